@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#
+# This file is part of the GROMACS molecular simulation package.
+#
+# Copyright (c) 2020, by the GROMACS development team, led by
+# Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+# and including many others, as listed in the AUTHORS file in the
+# top-level source directory and at http://www.gromacs.org.
+#
+# GROMACS is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# as published by the Free Software Foundation; either version 2.1
+# of the License, or (at your option) any later version.
+#
+# GROMACS is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with GROMACS; if not, see
+# http://www.gnu.org/licenses, or write to the Free Software Foundation,
+# Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+#
+# If you want to redistribute modifications to GROMACS, please
+# consider that scientific software is very special. Version
+# control is crucial - bugs must be traceable. We will be happy to
+# consider code for inclusion in the official distribution, but
+# derived work must not be called official GROMACS. Details are found
+# in the README & COPYING files - if they are missing, get the
+# official version at http://www.gromacs.org.
+#
+# To help us fund GROMACS development, we humbly ask that you cite
+# the research papers on the package. Check out http://www.gromacs.org.
+
+"""Convert wallcycle trace files to Chrome-trace (Perfetto) JSON.
+
+mdrun writes one wallcycle_trace_rank<n>.bin file per rank when the
+GMX_CYCLE_TRACE environment variable is set. This script converts one or
+more of those files into a single Chrome-trace JSON file, which can be
+opened at https://ui.perfetto.dev or in chrome://tracing to inspect the
+timing of each counted region per step.
+
+Timestamps in the trace files are raw cycle counter readings. Pass the
+nominal TSC frequency of the machine with --tsc-ghz to get microseconds;
+without it, one "microsecond" in the viewer corresponds to 1000 cycles.
+
+Usage: wallcycle_trace2chrometrace.py [--tsc-ghz GHZ] [-o out.json] wallcycle_trace_rank*.bin
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+MAGIC = b'GMXWCTRC'
+
+
+def read_trace(filename):
+    """Read one trace file, returning (counterNames, records).
+
+    Each record is a tuple (counterIndex, startCycle, cycleCount).
+    """
+    with open(filename, 'rb') as f:
+        if f.read(8) != MAGIC:
+            sys.exit(f'{filename}: not a wallcycle trace file')
+        (version, numCounters) = struct.unpack('<ii', f.read(8))
+        if version != 2:
+            sys.exit(f'{filename}: unsupported trace format version {version}')
+        counterNames = []
+        for _ in range(numCounters):
+            name = f.read(20)
+            counterNames.append(name.split(b'\0')[0].decode())
+        (numRecords,) = struct.unpack('<q', f.read(8))
+        recordFormat = struct.Struct('<iiQQ')
+        records = []
+        for _ in range(numRecords):
+            (ewc, _, start, cycles) = recordFormat.unpack(f.read(recordFormat.size))
+            records.append((ewc, start, cycles))
+        return (counterNames, records)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--tsc-ghz', type=float, default=None,
+                        help='cycle counter frequency in GHz, for real time stamps')
+    parser.add_argument('-o', '--output', default='wallcycle_trace.json',
+                        help='output Chrome-trace JSON file')
+    parser.add_argument('tracefile', nargs='+',
+                        help='wallcycle_trace_rank<n>.bin file(s) from one run')
+    args = parser.parse_args()
+
+    cyclesPerMicrosecond = args.tsc_ghz * 1000.0 if args.tsc_ghz else 1000.0
+
+    perRank = {}
+    for filename in args.tracefile:
+        match = re.search(r'rank(\d+)', filename)
+        rank = int(match.group(1)) if match else len(perRank)
+        perRank[rank] = read_trace(filename)
+
+    # A common offset keeps the timestamps small and the ranks aligned,
+    # assuming their cycle counters are synchronized (as on one node).
+    firstStart = min(records[0][1]
+                     for (_, records) in perRank.values() if records)
+
+    events = []
+    for (rank, (counterNames, records)) in sorted(perRank.items()):
+        for (ewc, start, cycles) in records:
+            name = counterNames[ewc] if ewc < len(counterNames) else str(ewc)
+            events.append({'name': name,
+                           'cat': 'wallcycle',
+                           'ph': 'X',
+                           'pid': rank,
+                           'tid': 0,
+                           'ts': (start - firstStart) / cyclesPerMicrosecond,
+                           'dur': cycles / cyclesPerMicrosecond})
+
+    with open(args.output, 'w') as f:
+        json.dump({'traceEvents': events,
+                   'displayTimeUnit': 'ms'}, f)
+    print(f'Wrote {len(events)} events to {args.output}')
+
+
+if __name__ == '__main__':
+    main()
@@ -187,21 +187,6 @@ AnalysisHistogramSettings::AnalysisHistogramSettings(const AnalysisHistogramSett
 }
 
 
-int AnalysisHistogramSettings::findBin(real y) const
-{
-    if (y < firstEdge_)
-    {
-        return bAll_ ? 0 : -1;
-    }
-    int bin = static_cast<int>((y - firstEdge_) * inverseBinWidth_);
-    if (bin >= binCount_)
-    {
-        return bAll_ ? binCount_ - 1 : -1;
-    }
-    return bin;
-}
-
-
 /********************************************************************
  * StaticAverageHistogram
  */
@@ -646,11 +631,16 @@ void AnalysisDataSimpleHistogramModule::pointsAdded(const AnalysisDataPointSetRe
 {
     Impl::FrameLocalData::DataSetHandle handle =
             impl_->accumulator_.frameDataSet(points.frameIndex(), points.dataSetIndex());
-    for (int i = 0; i < points.columnCount(); ++i)
+    // The whole point set is binned as one batch, with the settings hoisted
+    // into a local so that the inline findBin() reduces to straight-line
+    // arithmetic per value.
+    const AnalysisHistogramSettings& settings    = this->settings();
+    const int                        columnCount = points.columnCount();
+    for (int i = 0; i < columnCount; ++i)
     {
         if (points.present(i))
         {
-            const int bin = settings().findBin(points.y(i));
+            const int bin = settings.findBin(points.y(i));
             if (bin != -1)
             {
                 handle.value(bin) += 1;
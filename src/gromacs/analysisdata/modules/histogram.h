@@ -244,8 +244,25 @@ public:
     real binWidth() const { return binWidth_; }
     //! Whether values beyond the edges are mapped to the edge bins.
     bool includeAll() const { return bAll_; }
-    //! Returns a zero-based bin index for a value, or -1 if not in range.
-    int findBin(real y) const;
+    /*! \brief
+     * Returns a zero-based bin index for a value, or -1 if not in range.
+     *
+     * Defined inline so that batched binning loops over whole-frame value
+     * arrays do not pay a function call per value.
+     */
+    int findBin(real y) const
+    {
+        if (y < firstEdge_)
+        {
+            return bAll_ ? 0 : -1;
+        }
+        const int bin = static_cast<int>((y - firstEdge_) * inverseBinWidth_);
+        if (bin >= binCount_)
+        {
+            return bAll_ ? binCount_ - 1 : -1;
+        }
+        return bin;
+    }
 
 private:
     real firstEdge_;
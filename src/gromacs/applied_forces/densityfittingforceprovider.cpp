@@ -51,11 +51,14 @@
 #include "gromacs/math/densityfittingforce.h"
 #include "gromacs/math/exponentialmovingaverage.h"
 #include "gromacs/math/gausstransform.h"
+#include "gromacs/mdlib/gmx_omp_nthreads.h"
 #include "gromacs/mdtypes/commrec.h"
 #include "gromacs/mdtypes/enerdata.h"
 #include "gromacs/mdtypes/forceoutput.h"
 #include "gromacs/mdtypes/iforceprovider.h"
 #include "gromacs/pbcutil/pbc.h"
+#include "gromacs/utility/exceptions.h"
+#include "gromacs/utility/gmxomp.h"
 
 #include "densityfittingamplitudelookup.h"
 #include "densityfittingparameters.h"
@@ -114,7 +117,6 @@ private:
     GaussianSpreadKernelParameters::Shape spreadKernel_;
     GaussTransform3D                      gaussTransform_;
     DensitySimilarityMeasure              measure_;
-    DensityFittingForce                   densityFittingForce_;
     //! the local atom coordinates transformed into the grid coordinate system
     std::vector<RVec>             transformedCoordinates_;
     std::vector<RVec>             forces_;
@@ -144,7 +146,6 @@ DensityFittingForceProvider::Impl::Impl(const DensityFittingParameters&
                                    transformationToDensityLattice.scaleOperationOnly())),
     gaussTransform_(referenceDensity.extents(), spreadKernel_),
     measure_(parameters.similarityMeasureMethod_, referenceDensity),
-    densityFittingForce_(spreadKernel_),
     transformedCoordinates_(localAtomSet_.numAtomsLocal()),
     amplitudeLookup_(parameters_.amplitudeLookupMethod_),
     transformationToDensityLattice_(transformationToDensityLattice),
@@ -228,12 +229,43 @@ void DensityFittingForceProvider::Impl::calculateForces(const ForceProviderInput
         }
     }
 
-    auto amplitudeIterator = amplitudes.cbegin();
+    /* Spreading different atoms races on the lattice, so each thread spreads
+     * its share of the atoms on its own copy of the lattice. The copies are
+     * reduced into the main lattice below.
+     * \todo Offload the spreading and the force evaluation to the GPU; this
+     *       needs force providers with access to device-resident coordinate
+     *       and force buffers.
+     */
+    const int numThreads = gmx_omp_nthreads_get(emntDefault);
+
+    std::vector<GaussTransform3D> threadLocalGaussTransform(numThreads - 1, gaussTransform_);
+#pragma omp parallel num_threads(numThreads)
+    {
+        try
+        {
+            const int         thread = gmx_omp_get_thread_num();
+            GaussTransform3D& localGaussTransform =
+                    thread == 0 ? gaussTransform_ : threadLocalGaussTransform[thread - 1];
+#pragma omp for schedule(static)
+            for (index i = 0; i < ssize(transformedCoordinates_); i++)
+            {
+                localGaussTransform.add({ transformedCoordinates_[i], amplitudes[i] });
+            }
+        }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+    }
 
-    for (const auto& r : transformedCoordinates_)
+    /* Reduce the thread-local lattices into the main lattice */
+    float*      mainLattice = gaussTransform_.view().data();
+    const index numVoxels   = gaussTransform_.view().mapping().required_span_size();
+    for (GaussTransform3D& localGaussTransform : threadLocalGaussTransform)
     {
-        gaussTransform_.add({ r, *amplitudeIterator });
-        ++amplitudeIterator;
+        const float* localLattice = localGaussTransform.view().data();
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+        for (index voxel = 0; voxel < numVoxels; voxel++)
+        {
+            mainLattice[voxel] += localLattice[voxel];
+        }
     }
 
     // communicate grid
@@ -249,11 +281,22 @@ void DensityFittingForceProvider::Impl::calculateForces(const ForceProviderInput
             measure_.gradient(gaussTransform_.constView());
     // calculate forces
     forces_.resize(localAtomSet_.numAtomsLocal());
-    std::transform(
-            std::begin(transformedCoordinates_), std::end(transformedCoordinates_), std::begin(amplitudes),
-            std::begin(forces_), [&densityDerivative, this](const RVec r, real amplitude) {
-                return densityFittingForce_.evaluateForce({ r, amplitude }, densityDerivative);
-            });
+#pragma omp parallel num_threads(numThreads)
+    {
+        try
+        {
+            /* DensityFittingForce keeps internal spreading buffers, so each
+             * thread needs its own force evaluator */
+            DensityFittingForce threadLocalFittingForce(spreadKernel_);
+#pragma omp for schedule(static)
+            for (index i = 0; i < ssize(forces_); i++)
+            {
+                forces_[i] = threadLocalFittingForce.evaluateForce(
+                        { transformedCoordinates_[i], amplitudes[i] }, densityDerivative);
+            }
+        }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+    }
 
     transformationToDensityLattice_.scaleOperationOnly().inverseIgnoringZeroScale(forces_);
 
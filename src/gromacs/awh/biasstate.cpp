@@ -258,7 +258,7 @@ void BiasState::calcConvolvedPmf(const std::vector<DimParams>& dimParams,
     {
         double           freeEnergyWeights = 0;
         const GridPoint& point             = grid.point(m);
-        for (auto& neighbor : point.neighbor)
+        for (int neighbor : grid.neighbors(m))
         {
             /* The negative PMF is a positive bias. */
             double biasNeighbor = -pmf[neighbor];
@@ -370,11 +370,11 @@ int BiasState::warnForHistogramAnomalies(const Grid& grid, int biasIndex, double
     for (size_t m = 0; m < numPoints; m++)
     {
         /* Skip points close to boundary or non-target region */
-        const GridPoint& gridPoint = grid.point(m);
-        bool             skipPoint = false;
-        for (size_t n = 0; (n < gridPoint.neighbor.size()) && !skipPoint; n++)
+        const std::vector<int>& neighbors = grid.neighbors(m);
+        bool                    skipPoint = false;
+        for (size_t n = 0; (n < neighbors.size()) && !skipPoint; n++)
         {
-            int neighbor = gridPoint.neighbor[n];
+            int neighbor = neighbors[n];
             skipPoint    = !points_[neighbor].inTargetRegion();
             for (int d = 0; (d < grid.numDimensions()) && !skipPoint; d++)
             {
@@ -446,7 +446,7 @@ void BiasState::calcConvolvedForce(const std::vector<DimParams>& dimParams,
     }
 
     /* Only neighboring points have non-negligible contribution. */
-    const std::vector<int>& neighbor          = grid.point(coordState_.gridpointIndex()).neighbor;
+    const std::vector<int>& neighbor          = grid.neighbors(coordState_.gridpointIndex());
     gmx::ArrayRef<double>   forceFromNeighbor = forceWorkBuffer;
     for (size_t n = 0; n < neighbor.size(); n++)
     {
@@ -593,7 +593,7 @@ void BiasState::doSkippedUpdatesInNeighborhood(const BiasParams& params, const G
     getSkippedUpdateHistogramScaleFactors(params, &weightHistScaling, &logPmfsumScaling);
 
     /* For each neighbor point of the center point, refresh its state by adding the results of all past, skipped updates. */
-    const std::vector<int>& neighbors = grid.point(coordState_.gridpointIndex()).neighbor;
+    const std::vector<int>& neighbors = grid.neighbors(coordState_.gridpointIndex());
     for (auto& neighbor : neighbors)
     {
         bool didUpdate = points_[neighbor].performPreviouslySkippedUpdates(
@@ -1157,7 +1157,7 @@ double BiasState::updateProbabilityWeightsAndConvolvedBias(const std::vector<Dim
                                                            std::vector<double, AlignedAllocator<double>>* weight) const
 {
     /* Only neighbors of the current coordinate value will have a non-negligible chance of getting sampled */
-    const std::vector<int>& neighbors = grid.point(coordState_.gridpointIndex()).neighbor;
+    const std::vector<int>& neighbors = grid.neighbors(coordState_.gridpointIndex());
 
 #if GMX_SIMD_HAVE_DOUBLE
     typedef SimdDouble PackType;
@@ -1214,12 +1214,11 @@ double BiasState::calcConvolvedBias(const std::vector<DimParams>& dimParams,
                                     const Grid&                   grid,
                                     const awh_dvec&               coordValue) const
 {
-    int              point     = grid.nearestIndex(coordValue);
-    const GridPoint& gridPoint = grid.point(point);
+    int point = grid.nearestIndex(coordValue);
 
     /* Sum the probability weights from the neighborhood of the given point */
     double weightSum = 0;
-    for (int neighbor : gridPoint.neighbor)
+    for (int neighbor : grid.neighbors(point))
     {
         double logWeight = biasedLogWeightFromPoint(dimParams, points_, grid, neighbor,
                                                     points_[neighbor].bias(), coordValue);
@@ -1232,7 +1231,7 @@ double BiasState::calcConvolvedBias(const std::vector<DimParams>& dimParams,
 
 void BiasState::sampleProbabilityWeights(const Grid& grid, gmx::ArrayRef<const double> probWeightNeighbor)
 {
-    const std::vector<int>& neighbor = grid.point(coordState_.gridpointIndex()).neighbor;
+    const std::vector<int>& neighbor = grid.neighbors(coordState_.gridpointIndex());
 
     /* Save weights for next update */
     for (size_t n = 0; n < neighbor.size(); n++)
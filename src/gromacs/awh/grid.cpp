@@ -567,6 +567,10 @@ int Grid::nearestIndex(const awh_dvec value) const
 namespace
 {
 
+//! The maximum number of neighbors within scope along one grid axis.
+const int c_maxNeighborsAlongAxis =
+        1 + 2 * static_cast<int>(Grid::c_numPointsPerSigma * Grid::c_scopeCutoff);
+
 /*! \brief
  * Find and set the neighbors of a grid point.
  *
@@ -579,9 +583,6 @@ namespace
  */
 void setNeighborsOfGridPoint(int pointIndex, const Grid& grid, std::vector<int>* neighborIndexArray)
 {
-    const int c_maxNeighborsAlongAxis =
-            1 + 2 * static_cast<int>(Grid::c_numPointsPerSigma * Grid::c_scopeCutoff);
-
     awh_ivec numCandidates = { 0 };
     awh_ivec subgridOrigin = { 0 };
     for (int d = 0; d < grid.numDimensions(); d++)
@@ -719,16 +720,29 @@ Grid::Grid(const std::vector<DimParams>& dimParams, const AwhDimParams* awhDimPa
     /* Set their values */
     initPoints();
 
-    /* Keep a neighbor list for each point.
-     * Note: could also generate neighbor list only when needed
-     * instead of storing them for each point.
+    /* The neighbor lists are generated on demand in neighbors(), since
+     * storing them for all points takes memory exponential in the number
+     * of dimensions. Here we only reserve space for the largest possible
+     * neighborhood, so queries never reallocate.
      */
-    for (size_t m = 0; m < point_.size(); m++)
+    int maxNeighborhoodSize = 1;
+    for (const GridAxis& axis : axis_)
     {
-        std::vector<int>* neighbor = &point_[m].neighbor;
+        maxNeighborhoodSize *= std::min(c_maxNeighborsAlongAxis, axis.numPoints());
+    }
+    cachedNeighbors_.reserve(maxNeighborhoodSize);
+}
 
-        setNeighborsOfGridPoint(m, *this, neighbor);
+const std::vector<int>& Grid::neighbors(int pointIndex) const
+{
+    if (pointIndex != cachedNeighborsIndex_)
+    {
+        cachedNeighbors_.clear();
+        setNeighborsOfGridPoint(pointIndex, *this, &cachedNeighbors_);
+        cachedNeighborsIndex_ = pointIndex;
     }
+
+    return cachedNeighbors_;
 }
 
 void mapGridToDataGrid(std::vector<int>*    gridpointToDatapoint,
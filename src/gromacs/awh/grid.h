@@ -56,6 +56,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "dimparams.h" /* This is needed for awh_dvec */
 
@@ -147,15 +148,14 @@ private:
 /*! \internal
  * \brief A point in the grid.
  *
- * A grid point has a coordinate value and a coordinate index of the same dimensionality as the
- * grid. It knows the linear indices of its neighboring point (which are useful only when handed up
- * to the grid).
+ * A grid point has a coordinate value and a coordinate index of the same
+ * dimensionality as the grid. The linear indices of the neighboring points
+ * are obtained from the grid, see Grid::neighbors().
  */
 struct GridPoint
 {
-    awh_dvec         coordValue; /**< Multidimensional coordinate value of this point */
-    awh_ivec         index;      /**< Multidimensional point indices */
-    std::vector<int> neighbor;   /**< Linear point indices of the neighboring points */
+    awh_dvec coordValue; /**< Multidimensional coordinate value of this point */
+    awh_ivec index;      /**< Multidimensional point indices */
 };
 
 /*! \internal
@@ -203,6 +203,28 @@ public:
      */
     const GridPoint& point(size_t pointIndex) const { return point_[pointIndex]; }
 
+    /*! \brief Returns the neighborhood of a grid point.
+     *
+     * The neighborhood is the set of grid points within the scope cutoff
+     * of the given point, in linear point indices. The list is generated
+     * on demand and cached for the most recently queried point, so
+     * repeated calls for the same point, which is the common access
+     * pattern during sampling, only cost a lookup. The returned reference
+     * is invalidated by a call for a different point.
+     *
+     * Generating the neighborhoods on demand keeps the grid memory
+     * proportional to the number of points. Storing them for all points
+     * requires up to (2*c_scopeCutoff*c_numPointsPerSigma + 1)^ndim
+     * elements per point, which gets prohibitive for multidimensional
+     * grids.
+     *
+     * \note Not thread-safe, because of the internal cache.
+     *
+     * \param[in] pointIndex  Grid point index.
+     * \returns the linear indices of the points in the neighborhood.
+     */
+    const std::vector<int>& neighbors(int pointIndex) const;
+
     /*! \brief Returns the dimensionality of the grid.
      *
      * \returns the dimensionality of the grid.
@@ -240,6 +262,9 @@ public:
 private:
     std::vector<GridPoint> point_; /**< Points on the grid */
     std::vector<GridAxis>  axis_;  /**< Axes, one for each dimension. */
+
+    mutable std::vector<int> cachedNeighbors_; /**< Cache with the neighborhood of one point, see neighbors() */
+    mutable int cachedNeighborsIndex_ = -1; /**< The point index the neighbor cache is valid for, -1 if none */
 };
 
 /*! \endcond */
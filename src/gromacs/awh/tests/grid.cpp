@@ -115,7 +115,7 @@ TEST(gridTest, neighborhood)
     /* Checking for all points is overkill, we check every 7th */
     for (size_t i = 0; i < grid.numPoints(); i += 7)
     {
-        const GridPoint& point = grid.point(i);
+        const std::vector<int>& neighbors = grid.neighbors(i);
 
         /* NOTE: This code relies on major-minor index ordering in Grid */
         int pointIndex0 = i / numPointsDim[1];
@@ -128,12 +128,12 @@ TEST(gridTest, neighborhood)
         int    distanceFromEdge1 = std::min(pointIndex1, numPointsDim[1] - 1 - pointIndex1);
         size_t numNeighbors      = (2 * scopeInPoints + 1)
                               * (scopeInPoints + std::min(scopeInPoints, distanceFromEdge1) + 1);
-        if (point.neighbor.size() != numNeighbors)
+        if (neighbors.size() != numNeighbors)
         {
             haveCorrectNumNeighbors = false;
         }
 
-        for (auto& j : point.neighbor)
+        for (auto& j : neighbors)
         {
             if (j >= 0 && j < numPoints)
             {
@@ -171,7 +171,7 @@ TEST(gridTest, neighborhood)
         }
 
         /* Clear the marked points in the checking grid */
-        for (auto& neighbor : point.neighbor)
+        for (auto& neighbor : neighbors)
         {
             if (neighbor >= 0 && neighbor < numPoints)
             {
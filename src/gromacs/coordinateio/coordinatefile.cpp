@@ -45,6 +45,8 @@
 
 #include "coordinatefile.h"
 
+#include <cstdlib>
+
 #include <algorithm>
 
 #include "gromacs/options.h"
@@ -59,6 +61,9 @@
 namespace gmx
 {
 
+//! Maximum number of frames queued for the asynchronous writer thread.
+static constexpr size_t c_maxQueuedFrames = 8;
+
 /*!\brief
  *  Get the internal file type from the \p filename.
  *
@@ -384,9 +389,154 @@ t_trxstatus* TrajectoryFileOpener::outputFile()
     return outputFile_;
 }
 
+/*! \internal \brief
+ * Deep copy of a frame queued for the asynchronous writer thread.
+ */
+struct TrajectoryFrameWriter::QueuedFrame
+{
+    //! Frame number passed to the output adapters.
+    int framenumber;
+    //! Frame header with array pointers into the storage below.
+    t_trxframe frame;
+    //! Storage for positions.
+    std::vector<RVec> x;
+    //! Storage for velocities.
+    std::vector<RVec> v;
+    //! Storage for forces.
+    std::vector<RVec> f;
+    //! Storage for the index.
+    std::vector<int> index;
+};
+
+TrajectoryFrameWriter::TrajectoryFrameWriter(const std::string&     name,
+                                             int                    filetype,
+                                             const Selection&       sel,
+                                             const gmx_mtop_t*      mtop,
+                                             OutputAdapterContainer adapters) :
+    file_(name, filetype, sel, mtop),
+    outputAdapters_(std::move(adapters)),
+    asyncWriting_(false),
+    stopWriter_(false),
+    writerFailed_(false)
+{
+    if (std::getenv("GMX_COORDINATEIO_ASYNC") != nullptr)
+    {
+        asyncWriting_ = true;
+        writerThread_ = std::thread(&TrajectoryFrameWriter::writerThreadLoop, this);
+    }
+}
+
+TrajectoryFrameWriter::~TrajectoryFrameWriter()
+{
+    if (writerThread_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(writerMutex_);
+            stopWriter_ = true;
+        }
+        queueNotEmpty_.notify_all();
+        writerThread_.join();
+        if (writerException_)
+        {
+            // Exceptions can not propagate from a destructor; report the
+            // error the same way the top-level handlers do.
+            try
+            {
+                std::rethrow_exception(writerException_);
+            }
+            catch (const std::exception& ex)
+            {
+                printFatalErrorMessage(stderr, ex);
+            }
+        }
+    }
+}
+
+void TrajectoryFrameWriter::processAndWriteFrame(const int framenumber, t_trxframe* frame)
+{
+    for (const auto& outputAdapter : outputAdapters_.getAdapters())
+    {
+        if (outputAdapter)
+        {
+            outputAdapter->processFrame(framenumber, frame);
+        }
+    }
+    write_trxframe(file_.outputFile(), frame, nullptr);
+}
+
+void TrajectoryFrameWriter::writerThreadLoop()
+{
+    try
+    {
+        while (true)
+        {
+            std::unique_ptr<QueuedFrame> entry;
+            {
+                std::unique_lock<std::mutex> lock(writerMutex_);
+                queueNotEmpty_.wait(lock, [this] { return stopWriter_ || !frameQueue_.empty(); });
+                if (frameQueue_.empty())
+                {
+                    return;
+                }
+                entry = std::move(frameQueue_.front());
+                frameQueue_.pop_front();
+            }
+            queueNotFull_.notify_one();
+            processAndWriteFrame(entry->framenumber, &entry->frame);
+        }
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        writerFailed_    = true;
+        writerException_ = std::current_exception();
+        queueNotFull_.notify_all();
+    }
+}
+
 void TrajectoryFrameWriter::prepareAndWriteFrame(const int framenumber, const t_trxframe& input)
 {
-    if (!outputAdapters_.isEmpty())
+    if (asyncWriting_)
+    {
+        // The frame is always deep copied here, also without adapters,
+        // because the write happens after this method has returned and the
+        // caller is free to overwrite the input frame.
+        auto entry         = std::make_unique<QueuedFrame>();
+        entry->framenumber = framenumber;
+        clear_trxframe(&entry->frame, true);
+        entry->x.resize(input.natoms);
+        entry->index.resize(input.natoms);
+        if (input.bV)
+        {
+            entry->v.resize(input.natoms);
+        }
+        if (input.bF)
+        {
+            entry->f.resize(input.natoms);
+        }
+        deepCopy_t_trxframe(input, &entry->frame, entry->x.data(), entry->v.data(),
+                            entry->f.data(), entry->index.data());
+        {
+            std::unique_lock<std::mutex> lock(writerMutex_);
+            queueNotFull_.wait(lock, [this] {
+                return writerFailed_ || frameQueue_.size() < c_maxQueuedFrames;
+            });
+            if (writerFailed_)
+            {
+                if (writerException_)
+                {
+                    std::exception_ptr ex = writerException_;
+                    writerException_      = nullptr;
+                    std::rethrow_exception(ex);
+                }
+                // The error has already been rethrown earlier; drop the frame.
+                return;
+            }
+            frameQueue_.push_back(std::move(entry));
+        }
+        queueNotEmpty_.notify_one();
+    }
+    else if (!outputAdapters_.isEmpty())
     {
         t_trxframe local;
         clear_trxframe(&local, true);
@@ -402,14 +552,7 @@ void TrajectoryFrameWriter::prepareAndWriteFrame(const int framenumber, const t_
         }
         deepCopy_t_trxframe(input, &local, localX_.data(), localV_.data(), localF_.data(),
                             localIndex_.data());
-        for (const auto& outputAdapter : outputAdapters_.getAdapters())
-        {
-            if (outputAdapter)
-            {
-                outputAdapter->processFrame(framenumber, &local);
-            }
-        }
-        write_trxframe(file_.outputFile(), &local, nullptr);
+        processAndWriteFrame(framenumber, &local);
     }
     else
     {
@@ -43,7 +43,12 @@
 #ifndef GMX_COORDINATEIO_COORDINATEFILE_H
 #define GMX_COORDINATEIO_COORDINATEFILE_H
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 
 #include "gromacs/coordinateio/ioutputadapter.h"
@@ -161,6 +166,11 @@ private:
  * frame data before writing. If any transform modules are used,
  * makes a deep copy of the frame contents.
  *
+ * When the environment variable GMX_COORDINATEIO_ASYNC is set, the
+ * adapters and the file writing run on a background thread with a
+ * bounded frame queue, so that the caller can continue reading the
+ * next frame while the previous ones are converted and written.
+ *
  * \inpublicapi
  * \ingroup module_coordinateio
  *
@@ -174,9 +184,18 @@ public:
                                                                               AtomsDataPtr atoms,
                                                                               OutputRequirements requirements);
 
+    /*! \brief
+     * Finishes any pending asynchronous writes and closes the writer thread.
+     */
+    ~TrajectoryFrameWriter();
+
     /*! \brief
      * Writes the input frame, after applying any IOutputAdapters.
      *
+     * With asynchronous writing, queues a deep copy of the frame for the
+     * writer thread instead, blocking if the queue is full.  Errors from
+     * the writer thread are rethrown here on a subsequent call.
+     *
      * \param[in] framenumber Number of frame being currently processed.
      * \param[in] input View of the constant t_trxframe object provided by the
      *                  method that calls the output manager.
@@ -184,6 +203,8 @@ public:
     void prepareAndWriteFrame(int framenumber, const t_trxframe& input);
 
 private:
+    //! Storage for a frame queued for the asynchronous writer thread.
+    struct QueuedFrame;
     /*! \brief
      * Creates fully initialized object.
      *
@@ -200,11 +221,12 @@ private:
                           int                    filetype,
                           const Selection&       sel,
                           const gmx_mtop_t*      mtop,
-                          OutputAdapterContainer adapters) :
-        file_(name, filetype, sel, mtop),
-        outputAdapters_(std::move(adapters))
-    {
-    }
+                          OutputAdapterContainer adapters);
+
+    //! Applies the output adapters to \p frame and writes it to the file.
+    void processAndWriteFrame(int framenumber, t_trxframe* frame);
+    //! Loop run by the background writer thread.
+    void writerThreadLoop();
 
     //! Underlying object for open/writing to file.
     TrajectoryFileOpener file_;
@@ -220,6 +242,25 @@ private:
     std::vector<RVec> localF_;
     //! Local storage for modified indices.
     std::vector<int> localIndex_;
+
+    //! Whether the asynchronous writing pipeline is active.
+    bool asyncWriting_;
+    //! Frames queued for the writer thread.
+    std::deque<std::unique_ptr<QueuedFrame>> frameQueue_;
+    //! Protects frameQueue_, stopWriter_, and the error state below.
+    std::mutex writerMutex_;
+    //! Signals the producer that the queue is no longer full.
+    std::condition_variable queueNotFull_;
+    //! Signals the writer thread that frames are available.
+    std::condition_variable queueNotEmpty_;
+    //! Set to request the writer thread to finish.
+    bool stopWriter_;
+    //! Whether the writer thread has failed with an exception.
+    bool writerFailed_;
+    //! Exception raised on the writer thread, if any.
+    std::exception_ptr writerException_;
+    //! Background thread applying adapters and writing frames.
+    std::thread writerThread_;
 };
 
 //! Smart pointer to manage the TrajectoryFrameWriter object.
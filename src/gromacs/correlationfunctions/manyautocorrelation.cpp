@@ -49,82 +49,184 @@
 #include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/gmxomp.h"
 
-int many_auto_correl(std::vector<std::vector<real>>* c)
+namespace gmx
 {
-    size_t nfunc = (*c).size();
-    if (nfunc == 0)
+
+ManyAutocorrelation::ManyAutocorrelation(int dataLength) :
+    ndata_(dataLength), nfft_((3 * dataLength / 2) + 1), numAccumulated_(0)
+{
+    if (dataLength <= 0)
     {
-        GMX_THROW(gmx::InconsistentInputError("Empty array of vectors supplied"));
+        GMX_THROW(InconsistentInputError("Data length should be positive"));
     }
-    size_t ndata = (*c)[0].size();
-    if (ndata == 0)
+    int nthreads = gmx_omp_get_max_threads();
+    fft_.resize(nthreads, nullptr);
+    in_.resize(nthreads);
+    out_.resize(nthreads);
+    sum_.resize(nthreads);
+    for (int t = 0; t < nthreads; t++)
     {
-        GMX_THROW(gmx::InconsistentInputError("Empty vector supplied"));
+        gmx_fft_init_1d(&fft_[t], nfft_, GMX_FFT_FLAG_CONSERVATIVE);
+        in_[t].resize(2 * nfft_, 0);
+        out_[t].resize(2 * nfft_, 0);
+    }
+}
+
+ManyAutocorrelation::~ManyAutocorrelation()
+{
+    for (auto& fft : fft_)
+    {
+        gmx_fft_destroy(fft);
+    }
+}
+
+void ManyAutocorrelation::computeOneSet(const real* data, int thread)
+{
+    std::vector<real>& in  = in_[thread];
+    std::vector<real>& out = out_[thread];
+
+    /* Copy to the zero-padded complex workspace instead of padding the
+     * caller's array, which would reallocate for every data set.
+     */
+    for (int j = 0; j < ndata_; j++)
+    {
+        in[2 * j + 0] = data[j];
+        in[2 * j + 1] = 0;
+    }
+    for (int j = ndata_; j < nfft_; j++)
+    {
+        in[2 * j + 0] = 0;
+        in[2 * j + 1] = 0;
     }
-#ifndef NDEBUG
-    for (size_t i = 1; i < nfunc; i++)
+    gmx_fft_1d(fft_[thread], GMX_FFT_BACKWARD, in.data(), out.data());
+    for (int j = 0; j < nfft_; j++)
     {
-        if ((*c)[i].size() != ndata)
+        in[2 * j + 0] = (out[2 * j + 0] * out[2 * j + 0] + out[2 * j + 1] * out[2 * j + 1]) / nfft_;
+        in[2 * j + 1] = 0;
+    }
+    gmx_fft_1d(fft_[thread], GMX_FFT_FORWARD, in.data(), out.data());
+}
+
+void ManyAutocorrelation::compute(std::vector<std::vector<real>>* c)
+{
+    size_t nfunc = c->size();
+    if (nfunc == 0)
+    {
+        GMX_THROW(InconsistentInputError("Empty array of vectors supplied"));
+    }
+    for (size_t i = 0; i < nfunc; i++)
+    {
+        if ((*c)[i].size() != static_cast<size_t>(ndata_))
         {
             char buf[256];
-            snprintf(buf, sizeof(buf), "Vectors of different lengths supplied (%d %d)",
-                     static_cast<int>((*c)[i].size()), static_cast<int>(ndata));
-            GMX_THROW(gmx::InconsistentInputError(buf));
+            snprintf(buf, sizeof(buf), "Vector of wrong length supplied (%d instead of %d)",
+                     static_cast<int>((*c)[i].size()), ndata_);
+            GMX_THROW(InconsistentInputError(buf));
         }
     }
-#endif
-    // Add buffer size to the arrays.
-    size_t nfft = (3 * ndata / 2) + 1;
-    // Pad arrays with zeros
-    for (auto& i : *c)
-    {
-        i.resize(nfft, 0);
-    }
 #pragma omp parallel
     {
         try
         {
-            gmx_fft_t         fft1;
-            std::vector<real> in, out;
-
             int nthreads  = gmx_omp_get_max_threads();
             int thread_id = gmx_omp_get_thread_num();
             int i0        = (thread_id * nfunc) / nthreads;
             int i1        = std::min(nfunc, ((thread_id + 1) * nfunc) / nthreads);
 
-            gmx_fft_init_1d(&fft1, nfft, GMX_FFT_FLAG_CONSERVATIVE);
-            /* Allocate temporary arrays */
-            in.resize(2 * nfft, 0);
-            out.resize(2 * nfft, 0);
             for (int i = i0; (i < i1); i++)
             {
-                for (size_t j = 0; j < ndata; j++)
+                computeOneSet((*c)[i].data(), thread_id);
+                for (int j = 0; j < ndata_; j++)
                 {
-                    in[2 * j + 0] = (*c)[i][j];
-                    in[2 * j + 1] = 0;
+                    (*c)[i][j] = out_[thread_id][2 * j + 0];
                 }
-                gmx_fft_1d(fft1, GMX_FFT_BACKWARD, in.data(), out.data());
-                for (size_t j = 0; j < nfft; j++)
-                {
-                    in[2 * j + 0] =
-                            (out[2 * j + 0] * out[2 * j + 0] + out[2 * j + 1] * out[2 * j + 1]) / nfft;
-                    in[2 * j + 1] = 0;
-                }
-                gmx_fft_1d(fft1, GMX_FFT_FORWARD, in.data(), out.data());
-                for (size_t j = 0; (j < nfft); j++)
+            }
+        }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+    }
+}
+
+void ManyAutocorrelation::accumulate(const std::vector<std::vector<real>>& c)
+{
+    size_t nfunc = c.size();
+    if (nfunc == 0)
+    {
+        GMX_THROW(InconsistentInputError("Empty array of vectors supplied"));
+    }
+    for (size_t i = 0; i < nfunc; i++)
+    {
+        if (c[i].size() != static_cast<size_t>(ndata_))
+        {
+            char buf[256];
+            snprintf(buf, sizeof(buf), "Vector of wrong length supplied (%d instead of %d)",
+                     static_cast<int>(c[i].size()), ndata_);
+            GMX_THROW(InconsistentInputError(buf));
+        }
+    }
+#pragma omp parallel
+    {
+        try
+        {
+            int nthreads  = gmx_omp_get_max_threads();
+            int thread_id = gmx_omp_get_thread_num();
+            int i0        = (thread_id * nfunc) / nthreads;
+            int i1        = std::min(nfunc, ((thread_id + 1) * nfunc) / nthreads);
+
+            if (i0 < i1 && sum_[thread_id].empty())
+            {
+                sum_[thread_id].resize(ndata_, 0);
+            }
+            for (int i = i0; (i < i1); i++)
+            {
+                computeOneSet(c[i].data(), thread_id);
+                for (int j = 0; j < ndata_; j++)
                 {
-                    (*c)[i][j] = out[2 * j + 0];
+                    sum_[thread_id][j] += out_[thread_id][2 * j + 0];
                 }
             }
-            /* Free the memory */
-            gmx_fft_destroy(fft1);
         }
         GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
     }
-    for (auto& i : *c)
+    numAccumulated_ += nfunc;
+}
+
+std::vector<real> ManyAutocorrelation::average() const
+{
+    if (numAccumulated_ == 0)
+    {
+        GMX_THROW(InconsistentInputError("No data sets have been accumulated"));
+    }
+    std::vector<real> acf(ndata_);
+    for (int j = 0; j < ndata_; j++)
     {
-        i.resize(ndata);
+        double s = 0;
+        for (const auto& sum : sum_)
+        {
+            if (!sum.empty())
+            {
+                s += sum[j];
+            }
+        }
+        acf[j] = s / numAccumulated_;
+    }
+    return acf;
+}
+
+} // namespace gmx
+
+int many_auto_correl(std::vector<std::vector<real>>* c)
+{
+    if (c->empty())
+    {
+        GMX_THROW(gmx::InconsistentInputError("Empty array of vectors supplied"));
+    }
+    size_t ndata = (*c)[0].size();
+    if (ndata == 0)
+    {
+        GMX_THROW(gmx::InconsistentInputError("Empty vector supplied"));
     }
+    gmx::ManyAutocorrelation engine(ndata);
+    engine.compute(c);
 
     return 0;
 }
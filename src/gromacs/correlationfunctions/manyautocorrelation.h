@@ -47,8 +47,93 @@
 #include <vector>
 
 #include "gromacs/fft/fft.h"
+#include "gromacs/utility/classhelpers.h"
 #include "gromacs/utility/real.h"
 
+namespace gmx
+{
+
+/*! \libinternal \brief
+ * Engine for computing many autocorrelation functions of equally long data sets.
+ *
+ * The FFT plans and transform workspaces are set up once, per OpenMP thread,
+ * when the engine is constructed for a given data length, and are reused for
+ * every data set processed afterwards. This avoids the planning and allocation
+ * overhead that dominates when autocorrelations of many short series are
+ * computed one batch at a time, such as over all molecules in a system.
+ *
+ * Data sets can either be transformed in place in batches with compute(),
+ * or streamed through accumulate(), which only maintains the running sum
+ * of the autocorrelation functions and therefore does not require all
+ * data sets to be in memory at the same time.
+ */
+class ManyAutocorrelation
+{
+public:
+    /*! \brief Plan FFTs and allocate workspaces for data sets of \p dataLength points.
+     *
+     * \throws InconsistentInputError if \p dataLength is not positive.
+     */
+    explicit ManyAutocorrelation(int dataLength);
+    ~ManyAutocorrelation();
+
+    //! Return the data set length this engine was planned for.
+    int dataLength() const { return ndata_; }
+
+    /*! \brief Compute the autocorrelation of each data set in \p c in place.
+     *
+     * On return c[i][j] contains the autocorrelation of data set i at lag j,
+     * as a symmetric function suitable for further FFTs, identical to what
+     * many_auto_correl() produces.
+     *
+     * \throws InconsistentInputError if \p c is empty or any data set does
+     *         not have dataLength() points.
+     */
+    void compute(std::vector<std::vector<real>>* c);
+
+    /*! \brief Add the autocorrelation of each data set in \p c to the running sum.
+     *
+     * The input data sets are not modified, and the sum can be extended with
+     * further calls before extracting the result with average().
+     *
+     * \throws InconsistentInputError if \p c is empty or any data set does
+     *         not have dataLength() points.
+     */
+    void accumulate(const std::vector<std::vector<real>>& c);
+
+    //! Return the number of data sets accumulated so far.
+    int numAccumulated() const { return numAccumulated_; }
+
+    /*! \brief Return the average of all accumulated autocorrelation functions.
+     *
+     * \throws InconsistentInputError if no data sets have been accumulated.
+     */
+    std::vector<real> average() const;
+
+private:
+    //! Compute the autocorrelation of \p data into the workspace of \p thread.
+    void computeOneSet(const real* data, int thread);
+
+    //! Length of the data sets.
+    int ndata_;
+    //! Transform length, including zero padding.
+    int nfft_;
+    //! One FFT plan per OpenMP thread.
+    std::vector<gmx_fft_t> fft_;
+    //! Per-thread transform input workspace.
+    std::vector<std::vector<real>> in_;
+    //! Per-thread transform output workspace.
+    std::vector<std::vector<real>> out_;
+    //! Per-thread partial sums of accumulated autocorrelations.
+    std::vector<std::vector<double>> sum_;
+    //! Number of data sets accumulated into sum_.
+    int numAccumulated_;
+
+    GMX_DISALLOW_COPY_AND_ASSIGN(ManyAutocorrelation);
+};
+
+} // namespace gmx
+
 /*! \brief
  * Perform many autocorrelation calculations.
  *
@@ -64,6 +149,10 @@
  *
  * The functions uses OpenMP parallellization.
  *
+ * When many batches of data sets with the same length are processed, use
+ * gmx::ManyAutocorrelation directly instead, so that the FFT plans and
+ * workspaces are set up only once.
+ *
  * \param[inout] c Data array
  * \return fft error code, or zero if everything went fine (see fft/fft.h)
  * \throws gmx::InconsistentInputError if the input is inconsistent.
@@ -69,7 +69,6 @@ TEST_F(ManyAutocorrelationTest, Empty)
     EXPECT_THROW_GMX(many_auto_correl(&c), gmx::InconsistentInputError);
 }
 
-#ifndef NDEBUG
 TEST_F(ManyAutocorrelationTest, DifferentLength)
 {
     std::vector<std::vector<real>> c;
@@ -79,7 +78,87 @@ TEST_F(ManyAutocorrelationTest, DifferentLength)
     c[2].resize(8);
     EXPECT_THROW_GMX(many_auto_correl(&c), gmx::InconsistentInputError);
 }
-#endif
+
+//! Fill \c nfunc data sets of \c ndata points with a deterministic pattern
+std::vector<std::vector<real>> makeTestData(int nfunc, int ndata)
+{
+    std::vector<std::vector<real>> c(nfunc);
+    for (int i = 0; i < nfunc; i++)
+    {
+        c[i].resize(ndata);
+        for (int j = 0; j < ndata; j++)
+        {
+            c[i][j] = std::cos(0.1 * (i + 1) * j);
+        }
+    }
+    return c;
+}
+
+TEST_F(ManyAutocorrelationTest, EngineMatchesManyAutoCorrel)
+{
+    const int ndata = 32;
+
+    std::vector<std::vector<real>> reference = makeTestData(5, ndata);
+    many_auto_correl(&reference);
+
+    std::vector<std::vector<real>> c = makeTestData(5, ndata);
+    gmx::ManyAutocorrelation       engine(ndata);
+    EXPECT_EQ(engine.dataLength(), ndata);
+    engine.compute(&c);
+    /* A second batch through the same plans and workspaces */
+    std::vector<std::vector<real>> c2 = makeTestData(5, ndata);
+    engine.compute(&c2);
+
+    for (size_t i = 0; i < reference.size(); i++)
+    {
+        for (int j = 0; j < ndata; j++)
+        {
+            EXPECT_REAL_EQ_TOL(reference[i][j], c[i][j], gmx::test::defaultRealTolerance());
+            EXPECT_REAL_EQ_TOL(reference[i][j], c2[i][j], gmx::test::defaultRealTolerance());
+        }
+    }
+}
+
+TEST_F(ManyAutocorrelationTest, EngineAccumulatesAverage)
+{
+    const int ndata = 24;
+    const int nfunc = 6;
+
+    std::vector<std::vector<real>> reference = makeTestData(nfunc, ndata);
+    many_auto_correl(&reference);
+
+    gmx::ManyAutocorrelation       engine(ndata);
+    std::vector<std::vector<real>> c = makeTestData(nfunc, ndata);
+    /* Stream the data sets in two batches */
+    engine.accumulate(std::vector<std::vector<real>>(c.begin(), c.begin() + 2));
+    engine.accumulate(std::vector<std::vector<real>>(c.begin() + 2, c.end()));
+    EXPECT_EQ(engine.numAccumulated(), nfunc);
+
+    std::vector<real> average = engine.average();
+    auto              tolerance = gmx::test::relativeToleranceAsFloatingPoint(1.0, 1e-5);
+    for (int j = 0; j < ndata; j++)
+    {
+        double refAverage = 0;
+        for (int i = 0; i < nfunc; i++)
+        {
+            refAverage += reference[i][j];
+        }
+        refAverage /= nfunc;
+        EXPECT_REAL_EQ_TOL(refAverage, average[j], tolerance);
+    }
+}
+
+TEST_F(ManyAutocorrelationTest, EngineChecksInput)
+{
+    EXPECT_THROW_GMX(gmx::ManyAutocorrelation(0), gmx::InconsistentInputError);
+
+    gmx::ManyAutocorrelation       engine(10);
+    std::vector<std::vector<real>> c;
+    EXPECT_THROW_GMX(engine.compute(&c), gmx::InconsistentInputError);
+    c = makeTestData(2, 8);
+    EXPECT_THROW_GMX(engine.compute(&c), gmx::InconsistentInputError);
+    EXPECT_THROW_GMX(engine.average(), gmx::InconsistentInputError);
+}
 
 } // namespace
 
@@ -177,6 +177,22 @@ real grid_jump_limit(const gmx_domdec_comm_t* comm, real cutoff, int dim_ind)
  * comm->cellsize_min, for bonded and initial non-bonded cut-offs,
  * and, possibly, a longer cut-off limit set for PME load balancing.
  */
+float dd_dlb_boundary_flip_fraction(const RowMaster& rowMaster)
+{
+    float flipFraction = 0;
+
+    if (rowMaster.numBoundaryUpdates >= 2)
+    {
+        for (const int flipCount : rowMaster.boundaryFlipCount)
+        {
+            flipFraction = std::max(
+                    flipFraction, flipCount / static_cast<float>(rowMaster.numBoundaryUpdates - 1));
+        }
+    }
+
+    return flipFraction;
+}
+
 static real cellsize_min_dlb(gmx_domdec_comm_t* comm, int dim_ind, int dim)
 {
     real cellsize_min;
@@ -556,6 +572,47 @@ static void dd_cell_sizes_dlb_root_enforce_limits(gmx_domdec_t*      dd,
 }
 
 
+/* Returns the relative cell size change for cell i of a row, based on
+ * the measured loads.
+ *
+ * With nodeSize > 1 the imbalance is determined in two levels: first
+ * the average load of the group of nodeSize consecutive cells that
+ * share a physical node is balanced against the row average, then the
+ * cell load is balanced against its group average. This way all cells
+ * of a node get the same coarse change and the boundaries internal to
+ * a node only move because of intra-node imbalance, which avoids
+ * boundary thrashing when a whole node runs slower, e.g. due to a
+ * lower clock. With nodeSize = 1 all cells are treated uniformly.
+ */
+static real dlb_cell_size_change(const domdec_load_t& load, int i, int nodeSize, real load_aver, real relax)
+{
+    const real load_i = load.load[i * load.nload + 2];
+
+    real imbalance;
+    if (nodeSize > 1)
+    {
+        /* The average load of the node group that cell i belongs to */
+        const int group_start = (i / nodeSize) * nodeSize;
+        real      load_node   = 0;
+        for (int j = group_start; j < group_start + nodeSize; j++)
+        {
+            load_node += load.load[j * load.nload + 2];
+        }
+        load_node /= nodeSize;
+
+        /* Coarse, inter-node level plus fine, intra-node level */
+        imbalance = (load_node - load_aver) / (load_aver > 0 ? load_aver : 1)
+                    + (load_i - load_node) / (load_node > 0 ? load_node : 1);
+    }
+    else
+    {
+        imbalance = (load_i - load_aver) / (load_aver > 0 ? load_aver : 1);
+    }
+
+    /* Determine the change of the cell size using underrelaxation */
+    return -relax * imbalance;
+}
+
 static void set_dd_cell_sizes_dlb_root(gmx_domdec_t*      dd,
                                        int                d,
                                        int                dim,
@@ -592,18 +649,21 @@ static void set_dd_cell_sizes_dlb_root(gmx_domdec_t*      dd,
     }
     else if (dd_load_count(comm) > 0)
     {
+        /* The number of consecutive cells in this row sharing a physical
+         * node for two-level balancing, 1 when balancing uniformly.
+         */
+        int nodeSize = comm->ddSettings.dlbNodeSize;
+        if (nodeSize <= 1 || ncd % nodeSize != 0)
+        {
+            nodeSize = 1;
+        }
+
         real load_aver  = comm->load[d].sum_m / ncd;
         real change_max = 0;
-        real load_i;
-        real change;
         for (int i = 0; i < ncd; i++)
         {
-            /* Determine the relative imbalance of cell i */
-            load_i         = comm->load[d].load[i * comm->load[d].nload + 2];
-            real imbalance = (load_i - load_aver) / (load_aver > 0 ? load_aver : 1);
-            /* Determine the change of the cell size using underrelaxation */
-            change     = -c_relax * imbalance;
-            change_max = std::max(change_max, std::max(change, -change));
+            const real change = dlb_cell_size_change(comm->load[d], i, nodeSize, load_aver, c_relax);
+            change_max        = std::max(change_max, std::max(change, -change));
         }
         /* Limit the amount of scaling.
          * We need to use the same rescaling for all cells in one row,
@@ -616,11 +676,7 @@ static void set_dd_cell_sizes_dlb_root(gmx_domdec_t*      dd,
         }
         for (int i = 0; i < ncd; i++)
         {
-            /* Determine the relative imbalance of cell i */
-            load_i         = comm->load[d].load[i * comm->load[d].nload + 2];
-            real imbalance = (load_i - load_aver) / (load_aver > 0 ? load_aver : 1);
-            /* Determine the change of the cell size using underrelaxation */
-            change       = -sc * imbalance;
+            const real change = dlb_cell_size_change(comm->load[d], i, nodeSize, load_aver, sc);
             cell_size[i] = (rowMaster->cellFrac[i + 1] - rowMaster->cellFrac[i]) * (1 + change);
         }
     }
@@ -699,6 +755,25 @@ static void set_dd_cell_sizes_dlb_root(gmx_domdec_t*      dd,
         }
     }
 
+    if (!bUniform && dd_load_count(comm) > 0)
+    {
+        /* Track the direction of the boundary moves. Boundaries that reverse
+         * direction at (nearly) every update indicate that the balancing
+         * oscillates instead of converging, which is diagnosed in the load
+         * balancing report.
+         */
+        for (int i = 1; i < ncd; i++)
+        {
+            const real shift = rowMaster->cellFrac[i] - rowMaster->oldCellFrac[i];
+            if (rowMaster->numBoundaryUpdates > 0 && shift * rowMaster->prevBoundaryShift[i] < 0)
+            {
+                rowMaster->boundaryFlipCount[i]++;
+            }
+            rowMaster->prevBoundaryShift[i] = shift;
+        }
+        rowMaster->numBoundaryUpdates++;
+    }
+
     int pos = ncd + 1;
     /* Store the cell boundaries of the lower dimensions at the end */
     for (int d1 = 0; d1 < d; d1++)
@@ -52,6 +52,7 @@
 struct gmx_ddbox_t;
 struct gmx_domdec_comm_t;
 struct gmx_domdec_t;
+struct RowMaster;
 
 /*! \brief Options for setting up a regular, possibly static load balanced, cell grid geometry */
 enum
@@ -64,6 +65,13 @@ enum
 /*! \brief Returns the minimum allowed distance between lower and upper bounds of zones along dimension dim_ind */
 real grid_jump_limit(const gmx_domdec_comm_t* comm, real cutoff, int dim_ind);
 
+/*! \brief Returns the fraction of DLB updates in which a cell boundary of this row reversed its direction of motion
+ *
+ * A fraction close to 1 means the load balancing oscillates instead of
+ * converging, which is diagnosed in the load balancing report.
+ */
+float dd_dlb_boundary_flip_fraction(const RowMaster& rowMaster);
+
 /*! \brief Sets up an initial, non-staggered grid geometry, possibly using static load balancing
  *
  * The number of communication pulses per dimension is returned in numPulses.
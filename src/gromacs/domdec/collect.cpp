@@ -225,6 +225,80 @@ static void dd_collect_vec_gatherv(gmx_domdec_t*                  dd,
     }
 }
 
+#if GMX_LIB_MPI
+/*! \brief Collects \p lv to \p v on the master using a non-blocking gather
+ *
+ * Non-master ranks copy their contribution to a dedicated send buffer and
+ * return without waiting for completion, so they can proceed with the next
+ * MD steps while the master unpacks the data and writes the output. The
+ * outstanding request is completed at the start of the next collect call,
+ * before the send buffer is reused.
+ */
+static void dd_collect_vec_igatherv(gmx_domdec_t*                  dd,
+                                    gmx::ArrayRef<const gmx::RVec> lv,
+                                    gmx::ArrayRef<gmx::RVec>       v)
+{
+    gmx_domdec_comm_t& comm = *dd->comm;
+
+    /* Complete a possibly outstanding gather before reusing the buffers */
+    MPI_Wait(&comm.collectRequest, MPI_STATUS_IGNORE);
+
+    const int numHomeAtoms = comm.atomRanges.numHomeAtoms();
+
+    int* recvCounts    = nullptr;
+    int* displacements = nullptr;
+
+    const void* sendBuffer;
+    if (DDMASTER(dd))
+    {
+        get_commbuffer_counts(dd->ma.get(), &recvCounts, &displacements);
+
+        /* With few ranks the receive buffer is not allocated at setup,
+         * since then the blocking path uses send/receive instead.
+         */
+        const size_t totalBytes = displacements[dd->nnodes - 1] + recvCounts[dd->nnodes - 1];
+        if (dd->ma->rvecBuffer.size() * sizeof(rvec) < totalBytes)
+        {
+            dd->ma->rvecBuffer.resize(totalBytes / sizeof(rvec));
+        }
+
+        /* The master waits for the gather below, so it can send in place */
+        sendBuffer = lv.data();
+    }
+    else
+    {
+        /* Copy our contribution to a dedicated buffer, so the integrator
+         * can modify lv while the gather is still in progress.
+         */
+        comm.collectSendBuffer.assign(lv.begin(), lv.begin() + numHomeAtoms);
+
+        sendBuffer = comm.collectSendBuffer.data();
+    }
+
+    MPI_Igatherv(const_cast<void*>(sendBuffer), numHomeAtoms * sizeof(rvec), MPI_BYTE,
+                 DDMASTER(dd) ? dd->ma->rvecBuffer.data() : nullptr, recvCounts, displacements,
+                 MPI_BYTE, dd->masterrank, dd->mpi_comm_all, &comm.collectRequest);
+
+    if (DDMASTER(dd))
+    {
+        /* The master needs the data now for writing the output */
+        MPI_Wait(&comm.collectRequest, MPI_STATUS_IGNORE);
+
+        const AtomDistribution& ma = *dd->ma;
+
+        int bufferAtom = 0;
+        for (int rank = 0; rank < dd->nnodes; rank++)
+        {
+            const auto& domainGroups = ma.domainGroups[rank];
+            for (const int& globalAtom : domainGroups.atomGroups)
+            {
+                copy_rvec(ma.rvecBuffer[bufferAtom++], v[globalAtom]);
+            }
+        }
+    }
+}
+#endif // GMX_LIB_MPI
+
 void dd_collect_vec(gmx_domdec_t*                  dd,
                     const t_state*                 state_local,
                     gmx::ArrayRef<const gmx::RVec> lv,
@@ -232,6 +306,15 @@ void dd_collect_vec(gmx_domdec_t*                  dd,
 {
     dd_collect_cg(dd, state_local);
 
+#if GMX_LIB_MPI
+    if (dd->comm->ddSettings.useAsyncStateCollection && dd->nnodes > 1)
+    {
+        dd_collect_vec_igatherv(dd, lv, v);
+
+        return;
+    }
+#endif
+
     if (dd->nnodes <= c_maxNumRanksUseSendRecvForScatterAndGather)
     {
         dd_collect_vec_sendrecv(dd, lv, v);
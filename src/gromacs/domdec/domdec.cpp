@@ -269,6 +269,8 @@ void dd_move_x(gmx_domdec_t* dd, const matrix box, gmx::ArrayRef<gmx::RVec> x, g
 
     comm = dd->comm;
 
+    const bool useNonblockingHalo = comm->ddSettings.useNonblockingHalo;
+
     nzone   = 1;
     nat_tot = comm->atomRanges.numHomeAtoms();
     for (int d = 0; d < dd->ndim; d++)
@@ -280,11 +282,39 @@ void dd_move_x(gmx_domdec_t* dd, const matrix box, gmx::ArrayRef<gmx::RVec> x, g
             copy_rvec(box[dd->dim[d]], shift);
         }
         cd = &comm->cd[d];
-        for (const gmx_domdec_ind_t& ind : cd->ind)
+        for (int p = 0; p < cd->numPulses(); p++)
         {
+            const gmx_domdec_ind_t& ind = cd->ind[p];
+            /* The first pulse is present on all ranks, so only that one can
+             * use the neighborhood collective; the number of later pulses
+             * can differ between ranks with dynamic load balancing.
+             */
+            const bool useNeighborhood = (comm->ddSettings.useNeighborCollectives && p == 0);
             DDBufferAccess<gmx::RVec> sendBufferAccess(comm->rvecBuffer, ind.nsend[nzone + 1]);
             gmx::ArrayRef<gmx::RVec>& sendBuffer = sendBufferAccess.buffer;
-            int                       n          = 0;
+
+            DDBufferAccess<gmx::RVec> receiveBufferAccess(
+                    comm->rvecBuffer2, cd->receiveInPlace ? 0 : ind.nrecv[nzone + 1]);
+
+            gmx::ArrayRef<gmx::RVec> receiveBuffer;
+            if (cd->receiveInPlace)
+            {
+                receiveBuffer = gmx::arrayRefFromArray(x.data() + nat_tot, ind.nrecv[nzone + 1]);
+            }
+            else
+            {
+                receiveBuffer = receiveBufferAccess.buffer;
+            }
+
+            MPI_Request requests[2];
+            if (useNonblockingHalo && !useNeighborhood)
+            {
+                /* Post the receive first, so the incoming coordinates can
+                 * arrive while we are packing the send buffer. */
+                ddPostReceive(dd, d, dddirBackward, receiveBuffer, &requests[0]);
+            }
+
+            int n = 0;
             if (!bPBC)
             {
                 for (int j : ind.index)
@@ -321,20 +351,20 @@ void dd_move_x(gmx_domdec_t* dd, const matrix box, gmx::ArrayRef<gmx::RVec> x, g
                 }
             }
 
-            DDBufferAccess<gmx::RVec> receiveBufferAccess(
-                    comm->rvecBuffer2, cd->receiveInPlace ? 0 : ind.nrecv[nzone + 1]);
-
-            gmx::ArrayRef<gmx::RVec> receiveBuffer;
-            if (cd->receiveInPlace)
+            /* Send and receive the coordinates */
+            if (useNeighborhood)
             {
-                receiveBuffer = gmx::arrayRefFromArray(x.data() + nat_tot, ind.nrecv[nzone + 1]);
+                ddNeighborhoodSendrecv(dd, d, dddirBackward, sendBuffer, receiveBuffer);
+            }
+            else if (useNonblockingHalo)
+            {
+                ddPostSend(dd, d, dddirBackward, sendBuffer, &requests[1]);
+                ddWaitall(requests);
             }
             else
             {
-                receiveBuffer = receiveBufferAccess.buffer;
+                ddSendrecv(dd, d, dddirBackward, sendBuffer, receiveBuffer);
             }
-            /* Send and receive the coordinates */
-            ddSendrecv(dd, d, dddirBackward, sendBuffer, receiveBuffer);
 
             if (!cd->receiveInPlace)
             {
@@ -365,6 +395,8 @@ void dd_move_f(gmx_domdec_t* dd, gmx::ForceWithShiftForces* forceWithShiftForces
     gmx_domdec_comm_t& comm    = *dd->comm;
     int                nzone   = comm.zones.n / 2;
     int                nat_tot = comm.atomRanges.end(DDAtomRanges::Type::Zones);
+
+    const bool useNonblockingHalo = comm.ddSettings.useNonblockingHalo;
     for (int d = dd->ndim - 1; d >= 0; d--)
     {
         /* Only forces in domains near the PBC boundaries need to
@@ -388,6 +420,20 @@ void dd_move_f(gmx_domdec_t* dd, gmx::ForceWithShiftForces* forceWithShiftForces
 
             nat_tot -= ind.nrecv[nzone + 1];
 
+            /* The first pulse is present on all ranks, so only that one can
+             * use the neighborhood collective; the number of later pulses
+             * can differ between ranks with dynamic load balancing.
+             */
+            const bool useNeighborhood = (comm.ddSettings.useNeighborCollectives && p == 0);
+
+            MPI_Request requests[2];
+            if (useNonblockingHalo && !useNeighborhood)
+            {
+                /* Post the receive first, so the incoming forces can arrive
+                 * while we are packing the send buffer. */
+                ddPostReceive(dd, d, dddirForward, receiveBuffer, &requests[0]);
+            }
+
             DDBufferAccess<gmx::RVec> sendBufferAccess(
                     comm.rvecBuffer2, cd.receiveInPlace ? 0 : ind.nrecv[nzone + 1]);
 
@@ -409,7 +455,19 @@ void dd_move_f(gmx_domdec_t* dd, gmx::ForceWithShiftForces* forceWithShiftForces
                 }
             }
             /* Communicate the forces */
-            ddSendrecv(dd, d, dddirForward, sendBuffer, receiveBuffer);
+            if (useNeighborhood)
+            {
+                ddNeighborhoodSendrecv(dd, d, dddirForward, sendBuffer, receiveBuffer);
+            }
+            else if (useNonblockingHalo)
+            {
+                ddPostSend(dd, d, dddirForward, sendBuffer, &requests[1]);
+                ddWaitall(requests);
+            }
+            else
+            {
+                ddSendrecv(dd, d, dddirForward, sendBuffer, receiveBuffer);
+            }
             /* Add the received forces */
             int n = 0;
             if (!shiftForcesNeedPbc)
@@ -1076,6 +1134,8 @@ static void make_load_communicator(gmx_domdec_t* dd, int dim_ind, ivec loc)
                     rowMaster.bounds.resize(dd->numCells[dim]);
                 }
                 rowMaster.buf_ncd.resize(dd->numCells[dim]);
+                rowMaster.prevBoundaryShift.resize(dd->numCells[dim] + 1);
+                rowMaster.boundaryFlipCount.resize(dd->numCells[dim] + 1);
             }
             else
             {
@@ -1301,6 +1361,25 @@ static void setup_neighbor_relations(gmx_domdec_t* dd)
         dd->comm->cellsizesWithDlb.resize(dd->ndim);
     }
 
+#if GMX_LIB_MPI
+    if (dd->comm->ddSettings.useNeighborCollectives)
+    {
+        /* The halo neighbor ranks are fixed for the whole run, so we can
+         * build one distributed graph communicator per dimension here and
+         * use neighborhood collectives for the halo exchange. This exposes
+         * the regular halo pattern to the MPI library, which can offload
+         * it to hardware collective engines on networks that have them.
+         */
+        for (d = 0; d < dd->ndim; d++)
+        {
+            int neighborRanks[2] = { dd->neighbor[d][0], dd->neighbor[d][1] };
+            MPI_Dist_graph_create_adjacent(dd->mpi_comm_all, 2, neighborRanks, MPI_UNWEIGHTED, 2,
+                                           neighborRanks, MPI_UNWEIGHTED, MPI_INFO_NULL, FALSE,
+                                           &dd->comm->mpi_comm_neighbor[d]);
+        }
+    }
+#endif
+
     if (dd->comm->ddSettings.recordLoad)
     {
         make_load_communicators(dd);
@@ -2856,7 +2935,11 @@ static DDSettings getDDSettings(const gmx::MDLogger&     mdlog,
     DDSettings ddSettings;
 
     ddSettings.useSendRecv2        = (dd_getenv(mdlog, "GMX_DD_USE_SENDRECV2", 0) != 0);
+    ddSettings.useNonblockingHalo  = (dd_getenv(mdlog, "GMX_DD_NONBLOCKING_HALO", 0) != 0);
+    ddSettings.useNeighborCollectives = (dd_getenv(mdlog, "GMX_DD_NEIGHBOR_COLLECTIVES", 0) != 0);
+    ddSettings.useAsyncStateCollection = (dd_getenv(mdlog, "GMX_DD_ASYNC_COLLECT", 0) != 0);
     ddSettings.dlb_scale_lim       = dd_getenv(mdlog, "GMX_DLB_MAX_BOX_SCALING", 10);
+    ddSettings.dlbNodeSize         = dd_getenv(mdlog, "GMX_DLB_NODE_SIZE", 1);
     ddSettings.request1D           = bool(dd_getenv(mdlog, "GMX_DD_1D", 0));
     ddSettings.useDDOrderZYX       = bool(dd_getenv(mdlog, "GMX_DD_ORDER_ZYX", 0));
     ddSettings.useCartesianReorder = bool(dd_getenv(mdlog, "GMX_NO_CART_REORDER", 1));
@@ -2875,6 +2958,62 @@ static DDSettings getDDSettings(const gmx::MDLogger&     mdlog,
                         "communication");
     }
 
+    if (ddSettings.useNonblockingHalo)
+    {
+        GMX_LOG(mdlog.info)
+                .appendText(
+                        "Will use non-blocking MPI calls for the halo exchange, with the receive "
+                        "posted before packing the send buffer");
+    }
+
+    if (ddSettings.useNeighborCollectives)
+    {
+        if (GMX_LIB_MPI)
+        {
+            GMX_LOG(mdlog.info)
+                    .appendText(
+                            "Will use MPI neighborhood collectives on a persistent graph "
+                            "communicator for the first halo exchange pulse along each dimension");
+        }
+        else
+        {
+            /* Thread-MPI does not provide neighborhood collectives */
+            ddSettings.useNeighborCollectives = false;
+            GMX_LOG(mdlog.info)
+                    .appendText(
+                            "Ignoring GMX_DD_NEIGHBOR_COLLECTIVES, MPI neighborhood collectives "
+                            "require an MPI library build");
+        }
+    }
+
+    if (ddSettings.useAsyncStateCollection)
+    {
+        if (GMX_LIB_MPI)
+        {
+            GMX_LOG(mdlog.info)
+                    .appendText(
+                            "Will use a non-blocking gather for collecting state vectors on the "
+                            "master rank, so non-master ranks can proceed while output is written");
+        }
+        else
+        {
+            ddSettings.useAsyncStateCollection = false;
+            GMX_LOG(mdlog.info)
+                    .appendText(
+                            "Ignoring GMX_DD_ASYNC_COLLECT, the non-blocking gather requires an "
+                            "MPI library build");
+        }
+    }
+
+    if (ddSettings.dlbNodeSize > 1)
+    {
+        GMX_LOG(mdlog.info)
+                .appendTextFormatted(
+                        "Will balance the domain decomposition load in two levels, treating groups "
+                        "of %d consecutive ranks as one physical node",
+                        ddSettings.dlbNodeSize);
+    }
+
     if (ddSettings.eFlop)
     {
         GMX_LOG(mdlog.info).appendText("Will load balance based on FLOP count");
@@ -3203,9 +3342,7 @@ gmx_bool change_dd_cutoff(t_commrec* cr, const matrix box, gmx::ArrayRef<const g
 void constructGpuHaloExchange(const gmx::MDLogger& mdlog, const t_commrec& cr, void* streamLocal, void* streamNonLocal)
 {
 
-    int gpuHaloExchangeSize = 0;
-    int pulseStart          = 0;
-    if (cr.dd->gpuHaloExchange.empty())
+    if (cr.dd->gpuHaloExchange[0].empty())
     {
         GMX_LOG(mdlog.warning)
                 .asParagraph()
@@ -3214,17 +3351,15 @@ void constructGpuHaloExchange(const gmx::MDLogger& mdlog, const t_commrec& cr, v
                         "by the "
                         "GMX_GPU_DD_COMMS environment variable.");
     }
-    else
-    {
-        gpuHaloExchangeSize = static_cast<int>(cr.dd->gpuHaloExchange.size());
-        pulseStart          = gpuHaloExchangeSize - 1;
-    }
-    if (cr.dd->comm->cd[0].numPulses() > gpuHaloExchangeSize)
+    for (int d = 0; d < cr.dd->ndim; d++)
     {
-        for (int pulse = pulseStart; pulse < cr.dd->comm->cd[0].numPulses(); pulse++)
+        /* The number of pulses can grow after repartitioning, extend the
+         * list of exchange objects for the new pulses of this dimension. */
+        for (int pulse = static_cast<int>(cr.dd->gpuHaloExchange[d].size());
+             pulse < cr.dd->comm->cd[d].numPulses(); pulse++)
         {
-            cr.dd->gpuHaloExchange.push_back(std::make_unique<gmx::GpuHaloExchange>(
-                    cr.dd, cr.mpi_comm_mysim, streamLocal, streamNonLocal, pulse));
+            cr.dd->gpuHaloExchange[d].push_back(std::make_unique<gmx::GpuHaloExchange>(
+                    cr.dd, d, cr.mpi_comm_mysim, streamLocal, streamNonLocal, pulse));
         }
     }
 }
@@ -3233,9 +3368,12 @@ void reinitGpuHaloExchange(const t_commrec&              cr,
                            const DeviceBuffer<gmx::RVec> d_coordinatesBuffer,
                            const DeviceBuffer<gmx::RVec> d_forcesBuffer)
 {
-    for (int pulse = 0; pulse < cr.dd->comm->cd[0].numPulses(); pulse++)
+    for (int d = 0; d < cr.dd->ndim; d++)
     {
-        cr.dd->gpuHaloExchange[pulse]->reinitHalo(d_coordinatesBuffer, d_forcesBuffer);
+        for (int pulse = 0; pulse < cr.dd->comm->cd[d].numPulses(); pulse++)
+        {
+            cr.dd->gpuHaloExchange[d][pulse]->reinitHalo(d_coordinatesBuffer, d_forcesBuffer);
+        }
     }
 }
 
@@ -3243,16 +3381,24 @@ void communicateGpuHaloCoordinates(const t_commrec&      cr,
                                    const matrix          box,
                                    GpuEventSynchronizer* coordinatesReadyOnDeviceEvent)
 {
-    for (int pulse = 0; pulse < cr.dd->comm->cd[0].numPulses(); pulse++)
+    for (int d = 0; d < cr.dd->ndim; d++)
     {
-        cr.dd->gpuHaloExchange[pulse]->communicateHaloCoordinates(box, coordinatesReadyOnDeviceEvent);
+        for (int pulse = 0; pulse < cr.dd->comm->cd[d].numPulses(); pulse++)
+        {
+            cr.dd->gpuHaloExchange[d][pulse]->communicateHaloCoordinates(box, coordinatesReadyOnDeviceEvent);
+        }
     }
 }
 
 void communicateGpuHaloForces(const t_commrec& cr, bool accumulateForces)
 {
-    for (int pulse = cr.dd->comm->cd[0].numPulses() - 1; pulse >= 0; pulse--)
+    /* The force halos are communicated in the reverse order of the
+     * coordinate halos, like in dd_move_f(). */
+    for (int d = cr.dd->ndim - 1; d >= 0; d--)
     {
-        cr.dd->gpuHaloExchange[pulse]->communicateHaloForces(accumulateForces);
+        for (int pulse = cr.dd->comm->cd[d].numPulses() - 1; pulse >= 0; pulse--)
+        {
+            cr.dd->gpuHaloExchange[d][pulse]->communicateHaloForces(accumulateForces);
+        }
     }
 }
@@ -56,7 +56,7 @@ struct t_commrec;
 
 /*! \cond INTERNAL */
 
-#define DD_NLOAD_MAX 9
+#define DD_NLOAD_MAX 10
 
 struct BalanceRegion;
 
@@ -119,6 +119,12 @@ struct RowMaster
     std::vector<Bounds> bounds;
     /**< State var.: is DLB limited in this row */
     bool dlbIsLimited = false;
+    /**< State var.: boundary shift of the last update, for oscillation detection */
+    std::vector<real> prevBoundaryShift;
+    /**< State var.: per boundary, the number of updates where the shift reversed direction */
+    std::vector<int> boundaryFlipCount;
+    /**< State var.: the number of load balancing boundary updates performed */
+    int numBoundaryUpdates = 0;
     /**< Temp. var.  */
     std::vector<real> buf_ncd;
 };
@@ -165,6 +171,8 @@ typedef struct
     float pme = 0;
     /**< Bit flags that tell if DLB was limited, per dimension */
     int flags = 0;
+    /**< Max over the rows of the fraction of DLB updates with a direction reversal */
+    float flipFrac = 0;
 } domdec_load_t;
 
 /*! \brief Data needed to sort an atom to the desired location in the local state */
@@ -467,9 +475,20 @@ struct DDSettings
     //! Use MPI_Sendrecv communication instead of non-blocking calls
     bool useSendRecv2 = false;
 
+    //! Use non-blocking halo communication with the receive posted before packing the send buffer
+    bool useNonblockingHalo = false;
+
+    //! Use MPI neighborhood collectives on a persistent graph communicator for the halo exchange
+    bool useNeighborCollectives = false;
+
+    //! Use a non-blocking gather for collecting state vectors on the master rank
+    bool useAsyncStateCollection = false;
+
     /* Information for managing the dynamic load balancing */
     //! Maximum DLB scaling per load balancing step in percent
     int dlb_scale_lim = 0;
+    //! Number of consecutive ranks in a DD row sharing a physical node, for two-level DLB
+    int dlbNodeSize = 1;
     //! Flop counter (0=no,1=yes,2=with (eFlop-1)*5% noise
     int eFlop = 0;
 
@@ -664,6 +683,9 @@ struct gmx_domdec_comm_t // NOLINT (clang-analyzer-optin.performance.Padding)
     /**< Another rvec comm. buffer */
     DDBuffer<gmx::RVec> rvecBuffer2;
 
+    /**< Send buffer of the non-blocking state vector gather, used with GMX_DD_ASYNC_COLLECT */
+    std::vector<gmx::RVec> collectSendBuffer;
+
     /* Communication buffers for local redistribution */
     /**< Charge group flag comm. buffers */
     std::array<std::vector<int>, DIM * 2> cggl_flag;
@@ -683,6 +705,12 @@ struct gmx_domdec_comm_t // NOLINT (clang-analyzer-optin.performance.Padding)
     MPI_Comm* mpi_comm_load = nullptr;
     /**< The MPI load communicator for ranks sharing a GPU */
     MPI_Comm mpi_comm_gpu_shared;
+    /**< Outstanding request of the non-blocking state vector gather */
+    MPI_Request collectRequest = MPI_REQUEST_NULL;
+    /**< Per decomposition dimension, the distributed graph communicator
+     *   connecting the halo neighbor ranks, used for neighborhood
+     *   collectives; only set up with GMX_DD_NEIGHBOR_COLLECTIVES */
+    MPI_Comm mpi_comm_neighbor[DIM] = { MPI_COMM_NULL, MPI_COMM_NULL, MPI_COMM_NULL };
 #endif
 
     /**< Struct for timing the force load balancing region */
@@ -735,6 +763,10 @@ struct gmx_domdec_comm_t // NOLINT (clang-analyzer-optin.performance.Padding)
     double load_mdf = 0.0;
     /**< Total time on our PME-only rank */
     double load_pme = 0.0;
+    /**< The relative load imbalance of each load measurement, only set on the master */
+    std::vector<float> imbalanceTimeline;
+    /**< Max fraction of DLB updates where a cell boundary reversed direction */
+    float load_flip = 0.0;
 
     /** The last partition step */
     int64_t partition_step = INT_MIN;
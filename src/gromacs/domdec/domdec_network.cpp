@@ -51,6 +51,8 @@
 #include <cstring>
 
 #include "gromacs/domdec/domdec_struct.h"
+#include "gromacs/timing/mpi_profile.h"
+#include "gromacs/utility/gmxassert.h"
 #include "gromacs/utility/gmxmpi.h"
 
 #include "domdec_internal.h"
@@ -79,7 +81,8 @@ void ddSendrecv(const struct gmx_domdec_t* dd,
     int sendRank    = dd->neighbor[ddDimensionIndex][direction == dddirForward ? 0 : 1];
     int receiveRank = dd->neighbor[ddDimensionIndex][direction == dddirForward ? 1 : 0];
 
-    constexpr int mpiTag = 0;
+    constexpr int mpiTag       = 0;
+    const double  profileStart = mpi_profile_start();
     MPI_Status    mpiStatus;
     if (numElementsToSend > 0 && numElementsToReceive > 0)
     {
@@ -96,6 +99,8 @@ void ddSendrecv(const struct gmx_domdec_t* dd,
         MPI_Recv(receiveBuffer, numElementsToReceive * sizeof(T), MPI_BYTE, receiveRank, mpiTag,
                  dd->mpi_comm_all, &mpiStatus);
     }
+    mpi_profile_record(empcDDHALO, profileStart, numElementsToSend * sizeof(T),
+                       numElementsToReceive * sizeof(T));
 #else  // GMX_MPI
     GMX_UNUSED_VALUE(dd);
     GMX_UNUSED_VALUE(ddDimensionIndex);
@@ -132,6 +137,142 @@ template void ddSendrecv(const gmx_domdec_t*, int, int, gmx::ArrayRef<real>, gmx
 //! Specialization of extern template for gmx::RVec
 template void ddSendrecv(const gmx_domdec_t*, int, int, gmx::ArrayRef<gmx::RVec>, gmx::ArrayRef<gmx::RVec>);
 
+template<typename T>
+void ddPostReceive(const gmx_domdec_t* dd,
+                   int                 ddDimensionIndex,
+                   int                 direction,
+                   gmx::ArrayRef<T>    receiveBuffer,
+                   MPI_Request*        request)
+{
+#if GMX_MPI
+    int receiveRank = dd->neighbor[ddDimensionIndex][direction == dddirForward ? 1 : 0];
+
+    constexpr int mpiTag = 0;
+    if (!receiveBuffer.empty())
+    {
+        const double profileStart = mpi_profile_start();
+        MPI_Irecv(receiveBuffer.data(), receiveBuffer.size() * sizeof(T), MPI_BYTE, receiveRank,
+                  mpiTag, dd->mpi_comm_all, request);
+        mpi_profile_record(empcDDHALO, profileStart, 0, receiveBuffer.size() * sizeof(T));
+    }
+    else
+    {
+        *request = MPI_REQUEST_NULL;
+    }
+#else  // GMX_MPI
+    GMX_UNUSED_VALUE(dd);
+    GMX_UNUSED_VALUE(ddDimensionIndex);
+    GMX_UNUSED_VALUE(direction);
+    GMX_UNUSED_VALUE(receiveBuffer);
+    GMX_UNUSED_VALUE(request);
+#endif // GMX_MPI
+}
+
+//! Specialization of extern template for gmx::RVec
+template void ddPostReceive(const gmx_domdec_t*, int, int, gmx::ArrayRef<gmx::RVec>, MPI_Request*);
+
+template<typename T>
+void ddPostSend(const gmx_domdec_t* dd,
+                int                 ddDimensionIndex,
+                int                 direction,
+                gmx::ArrayRef<T>    sendBuffer,
+                MPI_Request*        request)
+{
+#if GMX_MPI
+    int sendRank = dd->neighbor[ddDimensionIndex][direction == dddirForward ? 0 : 1];
+
+    constexpr int mpiTag = 0;
+    if (!sendBuffer.empty())
+    {
+        const double profileStart = mpi_profile_start();
+        MPI_Isend(sendBuffer.data(), sendBuffer.size() * sizeof(T), MPI_BYTE, sendRank, mpiTag,
+                  dd->mpi_comm_all, request);
+        mpi_profile_record(empcDDHALO, profileStart, sendBuffer.size() * sizeof(T), 0);
+    }
+    else
+    {
+        *request = MPI_REQUEST_NULL;
+    }
+#else  // GMX_MPI
+    GMX_UNUSED_VALUE(dd);
+    GMX_UNUSED_VALUE(ddDimensionIndex);
+    GMX_UNUSED_VALUE(direction);
+    GMX_UNUSED_VALUE(sendBuffer);
+    GMX_UNUSED_VALUE(request);
+#endif // GMX_MPI
+}
+
+//! Specialization of extern template for gmx::RVec
+template void ddPostSend(const gmx_domdec_t*, int, int, gmx::ArrayRef<gmx::RVec>, MPI_Request*);
+
+template<typename T>
+void ddNeighborhoodSendrecv(const gmx_domdec_t* dd,
+                            int                 ddDimensionIndex,
+                            int                 direction,
+                            gmx::ArrayRef<T>    sendBuffer,
+                            gmx::ArrayRef<T>    receiveBuffer)
+{
+#if GMX_LIB_MPI
+    const MPI_Comm neighborComm = dd->comm->mpi_comm_neighbor[ddDimensionIndex];
+    GMX_ASSERT(neighborComm != MPI_COMM_NULL,
+               "The neighborhood graph communicator should have been set up");
+
+    /* Graph edges 0 and 1 are the forward and backward neighbor ranks,
+     * in the order of dd->neighbor[ddDimensionIndex].
+     */
+    int sendIndex    = (direction == dddirForward ? 0 : 1);
+    int receiveIndex = 1 - sendIndex;
+    if (dd->neighbor[ddDimensionIndex][0] == dd->neighbor[ddDimensionIndex][1])
+    {
+        /* With 2 cells both neighbors are the same rank and messages match
+         * in graph edge order, so we need to use the first edge both ways.
+         */
+        sendIndex    = 0;
+        receiveIndex = 0;
+    }
+
+    int sendCounts[2]           = { 0, 0 };
+    int receiveCounts[2]        = { 0, 0 };
+    int sendDisplacements[2]    = { 0, 0 };
+    int receiveDisplacements[2] = { 0, 0 };
+    sendCounts[sendIndex]       = sendBuffer.size() * sizeof(T);
+    receiveCounts[receiveIndex] = receiveBuffer.size() * sizeof(T);
+
+    /* MPI expects valid buffer pointers, also with only zero counts */
+    char  dummy       = 0;
+    void* sendPointer = (sendBuffer.empty() ? static_cast<void*>(&dummy)
+                                            : static_cast<void*>(sendBuffer.data()));
+    void* receivePointer = (receiveBuffer.empty() ? static_cast<void*>(&dummy)
+                                                  : static_cast<void*>(receiveBuffer.data()));
+
+    const double profileStart = mpi_profile_start();
+    MPI_Neighbor_alltoallv(sendPointer, sendCounts, sendDisplacements, MPI_BYTE, receivePointer,
+                           receiveCounts, receiveDisplacements, MPI_BYTE, neighborComm);
+    mpi_profile_record(empcDDHALO, profileStart, sendBuffer.size() * sizeof(T),
+                       receiveBuffer.size() * sizeof(T));
+#else  // GMX_LIB_MPI
+    /* Thread-MPI does not provide neighborhood collectives */
+    ddSendrecv(dd, ddDimensionIndex, direction, sendBuffer, receiveBuffer);
+#endif // GMX_LIB_MPI
+}
+
+//! Specialization of extern template for gmx::RVec
+template void ddNeighborhoodSendrecv(const gmx_domdec_t*, int, int, gmx::ArrayRef<gmx::RVec>, gmx::ArrayRef<gmx::RVec>);
+
+void ddWaitall(gmx::ArrayRef<MPI_Request> requests)
+{
+#if GMX_MPI
+    if (!requests.empty())
+    {
+        const double profileStart = mpi_profile_start();
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        mpi_profile_record(empcDDHALO, profileStart, 0, 0);
+    }
+#else  // GMX_MPI
+    GMX_UNUSED_VALUE(requests);
+#endif // GMX_MPI
+}
+
 void dd_sendrecv2_rvec(const struct gmx_domdec_t gmx_unused* dd,
                        int gmx_unused ddimind,
                        rvec gmx_unused* buf_s_fw,
@@ -151,6 +292,8 @@ void dd_sendrecv2_rvec(const struct gmx_domdec_t gmx_unused* dd,
     rank_fw = dd->neighbor[ddimind][0];
     rank_bw = dd->neighbor[ddimind][1];
 
+    const double profileStart = mpi_profile_start();
+
     if (!dd->comm->ddSettings.useSendRecv2)
     {
         /* Try to send and receive in two directions simultaneously.
@@ -200,6 +343,8 @@ void dd_sendrecv2_rvec(const struct gmx_domdec_t gmx_unused* dd,
         MPI_Sendrecv(buf_s_bw[0], n_s_bw * sizeof(rvec), MPI_BYTE, rank_bw, 0, buf_r_bw[0],
                      n_r_bw * sizeof(rvec), MPI_BYTE, rank_fw, 0, dd->mpi_comm_all, &stat[0]);
     }
+    mpi_profile_record(empcDDHALO, profileStart, (n_s_fw + n_s_bw) * sizeof(rvec),
+                       (n_r_fw + n_r_bw) * sizeof(rvec));
 #endif
 }
 
@@ -51,6 +51,7 @@
 
 #include "gromacs/math/vectypes.h"
 #include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/gmxmpi.h"
 
 struct gmx_domdec_t;
 
@@ -141,6 +142,76 @@ extern template void ddSendrecv<gmx::RVec>(const gmx_domdec_t*      dd,
                                            gmx::ArrayRef<gmx::RVec> sendBuffer,
                                            gmx::ArrayRef<gmx::RVec> receiveBuffer);
 
+/*! \brief Post a non-blocking receive for a halo communication pulse
+ *
+ * Posts the receive matching the send of \c ddSendrecv with the same
+ * dimension index and direction on the neighboring rank. Posting the
+ * receive before packing the send buffer lets the incoming message
+ * overlap with the packing. The request should be completed with
+ * ddWaitall() before the receive buffer is read.
+ * With an empty buffer no receive is posted and the request is set to null.
+ */
+template<typename T>
+void ddPostReceive(const gmx_domdec_t* dd,
+                   int                 ddDimensionIndex,
+                   int                 direction,
+                   gmx::ArrayRef<T>    receiveBuffer,
+                   MPI_Request*        request);
+
+//! Extern declaration for gmx::RVec specialization
+extern template void ddPostReceive<gmx::RVec>(const gmx_domdec_t*      dd,
+                                              int                      ddDimensionIndex,
+                                              int                      direction,
+                                              gmx::ArrayRef<gmx::RVec> receiveBuffer,
+                                              MPI_Request*             request);
+
+/*! \brief Post a non-blocking send for a halo communication pulse
+ *
+ * The counterpart of ddPostReceive(). The send buffer may not be
+ * modified until the request has been completed with ddWaitall().
+ * With an empty buffer no send is posted and the request is set to null.
+ */
+template<typename T>
+void ddPostSend(const gmx_domdec_t* dd,
+                int                 ddDimensionIndex,
+                int                 direction,
+                gmx::ArrayRef<T>    sendBuffer,
+                MPI_Request*        request);
+
+//! Extern declaration for gmx::RVec specialization
+extern template void ddPostSend<gmx::RVec>(const gmx_domdec_t*      dd,
+                                           int                      ddDimensionIndex,
+                                           int                      direction,
+                                           gmx::ArrayRef<gmx::RVec> sendBuffer,
+                                           MPI_Request*             request);
+
+/*! \brief Waits for all \p requests to complete, null requests are ignored */
+void ddWaitall(gmx::ArrayRef<MPI_Request> requests);
+
+/*! \brief Move a view of T values one cell along the domain decomposition
+ * using an MPI neighborhood collective
+ *
+ * Performs the same communication as \c ddSendrecv, but through
+ * MPI_Neighbor_alltoallv on the persistent graph communicator of the
+ * dimension indexed by ddDimensionIndex, which is set up with
+ * GMX_DD_NEIGHBOR_COLLECTIVES. This call is collective over all DD ranks,
+ * so all ranks have to call it with the same dimension index, also with
+ * empty buffers. Without a library MPI build this falls back to ddSendrecv.
+ */
+template<typename T>
+void ddNeighborhoodSendrecv(const gmx_domdec_t* dd,
+                            int                 ddDimensionIndex,
+                            int                 direction,
+                            gmx::ArrayRef<T>    sendBuffer,
+                            gmx::ArrayRef<T>    receiveBuffer);
+
+//! Extern declaration for gmx::RVec specialization
+extern template void ddNeighborhoodSendrecv<gmx::RVec>(const gmx_domdec_t*      dd,
+                                                       int                      ddDimensionIndex,
+                                                       int                      direction,
+                                                       gmx::ArrayRef<gmx::RVec> sendBuffer,
+                                                       gmx::ArrayRef<gmx::RVec> receiveBuffer);
+
 /*! \brief Move revc's in the comm. region one cell along the domain decomposition
  *
  * Moves in dimension indexed by ddimind, simultaneously in the forward
@@ -53,6 +53,9 @@
 #include <cmath>
 #include <cstdio>
 
+#include <algorithm>
+#include <array>
+
 #include "gromacs/domdec/domdec.h"
 #include "gromacs/domdec/domdec_struct.h"
 #include "gromacs/domdec/options.h"
@@ -311,6 +314,109 @@ real comm_box_frac(const gmx::IVec& dd_nc, real cutoff, const gmx_ddbox_t& ddbox
     return comm_vol;
 }
 
+/*! \internal \brief Cumulative atom distribution along the box axes
+ *
+ * Used to estimate the initial load imbalance of a candidate DD grid for
+ * systems with an inhomogeneous particle density, such as membrane or
+ * interface systems with slabs of different density.
+ */
+class AxisDensityProfile
+{
+public:
+    /*! \brief Builds the profile by binning \p x along the three box axes
+     *
+     * \param[in] x        The global coordinates, should not be empty
+     * \param[in] box      The unit cell
+     * \param[in] npbcdim  The number of dimensions with PBC
+     */
+    AxisDensityProfile(gmx::ArrayRef<const gmx::RVec> x, const matrix box, int npbcdim);
+
+    /*! \brief Returns the atom count of the fullest of \p nc equal slabs along \p dim relative to the average count
+     *
+     * The return value is >= 1, where 1 means a homogeneous distribution.
+     */
+    real slabImbalance(int dim, int nc) const;
+
+private:
+    //! The number of bins along each axis
+    static constexpr int c_numBins = 256;
+
+    //! Per dimension, cumulative atom counts at the bin boundaries
+    std::array<std::array<int, c_numBins + 1>, DIM> cumulative_;
+    //! The total number of atoms binned
+    int numAtoms_;
+};
+
+AxisDensityProfile::AxisDensityProfile(gmx::ArrayRef<const gmx::RVec> x, const matrix box, int npbcdim) :
+    numAtoms_(x.ssize())
+{
+    std::array<std::array<int, c_numBins + 1>, DIM>& count = cumulative_;
+    for (int d = 0; d < DIM; d++)
+    {
+        count[d].fill(0);
+    }
+
+    for (const gmx::RVec& xAtom : x)
+    {
+        /* Compute the triclinic fractional coordinates along the box vectors,
+         * which is the metric the DD grid decomposes along.
+         */
+        rvec frac;
+        for (int d = DIM - 1; d >= 0; d--)
+        {
+            real pos = xAtom[d];
+            for (int d2 = d + 1; d2 < DIM; d2++)
+            {
+                pos -= frac[d2] * box[d2][d];
+            }
+            frac[d] = pos / box[d][d];
+        }
+        for (int d = 0; d < DIM; d++)
+        {
+            real fracWrapped = frac[d];
+            if (d < npbcdim)
+            {
+                /* The input coordinates can be (slightly) outside the box */
+                fracWrapped -= std::floor(fracWrapped);
+            }
+            const int bin = std::max(0, std::min(static_cast<int>(fracWrapped * c_numBins), c_numBins - 1));
+            count[d][bin + 1]++;
+        }
+    }
+
+    for (int d = 0; d < DIM; d++)
+    {
+        for (int bin = 0; bin < c_numBins; bin++)
+        {
+            count[d][bin + 1] += count[d][bin];
+        }
+    }
+}
+
+real AxisDensityProfile::slabImbalance(int dim, int nc) const
+{
+    const std::array<int, c_numBins + 1>& count = cumulative_[dim];
+
+    /* Returns the cumulative count at fraction f, interpolating within bins */
+    auto cumulativeAt = [&count](real f) {
+        const real binPos  = f * c_numBins;
+        const int  bin     = std::max(0, std::min(static_cast<int>(binPos), c_numBins - 1));
+        const real binFrac = binPos - bin;
+
+        return count[bin] + binFrac * (count[bin + 1] - count[bin]);
+    };
+
+    real maxSlabCount = 0;
+    for (int slab = 0; slab < nc; slab++)
+    {
+        const real slabCount =
+                cumulativeAt(static_cast<real>(slab + 1) / nc) - cumulativeAt(static_cast<real>(slab) / nc);
+        maxSlabCount = std::max(maxSlabCount, slabCount);
+    }
+
+    return maxSlabCount * nc / numAtoms_;
+}
+
 /*! \brief Return whether the DD inhomogeneous in the z direction */
 static gmx_bool inhomogeneous_z(const t_inputrec& ir)
 {
@@ -340,15 +446,16 @@ static float comm_pme_cost_vol(int npme, int a, int b, int c)
 }
 
 /*! \brief Estimate cost of communication for a possible domain decomposition. */
-static float comm_cost_est(real               limit,
-                           real               cutoff,
-                           const matrix       box,
-                           const gmx_ddbox_t& ddbox,
-                           int                natoms,
-                           const t_inputrec&  ir,
-                           float              pbcdxr,
-                           int                npme_tot,
-                           const gmx::IVec&   nc)
+static float comm_cost_est(real                      limit,
+                           real                      cutoff,
+                           const matrix              box,
+                           const gmx_ddbox_t&        ddbox,
+                           int                       natoms,
+                           const t_inputrec&         ir,
+                           float                     pbcdxr,
+                           int                       npme_tot,
+                           const AxisDensityProfile* densityProfile,
+                           const gmx::IVec&          nc)
 {
     gmx::IVec npme = { 1, 1, 1 };
     int       i, j, nk, overlap;
@@ -540,32 +647,54 @@ static float comm_cost_est(real               limit,
         }
     }
 
+    /* Estimate the initial load imbalance caused by an inhomogeneous
+     * particle density. Until DLB has converged, the fullest domain sets
+     * the pace, so we weight the particle-particle cost of each dimension
+     * choice with the relative density of the fullest slab along each
+     * decomposed dimension. For homogeneous systems this factor is
+     * close to 1 for all choices and does not affect the result.
+     */
+    float densityImbalance = 1;
+    if (densityProfile != nullptr)
+    {
+        for (i = 0; i < DIM; i++)
+        {
+            if (nc[i] > 1)
+            {
+                densityImbalance *= densityProfile->slabImbalance(i, nc[i]);
+            }
+        }
+    }
+
     if (debug)
     {
-        fprintf(debug, "nc %2d %2d %2d %2d %2d vol pp %6.4f pbcdx %6.4f pme %9.3e tot %9.3e\n",
-                nc[XX], nc[YY], nc[ZZ], npme[XX], npme[YY], comm_vol, cost_pbcdx,
-                comm_pme / (3 * natoms), comm_vol + cost_pbcdx + comm_pme / (3 * natoms));
+        fprintf(debug,
+                "nc %2d %2d %2d %2d %2d vol pp %6.4f pbcdx %6.4f imb %6.4f pme %9.3e tot %9.3e\n",
+                nc[XX], nc[YY], nc[ZZ], npme[XX], npme[YY], comm_vol, cost_pbcdx, densityImbalance,
+                comm_pme / (3 * natoms),
+                comm_vol * densityImbalance + cost_pbcdx + comm_pme / (3 * natoms));
     }
 
-    return 3 * natoms * (comm_vol + cost_pbcdx) + comm_pme;
+    return 3 * natoms * (comm_vol * densityImbalance + cost_pbcdx) + comm_pme;
 }
 
 /*! \brief Assign penalty factors to possible domain decompositions,
  * based on the estimated communication costs. */
-static void assign_factors(const real         limit,
-                           const bool         request1D,
-                           const real         cutoff,
-                           const matrix       box,
-                           const gmx_ddbox_t& ddbox,
-                           int                natoms,
-                           const t_inputrec&  ir,
-                           float              pbcdxr,
-                           int                npme,
-                           int                ndiv,
-                           const int*         div,
-                           const int*         mdiv,
-                           gmx::IVec*         irTryPtr,
-                           gmx::IVec*         opt)
+static void assign_factors(const real                limit,
+                           const bool                request1D,
+                           const real                cutoff,
+                           const matrix              box,
+                           const gmx_ddbox_t&        ddbox,
+                           int                       natoms,
+                           const t_inputrec&         ir,
+                           float                     pbcdxr,
+                           int                       npme,
+                           const AxisDensityProfile* densityProfile,
+                           int                       ndiv,
+                           const int*                div,
+                           const int*                mdiv,
+                           gmx::IVec*                irTryPtr,
+                           gmx::IVec*                opt)
 {
     int        x, y, i;
     float      ce;
@@ -582,10 +711,11 @@ static void assign_factors(const real         limit,
             return;
         }
 
-        ce = comm_cost_est(limit, cutoff, box, ddbox, natoms, ir, pbcdxr, npme, ir_try);
+        ce = comm_cost_est(limit, cutoff, box, ddbox, natoms, ir, pbcdxr, npme, densityProfile, ir_try);
         if (ce >= 0
             && ((*opt)[XX] == 0
-                || ce < comm_cost_est(limit, cutoff, box, ddbox, natoms, ir, pbcdxr, npme, *opt)))
+                || ce < comm_cost_est(limit, cutoff, box, ddbox, natoms, ir, pbcdxr, npme,
+                                      densityProfile, *opt)))
         {
             *opt = ir_try;
         }
@@ -611,8 +741,8 @@ static void assign_factors(const real         limit,
             }
 
             /* recurse */
-            assign_factors(limit, request1D, cutoff, box, ddbox, natoms, ir, pbcdxr, npme, ndiv - 1,
-                           div + 1, mdiv + 1, irTryPtr, opt);
+            assign_factors(limit, request1D, cutoff, box, ddbox, natoms, ir, pbcdxr, npme,
+                           densityProfile, ndiv - 1, div + 1, mdiv + 1, irTryPtr, opt);
 
             for (i = 0; i < mdiv[0] - x - y; i++)
             {
@@ -635,16 +765,17 @@ static void assign_factors(const real         limit,
  *
  * \returns The optimal grid cell choice. The latter will contain all
  *          zeros if no valid cell choice exists. */
-static gmx::IVec optimizeDDCells(const gmx::MDLogger& mdlog,
-                                 const int            numRanksRequested,
-                                 const int            numPmeOnlyRanks,
-                                 const real           cellSizeLimit,
-                                 const bool           request1D,
-                                 const gmx_mtop_t&    mtop,
-                                 const matrix         box,
-                                 const gmx_ddbox_t&   ddbox,
-                                 const t_inputrec&    ir,
-                                 const DDSystemInfo&  systemInfo)
+static gmx::IVec optimizeDDCells(const gmx::MDLogger&           mdlog,
+                                 const int                      numRanksRequested,
+                                 const int                      numPmeOnlyRanks,
+                                 const real                     cellSizeLimit,
+                                 const bool                     request1D,
+                                 const gmx_mtop_t&              mtop,
+                                 const matrix                   box,
+                                 const gmx_ddbox_t&             ddbox,
+                                 const t_inputrec&              ir,
+                                 gmx::ArrayRef<const gmx::RVec> xGlobal,
+                                 const DDSystemInfo&            systemInfo)
 {
     double pbcdxr;
 
@@ -714,10 +845,21 @@ static gmx::IVec optimizeDDCells(const gmx::MDLogger& mdlog,
     std::vector<int> mdiv;
     factorize(numPPRanks, &div, &mdiv);
 
+    /* Estimate the initial load imbalance of the grid candidates from the
+     * particle distribution, so inhomogeneous systems start with balanced
+     * domains instead of needing many DLB steps to converge.
+     */
+    std::unique_ptr<AxisDensityProfile> densityProfile;
+    if (!xGlobal.empty())
+    {
+        densityProfile = std::make_unique<AxisDensityProfile>(xGlobal, box, ddbox.npbcdim);
+    }
+
     gmx::IVec itry       = { 1, 1, 1 };
     gmx::IVec numDomains = { 0, 0, 0 };
     assign_factors(cellSizeLimit, request1D, systemInfo.cutoff, box, ddbox, mtop.natoms, ir, pbcdxr,
-                   numRanksDoingPmeWork, div.size(), div.data(), mdiv.data(), &itry, &numDomains);
+                   numRanksDoingPmeWork, densityProfile.get(), div.size(), div.data(), mdiv.data(),
+                   &itry, &numDomains);
 
     return numDomains;
 }
@@ -935,7 +1077,7 @@ DDGridSetup getDDGridSetup(const gmx::MDLogger&           mdlog,
         if (MASTER(cr))
         {
             numDomains = optimizeDDCells(mdlog, numRanksRequested, numPmeOnlyRanks, cellSizeLimit,
-                                         ddSettings.request1D, mtop, box, *ddbox, ir, systemInfo);
+                                         ddSettings.request1D, mtop, box, *ddbox, ir, xGlobal, systemInfo);
         }
     }
 
@@ -178,6 +178,7 @@ struct gmx_domdec_t
     int                   pme_nodeid           = 0;
     gmx_bool              pme_receive_vir_ener = false;
     gmx_pme_comm_n_box_t* cnb                  = nullptr;
+    int                   cnb_slot             = 0;
     int                   nreq_pme             = 0;
     MPI_Request           req_pme[8];
 
@@ -236,8 +237,8 @@ struct gmx_domdec_t
     /* gmx_pme_recv_f buffer */
     std::vector<gmx::RVec> pmeForceReceiveBuffer;
 
-    /* GPU halo exchange object */
-    std::vector<std::unique_ptr<gmx::GpuHaloExchange>> gpuHaloExchange;
+    /* GPU halo exchange objects: one vector of pulses per dimension */
+    std::array<std::vector<std::unique_ptr<gmx::GpuHaloExchange>>, DIM> gpuHaloExchange;
 };
 
 //! Are we the master node for domain decomposition
@@ -84,6 +84,7 @@
 #include "gromacs/utility/stringstream.h"
 #include "gromacs/utility/stringutil.h"
 #include "gromacs/utility/textwriter.h"
+#include "gromacs/utility/threadscratch.h"
 
 #include "domdec_constraints.h"
 #include "domdec_internal.h"
@@ -132,9 +133,11 @@ struct gmx_reverse_top_t
     bool bBCheck = false;
     //! \brief Are there bondeds/exclusions between atoms?
     bool bInterAtomicInteractions = false;
-    //! \brief Reverse ilist for all moltypes
+    //! \brief Reverse ilist for all moltypes, only filled for interned moltypes
     std::vector<reverse_ilist_t> ril_mt;
-    //! \brief The size of ril_mt[?].index summed over all entries
+    //! \brief For each moltype, the moltype with identical ilists whose ril_mt entry is shared
+    std::vector<int> ril_mt_intern;
+    //! \brief The size of ril_mt[?].index summed over all interned entries
     int ril_mt_tot_size = 0;
     //! \brief The sorting state of bondeds for free energy
     int ilsort = ilsortUNKNOWN;
@@ -146,6 +149,16 @@ struct gmx_reverse_top_t
     //! \brief Intermolecular reverse ilist
     reverse_ilist_t ril_intermol;
 
+    /* Cache for reusing the local topology when the zone atom assignment
+     * is unchanged between repartitionings
+     */
+    //! \brief The local topology the cached zone assignment was built for
+    const gmx_localtop_t* cachedLocalTopology = nullptr;
+    //! \brief The zone atom ranges the local topology was built for
+    std::vector<int> cachedZoneRanges;
+    //! \brief The global atom indices the local topology was built for
+    std::vector<int> cachedGlobalAtomIndices;
+
     /* Work data structures for multi-threading */
     //! \brief Thread work array for local topology generation
     std::vector<thread_work_t> th_work;
@@ -323,9 +336,9 @@ static void print_missing_interactions_atoms(const gmx::MDLogger& mdlog,
         a_end                        = a_start + molb.nmol * moltype.atoms.nr;
 
         GMX_LOG(mdlog.warning)
-                .appendText(print_missing_interactions_mb(cr, rt, *(moltype.name),
-                                                          &rt->ril_mt[molb.type], a_start, a_end,
-                                                          moltype.atoms.nr, molb.nmol, idef));
+                .appendText(print_missing_interactions_mb(
+                        cr, rt, *(moltype.name), &rt->ril_mt[rt->ril_mt_intern[molb.type]], a_start,
+                        a_end, moltype.atoms.nr, molb.nmol, idef));
     }
 }
 
@@ -624,6 +637,8 @@ static gmx_reverse_top_t make_reverse_top(const gmx_mtop_t* mtop,
 
     rt.bInterAtomicInteractions = mtop->bIntermolecularInteractions;
     rt.ril_mt.resize(mtop->moltype.size());
+    /* Molecule types with identical ilists share one reverse ilist */
+    rt.ril_mt_intern   = gmx_mtop_ilist_intern_index(*mtop);
     rt.ril_mt_tot_size = 0;
     std::vector<int> nint_mt;
     for (size_t mt = 0; mt < mtop->moltype.size(); mt++)
@@ -634,12 +649,20 @@ static gmx_reverse_top_t make_reverse_top(const gmx_mtop_t* mtop,
             rt.bInterAtomicInteractions = true;
         }
 
-        /* Make the atom to interaction list for this molecule type */
-        int numberOfInteractions = make_reverse_ilist(
-                molt.ilist, &molt.atoms, rt.bConstr, rt.bSettle, rt.bBCheck, FALSE, &rt.ril_mt[mt]);
-        nint_mt.push_back(numberOfInteractions);
+        if (rt.ril_mt_intern[mt] == static_cast<int>(mt))
+        {
+            /* Make the atom to interaction list for this molecule type */
+            int numberOfInteractions = make_reverse_ilist(
+                    molt.ilist, &molt.atoms, rt.bConstr, rt.bSettle, rt.bBCheck, FALSE, &rt.ril_mt[mt]);
+            nint_mt.push_back(numberOfInteractions);
 
-        rt.ril_mt_tot_size += rt.ril_mt[mt].index[molt.atoms.nr];
+            rt.ril_mt_tot_size += rt.ril_mt[mt].index[molt.atoms.nr];
+        }
+        else
+        {
+            /* Identical to an earlier molecule type, share its reverse ilist */
+            nint_mt.push_back(nint_mt[rt.ril_mt_intern[mt]]);
+        }
     }
     if (debug)
     {
@@ -1317,10 +1340,11 @@ static int make_bondeds_zone(gmx_domdec_t*                      dd,
         const int i_gl = dd->globalAtomIndices[i];
         global_atomnr_to_moltype_ind(rt, i_gl, &mb, &mt, &mol, &i_mol);
         /* Check all intramolecular interactions assigned to this atom */
-        gmx::ArrayRef<const int>     index = rt->ril_mt[mt].index;
-        gmx::ArrayRef<const t_iatom> rtil  = rt->ril_mt[mt].il;
+        const reverse_ilist_t&       ril   = rt->ril_mt[rt->ril_mt_intern[mt]];
+        gmx::ArrayRef<const int>     index = ril.index;
+        gmx::ArrayRef<const t_iatom> rtil  = ril.il;
 
-        check_assign_interactions_atom(i, i_gl, mol, i_mol, rt->ril_mt[mt].numAtomsInMolecule,
+        check_assign_interactions_atom(i, i_gl, mol, i_mol, ril.numAtomsInMolecule,
                                        index, rtil, FALSE, index[i_mol], index[i_mol + 1], dd,
                                        zones, &molb[mb], bRCheckMB, rcheck, bRCheck2B, rc2,
                                        pbc_null, cg_cm, ip_in, idef, izone, bBCheck, &nbonded_local);
@@ -1332,7 +1356,7 @@ static int make_bondeds_zone(gmx_domdec_t*                      dd,
             index = rt->ril_intermol.index;
             rtil  = rt->ril_intermol.il;
 
-            check_assign_interactions_atom(i, i_gl, mol, i_mol, rt->ril_mt[mt].numAtomsInMolecule,
+            check_assign_interactions_atom(i, i_gl, mol, i_mol, ril.numAtomsInMolecule,
                                            index, rtil, TRUE, index[i_gl], index[i_gl + 1], dd, zones,
                                            &molb[mb], bRCheckMB, rcheck, bRCheck2B, rc2, pbc_null,
                                            cg_cm, ip_in, idef, izone, bBCheck, &nbonded_local);
@@ -1359,7 +1383,12 @@ static void make_exclusions_zone(gmx_domdec_t*                     dd,
 
     const gmx::index oldNumLists = lexcls->ssize();
 
-    std::vector<int> exclusionsForAtom;
+    /* This buffer is rebuilt for every atom, so we take it from the
+     * per-thread scratch arena to avoid contention on the system
+     * allocator when many threads build their zone concurrently.
+     */
+    gmx::ThreadScratchScope                            scratchScope;
+    std::vector<int, gmx::ThreadScratchAllocator<int>> exclusionsForAtom;
     for (int at = at_start; at < at_end; at++)
     {
         exclusionsForAtom.clear();
@@ -1538,6 +1567,14 @@ static int make_local_bondeds_excls(gmx_domdec_t*       dd,
 
         if (izone < numIZonesForExclusions)
         {
+            std::size_t numLists    = lexcls->size();
+            std::size_t numElements = lexcls->numElements();
+            for (std::size_t th = 1; th < rt->th_work.size(); th++)
+            {
+                numLists += rt->th_work[th].excl.size();
+                numElements += rt->th_work[th].excl.numElements();
+            }
+            lexcls->reserve(numLists, numElements);
             for (std::size_t th = 1; th < rt->th_work.size(); th++)
             {
                 lexcls->appendListOfLists(rt->th_work[th].excl);
@@ -1631,10 +1668,56 @@ void dd_make_local_top(gmx_domdec_t*       dd,
         }
     }
 
+    /* Without distance checks, the local topology is a pure function of
+     * the global atom indices of the zones we assign bondeds for. With
+     * little diffusion, repartitioning often leaves the zone assignment
+     * unchanged and then we can reuse the local topology from the
+     * previous partitioning instead of rebuilding it.
+     */
+    gmx_reverse_top_t* rt            = dd->reverse_top;
+    const int          numZonesCheck = (rt->bInterAtomicInteractions ? zones->n : 1);
+    const int          atomEnd       = zones->cg_range[numZonesCheck];
+    const bool         canUseCache   = (!bRCheckMB && !bRCheck2B);
+
+    if (canUseCache && ltop == rt->cachedLocalTopology
+        && gmx::ssize(rt->cachedZoneRanges) == numZonesCheck + 1
+        && std::equal(rt->cachedZoneRanges.begin(), rt->cachedZoneRanges.end(), zones->cg_range)
+        && gmx::ssize(rt->cachedGlobalAtomIndices) == atomEnd
+        && std::equal(rt->cachedGlobalAtomIndices.begin(), rt->cachedGlobalAtomIndices.end(),
+                      dd->globalAtomIndices.begin()))
+    {
+        if (debug)
+        {
+            fprintf(debug, "Reusing the local topology, the zone atom assignment is unchanged\n");
+        }
+
+        /* ltop, dd->nbonded_local and the atomtypes are all unchanged,
+         * we only need to reset the sorting state for free energy.
+         */
+        ltop->idef.ilsort = ilsortUNKNOWN;
+
+        return;
+    }
+
     dd->nbonded_local = make_local_bondeds_excls(dd, zones, &mtop, fr->cginfo.data(), bRCheckMB,
                                                  rcheck, bRCheck2B, rc, pbc_null, cgcm_or_x,
                                                  &ltop->idef, &ltop->excls, &nexcl);
 
+    if (canUseCache)
+    {
+        rt->cachedLocalTopology = ltop;
+        rt->cachedZoneRanges.assign(zones->cg_range, zones->cg_range + numZonesCheck + 1);
+        rt->cachedGlobalAtomIndices.assign(dd->globalAtomIndices.begin(),
+                                           dd->globalAtomIndices.begin() + atomEnd);
+    }
+    else
+    {
+        /* The distance checks depend on the coordinates, so the result
+         * can not be reused even with an identical atom assignment.
+         */
+        rt->cachedLocalTopology = nullptr;
+    }
+
     /* The ilist is not sorted yet,
      * we can only do this when we have the charge arrays.
      */
@@ -1743,6 +1826,13 @@ t_blocka* makeBondedLinks(const gmx_mtop_t& mtop, gmx::ArrayRef<cginfo_mb_t> cgi
         make_reverse_ilist(*mtop.intermolecular_ilist, &atoms, FALSE, FALSE, FALSE, TRUE, &ril_intermol);
     }
 
+    /* Build the reverse ilist once per unique set of interaction lists,
+     * molecule types with identical ilists share the cached entry.
+     */
+    const std::vector<int>       internedMoltype = gmx_mtop_ilist_intern_index(mtop);
+    std::vector<reverse_ilist_t> rilCache(mtop.moltype.size());
+    std::vector<bool>            rilCacheFilled(mtop.moltype.size(), false);
+
     snew(link, 1);
     snew(link->index, mtop.natoms + 1);
     link->nalloc_a = 0;
@@ -1763,8 +1853,13 @@ t_blocka* makeBondedLinks(const gmx_mtop_t& mtop, gmx::ArrayRef<cginfo_mb_t> cgi
          * to all atoms, not only the first atom as in gmx_reverse_top.
          * The constraints are discarded here.
          */
-        reverse_ilist_t ril;
-        make_reverse_ilist(molt.ilist, &molt.atoms, FALSE, FALSE, FALSE, TRUE, &ril);
+        const int mtIntern = internedMoltype[molb.type];
+        if (!rilCacheFilled[mtIntern])
+        {
+            make_reverse_ilist(molt.ilist, &molt.atoms, FALSE, FALSE, FALSE, TRUE, &rilCache[mtIntern]);
+            rilCacheFilled[mtIntern] = true;
+        }
+        const reverse_ilist_t& ril = rilCache[mtIntern];
 
         cgi_mb = &cginfo_mb[mb];
 
@@ -0,0 +1,333 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Defines a flat, open-addressing hash map from non-negative integer
+ * keys to values.
+ * The functions are performance critical and should be inlined.
+ *
+ * \inlibraryapi
+ * \ingroup module_domdec
+ */
+#ifndef GMX_DOMDEC_FLATHASHEDMAP_H
+#define GMX_DOMDEC_FLATHASHEDMAP_H
+
+#include <climits>
+
+#include <algorithm>
+#include <vector>
+
+#include "gromacs/compat/utility.h"
+#include "gromacs/utility/basedefinitions.h"
+#include "gromacs/utility/exceptions.h"
+#include "gromacs/utility/gmxassert.h"
+
+namespace gmx
+{
+
+/*! \libinternal \brief Unordered key to value mapping with open addressing
+ *
+ * Manages mapping from non-negative integer keys to values, like
+ * \p HashedMap, but stores all entries in a single flat array with
+ * linear probing instead of chained buckets. Probing then walks
+ * consecutive memory locations, which avoids the dependent loads of
+ * chain traversal and typically touches a single cache line per
+ * lookup, which matters in the per-atom lookup loops during
+ * repartitioning.
+ *
+ * Note that only keys >= 0 are supported.
+ */
+template<class T>
+class FlatHashedMap
+{
+private:
+    /*! \brief Key value of an empty slot, ends a probe sequence */
+    static constexpr int c_emptyKey = -1;
+    /*! \brief Key value of a deleted slot, probing continues past it */
+    static constexpr int c_deletedKey = -2;
+
+    /*! \libinternal \brief A slot in the flat key/value table */
+    struct Slot
+    {
+        int key = -1; /**< The key, c_emptyKey or c_deletedKey */
+        T   value;    /**< The value */
+    };
+
+    /*! \brief The table size is set to at least this factor times the nr of keys */
+    static constexpr float c_relTableSizeSetMin = 2.0;
+    /*! \brief Threshold for increasing the table size */
+    static constexpr float c_relTableSizeThresholdMin = 1.7;
+    /*! \brief Threshold for decreasing the table size */
+    static constexpr float c_relTableSizeThresholdMax = 4.5;
+
+    /*! \brief Sets an empty table sized for \p numElementsEstimate elements
+     *
+     * \param[in] numElementsEstimate  An estimate of the number of elements that will be stored
+     */
+    void setTableSize(int numElementsEstimate)
+    {
+        /* Make the table a power of 2, filled at most half at the estimate,
+         * so lookups need about one probe on average and the linear probe
+         * sequences stay short.
+         */
+        int tableSize = 64;
+        while (tableSize <= INT_MAX / 2
+               && static_cast<float>(numElementsEstimate) * c_relTableSizeSetMin > tableSize)
+        {
+            tableSize *= 2;
+        }
+        table_.clear();
+        table_.resize(tableSize);
+
+        /* Table size is a power of 2, so a binary mask gives the hash */
+        bitMask_ = tableSize - 1;
+    }
+
+    /*! \brief Rebuilds the table, sized for \p numElementsEstimate, dropping deleted slots
+     *
+     * \param[in] numElementsEstimate  An estimate of the number of elements that will be stored
+     */
+    void rehash(int numElementsEstimate)
+    {
+        std::vector<Slot> oldTable = std::move(table_);
+
+        setTableSize(numElementsEstimate);
+        numElements_ = 0;
+        numDeleted_  = 0;
+
+        for (const Slot& slot : oldTable)
+        {
+            if (slot.key >= 0)
+            {
+                insert(slot.key, slot.value);
+            }
+        }
+    }
+
+public:
+    /*! \brief Constructor
+     *
+     * \param[in] numElementsEstimate  An estimate of the number of elements that will be stored, used for optimizing initial performance
+     */
+    FlatHashedMap(int numElementsEstimate) { setTableSize(numElementsEstimate); }
+
+    /*! \brief Returns the number of elements */
+    int size() const { return numElements_; }
+
+    /*! \brief Returns the number of slots in the flat table */
+    int bucket_count() const { return bitMask_ + 1; }
+
+private:
+    /*! \brief Inserts or assigns a key and value
+     *
+     * \tparam    allowAssign  Sets whether assignment of a key that is present is allowed
+     * \param[in] key          The key for the entry
+     * \param[in] value        The value for the entry
+     * \throws InvalidInputError from a debug build when attempting to insert a duplicate key with \p allowAssign=false
+     */
+    template<bool allowAssign>
+    void insert_assign(int key, const T& value)
+    {
+        GMX_ASSERT(key >= 0, "Only keys >= 0 are supported");
+
+        /* Both elements and deleted slots lengthen the probe sequences,
+         * rebuild the table before it gets more than 2/3 occupied.
+         */
+        if ((numElements_ + numDeleted_ + 1) * 3 > 2 * bucket_count())
+        {
+            rehash(numElements_ + 1);
+        }
+
+        size_t ind          = (key & bitMask_);
+        int    firstDeleted = -1;
+        while (true)
+        {
+            const int slotKey = table_[ind].key;
+            if (slotKey == key)
+            {
+                if (allowAssign)
+                {
+                    table_[ind].value = value;
+                }
+                else
+                {
+// Note: This is performance critical, so we only throw in debug mode
+#ifndef NDEBUG
+                    GMX_THROW(InvalidInputError("Attempt to insert duplicate key"));
+#endif
+                }
+                return;
+            }
+            if (slotKey == c_emptyKey)
+            {
+                break;
+            }
+            if (slotKey == c_deletedKey && firstDeleted < 0)
+            {
+                firstDeleted = ind;
+            }
+            ind = (ind + 1) & bitMask_;
+        }
+
+        /* The key is not present, prefer reusing a deleted slot on the probe path */
+        if (firstDeleted >= 0)
+        {
+            ind = firstDeleted;
+            numDeleted_ -= 1;
+        }
+        table_[ind].key   = key;
+        table_[ind].value = value;
+
+        numElements_ += 1;
+    }
+
+public:
+    /*! \brief Inserts entry, key should not already be present
+     *
+     * \param[in] key    The key for the entry
+     * \param[in] value  The value for the entry
+     * \throws InvalidInputError from a debug build when attempting to insert a duplicate key
+     */
+    void insert(int key, const T& value) { insert_assign<false>(key, value); }
+
+    /*! \brief Inserts an entry when the key is not present, otherwise sets the value
+     *
+     * \param[in] key    The key for the entry
+     * \param[in] value  The value for the entry
+     */
+    void insert_or_assign(int key, const T& value) { insert_assign<true>(key, value); }
+
+    /*! \brief Delete the entry for key \p key, when present
+     *
+     * \param[in] key  The key
+     */
+    void erase(int key)
+    {
+        size_t ind = (key & bitMask_);
+        while (true)
+        {
+            const int slotKey = table_[ind].key;
+            if (slotKey == key)
+            {
+                /* Mark the slot as deleted instead of empty, so probe
+                 * sequences of keys stored behind it stay intact.
+                 */
+                table_[ind].key = c_deletedKey;
+
+                numElements_ -= 1;
+                numDeleted_ += 1;
+
+                return;
+            }
+            if (slotKey == c_emptyKey)
+            {
+                return;
+            }
+            ind = (ind + 1) & bitMask_;
+        }
+    }
+
+    /*! \brief Returns a pointer to the value for the given key or nullptr when not present
+     *
+     * \param[in] key  The key
+     * \return a pointer to value for the given key or nullptr when not present
+     */
+    T* find(int key) { return const_cast<T*>(gmx::compat::as_const(*this).find(key)); }
+
+    /*! \brief Returns a pointer to the value for the given key or nullptr when not present
+     *
+     * \param[in] key  The key
+     * \return a pointer to value for the given key or nullptr when not present
+     */
+    const T* find(int key) const
+    {
+        size_t ind = (key & bitMask_);
+        while (true)
+        {
+            const int slotKey = table_[ind].key;
+            if (slotKey == key)
+            {
+                return &table_[ind].value;
+            }
+            if (slotKey == c_emptyKey)
+            {
+                return nullptr;
+            }
+            ind = (ind + 1) & bitMask_;
+        }
+    }
+
+    /*! \brief Clear all the entries in the table
+     *
+     * Also optimizes the size of the table based on the current
+     * number of elements stored.
+     */
+    void clear()
+    {
+        const int oldNumElements = numElements_;
+
+        for (Slot& slot : table_)
+        {
+            slot.key = c_emptyKey;
+        }
+        numElements_ = 0;
+        numDeleted_  = 0;
+
+        /* Resize the table when the occupation is far from optimal.
+         * Do not resize with 0 elements to avoid minimal size when clear()
+         * is called twice in a row.
+         */
+        if (oldNumElements > 0
+            && (oldNumElements * c_relTableSizeThresholdMax < bucket_count()
+                || oldNumElements * c_relTableSizeThresholdMin > bucket_count()))
+        {
+            setTableSize(oldNumElements);
+        }
+    }
+
+private:
+    /*! \brief The flat table of slots */
+    std::vector<Slot> table_;
+    /*! \brief The bit mask for computing the hash of a key */
+    int bitMask_ = 0;
+    /*! \brief The number of elements currently stored in the table */
+    int numElements_ = 0;
+    /*! \brief The number of deleted slots in the table */
+    int numDeleted_ = 0;
+};
+
+} // namespace gmx
+
+#endif
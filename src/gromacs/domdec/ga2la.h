@@ -51,7 +51,7 @@
 
 #include <vector>
 
-#include "gromacs/domdec/hashedmap.h"
+#include "gromacs/domdec/flathashedmap.h"
 #include "gromacs/utility/gmxassert.h"
 
 /*! \libinternal \brief Global to local atom mapping
@@ -75,7 +75,7 @@ public:
      * \param[in] numAtomsLocal  An estimate of the number of home+communicated atoms
      */
     gmx_ga2la_t(int numAtomsTotal, int numAtomsLocal);
-    ~gmx_ga2la_t() { usingDirect_ ? data_.direct.~vector() : data_.hashed.~HashedMap(); }
+    ~gmx_ga2la_t() { usingDirect_ ? data_.direct.~vector() : data_.hashed.~FlatHashedMap(); }
 
     /*! \brief Inserts an entry, there should not already be an entry for \p a_gl
      *
@@ -167,8 +167,8 @@ public:
 
 private:
     union Data {
-        std::vector<Entry>    direct;
-        gmx::HashedMap<Entry> hashed;
+        std::vector<Entry>        direct;
+        gmx::FlatHashedMap<Entry> hashed;
         // constructor and destructor function in parent class
         Data() {}
         ~Data() {}
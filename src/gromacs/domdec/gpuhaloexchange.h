@@ -79,12 +79,18 @@ public:
      * does not yet support virial steps.
      *
      * \param [inout] dd                       domdec structure
+     * \param [in]    dimIndex                 the dimension index for this instance
      * \param [in]    mpi_comm_mysim           communicator used for simulation
      * \param [in]    streamLocal              local NB CUDA stream.
      * \param [in]    streamNonLocal           non-local NB CUDA stream.
      * \param [in]    pulse                    the communication pulse for this instance
      */
-    GpuHaloExchange(gmx_domdec_t* dd, MPI_Comm mpi_comm_mysim, void* streamLocal, void* streamNonLocal, int pulse);
+    GpuHaloExchange(gmx_domdec_t* dd,
+                    int           dimIndex,
+                    MPI_Comm      mpi_comm_mysim,
+                    void*         streamLocal,
+                    void*         streamNonLocal,
+                    int           pulse);
     ~GpuHaloExchange();
 
     /*! \brief
@@ -36,6 +36,15 @@
  *
  * \brief Implements GPU halo exchange using CUDA.
  *
+ * The halo data itself moves device-to-device: a packing kernel fills a
+ * contiguous send buffer and cudaMemcpyAsync pushes it into the remote
+ * rank's device memory, whose address was exchanged at reinitialization.
+ * The per-step host-side MPI messages only carry event pointers and are
+ * required for correctness: enqueueing a stream wait on a peer event is
+ * a no-op unless the producing rank has already recorded it, so the
+ * rendezvous cannot be elided. Replacing that handshake would need
+ * GPU-initiated communication (e.g. device-side put/signal), i.e. a
+ * communication library dependency beyond the CUDA runtime.
  *
  * \author Alan Gray <alang@nvidia.com>
  *
@@ -136,7 +145,7 @@ void GpuHaloExchange::Impl::reinitHalo(float3* d_coordinatesBuffer, float3* d_fo
 
     cudaStream_t                 stream  = nonLocalStream_;
     const gmx_domdec_comm_t&     comm    = *dd_->comm;
-    const gmx_domdec_comm_dim_t& cd      = comm.cd[0];
+    const gmx_domdec_comm_dim_t& cd      = comm.cd[dimIndex_];
     const gmx_domdec_ind_t&      ind     = cd.ind[pulse_];
     int                          newSize = ind.nsend[nzone_ + 1];
 
@@ -163,6 +172,24 @@ void GpuHaloExchange::Impl::reinitHalo(float3* d_coordinatesBuffer, float3* d_fo
 
     numHomeAtoms_ = comm.atomRanges.numHomeAtoms(); // offset for data recieved by this rank
 
+    // The halo atoms of this instance are stored after those received
+    // in the earlier dimensions and in the earlier pulses of this
+    // dimension, matching the CPU ordering in dd_move_x().
+    atomOffset_   = 0;
+    int zoneIndex = 1;
+    for (int d = 0; d < dimIndex_; d++)
+    {
+        for (const gmx_domdec_ind_t& indEarlier : comm.cd[d].ind)
+        {
+            atomOffset_ += indEarlier.nrecv[zoneIndex + 1];
+        }
+        zoneIndex += zoneIndex;
+    }
+    for (int p = 0; p < pulse_; p++)
+    {
+        atomOffset_ += cd.ind[p].nrecv[nzone_ + 1];
+    }
+
     GMX_ASSERT(ind.index.size() == h_indexMap_.size(), "Size mismatch");
     std::copy(ind.index.begin(), ind.index.end(), h_indexMap_.begin());
 
@@ -176,13 +203,7 @@ void GpuHaloExchange::Impl::reinitHalo(float3* d_coordinatesBuffer, float3* d_fo
 
     // Coordinates buffer:
 #if GMX_MPI
-    int pulseOffset = 0;
-    for (int p = pulse_ - 1; p >= 0; p--)
-    {
-        pulseOffset += cd.ind[p].nrecv[nzone_ + 1];
-    }
-    //    void* recvPtr = static_cast<void*>(&d_coordinatesBuffer[numHomeAtoms_ + pulseOffset]);
-    void* recvPtr = static_cast<void*>(&d_x_[numHomeAtoms_ + pulseOffset]);
+    void* recvPtr = static_cast<void*>(&d_x_[numHomeAtoms_ + atomOffset_]);
     MPI_Sendrecv(&recvPtr, sizeof(void*), MPI_BYTE, recvRankX_, 0, &remoteXPtr_, sizeof(void*),
                  MPI_BYTE, sendRankX_, 0, mpi_comm_mysim_, MPI_STATUS_IGNORE);
 
@@ -199,7 +220,7 @@ void GpuHaloExchange::Impl::communicateHaloCoordinates(const matrix          box
                                                        GpuEventSynchronizer* coordinatesReadyOnDeviceEvent)
 {
 
-    if (pulse_ == 0)
+    if (dimIndex_ == 0 && pulse_ == 0)
     {
         // ensure stream waits until coordinate data is available on device
         coordinatesReadyOnDeviceEvent->enqueueWaitEvent(nonLocalStream_);
@@ -225,10 +246,7 @@ void GpuHaloExchange::Impl::communicateHaloCoordinates(const matrix          box
     // performing pressure coupling. So, for simplicity, the box
     // is used every step to pass the shift vector as an argument of
     // the packing kernel.
-    //
-    // Because only one-dimensional DD is supported, the coordinate
-    // shift only needs to handle that dimension.
-    const int    dimensionIndex = dd_->dim[0];
+    const int    dimensionIndex = dd_->dim[dimIndex_];
     const float3 coordinateShift{ box[dimensionIndex][XX], box[dimensionIndex][YY],
                                   box[dimensionIndex][ZZ] };
 
@@ -258,7 +276,10 @@ void GpuHaloExchange::Impl::communicateHaloForces(bool accumulateForces)
 
     float3* d_f = d_f_;
 
-    if (pulse_ == (dd_->comm->cd[0].numPulses() - 1))
+    // The force halos are exchanged in the reverse order of the
+    // coordinate halos, so this instance runs first when it handles
+    // the last pulse of the last dimension.
+    if (dimIndex_ == (dd_->ndim - 1) && pulse_ == (dd_->comm->cd[dimIndex_].numPulses() - 1))
     {
         if (!accumulateForces)
         {
@@ -291,11 +312,12 @@ void GpuHaloExchange::Impl::communicateHaloForces(bool accumulateForces)
     const int*    indexMap = d_indexMap_;
     const int     size     = fRecvSize_;
 
-    if (pulse_ > 0)
+    if (pulse_ > 0 || dimIndex_ < (dd_->ndim - 1))
     {
         // We need to accumulate rather than set, since it is possible
-        // that, in this pulse, a value could be written to a location
-        // corresponding to the halo region of a following pulse.
+        // that, in this pulse or dimension, a value could be written
+        // to a location corresponding to the halo region of a
+        // following pulse or dimension.
         accumulateForces = true;
     }
 
@@ -309,7 +331,7 @@ void GpuHaloExchange::Impl::communicateHaloForces(bool accumulateForces)
         launchGpuKernel(kernelFn, config, nullptr, "Domdec GPU Apply F Halo Exchange", kernelArgs);
     }
 
-    if (pulse_ == 0)
+    if (dimIndex_ == 0 && pulse_ == 0)
     {
         fReadyOnDevice_.markEvent(nonLocalStream_);
     }
@@ -350,12 +372,9 @@ void GpuHaloExchange::Impl::communicateHaloData(float3*               d_ptr,
     }
     else
     {
-        int recvOffset = dd_->comm->atomRanges.end(DDAtomRanges::Type::Zones);
-        for (int p = pulse_; p < dd_->comm->cd[0].numPulses(); p++)
-        {
-            recvOffset -= dd_->comm->cd[0].ind[p].nrecv[nzone_ + 1];
-        }
-        sendPtr   = static_cast<void*>(&(d_ptr[recvOffset]));
+        // The halo atoms received in the coordinate exchange are sent
+        // back from the same location in the force buffer.
+        sendPtr   = static_cast<void*>(&(d_ptr[numHomeAtoms_ + atomOffset_]));
         sendSize  = fSendSize_;
         remotePtr = remoteFPtr_;
         sendRank  = sendRankF_;
@@ -416,31 +435,29 @@ GpuEventSynchronizer* GpuHaloExchange::Impl::getForcesReadyOnDeviceEvent()
 
 /*! \brief Create Domdec GPU object */
 GpuHaloExchange::Impl::Impl(gmx_domdec_t* dd,
+                            int           dimIndex,
                             MPI_Comm      mpi_comm_mysim,
                             void*         localStream,
                             void*         nonLocalStream,
                             int           pulse) :
     dd_(dd),
-    sendRankX_(dd->neighbor[0][1]),
-    recvRankX_(dd->neighbor[0][0]),
-    sendRankF_(dd->neighbor[0][0]),
-    recvRankF_(dd->neighbor[0][1]),
-    usePBC_(dd->ci[dd->dim[0]] == 0),
+    sendRankX_(dd->neighbor[dimIndex][1]),
+    recvRankX_(dd->neighbor[dimIndex][0]),
+    sendRankF_(dd->neighbor[dimIndex][0]),
+    recvRankF_(dd->neighbor[dimIndex][1]),
+    usePBC_(dd->ci[dd->dim[dimIndex]] == 0),
     haloDataTransferLaunched_(new GpuEventSynchronizer()),
     mpi_comm_mysim_(mpi_comm_mysim),
     localStream_(*static_cast<cudaStream_t*>(localStream)),
     nonLocalStream_(*static_cast<cudaStream_t*>(nonLocalStream)),
-    pulse_(pulse)
+    dimIndex_(dimIndex),
+    pulse_(pulse),
+    nzone_(1 << dimIndex)
 {
 
     GMX_RELEASE_ASSERT(GMX_THREAD_MPI,
                        "GPU Halo exchange is currently only supported with thread-MPI enabled");
 
-    if (dd->ndim > 1)
-    {
-        gmx_fatal(FARGS, "Error: dd->ndim > 1 is not yet supported in GPU halo exchange");
-    }
-
     if (usePBC_ && dd->unitCellInfo.haveScrewPBC)
     {
         gmx_fatal(FARGS, "Error: screw is not yet supported in GPU halo exchange\n");
@@ -461,11 +478,12 @@ GpuHaloExchange::Impl::~Impl()
 }
 
 GpuHaloExchange::GpuHaloExchange(gmx_domdec_t* dd,
+                                 int           dimIndex,
                                  MPI_Comm      mpi_comm_mysim,
                                  void*         localStream,
                                  void*         nonLocalStream,
                                  int           pulse) :
-    impl_(new Impl(dd, mpi_comm_mysim, localStream, nonLocalStream, pulse))
+    impl_(new Impl(dd, dimIndex, mpi_comm_mysim, localStream, nonLocalStream, pulse))
 {
 }
 
@@ -69,12 +69,13 @@ public:
     /*! \brief Creates GPU Halo Exchange object.
      *
      * \param [inout] dd                       domdec structure
+     * \param [in]    dimIndex                 the dimension index for this instance
      * \param [in]    mpi_comm_mysim           communicator used for simulation
      * \param [in]    localStream              local NB CUDA stream
      * \param [in]    nonLocalStream           non-local NB CUDA stream
      * \param [in]    pulse                    the communication pulse for this instance
      */
-    Impl(gmx_domdec_t* dd, MPI_Comm mpi_comm_mysim, void* localStream, void* nonLocalStream, int pulse);
+    Impl(gmx_domdec_t* dd, int dimIndex, MPI_Comm mpi_comm_mysim, void* localStream, void* nonLocalStream, int pulse);
     ~Impl();
 
     /*! \brief
@@ -185,10 +186,14 @@ private:
     float3* d_f_ = nullptr;
     //! An event recorded once the exchanged forces are ready on the GPU
     GpuEventSynchronizer fReadyOnDevice_;
+    //! The dimension index corresponding to this halo exchange instance
+    int dimIndex_ = 0;
     //! The pulse corresponding to this halo exchange instance
     int pulse_ = 0;
-    //! Number of zones. Always 1 for 1-D case.
-    const int nzone_ = 1;
+    //! The zone index covering all communicated zones of this dimension, 1 << dimIndex
+    int nzone_ = 1;
+    //! The offset of the halo atoms of this (dimension, pulse) with respect to the home atoms
+    int atomOffset_ = 0;
 };
 
 } // namespace gmx
@@ -827,6 +827,7 @@ static void get_load_distribution(gmx_domdec_t* dd, gmx_wallcycle_t wcycle)
                     sbuf[pos++] = comm->load[d + 1].sum_m;
                     sbuf[pos++] = comm->load[d + 1].cvol_min * cell_frac;
                     sbuf[pos++] = comm->load[d + 1].flags;
+                    sbuf[pos++] = comm->load[d + 1].flipFrac;
                     if (d > 0)
                     {
                         sbuf[pos++] = cellsizes->fracLowerMax;
@@ -861,9 +862,15 @@ static void get_load_distribution(gmx_domdec_t* dd, gmx_wallcycle_t wcycle)
                 load->sum_m    = 0;
                 load->cvol_min = 1;
                 load->flags    = 0;
+                load->flipFrac = 0;
                 load->mdf      = 0;
                 load->pme      = 0;
-                int pos        = 0;
+                if (rowMaster != nullptr)
+                {
+                    /* The boundary oscillation statistics of this row */
+                    load->flipFrac = dd_dlb_boundary_flip_fraction(*rowMaster);
+                }
+                int pos = 0;
                 for (int i = 0; i < dd->numCells[dim]; i++)
                 {
                     load->sum += load->load[pos++];
@@ -887,7 +894,8 @@ static void get_load_distribution(gmx_domdec_t* dd, gmx_wallcycle_t wcycle)
                         pos++;
                         if (d < dd->ndim - 1)
                         {
-                            load->flags = gmx::roundToInt(load->load[pos++]);
+                            load->flags    = gmx::roundToInt(load->load[pos++]);
+                            load->flipFrac = std::max(load->flipFrac, load->load[pos++]);
                         }
                         if (d > 0)
                         {
@@ -918,6 +926,11 @@ static void get_load_distribution(gmx_domdec_t* dd, gmx_wallcycle_t wcycle)
         comm->load_step += comm->cycl[ddCyclStep];
         comm->load_sum += comm->load[0].sum;
         comm->load_max += comm->load[0].max;
+        if (comm->load[0].sum > 0)
+        {
+            /* Record the imbalance of this measurement for the report time line */
+            comm->imbalanceTimeline.push_back(comm->load[0].max * dd->nnodes / comm->load[0].sum - 1);
+        }
         if (isDlbOn(comm))
         {
             for (int d = 0; d < dd->ndim; d++)
@@ -927,6 +940,7 @@ static void get_load_distribution(gmx_domdec_t* dd, gmx_wallcycle_t wcycle)
                     comm->load_lim[d]++;
                 }
             }
+            comm->load_flip = std::max(comm->load_flip, comm->load[0].flipFrac);
         }
         if (bSepPME)
         {
@@ -1034,6 +1048,36 @@ static void print_dd_load_av(FILE* fplog, gmx_domdec_t* dd)
         msg += gmx::formatString(
                 " Part of the total run time spent waiting due to load imbalance: %.1f%%.\n",
                 lossFraction * 100);
+
+        /* Print a compact time line of how the imbalance evolved over the run */
+        const std::vector<float>& timeline = comm->imbalanceTimeline;
+        if (timeline.size() >= 10)
+        {
+            constexpr int c_numBins = 10;
+
+            msg += " Load imbalance over consecutive tenths of the load measurements:\n";
+            msg += "   ";
+            for (int bin = 0; bin < c_numBins; bin++)
+            {
+                const size_t binStart = (timeline.size() * bin) / c_numBins;
+                const size_t binEnd   = (timeline.size() * (bin + 1)) / c_numBins;
+                double       binSum   = 0;
+                for (size_t i = binStart; i < binEnd; i++)
+                {
+                    binSum += timeline[i];
+                }
+                msg += gmx::formatString(" %4.0f%%", 100 * binSum / (binEnd - binStart));
+            }
+            msg += "\n";
+        }
+        if (isDlbOn(comm) && comm->load_flip > 0)
+        {
+            msg += gmx::formatString(
+                    " Cell boundaries reversed their direction of motion in %.0f%% of the DLB "
+                    "updates.\n",
+                    100 * comm->load_flip);
+        }
+
         fprintf(fplog, "%s", msg.c_str());
         fprintf(stderr, "\n%s", msg.c_str());
     }
@@ -1125,6 +1169,48 @@ static void print_dd_load_av(FILE* fplog, gmx_domdec_t* dd)
         fprintf(fplog, "%s\n", buf);
         fprintf(stderr, "%s\n", buf);
     }
+
+    if (isDlbOn(comm) && comm->load_flip >= 0.5F && lossFraction >= DD_PERF_LOSS_WARN)
+    {
+        std::string message = gmx::formatString(
+                "NOTE: The DLB cell boundaries reversed their direction of motion in %.0f %% of\n"
+                "      the balancing updates: the load balancing oscillated instead of\n"
+                "      converging, which itself causes imbalance. You might want to restrict\n"
+                "      the boundary motion by increasing -dds towards 1, run with -dlb no,\n"
+                "      or, when using separate PME ranks, shift work by changing -npme.\n",
+                100 * comm->load_flip);
+        fprintf(fplog, "%s\n", message.c_str());
+        fprintf(stderr, "%s\n", message.c_str());
+    }
+
+    const std::vector<float>& timeline = comm->imbalanceTimeline;
+    if (lossFraction >= DD_PERF_LOSS_WARN && timeline.size() >= 10)
+    {
+        /* Compare the average imbalance of the first and last half of the run */
+        double sumFirst = 0, sumLast = 0;
+        const size_t half = timeline.size() / 2;
+        for (size_t i = 0; i < half; i++)
+        {
+            sumFirst += timeline[i];
+        }
+        for (size_t i = half; i < timeline.size(); i++)
+        {
+            sumLast += timeline[i];
+        }
+        const double imbFirst = sumFirst / half;
+        const double imbLast  = sumLast / (timeline.size() - half);
+        if (imbLast > 1.5 * imbFirst + 0.02)
+        {
+            std::string message = gmx::formatString(
+                    "NOTE: The load imbalance grew during the run, from %.0f %% over the first\n"
+                    "      half to %.0f %% over the last half. The system is likely becoming\n"
+                    "      more inhomogeneous; you might want to use fewer domains along the\n"
+                    "      dimension in which the inhomogeneity develops (option -dd).\n",
+                    100 * imbFirst, 100 * imbLast);
+            fprintf(fplog, "%s\n", message.c_str());
+            fprintf(stderr, "%s\n", message.c_str());
+        }
+    }
 }
 
 //! Return the minimum communication volume.
@@ -2578,6 +2664,19 @@ void reset_dd_statistics_counters(gmx_domdec_t* dd)
     clear_ivec(comm->load_lim);
     comm->load_mdf = 0;
     comm->load_pme = 0;
+    comm->imbalanceTimeline.clear();
+    comm->load_flip = 0;
+    for (int d = 0; d < dd->ndim; d++)
+    {
+        RowMaster* rowMaster = (!isDlbDisabled(comm) && comm->cellsizesWithDlb[d].rowMaster
+                                        ? comm->cellsizesWithDlb[d].rowMaster.get()
+                                        : nullptr);
+        if (rowMaster != nullptr)
+        {
+            std::fill(rowMaster->boundaryFlipCount.begin(), rowMaster->boundaryFlipCount.end(), 0);
+            rowMaster->numBoundaryUpdates = 0;
+        }
+    }
 }
 
 void print_dd_statistics(const t_commrec* cr, const t_inputrec* ir, FILE* fplog)
@@ -3017,8 +3116,17 @@ void dd_partition_system(FILE*                        fplog,
         /* After sorting and compacting we set the correct size */
         dd_resize_state(state_local, f, comm->atomRanges.numHomeAtoms());
 
-        /* Rebuild all the indices */
-        dd->ga2la->clear();
+        /* Rebuild all the indices.
+         * Instead of clearing the whole global-to-local table, which scales
+         * with the global atom count per rank, erase only the entries that
+         * can still be present: everything inserted since the clearing at
+         * the start of this routine has its global index in
+         * dd->globalAtomIndices, and erasing absent entries is harmless.
+         */
+        for (const int globalAtomIndex : dd->globalAtomIndices)
+        {
+            dd->ga2la->erase(globalAtomIndex);
+        }
         ncgindex_set = 0;
 
         wallcycle_sub_stop(wcycle, ewcsDD_GRID);
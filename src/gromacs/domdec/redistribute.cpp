@@ -83,24 +83,31 @@ static inline int DD_FLAG_BW(int d)
     return 1 << (16 + d * 2 + 1);
 }
 
-static void copyMovedAtomsToBufferPerAtom(gmx::ArrayRef<const int> move,
-                                          int                      nvec,
-                                          int                      vec,
-                                          rvec*                    src,
-                                          gmx_domdec_comm_t*       comm)
+/* Copy the state of the moved atoms to the send buffers as one record per atom
+ *
+ * All state vectors in \p sources are interleaved per atom directly behind
+ * the COG entry written by copyMovedUpdateGroupCogs(), so a single pass
+ * over the atoms packs the complete, contiguous migration record of each
+ * atom, instead of one pass over all atoms per state vector.
+ */
+static void copyMovedAtomsToBufferPerAtom(gmx::ArrayRef<const int>    move,
+                                          gmx::ArrayRef<const rvec*>  sources,
+                                          gmx_domdec_comm_t*          comm)
 {
     int pos_vec[DIM * 2] = { 0 };
 
     for (gmx::index i = 0; i < move.ssize(); i++)
     {
-        /* Skip moved atoms */
+        /* Skip atoms that do not move */
         const int m = move[i];
         if (m >= 0)
         {
-            /* Copy to the communication buffer */
-            pos_vec[m] += 1 + vec;
-            copy_rvec(src[i], comm->cgcm_state[m][pos_vec[m]++]);
-            pos_vec[m] += nvec - vec - 1;
+            /* Skip the COG entry and copy all state vectors for this atom */
+            pos_vec[m]++;
+            for (const rvec* src : sources)
+            {
+                copy_rvec(src[i], comm->cgcm_state[m][pos_vec[m]++]);
+            }
         }
     }
 }
@@ -715,16 +722,19 @@ void dd_redistribute_cg(FILE*                        fplog,
      */
     copyMovedUpdateGroupCogs(move, nvec, state->x, comm);
 
-    int vectorIndex = 0;
-    copyMovedAtomsToBufferPerAtom(move, nvec, vectorIndex++, state->x.rvec_array(), comm);
+    const rvec* sources[3];
+    int         numSources  = 0;
+    sources[numSources++]   = state->x.rvec_array();
     if (bV)
     {
-        copyMovedAtomsToBufferPerAtom(move, nvec, vectorIndex++, state->v.rvec_array(), comm);
+        sources[numSources++] = state->v.rvec_array();
     }
     if (bCGP)
     {
-        copyMovedAtomsToBufferPerAtom(move, nvec, vectorIndex++, state->cg_p.rvec_array(), comm);
+        sources[numSources++] = state->cg_p.rvec_array();
     }
+    GMX_ASSERT(numSources == nvec, "All state vectors should be packed");
+    copyMovedAtomsToBufferPerAtom(move, gmx::arrayRefFromArray(sources, numSources), comm);
 
     int* moved = getMovedBuffer(comm, 0, dd->ncg_home);
 
@@ -0,0 +1,219 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Implements gmx::EnergyStreamer.
+ *
+ * \ingroup module_energyanalysis
+ */
+#include "gmxpre.h"
+
+#include "energystreamer.h"
+
+#include <chrono>
+#include <utility>
+
+#include "gromacs/energyanalysis/ienergyanalysis.h"
+#include "gromacs/fileio/gmxfio.h"
+#include "gromacs/utility/basedefinitions.h"
+#include "gromacs/utility/gmxassert.h"
+
+namespace gmx
+{
+
+namespace
+{
+
+//! Interval at which a followed file is polled for appended frames
+constexpr int c_pollIntervalMs = 200;
+
+} // namespace
+
+EnergyStreamer::EnergyStreamer(const std::string& filename) :
+    ef_(open_enx(filename.c_str(), "r")),
+    nre_(0),
+    nms_(nullptr),
+    followTimeout_(0),
+    bufferSize_(8),
+    head_(0),
+    tail_(0),
+    count_(0),
+    eof_(false),
+    stop_(false)
+{
+    do_enxnms(ef_, &nre_, &nms_);
+}
+
+EnergyStreamer::~EnergyStreamer()
+{
+    if (reader_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        notFull_.notify_one();
+        reader_.join();
+    }
+    for (t_enxframe& slot : slots_)
+    {
+        free_enxframe(&slot);
+    }
+    free_enxnms(nre_, nms_);
+    done_ener_file(ef_);
+}
+
+void EnergyStreamer::addAnalyzer(IEnergyAnalysis* analysis)
+{
+    analyzers_.push_back(analysis);
+}
+
+void EnergyStreamer::setBufferSize(int numFrames)
+{
+    GMX_RELEASE_ASSERT(numFrames >= 1, "Need at least one frame buffer slot");
+    bufferSize_ = numFrames;
+}
+
+void EnergyStreamer::setFollowTimeout(double timeoutSeconds)
+{
+    followTimeout_ = timeoutSeconds;
+}
+
+/* Loop of the reader thread: decode frames into free ring slots until the
+ * file ends (and, with a follow timeout, stops growing) or the consumer
+ * asks us to stop. */
+void EnergyStreamer::readLoop()
+{
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this] { return stop_ || count_ < ssize(slots_); });
+        if (stop_)
+        {
+            return;
+        }
+        t_enxframe* slot = &slots_[head_];
+        lock.unlock();
+        /* Decoding happens without holding the lock, so the consumer can
+         * take finished frames while this one is being read. */
+        gmx_off_t offset    = gmx_fio_ftell(enx_file_pointer(ef_));
+        bool      haveFrame = (do_enx(ef_, slot) != 0);
+        if (!haveFrame && followTimeout_ > 0)
+        {
+            /* The writer may still be appending frames; the frame at the
+             * current offset may even have been written only partially.
+             * Rewind to its start and retry until a whole frame appears
+             * or the file has not grown for the timeout. */
+            double waited = 0;
+            while (!haveFrame && waited < followTimeout_)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(mutex_);
+                    if (stop_)
+                    {
+                        return;
+                    }
+                }
+                gmx_fio_seek(enx_file_pointer(ef_), offset);
+                std::this_thread::sleep_for(std::chrono::milliseconds(c_pollIntervalMs));
+                waited += 1e-3 * c_pollIntervalMs;
+                haveFrame = (do_enx(ef_, slot) != 0);
+            }
+        }
+        lock.lock();
+        if (!haveFrame)
+        {
+            eof_ = true;
+            notEmpty_.notify_one();
+            return;
+        }
+        head_ = (head_ + 1) % static_cast<int>(slots_.size());
+        count_++;
+        notEmpty_.notify_one();
+    }
+}
+
+int64_t EnergyStreamer::streamAllFrames()
+{
+    GMX_RELEASE_ASSERT(!reader_.joinable(), "An EnergyStreamer can only stream its file once");
+
+    slots_.resize(bufferSize_);
+    for (t_enxframe& slot : slots_)
+    {
+        init_enxframe(&slot);
+    }
+    for (IEnergyAnalysis* analyzer : analyzers_)
+    {
+        analyzer->initAnalysis(nre_, nms_);
+    }
+    reader_ = std::thread(&EnergyStreamer::readLoop, this);
+
+    t_enxframe frame;
+    init_enxframe(&frame);
+    int64_t numFrames = 0;
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this] { return count_ > 0 || eof_; });
+        if (count_ == 0)
+        {
+            break;
+        }
+        /* Swap the whole frame out of the ring: the decoded arrays move
+         * to this thread and the previous arrays are reused for decoding. */
+        std::swap(frame, slots_[tail_]);
+        tail_ = (tail_ + 1) % static_cast<int>(slots_.size());
+        count_--;
+        notFull_.notify_one();
+        lock.unlock();
+
+        for (IEnergyAnalysis* analyzer : analyzers_)
+        {
+            analyzer->analyzeFrame(frame);
+        }
+        numFrames++;
+    }
+    reader_.join();
+    free_enxframe(&frame);
+
+    for (IEnergyAnalysis* analyzer : analyzers_)
+    {
+        analyzer->finishAnalysis();
+    }
+
+    return numFrames;
+}
+
+} // namespace gmx
@@ -0,0 +1,175 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares gmx::EnergyStreamer, which pushes energy frames from an
+ * asynchronous reader thread through registered analyzers.
+ *
+ * \inlibraryapi
+ * \ingroup module_energyanalysis
+ */
+#ifndef GMX_ENERGYANALYSIS_ENERGYSTREAMER_H
+#define GMX_ENERGYANALYSIS_ENERGYSTREAMER_H
+
+#include <cstdint>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gromacs/fileio/enxio.h"
+#include "gromacs/trajectory/energyframe.h"
+#include "gromacs/utility/classhelpers.h"
+
+namespace gmx
+{
+
+class IEnergyAnalysis;
+
+/*! \libinternal \brief
+ * Streams the frames of an energy file through registered analyzers.
+ *
+ * The streamer decodes frames on its own reader thread into a bounded
+ * ring of pre-allocated frames, while the calling thread takes finished
+ * frames from the ring and pushes them through the registered
+ * IEnergyAnalysis modules in registration order. Decoding thus overlaps
+ * with analysis, and memory use is bounded by the ring size instead of
+ * the file size.
+ *
+ * With a follow timeout set, the streamer does not stop at the end of
+ * the file, but keeps polling for frames appended by a running
+ * simulation, which allows on-the-fly monitoring without repeated full
+ * scans of the file. An incompletely written last frame is re-read from
+ * its starting offset once the writer has completed it.
+ */
+class EnergyStreamer
+{
+public:
+    /*! \brief
+     * Opens \p filename and reads the energy-term names.
+     *
+     * \throws FileIOError when the file cannot be opened.
+     */
+    explicit EnergyStreamer(const std::string& filename);
+    ~EnergyStreamer();
+
+    //! Returns the number of energy terms per frame.
+    int nre() const { return nre_; }
+    //! Returns the names and units of the energy terms.
+    const gmx_enxnm_t* energyNames() const { return nms_; }
+
+    /*! \brief
+     * Registers an analyzer to receive the frames.
+     *
+     * The caller retains ownership; the analyzer has to stay alive
+     * until streamAllFrames() returns.
+     */
+    void addAnalyzer(IEnergyAnalysis* analysis);
+
+    /*! \brief
+     * Sets the number of frames buffered between reading and analysis.
+     *
+     * Has to be called before streamAllFrames(). The default of 8 frames
+     * is enough to decouple decoding from analyzers of uneven cost.
+     */
+    void setBufferSize(int numFrames);
+
+    /*! \brief
+     * Keeps streaming frames appended to a growing file.
+     *
+     * At the end of the file the reader polls for newly appended frames
+     * and only gives up after no new frame has appeared for
+     * \p timeoutSeconds. Pass 0 (the default) to stop at the first end
+     * of file.
+     */
+    void setFollowTimeout(double timeoutSeconds);
+
+    /*! \brief
+     * Streams all frames of the file through the registered analyzers.
+     *
+     * Calls initAnalysis() on all analyzers, delivers each frame to all
+     * of them in registration order, and calls finishAnalysis() when the
+     * file (including any followed growth) is exhausted.
+     *
+     * \returns the number of frames delivered.
+     */
+    int64_t streamAllFrames();
+
+private:
+    //! Loop of the reader thread; fills ring slots until eof or stop.
+    void readLoop();
+
+    //! The energy file being streamed
+    ener_file_t ef_;
+    //! Number of energy terms per frame
+    int nre_;
+    //! Names and units of the energy terms
+    gmx_enxnm_t* nms_;
+    //! The registered analyzers, not owned
+    std::vector<IEnergyAnalysis*> analyzers_;
+    //! Seconds to keep polling a growing file for new frames, 0 for none
+    double followTimeout_;
+    //! Number of frames buffered between reading and analysis
+    int bufferSize_;
+
+    //! Ring of pre-allocated frames
+    std::vector<t_enxframe> slots_;
+    //! Next slot the reader thread fills
+    int head_;
+    //! Next slot the consumer takes
+    int tail_;
+    //! Number of filled slots
+    int count_;
+    //! Reader thread hit the end of the file
+    bool eof_;
+    //! Consumer asked the reader thread to stop
+    bool stop_;
+    //! Protects the ring state above
+    std::mutex mutex_;
+    //! Signalled when a slot is consumed
+    std::condition_variable notFull_;
+    //! Signalled when a slot is filled or at eof
+    std::condition_variable notEmpty_;
+    //! The reader thread, only running during streamAllFrames()
+    std::thread reader_;
+
+    GMX_DISALLOW_COPY_AND_ASSIGN(EnergyStreamer);
+};
+
+} // namespace gmx
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares gmx::IEnergyAnalysis, the interface for push-based energy
+ * frame analysis.
+ *
+ * \inlibraryapi
+ * \ingroup module_energyanalysis
+ */
+#ifndef GMX_ENERGYANALYSIS_IENERGYANALYSIS_H
+#define GMX_ENERGYANALYSIS_IENERGYANALYSIS_H
+
+#include "gromacs/fileio/enxio.h"
+
+namespace gmx
+{
+
+/*! \libinternal \brief
+ * Interface for analysis modules that consume energy frames one at a time.
+ *
+ * Analyzers implementing this interface are registered with an
+ * EnergyStreamer, which pushes the frames of an energy file through them
+ * in file order. Because frames are delivered as they are decoded, an
+ * analyzer never needs the whole file in memory and can also process the
+ * growing energy file of a running simulation.
+ */
+class IEnergyAnalysis
+{
+public:
+    virtual ~IEnergyAnalysis() {}
+
+    /*! \brief
+     * Called once, before the first frame is delivered.
+     *
+     * \param[in] nre Number of energy terms per frame
+     * \param[in] nms Names and units of the energy terms, valid for the
+     *                lifetime of the streamer
+     */
+    virtual void initAnalysis(int nre, const gmx_enxnm_t* nms) = 0;
+
+    /*! \brief
+     * Called for each energy frame, in file order.
+     *
+     * The frame and everything it points to are only valid for the
+     * duration of the call; an analyzer that needs values later has to
+     * copy them.
+     *
+     * \param[in] frame The decoded energy frame
+     */
+    virtual void analyzeFrame(const t_enxframe& frame) = 0;
+
+    /*! \brief
+     * Called once, after the last frame has been delivered.
+     */
+    virtual void finishAnalysis() = 0;
+};
+
+} // namespace gmx
+
+#endif
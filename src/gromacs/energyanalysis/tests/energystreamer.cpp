@@ -0,0 +1,136 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for gmx::EnergyStreamer
+ *
+ * \ingroup module_energyanalysis
+ */
+#include "gmxpre.h"
+
+#include "gromacs/energyanalysis/energystreamer.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/energyanalysis/ienergyanalysis.h"
+#include "gromacs/utility/smalloc.h"
+
+#include "testutils/testfilemanager.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! Analyzer that records the delivered frames for checking.
+class FrameCollector : public IEnergyAnalysis
+{
+public:
+    void initAnalysis(int nre, const gmx_enxnm_t* /*nms*/) override
+    {
+        nre_        = nre;
+        initCalled_ = true;
+    }
+    void analyzeFrame(const t_enxframe& frame) override
+    {
+        times_.push_back(frame.t);
+        firstTerm_.push_back(frame.ener[0].e);
+    }
+    void finishAnalysis() override { finishCalled_ = true; }
+
+    //! Number of terms passed to initAnalysis()
+    int nre_ = 0;
+    //! Whether initAnalysis() was called
+    bool initCalled_ = false;
+    //! Whether finishAnalysis() was called
+    bool finishCalled_ = false;
+    //! Times of the delivered frames
+    std::vector<double> times_;
+    //! First energy term of each delivered frame
+    std::vector<real> firstTerm_;
+};
+
+TEST(EnergyStreamerTest, StreamsAllFramesInOrder)
+{
+    const std::string filename = TestFileManager::getInputFilePath("ener.edr");
+
+    /* Read the file directly as the reference */
+    ener_file_t  ef  = open_enx(filename.c_str(), "r");
+    int          nre = 0;
+    gmx_enxnm_t* nms = nullptr;
+    do_enxnms(ef, &nre, &nms);
+    t_enxframe* fr;
+    snew(fr, 1);
+    std::vector<double> refTimes;
+    std::vector<real>   refFirstTerm;
+    while (do_enx(ef, fr))
+    {
+        refTimes.push_back(fr->t);
+        refFirstTerm.push_back(fr->ener[0].e);
+    }
+    free_enxframe(fr);
+    sfree(fr);
+    free_enxnms(nre, nms);
+    done_ener_file(ef);
+    ASSERT_FALSE(refTimes.empty());
+
+    /* A small buffer forces the reader thread to block on the consumer */
+    FrameCollector first;
+    FrameCollector second;
+    EnergyStreamer streamer(filename);
+    EXPECT_EQ(nre, streamer.nre());
+    streamer.setBufferSize(2);
+    streamer.addAnalyzer(&first);
+    streamer.addAnalyzer(&second);
+    const int64_t numFrames = streamer.streamAllFrames();
+
+    EXPECT_EQ(refTimes.size(), numFrames);
+    EXPECT_TRUE(first.initCalled_);
+    EXPECT_TRUE(first.finishCalled_);
+    EXPECT_EQ(nre, first.nre_);
+    EXPECT_EQ(refTimes, first.times_);
+    EXPECT_EQ(refFirstTerm, first.firstTerm_);
+    EXPECT_EQ(refTimes, second.times_);
+    EXPECT_EQ(refFirstTerm, second.firstTerm_);
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
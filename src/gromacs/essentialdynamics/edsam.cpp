@@ -398,42 +398,62 @@ real projectx(const t_edpar& edi, rvec* xcoll, rvec* vec)
 
     return proj;
 }
+
+/*!\brief Mass-weighted projections onto all eigenvectors of a set in one sweep.
+ * Computes the same projections as calling projectx() once per eigenvector
+ * after subtracting the average positions, but reads the coordinates only
+ * once instead of once per eigenvector. With many eigenvectors (e.g. in
+ * flooding runs) this roughly halves the memory traffic of the projection.
+ * The coordinates are left unchanged.
+ * \param[in]  edi  essential dynamics parameters holding average structure and masses
+ * \param[in]  x    the coordinates to project
+ * \param[in]  vec  the eigenvectors
+ * \param[out] proj the projection onto each eigenvector, size vec.neig
+ */
+void project_onto_all_eigvectors(const t_edpar& edi, const rvec* x, const t_eigvec& vec, real* proj)
+{
+    for (int v = 0; v < vec.neig; v++)
+    {
+        proj[v] = 0.0;
+    }
+
+    for (int i = 0; i < edi.sav.nr; i++)
+    {
+        rvec dx;
+
+        rvec_sub(x[i], edi.sav.x[i], dx);
+
+        for (int v = 0; v < vec.neig; v++)
+        {
+            proj[v] += edi.sav.sqrtm[i] * iprod(vec.vec[v][i], dx);
+        }
+    }
+}
+
 /*!\brief Project coordinates onto vector after substracting average position.
  * projection is stored in vec->refproj which is used for radacc, radfix,
  * radcon and center of flooding potential.
- * Average positions are first substracted from x, then added back again.
+ * Average positions are subtracted on the fly, x is left unchanged.
  * \param[in] edi essential dynamics parameters with average position
  * \param[in] x Coordinates to be projected
  * \param[out] vec eigenvector, radius and refproj are overwritten here
  */
 void rad_project(const t_edpar& edi, rvec* x, t_eigvec* vec)
 {
-    int  i;
     real rad = 0.0;
 
-    /* Subtract average positions */
-    for (i = 0; i < edi.sav.nr; i++)
-    {
-        rvec_dec(x[i], edi.sav.x[i]);
-    }
+    project_onto_all_eigvectors(edi, x, *vec, vec->refproj);
 
-    for (i = 0; i < vec->neig; i++)
+    for (int i = 0; i < vec->neig; i++)
     {
-        vec->refproj[i] = projectx(edi, x, vec->vec[i]);
         rad += gmx::square((vec->refproj[i] - vec->xproj[i]));
     }
     vec->radius = sqrt(rad);
-
-    /* Add average positions */
-    for (i = 0; i < edi.sav.nr; i++)
-    {
-        rvec_inc(x[i], edi.sav.x[i]);
-    }
 }
 
 /*!\brief Projects coordinates onto eigenvectors and stores result in vec->xproj.
- * Mass-weighting is applied. Subtracts average positions prior to projection and add
- * them afterwards to retain the unchanged vector.
+ * Mass-weighting is applied. Average positions are subtracted on the fly,
+ * x is left unchanged.
  * \param[in] x The coordinates to project to an eigenvector
  * \param[in,out] vec The eigenvectors
  * \param[in] edi essential dynamics parameters holding average structure and masses
@@ -445,22 +465,7 @@ void project_to_eigvectors(rvec* x, t_eigvec* vec, const t_edpar& edi)
         return;
     }
 
-    /* Subtract average positions */
-    for (int i = 0; i < edi.sav.nr; i++)
-    {
-        rvec_dec(x[i], edi.sav.x[i]);
-    }
-
-    for (int i = 0; i < vec->neig; i++)
-    {
-        vec->xproj[i] = projectx(edi, x, vec->vec[i]);
-    }
-
-    /* Add average positions */
-    for (int i = 0; i < edi.sav.nr; i++)
-    {
-        rvec_inc(x[i], edi.sav.x[i]);
-    }
+    project_onto_all_eigvectors(edi, x, *vec, vec->xproj);
 }
 } // namespace
 
@@ -199,6 +199,13 @@ bool pme_gpu_supports_input(const t_inputrec& ir, const gmx_mtop_t& mtop, std::s
     }
     if (EVDW_PME(ir.vdwtype))
     {
+        /* The GPU kernels only handle a single charge grid. Supporting LJ-PME
+         * requires spreading/gathering C6 coefficients onto separate grids
+         * (seven of them with Lorentz-Berthelot combination rules), a solve
+         * kernel for the dispersion term and a combined force reduction, so
+         * this restriction can only be lifted together with multiple-grid
+         * support in the spread/gather/solve kernels.
+         */
         errorReasons.emplace_back("Lennard-Jones PME");
     }
     if (!EI_DYNAMICS(ir.eI))
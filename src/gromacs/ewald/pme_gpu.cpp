@@ -425,7 +425,14 @@ void pme_gpu_reinit_computation(const gmx_pme_t* pme, gmx_wallcycle* wcycle)
     pme_gpu_update_timings(pme->gpu);
 
     pme_gpu_clear_grids(pme->gpu);
-    pme_gpu_clear_energy_virial(pme->gpu);
+    if ((pme->gpu->settings.currentFlags & GMX_PME_CALC_ENER_VIR) != 0)
+    {
+        /* The solve kernel only accumulates into the energy/virial buffer on
+         * energy/virial steps, so clearing it on every step would launch a
+         * redundant clear kernel. The buffer starts out zeroed on allocation.
+         */
+        pme_gpu_clear_energy_virial(pme->gpu);
+    }
 
     wallcycle_sub_stop(wcycle, ewcsLAUNCH_GPU_PME);
     wallcycle_stop(wcycle, ewcLAUNCH_GPU);
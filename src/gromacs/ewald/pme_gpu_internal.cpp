@@ -144,6 +144,10 @@ void pme_gpu_alloc_energy_virial(PmeGpu* pmeGpu)
     allocateDeviceBuffer(&pmeGpu->kernelParams->constants.d_virialAndEnergy, c_virialAndEnergyCount,
                          pmeGpu->archSpecific->context);
     pmalloc(reinterpret_cast<void**>(&pmeGpu->staging.h_virialAndEnergy), energyAndVirialSize);
+    /* The accumulator has to start out zeroed; after this it is only cleared
+     * again after computations that have accumulated energy/virial into it.
+     */
+    pme_gpu_clear_energy_virial(pmeGpu);
 }
 
 void pme_gpu_free_energy_virial(PmeGpu* pmeGpu)
@@ -489,9 +493,12 @@ void pme_gpu_init_internal(PmeGpu* pmeGpu)
     pmeGpu->archSpecific.reset(new PmeGpuSpecific());
     pmeGpu->kernelParams.reset(new PmeGpuKernelParams());
 
-    pmeGpu->archSpecific->performOutOfPlaceFFT = true;
-    /* This should give better performance, according to the cuFFT documentation.
+    pmeGpu->archSpecific->performOutOfPlaceFFT = (getenv("GMX_PME_GPU_INPLACE_FFT") == nullptr);
+    /* Out-of-place should give better performance, according to the cuFFT documentation.
      * The performance seems to be the same though.
+     * The in-place mode shares one buffer between the real and complex grids,
+     * which saves a whole grid of device memory and lets the FFT transform the
+     * spread output without touching a second buffer.
      * TODO: PME could also try to pick up nice grid sizes (with factors of 2, 3, 5, 7).
      */
 
@@ -731,9 +738,12 @@ static void pme_gpu_reinit_grids(PmeGpu* pmeGpu)
         kernelParamsPtr->grid.complexGridSizePadded[i] = kernelParamsPtr->grid.realGridSize[i];
     }
     /* FFT: n real elements correspond to (n / 2 + 1) complex elements in minor dimension */
-    if (!pme_gpu_settings(pmeGpu).performGPUFFT)
+    if (!pme_gpu_settings(pmeGpu).performGPUFFT || !pmeGpu->archSpecific->performOutOfPlaceFFT)
     {
-        // This allows for GPU spreading grid and CPU fftgrid to have the same layout, so that we can copy the data directly
+        // This allows for GPU spreading grid and CPU fftgrid to have the same layout,
+        // so that we can copy the data directly.
+        // An in-place GPU FFT needs the same row padding so that the complex output
+        // of each z row fits where its real input was.
         kernelParamsPtr->grid.realGridSizePadded[ZZ] =
                 (kernelParamsPtr->grid.realGridSize[ZZ] / 2 + 1) * 2;
     }
@@ -836,6 +846,9 @@ static void pme_gpu_init(gmx_pme_t* pme, const DeviceInformation* deviceInfo, co
     pmeGpu->settings.performGPUGather = true;
     // By default GPU-side reduction is off (explicitly set here for tests, otherwise reset per-step)
     pmeGpu->settings.useGpuForceReduction = false;
+    // No computation has happened yet; pme_gpu_reinit_computation() relies on
+    // these flags to decide whether the energy/virial accumulator needs clearing
+    pmeGpu->settings.currentFlags = 0;
 
     pme_gpu_set_testing(pmeGpu, false);
 
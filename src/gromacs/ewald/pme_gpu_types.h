@@ -129,7 +129,15 @@ struct PmeGpuGridParams
     int tablesOffsets[DIM];
 
     /* Grid arrays */
-    /*! \brief Real space grid. */
+    /*! \brief Real space grid.
+     *
+     * Always stored in single precision. Reduced (half) precision storage
+     * would halve the grid traffic of the bandwidth-bound spread and gather
+     * passes, but since the FFT consumes this same buffer it can only be
+     * introduced together with half-precision FFT plans (cufftXt, sm_53+),
+     * half atomics in the spread kernel (sm_70+) and a complex-half solve
+     * stage, i.e. as one coordinated change to all grid-stage kernels.
+     */
     HIDE_FROM_OPENCL_COMPILER(DeviceBuffer<float>) d_realGrid;
     /*! \brief Complex grid - used in FFT/solve. If inplace cu/clFFT is used, then it is the same handle as realGrid. */
     HIDE_FROM_OPENCL_COMPILER(DeviceBuffer<float>) d_fourierGrid;
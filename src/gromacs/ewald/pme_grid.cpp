@@ -43,6 +43,7 @@
 #include "config.h"
 
 #include <cstdlib>
+#include <cstring>
 
 #include "gromacs/ewald/pme.h"
 #include "gromacs/fft/parallel_3dfft.h"
@@ -656,7 +657,31 @@ void pmegrids_init(pmegrids_t* grids,
     copy_ivec(n, n_base);
     n_base[ZZ] = nz_base;
 
-    pmegrid_init(&grids->grid, 0, 0, 0, 0, 0, 0, n[XX], n[YY], n[ZZ], FALSE, pme_order, nullptr);
+    {
+        /* Allocate the grid data uninitialized and zero, and thereby
+         * first-touch, it in the x-slabs the threads operate on, e.g. in
+         * copy_pmegrid_to_fftgrid(). This places the pages on the NUMA node
+         * of the thread that accesses them instead of all on the node of
+         * the allocating thread.
+         */
+        int gridsize = nx * ny * nz;
+        set_gridsize_alignment(&gridsize, pme_order);
+        real* ptr = static_cast<real*>(save_malloc_aligned("grids->grid.grid", __FILE__, __LINE__,
+                                                           gridsize, sizeof(real), SIMD4_ALIGNMENT));
+#pragma omp parallel for num_threads(nthread) schedule(static)
+        for (int thread = 0; thread < nthread; thread++)
+        {
+            const int x0 = (nx * thread) / nthread;
+            const int x1 = (nx * (thread + 1)) / nthread;
+            std::memset(ptr + static_cast<size_t>(x0) * ny * nz, 0,
+                        static_cast<size_t>(x1 - x0) * ny * nz * sizeof(real));
+        }
+        /* The alignment padding beyond the grid data proper */
+        std::memset(ptr + static_cast<size_t>(nx) * ny * nz, 0,
+                    (gridsize - static_cast<size_t>(nx) * ny * nz) * sizeof(real));
+
+        pmegrid_init(&grids->grid, 0, 0, 0, 0, 0, 0, n[XX], n[YY], n[ZZ], FALSE, pme_order, ptr);
+    }
 
     grids->nthread = nthread;
 
@@ -685,8 +710,23 @@ void pmegrids_init(pmegrids_t* grids,
         t        = 0;
         gridsize = nst[XX] * nst[YY] * nst[ZZ];
         set_gridsize_alignment(&gridsize, pme_order);
-        snew_aligned(grids->grid_all, grids->nthread * gridsize + (grids->nthread + 1) * GMX_CACHE_SEP,
-                     SIMD4_ALIGNMENT);
+        grids->grid_all = static_cast<real*>(save_malloc_aligned(
+                "grids->grid_all", __FILE__, __LINE__,
+                grids->nthread * gridsize + (grids->nthread + 1) * GMX_CACHE_SEP, sizeof(real),
+                SIMD4_ALIGNMENT));
+        /* Let each thread first-touch its own spreading grid, including the
+         * cache separator in front of it; the thread to sub-grid assignment
+         * matches the one used when spreading.
+         */
+#pragma omp parallel for num_threads(grids->nthread) schedule(static)
+        for (int thread = 0; thread < grids->nthread; thread++)
+        {
+            std::memset(grids->grid_all + thread * (gridsize + GMX_CACHE_SEP), 0,
+                        (gridsize + GMX_CACHE_SEP) * sizeof(real));
+        }
+        /* The cache separator behind the last thread grid */
+        std::memset(grids->grid_all + grids->nthread * (gridsize + GMX_CACHE_SEP), 0,
+                    GMX_CACHE_SEP * sizeof(real));
 
         for (x = 0; x < grids->nc[XX]; x++)
         {
@@ -52,6 +52,7 @@
 #include "config.h"
 
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 #include "gromacs/domdec/domdec.h"
@@ -68,6 +69,7 @@
 #include "gromacs/mdtypes/md_enums.h"
 #include "gromacs/mdtypes/state_propagator_data_gpu.h"
 #include "gromacs/nbnxm/nbnxm.h"
+#include "gromacs/timing/mpi_profile.h"
 #include "gromacs/timing/wallcycle.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/gmxmpi.h"
@@ -75,11 +77,27 @@
 
 #include "pme_pp_communication.h"
 
-/*! \brief Block to wait for communication to PME ranks to complete
+/*! \brief Returns whether to delay waiting for the coordinate sends to PME ranks
  *
- * This should be faster with a real non-blocking MPI implementation
+ * With delayed waiting the MPI_Waitall for the per-step coordinate send is
+ * postponed until gmx_pme_receive_f(), so the PP rank can launch local work
+ * while the send is still in flight. This should be faster with a real
+ * non-blocking MPI implementation. The header staging buffer is double
+ * buffered to keep this safe, see gmx_pme_send_coeffs_coords().
+ * Delayed waiting is enabled by setting the env.var. GMX_PME_PP_DELAYED_WAIT.
  */
-static constexpr bool c_useDelayedWait = false;
+static bool useDelayedWait()
+{
+    static const bool delayedWait = (getenv("GMX_PME_PP_DELAYED_WAIT") != nullptr);
+    return delayedWait;
+}
+
+/*! \brief The number of staging buffers for the commmunicated header data
+ *
+ * With two buffers one delayed coordinate send can remain in flight while
+ * the header for the next send is being staged.
+ */
+static constexpr int c_numCnbStagingBuffers = 2;
 
 /*! \brief Wait for the pending data send requests to PME ranks to complete */
 static void gmx_pme_send_coeffs_coords_wait(gmx_domdec_t* dd)
@@ -87,7 +105,9 @@ static void gmx_pme_send_coeffs_coords_wait(gmx_domdec_t* dd)
     if (dd->nreq_pme)
     {
 #if GMX_MPI
+        const double profileStart = mpi_profile_start();
         MPI_Waitall(dd->nreq_pme, dd->req_pme, MPI_STATUSES_IGNORE);
+        mpi_profile_record(empcPMEPP, profileStart, 0, 0);
 #endif
         dd->nreq_pme = 0;
     }
@@ -134,20 +154,50 @@ static void gmx_pme_send_coeffs_coords(t_forcerec*      fr,
         flags |= PP_PME_GPUCOMMS;
     }
 
-    if (c_useDelayedWait)
+    /* Only the hot per-step coordinate-only sends are delayed; sends that
+     * also communicate coefficients post more requests than the request
+     * list can hold on top of pending ones and are rare, so those always
+     * complete any delayed sends first and wait after posting as before.
+     */
+    const bool delayedWait =
+            (useDelayedWait() && (flags & PP_PME_COORD)
+             && !(flags & (PP_PME_CHARGE | PP_PME_CHARGEB | PP_PME_SQRTC6 | PP_PME_SQRTC6B | PP_PME_SIGMA | PP_PME_SIGMAB)));
+
+    if (!delayedWait)
+    {
+        /* We can not reuse the staging buffers and request slots until
+         * pending communication has finished; this is a no-op unless
+         * delayed sends are outstanding.
+         */
+        gmx_pme_send_coeffs_coords_wait(dd);
+    }
+    else if (dd->nreq_pme > 2 * (c_numCnbStagingBuffers - 1))
     {
-        /* We can not use cnb until pending communication has finished */
+        /* A delayed send posts at most two requests. More outstanding
+         * requests than the extra staging buffers can cover means the
+         * buffer we are about to reuse can still be in flight, so
+         * complete the older sends first. This does not trigger in the
+         * normal MD loop, where gmx_pme_receive_f() completes the sends
+         * every step.
+         */
         gmx_pme_send_coeffs_coords_wait(dd);
     }
 
+    const double profileStart = mpi_profile_start();
+    std::size_t  bytesPosted  = 0;
+
     if (dd->pme_receive_vir_ener)
     {
         /* Peer PP node: communicate all data */
         if (dd->cnb == nullptr)
         {
-            snew(dd->cnb, 1);
+            snew(dd->cnb, c_numCnbStagingBuffers);
         }
-        cnb = dd->cnb;
+        /* Rotate over the staging buffers, so with delayed waiting we do
+         * not overwrite a header that is still being sent.
+         */
+        cnb          = &dd->cnb[dd->cnb_slot];
+        dd->cnb_slot = (dd->cnb_slot + 1) % c_numCnbStagingBuffers;
 
         cnb->flags      = flags;
         cnb->natoms     = n;
@@ -163,6 +213,7 @@ static void gmx_pme_send_coeffs_coords(t_forcerec*      fr,
 #if GMX_MPI
         MPI_Isend(cnb, sizeof(*cnb), MPI_BYTE, dd->pme_nodeid, eCommType_CNB, cr->mpi_comm_mysim,
                   &dd->req_pme[dd->nreq_pme++]);
+        bytesPosted += sizeof(*cnb);
 #endif
     }
     else if (flags & (PP_PME_CHARGE | PP_PME_SQRTC6 | PP_PME_SIGMA))
@@ -171,6 +222,7 @@ static void gmx_pme_send_coeffs_coords(t_forcerec*      fr,
         /* Communicate only the number of atoms */
         MPI_Isend(&n, sizeof(n), MPI_BYTE, dd->pme_nodeid, eCommType_CNB, cr->mpi_comm_mysim,
                   &dd->req_pme[dd->nreq_pme++]);
+        bytesPosted += sizeof(n);
 #endif
     }
 
@@ -181,31 +233,37 @@ static void gmx_pme_send_coeffs_coords(t_forcerec*      fr,
         {
             MPI_Isend(chargeA, n * sizeof(real), MPI_BYTE, dd->pme_nodeid, eCommType_ChargeA,
                       cr->mpi_comm_mysim, &dd->req_pme[dd->nreq_pme++]);
+            bytesPosted += n * sizeof(real);
         }
         if (flags & PP_PME_CHARGEB)
         {
             MPI_Isend(chargeB, n * sizeof(real), MPI_BYTE, dd->pme_nodeid, eCommType_ChargeB,
                       cr->mpi_comm_mysim, &dd->req_pme[dd->nreq_pme++]);
+            bytesPosted += n * sizeof(real);
         }
         if (flags & PP_PME_SQRTC6)
         {
             MPI_Isend(c6A, n * sizeof(real), MPI_BYTE, dd->pme_nodeid, eCommType_SQRTC6A,
                       cr->mpi_comm_mysim, &dd->req_pme[dd->nreq_pme++]);
+            bytesPosted += n * sizeof(real);
         }
         if (flags & PP_PME_SQRTC6B)
         {
             MPI_Isend(c6B, n * sizeof(real), MPI_BYTE, dd->pme_nodeid, eCommType_SQRTC6B,
                       cr->mpi_comm_mysim, &dd->req_pme[dd->nreq_pme++]);
+            bytesPosted += n * sizeof(real);
         }
         if (flags & PP_PME_SIGMA)
         {
             MPI_Isend(sigmaA, n * sizeof(real), MPI_BYTE, dd->pme_nodeid, eCommType_SigmaA,
                       cr->mpi_comm_mysim, &dd->req_pme[dd->nreq_pme++]);
+            bytesPosted += n * sizeof(real);
         }
         if (flags & PP_PME_SIGMAB)
         {
             MPI_Isend(sigmaB, n * sizeof(real), MPI_BYTE, dd->pme_nodeid, eCommType_SigmaB,
                       cr->mpi_comm_mysim, &dd->req_pme[dd->nreq_pme++]);
+            bytesPosted += n * sizeof(real);
         }
         if (flags & PP_PME_COORD)
         {
@@ -229,6 +287,7 @@ static void gmx_pme_send_coeffs_coords(t_forcerec*      fr,
             {
                 MPI_Isend(xRealPtr, n * sizeof(rvec), MPI_BYTE, dd->pme_nodeid, eCommType_COORD,
                           cr->mpi_comm_mysim, &dd->req_pme[dd->nreq_pme++]);
+                bytesPosted += n * sizeof(rvec);
             }
         }
     }
@@ -238,7 +297,8 @@ static void gmx_pme_send_coeffs_coords(t_forcerec*      fr,
     GMX_UNUSED_VALUE(sendCoordinatesFromGpu);
     GMX_UNUSED_VALUE(coordinatesReadyOnDeviceEvent);
 #endif
-    if (!c_useDelayedWait)
+    mpi_profile_record(empcPMEPP, profileStart, bytesPosted, 0);
+    if (!delayedWait)
     {
         /* Wait for the data to arrive */
         /* We can skip this wait as we are sure x and q will not be modified
@@ -380,7 +440,9 @@ static void receive_virial_energy(const t_commrec*      cr,
                     cr->sim_nodeid, cr->dd->pme_nodeid);
         }
 #if GMX_MPI
+        const double profileStart = mpi_profile_start();
         MPI_Recv(&cve, sizeof(cve), MPI_BYTE, cr->dd->pme_nodeid, 1, cr->mpi_comm_mysim, MPI_STATUS_IGNORE);
+        mpi_profile_record(empcPMEPP, profileStart, 0, sizeof(cve));
 #else
         memset(&cve, 0, sizeof(cve));
 #endif
@@ -424,8 +486,10 @@ static void recvFFromPme(gmx::PmePpCommGpu* pmePpCommGpu,
     {
         // Receive data using MPI
 #if GMX_MPI
+        const double profileStart = mpi_profile_start();
         MPI_Recv(recvptr, n * sizeof(rvec), MPI_BYTE, cr->dd->pme_nodeid, 0, cr->mpi_comm_mysim,
                  MPI_STATUS_IGNORE);
+        mpi_profile_record(empcPMEPP, profileStart, 0, n * sizeof(rvec));
 #else
         GMX_UNUSED_VALUE(cr);
 #endif
@@ -444,7 +508,7 @@ void gmx_pme_receive_f(gmx::PmePpCommGpu*    pmePpCommGpu,
                        bool                  receivePmeForceToGpu,
                        float*                pme_cycles)
 {
-    if (c_useDelayedWait)
+    if (useDelayedWait())
     {
         /* Wait for the x request to finish */
         gmx_pme_send_coeffs_coords_wait(cr->dd);
@@ -452,7 +516,14 @@ void gmx_pme_receive_f(gmx::PmePpCommGpu*    pmePpCommGpu,
 
     const int               natoms = dd_numHomeAtoms(*cr->dd);
     std::vector<gmx::RVec>& buffer = cr->dd->pmeForceReceiveBuffer;
-    buffer.resize(natoms);
+    /* When the forces are received directly into a GPU buffer, consumed
+     * there by the GPU force reduction, the host-side receive buffer is
+     * never read and does not need to be kept at size.
+     */
+    if (!receivePmeForceToGpu)
+    {
+        buffer.resize(natoms);
+    }
 
     void* recvptr = reinterpret_cast<void*>(buffer.data());
     recvFFromPme(pmePpCommGpu, recvptr, natoms, cr, useGpuPmePpComms, receivePmeForceToGpu);
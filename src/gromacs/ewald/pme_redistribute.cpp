@@ -52,6 +52,7 @@
 #include "config.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "gromacs/math/vec.h"
 #include "gromacs/mdtypes/commrec.h"
@@ -363,6 +364,59 @@ static void dd_pmeredist_pos_coeffs(gmx_pme_t*                     pme,
     }
 
     buf_pos = 0;
+#if GMX_MPI
+    /* The send and receive regions of the different slab shifts are disjoint,
+     * so all exchanges can be posted at once instead of doing a blocking
+     * Sendrecv per shift. The serialized ring exchange exposes up to
+     * 2*maxshift message latencies, which dominates at large rank counts.
+     */
+    std::vector<MPI_Request> requests;
+    requests.reserve(4 * nnodes_comm);
+    for (i = 0; i < nnodes_comm; i++)
+    {
+        const int scount = atc->sendCount()[atc->slabCommSetup[i].node_dest];
+        const int rcount = atc->slabCommSetup[i].rcount;
+        if (scount > 0 || rcount > 0)
+        {
+            const int   dest = atc->slabCommSetup[i].node_dest;
+            const int   src  = atc->slabCommSetup[i].node_src;
+            MPI_Request req;
+            /* Distinct tags for the coordinate and coefficient messages of
+             * each shift, since they are now all in flight concurrently.
+             */
+            if (bX && rcount > 0)
+            {
+                MPI_Irecv(atc->xBuffer.data() + local_pos, rcount * sizeof(rvec), MPI_BYTE, src, i,
+                          atc->mpi_comm, &req);
+                requests.push_back(req);
+            }
+            if (bX && scount > 0)
+            {
+                MPI_Isend(pme->bufv + buf_pos, scount * sizeof(rvec), MPI_BYTE, dest, i,
+                          atc->mpi_comm, &req);
+                requests.push_back(req);
+            }
+            if (rcount > 0)
+            {
+                MPI_Irecv(atc->coefficientBuffer.data() + local_pos, rcount * sizeof(real),
+                          MPI_BYTE, src, nnodes_comm + i, atc->mpi_comm, &req);
+                requests.push_back(req);
+            }
+            if (scount > 0)
+            {
+                MPI_Isend(pme->bufr + buf_pos, scount * sizeof(real), MPI_BYTE, dest,
+                          nnodes_comm + i, atc->mpi_comm, &req);
+                requests.push_back(req);
+            }
+            buf_pos += scount;
+            local_pos += rcount;
+        }
+    }
+    if (!requests.empty())
+    {
+        MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    }
+#else
     for (i = 0; i < nnodes_comm; i++)
     {
         const int scount = atc->sendCount()[atc->slabCommSetup[i].node_dest];
@@ -382,6 +436,7 @@ static void dd_pmeredist_pos_coeffs(gmx_pme_t*                     pme,
             local_pos += atc->slabCommSetup[i].rcount;
         }
     }
+#endif
     GMX_ASSERT(local_pos == atc->numAtoms(), "After receiving we should have numAtoms coordinates");
 }
 
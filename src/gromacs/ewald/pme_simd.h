@@ -67,4 +67,14 @@
 #    define PME_4NSIMD_GATHER 0
 #endif
 
+/* Check if we can use SIMD with packs of 4 for spread with order 4.
+ * In addition to the gather requirements we need unaligned stores
+ * for the read-modify-write of the grid.
+ */
+#if PME_4NSIMD_GATHER && GMX_SIMD_HAVE_STOREU
+#    define PME_4NSIMD_SPREAD 1
+#else
+#    define PME_4NSIMD_SPREAD 0
+#endif
+
 #endif
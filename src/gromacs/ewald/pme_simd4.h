@@ -41,6 +41,41 @@
  * and to remove conditionals and variable loop bounds at compile time.
  */
 
+#ifdef PME_SPREAD_4NSIMD_ORDER4
+/* Spread one charge with pme_order=4 with unaligned 4N SIMD load+store,
+ * where N is SIMD_WIDTH/4. Each operation covers all of z and N rows
+ * of y, analogously to the 4N gather in pme_gather.cpp.
+ * This code does not assume any memory alignment for the grid.
+ */
+{
+    using namespace gmx;
+
+    /* With order 4 the z-spline is actually aligned */
+    const Simd4NReal tz_S = load4DuplicateN(thz);
+
+    for (ithx = 0; (ithx < 4); ithx++)
+    {
+        index_x = (i0 + ithx) * pny * pnz;
+        valx    = coefficient * thx[ithx];
+
+        const Simd4NReal vx_tz_S = Simd4NReal(valx) * tz_S;
+
+        for (ithy = 0; ithy < 4; ithy += GMX_SIMD4N_REAL_WIDTH / 4)
+        {
+            index_xy = index_x + (j0 + ithy) * pnz + k0;
+
+            const Simd4NReal ty_S  = loadUNDuplicate4(thy + ithy);
+            const Simd4NReal gri_S = loadU4NOffset(grid + index_xy, pnz);
+            const Simd4NReal sum_S = fma(vx_tz_S, ty_S, gri_S);
+
+            storeU4NOffset(grid + index_xy, pnz, sum_S);
+        }
+    }
+}
+#    undef PME_SPREAD_4NSIMD_ORDER4
+#endif
+
+
 #ifdef PME_SPREAD_SIMD4_ORDER4
 /* Spread one charge with pme_order=4 with unaligned SIMD4 load+store.
  * This code does not assume any memory alignment for the grid.
@@ -380,7 +380,10 @@ static void spread_coefficients_bsplines_thread(const pmegrid_t*       pmegrid,
             switch (order)
             {
                 case 4:
-#ifdef PME_SIMD4_SPREAD_GATHER
+#if PME_4NSIMD_SPREAD
+#    define PME_SPREAD_4NSIMD_ORDER4
+#    include "pme_simd4.h"
+#elif defined PME_SIMD4_SPREAD_GATHER
 #    ifdef PME_SIMD4_UNALIGNED
 #        define PME_SPREAD_SIMD4_ORDER4
 #    else
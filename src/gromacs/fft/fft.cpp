@@ -45,6 +45,10 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include "gromacs/math/gmxcomplex.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/real.h"
@@ -161,6 +165,101 @@ void gmx_many_fft_destroy(gmx_fft_t fft)
 
 #endif // not GMX_FFT_FFTW3
 
+/* A process-wide cache of many-1D FFT plans, so that PME grid-size tuning
+ * does not have to repeat the expensive FFTW_MEASURE planning when it
+ * revisits a grid size. Sharing one plan between callers relies on plan
+ * execution being stateless, which holds for the FFTW3 backends; MKL and
+ * fftpack keep work data in their handles, so the cache stays inactive there.
+ */
+
+//! Returns whether the 1D FFT plan cache is active
+static bool fftPlanCacheEnabled()
+{
+    static const bool enabled = (GMX_FFT_FFTW3 || GMX_FFT_ARMPL_FFTW3)
+                                && getenv("GMX_FFT_PLAN_CACHE") != nullptr;
+
+    return enabled;
+}
+
+//! Key identifying a cached plan: length, count, flags, real<->complex
+typedef std::tuple<int, int, int, int> FftPlanCacheKey;
+
+//! Mutex protecting the plan cache
+static std::mutex g_fftPlanCacheMutex;
+//! The cached plans; entries live until the end of the process
+static std::map<FftPlanCacheKey, gmx_fft_t> g_fftPlanCache;
+
+int gmx_fft_init_many_1d_cached(gmx_fft_t* pfft, int nx, int howmany, gmx_fft_flag flags)
+{
+    if (!fftPlanCacheEnabled())
+    {
+        return gmx_fft_init_many_1d(pfft, nx, howmany, flags);
+    }
+
+    std::lock_guard<std::mutex> lock(g_fftPlanCacheMutex);
+
+    const FftPlanCacheKey key(nx, howmany, flags, 0);
+    auto                  entry = g_fftPlanCache.find(key);
+    if (entry == g_fftPlanCache.end())
+    {
+        gmx_fft_t fft = nullptr;
+        const int ret = gmx_fft_init_many_1d(&fft, nx, howmany, flags);
+        if (ret != 0)
+        {
+            return ret;
+        }
+        entry = g_fftPlanCache.insert(std::make_pair(key, fft)).first;
+    }
+    *pfft = entry->second;
+
+    return 0;
+}
+
+int gmx_fft_init_many_1d_real_cached(gmx_fft_t* pfft, int nx, int howmany, gmx_fft_flag flags)
+{
+    if (!fftPlanCacheEnabled())
+    {
+        return gmx_fft_init_many_1d_real(pfft, nx, howmany, flags);
+    }
+
+    std::lock_guard<std::mutex> lock(g_fftPlanCacheMutex);
+
+    const FftPlanCacheKey key(nx, howmany, flags, 1);
+    auto                  entry = g_fftPlanCache.find(key);
+    if (entry == g_fftPlanCache.end())
+    {
+        gmx_fft_t fft = nullptr;
+        const int ret = gmx_fft_init_many_1d_real(&fft, nx, howmany, flags);
+        if (ret != 0)
+        {
+            return ret;
+        }
+        entry = g_fftPlanCache.insert(std::make_pair(key, fft)).first;
+    }
+    *pfft = entry->second;
+
+    return 0;
+}
+
+void gmx_fft_many_destroy_cached(gmx_fft_t fft)
+{
+    if (fftPlanCacheEnabled())
+    {
+        std::lock_guard<std::mutex> lock(g_fftPlanCacheMutex);
+
+        for (const auto& entry : g_fftPlanCache)
+        {
+            if (entry.second == fft)
+            {
+                /* The cache retains the plan for later reuse */
+                return;
+            }
+        }
+    }
+
+    gmx_many_fft_destroy(fft);
+}
+
 int gmx_fft_transpose_2d(t_complex* in_data, t_complex* out_data, int nx, int ny)
 {
     int  i, j, k, im, n, ncount;
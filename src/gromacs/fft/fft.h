@@ -177,6 +177,38 @@ int gmx_fft_init_1d_real(gmx_fft_t* fft, int nx, gmx_fft_flag flags);
 int gmx_fft_init_many_1d_real(gmx_fft_t* fft, int nx, int howmany, gmx_fft_flag flags);
 
 
+/*! \brief As gmx_fft_init_many_1d(), but consults the process-wide plan cache
+ *
+ *  With the plan cache active (GMX_FFT_PLAN_CACHE set and an FFTW3 backend),
+ *  a plan created earlier with the same parameters is returned instead of
+ *  planning again, which avoids the expensive FFTW_MEASURE planning when
+ *  PME tuning revisits a grid size. Cached plans are owned by the cache;
+ *  release them with gmx_fft_many_destroy_cached().
+ *
+ *  \param fft    Pointer to opaque Gromacs FFT datatype
+ *  \param nx     Length of transform
+ *  \param howmany Howmany 1D FFT
+ *  \param flags  FFT options
+ *
+ *  \return status - 0 or a standard error message.
+ */
+int gmx_fft_init_many_1d_cached(gmx_fft_t* fft, int nx, int howmany, gmx_fft_flag flags);
+
+
+/*! \brief As gmx_fft_init_many_1d_real(), but consults the process-wide plan cache
+ *
+ *  See gmx_fft_init_many_1d_cached() for the cache behavior.
+ *
+ *  \param fft    Pointer to opaque Gromacs FFT datatype
+ *  \param nx     Length of transform in real space
+ *  \param howmany Howmany 1D FFTs
+ *  \param flags  FFT options
+ *
+ *  \return status - 0 or a standard error message.
+ */
+int gmx_fft_init_many_1d_real_cached(gmx_fft_t* fft, int nx, int howmany, gmx_fft_flag flags);
+
+
 /*! \brief Setup a 2-dimensional real-to-complex transform
  *
  *  \param fft    Pointer to opaque Gromacs FFT datatype
@@ -337,6 +369,16 @@ void gmx_fft_destroy(gmx_fft_t setup);
  */
 void gmx_many_fft_destroy(gmx_fft_t setup);
 
+/*! \brief Release a many FFT setup obtained from the cached initializers
+ *
+ *  Setups owned by the plan cache are retained for later reuse;
+ *  setups created while the cache was inactive are destroyed.
+ *
+ *  \param setup Setup returned from gmx_fft_init_many_1d_cached() or
+ *               gmx_fft_init_many_1d_real_cached().
+ */
+void gmx_fft_many_destroy_cached(gmx_fft_t setup);
+
 
 /*! \brief Transpose 2d complex matrix, in-place or out-of-place.
  *
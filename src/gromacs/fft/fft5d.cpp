@@ -47,8 +47,10 @@
 #include <cstring>
 
 #include <algorithm>
+#include <vector>
 
 #include "gromacs/gpu_utils/gpu_utils.h"
+#include "gromacs/utility/basedefinitions.h"
 #include "gromacs/gpu_utils/hostallocator.h"
 #include "gromacs/gpu_utils/pinning.h"
 #include "gromacs/utility/alignedallocator.h"
@@ -638,14 +640,14 @@ fft5d_plan fft5d_plan_3d(int                NG,
                             && ((!(flags & FFT5D_BACKWARD) && s == 0)
                                 || ((flags & FFT5D_BACKWARD) && s == 2)))
                         {
-                            gmx_fft_init_many_1d_real(
+                            gmx_fft_init_many_1d_real_cached(
                                     &plan->p1d[s][t], rC[s], tsize,
                                     (flags & FFT5D_NOMEASURE) ? GMX_FFT_FLAG_CONSERVATIVE : 0);
                         }
                         else
                         {
-                            gmx_fft_init_many_1d(&plan->p1d[s][t], C[s], tsize,
-                                                 (flags & FFT5D_NOMEASURE) ? GMX_FFT_FLAG_CONSERVATIVE : 0);
+                            gmx_fft_init_many_1d_cached(&plan->p1d[s][t], C[s], tsize,
+                                                        (flags & FFT5D_NOMEASURE) ? GMX_FFT_FLAG_CONSERVATIVE : 0);
                         }
                     }
                     GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
@@ -723,8 +725,17 @@ fft5d_plan fft5d_plan_3d(int                NG,
         plan->direction=direction;
         plan->realcomplex=realcomplex;
      */
-    plan->flags         = flags;
-    plan->nthreads      = nthreads;
+    plan->flags    = flags;
+    plan->nthreads = nthreads;
+    /* Experimental: split the transpose all-to-all into multiple concurrent
+     * nonblocking exchanges, so chunks for different ranks can be in flight
+     * at the same time instead of one bulk synchronous exchange.
+     */
+    plan->nTransposeBatches = 1;
+    if (const char* env = getenv("GMX_FFT5D_PIPELINE"))
+    {
+        plan->nTransposeBatches = std::max(1, atoi(env));
+    }
     plan->pinningPolicy = realGridAllocationPinningPolicy;
     *rlin               = lin;
     *rlout              = lout;
@@ -1095,6 +1106,51 @@ static void print_localdata(const t_complex* lin, const char* txt, int s, fft5d_
     }
 }
 
+#if GMX_MPI
+/* Perform the all-to-all of one transpose step, either as a single blocking
+ * call or, with nBatches > 1, as nBatches concurrent nonblocking exchanges
+ * of contiguous chunks of each per-rank block. The chunked exchange keeps
+ * messages for different ranks in flight concurrently, which reduces the
+ * time a PME rank sits idle in the bulk synchronous transpose at high
+ * parallelization.
+ */
+static void fft5d_alltoall(real* send, real* recv, int count, MPI_Comm comm, int nBatches)
+{
+#    if GMX_LIB_MPI && defined(MPI_VERSION) && MPI_VERSION >= 3
+    if (nBatches > 1)
+    {
+        int P;
+        MPI_Comm_size(comm, &P);
+        nBatches = std::min(nBatches, count);
+
+        std::vector<std::vector<int>> counts(nBatches);
+        std::vector<std::vector<int>> displs(nBatches);
+        std::vector<MPI_Request>      requests(nBatches);
+        for (int b = 0; b < nBatches; b++)
+        {
+            const int start = (b * count) / nBatches;
+            const int len   = ((b + 1) * count) / nBatches - start;
+            counts[b].resize(P, len);
+            displs[b].resize(P);
+            for (int p = 0; p < P; p++)
+            {
+                /* The same chunk of the block for/from each rank */
+                displs[b][p] = p * count + start;
+            }
+            MPI_Ialltoallv(send, counts[b].data(), displs[b].data(), GMX_MPI_REAL, recv,
+                           counts[b].data(), displs[b].data(), GMX_MPI_REAL, comm, &requests[b]);
+        }
+        MPI_Waitall(nBatches, requests.data(), MPI_STATUSES_IGNORE);
+
+        return;
+    }
+#    else
+    GMX_UNUSED_VALUE(nBatches);
+#    endif
+    MPI_Alltoall(send, count, GMX_MPI_REAL, recv, count, GMX_MPI_REAL, comm);
+}
+#endif /*GMX_MPI*/
+
 void fft5d_execute(fft5d_plan plan, int thread, fft5d_time times)
 {
     t_complex* lin   = plan->lin;
@@ -1262,19 +1318,15 @@ void fft5d_execute(fft5d_plan plan, int thread, fft5d_time times)
                 if ((s == 0 && !(plan->flags & FFT5D_ORDER_YZ))
                     || (s == 1 && (plan->flags & FFT5D_ORDER_YZ)))
                 {
-                    MPI_Alltoall(reinterpret_cast<real*>(lout2),
-                                 N[s] * pM[s] * K[s] * sizeof(t_complex) / sizeof(real),
-                                 GMX_MPI_REAL, reinterpret_cast<real*>(lout3),
-                                 N[s] * pM[s] * K[s] * sizeof(t_complex) / sizeof(real),
-                                 GMX_MPI_REAL, cart[s]);
+                    fft5d_alltoall(reinterpret_cast<real*>(lout2), reinterpret_cast<real*>(lout3),
+                                   N[s] * pM[s] * K[s] * sizeof(t_complex) / sizeof(real), cart[s],
+                                   plan->nTransposeBatches);
                 }
                 else
                 {
-                    MPI_Alltoall(reinterpret_cast<real*>(lout2),
-                                 N[s] * M[s] * pK[s] * sizeof(t_complex) / sizeof(real),
-                                 GMX_MPI_REAL, reinterpret_cast<real*>(lout3),
-                                 N[s] * M[s] * pK[s] * sizeof(t_complex) / sizeof(real),
-                                 GMX_MPI_REAL, cart[s]);
+                    fft5d_alltoall(reinterpret_cast<real*>(lout2), reinterpret_cast<real*>(lout3),
+                                   N[s] * M[s] * pK[s] * sizeof(t_complex) / sizeof(real), cart[s],
+                                   plan->nTransposeBatches);
                 }
 #    else
                 gmx_incons("fft5d MPI call without MPI configuration");
@@ -1404,7 +1456,7 @@ void fft5d_destroy(fft5d_plan plan)
         {
             for (t = 0; t < plan->nthreads; t++)
             {
-                gmx_many_fft_destroy(plan->p1d[s][t]);
+                gmx_fft_many_destroy_cached(plan->p1d[s][t]);
             }
             free(plan->p1d[s]);
         }
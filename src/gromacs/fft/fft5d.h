@@ -122,6 +122,7 @@ struct fft5d_plan_t
     /*int P[2];*/
     int                coor[2];
     int                nthreads;
+    int nTransposeBatches; /*number of chunks for the transpose all-to-all, 1 = one blocking call*/
     gmx::PinningPolicy pinningPolicy;
 };
 
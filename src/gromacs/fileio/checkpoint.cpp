@@ -49,6 +49,8 @@
 
 #include <array>
 #include <memory>
+#include <string>
+#include <thread>
 
 #include "buildinfo.h"
 #include "gromacs/fileio/filetypes.h"
@@ -113,6 +115,7 @@ enum cptv
     cptv_ComPrevStepAsPullGroupReference, /**< Allow using COM of previous step as pull group PBC reference */
     cptv_PullAverage, /**< Added possibility to output average pull force and position */
     cptv_MdModules,   /**< Added checkpointing for MdModules */
+    cptv_DeltaCheckpoint, /**< Added delta checkpoints storing AWH history as sparse updates to a base file */
     cptv_Count        /**< the total number of cptv versions */
 };
 
@@ -1182,6 +1185,17 @@ static void do_cpt_header(XDR* xd, gmx_bool bRead, FILE* list, CheckpointHeaderC
     {
         contents->flagsPullHistory = 0;
     }
+
+    if (contents->file_version >= cptv_DeltaCheckpoint)
+    {
+        do_cpt_int_err(xd, "delta checkpoint", &contents->isDeltaCheckpoint, list);
+        do_cpt_step_err(xd, "delta base step", &contents->deltaBaseStep, list);
+    }
+    else
+    {
+        contents->isDeltaCheckpoint = 0;
+        contents->deltaBaseStep     = -1;
+    }
 }
 
 static int do_cpt_footer(XDR* xd, int file_version)
@@ -1913,6 +1927,21 @@ static int do_cpt_EDstate(XDR* xd, gmx_bool bRead, int nED, edsamhistory_t* EDst
     return 0;
 }
 
+static void do_cpt_correlation_block(XDR* xd, const char* name, gmx::CorrelationBlockDataHistory* blockData, FILE* list)
+{
+    do_cpt_double_err(xd, name, &(blockData->blockSumWeight), list);
+    do_cpt_double_err(xd, name, &(blockData->blockSumSquareWeight), list);
+    do_cpt_double_err(xd, name, &(blockData->blockSumWeightX), list);
+    do_cpt_double_err(xd, name, &(blockData->blockSumWeightY), list);
+    do_cpt_double_err(xd, name, &(blockData->sumOverBlocksSquareBlockWeight), list);
+    do_cpt_double_err(xd, name, &(blockData->sumOverBlocksBlockSquareWeight), list);
+    do_cpt_double_err(xd, name, &(blockData->sumOverBlocksBlockWeightBlockWeightX), list);
+    do_cpt_double_err(xd, name, &(blockData->sumOverBlocksBlockWeightBlockWeightY), list);
+    do_cpt_double_err(xd, name, &(blockData->blockLength), list);
+    do_cpt_int_err(xd, name, &(blockData->previousBlockIndex), list);
+    do_cpt_double_err(xd, name, &(blockData->correlationIntegral), list);
+}
+
 static int do_cpt_correlation_grid(XDR*                         xd,
                                    gmx_bool                     bRead,
                                    gmx_unused int               fflags,
@@ -1934,22 +1963,27 @@ static int do_cpt_correlation_grid(XDR*                         xd,
 
     for (gmx::CorrelationBlockDataHistory& blockData : corrGrid->blockDataBuffer)
     {
-        do_cpt_double_err(xd, eawhh_names[eawhh], &(blockData.blockSumWeight), list);
-        do_cpt_double_err(xd, eawhh_names[eawhh], &(blockData.blockSumSquareWeight), list);
-        do_cpt_double_err(xd, eawhh_names[eawhh], &(blockData.blockSumWeightX), list);
-        do_cpt_double_err(xd, eawhh_names[eawhh], &(blockData.blockSumWeightY), list);
-        do_cpt_double_err(xd, eawhh_names[eawhh], &(blockData.sumOverBlocksSquareBlockWeight), list);
-        do_cpt_double_err(xd, eawhh_names[eawhh], &(blockData.sumOverBlocksBlockSquareWeight), list);
-        do_cpt_double_err(xd, eawhh_names[eawhh], &(blockData.sumOverBlocksBlockWeightBlockWeightX), list);
-        do_cpt_double_err(xd, eawhh_names[eawhh], &(blockData.sumOverBlocksBlockWeightBlockWeightY), list);
-        do_cpt_double_err(xd, eawhh_names[eawhh], &(blockData.blockLength), list);
-        do_cpt_int_err(xd, eawhh_names[eawhh], &(blockData.previousBlockIndex), list);
-        do_cpt_double_err(xd, eawhh_names[eawhh], &(blockData.correlationIntegral), list);
+        do_cpt_correlation_block(xd, eawhh_names[eawhh], &blockData, list);
     }
 
     return ret;
 }
 
+static void do_cpt_awh_point(XDR* xd, const char* name, gmx::AwhPointStateHistory* psh, FILE* list)
+{
+    do_cpt_double_err(xd, name, &psh->target, list);
+    do_cpt_double_err(xd, name, &psh->free_energy, list);
+    do_cpt_double_err(xd, name, &psh->bias, list);
+    do_cpt_double_err(xd, name, &psh->weightsum_iteration, list);
+    do_cpt_double_err(xd, name, &psh->weightsum_covering, list);
+    do_cpt_double_err(xd, name, &psh->weightsum_tot, list);
+    do_cpt_double_err(xd, name, &psh->weightsum_ref, list);
+    do_cpt_step_err(xd, name, &psh->last_update_index, list);
+    do_cpt_double_err(xd, name, &psh->log_pmfsum, list);
+    do_cpt_double_err(xd, name, &psh->visits_iteration, list);
+    do_cpt_double_err(xd, name, &psh->visits_tot, list);
+}
+
 static int do_cpt_awh_bias(XDR* xd, gmx_bool bRead, int fflags, gmx::AwhBiasHistory* biasHistory, FILE* list)
 {
     int ret = 0;
@@ -1987,17 +2021,7 @@ static int do_cpt_awh_bias(XDR* xd, gmx_bool bRead, int fflags, gmx::AwhBiasHist
                 case eawhhCOORDPOINT:
                     for (auto& psh : biasHistory->pointState)
                     {
-                        do_cpt_double_err(xd, eawhh_names[i], &psh.target, list);
-                        do_cpt_double_err(xd, eawhh_names[i], &psh.free_energy, list);
-                        do_cpt_double_err(xd, eawhh_names[i], &psh.bias, list);
-                        do_cpt_double_err(xd, eawhh_names[i], &psh.weightsum_iteration, list);
-                        do_cpt_double_err(xd, eawhh_names[i], &psh.weightsum_covering, list);
-                        do_cpt_double_err(xd, eawhh_names[i], &psh.weightsum_tot, list);
-                        do_cpt_double_err(xd, eawhh_names[i], &psh.weightsum_ref, list);
-                        do_cpt_step_err(xd, eawhh_names[i], &psh.last_update_index, list);
-                        do_cpt_double_err(xd, eawhh_names[i], &psh.log_pmfsum, list);
-                        do_cpt_double_err(xd, eawhh_names[i], &psh.visits_iteration, list);
-                        do_cpt_double_err(xd, eawhh_names[i], &psh.visits_tot, list);
+                        do_cpt_awh_point(xd, eawhh_names[i], &psh, list);
                     }
                     break;
                 case eawhhUMBRELLAGRIDPOINT:
@@ -2077,6 +2101,216 @@ static int do_cpt_awh(XDR* xd, gmx_bool bRead, int fflags, gmx::AwhHistory* awhH
     return ret;
 }
 
+/* The last full AWH history written in delta-checkpoint mode, used to
+ * detect which grid points changed since the base checkpoint. Checkpoints
+ * are only written by the master rank, so plain statics suffice here,
+ * like for the background checkpoint finishing above.
+ */
+static std::shared_ptr<gmx::AwhHistory> deltaCheckpointBaseAwh;
+static int64_t                          deltaCheckpointBaseStep = -1;
+
+/*! \brief Returns the name of the base checkpoint file belonging to \p fn */
+static std::string delta_checkpoint_base_filename(const char* fn)
+{
+    std::string fnBase(fn);
+    size_t      extension = fnBase.rfind('.');
+    if (extension != std::string::npos)
+    {
+        fnBase.insert(extension, "_base");
+    }
+    else
+    {
+        fnBase += "_base";
+    }
+    return fnBase;
+}
+
+static bool awh_point_changed(const gmx::AwhPointStateHistory& a, const gmx::AwhPointStateHistory& b)
+{
+    return a.target != b.target || a.free_energy != b.free_energy || a.bias != b.bias
+           || a.weightsum_iteration != b.weightsum_iteration
+           || a.weightsum_covering != b.weightsum_covering || a.weightsum_tot != b.weightsum_tot
+           || a.weightsum_ref != b.weightsum_ref || a.last_update_index != b.last_update_index
+           || a.log_pmfsum != b.log_pmfsum || a.visits_iteration != b.visits_iteration
+           || a.visits_tot != b.visits_tot;
+}
+
+static bool correlation_block_changed(const gmx::CorrelationBlockDataHistory& a,
+                                      const gmx::CorrelationBlockDataHistory& b)
+{
+    return a.blockSumWeight != b.blockSumWeight || a.blockSumSquareWeight != b.blockSumSquareWeight
+           || a.blockSumWeightX != b.blockSumWeightX || a.blockSumWeightY != b.blockSumWeightY
+           || a.sumOverBlocksSquareBlockWeight != b.sumOverBlocksSquareBlockWeight
+           || a.sumOverBlocksBlockSquareWeight != b.sumOverBlocksBlockSquareWeight
+           || a.sumOverBlocksBlockWeightBlockWeightX != b.sumOverBlocksBlockWeightBlockWeightX
+           || a.sumOverBlocksBlockWeightBlockWeightY != b.sumOverBlocksBlockWeightBlockWeightY
+           || a.blockLength != b.blockLength || a.previousBlockIndex != b.previousBlockIndex
+           || a.correlationIntegral != b.correlationIntegral;
+}
+
+/* Sparse AWH history record for delta checkpoints: only the grid points
+ * and correlation blocks that changed since the base checkpoint are
+ * stored, with their indices. The small scalar state is always stored in
+ * full. Reading applies the updates on top of \p awhHistory, which must
+ * already contain the base state to reconstruct the full history; with an
+ * empty history the record is still parsed consistently, which is what
+ * the tool readers need to get past this section.
+ */
+static int do_cpt_awh_delta(XDR*                    xd,
+                            gmx_bool                bRead,
+                            int                     fflags,
+                            gmx::AwhHistory*        awhHistory,
+                            const gmx::AwhHistory*  baseHistory,
+                            FILE*                   list)
+{
+    if (fflags == 0)
+    {
+        return 0;
+    }
+    GMX_RELEASE_ASSERT(awhHistory != nullptr, "Need an AwhHistory for a delta checkpoint");
+    if (!bRead)
+    {
+        GMX_RELEASE_ASSERT(baseHistory != nullptr
+                                   && baseHistory->bias.size() == awhHistory->bias.size(),
+                           "Writing a delta checkpoint requires a matching base AWH history");
+    }
+
+    int numBias = awhHistory->bias.size();
+    do_cpt_int_err(xd, "awh_nbias", &numBias, list);
+    if (bRead)
+    {
+        awhHistory->bias.resize(numBias);
+    }
+
+    for (int b = 0; b < numBias; b++)
+    {
+        gmx::AwhBiasHistory*      bias  = &awhHistory->bias[b];
+        gmx::AwhBiasStateHistory* state = &bias->state;
+
+        do_cpt_bool_err(xd, eawhh_names[eawhhIN_INITIAL], &state->in_initial, list);
+        do_cpt_bool_err(xd, eawhh_names[eawhhEQUILIBRATEHISTOGRAM], &state->equilibrateHistogram, list);
+        do_cpt_double_err(xd, eawhh_names[eawhhHISTSIZE], &state->histSize, list);
+        do_cpt_int_err(xd, eawhh_names[eawhhUMBRELLAGRIDPOINT], &state->umbrellaGridpoint, list);
+        do_cpt_int_err(xd, eawhh_names[eawhhUPDATELIST], &state->origin_index_updatelist, list);
+        do_cpt_int_err(xd, eawhh_names[eawhhUPDATELIST], &state->end_index_updatelist, list);
+        do_cpt_double_err(xd, eawhh_names[eawhhLOGSCALEDSAMPLEWEIGHT], &state->logScaledSampleWeight, list);
+        do_cpt_double_err(xd, eawhh_names[eawhhLOGSCALEDSAMPLEWEIGHT],
+                          &state->maxLogScaledSampleWeight, list);
+        do_cpt_step_err(xd, eawhh_names[eawhhNUMUPDATES], &state->numUpdates, list);
+
+        int numPoints = bias->pointState.size();
+        do_cpt_int_err(xd, eawhh_names[eawhhNPOINTS], &numPoints, list);
+        if (bRead)
+        {
+            bias->pointState.resize(numPoints);
+        }
+
+        const std::vector<gmx::AwhPointStateHistory>* basePoints =
+                (!bRead ? &baseHistory->bias[b].pointState : nullptr);
+        int numChanged = 0;
+        if (!bRead)
+        {
+            GMX_RELEASE_ASSERT(basePoints->size() == bias->pointState.size(),
+                               "AWH grid size changed since the base checkpoint");
+            for (int p = 0; p < numPoints; p++)
+            {
+                if (awh_point_changed(bias->pointState[p], (*basePoints)[p]))
+                {
+                    numChanged++;
+                }
+            }
+        }
+        do_cpt_int_err(xd, eawhh_names[eawhhCOORDPOINT], &numChanged, list);
+        if (!bRead)
+        {
+            for (int p = 0; p < numPoints; p++)
+            {
+                if (awh_point_changed(bias->pointState[p], (*basePoints)[p]))
+                {
+                    do_cpt_int_err(xd, eawhh_names[eawhhCOORDPOINT], &p, list);
+                    do_cpt_awh_point(xd, eawhh_names[eawhhCOORDPOINT], &bias->pointState[p], list);
+                }
+            }
+        }
+        else
+        {
+            for (int c = 0; c < numChanged; c++)
+            {
+                int p = -1;
+                do_cpt_int_err(xd, eawhh_names[eawhhCOORDPOINT], &p, list);
+                if (p < 0 || p >= numPoints)
+                {
+                    cp_error();
+                }
+                do_cpt_awh_point(xd, eawhh_names[eawhhCOORDPOINT], &bias->pointState[p], list);
+            }
+        }
+
+        if (fflags & (1 << eawhhFORCECORRELATIONGRID))
+        {
+            gmx::CorrelationGridHistory* corrGrid = &bias->forceCorrelationGrid;
+
+            do_cpt_int_err(xd, eawhh_names[eawhhFORCECORRELATIONGRID], &corrGrid->numCorrelationTensors, list);
+            do_cpt_int_err(xd, eawhh_names[eawhhFORCECORRELATIONGRID], &corrGrid->tensorSize, list);
+            do_cpt_int_err(xd, eawhh_names[eawhhFORCECORRELATIONGRID], &corrGrid->blockDataListSize, list);
+            if (bRead
+                && gmx::ssize(corrGrid->blockDataBuffer)
+                           != corrGrid->numCorrelationTensors * corrGrid->tensorSize * corrGrid->blockDataListSize)
+            {
+                initCorrelationGridHistory(corrGrid, corrGrid->numCorrelationTensors,
+                                           corrGrid->tensorSize, corrGrid->blockDataListSize);
+            }
+            int numBlocks = corrGrid->blockDataBuffer.size();
+
+            const std::vector<gmx::CorrelationBlockDataHistory>* baseBlocks =
+                    (!bRead ? &baseHistory->bias[b].forceCorrelationGrid.blockDataBuffer : nullptr);
+            int numChangedBlocks = 0;
+            if (!bRead)
+            {
+                GMX_RELEASE_ASSERT(baseBlocks->size() == corrGrid->blockDataBuffer.size(),
+                                   "AWH correlation grid size changed since the base checkpoint");
+                for (int k = 0; k < numBlocks; k++)
+                {
+                    if (correlation_block_changed(corrGrid->blockDataBuffer[k], (*baseBlocks)[k]))
+                    {
+                        numChangedBlocks++;
+                    }
+                }
+            }
+            do_cpt_int_err(xd, eawhh_names[eawhhFORCECORRELATIONGRID], &numChangedBlocks, list);
+            if (!bRead)
+            {
+                for (int k = 0; k < numBlocks; k++)
+                {
+                    if (correlation_block_changed(corrGrid->blockDataBuffer[k], (*baseBlocks)[k]))
+                    {
+                        do_cpt_int_err(xd, eawhh_names[eawhhFORCECORRELATIONGRID], &k, list);
+                        do_cpt_correlation_block(xd, eawhh_names[eawhhFORCECORRELATIONGRID],
+                                                 &corrGrid->blockDataBuffer[k], list);
+                    }
+                }
+            }
+            else
+            {
+                for (int c = 0; c < numChangedBlocks; c++)
+                {
+                    int k = -1;
+                    do_cpt_int_err(xd, eawhh_names[eawhhFORCECORRELATIONGRID], &k, list);
+                    if (k < 0 || k >= numBlocks)
+                    {
+                        cp_error();
+                    }
+                    do_cpt_correlation_block(xd, eawhh_names[eawhhFORCECORRELATIONGRID],
+                                             &corrGrid->blockDataBuffer[k], list);
+                }
+            }
+        }
+    }
+    do_cpt_double_err(xd, "awh_potential_offset", &awhHistory->potentialOffset, list);
+
+    return 0;
+}
+
 static void do_cpt_mdmodules(int                           fileVersion,
                              t_fileio*                     checkpointFileHandle,
                              const gmx::MdModulesNotifier& mdModulesNotifier)
@@ -2178,6 +2412,104 @@ static int do_cpt_files(XDR* xd, gmx_bool bRead, std::vector<gmx_file_position_t
 }
 
 
+/* State of the background thread that finishes a checkpoint write when
+ * GMX_ASYNC_CHECKPOINT is set. Only the master rank writes checkpoints, and
+ * writes are serialized by wait_for_pending_checkpoint(), so file-scope
+ * variables suffice.
+ */
+static std::thread checkpointFinishThread;
+static std::string checkpointFinishErrorMessage;
+
+/* Syncs, closes and renames the files of a checkpoint whose contents have
+ * been written. This only touches the file system, not the simulation state,
+ * so it can run on a background thread. Returns an empty string on success
+ * and a fatal error message otherwise.
+ */
+static std::string finish_checkpoint_files(t_fileio*          fp,
+                                           const std::string& fn,
+                                           const std::string& fntemp,
+                                           gmx_bool           bNumberAndKeep)
+{
+    char buf[STRLEN];
+
+    /* we really, REALLY, want to make sure to physically write the checkpoint,
+       and all the files it depends on, out to disk. Because we've
+       opened the checkpoint with gmx_fio_open(), it's in our list
+       of open files.  */
+    t_fileio* ret = gmx_fio_all_output_fsync();
+
+    if (ret)
+    {
+        sprintf(buf, "Cannot fsync '%s'; maybe you are out of disk space?", gmx_fio_getname(ret));
+
+        if (getenv(GMX_IGNORE_FSYNC_FAILURE_ENV) == nullptr)
+        {
+            return buf;
+        }
+        else
+        {
+            gmx_warning("%s", buf);
+        }
+    }
+
+    if (gmx_fio_close(fp) != 0)
+    {
+        return "Cannot read/write checkpoint; corrupt file, or maybe you are out of disk space?";
+    }
+
+    /* we don't move the checkpoint if the user specified they didn't want it,
+       or if the fsyncs failed */
+#if !GMX_NO_RENAME
+    if (!bNumberAndKeep && !ret)
+    {
+        if (gmx_fexist(fn.c_str()))
+        {
+            /* Rename the previous checkpoint file */
+            std::strcpy(buf, fn.c_str());
+            buf[fn.length() - std::strlen(ftp2ext(fn2ftp(fn.c_str()))) - 1] = '\0';
+            std::strcat(buf, "_prev");
+            std::strcat(buf, fn.c_str() + fn.length() - std::strlen(ftp2ext(fn2ftp(fn.c_str()))) - 1);
+            if (!GMX_FAHCORE)
+            {
+                /* we copy here so that if something goes wrong between now and
+                 * the rename below, there's always a state.cpt.
+                 * If renames are atomic (such as in POSIX systems),
+                 * this copying should be unneccesary.
+                 */
+                gmx_file_copy(fn.c_str(), buf, FALSE);
+                /* We don't really care if this fails:
+                 * there's already a new checkpoint.
+                 */
+            }
+            else
+            {
+                gmx_file_rename(fn.c_str(), buf);
+            }
+        }
+        if (gmx_file_rename(fntemp.c_str(), fn.c_str()) != 0)
+        {
+            return "Cannot rename checkpoint file; maybe you are out of disk space?";
+        }
+    }
+#endif /* GMX_NO_RENAME */
+
+    return "";
+}
+
+void wait_for_pending_checkpoint()
+{
+    if (checkpointFinishThread.joinable())
+    {
+        checkpointFinishThread.join();
+    }
+    if (!checkpointFinishErrorMessage.empty())
+    {
+        std::string message = checkpointFinishErrorMessage;
+        checkpointFinishErrorMessage.clear();
+        gmx_file(message.c_str());
+    }
+}
+
 void write_checkpoint(const char*                   fn,
                       gmx_bool                      bNumberAndKeep,
                       FILE*                         fplog,
@@ -2198,7 +2530,11 @@ void write_checkpoint(const char*                   fn,
     char*     fntemp; /* the temporary checkpoint file name */
     int       npmenodes;
     char      buf[1024], suffix[5 + STEPSTRSIZE], sbuf[STEPSTRSIZE];
-    t_fileio* ret;
+
+    /* Make sure a checkpoint that is still being finished on a background
+     * thread has hit the disk before we start the next one.
+     */
+    wait_for_pending_checkpoint();
 
     if (DOMAINDECOMP(cr))
     {
@@ -2234,8 +2570,6 @@ void write_checkpoint(const char*                   fn,
     /* Get offsets for open files */
     auto outputfiles = gmx_fio_get_output_file_positions();
 
-    fp = gmx_fio_open(fntemp, "w");
-
     int flags_eks;
     if (state->ekinstate.bUpToDate)
     {
@@ -2347,7 +2681,9 @@ void write_checkpoint(const char*                   fn,
                                                 flags_dfh,
                                                 flags_awhh,
                                                 nED,
-                                                eSwapCoords };
+                                                eSwapCoords,
+                                                0,
+                                                -1 };
     std::strcpy(headerContents.version, gmx_version());
     std::strcpy(headerContents.fprog, gmx::getProgramContext().fullBinaryPath());
     std::strcpy(headerContents.ftime, timebuf.c_str());
@@ -2356,96 +2692,112 @@ void write_checkpoint(const char*                   fn,
         copy_ivec(domdecCells, headerContents.dd_nc);
     }
 
-    do_cpt_header(gmx_fio_getxdr(fp), FALSE, nullptr, &headerContents);
-
-    if ((do_cpt_state(gmx_fio_getxdr(fp), state->flags, state, nullptr) < 0)
-        || (do_cpt_ekinstate(gmx_fio_getxdr(fp), flags_eks, &state->ekinstate, nullptr) < 0)
-        || (do_cpt_enerhist(gmx_fio_getxdr(fp), FALSE, flags_enh, enerhist, nullptr) < 0)
-        || (doCptPullHist(gmx_fio_getxdr(fp), FALSE, flagsPullHistory, pullHist, StatePart::pullHistory, nullptr)
-            < 0)
-        || (do_cpt_df_hist(gmx_fio_getxdr(fp), flags_dfh, nlambda, &state->dfhist, nullptr) < 0)
-        || (do_cpt_EDstate(gmx_fio_getxdr(fp), FALSE, nED, edsamhist, nullptr) < 0)
-        || (do_cpt_awh(gmx_fio_getxdr(fp), FALSE, flags_awhh, state->awhHistory.get(), nullptr) < 0)
-        || (do_cpt_swapstate(gmx_fio_getxdr(fp), FALSE, eSwapCoords, swaphist, nullptr) < 0)
-        || (do_cpt_files(gmx_fio_getxdr(fp), FALSE, &outputfiles, nullptr, headerContents.file_version) < 0))
+    auto writeCheckpointData = [&](t_fileio* fpOut, bool sparseAwh) {
+        do_cpt_header(gmx_fio_getxdr(fpOut), FALSE, nullptr, &headerContents);
+
+        if ((do_cpt_state(gmx_fio_getxdr(fpOut), state->flags, state, nullptr) < 0)
+            || (do_cpt_ekinstate(gmx_fio_getxdr(fpOut), flags_eks, &state->ekinstate, nullptr) < 0)
+            || (do_cpt_enerhist(gmx_fio_getxdr(fpOut), FALSE, flags_enh, enerhist, nullptr) < 0)
+            || (doCptPullHist(gmx_fio_getxdr(fpOut), FALSE, flagsPullHistory, pullHist,
+                              StatePart::pullHistory, nullptr)
+                < 0)
+            || (do_cpt_df_hist(gmx_fio_getxdr(fpOut), flags_dfh, nlambda, &state->dfhist, nullptr) < 0)
+            || (do_cpt_EDstate(gmx_fio_getxdr(fpOut), FALSE, nED, edsamhist, nullptr) < 0)
+            || (sparseAwh ? (do_cpt_awh_delta(gmx_fio_getxdr(fpOut), FALSE, flags_awhh,
+                                              state->awhHistory.get(), deltaCheckpointBaseAwh.get(), nullptr)
+                             < 0)
+                          : (do_cpt_awh(gmx_fio_getxdr(fpOut), FALSE, flags_awhh,
+                                        state->awhHistory.get(), nullptr)
+                             < 0))
+            || (do_cpt_swapstate(gmx_fio_getxdr(fpOut), FALSE, eSwapCoords, swaphist, nullptr) < 0)
+            || (do_cpt_files(gmx_fio_getxdr(fpOut), FALSE, &outputfiles, nullptr, headerContents.file_version) < 0))
+        {
+            gmx_file("Cannot read/write checkpoint; corrupt file, or maybe you are out of disk space?");
+        }
+
+        // Checkpointing MdModules
+        {
+            gmx::KeyValueTreeBuilder          builder;
+            gmx::MdModulesWriteCheckpointData mdModulesWriteCheckpoint = {
+                builder.rootObject(), headerContents.file_version
+            };
+            mdModulesNotifier.checkpointingNotifications_.notify(mdModulesWriteCheckpoint);
+            auto                     tree = builder.build();
+            gmx::FileIOXdrSerializer serializer(fpOut);
+            gmx::serializeKeyValueTree(tree, &serializer);
+        }
+
+        do_cpt_footer(gmx_fio_getxdr(fpOut), headerContents.file_version);
+    };
+
+    /* In delta-checkpoint mode a full base checkpoint is written to a
+     * separate _base file every GMX_DELTA_CHECKPOINT-th call, and the
+     * regular checkpoint file stores the AWH history as sparse updates
+     * relative to that base. This cuts the checkpoint volume for runs
+     * whose AWH grids dominate the file; restarting needs both files.
+     */
+    static int deltaCheckpointCount = 0;
+    int        deltaInterval        = 0;
+    if (const char* env = getenv("GMX_DELTA_CHECKPOINT"))
     {
-        gmx_file("Cannot read/write checkpoint; corrupt file, or maybe you are out of disk space?");
+        deltaInterval = std::strtol(env, nullptr, 10);
     }
+    const bool writeDelta = (deltaInterval >= 2 && flags_awhh != 0 && !GMX_FAHCORE);
 
-    // Checkpointing MdModules
+    if (writeDelta)
     {
-        gmx::KeyValueTreeBuilder          builder;
-        gmx::MdModulesWriteCheckpointData mdModulesWriteCheckpoint = { builder.rootObject(),
-                                                                       headerContents.file_version };
-        mdModulesNotifier.checkpointingNotifications_.notify(mdModulesWriteCheckpoint);
-        auto                     tree = builder.build();
-        gmx::FileIOXdrSerializer serializer(fp);
-        gmx::serializeKeyValueTree(tree, &serializer);
-    }
-
-    do_cpt_footer(gmx_fio_getxdr(fp), headerContents.file_version);
-
-    /* we really, REALLY, want to make sure to physically write the checkpoint,
-       and all the files it depends on, out to disk. Because we've
-       opened the checkpoint with gmx_fio_open(), it's in our list
-       of open files.  */
-    ret = gmx_fio_all_output_fsync();
-
-    if (ret)
-    {
-        char buf[STRLEN];
-        sprintf(buf, "Cannot fsync '%s'; maybe you are out of disk space?", gmx_fio_getname(ret));
-
-        if (getenv(GMX_IGNORE_FSYNC_FAILURE_ENV) == nullptr)
-        {
-            gmx_file(buf);
-        }
-        else
+        if (deltaCheckpointCount % deltaInterval == 0)
         {
-            gmx_warning("%s", buf);
+            std::string fnBase = delta_checkpoint_base_filename(fn);
+#if GMX_NO_RENAME
+            std::string fnBaseTemp = fnBase;
+#else
+            std::string fnBaseTemp = fnBase + ".tmp";
+#endif
+            headerContents.isDeltaCheckpoint = 0;
+            headerContents.deltaBaseStep     = -1;
+            t_fileio* fpBase                 = gmx_fio_open(fnBaseTemp.c_str(), "w");
+            writeCheckpointData(fpBase, false);
+            std::string errorMessage = finish_checkpoint_files(fpBase, fnBase, fnBaseTemp, FALSE);
+            if (!errorMessage.empty())
+            {
+                gmx_file(errorMessage.c_str());
+            }
+            deltaCheckpointBaseAwh  = std::make_shared<gmx::AwhHistory>(*state->awhHistory);
+            deltaCheckpointBaseStep = step;
         }
+        deltaCheckpointCount++;
+        headerContents.isDeltaCheckpoint = 1;
+        headerContents.deltaBaseStep     = deltaCheckpointBaseStep;
     }
 
-    if (gmx_fio_close(fp) != 0)
+    fp = gmx_fio_open(fntemp, "w");
+    writeCheckpointData(fp, writeDelta);
+
+    /* The serialization above had to walk the live state, but syncing and
+     * renaming only touch the file system, so with GMX_ASYNC_CHECKPOINT set
+     * the simulation can continue while a background thread waits for the
+     * data to hit the disk. Any error is raised at the next checkpoint or
+     * by wait_for_pending_checkpoint() when the output files are closed.
+     * With GMX_FAHCORE the core is notified right after the rename, so the
+     * finish stays synchronous there.
+     */
+    if (getenv("GMX_ASYNC_CHECKPOINT") != nullptr && !GMX_FAHCORE)
     {
-        gmx_file("Cannot read/write checkpoint; corrupt file, or maybe you are out of disk space?");
+        std::string fnCopy     = fn;
+        std::string fntempCopy = fntemp;
+        checkpointFinishThread = std::thread([fp, fnCopy, fntempCopy, bNumberAndKeep]() {
+            checkpointFinishErrorMessage = finish_checkpoint_files(fp, fnCopy, fntempCopy, bNumberAndKeep);
+        });
     }
-
-    /* we don't move the checkpoint if the user specified they didn't want it,
-       or if the fsyncs failed */
-#if !GMX_NO_RENAME
-    if (!bNumberAndKeep && !ret)
+    else
     {
-        if (gmx_fexist(fn))
-        {
-            /* Rename the previous checkpoint file */
-            std::strcpy(buf, fn);
-            buf[std::strlen(fn) - std::strlen(ftp2ext(fn2ftp(fn))) - 1] = '\0';
-            std::strcat(buf, "_prev");
-            std::strcat(buf, fn + std::strlen(fn) - std::strlen(ftp2ext(fn2ftp(fn))) - 1);
-            if (!GMX_FAHCORE)
-            {
-                /* we copy here so that if something goes wrong between now and
-                 * the rename below, there's always a state.cpt.
-                 * If renames are atomic (such as in POSIX systems),
-                 * this copying should be unneccesary.
-                 */
-                gmx_file_copy(fn, buf, FALSE);
-                /* We don't really care if this fails:
-                 * there's already a new checkpoint.
-                 */
-            }
-            else
-            {
-                gmx_file_rename(fn, buf);
-            }
-        }
-        if (gmx_file_rename(fntemp, fn) != 0)
+        std::string errorMessage = finish_checkpoint_files(fp, fn, fntemp, bNumberAndKeep);
+        if (!errorMessage.empty())
         {
-            gmx_file("Cannot rename checkpoint file; maybe you are out of disk space?");
+            gmx_file(errorMessage.c_str());
         }
     }
-#endif /* GMX_NO_RENAME */
 
     sfree(fntemp);
 
@@ -2595,6 +2947,40 @@ static void check_match(FILE*                           fplog,
     }
 }
 
+static CheckpointHeaderContents read_checkpoint_data(t_fileio*                         fp,
+                                                     t_state*                          state,
+                                                     std::vector<gmx_file_position_t>* outputfiles);
+
+/*! \brief Loads the full AWH history from the base checkpoint belonging to delta checkpoint \p fn */
+static void read_delta_checkpoint_base(const char* fn, const CheckpointHeaderContents& deltaHeader, t_state* state)
+{
+    char        buf[STEPSTRSIZE];
+    std::string fnBase = delta_checkpoint_base_filename(fn);
+
+    if (!gmx_fexist(fnBase.c_str()))
+    {
+        gmx_fatal(FARGS,
+                  "Checkpoint file %s is a delta checkpoint, but its base checkpoint %s was not "
+                  "found. Both files are needed to restart from a run that used "
+                  "GMX_DELTA_CHECKPOINT.",
+                  fn, fnBase.c_str());
+    }
+    t_fileio* fp = gmx_fio_open(fnBase.c_str(), "r");
+    t_state   baseState;
+    baseState.awhHistory = std::make_shared<gmx::AwhHistory>();
+    std::vector<gmx_file_position_t> outputfiles;
+    CheckpointHeaderContents         baseHeader = read_checkpoint_data(fp, &baseState, &outputfiles);
+    gmx_fio_close(fp);
+    if (baseHeader.isDeltaCheckpoint != 0 || baseHeader.step != deltaHeader.deltaBaseStep)
+    {
+        gmx_fatal(FARGS,
+                  "Base checkpoint %s does not match delta checkpoint %s, expected a full "
+                  "checkpoint of step %s",
+                  fnBase.c_str(), fn, gmx_step_str(deltaHeader.deltaBaseStep, buf));
+    }
+    state->awhHistory = baseState.awhHistory;
+}
+
 static void read_checkpoint(const char*                   fn,
                             t_fileio*                     logfio,
                             const t_commrec*              cr,
@@ -2762,7 +3148,20 @@ static void read_checkpoint(const char*                   fn,
     {
         state->awhHistory = std::make_shared<gmx::AwhHistory>();
     }
-    ret = do_cpt_awh(gmx_fio_getxdr(fp), TRUE, headerContents->flags_awhh, state->awhHistory.get(), nullptr);
+    if (headerContents->isDeltaCheckpoint != 0 && headerContents->flags_awhh != 0)
+    {
+        /* Load the full AWH history from the base checkpoint first, then
+         * apply the sparse updates stored in this delta checkpoint.
+         */
+        read_delta_checkpoint_base(fn, *headerContents, state);
+        ret = do_cpt_awh_delta(gmx_fio_getxdr(fp), TRUE, headerContents->flags_awhh,
+                               state->awhHistory.get(), nullptr, nullptr);
+    }
+    else
+    {
+        ret = do_cpt_awh(gmx_fio_getxdr(fp), TRUE, headerContents->flags_awhh,
+                         state->awhHistory.get(), nullptr);
+    }
     if (ret)
     {
         cp_error();
@@ -2916,7 +3315,20 @@ static CheckpointHeaderContents read_checkpoint_data(t_fileio*
         cp_error();
     }
 
-    ret = do_cpt_awh(gmx_fio_getxdr(fp), TRUE, headerContents.flags_awhh, state->awhHistory.get(), nullptr);
+    if (headerContents.isDeltaCheckpoint != 0 && headerContents.flags_awhh != 0)
+    {
+        if (state->awhHistory == nullptr)
+        {
+            state->awhHistory = std::make_shared<gmx::AwhHistory>();
+        }
+        ret = do_cpt_awh_delta(gmx_fio_getxdr(fp), TRUE, headerContents.flags_awhh,
+                               state->awhHistory.get(), nullptr, nullptr);
+    }
+    else
+    {
+        ret = do_cpt_awh(gmx_fio_getxdr(fp), TRUE, headerContents.flags_awhh,
+                         state->awhHistory.get(), nullptr);
+    }
     if (ret)
     {
         cp_error();
@@ -3028,7 +3440,17 @@ void list_checkpoint(const char* fn, FILE* out)
 
     if (ret == 0)
     {
-        ret = do_cpt_awh(gmx_fio_getxdr(fp), TRUE, headerContents.flags_awhh, state.awhHistory.get(), out);
+        if (headerContents.isDeltaCheckpoint != 0 && headerContents.flags_awhh != 0)
+        {
+            state.awhHistory = std::make_shared<gmx::AwhHistory>();
+            ret = do_cpt_awh_delta(gmx_fio_getxdr(fp), TRUE, headerContents.flags_awhh,
+                                   state.awhHistory.get(), nullptr, out);
+        }
+        else
+        {
+            ret = do_cpt_awh(gmx_fio_getxdr(fp), TRUE, headerContents.flags_awhh,
+                             state.awhHistory.get(), out);
+        }
     }
 
     if (ret == 0)
@@ -174,6 +174,10 @@ struct CheckpointHeaderContents
     int nED;
     //! Enum for coordinate swapping.
     int eSwapCoords;
+    //! Whether this is a delta checkpoint with AWH history stored as sparse updates to a base checkpoint.
+    int isDeltaCheckpoint;
+    //! Step of the base checkpoint a delta checkpoint refers to, -1 when not a delta checkpoint.
+    int64_t deltaBaseStep;
 };
 
 /* Write a checkpoint to <fn>.cpt
@@ -196,6 +200,13 @@ void write_checkpoint(const char*                   fn,
                       ObservablesHistory*           observablesHistory,
                       const gmx::MdModulesNotifier& notifier);
 
+/* Waits for a checkpoint write that is being finished on a background
+ * thread (see GMX_ASYNC_CHECKPOINT in write_checkpoint) and raises any
+ * error it recorded. Must be called before the output files are closed.
+ * A no-op when no write is pending.
+ */
+void wait_for_pending_checkpoint();
+
 /* Loads a checkpoint from fn for run continuation.
  * Generates a fatal error on system size mismatch.
  * The master node reads the file
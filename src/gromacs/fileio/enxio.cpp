@@ -94,6 +94,9 @@ struct ener_file
     t_fileio*  fio;
     int        framenr;
     real       frametime;
+    int        nSubTerms;   /* Number of entries in bSubTerm, 0 when unset */
+    gmx_bool*  bSubTerm;    /* Which energy terms to decode, NULL for all  */
+    gmx_bool   bSkipBlocks; /* Skip the extra data blocks when reading     */
 };
 
 static void enxsubblock_init(t_enxsubblock* sb)
@@ -769,6 +772,7 @@ void done_ener_file(ener_file_t ef)
 {
     // Free the contents, then the pointer itself
     close_enx(ef);
+    sfree(ef->bSubTerm);
     sfree(ef);
 }
 
@@ -950,6 +954,25 @@ static void convert_full_sums(ener_old_t* ener_old, t_enxframe* fr)
     ener_old->step_prev = fr->step;
 }
 
+void set_enx_subscription(ener_file_t ef, int nre, const gmx_bool* bSelectedTerms, gmx_bool bReadBlocks)
+{
+    int i;
+
+    sfree(ef->bSubTerm);
+    ef->bSubTerm  = nullptr;
+    ef->nSubTerms = 0;
+    if (bSelectedTerms != nullptr)
+    {
+        snew(ef->bSubTerm, nre);
+        for (i = 0; i < nre; i++)
+        {
+            ef->bSubTerm[i] = bSelectedTerms[i];
+        }
+        ef->nSubTerms = nre;
+    }
+    ef->bSkipBlocks = !bReadBlocks;
+}
+
 gmx_bool do_enx(ener_file_t ef, t_enxframe* fr)
 {
     int      file_version = -1;
@@ -1021,8 +1044,48 @@ gmx_bool do_enx(ener_file_t ef, t_enxframe* fr)
         fr->e_alloc = fr->nre;
     }
 
+    /* With a term subscription active, non-selected terms are skipped by
+     * seeking: the terms are stored back to back with a fixed size, so we
+     * can jump over a run of them without decoding any values.
+     */
+    gmx_off_t termBytes = 0;
+    if (bRead && ef->bSubTerm != nullptr)
+    {
+        if (ef->nSubTerms != fr->nre)
+        {
+            gmx_fatal(FARGS,
+                      "An energy term subscription was set for %d terms, but the frame in %s "
+                      "contains %d terms",
+                      ef->nSubTerms, gmx_fio_getname(ef->fio), fr->nre);
+        }
+        int valsPerTerm = (file_version == 1 || fr->nsum > 0) ? 3 : 1;
+        if (file_version == 1)
+        {
+            valsPerTerm += 1;
+        }
+        termBytes = valsPerTerm * (gmx_fio_is_double(ef->fio) ? sizeof(double) : sizeof(float));
+    }
+
     for (i = 0; i < fr->nre; i++)
     {
+        if (bRead && ef->bSubTerm != nullptr && !ef->bSubTerm[i])
+        {
+            /* Skip the whole run of non-selected terms with one seek;
+             * their values in fr->ener are not updated.
+             */
+            int j = i + 1;
+            while (j < fr->nre && !ef->bSubTerm[j])
+            {
+                j++;
+            }
+            if (gmx_fio_seek(ef->fio, gmx_fio_ftell(ef->fio) + (j - i) * termBytes) != 0)
+            {
+                bOK = FALSE;
+            }
+            i = j - 1;
+            continue;
+        }
+
         bOK = bOK && gmx_fio_do_real(ef->fio, fr->ener[i].e);
 
         /* Do not store sums of length 1,
@@ -1073,6 +1136,34 @@ gmx_bool do_enx(ener_file_t ef, t_enxframe* fr)
         {
             t_enxsubblock* sub = &(fr->block[b].sub[i]); /* shortcut */
 
+            if (bRead && ef->bSkipBlocks)
+            {
+                /* Seek past fixed-size subblock data without decoding or
+                 * allocating; the XDR encoding of these types has a known
+                 * size per value. Strings are variable-size and rare, so
+                 * they take the normal path below.
+                 */
+                gmx_off_t valBytes = 0;
+                switch (sub->type)
+                {
+                    case xdr_datatype_float: valBytes = 4; break;
+                    case xdr_datatype_double: valBytes = 8; break;
+                    case xdr_datatype_int: valBytes = 4; break;
+                    case xdr_datatype_int64: valBytes = 8; break;
+                    /* XDR stores each char in a full 4-byte unit */
+                    case xdr_datatype_char: valBytes = 4; break;
+                    default: break;
+                }
+                if (valBytes > 0)
+                {
+                    if (gmx_fio_seek(ef->fio, gmx_fio_ftell(ef->fio) + sub->nr * valBytes) != 0)
+                    {
+                        bOK = FALSE;
+                    }
+                    continue;
+                }
+            }
+
             if (bRead)
             {
                 enxsubblock_alloc(sub);
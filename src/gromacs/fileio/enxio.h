@@ -178,6 +178,17 @@ void free_enxnms(int n, gmx_enxnm_t* nms);
 gmx_bool do_enx(ener_file_t ef, t_enxframe* fr);
 /* Reads enx_frames, memory in fr is (re)allocated if necessary */
 
+void set_enx_subscription(ener_file_t ef, int nre, const gmx_bool* bSelectedTerms, gmx_bool bReadBlocks);
+/* Restrict what do_enx decodes when reading.
+ * bSelectedTerms is an array of nre flags matching the terms returned by
+ * do_enxnms, or NULL to decode all terms; non-selected terms are skipped
+ * by seeking and their values in t_enxframe are not updated.
+ * With bReadBlocks==FALSE the extra data blocks (restraints, BAR
+ * histograms, delta H data, ...) are also skipped; their headers are
+ * still read, but no data is decoded or allocated.
+ * Only affects reading; pass (ef, 0, NULL, TRUE) to restore full decoding.
+ */
+
 void get_enx_state(const char* fn, real t, const SimulationGroups& groups, t_inputrec* ir, t_state* state);
 /*
  * Reads state variables from enx file fn at time t.
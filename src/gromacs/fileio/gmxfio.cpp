@@ -92,6 +92,10 @@ using Lock = gmx::lock_guard<gmx::Mutex>;
  *
  ******************************************************************/
 
+/* How much must have been written since the last page-cache drop before
+ * we advise the OS again; syscalls per flush would be too frequent. */
+static const gmx_off_t c_pageCacheDropInterval = 16 * 1024 * 1024;
+
 static int gmx_fio_int_flush(t_fileio* fio)
 {
     int rc = 0;
@@ -99,6 +103,16 @@ static int gmx_fio_int_flush(t_fileio* fio)
     if (fio->fp)
     {
         rc = fflush(fio->fp);
+
+        if (rc == 0 && fio->bDropPageCache)
+        {
+            gmx_off_t position = gmx_ftell(fio->fp);
+            if (position - fio->cacheDropPosition >= c_pageCacheDropInterval)
+            {
+                gmx_file_drop_page_cache(fio->fp);
+                fio->cacheDropPosition = position;
+            }
+        }
     }
 
     return rc;
@@ -344,6 +358,18 @@ t_fileio* gmx_fio_open(const char* fn, const char* mode)
     fio->bReadWrite = bReadWrite;
     fio->bDouble    = (sizeof(real) == sizeof(double));
 
+    /* With GMX_DROP_FILE_CACHE set, streamed output files advise the OS
+     * to drop their page cache as they grow, so that large trajectory and
+     * energy writes do not evict more useful data on shared filesystems.
+     */
+    fio->bDropPageCache = FALSE;
+    fio->cacheDropPosition = 0;
+    if (!bRead && getenv("GMX_DROP_FILE_CACHE") != nullptr
+        && (fio->iFTP == efXTC || fio->iFTP == efTRR || fio->iFTP == efTRN || fio->iFTP == efEDR))
+    {
+        fio->bDropPageCache = TRUE;
+    }
+
     /* and now insert this file into the list of open files. */
     gmx_fio_insert(fio);
     return fio;
@@ -361,6 +387,12 @@ static int gmx_fio_close_locked(t_fileio* fio)
 
     if (fio->fp != nullptr)
     {
+        if (fio->bDropPageCache && fflush(fio->fp) == 0)
+        {
+            /* Also drop the cache behind the tail written since the last
+             * interval-triggered drop. */
+            gmx_file_drop_page_cache(fio->fp);
+        }
         rc = gmx_ffclose(fio->fp); /* fclose returns 0 if happy */
     }
 
@@ -69,6 +69,9 @@ struct t_fileio
     enum xdr_op xdrmode; /* the xdr mode */
     int         iFTP;    /* the file type identifier */
 
+    gmx_bool bDropPageCache;     /* drop the page cache behind this file */
+    gmx_off_t cacheDropPosition; /* file position of the last cache drop */
+
     t_fileio *next, *prev; /* next and previous file pointers in the
                               linked list */
     tMPI_Lock_t mtx;       /* content locking mutex. This is a fast lock
@@ -39,6 +39,8 @@
 
 #include "gmxfio_xdr.h"
 
+#include "config.h"
+
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
@@ -592,14 +594,72 @@ gmx_bool gmx_fio_doe_opaque(t_fileio* fio, char* data, std::size_t size, const c
 
 /* Array reading & writing */
 
+/* Copies nitem values of the given width between src and dst, reversing
+ * the byte order of each value. */
+static void swap_copy_values(const char* src, char* dst, std::size_t nitem, std::size_t width)
+{
+    for (std::size_t i = 0; i < nitem; i++)
+    {
+        for (std::size_t b = 0; b < width; b++)
+        {
+            dst[i * width + b] = src[i * width + (width - 1 - b)];
+        }
+    }
+}
+
+/* Bulk path for contiguous floating-point arrays. XDR stores such arrays
+ * simply as the big-endian values back to back, so instead of issuing one
+ * xdr call per value we byte-swap into a buffer and pass it through
+ * xdr_opaque as a single block; the bytes in the file are identical.
+ * Only usable when the in-memory width of the values, passed as width,
+ * equals their width in the file. The fio should be locked by the caller.
+ */
+static gmx_bool do_xdr_fp_array_bulk(t_fileio* fio, void* item, std::size_t nitem, std::size_t width)
+{
+    const std::size_t numBytes = nitem * width;
+    bool_t            res;
+    char*             buf;
+
+    GMX_RELEASE_ASSERT(numBytes < static_cast<std::size_t>(std::numeric_limits<int>::max()),
+                       "The XDR interface cannot handle blocks > 2^31 bytes");
+    snew(buf, numBytes);
+    if (!fio->bRead)
+    {
+#if GMX_INTEGER_BIG_ENDIAN
+        std::memcpy(buf, item, numBytes);
+#else
+        swap_copy_values(static_cast<const char*>(item), buf, nitem, width);
+#endif
+    }
+    res = xdr_opaque(fio->xdr, buf, static_cast<unsigned int>(numBytes));
+    if (res != 0 && fio->bRead)
+    {
+#if GMX_INTEGER_BIG_ENDIAN
+        std::memcpy(item, buf, numBytes);
+#else
+        swap_copy_values(buf, static_cast<char*>(item), nitem, width);
+#endif
+    }
+    sfree(buf);
+
+    return res != 0;
+}
+
 gmx_bool gmx_fio_ndoe_real(t_fileio* fio, real* item, int n, const char* desc, const char* srcfile, int line)
 {
     gmx_bool ret = TRUE;
     int      i;
     gmx_fio_lock(fio);
-    for (i = 0; i < n; i++)
+    if (n > 1 && item != nullptr && (fio->bDouble ? sizeof(double) : sizeof(float)) == sizeof(real))
     {
-        ret = ret && do_xdr(fio, &(item[i]), 1, eioREAL, desc, srcfile, line);
+        ret = do_xdr_fp_array_bulk(fio, item, n, sizeof(real));
+    }
+    else
+    {
+        for (i = 0; i < n; i++)
+        {
+            ret = ret && do_xdr(fio, &(item[i]), 1, eioREAL, desc, srcfile, line);
+        }
     }
     gmx_fio_unlock(fio);
     return ret;
@@ -611,9 +671,16 @@ gmx_bool gmx_fio_ndoe_float(t_fileio* fio, float* item, int n, const char* desc,
     gmx_bool ret = TRUE;
     int      i;
     gmx_fio_lock(fio);
-    for (i = 0; i < n; i++)
+    if (n > 1 && item != nullptr)
+    {
+        ret = do_xdr_fp_array_bulk(fio, item, n, sizeof(float));
+    }
+    else
     {
-        ret = ret && do_xdr(fio, &(item[i]), 1, eioFLOAT, desc, srcfile, line);
+        for (i = 0; i < n; i++)
+        {
+            ret = ret && do_xdr(fio, &(item[i]), 1, eioFLOAT, desc, srcfile, line);
+        }
     }
     gmx_fio_unlock(fio);
     return ret;
@@ -625,9 +692,16 @@ gmx_bool gmx_fio_ndoe_double(t_fileio* fio, double* item, int n, const char* des
     gmx_bool ret = TRUE;
     int      i;
     gmx_fio_lock(fio);
-    for (i = 0; i < n; i++)
+    if (n > 1 && item != nullptr)
     {
-        ret = ret && do_xdr(fio, &(item[i]), 1, eioDOUBLE, desc, srcfile, line);
+        ret = do_xdr_fp_array_bulk(fio, item, n, sizeof(double));
+    }
+    else
+    {
+        for (i = 0; i < n; i++)
+        {
+            ret = ret && do_xdr(fio, &(item[i]), 1, eioDOUBLE, desc, srcfile, line);
+        }
     }
     gmx_fio_unlock(fio);
     return ret;
@@ -723,7 +797,14 @@ gmx_bool gmx_fio_ndoe_rvec(t_fileio* fio, rvec* item, int n, const char* desc, c
 {
     gmx_bool ret = TRUE;
     gmx_fio_lock(fio);
-    ret = ret && do_xdr(fio, item, n, eioNRVEC, desc, srcfile, line);
+    if (n > 1 && item != nullptr && (fio->bDouble ? sizeof(double) : sizeof(float)) == sizeof(real))
+    {
+        ret = do_xdr_fp_array_bulk(fio, item, static_cast<std::size_t>(n) * DIM, sizeof(real));
+    }
+    else
+    {
+        ret = ret && do_xdr(fio, item, n, eioNRVEC, desc, srcfile, line);
+    }
     gmx_fio_unlock(fio);
     return ret;
 }
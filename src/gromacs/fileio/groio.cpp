@@ -56,6 +56,7 @@
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/futil.h"
 #include "gromacs/utility/smalloc.h"
+#include "gromacs/utility/strconvert.h"
 
 static void get_coordnum_fp(FILE* in, char* title, int* natoms)
 {
@@ -96,11 +97,10 @@ static gmx_bool get_w_conf(FILE*       in,
 {
     char     name[6];
     char     resname[6], oldresname[6];
-    char     line[STRLEN + 1], *ptr;
-    char     buf[256];
+    char     line[STRLEN + 1];
     double   x1, y1, z1, x2, y2, z2;
     rvec     xmin, xmax;
-    int      natoms, i, m, resnr, newres, oldres, ddist, c;
+    int      natoms, i, m, resnr, newres, oldres, ddist;
     gmx_bool bFirst, bVel, oldResFirst;
     char *   p1, *p2, *p3;
 
@@ -215,17 +215,19 @@ static gmx_bool get_w_conf(FILE*       in,
         /* eventueel controle atomnumber met i+1 */
 
         /* coordinates (start after residue data) */
-        ptr = line + 20;
-        /* Read fixed format */
+        const char* ptr     = line + 20;
+        const char* lineEnd = line + strlen(line);
+        /* Read fixed format; the fields are parsed in place, which is
+         * much faster than sscanf and matters for large systems.
+         */
         for (m = 0; m < DIM; m++)
         {
-            for (c = 0; (c < ddist && ptr[0]); c++)
-            {
-                buf[c] = ptr[0];
-                ptr++;
-            }
-            buf[c] = '\0';
-            if (sscanf(buf, "%lf %lf", &x1, &x2) != 1)
+            const char* fieldEnd  = std::min(ptr + ddist, lineEnd);
+            const char* numberEnd = gmx::parseDoubleFromFixedField(ptr, fieldEnd, &x1);
+            /* A field without a number, or with a second number, means
+             * the columns do not line up with the decimal point spacing.
+             */
+            if (numberEnd == ptr || gmx::parseDoubleFromFixedField(numberEnd, fieldEnd, &x2) != numberEnd)
             {
                 gmx_fatal(FARGS,
                           "Something is wrong in the coordinate formatting of file %s. Note that "
@@ -236,6 +238,7 @@ static gmx_bool get_w_conf(FILE*       in,
             {
                 x[i][m] = x1;
             }
+            ptr = fieldEnd;
         }
 
         /* velocities (start after residues and coordinates) */
@@ -244,13 +247,8 @@ static gmx_bool get_w_conf(FILE*       in,
             /* Read fixed format */
             for (m = 0; m < DIM; m++)
             {
-                for (c = 0; (c < ddist && ptr[0]); c++)
-                {
-                    buf[c] = ptr[0];
-                    ptr++;
-                }
-                buf[c] = '\0';
-                if (sscanf(buf, "%lf", &x1) != 1)
+                const char* fieldEnd = std::min(ptr + ddist, lineEnd);
+                if (gmx::parseDoubleFromFixedField(ptr, fieldEnd, &x1) == ptr)
                 {
                     v[i][m] = 0;
                 }
@@ -259,6 +257,7 @@ static gmx_bool get_w_conf(FILE*       in,
                     v[i][m] = x1;
                     bVel    = TRUE;
                 }
+                ptr = fieldEnd;
             }
         }
     }
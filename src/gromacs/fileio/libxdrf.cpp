@@ -401,13 +401,13 @@ int xdr3dfcoord(XDR* xdrs, float* fp, int* size, float* precision)
     int      prealloc_ip[3 * 16], prealloc_buf[3 * 20];
     int      we_should_free = 0;
 
-    int          minint[3], maxint[3], mindiff, *lip, diff;
-    int          lint1, lint2, lint3, oldlint1, oldlint2, oldlint3, smallidx;
+    int          minint[3], maxint[3], mindiff, *lip;
+    int          smallidx;
     int          minidx, maxidx;
     unsigned     sizeint[3], sizesmall[3], bitsizeint[3], size3, *luip;
     int          flag, k;
     int          smallnum, smaller, larger, i, is_small, is_smaller, run, prevrun;
-    float *      lfp, lf;
+    float*       lfp;
     int          tmp, *thiscoord, prevcoord[3];
     unsigned int tmpcoord[30];
 
@@ -472,96 +472,95 @@ int xdr3dfcoord(XDR* xdrs, float* fp, int* size, float* precision)
         }
         /* buf[0-2] are special and do not contain actual data */
         buf[0] = buf[1] = buf[2] = 0;
-        minint[0] = minint[1] = minint[2] = INT_MAX;
-        maxint[0] = maxint[1] = maxint[2] = INT_MIN;
-        prevrun                           = -1;
-        lfp                               = fp;
-        lip                               = ip;
-        mindiff                           = INT_MAX;
-        oldlint1 = oldlint2 = oldlint3 = 0;
-        while (lfp < fp + size3)
+        prevrun = -1;
+
+        /* Quantization is independent per atom, so this pass, which for
+         * large systems is a sizeable part of the compression time, can run
+         * in parallel. The bit-packing loop further down has to stay
+         * sequential: the small-number index adapts from atom to atom and
+         * the stream layout is fixed by the XTC format.
+         */
+        int minint0 = INT_MAX, minint1 = INT_MAX, minint2 = INT_MAX;
+        int maxint0 = INT_MIN, maxint1 = INT_MIN, maxint2 = INT_MIN;
+#pragma omp parallel for schedule(static) reduction(min : minint0, minint1, minint2, errval) \
+        reduction(max : maxint0, maxint1, maxint2) if (*size > 16 * 1024)
+        for (i = 0; i < *size; i++)
         {
+            const float* xp = fp + i * 3;
+            float        qf;
+            int          q1, q2, q3;
+
             /* find nearest integer */
-            if (*lfp >= 0.0)
+            if (xp[0] >= 0.0)
             {
-                lf = *lfp * *precision + 0.5;
+                qf = xp[0] * *precision + 0.5;
             }
             else
             {
-                lf = *lfp * *precision - 0.5;
+                qf = xp[0] * *precision - 0.5;
             }
-            if (std::fabs(lf) > MAXABS)
+            if (std::fabs(qf) > MAXABS)
             {
                 /* scaling would cause overflow */
                 errval = 0;
             }
-            lint1 = static_cast<int>(lf);
-            if (lint1 < minint[0])
-            {
-                minint[0] = lint1;
-            }
-            if (lint1 > maxint[0])
+            q1 = static_cast<int>(qf);
+            if (xp[1] >= 0.0)
             {
-                maxint[0] = lint1;
-            }
-            *lip++ = lint1;
-            lfp++;
-            if (*lfp >= 0.0)
-            {
-                lf = *lfp * *precision + 0.5;
+                qf = xp[1] * *precision + 0.5;
             }
             else
             {
-                lf = *lfp * *precision - 0.5;
+                qf = xp[1] * *precision - 0.5;
             }
-            if (std::fabs(lf) > MAXABS)
+            if (std::fabs(qf) > MAXABS)
             {
                 /* scaling would cause overflow */
                 errval = 0;
             }
-            lint2 = static_cast<int>(lf);
-            if (lint2 < minint[1])
-            {
-                minint[1] = lint2;
-            }
-            if (lint2 > maxint[1])
+            q2 = static_cast<int>(qf);
+            if (xp[2] >= 0.0)
             {
-                maxint[1] = lint2;
-            }
-            *lip++ = lint2;
-            lfp++;
-            if (*lfp >= 0.0)
-            {
-                lf = *lfp * *precision + 0.5;
+                qf = xp[2] * *precision + 0.5;
             }
             else
             {
-                lf = *lfp * *precision - 0.5;
+                qf = xp[2] * *precision - 0.5;
             }
-            if (std::abs(lf) > MAXABS)
+            if (std::abs(qf) > MAXABS)
             {
                 /* scaling would cause overflow */
                 errval = 0;
             }
-            lint3 = static_cast<int>(lf);
-            if (lint3 < minint[2])
-            {
-                minint[2] = lint3;
-            }
-            if (lint3 > maxint[2])
-            {
-                maxint[2] = lint3;
-            }
-            *lip++ = lint3;
-            lfp++;
-            diff = std::abs(oldlint1 - lint1) + std::abs(oldlint2 - lint2) + std::abs(oldlint3 - lint3);
-            if (diff < mindiff && lfp > fp + 3)
+            q3 = static_cast<int>(qf);
+            minint0       = std::min(minint0, q1);
+            maxint0       = std::max(maxint0, q1);
+            minint1       = std::min(minint1, q2);
+            maxint1       = std::max(maxint1, q2);
+            minint2       = std::min(minint2, q3);
+            maxint2       = std::max(maxint2, q3);
+            ip[i * 3]     = q1;
+            ip[i * 3 + 1] = q2;
+            ip[i * 3 + 2] = q3;
+        }
+        minint[0] = minint0;
+        minint[1] = minint1;
+        minint[2] = minint2;
+        maxint[0] = maxint0;
+        maxint[1] = maxint1;
+        maxint[2] = maxint2;
+
+        mindiff = INT_MAX;
+#pragma omp parallel for schedule(static) reduction(min : mindiff) if (*size > 16 * 1024)
+        for (i = 1; i < *size; i++)
+        {
+            const int diffsum = std::abs(ip[(i - 1) * 3] - ip[i * 3])
+                                + std::abs(ip[(i - 1) * 3 + 1] - ip[i * 3 + 1])
+                                + std::abs(ip[(i - 1) * 3 + 2] - ip[i * 3 + 2]);
+            if (diffsum < mindiff)
             {
-                mindiff = diff;
+                mindiff = diffsum;
             }
-            oldlint1 = lint1;
-            oldlint2 = lint2;
-            oldlint3 = lint3;
         }
         if ((xdr_int(xdrs, &(minint[0])) == 0) || (xdr_int(xdrs, &(minint[1])) == 0)
             || (xdr_int(xdrs, &(minint[2])) == 0) || (xdr_int(xdrs, &(maxint[0])) == 0)
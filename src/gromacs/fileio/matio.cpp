@@ -41,6 +41,7 @@
 
 #include <cctype>
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 
@@ -258,7 +259,7 @@ static char* line2string(char** line)
 //! If a label named \c label is found in \c line, return it. Otherwise return empty string.
 static std::string findLabelInLine(const std::string& line, const std::string& label)
 {
-    std::regex  re(".*" + label + "\"(.*)\"");
+    std::regex  re(".*" + label + ":[[:blank:]]*\"(.*)\"");
     std::smatch match;
     if (std::regex_search(line, match, re) && match.size() > 1)
     {
@@ -286,14 +287,26 @@ static t_matrix read_xpm_entry(FILE* in)
            && (std::strncmp(line_buf, "static", 6) != 0))
     {
         std::string lineString = line_buf;
-        mm.title               = findLabelInLine(lineString, "title");
-        mm.legend              = findLabelInLine(lineString, "legend");
-        mm.label_x             = findLabelInLine(lineString, "x-label");
-        mm.label_y             = findLabelInLine(lineString, "y-label");
+        if (mm.title.empty())
+        {
+            mm.title = findLabelInLine(lineString, "title");
+        }
+        if (mm.legend.empty())
+        {
+            mm.legend = findLabelInLine(lineString, "legend");
+        }
+        if (mm.label_x.empty())
+        {
+            mm.label_x = findLabelInLine(lineString, "x-label");
+        }
+        if (mm.label_y.empty())
+        {
+            mm.label_y = findLabelInLine(lineString, "y-label");
+        }
         findLabelInLine(lineString, "type"); // discard the returned string
     }
 
-    if (!line || strncmp(line, "static", 6) != 0)
+    if (!line_buf || strncmp(line_buf, "static", 6) != 0)
     {
         gmx_input("Invalid XPixMap");
     }
@@ -437,7 +450,6 @@ static t_matrix read_xpm_entry(FILE* in)
         {
             line = std::strstr(line, "x-axis");
             skipstr(line);
-            mm.axis_x.resize(0);
             mm.axis_x.reserve(mm.nx + 1);
             while (sscanf(line, "%lf", &u) == 1)
             {
@@ -457,7 +469,6 @@ static t_matrix read_xpm_entry(FILE* in)
         {
             line = std::strstr(line, "y-axis");
             skipstr(line);
-            mm.axis_y.resize(0);
             mm.axis_y.reserve(mm.ny + 1);
             while (sscanf(line, "%lf", &u) == 1)
             {
@@ -526,12 +537,358 @@ static t_matrix read_xpm_entry(FILE* in)
     return mm;
 }
 
+/* The compact binary matrix format, an alternative to text .xpm output
+ * for large matrices. Each matrix starts with an 8-byte magic string, so
+ * that, as with .xpm, several matrices can be appended to one file and
+ * the format can be recognized by read_xpm_matrix. All integers and
+ * floating point values are stored little-endian, with reals widened to
+ * double, so that files can be exchanged between machines and between
+ * single and double precision builds. The matrix elements are indices
+ * into the color map, stored in one byte when the map has at most 256
+ * entries and in two bytes otherwise, either dense or run-length
+ * encoded, whichever is smaller.
+ */
+static const char c_binaryMatrixMagic[8] = { 'G', 'M', 'X', 'B', 'M', 'A', 'T', '1' };
+
+static void putBinaryU16(FILE* out, unsigned int v)
+{
+    unsigned char buf[2] = { static_cast<unsigned char>(v & 0xff),
+                             static_cast<unsigned char>((v >> 8) & 0xff) };
+
+    fwrite(buf, 1, sizeof(buf), out);
+}
+
+static void putBinaryI32(FILE* out, int v)
+{
+    const auto    u      = static_cast<std::uint32_t>(v);
+    unsigned char buf[4] = { static_cast<unsigned char>(u & 0xff),
+                             static_cast<unsigned char>((u >> 8) & 0xff),
+                             static_cast<unsigned char>((u >> 16) & 0xff),
+                             static_cast<unsigned char>((u >> 24) & 0xff) };
+
+    fwrite(buf, 1, sizeof(buf), out);
+}
+
+static void putBinaryF64(FILE* out, double v)
+{
+    std::uint64_t u;
+    unsigned char buf[8];
+
+    std::memcpy(&u, &v, sizeof(u));
+    for (size_t i = 0; i < sizeof(buf); i++)
+    {
+        buf[i] = static_cast<unsigned char>((u >> (8 * i)) & 0xff);
+    }
+    fwrite(buf, 1, sizeof(buf), out);
+}
+
+static void putBinaryString(FILE* out, const char* s)
+{
+    const int len = (s != nullptr) ? static_cast<int>(std::strlen(s)) : 0;
+
+    putBinaryI32(out, len);
+    if (len > 0)
+    {
+        fwrite(s, 1, len, out);
+    }
+}
+
+static void getBinaryBytes(FILE* in, unsigned char buf[], size_t n)
+{
+    if (fread(buf, 1, n, in) != n)
+    {
+        gmx_file("Unexpected end of binary matrix file");
+    }
+}
+
+static unsigned int getBinaryU8(FILE* in)
+{
+    const int c = fgetc(in);
+
+    if (c == EOF)
+    {
+        gmx_file("Unexpected end of binary matrix file");
+    }
+    return c;
+}
+
+static unsigned int getBinaryU16(FILE* in)
+{
+    unsigned char buf[2];
+
+    getBinaryBytes(in, buf, sizeof(buf));
+    return buf[0] | (buf[1] << 8);
+}
+
+static int getBinaryI32(FILE* in)
+{
+    unsigned char buf[4];
+    std::uint32_t u = 0;
+
+    getBinaryBytes(in, buf, sizeof(buf));
+    for (size_t i = 0; i < sizeof(buf); i++)
+    {
+        u |= static_cast<std::uint32_t>(buf[i]) << (8 * i);
+    }
+    return static_cast<int>(u);
+}
+
+static double getBinaryF64(FILE* in)
+{
+    unsigned char buf[8];
+    std::uint64_t u = 0;
+    double        v;
+
+    getBinaryBytes(in, buf, sizeof(buf));
+    for (size_t i = 0; i < sizeof(buf); i++)
+    {
+        u |= static_cast<std::uint64_t>(buf[i]) << (8 * i);
+    }
+    std::memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+static std::string getBinaryString(FILE* in)
+{
+    const int len = getBinaryI32(in);
+
+    if (len < 0)
+    {
+        gmx_file("Corrupt string length in binary matrix file");
+    }
+    std::string s(len, '\0');
+    if (len > 0)
+    {
+        getBinaryBytes(in, reinterpret_cast<unsigned char*>(&s[0]), len);
+    }
+    return s;
+}
+
+bool is_binary_matrix_file(const char* fnm)
+{
+    FILE* in = gmx_fio_fopen(fnm, "rb");
+    char  magic[sizeof(c_binaryMatrixMagic)];
+
+    const bool bBinary = (fread(magic, 1, sizeof(magic), in) == sizeof(magic)
+                          && std::memcmp(magic, c_binaryMatrixMagic, sizeof(magic)) == 0);
+    gmx_fio_fclose(in);
+
+    return bBinary;
+}
+
+void write_binary_matrix(FILE* out, const t_matrix& m)
+{
+    fwrite(c_binaryMatrixMagic, 1, sizeof(c_binaryMatrixMagic), out);
+    putBinaryI32(out, m.flags);
+    putBinaryI32(out, m.nx);
+    putBinaryI32(out, m.ny);
+    putBinaryI32(out, m.bDiscrete ? 1 : 0);
+    putBinaryString(out, m.title.c_str());
+    putBinaryString(out, m.legend.c_str());
+    putBinaryString(out, m.label_x.c_str());
+    putBinaryString(out, m.label_y.c_str());
+    putBinaryI32(out, static_cast<int>(m.axis_x.size()));
+    for (const real label : m.axis_x)
+    {
+        putBinaryF64(out, label);
+    }
+    putBinaryI32(out, static_cast<int>(m.axis_y.size()));
+    for (const real label : m.axis_y)
+    {
+        putBinaryF64(out, label);
+    }
+    putBinaryI32(out, static_cast<int>(m.map.size()));
+    for (const t_mapping& map : m.map)
+    {
+        const unsigned char code[2] = { static_cast<unsigned char>(map.code.c1),
+                                        static_cast<unsigned char>(map.code.c2) };
+
+        fwrite(code, 1, sizeof(code), out);
+        putBinaryF64(out, map.rgb.r);
+        putBinaryF64(out, map.rgb.g);
+        putBinaryF64(out, map.rgb.b);
+        putBinaryString(out, map.desc);
+    }
+
+    /* A run is at most 255 elements, so that its length fits in one
+     * byte; count how many runs the matrix has to decide whether
+     * run-length encoding pays off. It does when the matrix has large
+     * uniform areas, as contact and existence maps do, while dense
+     * storage bounds the size for matrices without repetition.
+     */
+    const int          elemSize = (m.map.size() <= 256) ? 1 : 2;
+    const std::int64_t nelem    = static_cast<std::int64_t>(m.nx) * m.ny;
+    std::int64_t       nruns    = 0;
+    for (std::int64_t e = 0; e < nelem;)
+    {
+        const t_matelmt elmt = m.matrix(e / m.ny, e % m.ny);
+        std::int64_t    e1   = e + 1;
+        while (e1 < nelem && e1 - e < 255 && m.matrix(e1 / m.ny, e1 % m.ny) == elmt)
+        {
+            e1++;
+        }
+        nruns++;
+        e = e1;
+    }
+    const gmx_bool bRunLength = ((elemSize + 1) * nruns < elemSize * nelem);
+
+    fputc(elemSize, out);
+    fputc(bRunLength ? 1 : 0, out);
+    if (bRunLength)
+    {
+        for (std::int64_t e = 0; e < nelem;)
+        {
+            const t_matelmt elmt = m.matrix(e / m.ny, e % m.ny);
+            std::int64_t    e1   = e + 1;
+            while (e1 < nelem && e1 - e < 255 && m.matrix(e1 / m.ny, e1 % m.ny) == elmt)
+            {
+                e1++;
+            }
+            fputc(static_cast<int>(e1 - e), out);
+            if (elemSize == 1)
+            {
+                fputc(elmt, out);
+            }
+            else
+            {
+                putBinaryU16(out, elmt);
+            }
+            e = e1;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < m.nx; i++)
+        {
+            for (int j = 0; j < m.ny; j++)
+            {
+                if (elemSize == 1)
+                {
+                    fputc(m.matrix(i, j), out);
+                }
+                else
+                {
+                    putBinaryU16(out, m.matrix(i, j));
+                }
+            }
+        }
+    }
+}
+
+static t_matrix read_binary_matrix_entry(FILE* in)
+{
+    t_matrix mm;
+
+    mm.flags     = getBinaryI32(in);
+    mm.nx        = getBinaryI32(in);
+    mm.ny        = getBinaryI32(in);
+    mm.bDiscrete = (getBinaryI32(in) != 0);
+    if (mm.nx <= 0 || mm.ny <= 0)
+    {
+        gmx_file("Corrupt matrix dimensions in binary matrix file");
+    }
+    mm.title   = getBinaryString(in);
+    mm.legend  = getBinaryString(in);
+    mm.label_x = getBinaryString(in);
+    mm.label_y = getBinaryString(in);
+    mm.axis_x.resize(getBinaryI32(in));
+    for (real& label : mm.axis_x)
+    {
+        label = getBinaryF64(in);
+    }
+    mm.axis_y.resize(getBinaryI32(in));
+    for (real& label : mm.axis_y)
+    {
+        label = getBinaryF64(in);
+    }
+    mm.map.resize(getBinaryI32(in));
+    for (t_mapping& map : mm.map)
+    {
+        unsigned char code[2];
+
+        getBinaryBytes(in, code, sizeof(code));
+        map.code.c1 = code[0];
+        map.code.c2 = code[1];
+        map.rgb.r   = getBinaryF64(in);
+        map.rgb.g   = getBinaryF64(in);
+        map.rgb.b   = getBinaryF64(in);
+        map.desc    = gmx_strdup(getBinaryString(in).c_str());
+    }
+
+    mm.matrix.resize(mm.nx, mm.ny);
+    const std::int64_t nelem    = static_cast<std::int64_t>(mm.nx) * mm.ny;
+    const int          elemSize = fgetc(in);
+    const int          mode     = fgetc(in);
+    if ((elemSize != 1 && elemSize != 2) || (mode != 0 && mode != 1))
+    {
+        gmx_file("Unknown storage mode in binary matrix file");
+    }
+    if (mode == 1)
+    {
+        for (std::int64_t e = 0; e < nelem;)
+        {
+            const int       len  = getBinaryU8(in);
+            const t_matelmt elmt = (elemSize == 1) ? getBinaryU8(in) : getBinaryU16(in);
+
+            if (len <= 0 || e + len > nelem)
+            {
+                gmx_file("Corrupt run-length data in binary matrix file");
+            }
+            for (int k = 0; k < len; k++, e++)
+            {
+                mm.matrix(e / mm.ny, e % mm.ny) = elmt;
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < mm.nx; i++)
+        {
+            for (int j = 0; j < mm.ny; j++)
+            {
+                mm.matrix(i, j) = (elemSize == 1) ? getBinaryU8(in) : getBinaryU16(in);
+            }
+        }
+    }
+
+    return mm;
+}
+
+static std::vector<t_matrix> read_binary_matrix(const char* fnm)
+{
+    FILE* in = gmx_fio_fopen(fnm, "rb");
+    char  magic[sizeof(c_binaryMatrixMagic)];
+
+    std::vector<t_matrix> mat;
+    while (fread(magic, 1, sizeof(magic), in) == sizeof(magic))
+    {
+        if (std::memcmp(magic, c_binaryMatrixMagic, sizeof(magic)) != 0)
+        {
+            gmx_file("Corrupt magic in binary matrix file");
+        }
+        mat.emplace_back(read_binary_matrix_entry(in));
+    }
+    gmx_fio_fclose(in);
+
+    if (mat.empty())
+    {
+        gmx_file("Invalid binary matrix file");
+    }
+
+    return mat;
+}
+
 std::vector<t_matrix> read_xpm_matrix(const char* fnm)
 {
     FILE* in;
     char* line    = nullptr;
     int   llalloc = 0;
 
+    if (is_binary_matrix_file(fnm))
+    {
+        return read_binary_matrix(fnm);
+    }
+
     in = gmx_fio_fopen(fnm, "r");
 
     std::vector<t_matrix> mat;
@@ -1174,3 +1531,90 @@ void write_xpm(FILE*              out,
     writeXpmAxis(out, "y", ArrayRef<real>(axis_y, axis_y + n_y + ((flags & MAT_SPATIAL_Y) != 0U ? 1 : 0)));
     write_xpm_data(out, n_x, n_y, mat, lo, hi, *nlevels);
 }
+
+t_matrix real2matrix(unsigned int       flags,
+                     const std::string& title,
+                     const std::string& legend,
+                     const std::string& label_x,
+                     const std::string& label_y,
+                     int                n_x,
+                     int                n_y,
+                     real               axis_x[],
+                     real               axis_y[],
+                     real*              mat[],
+                     real               lo,
+                     real               hi,
+                     t_rgb              rlo,
+                     t_rgb              rhi,
+                     int*               nlevels)
+{
+    /* Discretizes mat[][] to a t_matrix, with the same color map, level
+     * values and element quantization as write_xpm() writes, so that
+     * matrix2real() on the result recovers the same values as reading
+     * back a written .xpm file would. See write_xpm() for the arguments.
+     */
+    t_matrix mm;
+    char     buf[32];
+
+    if (hi <= lo)
+    {
+        gmx_fatal(FARGS, "hi (%f) <= lo (%f)", hi, lo);
+    }
+    if (*nlevels > NMAP * NMAP)
+    {
+        fprintf(stderr, "Warning, too many levels (%d) in matrix, using %d only\n", *nlevels,
+                static_cast<int>(NMAP * NMAP));
+        *nlevels = NMAP * NMAP;
+    }
+    else if (*nlevels < 2)
+    {
+        fprintf(stderr, "Warning, too few levels (%d) in matrix, using 2 instead\n", *nlevels);
+        *nlevels = 2;
+    }
+
+    mm.flags   = flags;
+    mm.nx      = n_x;
+    mm.ny      = n_y;
+    mm.title   = title;
+    mm.legend  = legend;
+    mm.label_x = label_x;
+    mm.label_y = label_y;
+    mm.axis_x.assign(axis_x, axis_x + n_x + ((flags & MAT_SPATIAL_X) != 0U ? 1 : 0));
+    mm.axis_y.assign(axis_y, axis_y + n_y + ((flags & MAT_SPATIAL_Y) != 0U ? 1 : 0));
+
+    const real invlevel = 1.0 / (*nlevels - 1);
+    mm.map.resize(*nlevels);
+    for (int i = 0; i < *nlevels; i++)
+    {
+        const int nlo = *nlevels - 1 - i;
+
+        mm.map[i].code.c1 = mapper[i % NMAP];
+        mm.map[i].code.c2 = (*nlevels <= NMAP) ? 0 : mapper[i / NMAP];
+        mm.map[i].rgb.r   = (nlo * rlo.r + i * rhi.r) * invlevel;
+        mm.map[i].rgb.g   = (nlo * rlo.g + i * rhi.g) * invlevel;
+        mm.map[i].rgb.b   = (nlo * rlo.b + i * rhi.b) * invlevel;
+        sprintf(buf, "%.3g", (nlo * lo + i * hi) * invlevel);
+        mm.map[i].desc = gmx_strdup(buf);
+    }
+
+    mm.matrix.resize(n_x, n_y);
+    const real invdelta = (*nlevels - 1) / (hi - lo);
+    for (int i = 0; i < n_x; i++)
+    {
+        for (int j = 0; j < n_y; j++)
+        {
+            int c = roundToInt((mat[i][j] - lo) * invdelta);
+            if (c < 0)
+            {
+                c = 0;
+            }
+            if (c >= *nlevels)
+            {
+                c = *nlevels - 1;
+            }
+            mm.matrix(i, j) = c;
+        }
+    }
+
+    return mm;
+}
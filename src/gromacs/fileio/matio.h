@@ -135,9 +135,40 @@ void printcmap(FILE* out, int n, t_mapping map[]);
 void writecmap(const char* fn, int n, t_mapping map[]);
 /* print mapping table to fn */
 
-//! Reads and returns a number of matrices from .xpm file \c fnm.
+//! Reads and returns a number of matrices from .xpm or binary matrix file \c fnm.
 std::vector<t_matrix> read_xpm_matrix(const char* fnm);
 
+//! Returns whether \c fnm starts with the magic of the compact binary matrix format.
+bool is_binary_matrix_file(const char* fnm);
+
+void write_binary_matrix(FILE* out, const t_matrix& m);
+/* Writes a t_matrix struct to the compact binary matrix format.
+ * The matrix elements are stored dense or run-length encoded, whichever
+ * is smaller. As with write_xpm, several matrices can be written to one
+ * file; read_xpm_matrix recognizes the format and reads them back.
+ */
+
+t_matrix real2matrix(unsigned int       flags,
+                     const std::string& title,
+                     const std::string& legend,
+                     const std::string& label_x,
+                     const std::string& label_y,
+                     int                n_x,
+                     int                n_y,
+                     real               axis_x[],
+                     real               axis_y[],
+                     real*              mat[],
+                     real               lo,
+                     real               hi,
+                     t_rgb              rlo,
+                     t_rgb              rhi,
+                     int*               nlevels);
+/* Discretizes a matrix of reals to a t_matrix with the same color map and
+ * level quantization as write_xpm; see there for the arguments. Together
+ * with write_binary_matrix this is the binary counterpart of write_xpm,
+ * and matrix2real converts the elements back to reals.
+ */
+
 real** matrix2real(t_matrix* in, real** out);
 /* Converts an matrix in a t_matrix struct to a matrix of reals
  * When mat==NULL memory will be allocated
@@ -61,6 +61,7 @@
 #include "gromacs/utility/futil.h"
 #include "gromacs/utility/smalloc.h"
 #include "gromacs/utility/snprintf.h"
+#include "gromacs/utility/strconvert.h"
 
 typedef struct
 {
@@ -706,17 +707,26 @@ read_atom(t_symtab* symtab, const char line[], int type, int natom, t_atoms* ato
         atomn->atomnumber      = atomnumber;
         strncpy(atomn->elem, elem, 4);
     }
-    x[natom][XX] = strtod(xc, nullptr) * 0.1;
-    x[natom][YY] = strtod(yc, nullptr) * 0.1;
-    x[natom][ZZ] = strtod(zc, nullptr) * 0.1;
+    /* The fixed-field parser is much faster than strtod, which matters
+     * when reading structures with millions of atoms.
+     */
+    double coord;
+    gmx::parseDoubleFromFixedField(xc, xc + strlen(xc), &coord);
+    x[natom][XX] = coord * 0.1;
+    gmx::parseDoubleFromFixedField(yc, yc + strlen(yc), &coord);
+    x[natom][YY] = coord * 0.1;
+    gmx::parseDoubleFromFixedField(zc, zc + strlen(zc), &coord);
+    x[natom][ZZ] = coord * 0.1;
     if (atoms->pdbinfo)
     {
         atoms->pdbinfo[natom].type   = type;
         atoms->pdbinfo[natom].atomnr = strtol(anr, nullptr, 10);
         atoms->pdbinfo[natom].altloc = altloc;
         strcpy(atoms->pdbinfo[natom].atomnm, anm_copy);
-        atoms->pdbinfo[natom].bfac  = strtod(bfac, nullptr);
-        atoms->pdbinfo[natom].occup = strtod(occup, nullptr);
+        gmx::parseDoubleFromFixedField(bfac, bfac + strlen(bfac), &coord);
+        atoms->pdbinfo[natom].bfac = coord;
+        gmx::parseDoubleFromFixedField(occup, occup + strlen(occup), &coord);
+        atoms->pdbinfo[natom].occup = coord;
     }
     natom++;
 
@@ -0,0 +1,151 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the buffered xvg table writer
+ *
+ * \ingroup module_fileio
+ */
+#include "gmxpre.h"
+
+#include "gromacs/fileio/xvgwriter.h"
+
+#include <cmath>
+#include <cstdio>
+
+#include <algorithm>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/utility/textreader.h"
+
+#include "testutils/testfilemanager.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+class XvgTableWriterTest : public ::testing::Test
+{
+public:
+    XvgTableWriterTest() : filename_(fileManager_.getTemporaryFilePath("table.xvg")) {}
+
+    //! Read back everything written to the test file.
+    std::string fileContents() const { return TextReader::readFileToString(filename_); }
+
+    TestFileManager fileManager_;
+    std::string     filename_;
+};
+
+TEST_F(XvgTableWriterTest, FormatsLikeFprintf)
+{
+    const double testValues[] = { 0.0,     -0.0,    1.25,      -1.25,   987.654321,
+                                  -0.0004, 1e12,    -123456.5, 2.5e-7,  3.14159265358979,
+                                  1e19,    -4.7e22, 1.0 / 3.0, 2e-45,   -0.75 };
+
+    FILE* fp = fopen(filename_.c_str(), "w");
+    ASSERT_NE(fp, nullptr);
+    std::string reference;
+    {
+        XvgTableWriter writer(fp);
+        char           buf[256];
+        for (double value : testValues)
+        {
+            writer.writeValue(value, 12, 6);
+            writer.writeText("  ");
+            writer.writeValue(value, 8, 3);
+            writer.writeText("  ");
+            writer.writeValue(value, 16, 12);
+            writer.finishRow();
+            snprintf(buf, sizeof(buf), "%12.6f  %8.3f  %16.12f\n", value, value, value);
+            reference += buf;
+        }
+    }
+    fclose(fp);
+
+    EXPECT_EQ(fileContents(), reference);
+}
+
+TEST_F(XvgTableWriterTest, HandlesZeroPrecisionAndNonFinite)
+{
+    FILE* fp = fopen(filename_.c_str(), "w");
+    ASSERT_NE(fp, nullptr);
+    const double nan = std::nan("");
+    const double inf = HUGE_VAL;
+    std::string  reference;
+    {
+        XvgTableWriter writer(fp);
+        char           buf[256];
+        for (double value : { 0.5, 1.5, -2.5, 1234567.0, nan, inf, -inf })
+        {
+            writer.writeValue(value, 10, 0);
+            writer.finishRow();
+            snprintf(buf, sizeof(buf), "%10.0f\n", value);
+            reference += buf;
+        }
+    }
+    fclose(fp);
+
+    EXPECT_EQ(fileContents(), reference);
+}
+
+TEST_F(XvgTableWriterTest, FlushesLongOutput)
+{
+    FILE* fp = fopen(filename_.c_str(), "w");
+    ASSERT_NE(fp, nullptr);
+    const int numRows = 10000;
+    {
+        XvgTableWriter writer(fp);
+        for (int i = 0; i < numRows; i++)
+        {
+            writer.writeValue(0.002 * i, 10, 5);
+            writer.writeText("  ");
+            writer.writeValue(std::sin(0.01 * i), 8, 3);
+            writer.finishRow();
+        }
+    }
+    fclose(fp);
+
+    const std::string contents = fileContents();
+    EXPECT_EQ(std::count(contents.begin(), contents.end(), '\n'), numRows);
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
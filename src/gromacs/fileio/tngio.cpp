@@ -39,6 +39,8 @@
 #include "config.h"
 
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 #include <algorithm>
 #include <iterator>
@@ -375,6 +377,30 @@ static int greatest_common_divisor_if_positive(int n1, int n2)
     return gmx_greatest_common_divisor(n1, n2);
 }
 
+/*! \libinternal \brief Returns the codec for losslessly stored particle blocks.
+ *
+ * The TNG format defines only uncompressed blocks, gzip, and its own lossy
+ * MF1 codec, so pluggable codecs such as zstd would need a format change in
+ * the TNG library itself. What can be chosen is whether the lossless blocks
+ * are gzipped at all: GMX_TNG_COMPRESSION=none stores position, velocity and
+ * force blocks uncompressed, which trades file size for a large reduction of
+ * the write CPU cost, e.g. for velocities, which gzip poorly anyway.
+ */
+static char losslessBlockCompression()
+{
+    const char* env = getenv("GMX_TNG_COMPRESSION");
+
+    if (env == nullptr || std::strcmp(env, "gzip") == 0)
+    {
+        return TNG_GZIP_COMPRESSION;
+    }
+    else if (std::strcmp(env, "none") == 0)
+    {
+        return TNG_UNCOMPRESSED;
+    }
+    gmx_fatal(FARGS, "Unknown GMX_TNG_COMPRESSION value '%s'; use 'gzip' or 'none'", env);
+}
+
 /* By default try to write 100 frames (of actual output) in each frame set.
  * This number is the number of outputs of the most frequently written data
  * type per frame set.
@@ -462,7 +488,7 @@ static void set_writing_intervals(gmx_tng_trajectory_t gmx_tng,
         xout        = ir->nstxout;
         vout        = ir->nstvout;
         fout        = ir->nstfout;
-        compression = TNG_GZIP_COMPRESSION;
+        compression = losslessBlockCompression();
     }
     if (xout)
     {
@@ -494,7 +520,7 @@ static void set_writing_intervals(gmx_tng_trajectory_t gmx_tng,
     if (fout)
     {
         set_writing_interval(tng, fout, 3, TNG_TRAJ_FORCES, "FORCES", TNG_PARTICLE_BLOCK_DATA,
-                             TNG_GZIP_COMPRESSION);
+                             losslessBlockCompression());
 
         gcd = greatest_common_divisor_if_positive(gcd, fout);
         if (lowest < 0 || fout < lowest)
@@ -835,7 +861,7 @@ void gmx_fwrite_tng(gmx_tng_trajectory_t gmx_tng,
     }
     else
     {
-        compression = TNG_GZIP_COMPRESSION;
+        compression = losslessBlockCompression();
     }
 
     /* The writing is done using write_data, which writes float or double
@@ -867,7 +893,7 @@ void gmx_fwrite_tng(gmx_tng_trajectory_t gmx_tng,
         /* TNG-MF1 compression only compresses positions and velocities. Use lossless
          * compression for forces regardless of output mode */
         if (write_data(tng, step, elapsedSeconds, reinterpret_cast<const real*>(f), 3,
-                       TNG_TRAJ_FORCES, "FORCES", TNG_PARTICLE_BLOCK_DATA, TNG_GZIP_COMPRESSION)
+                       TNG_TRAJ_FORCES, "FORCES", TNG_PARTICLE_BLOCK_DATA, losslessBlockCompression())
             != TNG_SUCCESS)
         {
             gmx_file("Cannot write TNG trajectory frame; maybe you are out of disk space?");
@@ -3328,6 +3328,40 @@ PbcType read_tpx(const char* fn, t_inputrec* ir, matrix box, int* natoms, rvec*
     return partialDeserializedTpr.pbcType;
 }
 
+void read_tpx_natoms_and_box(const char* fn, int* natoms, matrix box)
+{
+    t_fileio* fio = open_tpx(fn, "r");
+    gmx::FileIOXdrSerializer serializer(fio);
+    TpxFileHeader            tpx;
+    do_tpxheader(&serializer, &tpx, fn, fio, TRUE);
+    if (natoms != nullptr)
+    {
+        *natoms = tpx.natoms;
+    }
+    if (box != nullptr && tpx.bBox)
+    {
+        /* The box is stored at the start of the body, before the topology,
+         * so we only need to deserialize up to there and can skip the
+         * expensive parts of the file.
+         */
+        t_state state;
+        if (tpx.fileVersion >= tpxv_AddSizeField && tpx.fileGeneration >= 27)
+        {
+            std::vector<char> body(tpx.sizeOfTprBody);
+            doTpxBodyBuffer(&serializer, body);
+            gmx::InMemoryDeserializer tprBodyDeserializer(
+                    body, tpx.isDouble, gmx::EndianSwapBehavior::SwapIfHostIsLittleEndian);
+            do_tpx_state_first(&tprBodyDeserializer, &tpx, &state);
+        }
+        else
+        {
+            do_tpx_state_first(&serializer, &tpx, &state);
+        }
+        copy_mat(state.box, box);
+    }
+    close_tpx(fio);
+}
+
 PbcType read_tpx_top(const char* fn, t_inputrec* ir, matrix box, int* natoms, rvec* x, rvec* v, t_topology* top)
 {
     gmx_mtop_t mtop;
@@ -208,6 +208,22 @@ PartialDeserializedTprFile read_tpx_state(const char* fn, t_inputrec* ir, t_stat
  */
 PbcType read_tpx(const char* fn, t_inputrec* ir, matrix box, int* natoms, rvec* x, rvec* v, gmx_mtop_t* mtop);
 
+/*! \brief
+ * Read only the number of atoms and the box from a tpr file.
+ *
+ * The atom count comes from the header and the box is stored at the start
+ * of the file body, before the topology, so unlike read_tpx() this does
+ * not deserialize the topology or state arrays and is fast also for very
+ * large systems. The tpx body is a stream without per-section offsets, so
+ * anything stored after the topology (coordinates, velocities, inputrec)
+ * still requires a full read_tpx() pass.
+ *
+ * \param[in] fn Input file name.
+ * \param[out] natoms Total atom number to be set, or nullptr.
+ * \param[out] box Box matrix to be set, or nullptr.
+ */
+void read_tpx_natoms_and_box(const char* fn, int* natoms, matrix box);
+
 PbcType read_tpx_top(const char* fn, t_inputrec* ir, matrix box, int* natoms, rvec* x, rvec* v, t_topology* top);
 /* As read_tpx, but for the old t_topology struct */
 
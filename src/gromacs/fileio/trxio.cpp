@@ -42,9 +42,15 @@
 #include "config.h"
 
 #include <cassert>
+#include <cctype>
 #include <cmath>
 #include <cstring>
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "gromacs/fileio/checkpoint.h"
 #include "gromacs/fileio/confio.h"
 #include "gromacs/fileio/filetypes.h"
@@ -94,6 +100,10 @@ struct t_trxstatus
     double               DT, BOX[3];
     gmx_bool             bReadBox;
     char*                persistent_line; /* Persistent line for reading g96 trajectories */
+    char**               partFilenames;   /* Continuation parts to chain after this file */
+    int                  numParts;
+    int                  currentPart;       /* Next entry of partFilenames to open        */
+    real                 lastDeliveredTime; /* For skipping overlap between parts         */
 #if GMX_USE_PLUGINS
     gmx_vmdplugin_t* vmdplugin;
 #endif
@@ -167,6 +177,10 @@ static void status_init(t_trxstatus* status)
     status->tf              = 0;
     status->persistent_line = nullptr;
     status->tng             = nullptr;
+    status->partFilenames   = nullptr;
+    status->numParts        = 0;
+    status->currentPart     = 0;
+    status->lastDeliveredTime = -GMX_REAL_MAX;
 }
 
 
@@ -604,6 +618,11 @@ void close_trx(t_trxstatus* status)
         gmx_fio_close(status->fio);
     }
     sfree(status->persistent_line);
+    for (int i = 0; i < status->numParts; i++)
+    {
+        sfree(status->partFilenames[i]);
+    }
+    sfree(status->partFilenames);
 #if GMX_USE_PLUGINS
     sfree(status->vmdplugin);
 #endif
@@ -767,7 +786,122 @@ static int pdb_first_x(t_trxstatus* status, FILE* fp, t_trxframe* fr)
     return fr->natoms;
 }
 
-bool read_next_frame(const gmx_output_env_t* oenv, t_trxstatus* status, t_trxframe* fr)
+/* Looks for numbered continuation parts after a trajectory named like
+ * "traj.part0001.xtc" and stores them in status for chained reading. */
+static void scan_trajectory_parts(t_trxstatus* status, const char* fn)
+{
+    int ftp = fn2ftp(fn);
+    if (ftp != efXTC && ftp != efTRR && ftp != efTNG)
+    {
+        return;
+    }
+    /* Find the last ".partNNNN." in the name, as mdrun -noappend writes it */
+    const char* tag = nullptr;
+    for (const char* p = fn; (p = std::strstr(p, ".part")) != nullptr; p++)
+    {
+        tag = p;
+    }
+    if (tag == nullptr || std::strlen(tag) < 11 || tag[9] != '.')
+    {
+        return;
+    }
+    for (int d = 5; d < 9; d++)
+    {
+        if (std::isdigit(tag[d]) == 0)
+        {
+            return;
+        }
+    }
+    int   partNumber   = std::strtol(tag + 5, nullptr, 10);
+    int   prefixLength = (tag + 5) - fn;
+    char* buf;
+    snew(buf, std::strlen(fn) + 16);
+    for (int n = partNumber + 1; n <= 9999; n++)
+    {
+        sprintf(buf, "%.*s%04d%s", prefixLength, fn, n, tag + 9);
+        if (!gmx_fexist(buf))
+        {
+            break;
+        }
+        srenew(status->partFilenames, status->numParts + 1);
+        status->partFilenames[status->numParts] = gmx_strdup(buf);
+        status->numParts++;
+    }
+    sfree(buf);
+    if (status->numParts > 0)
+    {
+        fprintf(stderr, "\nWill read %d continuation part(s) following %s as one stream\n",
+                status->numParts, fn);
+    }
+}
+
+/* Closes the handles of the finished trajectory part and opens the next
+ * one, delivering its first frame into fr. Returns FALSE when the next
+ * part contains no valid frame. */
+static gmx_bool open_next_trajectory_part(const gmx_output_env_t* oenv, t_trxstatus* status, t_trxframe* fr)
+{
+    const char* nextFn = status->partFilenames[status->currentPart];
+    status->currentPart++;
+
+    gmx_tng_close(&status->tng);
+    if (status->fio)
+    {
+        gmx_fio_close(status->fio);
+        status->fio = nullptr;
+    }
+
+    t_trxframe   partFrame;
+    t_trxstatus* partStatus;
+    if (!read_first_frame(oenv, &partStatus, nextFn, &partFrame, status->flags))
+    {
+        close_trx(partStatus);
+        return FALSE;
+    }
+    if (partFrame.natoms != fr->natoms)
+    {
+        gmx_fatal(FARGS, "Trajectory part %s has %d atoms while the previous parts have %d",
+                  nextFn, partFrame.natoms, fr->natoms);
+    }
+
+    /* Take over the low-level handles of the new part */
+    status->fio = partStatus->fio;
+    status->tng = partStatus->tng;
+    sfree(status->persistent_line);
+    status->persistent_line = partStatus->persistent_line;
+    status->tf              = partStatus->tf;
+    sfree(partStatus);
+
+    /* Copy the first frame of the new part into the caller's frame, which
+     * keeps its own coordinate arrays since callers hold pointers to them. */
+    rvec* x     = fr->x;
+    rvec* v     = fr->v;
+    rvec* f     = fr->f;
+    int*  index = fr->index;
+    *fr         = partFrame;
+    fr->x       = x;
+    fr->v       = v;
+    fr->f       = f;
+    fr->index   = index;
+    if (x != nullptr && partFrame.x != nullptr)
+    {
+        std::memcpy(x, partFrame.x, fr->natoms * sizeof(rvec));
+    }
+    if (v != nullptr && partFrame.v != nullptr)
+    {
+        std::memcpy(v, partFrame.v, fr->natoms * sizeof(rvec));
+    }
+    if (f != nullptr && partFrame.f != nullptr)
+    {
+        std::memcpy(f, partFrame.f, fr->natoms * sizeof(rvec));
+    }
+    sfree(partFrame.x);
+    sfree(partFrame.v);
+    sfree(partFrame.f);
+
+    return TRUE;
+}
+
+static bool read_next_frame_single(const gmx_output_env_t* oenv, t_trxstatus* status, t_trxframe* fr)
 {
     real     pt;
     int      ct;
@@ -807,7 +941,26 @@ bool read_next_frame(const gmx_output_env_t* oenv, t_trxstatus* status, t_trxfra
             case efXTC:
                 if (bTimeSet(TBEGIN) && (status->tf < rTimeValue(TBEGIN)))
                 {
-                    if (xtc_seek_time(status->fio, rTimeValue(TBEGIN), fr->natoms, TRUE))
+                    /* With a sidecar index the seek is a binary search in
+                     * memory; without one we bisect through the file. Set
+                     * GMX_XTC_BUILD_INDEX to build and keep an index when
+                     * none is present yet. */
+                    gmx_bool    bSought = FALSE;
+                    t_xtcindex* index   = read_xtc_index(gmx_fio_getname(status->fio));
+                    if (index == nullptr && getenv("GMX_XTC_BUILD_INDEX") != nullptr)
+                    {
+                        index = build_xtc_index(gmx_fio_getname(status->fio));
+                        if (index != nullptr)
+                        {
+                            write_xtc_index(gmx_fio_getname(status->fio), index);
+                        }
+                    }
+                    if (index != nullptr)
+                    {
+                        bSought = (xtc_index_seek_time(status->fio, index, rTimeValue(TBEGIN)) == 0);
+                        done_xtc_index(index);
+                    }
+                    if (!bSought && xtc_seek_time(status->fio, rTimeValue(TBEGIN), fr->natoms, TRUE))
                     {
                         gmx_fatal(FARGS,
                                   "Specified frame (time %f) doesn't exist or file "
@@ -883,6 +1036,35 @@ bool read_next_frame(const gmx_output_env_t* oenv, t_trxstatus* status, t_trxfra
     return bRet;
 }
 
+bool read_next_frame(const gmx_output_env_t* oenv, t_trxstatus* status, t_trxframe* fr)
+{
+    bool bRet;
+
+    do
+    {
+        bRet = read_next_frame_single(oenv, status, fr);
+        while (!bRet && status->currentPart < status->numParts)
+        {
+            if (fr->bTime && check_times2(fr->time, status->t0, fr->bDouble) > 0)
+            {
+                /* We stopped at the requested end time, not at the end
+                 * of this part, so do not chain to the next one. */
+                return false;
+            }
+            bRet = open_next_trajectory_part(oenv, status, fr);
+        }
+        /* Skip frames the previous part already delivered; mdrun parts
+         * written around a checkpoint restart can overlap in time. */
+    } while (bRet && status->numParts > 0 && fr->bTime && fr->time <= status->lastDeliveredTime);
+
+    if (bRet && status->numParts > 0 && fr->bTime)
+    {
+        status->lastDeliveredTime = fr->time;
+    }
+
+    return bRet;
+}
+
 bool read_first_frame(const gmx_output_env_t* oenv, t_trxstatus** status, const char* fn, t_trxframe* fr, int flags)
 {
     t_fileio* fio = nullptr;
@@ -1041,6 +1223,17 @@ bool read_first_frame(const gmx_output_env_t* oenv, t_trxstatus** status, const
      */
     (*status)->natoms = fr->natoms;
 
+    /* With GMX_MULTIPART_TRX set, continuation parts written by
+     * mdrun -noappend are chained transparently after this file. */
+    if (getenv("GMX_MULTIPART_TRX") != nullptr)
+    {
+        scan_trajectory_parts(*status, fn);
+        if ((*status)->numParts > 0 && fr->bTime)
+        {
+            (*status)->lastDeliveredTime = fr->time;
+        }
+    }
+
     return (fr->natoms > 0);
 }
 
@@ -1081,6 +1274,126 @@ void rewind_trj(t_trxstatus* status)
     gmx_fio_rewind(status->fio);
 }
 
+/***** R E A D - A H E A D   S T U F F ******/
+
+struct t_trxreadahead
+{
+    const gmx_output_env_t* oenv;    /* output environment of the caller           */
+    t_trxstatus*            status;  /* the trajectory being read ahead            */
+    std::vector<t_trxframe> slots;   /* ring of pre-allocated frames               */
+    int                     head;    /* next slot the reader thread fills          */
+    int                     tail;    /* next slot the consumer takes               */
+    int                     count;   /* number of filled slots                     */
+    bool                    eof;     /* reader thread hit end of trajectory        */
+    bool                    stop;    /* consumer asked the reader thread to stop   */
+    std::mutex              mutex;
+    std::condition_variable notFull;  /* signalled when a slot is consumed          */
+    std::condition_variable notEmpty; /* signalled when a slot is filled or at eof  */
+    std::thread             reader;
+};
+
+/* Loop of the reader thread: decode frames into free ring slots until
+ * the trajectory ends or the consumer calls done_trx_readahead(). */
+static void read_ahead_loop(t_trxreadahead* ra)
+{
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(ra->mutex);
+        ra->notFull.wait(lock, [ra] { return ra->stop || ra->count < gmx::ssize(ra->slots); });
+        if (ra->stop)
+        {
+            return;
+        }
+        t_trxframe* slot = &ra->slots[ra->head];
+        lock.unlock();
+        /* Decoding happens without holding the lock, so the consumer can
+         * take finished frames while this one is being read. */
+        bool haveFrame = read_next_frame(ra->oenv, ra->status, slot);
+        lock.lock();
+        if (!haveFrame)
+        {
+            ra->eof = true;
+            ra->notEmpty.notify_one();
+            return;
+        }
+        ra->head = (ra->head + 1) % static_cast<int>(ra->slots.size());
+        ra->count++;
+        ra->notEmpty.notify_one();
+    }
+}
+
+t_trxreadahead* start_trx_readahead(const gmx_output_env_t* oenv, t_trxstatus* status, const t_trxframe* fr, int numFrames)
+{
+    GMX_RELEASE_ASSERT(numFrames >= 1, "Need at least one read-ahead slot");
+
+    t_trxreadahead* ra = new t_trxreadahead;
+    ra->oenv           = oenv;
+    ra->status         = status;
+    ra->head           = 0;
+    ra->tail           = 0;
+    ra->count          = 0;
+    ra->eof            = false;
+    ra->stop           = false;
+    ra->slots.resize(numFrames);
+    for (t_trxframe& slot : ra->slots)
+    {
+        /* Copy the flags and metadata from the first frame, but give each
+         * slot its own coordinate arrays so decoding does not touch frames
+         * the consumer still holds. */
+        slot = *fr;
+        if (fr->x)
+        {
+            snew(slot.x, fr->natoms);
+        }
+        if (fr->v)
+        {
+            snew(slot.v, fr->natoms);
+        }
+        if (fr->f)
+        {
+            snew(slot.f, fr->natoms);
+        }
+    }
+    ra->reader = std::thread(read_ahead_loop, ra);
+
+    return ra;
+}
+
+bool read_next_frame_readahead(t_trxreadahead* ra, t_trxframe* fr)
+{
+    std::unique_lock<std::mutex> lock(ra->mutex);
+    ra->notEmpty.wait(lock, [ra] { return ra->count > 0 || ra->eof; });
+    if (ra->count == 0)
+    {
+        return false;
+    }
+    /* Swap the whole frame with the caller's: the decoded arrays move to
+     * the caller and the caller's previous arrays are reused for decoding. */
+    std::swap(*fr, ra->slots[ra->tail]);
+    ra->tail = (ra->tail + 1) % static_cast<int>(ra->slots.size());
+    ra->count--;
+    ra->notFull.notify_one();
+
+    return true;
+}
+
+void done_trx_readahead(t_trxreadahead* ra)
+{
+    {
+        std::lock_guard<std::mutex> lock(ra->mutex);
+        ra->stop = true;
+    }
+    ra->notFull.notify_one();
+    ra->reader.join();
+    for (t_trxframe& slot : ra->slots)
+    {
+        sfree(slot.x);
+        sfree(slot.v);
+        sfree(slot.f);
+    }
+    delete ra;
+}
+
 /***** T O P O L O G Y   S T U F F ******/
 
 t_topology* read_top(const char* fn, PbcType* pbcType)
@@ -227,6 +227,39 @@ bool read_next_frame(const gmx_output_env_t* oenv, t_trxstatus* status, struct t
  * Returns true when succeeded, false otherwise.
  */
 
+/*! \brief Opaque handle for reading frames ahead on a background thread. */
+typedef struct t_trxreadahead t_trxreadahead;
+
+/*! \brief Start decoding frames ahead of the consumer on a reader thread.
+ *
+ * Call after read_first_frame() has succeeded; \p fr is the first frame
+ * and provides the flags and allocation sizes for the \p numFrames
+ * pre-allocated ring slots the reader thread decodes into. This overlaps
+ * (de)compression with the analysis of already delivered frames, which
+ * helps tools that read compressed trajectories.
+ *
+ * After this call \p status is owned by the reader thread; use
+ * read_next_frame_readahead() instead of read_next_frame() until
+ * done_trx_readahead() has been called, after which close_trx() remains
+ * the caller's responsibility.
+ */
+t_trxreadahead* start_trx_readahead(const gmx_output_env_t*  oenv,
+                                    t_trxstatus*             status,
+                                    const struct t_trxframe* fr,
+                                    int                      numFrames);
+
+/*! \brief Deliver the next decoded frame from the read-ahead ring.
+ *
+ * The contents of \p fr are swapped with a filled ring slot, so the
+ * caller's previous arrays are reused for decoding; no copying is done.
+ * Returns true when a frame was delivered, false at the end of the
+ * trajectory.
+ */
+bool read_next_frame_readahead(t_trxreadahead* ra, struct t_trxframe* fr);
+
+/*! \brief Stop the reader thread and free the read-ahead ring. */
+void done_trx_readahead(t_trxreadahead* ra);
+
 int read_first_x(const gmx_output_env_t* oenv, t_trxstatus** status, const char* fn, real* t, rvec** x, matrix box);
 /* These routines read first coordinates and box, and allocates
  * memory for the coordinates, for a trajectory file.
@@ -41,6 +41,8 @@
 
 #include <cstring>
 
+#include <string>
+
 #include "gromacs/fileio/gmxfio.h"
 #include "gromacs/fileio/gmxfio_xdr.h"
 #include "gromacs/fileio/xdrf.h"
@@ -285,3 +287,182 @@ int read_next_xtc(t_fileio* fio, int natoms, int64_t* step, real* time, matrix b
 
     return static_cast<int>(*bOK);
 }
+
+/* The sidecar index is an XDR file so that it is portable like the
+ * trajectory itself. It stores the size the trajectory had when the index
+ * was made, so an index that went stale because the trajectory was
+ * appended to or overwritten is silently ignored.
+ */
+#define XTC_INDEX_MAGIC 2011
+#define XTC_INDEX_VERSION 1
+
+static std::string xtc_index_filename(const char* fnXtc)
+{
+    return std::string(fnXtc) + ".xni";
+}
+
+static int64_t xtc_file_size(const char* fn)
+{
+    FILE*   fp = gmx_ffopen(fn, "rb");
+    int64_t size;
+
+    if (gmx_fseek(fp, 0, SEEK_END) != 0)
+    {
+        gmx_ffclose(fp);
+        return -1;
+    }
+    size = gmx_ftell(fp);
+    gmx_ffclose(fp);
+
+    return size;
+}
+
+t_xtcindex* read_xtc_index(const char* fnXtc)
+{
+    std::string fnIndex = xtc_index_filename(fnXtc);
+
+    if (!gmx_fexist(fnIndex.c_str()))
+    {
+        return nullptr;
+    }
+
+    t_fileio* fio     = gmx_fio_open(fnIndex.c_str(), "r");
+    XDR*      xd      = gmx_fio_getxdr(fio);
+    int       magic   = 0;
+    int       version = 0;
+    int64_t   xtcSize = 0;
+    int       nframes = 0;
+
+    if (xdr_int(xd, &magic) == 0 || magic != XTC_INDEX_MAGIC || xdr_int(xd, &version) == 0
+        || version != XTC_INDEX_VERSION || xdr_int64(xd, &xtcSize) == 0
+        || xdr_int(xd, &nframes) == 0 || nframes < 0 || xtcSize != xtc_file_size(fnXtc))
+    {
+        gmx_fio_close(fio);
+        return nullptr;
+    }
+
+    t_xtcindex* index;
+    snew(index, 1);
+    index->nframes = nframes;
+    snew(index->offset, nframes);
+    snew(index->step, nframes);
+    snew(index->time, nframes);
+    for (int i = 0; i < nframes; i++)
+    {
+        if (xdr_int64(xd, &index->offset[i]) == 0 || xdr_int64(xd, &index->step[i]) == 0
+            || xdr_r2f(xd, &index->time[i], TRUE) == 0)
+        {
+            gmx_fio_close(fio);
+            done_xtc_index(index);
+            return nullptr;
+        }
+    }
+    gmx_fio_close(fio);
+
+    return index;
+}
+
+void write_xtc_index(const char* fnXtc, const t_xtcindex* index)
+{
+    std::string fnIndex = xtc_index_filename(fnXtc);
+    t_fileio*   fio     = gmx_fio_open(fnIndex.c_str(), "w");
+    XDR*        xd      = gmx_fio_getxdr(fio);
+    int         magic   = XTC_INDEX_MAGIC;
+    int         version = XTC_INDEX_VERSION;
+    int64_t     xtcSize = xtc_file_size(fnXtc);
+    int         nframes = index->nframes;
+
+    xdr_int(xd, &magic);
+    xdr_int(xd, &version);
+    xdr_int64(xd, &xtcSize);
+    xdr_int(xd, &nframes);
+    for (int i = 0; i < nframes; i++)
+    {
+        xdr_int64(xd, &index->offset[i]);
+        xdr_int64(xd, &index->step[i]);
+        xdr_r2f(xd, &index->time[i], FALSE);
+    }
+    gmx_fio_close(fio);
+}
+
+t_xtcindex* build_xtc_index(const char* fnXtc)
+{
+    t_fileio* fio = open_xtc(fnXtc, "r");
+    int       natoms;
+    int64_t   step;
+    real      time, prec;
+    matrix    box;
+    rvec*     x = nullptr;
+    gmx_bool  bOK;
+
+    int64_t frameStart = gmx_fio_ftell(fio);
+    if (read_first_xtc(fio, &natoms, &step, &time, box, &x, &prec, &bOK) == 0)
+    {
+        sfree(x);
+        close_xtc(fio);
+        return nullptr;
+    }
+
+    t_xtcindex* index;
+    int         nalloc = 1024;
+    snew(index, 1);
+    index->nframes = 0;
+    snew(index->offset, nalloc);
+    snew(index->step, nalloc);
+    snew(index->time, nalloc);
+    do
+    {
+        if (index->nframes == nalloc)
+        {
+            nalloc *= 2;
+            srenew(index->offset, nalloc);
+            srenew(index->step, nalloc);
+            srenew(index->time, nalloc);
+        }
+        index->offset[index->nframes] = frameStart;
+        index->step[index->nframes]   = step;
+        index->time[index->nframes]   = time;
+        index->nframes++;
+        frameStart = gmx_fio_ftell(fio);
+    } while (read_next_xtc(fio, natoms, &step, &time, box, x, &prec, &bOK) != 0);
+    sfree(x);
+    close_xtc(fio);
+
+    return index;
+}
+
+void done_xtc_index(t_xtcindex* index)
+{
+    sfree(index->offset);
+    sfree(index->step);
+    sfree(index->time);
+    sfree(index);
+}
+
+int xtc_index_seek_time(t_fileio* fio, const t_xtcindex* index, real time)
+{
+    /* Binary search for the first frame with time >= time; frames are
+     * assumed to be in time order, as the seeks through the file itself
+     * assume as well. */
+    int low  = 0;
+    int high = index->nframes;
+
+    while (low < high)
+    {
+        int mid = low + (high - low) / 2;
+        if (index->time[mid] < time)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    if (low == index->nframes)
+    {
+        return -1;
+    }
+
+    return gmx_fio_seek(fio, index->offset[low]);
+}
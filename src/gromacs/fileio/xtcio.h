@@ -78,4 +78,35 @@ int read_next_xtc(struct t_fileio* fio, int natoms, int64_t* step, real* time, m
 int write_xtc(struct t_fileio* fio, int natoms, int64_t step, real time, const rvec* box, const rvec* x, real prec);
 /* Write a frame to xtc file */
 
+/* Optional sidecar frame index for an XTC file, stored next to the
+ * trajectory with an extra ".xni" extension. It records the file offset,
+ * MD step and time of every frame, so seeking becomes a binary search in
+ * memory plus one file seek instead of probing through the trajectory.
+ */
+typedef struct t_xtcindex
+{
+    int      nframes; /* number of frames in the trajectory          */
+    int64_t* offset;  /* file offset of the start of each frame      */
+    int64_t* step;    /* MD step of each frame                       */
+    real*    time;    /* time of each frame                          */
+} t_xtcindex;
+
+t_xtcindex* read_xtc_index(const char* fnXtc);
+/* Read the sidecar index of fnXtc. Returns NULL when there is no index
+ * or when it does not match the current size of the trajectory. */
+
+void write_xtc_index(const char* fnXtc, const t_xtcindex* index);
+/* Write the sidecar index of fnXtc */
+
+t_xtcindex* build_xtc_index(const char* fnXtc);
+/* Build an index by scanning the whole trajectory once.
+ * Returns NULL when the file can not be read. */
+
+void done_xtc_index(t_xtcindex* index);
+/* Free an index */
+
+int xtc_index_seek_time(struct t_fileio* fio, const t_xtcindex* index, real time);
+/* Position fio at the start of the first frame with time >= time.
+ * Returns 0 if successful, -1 when no such frame exists. */
+
 #endif
@@ -0,0 +1,178 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Implements a buffered writer for xvg data tables
+ *
+ * \ingroup module_fileio
+ */
+#include "gmxpre.h"
+
+#include "xvgwriter.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+
+namespace gmx
+{
+
+namespace
+{
+
+//! Size of the row buffer; large enough that fwrite calls are rare.
+constexpr std::size_t c_bufferSize = 64 * 1024;
+
+//! Upper bound on the formatted length of one value on the fast path.
+constexpr std::size_t c_maxValueLength = 64;
+
+/*! \brief Format \p value like fprintf() "%*.*f" into \p out.
+ *
+ * The value is scaled to an integer and its digits are emitted directly,
+ * which avoids the locale and format-string handling of printf. Values
+ * whose scaled representation does not fit exactly in the integer range,
+ * and non-finite values, are delegated to snprintf.
+ *
+ * \returns the number of characters written, at most c_maxValueLength.
+ */
+std::size_t formatFixed(char* out, double value, int width, int precision)
+{
+    /* Powers of ten for scaling; all exactly representable */
+    static const double c_powerOfTen[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                                           1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17 };
+
+    width     = std::min(width, static_cast<int>(c_maxValueLength) - 1);
+    precision = std::min(precision, 17);
+
+    const double scaled = value * c_powerOfTen[precision];
+    /* Beyond 2^52 doubles no longer hold every integer, so the digit
+     * emission below would not match printf; delegate such values.
+     */
+    if (!(std::abs(scaled) < 4.5e15))
+    {
+        const int n = snprintf(out, c_maxValueLength, "%*.*f", width, precision, value);
+        return std::min(static_cast<std::size_t>(n), c_maxValueLength - 1);
+    }
+    const int64_t rounded = std::llrint(scaled);
+
+    char  digits[c_maxValueLength];
+    char* p         = digits + sizeof(digits);
+    int64_t remainder = rounded >= 0 ? rounded : -rounded;
+    for (int i = 0; i < precision; i++)
+    {
+        *(--p) = '0' + remainder % 10;
+        remainder /= 10;
+    }
+    if (precision > 0)
+    {
+        *(--p) = '.';
+    }
+    do
+    {
+        *(--p) = '0' + remainder % 10;
+        remainder /= 10;
+    } while (remainder > 0);
+    /* printf prints a sign for negative values that round to zero */
+    if (std::signbit(value))
+    {
+        *(--p) = '-';
+    }
+
+    const std::size_t length = digits + sizeof(digits) - p;
+    std::size_t       padding = 0;
+    while (length + padding < static_cast<std::size_t>(width))
+    {
+        out[padding++] = ' ';
+    }
+    std::memcpy(out + padding, p, length);
+
+    return padding + length;
+}
+
+} // namespace
+
+XvgTableWriter::XvgTableWriter(FILE* fp) : fp_(fp), buffer_(c_bufferSize), used_(0) {}
+
+XvgTableWriter::~XvgTableWriter()
+{
+    flush();
+}
+
+void XvgTableWriter::ensureSpace(std::size_t bytes)
+{
+    if (used_ + bytes > buffer_.size())
+    {
+        flush();
+    }
+}
+
+void XvgTableWriter::flush()
+{
+    if (used_ > 0)
+    {
+        fwrite(buffer_.data(), 1, used_, fp_);
+        used_ = 0;
+    }
+}
+
+void XvgTableWriter::writeValue(double value, int width, int precision)
+{
+    ensureSpace(c_maxValueLength);
+    used_ += formatFixed(buffer_.data() + used_, value, width, precision);
+}
+
+void XvgTableWriter::writeText(const char* text)
+{
+    const std::size_t length = std::strlen(text);
+    if (length > buffer_.size())
+    {
+        flush();
+        fwrite(text, 1, length, fp_);
+        return;
+    }
+    ensureSpace(length);
+    std::memcpy(buffer_.data() + used_, text, length);
+    used_ += length;
+}
+
+void XvgTableWriter::finishRow()
+{
+    ensureSpace(1);
+    buffer_[used_++] = '\n';
+}
+
+} // namespace gmx
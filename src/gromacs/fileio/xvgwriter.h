@@ -0,0 +1,109 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares a buffered writer for xvg data tables
+ *
+ * \inlibraryapi
+ * \ingroup module_fileio
+ */
+#ifndef GMX_FILEIO_XVGWRITER_H
+#define GMX_FILEIO_XVGWRITER_H
+
+#include <cstdio>
+
+#include <vector>
+
+#include "gromacs/utility/classhelpers.h"
+
+namespace gmx
+{
+
+/*! \libinternal \brief
+ * Buffered writer for the data rows of xvg files.
+ *
+ * Tools that emit many rows of fixed-format columns spend most of their
+ * output time in per-value fprintf() calls. This writer formats values
+ * with a direct fixed-notation converter instead of the printf machinery
+ * and collects rows in a large buffer that is written out in a few
+ * fwrite() calls, which is roughly an order of magnitude faster.
+ *
+ * The writer appends to a FILE that has typically been opened with
+ * xvgropen(), after the headers and legends have been written with the
+ * usual routines; it does not take ownership of the file. Buffered data
+ * is flushed on destruction, so destroy or flush() the writer before
+ * calling xvgrclose() or mixing in direct fprintf() calls.
+ */
+class XvgTableWriter
+{
+public:
+    //! Create a writer appending to \p fp, which stays owned by the caller.
+    explicit XvgTableWriter(FILE* fp);
+    ~XvgTableWriter();
+
+    /*! \brief Append \p value formatted as fprintf() "%*.*f" would.
+     *
+     * \param[in] value     Value to write
+     * \param[in] width     Minimum field width, padded with spaces
+     * \param[in] precision Number of decimals
+     */
+    void writeValue(double value, int width, int precision);
+
+    //! Append literal text, such as a column separator.
+    void writeText(const char* text);
+
+    //! Terminate the current row.
+    void finishRow();
+
+    //! Write all buffered data to the file.
+    void flush();
+
+private:
+    //! Flush if fewer than \p bytes of buffer space remain.
+    void ensureSpace(std::size_t bytes);
+
+    //! The file written to; not owned.
+    FILE* fp_;
+    //! Row buffer.
+    std::vector<char> buffer_;
+    //! Number of bytes of buffer_ in use.
+    std::size_t used_;
+
+    GMX_DISALLOW_COPY_AND_ASSIGN(XvgTableWriter);
+};
+
+} // namespace gmx
+
+#endif
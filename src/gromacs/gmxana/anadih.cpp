@@ -47,6 +47,7 @@
 #include "gromacs/fileio/trxio.h"
 #include "gromacs/fileio/xvgr.h"
 #include "gromacs/gmxana/angle_correction.h"
+#include "gromacs/gmxana/dihbatch.h"
 #include "gromacs/gmxana/gstat.h"
 #include "gromacs/listed_forces/bonded.h"
 #include "gromacs/math/functions.h"
@@ -692,17 +693,15 @@ void calc_distribution_props(int nh, const int histo[], real start, int nkkk, t_
 
 static void calc_angles(struct t_pbc* pbc, int n3, int index[], real ang[], rvec x_s[])
 {
-    int  i, ix, t1, t2;
-    rvec r_ij, r_kj;
-    real costh = 0.0;
+    bond_angle_batch(pbc, n3 / 3, index, x_s, ang);
 
-    for (i = ix = 0; (ix < n3); i++, ix += 3)
-    {
-        ang[i] = bond_angle(x_s[index[ix]], x_s[index[ix + 1]], x_s[index[ix + 2]], pbc, r_ij, r_kj,
-                            &costh, &t1, &t2);
-    }
     if (debug)
     {
+        int  t1, t2;
+        rvec r_ij, r_kj;
+        real costh = 0.0;
+
+        bond_angle(x_s[index[0]], x_s[index[1]], x_s[index[2]], pbc, r_ij, r_kj, &costh, &t1, &t2);
         fprintf(debug, "Angle[0]=%g, costh=%g, index0 = %d, %d, %d\n", ang[0], costh, index[0],
                 index[1], index[2]);
         pr_rvec(debug, 0, "rij", r_ij, DIM, TRUE);
@@ -745,17 +744,8 @@ static real calc_fraction(const real angles[], int nangles)
 
 static void calc_dihs(struct t_pbc* pbc, int n4, const int index[], real ang[], rvec x_s[])
 {
-    int  i, ix, t1, t2, t3;
-    rvec r_ij, r_kj, r_kl, m, n;
-    real aaa;
-
-    for (i = ix = 0; (ix < n4); i++, ix += 4)
-    {
-        aaa = dih_angle(x_s[index[ix]], x_s[index[ix + 1]], x_s[index[ix + 2]], x_s[index[ix + 3]],
-                        pbc, r_ij, r_kj, r_kl, m, n, &t1, &t2, &t3);
-
-        ang[i] = aaa; /* not taking into account ryckaert bellemans yet */
-    }
+    /* not taking into account ryckaert bellemans yet */
+    dih_angle_batch(pbc, n4 / 4, index, x_s, ang);
 }
 
 void make_histo(FILE* log, int ndata, real data[], int npoints, int histo[], real minx, real maxx)
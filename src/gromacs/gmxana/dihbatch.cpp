@@ -0,0 +1,211 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+
+#include "gmxpre.h"
+
+#include "dihbatch.h"
+
+#include <cstdint>
+
+#include <algorithm>
+
+#include "gromacs/listed_forces/bonded.h"
+#include "gromacs/math/vec.h"
+#include "gromacs/pbcutil/pbc.h"
+#include "gromacs/pbcutil/pbc_simd.h"
+#include "gromacs/simd/simd.h"
+#include "gromacs/simd/simd_math.h"
+#include "gromacs/simd/vector_operations.h"
+
+#if GMX_SIMD_HAVE_REAL
+using namespace gmx;
+#endif
+
+void bond_angle_batch(const t_pbc* pbc, int nang, const int index[], const rvec x[], real theta[])
+{
+#if GMX_SIMD_HAVE_REAL
+    alignas(GMX_SIMD_ALIGNMENT) real         pbc_simd[9 * GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ai[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t aj[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ak[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real         buf[GMX_SIMD_REAL_WIDTH];
+
+    set_pbc_simd(pbc, pbc_simd);
+
+    for (int i = 0; i < nang; i += GMX_SIMD_REAL_WIDTH)
+    {
+        /* Collect atom triplets for GMX_SIMD_REAL_WIDTH angles; the last
+         * iteration is padded by repeating the last angle.
+         */
+        for (int s = 0; s < GMX_SIMD_REAL_WIDTH; s++)
+        {
+            const int iu = std::min(i + s, nang - 1);
+
+            ai[s] = index[3 * iu];
+            aj[s] = index[3 * iu + 1];
+            ak[s] = index[3 * iu + 2];
+        }
+
+        SimdReal xi_S, yi_S, zi_S;
+        SimdReal xj_S, yj_S, zj_S;
+        SimdReal xk_S, yk_S, zk_S;
+
+        gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), ai, &xi_S, &yi_S, &zi_S);
+        gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), aj, &xj_S, &yj_S, &zj_S);
+        gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), ak, &xk_S, &yk_S, &zk_S);
+
+        SimdReal rijx_S = xi_S - xj_S;
+        SimdReal rijy_S = yi_S - yj_S;
+        SimdReal rijz_S = zi_S - zj_S;
+        SimdReal rkjx_S = xk_S - xj_S;
+        SimdReal rkjy_S = yk_S - yj_S;
+        SimdReal rkjz_S = zk_S - zj_S;
+
+        pbc_correct_dx_simd(&rijx_S, &rijy_S, &rijz_S, pbc_simd);
+        pbc_correct_dx_simd(&rkjx_S, &rkjy_S, &rkjz_S, pbc_simd);
+
+        /* cos(theta) as in cos_angle(), clamped against rounding */
+        SimdReal ip_S    = iprod(rijx_S, rijy_S, rijz_S, rkjx_S, rkjy_S, rkjz_S);
+        SimdReal n2ij_S  = norm2(rijx_S, rijy_S, rijz_S);
+        SimdReal n2kj_S  = norm2(rkjx_S, rkjy_S, rkjz_S);
+        SimdReal costh_S = ip_S * invsqrt(n2ij_S * n2kj_S);
+        costh_S          = max(min(costh_S, SimdReal(1.0)), SimdReal(-1.0));
+
+        store(buf, acos(costh_S));
+
+        const int nStore = std::min(nang - i, GMX_SIMD_REAL_WIDTH);
+        for (int s = 0; s < nStore; s++)
+        {
+            theta[i + s] = buf[s];
+        }
+    }
+#else
+    for (int i = 0; i < nang; i++)
+    {
+        rvec r_ij, r_kj;
+        real costh;
+        int  t1, t2;
+
+        theta[i] = bond_angle(x[index[3 * i]], x[index[3 * i + 1]], x[index[3 * i + 2]], pbc, r_ij,
+                              r_kj, &costh, &t1, &t2);
+    }
+#endif
+}
+
+void dih_angle_batch(const t_pbc* pbc, int ndih, const int index[], const rvec x[], real phi[])
+{
+#if GMX_SIMD_HAVE_REAL
+    alignas(GMX_SIMD_ALIGNMENT) real         pbc_simd[9 * GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ai[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t aj[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ak[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t al[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real         buf[GMX_SIMD_REAL_WIDTH];
+
+    set_pbc_simd(pbc, pbc_simd);
+
+    for (int i = 0; i < ndih; i += GMX_SIMD_REAL_WIDTH)
+    {
+        /* Collect atom quadruplets for GMX_SIMD_REAL_WIDTH dihedrals; the
+         * last iteration is padded by repeating the last dihedral.
+         */
+        for (int s = 0; s < GMX_SIMD_REAL_WIDTH; s++)
+        {
+            const int iu = std::min(i + s, ndih - 1);
+
+            ai[s] = index[4 * iu];
+            aj[s] = index[4 * iu + 1];
+            ak[s] = index[4 * iu + 2];
+            al[s] = index[4 * iu + 3];
+        }
+
+        SimdReal xi_S, yi_S, zi_S;
+        SimdReal xj_S, yj_S, zj_S;
+        SimdReal xk_S, yk_S, zk_S;
+        SimdReal xl_S, yl_S, zl_S;
+        SimdReal mx_S, my_S, mz_S;
+        SimdReal nx_S, ny_S, nz_S;
+        SimdReal cx_S, cy_S, cz_S;
+
+        gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), ai, &xi_S, &yi_S, &zi_S);
+        gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), aj, &xj_S, &yj_S, &zj_S);
+        gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), ak, &xk_S, &yk_S, &zk_S);
+        gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), al, &xl_S, &yl_S, &zl_S);
+
+        SimdReal rijx_S = xi_S - xj_S;
+        SimdReal rijy_S = yi_S - yj_S;
+        SimdReal rijz_S = zi_S - zj_S;
+        SimdReal rkjx_S = xk_S - xj_S;
+        SimdReal rkjy_S = yk_S - yj_S;
+        SimdReal rkjz_S = zk_S - zj_S;
+        SimdReal rklx_S = xk_S - xl_S;
+        SimdReal rkly_S = yk_S - yl_S;
+        SimdReal rklz_S = zk_S - zl_S;
+
+        pbc_correct_dx_simd(&rijx_S, &rijy_S, &rijz_S, pbc_simd);
+        pbc_correct_dx_simd(&rkjx_S, &rkjy_S, &rkjz_S, pbc_simd);
+        pbc_correct_dx_simd(&rklx_S, &rkly_S, &rklz_S, pbc_simd);
+
+        cprod(rijx_S, rijy_S, rijz_S, rkjx_S, rkjy_S, rkjz_S, &mx_S, &my_S, &mz_S);
+        cprod(rkjx_S, rkjy_S, rkjz_S, rklx_S, rkly_S, rklz_S, &nx_S, &ny_S, &nz_S);
+        cprod(mx_S, my_S, mz_S, nx_S, ny_S, nz_S, &cx_S, &cy_S, &cz_S);
+
+        SimdReal cn_S = sqrt(norm2(cx_S, cy_S, cz_S));
+        SimdReal s_S  = iprod(mx_S, my_S, mz_S, nx_S, ny_S, nz_S);
+
+        /* The dihedral angle, with the sign set by r_ij . n as in dih_angle() */
+        SimdReal phi_S = atan2(cn_S, s_S);
+        SimdReal ipr_S = iprod(rijx_S, rijy_S, rijz_S, nx_S, ny_S, nz_S);
+        phi_S          = blend(phi_S, -phi_S, ipr_S < setZero());
+
+        store(buf, phi_S);
+
+        const int nStore = std::min(ndih - i, GMX_SIMD_REAL_WIDTH);
+        for (int s = 0; s < nStore; s++)
+        {
+            phi[i + s] = buf[s];
+        }
+    }
+#else
+    for (int i = 0; i < ndih; i++)
+    {
+        rvec r_ij, r_kj, r_kl, m, n;
+        int  t1, t2, t3;
+
+        phi[i] = dih_angle(x[index[4 * i]], x[index[4 * i + 1]], x[index[4 * i + 2]],
+                           x[index[4 * i + 3]], pbc, r_ij, r_kj, r_kl, m, n, &t1, &t2, &t3);
+    }
+#endif
+}
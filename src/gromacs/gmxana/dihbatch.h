@@ -0,0 +1,74 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+
+#ifndef _dihbatch_h
+#define _dihbatch_h
+
+#include "gromacs/math/vectypes.h"
+#include "gromacs/utility/real.h"
+
+struct t_pbc;
+
+/* Batched angle and dihedral computation for the analysis tools
+ * (gmx angle, gmx chi, gmx rama).
+ *
+ * These compute the same angles as bond_angle() and dih_angle() from
+ * listed_forces, but for a whole list of angles at once, using the SIMD
+ * layer when it is available so that GMX_SIMD_REAL_WIDTH angles are
+ * evaluated per iteration. Without SIMD support they fall back to the
+ * scalar routines.
+ */
+
+/*! \brief Compute nang angles between bonds i-j and j-k.
+ *
+ * \param[in]  pbc   the periodic boundary conditions, or nullptr
+ * \param[in]  nang  the number of angles
+ * \param[in]  index 3*nang atom indices, an i,j,k triplet per angle
+ * \param[in]  x     the coordinates
+ * \param[out] theta the nang angles in radians
+ */
+void bond_angle_batch(const t_pbc* pbc, int nang, const int index[], const rvec x[], real theta[]);
+
+/*! \brief Compute ndih dihedral angles around the bonds j-k.
+ *
+ * \param[in]  pbc   the periodic boundary conditions, or nullptr
+ * \param[in]  ndih  the number of dihedrals
+ * \param[in]  index 4*ndih atom indices, an i,j,k,l quadruplet per dihedral
+ * \param[in]  x     the coordinates
+ * \param[out] phi   the ndih dihedral angles in radians
+ */
+void dih_angle_batch(const t_pbc* pbc, int ndih, const int index[], const rvec x[], real phi[]);
+
+#endif
@@ -47,6 +47,7 @@
 #include "gromacs/correlationfunctions/autocorr.h"
 #include "gromacs/fileio/trrio.h"
 #include "gromacs/fileio/xvgr.h"
+#include "gromacs/fileio/xvgwriter.h"
 #include "gromacs/gmxana/angle_correction.h"
 #include "gromacs/gmxana/gmx_ana.h"
 #include "gromacs/gmxana/gstat.h"
@@ -297,25 +298,31 @@ int gmx_g_angle(int argc, char* argv[])
     {
         sprintf(title, "Average Angle: %s", grpname);
         out = xvgropen(opt2fn("-ov", NFILE, fnm), title, "Time (ps)", "Angle (degrees)", oenv);
-        for (i = 0; (i < nframes); i++)
         {
-            fprintf(out, "%10.5f  %8.3f", time[i], aver_angle[i] * RAD2DEG);
-            if (bALL)
+            gmx::XvgTableWriter writer(out);
+            for (i = 0; (i < nframes); i++)
             {
-                for (j = 0; (j < nangles); j++)
+                writer.writeValue(time[i], 10, 5);
+                writer.writeText("  ");
+                writer.writeValue(aver_angle[i] * RAD2DEG, 8, 3);
+                if (bALL)
                 {
-                    if (bPBC)
-                    {
-                        real dd = dih[j][i];
-                        fprintf(out, "  %8.3f", std::atan2(std::sin(dd), std::cos(dd)) * RAD2DEG);
-                    }
-                    else
+                    for (j = 0; (j < nangles); j++)
                     {
-                        fprintf(out, "  %8.3f", dih[j][i] * RAD2DEG);
+                        writer.writeText("  ");
+                        if (bPBC)
+                        {
+                            real dd = dih[j][i];
+                            writer.writeValue(std::atan2(std::sin(dd), std::cos(dd)) * RAD2DEG, 8, 3);
+                        }
+                        else
+                        {
+                            writer.writeValue(dih[j][i] * RAD2DEG, 8, 3);
+                        }
                     }
                 }
+                writer.finishRow();
             }
-            fprintf(out, "\n");
         }
         xvgrclose(out);
     }
@@ -1431,7 +1431,7 @@ int gmx_cluster(int argc, char* argv[])
 
     matrix      box;
     matrix*     boxes = nullptr;
-    rvec *      xtps, *usextps, *x1, **xx = nullptr;
+    rvec *      xtps, *usextps, **xx = nullptr;
     const char *fn, *trx_out_fn;
     t_clusters  clust;
     t_mat *     rms, *orig = nullptr;
@@ -1444,7 +1444,7 @@ int gmx_cluster(int argc, char* argv[])
     int      isize = 0, ifsize = 0, iosize = 0;
     int *    index = nullptr, *fitidx = nullptr, *outidx = nullptr, *frameindices = nullptr;
     char*    grpname;
-    real     rmsd, **d1, **d2, *time = nullptr, time_invfac, *mass = nullptr;
+    real     rmsd, *time = nullptr, time_invfac, *mass = nullptr;
     char     buf[STRLEN], buf1[80];
     gmx_bool bAnalyze, bUseRmsdCut, bJP_RMSD = FALSE, bReadMat, bReadTraj, bPBC = TRUE;
 
@@ -1790,67 +1790,110 @@ int gmx_cluster(int argc, char* argv[])
         if (!bRMSdist)
         {
             fprintf(stderr, "Computing %dx%d RMS deviation matrix\n", nf, nf);
-            /* Initialize work array */
-            snew(x1, isize);
-            for (i1 = 0; i1 < nf; i1++)
+            /* Rows of the matrix are distributed over the threads; each pair
+             * is independent, so only the progress counter and the matrix
+             * statistics need synchronization.
+             */
+#pragma omp parallel private(i1, i2, rmsd)
             {
-                for (i2 = i1 + 1; i2 < nf; i2++)
+                real minLocal = 1e10, maxLocal = 0, sumLocal = 0;
+#pragma omp for schedule(dynamic)
+                for (i1 = 0; i1 < nf; i1++)
                 {
-                    for (i = 0; i < isize; i++)
+                    for (i2 = i1 + 1; i2 < nf; i2++)
                     {
-                        copy_rvec(xx[i1][i], x1[i]);
+                        if (bFit)
+                        {
+                            /* All frames have been centered on the fit group,
+                             * so the QCP kernel returns the fitted RMSD
+                             * without constructing the rotation.
+                             */
+                            rmsd = calc_rmsd_qcp(isize, mass, xx[i2], xx[i1]);
+                        }
+                        else
+                        {
+                            rmsd = rmsdev(isize, mass, xx[i2], xx[i1]);
+                        }
+                        rms->mat[i1][i2] = rms->mat[i2][i1] = rmsd;
+                        maxLocal                            = std::max(maxLocal, rmsd);
+                        minLocal                            = std::min(minLocal, rmsd);
+                        sumLocal += rmsd;
                     }
-                    if (bFit)
+#pragma omp critical
                     {
-                        do_fit(isize, mass, xx[i2], x1);
+                        nrms -= nf - i1 - 1;
+                        fprintf(stderr,
+                                "\r# RMSD calculations left: "
+                                "%" PRId64 "   ",
+                                nrms);
+                        fflush(stderr);
                     }
-                    rmsd = rmsdev(isize, mass, xx[i2], x1);
-                    set_mat_entry(rms, i1, i2, rmsd);
                 }
-                nrms -= nf - i1 - 1;
-                fprintf(stderr,
-                        "\r# RMSD calculations left: "
-                        "%" PRId64 "   ",
-                        nrms);
-                fflush(stderr);
+#pragma omp critical
+                {
+                    rms->maxrms = std::max(rms->maxrms, maxLocal);
+                    rms->minrms = std::min(rms->minrms, minLocal);
+                    rms->sumrms += sumLocal;
+                }
             }
-            sfree(x1);
         }
         else /* bRMSdist */
         {
             fprintf(stderr, "Computing %dx%d RMS distance deviation matrix\n", nf, nf);
 
-            /* Initiate work arrays */
-            snew(d1, isize);
-            snew(d2, isize);
-            for (i = 0; (i < isize); i++)
-            {
-                snew(d1[i], isize);
-                snew(d2[i], isize);
-            }
-            for (i1 = 0; i1 < nf; i1++)
+#pragma omp parallel private(i, i1, i2)
             {
-                calc_dist(isize, xx[i1], d1);
-                for (i2 = i1 + 1; (i2 < nf); i2++)
+                real **d1Local, **d2Local;
+                real   minLocal = 1e10, maxLocal = 0, sumLocal = 0;
+                snew(d1Local, isize);
+                snew(d2Local, isize);
+                for (i = 0; (i < isize); i++)
                 {
-                    calc_dist(isize, xx[i2], d2);
-                    set_mat_entry(rms, i1, i2, rms_dist(isize, d1, d2));
+                    snew(d1Local[i], isize);
+                    snew(d2Local[i], isize);
                 }
-                nrms -= nf - i1 - 1;
-                fprintf(stderr,
-                        "\r# RMSD calculations left: "
-                        "%" PRId64 "   ",
-                        nrms);
-                fflush(stderr);
-            }
-            /* Clean up work arrays */
-            for (i = 0; (i < isize); i++)
-            {
-                sfree(d1[i]);
-                sfree(d2[i]);
+#pragma omp for schedule(dynamic)
+                for (i1 = 0; i1 < nf; i1++)
+                {
+                    calc_dist(isize, xx[i1], d1Local);
+                    for (i2 = i1 + 1; (i2 < nf); i2++)
+                    {
+                        calc_dist(isize, xx[i2], d2Local);
+                        const real dist  = rms_dist(isize, d1Local, d2Local);
+                        rms->mat[i1][i2] = rms->mat[i2][i1] = dist;
+                        maxLocal                            = std::max(maxLocal, dist);
+                        minLocal                            = std::min(minLocal, dist);
+                        sumLocal += dist;
+                    }
+#pragma omp critical
+                    {
+                        nrms -= nf - i1 - 1;
+                        fprintf(stderr,
+                                "\r# RMSD calculations left: "
+                                "%" PRId64 "   ",
+                                nrms);
+                        fflush(stderr);
+                    }
+                }
+#pragma omp critical
+                {
+                    rms->maxrms = std::max(rms->maxrms, maxLocal);
+                    rms->minrms = std::min(rms->minrms, minLocal);
+                    rms->sumrms += sumLocal;
+                }
+                /* Clean up work arrays */
+                for (i = 0; (i < isize); i++)
+                {
+                    sfree(d1Local[i]);
+                    sfree(d2Local[i]);
+                }
+                sfree(d1Local);
+                sfree(d2Local);
             }
-            sfree(d1);
-            sfree(d2);
+        }
+        if (nf > 1)
+        {
+            rms->nn = nf;
         }
         fprintf(stderr, "\n\n");
     }
@@ -61,6 +61,40 @@
 #include "gromacs/utility/smalloc.h"
 #include "gromacs/utility/sysinfo.h"
 
+/* Number of centered frames accumulated into the covariance matrix per pass */
+#define COVAR_FRAME_BLOCK 16
+
+/* Adds the rank-nf update of the upper triangle of the ndim*ndim matrix
+ * mat from nf centered frames, parallelized over matrix rows. The matrix
+ * is far larger than the frame coordinates, so the accumulation speed is
+ * bound by the memory traffic over the matrix; processing a block of
+ * frames per pass reduces that traffic by the block size.
+ */
+static void covar_accum_frames(real* mat, int64_t ndim, int natoms, rvec* const* xf, int nf)
+{
+#pragma omp parallel for schedule(dynamic, 4)
+    for (int j = 0; j < natoms; j++)
+    {
+        for (int dj = 0; dj < DIM; dj++)
+        {
+            const int64_t k = ndim * (DIM * j + dj);
+            for (int i = j; i < natoms; i++)
+            {
+                const int64_t l = k + DIM * i;
+                for (int d = 0; d < DIM; d++)
+                {
+                    real s = 0;
+                    for (int f = 0; f < nf; f++)
+                    {
+                        s += xf[f][i][d] * xf[f][j][dj];
+                    }
+                    mat[l + d] += s;
+                }
+            }
+        }
+    }
+}
+
 int gmx_covar(int argc, char* argv[])
 {
     const char* desc[] = {
@@ -120,7 +154,7 @@ int gmx_covar(int argc, char* argv[])
     matrix            box, zerobox;
     real *            sqrtm, *mat, *eigenvalues, sum, trace, inv_nframes;
     real              t, tstart, tend, **mat2;
-    real              xj, *w_rls = nullptr;
+    real*             w_rls = nullptr;
     real              min, max, *axis;
     int               natoms, nat, nframes0, nframes, nlevels;
     int64_t           ndim, i, j, k, l;
@@ -299,6 +333,15 @@ int gmx_covar(int argc, char* argv[])
 
     fprintf(stderr, "Constructing covariance matrix (%dx%d) ...\n", static_cast<int>(ndim),
             static_cast<int>(ndim));
+    /* The centered frames are collected in blocks, so each pass over the
+     * matrix accumulates several frames at once */
+    rvec** xblock;
+    int    nblock = 0;
+    snew(xblock, COVAR_FRAME_BLOCK);
+    for (i = 0; i < COVAR_FRAME_BLOCK; i++)
+    {
+        snew(xblock[i], natoms);
+    }
     nframes = 0;
     nat     = read_first_x(oenv, &status, trxfile, &t, &xread, box);
     tstart  = t;
@@ -320,36 +363,35 @@ int gmx_covar(int argc, char* argv[])
         {
             for (i = 0; i < natoms; i++)
             {
-                rvec_sub(xread[index[i]], xref[index[i]], x[i]);
+                rvec_sub(xread[index[i]], xref[index[i]], xblock[nblock][i]);
             }
         }
         else
         {
             for (i = 0; i < natoms; i++)
             {
-                rvec_sub(xread[index[i]], xav[i], x[i]);
+                rvec_sub(xread[index[i]], xav[i], xblock[nblock][i]);
             }
         }
 
-        for (j = 0; j < natoms; j++)
+        nblock++;
+        if (nblock == COVAR_FRAME_BLOCK)
         {
-            for (dj = 0; dj < DIM; dj++)
-            {
-                k  = ndim * (DIM * j + dj);
-                xj = x[j][dj];
-                for (i = j; i < natoms; i++)
-                {
-                    l = k + DIM * i;
-                    for (d = 0; d < DIM; d++)
-                    {
-                        mat[l + d] += x[i][d] * xj;
-                    }
-                }
-            }
+            covar_accum_frames(mat, ndim, natoms, xblock, nblock);
+            nblock = 0;
         }
     } while (read_next_x(oenv, status, &t, xread, box) && (bRef || nframes < nframes0));
     close_trx(status);
     gmx_rmpbc_done(gpbc);
+    if (nblock > 0)
+    {
+        covar_accum_frames(mat, ndim, natoms, xblock, nblock);
+    }
+    for (i = 0; i < COVAR_FRAME_BLOCK; i++)
+    {
+        sfree(xblock[i]);
+    }
+    sfree(xblock);
 
     fprintf(stderr, "Read %d frames\n", nframes);
 
@@ -48,6 +48,7 @@
 #include "gromacs/fileio/xvgr.h"
 #include "gromacs/gmxana/gmx_ana.h"
 #include "gromacs/gmxana/gstat.h"
+#include "gromacs/gmxana/slabbin.h"
 #include "gromacs/math/units.h"
 #include "gromacs/math/vec.h"
 #include "gromacs/pbcutil/pbc.h"
@@ -59,6 +60,7 @@
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/futil.h"
 #include "gromacs/utility/gmxassert.h"
+#include "gromacs/utility/gmxomp.h"
 #include "gromacs/utility/smalloc.h"
 
 typedef struct
@@ -191,21 +193,25 @@ static void calc_electron_density(const char*             fn,
     double       invvol;
     int          natoms; /* nr. atoms in trj */
     t_trxstatus* status;
-    int          i, n,     /* loop indices */
-            nr_frames = 0, /* number of frames */
-            slice;         /* current slice */
-    t_electron* found;     /* found by bsearch */
-    t_electron  sought;    /* thingie thought by bsearch */
-    real        boxSz, aveBox;
+    int          i, n,      /* loop indices */
+            nr_frames = 0;  /* number of frames */
+    t_electron* found;      /* found by bsearch */
+    t_electron  sought;     /* thingie sought by bsearch */
+    real        aveBox;
+    real*       den_val;    /* electrons per atom, from the datafile */
+    gmx_bool*   bKnown;     /* whether we already looked up this atom */
+    int         nth;        /* number of OpenMP threads for binning */
     gmx_rmpbc_t gpbc = nullptr;
 
-    real t, z;
+    real t;
 
     if (axis < 0 || axis >= DIM)
     {
         gmx_fatal(FARGS, "Invalid axes. Terminating\n");
     }
 
+    nth = gmx_omp_get_max_threads();
+
     if ((natoms = read_first_x(oenv, &status, fn, &t, &x0, box)) == 0)
     {
         gmx_fatal(FARGS, "Could not read coordinates from statusfile\n");
@@ -225,6 +231,43 @@ static void calc_electron_density(const char*             fn,
         snew((*slDensity)[i], *nslices);
     }
 
+    /* Find the number of electrons for each atom in the index groups once;
+     * doing the bsearch again for every atom in every frame is not efficient.
+     */
+    snew(den_val, top->atoms.nr);
+    snew(bKnown, top->atoms.nr);
+    for (n = 0; n < nr_grps; n++)
+    {
+        for (i = 0; i < gnx[n]; i++)
+        {
+            int a = index[n][i];
+
+            if (bKnown[a])
+            {
+                continue;
+            }
+            bKnown[a]       = TRUE;
+            sought.nr_el    = 0;
+            sought.atomname = gmx_strdup(*(top->atoms.atomname[a]));
+
+            found = static_cast<t_electron*>(
+                    bsearch(&sought, eltab, nr, sizeof(t_electron),
+                            reinterpret_cast<int (*)(const void*, const void*)>(compare)));
+
+            if (found == nullptr)
+            {
+                fprintf(stderr, "Couldn't find %s. Add it to the .dat file\n",
+                        *(top->atoms.atomname[a]));
+            }
+            else
+            {
+                den_val[a] = found->nr_el - top->atoms.atom[a].q;
+            }
+            free(sought.atomname);
+        }
+    }
+    sfree(bKnown);
+
     gpbc = gmx_rmpbc_init(&top->idef, pbcType, top->atoms.nr);
     /*********** Start processing trajectory ***********/
     do
@@ -244,63 +287,18 @@ static void calc_electron_density(const char*             fn,
         if (bRelative)
         {
             *slWidth = 1.0 / (*nslices);
-            boxSz    = 1.0;
         }
         else
         {
             *slWidth = box[axis][axis] / (*nslices);
-            boxSz    = box[axis][axis];
         }
 
         aveBox += box[axis][axis];
 
         for (n = 0; n < nr_grps; n++)
         {
-            for (i = 0; i < gnx[n]; i++) /* loop over all atoms in index file */
-            {
-                z = x0[index[n][i]][axis];
-                while (z < 0)
-                {
-                    z += box[axis][axis];
-                }
-                while (z > box[axis][axis])
-                {
-                    z -= box[axis][axis];
-                }
-
-                if (bRelative)
-                {
-                    z = z / box[axis][axis];
-                }
-
-                /* determine which slice atom is in */
-                if (bCenter)
-                {
-                    slice = static_cast<int>(std::floor((z - (boxSz / 2.0)) / (*slWidth)) + *nslices / 2.);
-                }
-                else
-                {
-                    slice = static_cast<int>(z / (*slWidth));
-                }
-                sought.nr_el    = 0;
-                sought.atomname = gmx_strdup(*(top->atoms.atomname[index[n][i]]));
-
-                /* now find the number of electrons. This is not efficient. */
-                found = static_cast<t_electron*>(
-                        bsearch(&sought, eltab, nr, sizeof(t_electron),
-                                reinterpret_cast<int (*)(const void*, const void*)>(compare)));
-
-                if (found == nullptr)
-                {
-                    fprintf(stderr, "Couldn't find %s. Add it to the .dat file\n",
-                            *(top->atoms.atomname[index[n][i]]));
-                }
-                else
-                {
-                    (*slDensity)[n][slice] += (found->nr_el - top->atoms.atom[index[n][i]].q) * invvol;
-                }
-                free(sought.atomname);
-            }
+            bin_slab_weights(x0, axis, index[n], gnx[n], den_val, invvol, box[axis][axis],
+                             *slWidth, 0.0, *nslices, bCenter, bRelative, (*slDensity)[n], nth);
         }
         nr_frames++;
     } while (read_next_x(oenv, status, &t, x0, box));
@@ -330,6 +328,7 @@ static void calc_electron_density(const char*             fn,
     }
 
     sfree(x0); /* free memory used by coordinate array */
+    sfree(den_val);
 }
 
 static void calc_density(const char*             fn,
@@ -354,12 +353,12 @@ static void calc_density(const char*             fn,
     double       invvol;
     int          natoms; /* nr. atoms in trj */
     t_trxstatus* status;
-    int          i, n,     /* loop indices */
-            nr_frames = 0, /* number of frames */
-            slice;         /* current slice */
-    real        t, z;
-    real        boxSz, aveBox;
+    int          i, n,      /* loop indices */
+            nr_frames = 0;  /* number of frames */
+    real        t;
+    real        aveBox;
     real*       den_val; /* values from which the density is calculated */
+    int         nth;     /* number of OpenMP threads for binning */
     gmx_rmpbc_t gpbc = nullptr;
 
     if (axis < 0 || axis >= DIM)
@@ -367,6 +366,8 @@ static void calc_density(const char*             fn,
         gmx_fatal(FARGS, "Invalid axes. Terminating\n");
     }
 
+    nth = gmx_omp_get_max_threads();
+
     if ((natoms = read_first_x(oenv, &status, fn, &t, &x0, box)) == 0)
     {
         gmx_fatal(FARGS, "Could not read coordinates from statusfile\n");
@@ -429,60 +430,18 @@ static void calc_density(const char*             fn,
         if (bRelative)
         {
             *slWidth = 1.0 / (*nslices);
-            boxSz    = 1.0;
         }
         else
         {
             *slWidth = box[axis][axis] / (*nslices);
-            boxSz    = box[axis][axis];
         }
 
         aveBox += box[axis][axis];
 
         for (n = 0; n < nr_grps; n++)
         {
-            for (i = 0; i < gnx[n]; i++) /* loop over all atoms in index file */
-            {
-                z = x0[index[n][i]][axis];
-                while (z < 0)
-                {
-                    z += box[axis][axis];
-                }
-                while (z > box[axis][axis])
-                {
-                    z -= box[axis][axis];
-                }
-
-                if (bRelative)
-                {
-                    z = z / box[axis][axis];
-                }
-
-                /* determine which slice atom is in */
-                if (bCenter)
-                {
-                    slice = static_cast<int>(std::floor((z - (boxSz / 2.0)) / (*slWidth)) + *nslices / 2.);
-                }
-                else
-                {
-                    slice = static_cast<int>(std::floor(z / (*slWidth)));
-                }
-
-                /* Slice should already be 0<=slice<nslices, but we just make
-                 * sure we are not hit by IEEE rounding errors since we do
-                 * math operations after applying PBC above.
-                 */
-                if (slice < 0)
-                {
-                    slice += *nslices;
-                }
-                else if (slice >= *nslices)
-                {
-                    slice -= *nslices;
-                }
-
-                (*slDensity)[n][slice] += den_val[index[n][i]] * invvol;
-            }
+            bin_slab_weights(x0, axis, index[n], gnx[n], den_val, invvol, box[axis][axis],
+                             *slWidth, 0.0, *nslices, bCenter, bRelative, (*slDensity)[n], nth);
         }
         nr_frames++;
     } while (read_next_x(oenv, status, &t, x0, box));
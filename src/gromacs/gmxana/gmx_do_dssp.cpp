@@ -43,7 +43,9 @@
 #include <cstring>
 
 #include <algorithm>
+#include <array>
 #include <numeric>
+#include <vector>
 
 #include "gromacs/commandline/pargs.h"
 #include "gromacs/commandline/viewit.h"
@@ -54,7 +56,10 @@
 #include "gromacs/fileio/xvgr.h"
 #include "gromacs/gmxana/gmx_ana.h"
 #include "gromacs/gmxana/gstat.h"
+#include "gromacs/math/units.h"
+#include "gromacs/math/vec.h"
 #include "gromacs/pbcutil/rmpbc.h"
+#include "gromacs/selection/nbsearch.h"
 #include "gromacs/topology/index.h"
 #include "gromacs/topology/topology.h"
 #include "gromacs/utility/arraysize.h"
@@ -96,6 +101,37 @@ static void printDsspResult(char* dssp, const DsspInputStrings& strings, const s
 }
 
 
+/*! \brief Appends one frame of secondary-structure characters to \p mat.
+ *
+ * \p ssbuf should hold one character per residue, plus the '=' chain
+ * separator characters. The matrix is initialized on the first call.
+ */
+static void ss_matrix_add_frame(t_matrix* mat, const char* ssbuf, int nr, real t, const gmx_output_env_t* oenv)
+{
+    if (mat->axis_x.empty())
+    {
+        mat->title     = "Secondary structure";
+        mat->legend    = "";
+        mat->label_x   = output_env_get_time_label(oenv);
+        mat->label_y   = "Residue";
+        mat->bDiscrete = true;
+        mat->ny        = nr;
+        mat->axis_y.resize(nr);
+        std::iota(mat->axis_y.begin(), mat->axis_y.end(), 1);
+        mat->axis_x.resize(0);
+        mat->matrix.resize(0, 0);
+    }
+    mat->axis_x.push_back(t);
+    mat->matrix.resize(mat->matrix.extent(0) + 1, nr);
+    mat->nx          = mat->matrix.extent(0);
+    auto columnIndex = mat->nx - 1;
+    for (int i = 0; i < nr; i++)
+    {
+        t_xpmelmt c                 = { ssbuf[i], 0 };
+        mat->matrix(columnIndex, i) = std::max(static_cast<t_matelmt>(0), searchcmap(mat->map, c));
+    }
+}
+
 static int strip_dssp(FILE*                   tapeout,
                       int                     nres,
                       const gmx_bool          bPhobres[],
@@ -180,27 +216,9 @@ static int strip_dssp(FILE*                   tapeout,
                     naccb, naccf);
         }
 
-        mat->title     = "Secondary structure";
-        mat->legend    = "";
-        mat->label_x   = output_env_get_time_label(oenv);
-        mat->label_y   = "Residue";
-        mat->bDiscrete = true;
-        mat->ny        = nr;
-        mat->axis_y.resize(nr);
-        std::iota(mat->axis_y.begin(), mat->axis_y.end(), 1);
-        mat->axis_x.resize(0);
-        mat->matrix.resize(0, 0);
         bFirst = false;
     }
-    mat->axis_x.push_back(t);
-    mat->matrix.resize(mat->matrix.extent(0), nr);
-    mat->nx          = mat->matrix.extent(0);
-    auto columnIndex = mat->nx - 1;
-    for (int i = 0; i < nr; i++)
-    {
-        t_xpmelmt c                 = { ssbuf[i], 0 };
-        mat->matrix(columnIndex, i) = std::max(static_cast<t_matelmt>(0), searchcmap(mat->map, c));
-    }
+    ss_matrix_add_frame(mat, ssbuf, nr, t, oenv);
 
     if (fTArea)
     {
@@ -283,6 +301,500 @@ static void check_oo(t_atoms* atoms)
     }
 }
 
+/* Built-in secondary-structure engine.
+ *
+ * This implements the hydrogen-bond and secondary-structure assignment
+ * of Kabsch & Sander (Biopolymers 22 (1983) 2577-2637) directly on the
+ * in-memory coordinates, following the dssp program closely. This avoids
+ * writing a PDB file and spawning an external dssp process for every
+ * frame; the per-frame cost is then dominated by the neighborhood search
+ * over the C-alpha atoms.
+ */
+
+/* Parameters of the Kabsch & Sander hydrogen-bond energy function.
+ * Energies are in kcal/mol and the distances entering the formula in A,
+ * matching the original formulation and the dssp implementation. */
+static const real c_hbondCoupling    = 27.888; /* = 332*0.42*0.20 kcal/(mol A) */
+static const real c_hbondMaxEnergy   = -0.5;    /* energy below which a hydrogen bond is assigned */
+static const real c_hbondMinEnergy   = -9.9;    /* clamp for clashing atoms */
+static const real c_hbondMinDistance = 0.05;    /* nm, below this atoms are considered clashing */
+static const real c_ssCaCutoff       = 0.9;     /* nm, C-alpha cut-off for bonded residue pairs */
+static const real c_ssChainBreakDist = 0.25;    /* nm, maximum C(i)-N(i+1) peptide-bond length */
+static const real c_ssBendAngle      = 70;      /* degrees, minimum C-alpha angle for a bend */
+
+//! Backbone atom indices for one residue of the analysis group, -1 when absent
+struct SsResidue
+{
+    int  resind    = -1;
+    int  atomN     = -1;
+    int  atomCA    = -1;
+    int  atomC     = -1;
+    int  atomO     = -1;
+    int  atomH     = -1;
+    bool bProline  = false;
+    //! Whether N, CA, C and O are all present, so the residue can be assigned
+    bool bComplete = false;
+};
+
+//! One candidate hydrogen-bond acceptor for the N-H donor of a residue
+struct SsHbond
+{
+    int  residue;
+    real energy;
+};
+
+//! A beta ladder: one or more consecutive bridges between two strands
+struct SsBridge
+{
+    bool parallel;
+    //! The residues of the two strands; \c i is ascending by construction
+    std::vector<int> i, j;
+};
+
+//! Extracts the per-residue backbone atoms from the selected index group
+static std::vector<SsResidue> get_ss_residues(const t_atoms* atoms, int gnx, const int index[])
+{
+    std::vector<SsResidue> residues;
+
+    for (int i = 0; i < gnx; i++)
+    {
+        const int a = index[i];
+        if (residues.empty() || atoms->atom[a].resind != residues.back().resind)
+        {
+            SsResidue newRes;
+            newRes.resind   = atoms->atom[a].resind;
+            newRes.bProline = (std::strcmp(*atoms->resinfo[newRes.resind].name, "PRO") == 0);
+            residues.push_back(newRes);
+        }
+        SsResidue&  res  = residues.back();
+        const char* name = *atoms->atomname[a];
+        if (std::strcmp(name, "N") == 0)
+        {
+            res.atomN = a;
+        }
+        else if (std::strcmp(name, "CA") == 0)
+        {
+            res.atomCA = a;
+        }
+        else if (std::strcmp(name, "C") == 0)
+        {
+            res.atomC = a;
+        }
+        else if (std::strcmp(name, "O") == 0)
+        {
+            res.atomO = a;
+        }
+        else if (std::strcmp(name, "H") == 0 || std::strcmp(name, "HN") == 0)
+        {
+            res.atomH = a;
+        }
+    }
+    for (SsResidue& res : residues)
+    {
+        res.bComplete = (res.atomN >= 0 && res.atomCA >= 0 && res.atomC >= 0 && res.atomO >= 0);
+    }
+
+    return residues;
+}
+
+/*! \brief Locates the chain breaks; element i is set when there is a break
+ * between residues i and i+1.
+ *
+ * Like dssp, residues are part of the same chain when their peptide bond
+ * has a reasonable length; topology chain boundaries and residues with
+ * missing backbone atoms also terminate a chain.
+ */
+static std::vector<bool> find_chain_breaks(const std::vector<SsResidue>& residues, const t_atoms* atoms, const rvec x[])
+{
+    std::vector<bool> breakAfter(residues.size(), false);
+
+    for (size_t i = 0; i + 1 < residues.size(); i++)
+    {
+        const SsResidue& ri = residues[i];
+        const SsResidue& rj = residues[i + 1];
+        if (!ri.bComplete || !rj.bComplete
+            || atoms->resinfo[ri.resind].chainnum != atoms->resinfo[rj.resind].chainnum)
+        {
+            breakAfter[i] = true;
+        }
+        else
+        {
+            rvec dx;
+            rvec_sub(x[rj.atomN], x[ri.atomC], dx);
+            breakAfter[i] = (norm(dx) > c_ssChainBreakDist);
+        }
+    }
+
+    return breakAfter;
+}
+
+//! Returns whether there is no chain break between residues \p a and \p b
+static bool no_chain_break(const std::vector<bool>& breakAfter, int a, int b)
+{
+    for (int i = a; i < b; i++)
+    {
+        if (breakAfter[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*! \brief Returns the Kabsch & Sander electrostatic hydrogen-bond energy
+ * in kcal/mol for the N-H of \p donor bonding to the C=O of \p acceptor.
+ */
+static real ss_hbond_energy(const std::vector<SsResidue>& residues,
+                            int                           donor,
+                            int                           acceptor,
+                            const rvec                    x[],
+                            const std::vector<gmx::RVec>& hpos)
+{
+    /* Proline has no amide hydrogen and can not donate */
+    if (residues[donor].bProline)
+    {
+        return 0;
+    }
+    const rvec& xN = x[residues[donor].atomN];
+    const rvec& xH = hpos[donor].as_vec();
+    const rvec& xC = x[residues[acceptor].atomC];
+    const rvec& xO = x[residues[acceptor].atomO];
+    rvec        dx;
+    rvec_sub(xO, xN, dx);
+    const real dON = norm(dx);
+    rvec_sub(xC, xH, dx);
+    const real dCH = norm(dx);
+    rvec_sub(xO, xH, dx);
+    const real dOH = norm(dx);
+    rvec_sub(xC, xN, dx);
+    const real dCN = norm(dx);
+    if (std::min({ dON, dCH, dOH, dCN }) < c_hbondMinDistance)
+    {
+        return c_hbondMinEnergy;
+    }
+    /* The factor 0.1 converts the reciprocal distances from 1/nm to 1/A */
+    const real e = 0.1 * c_hbondCoupling * (1 / dON + 1 / dCH - 1 / dOH - 1 / dCN);
+
+    return std::max(e, c_hbondMinEnergy);
+}
+
+//! Stores \p acceptor in the list of two best acceptors of a donor residue
+static void ss_store_hbond(std::array<SsHbond, 2>* partners, int acceptor, real energy)
+{
+    if (energy < (*partners)[0].energy)
+    {
+        (*partners)[1]         = (*partners)[0];
+        (*partners)[0].residue = acceptor;
+        (*partners)[0].energy  = energy;
+    }
+    else if (energy < (*partners)[1].energy)
+    {
+        (*partners)[1].residue = acceptor;
+        (*partners)[1].energy  = energy;
+    }
+}
+
+/*! \brief Assigns the secondary structure for one frame.
+ *
+ * Appends one column to \p mat, with one character per residue plus '='
+ * chain separators, using the same codes as the dssp program. Returns
+ * the number of matrix rows.
+ */
+static int assign_ss_frame(const std::vector<SsResidue>& residues,
+                           const std::vector<bool>&      breakAfter,
+                           const rvec                    x[],
+                           real                          t,
+                           gmx::AnalysisNeighborhood*    nb,
+                           t_matrix*                     mat,
+                           const gmx_output_env_t*       oenv)
+{
+    const int nres = static_cast<int>(residues.size());
+
+    /* Place the amide hydrogens. When the structure has no explicit
+     * amide hydrogen, it is constructed at 1 A from N along the C=O
+     * bond of the preceding residue, as dssp does. The first residue
+     * of a chain gets H = N, which makes all its donor energies vanish. */
+    std::vector<gmx::RVec> hpos(nres, gmx::RVec(0, 0, 0));
+    for (int r = 0; r < nres; r++)
+    {
+        if (!residues[r].bComplete)
+        {
+            continue;
+        }
+        if (residues[r].atomH >= 0)
+        {
+            hpos[r] = x[residues[r].atomH];
+        }
+        else if (r > 0 && !breakAfter[r - 1] && !residues[r].bProline)
+        {
+            rvec co;
+            rvec_sub(x[residues[r - 1].atomC], x[residues[r - 1].atomO], co);
+            unitv(co, co);
+            svmul(0.1, co, co);
+            rvec_add(x[residues[r].atomN], co, hpos[r]);
+        }
+        else
+        {
+            hpos[r] = x[residues[r].atomN];
+        }
+    }
+
+    /* Find the hydrogen bonds from a neighborhood search over the
+     * C-alpha atoms; Kabsch & Sander only allow bonds between residues
+     * whose C-alpha atoms are less than 9 A apart. Each residue keeps
+     * its two lowest-energy acceptors. */
+    std::vector<gmx::RVec> caPos;
+    std::vector<int>       caRes;
+    for (int r = 0; r < nres; r++)
+    {
+        if (residues[r].bComplete)
+        {
+            caPos.emplace_back(x[residues[r].atomCA]);
+            caRes.push_back(r);
+        }
+    }
+    std::vector<std::array<SsHbond, 2>> hbonds(nres, { { { -1, 0 }, { -1, 0 } } });
+    std::vector<std::pair<int, int>>    bridgeCandidates;
+    gmx::AnalysisNeighborhoodSearch     search = nb->initSearch(nullptr, caPos);
+    gmx::AnalysisNeighborhoodPairSearch pairSearch = search.startSelfPairSearch();
+    gmx::AnalysisNeighborhoodPair       pair;
+    while (pairSearch.findNextPair(&pair))
+    {
+        int ri = caRes[pair.refIndex()];
+        int rj = caRes[pair.testIndex()];
+        if (ri > rj)
+        {
+            std::swap(ri, rj);
+        }
+        ss_store_hbond(&hbonds[ri], rj, ss_hbond_energy(residues, ri, rj, x, hpos));
+        ss_store_hbond(&hbonds[rj], ri, ss_hbond_energy(residues, rj, ri, x, hpos));
+        if (rj - ri >= 3)
+        {
+            bridgeCandidates.emplace_back(ri, rj);
+        }
+    }
+
+    /* Returns whether the N-H of a donates a hydrogen bond to the C=O of b */
+    auto testBond = [&hbonds](int a, int b) {
+        return (hbonds[a][0].residue == b && hbonds[a][0].energy < c_hbondMaxEnergy)
+               || (hbonds[a][1].residue == b && hbonds[a][1].energy < c_hbondMaxEnergy);
+    };
+    /* Returns whether an n-turn starts at r: the C=O of r bonds to the N-H of r+n */
+    auto isTurnStart = [&](int r, int n) {
+        return r >= 0 && r + n < nres && testBond(r + n, r) && no_chain_break(breakAfter, r, r + n);
+    };
+
+    std::vector<char> ss(nres, '~');
+
+    /* Beta bridges: first collect the individual bridges in ascending
+     * residue order, merging consecutive bridges into ladders */
+    std::sort(bridgeCandidates.begin(), bridgeCandidates.end());
+    std::vector<SsBridge> bridges;
+    for (const auto& cand : bridgeCandidates)
+    {
+        const int a = cand.first;
+        const int b = cand.second;
+        if (a < 1 || a + 1 >= nres || b < 1 || b + 1 >= nres || !no_chain_break(breakAfter, a - 1, a + 1)
+            || !no_chain_break(breakAfter, b - 1, b + 1))
+        {
+            continue;
+        }
+        bool parallel;
+        if ((testBond(a + 1, b) && testBond(b, a - 1)) || (testBond(b + 1, a) && testBond(a, b - 1)))
+        {
+            parallel = true;
+        }
+        else if ((testBond(b, a) && testBond(a, b)) || (testBond(b + 1, a - 1) && testBond(a + 1, b - 1)))
+        {
+            parallel = false;
+        }
+        else
+        {
+            continue;
+        }
+        bool found = false;
+        for (SsBridge& bridge : bridges)
+        {
+            if (parallel != bridge.parallel || a != bridge.i.back() + 1)
+            {
+                continue;
+            }
+            /* In a parallel ladder the partner strand runs forwards,
+             * in an antiparallel ladder backwards */
+            if (b == bridge.j.back() + (parallel ? 1 : -1))
+            {
+                bridge.i.push_back(a);
+                bridge.j.push_back(b);
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+        {
+            bridges.push_back({ parallel, { a }, { b } });
+        }
+    }
+
+    /* Merge beta-bulge linked ladders, using the dssp criteria: at most
+     * one extra residue on one strand and at most four on the other */
+    for (size_t bi = 0; bi < bridges.size(); bi++)
+    {
+        for (size_t bj = bi + 1; bj < bridges.size();)
+        {
+            const auto iRange1 = std::minmax_element(bridges[bi].i.begin(), bridges[bi].i.end());
+            const auto jRange1 = std::minmax_element(bridges[bi].j.begin(), bridges[bi].j.end());
+            const auto iRange2 = std::minmax_element(bridges[bj].i.begin(), bridges[bj].i.end());
+            const auto jRange2 = std::minmax_element(bridges[bj].j.begin(), bridges[bj].j.end());
+            const int  ib1 = *iRange1.first, ie1 = *iRange1.second;
+            const int  jb1 = *jRange1.first, je1 = *jRange1.second;
+            const int  ib2 = *iRange2.first, ie2 = *iRange2.second;
+            const int  jb2 = *jRange2.first, je2 = *jRange2.second;
+            if (bridges[bi].parallel != bridges[bj].parallel
+                || !no_chain_break(breakAfter, std::min(ib1, ib2), std::max(ie1, ie2))
+                || ib2 - ie1 >= 6 || (ie1 >= ib2 && ib1 <= ie2))
+            {
+                bj++;
+                continue;
+            }
+            bool bulge;
+            if (bridges[bi].parallel)
+            {
+                bulge = (jb2 - je1 < 6 && ib2 - ie1 < 3) || (jb2 - je1 < 3);
+            }
+            else
+            {
+                bulge = (jb1 - je2 < 6 && ib2 - ie1 < 3) || (jb1 - je2 < 3);
+            }
+            if (bulge)
+            {
+                bridges[bi].i.insert(bridges[bi].i.end(), bridges[bj].i.begin(), bridges[bj].i.end());
+                bridges[bi].j.insert(bridges[bi].j.end(), bridges[bj].j.begin(), bridges[bj].j.end());
+                bridges.erase(bridges.begin() + bj);
+                /* The merged ladder can link to earlier skipped ones */
+                bj = bi + 1;
+            }
+            else
+            {
+                bj++;
+            }
+        }
+    }
+
+    /* An isolated bridge gives B, a ladder gives E on both strands,
+     * including any bulge residues in between */
+    for (const SsBridge& bridge : bridges)
+    {
+        const char code = (bridge.i.size() > 1) ? 'E' : 'B';
+        for (const std::vector<int>* strand : { &bridge.i, &bridge.j })
+        {
+            const auto range = std::minmax_element(strand->begin(), strand->end());
+            for (int r = *range.first; r <= *range.second; r++)
+            {
+                if (ss[r] != 'E')
+                {
+                    ss[r] = code;
+                }
+            }
+        }
+    }
+
+    /* Alpha helices: two consecutive i -> i+4 turns make residues
+     * i..i+3 helical; the alpha helix takes precedence over strands */
+    for (int r = 1; r < nres; r++)
+    {
+        if (isTurnStart(r, 4) && isTurnStart(r - 1, 4))
+        {
+            for (int k = r; k <= r + 3; k++)
+            {
+                ss[k] = 'H';
+            }
+        }
+    }
+    /* 3-10 and pi helices only claim residues that are still unassigned */
+    for (int r = 1; r < nres; r++)
+    {
+        if (isTurnStart(r, 3) && isTurnStart(r - 1, 3))
+        {
+            bool empty = true;
+            for (int k = r; k <= r + 2; k++)
+            {
+                empty = empty && (ss[k] == '~' || ss[k] == 'G');
+            }
+            if (empty)
+            {
+                for (int k = r; k <= r + 2; k++)
+                {
+                    ss[k] = 'G';
+                }
+            }
+        }
+    }
+    for (int r = 1; r < nres; r++)
+    {
+        if (isTurnStart(r, 5) && isTurnStart(r - 1, 5))
+        {
+            bool empty = true;
+            for (int k = r; k <= r + 4; k++)
+            {
+                empty = empty && (ss[k] == '~' || ss[k] == 'I');
+            }
+            if (empty)
+            {
+                for (int k = r; k <= r + 4; k++)
+                {
+                    ss[k] = 'I';
+                }
+            }
+        }
+    }
+
+    /* Turns and bends for the remaining residues */
+    for (int r = 0; r < nres; r++)
+    {
+        if (ss[r] != '~')
+        {
+            continue;
+        }
+        bool isTurn = false;
+        for (int n = 3; n <= 5 && !isTurn; n++)
+        {
+            for (int k = 1; k < n && !isTurn; k++)
+            {
+                isTurn = isTurnStart(r - k, n);
+            }
+        }
+        if (isTurn)
+        {
+            ss[r] = 'T';
+        }
+        else if (r >= 2 && r + 2 < nres && residues[r - 2].bComplete && residues[r + 2].bComplete
+                 && residues[r].bComplete && no_chain_break(breakAfter, r - 2, r + 2))
+        {
+            rvec v1, v2;
+            rvec_sub(x[residues[r].atomCA], x[residues[r - 2].atomCA], v1);
+            rvec_sub(x[residues[r + 2].atomCA], x[residues[r].atomCA], v2);
+            if (gmx_angle(v1, v2) > c_ssBendAngle * DEG2RAD)
+            {
+                ss[r] = 'S';
+            }
+        }
+    }
+
+    /* Insert the chain separator lines, like the dssp output has */
+    std::vector<char> ssbuf;
+    for (int r = 0; r < nres; r++)
+    {
+        ssbuf.push_back(ss[r]);
+        if (r + 1 < nres && breakAfter[r])
+        {
+            ssbuf.push_back('=');
+        }
+    }
+    ss_matrix_add_frame(mat, ssbuf.data(), ssbuf.size(), t, oenv);
+
+    return ssbuf.size();
+}
+
 static void norm_acc(t_atoms* atoms, int nres, const real av_area[], real norm_av_area[])
 {
     int i, n, n_surf;
@@ -470,8 +982,15 @@ int gmx_do_dssp(int argc, char* argv[])
     const char* desc[] = {
         "[THISMODULE] ",
         "reads a trajectory file and computes the secondary structure for",
-        "each time frame ",
-        "calling the dssp program. If you do not have the dssp program,",
+        "each time frame, using the hydrogen-bond criteria and structure",
+        "definitions of Kabsch and Sander, as implemented in the dssp program.",
+        "By default the assignment is done by a built-in implementation that",
+        "operates directly on the trajectory frames in memory, which is much",
+        "faster than calling an external program.[PAR]",
+        "With [TT]-xdssp[tt], or when solvent accessible surface output is",
+        "requested (which the built-in implementation does not provide),",
+        "the external dssp program is called for every frame instead.",
+        "If you do not have the dssp program,",
         "get it from http://swift.cmbi.ru.nl/gv/dssp. [THISMODULE] assumes ",
         "that the dssp executable is located in ",
         "[TT]/usr/local/bin/dssp[tt]. If this is not the case, then you should",
@@ -504,11 +1023,17 @@ int gmx_do_dssp(int argc, char* argv[])
         "function of secondary structure type."
     };
     static gmx_bool    bVerbose;
+    static gmx_bool    bCallDssp   = FALSE;
     static const char* ss_string   = "HEBT";
     static int         dsspVersion = 2;
     t_pargs            pa[]        = {
         { "-v", FALSE, etBOOL, { &bVerbose }, "HIDDENGenerate miles of useless information" },
         { "-sss", FALSE, etSTR, { &ss_string }, "Secondary structures for structure count" },
+        { "-xdssp",
+          FALSE,
+          etBOOL,
+          { &bCallDssp },
+          "Call the external dssp program instead of using the built-in implementation" },
         { "-ver",
           FALSE,
           etINT,
@@ -561,6 +1086,14 @@ int gmx_do_dssp(int argc, char* argv[])
     fnTArea    = opt2fn_null("-ta", NFILE, fnm);
     fnAArea    = opt2fn_null("-aa", NFILE, fnm);
     bDoAccSurf = ((fnArea != nullptr) || (fnTArea != nullptr) || (fnAArea != nullptr));
+    if (bDoAccSurf && !bCallDssp)
+    {
+        fprintf(stderr,
+                "Note: solvent accessible surface output was requested, which the built-in\n"
+                "secondary-structure implementation does not provide; calling the external\n"
+                "dssp program instead.\n");
+        bCallDssp = TRUE;
+    }
 
     read_tps_conf(ftp2fn(efTPS, NFILE, fnm), &top, &pbcType, &xp, nullptr, box, FALSE);
     atoms = &(top.atoms);
@@ -580,70 +1113,73 @@ int gmx_do_dssp(int argc, char* argv[])
     }
     fprintf(stderr, "There are %d residues in your selected group\n", nres);
 
-    std::strcpy(pdbfile, "ddXXXXXX");
-    gmx_tmpnam(pdbfile);
-    if ((tmpf = fopen(pdbfile, "w")) == nullptr)
+    if (bCallDssp)
     {
-        sprintf(pdbfile, "%ctmp%cfilterXXXXXX", DIR_SEPARATOR, DIR_SEPARATOR);
+        std::strcpy(pdbfile, "ddXXXXXX");
         gmx_tmpnam(pdbfile);
         if ((tmpf = fopen(pdbfile, "w")) == nullptr)
         {
-            gmx_fatal(FARGS, "Can not open tmp file %s", pdbfile);
+            sprintf(pdbfile, "%ctmp%cfilterXXXXXX", DIR_SEPARATOR, DIR_SEPARATOR);
+            gmx_tmpnam(pdbfile);
+            if ((tmpf = fopen(pdbfile, "w")) == nullptr)
+            {
+                gmx_fatal(FARGS, "Can not open tmp file %s", pdbfile);
+            }
         }
-    }
-    fclose(tmpf);
+        fclose(tmpf);
 
-    std::strcpy(tmpfile, "ddXXXXXX");
-    gmx_tmpnam(tmpfile);
-    if ((tmpf = fopen(tmpfile, "w")) == nullptr)
-    {
-        sprintf(tmpfile, "%ctmp%cfilterXXXXXX", DIR_SEPARATOR, DIR_SEPARATOR);
+        std::strcpy(tmpfile, "ddXXXXXX");
         gmx_tmpnam(tmpfile);
         if ((tmpf = fopen(tmpfile, "w")) == nullptr)
         {
-            gmx_fatal(FARGS, "Can not open tmp file %s", tmpfile);
+            sprintf(tmpfile, "%ctmp%cfilterXXXXXX", DIR_SEPARATOR, DIR_SEPARATOR);
+            gmx_tmpnam(tmpfile);
+            if ((tmpf = fopen(tmpfile, "w")) == nullptr)
+            {
+                gmx_fatal(FARGS, "Can not open tmp file %s", tmpfile);
+            }
         }
-    }
-    fclose(tmpf);
+        fclose(tmpf);
 
-    if ((dptr = getenv("DSSP")) == nullptr)
-    {
-        dptr = "/usr/local/bin/dssp";
-    }
-    if (!gmx_fexist(dptr))
-    {
-        gmx_fatal(FARGS, "DSSP executable (%s) does not exist (use setenv DSSP)", dptr);
-    }
-    std::string redirectionString;
-    redirectionString = prepareToRedirectStdout(bVerbose);
-    DsspInputStrings dsspStrings;
-    dsspStrings.dptr    = dptr;
-    dsspStrings.pdbfile = pdbfile;
-    dsspStrings.tmpfile = tmpfile;
-    if (dsspVersion >= 2)
-    {
-        if (dsspVersion > 2)
+        if ((dptr = getenv("DSSP")) == nullptr)
         {
-            printf("\nWARNING: You use DSSP version %d, which is not explicitly\nsupported by "
-                   "do_dssp. Assuming version 2 syntax.\n\n",
-                   dsspVersion);
+            dptr = "/usr/local/bin/dssp";
         }
-
-        printDsspResult(dssp, dsspStrings, redirectionString);
-    }
-    else
-    {
-        if (bDoAccSurf)
+        if (!gmx_fexist(dptr))
         {
-            dsspStrings.dptr.clear();
+            gmx_fatal(FARGS, "DSSP executable (%s) does not exist (use setenv DSSP)", dptr);
+        }
+        std::string redirectionString;
+        redirectionString = prepareToRedirectStdout(bVerbose);
+        DsspInputStrings dsspStrings;
+        dsspStrings.dptr    = dptr;
+        dsspStrings.pdbfile = pdbfile;
+        dsspStrings.tmpfile = tmpfile;
+        if (dsspVersion >= 2)
+        {
+            if (dsspVersion > 2)
+            {
+                printf("\nWARNING: You use DSSP version %d, which is not explicitly\nsupported by "
+                       "do_dssp. Assuming version 2 syntax.\n\n",
+                       dsspVersion);
+            }
+
+            printDsspResult(dssp, dsspStrings, redirectionString);
         }
         else
         {
-            dsspStrings.dptr = "-na";
+            if (bDoAccSurf)
+            {
+                dsspStrings.dptr.clear();
+            }
+            else
+            {
+                dsspStrings.dptr = "-na";
+            }
+            printDsspResult(dssp, dsspStrings, redirectionString);
         }
-        printDsspResult(dssp, dsspStrings, redirectionString);
+        fprintf(stderr, "dssp cmd='%s'\n", dssp);
     }
-    fprintf(stderr, "dssp cmd='%s'\n", dssp);
 
     if (fnTArea)
     {
@@ -674,6 +1210,22 @@ int gmx_do_dssp(int argc, char* argv[])
     accr  = nullptr;
     naccr = 0;
 
+    std::vector<SsResidue>    ssResidues;
+    std::vector<bool>         chainBreakAfter;
+    gmx::AnalysisNeighborhood neighborhood;
+    if (!bCallDssp)
+    {
+        ssResidues = get_ss_residues(atoms, gnx, index);
+        if (std::none_of(ssResidues.begin(), ssResidues.end(),
+                         [](const SsResidue& res) { return res.bComplete; }))
+        {
+            gmx_fatal(FARGS,
+                      "The selected group contains no residue with a complete protein backbone "
+                      "(atoms N, CA, C and O)");
+        }
+        neighborhood.setCutoff(c_ssCaCutoff);
+    }
+
     gpbc = gmx_rmpbc_init(&top.idef, pbcType, natoms);
     do
     {
@@ -688,40 +1240,53 @@ int gmx_do_dssp(int argc, char* argv[])
             }
         }
         gmx_rmpbc(gpbc, natoms, box, x);
-        tapein = gmx_ffopen(pdbfile, "w");
-        write_pdbfile_indexed(tapein, nullptr, atoms, x, pbcType, box, ' ', -1, gnx, index, nullptr, FALSE);
-        gmx_ffclose(tapein);
-        /* strip_dssp returns the number of lines found in the dssp file, i.e.
-         * the number of residues plus the separator lines */
+        if (!bCallDssp)
+        {
+            /* The chain layout determines the separator lines in the matrix
+             * and therefore has to be identical for all frames */
+            if (nframe == 0)
+            {
+                chainBreakAfter = find_chain_breaks(ssResidues, atoms, x);
+            }
+            nres_plus_separators =
+                    assign_ss_frame(ssResidues, chainBreakAfter, x, t, &neighborhood, &mat, oenv);
+        }
+        else
+        {
+            tapein = gmx_ffopen(pdbfile, "w");
+            write_pdbfile_indexed(tapein, nullptr, atoms, x, pbcType, box, ' ', -1, gnx, index,
+                                  nullptr, FALSE);
+            gmx_ffclose(tapein);
 
 #if HAVE_PIPES || GMX_NATIVE_WINDOWS
-        if (nullptr == (tapeout = popen(dssp, "r")))
+            if (nullptr == (tapeout = popen(dssp, "r")))
 #else
-        if (0 != system(dssp) || nullptr == (tapeout = gmx_ffopen(tmpfile, "r")))
+            if (0 != system(dssp) || nullptr == (tapeout = gmx_ffopen(tmpfile, "r")))
 #endif
-        {
-            remove(pdbfile);
-            remove(tmpfile);
-            gmx_fatal(FARGS,
-                      "Failed to execute command: %s\n"
-                      "Try specifying your dssp version with the -ver option.",
-                      dssp);
-        }
-        if (bDoAccSurf)
-        {
-            accr_ptr = accr[nframe];
-        }
-        /* strip_dssp returns the number of lines found in the dssp file, i.e.
-         * the number of residues plus the separator lines */
-        nres_plus_separators =
-                strip_dssp(tapeout, nres, bPhbres, t, accr_ptr, fTArea, &mat, average_area, oenv);
+            {
+                remove(pdbfile);
+                remove(tmpfile);
+                gmx_fatal(FARGS,
+                          "Failed to execute command: %s\n"
+                          "Try specifying your dssp version with the -ver option.",
+                          dssp);
+            }
+            if (bDoAccSurf)
+            {
+                accr_ptr = accr[nframe];
+            }
+            /* strip_dssp returns the number of lines found in the dssp file, i.e.
+             * the number of residues plus the separator lines */
+            nres_plus_separators =
+                    strip_dssp(tapeout, nres, bPhbres, t, accr_ptr, fTArea, &mat, average_area, oenv);
 #if HAVE_PIPES || GMX_NATIVE_WINDOWS
-        pclose(tapeout);
+            pclose(tapeout);
 #else
-        gmx_ffclose(tapeout);
+            gmx_ffclose(tapeout);
 #endif
-        remove(tmpfile);
-        remove(pdbfile);
+            remove(tmpfile);
+            remove(pdbfile);
+        }
         nframe++;
     } while (read_next_x(oenv, status, &t, x, box));
     fprintf(stderr, "\n");
@@ -42,6 +42,7 @@
 #include <cstring>
 
 #include <algorithm>
+#include <memory>
 
 #include "gromacs/commandline/pargs.h"
 #include "gromacs/commandline/viewit.h"
@@ -51,6 +52,7 @@
 #include "gromacs/fileio/tpxio.h"
 #include "gromacs/fileio/trxio.h"
 #include "gromacs/fileio/xvgr.h"
+#include "gromacs/fileio/xvgwriter.h"
 #include "gromacs/gmxana/gmx_ana.h"
 #include "gromacs/gmxana/gstat.h"
 #include "gromacs/math/functions.h"
@@ -478,11 +480,17 @@ static void calc_averages(int nset, enerdata_t* edat, int nbmin, int nbmax)
         }
     }
 
-    snew(eee, nbmax + 1);
+    /* The terms are independent of each other, so spread them over the
+     * OpenMP threads; each term uses its own block error estimate scratch.
+     */
+#pragma omp parallel for schedule(dynamic) default(shared) \
+        private(nb, f, sum, sum2, sump, see2, np, p, bound_nb, ed, es, x, sx, sy, sxx, sxy, eee, nee) \
+        if (nset > 1)
     for (i = 0; i < nset; i++)
     {
         ed = &edat->s[i];
 
+        snew(eee, nbmax + 1);
         sum  = 0;
         sum2 = 0;
         np   = 0;
@@ -613,8 +621,8 @@ static void calc_averages(int nset, enerdata_t* edat, int nbmin, int nbmax)
         {
             edat->s[i].ee = -1;
         }
+        sfree(eee);
     }
-    sfree(eee);
 }
 
 static enerdata_t* calc_sum(int nset, enerdata_t* edat, int nbmin, int nbmax)
@@ -1202,20 +1210,21 @@ static void analyse_ener(gmx_bool                bCorr,
     }
 }
 
-static void print_time(FILE* fp, double t)
+static void print_time(gmx::XvgTableWriter* writer, double t)
 {
-    fprintf(fp, "%12.6f", t);
+    writer->writeValue(t, 12, 6);
 }
 
-static void print1(FILE* fp, gmx_bool bDp, real e)
+static void print1(gmx::XvgTableWriter* writer, gmx_bool bDp, real e)
 {
+    writer->writeText("  ");
     if (bDp)
     {
-        fprintf(fp, "  %16.12f", e);
+        writer->writeValue(e, 16, 12);
     }
     else
     {
-        fprintf(fp, "  %10.6f", e);
+        writer->writeValue(e, 10, 6);
     }
 }
 
@@ -1731,6 +1740,7 @@ int gmx_energy(int argc, char* argv[])
                                    "Pres-ZZ", "Temperature", "Volume",  "Pressure" };
 
     FILE*        out     = nullptr;
+    std::unique_ptr<gmx::XvgTableWriter> tableWriter;
     FILE*        fp_dhdl = nullptr;
     ener_file_t  fp;
     int          timecheck = 0;
@@ -1878,6 +1888,23 @@ int gmx_energy(int argc, char* argv[])
         {
             gmx_fatal(FARGS, "Printing averages can only be done when a single set is selected");
         }
+        /* The headers and legends are written; buffer the data rows */
+        tableWriter = std::make_unique<gmx::XvgTableWriter>(out);
+
+        /* Subscribe to the selected terms, so that do_enx() seeks over all
+         * other terms and the extra data blocks instead of decoding them.
+         */
+        {
+            gmx_bool* bSelectedTerms;
+
+            snew(bSelectedTerms, nre);
+            for (i = 0; i < nset; i++)
+            {
+                bSelectedTerms[set[i]] = TRUE;
+            }
+            set_enx_subscription(fp, nre, bSelectedTerms, FALSE);
+            sfree(bSelectedTerms);
+        }
     }
     else if (bDHDL)
     {
@@ -2039,16 +2066,16 @@ int gmx_energy(int argc, char* argv[])
                          */
                         if (fr->nsum > 1)
                         {
-                            print_time(out, fr->t);
-                            print1(out, bDp, fr->ener[set[0]].e);
-                            print1(out, bDp, fr->ener[set[0]].esum / fr->nsum);
-                            print1(out, bDp, std::sqrt(fr->ener[set[0]].eav / fr->nsum));
-                            fprintf(out, "\n");
+                            print_time(tableWriter.get(), fr->t);
+                            print1(tableWriter.get(), bDp, fr->ener[set[0]].e);
+                            print1(tableWriter.get(), bDp, fr->ener[set[0]].esum / fr->nsum);
+                            print1(tableWriter.get(), bDp, std::sqrt(fr->ener[set[0]].eav / fr->nsum));
+                            tableWriter->finishRow();
                         }
                     }
                     else
                     {
-                        print_time(out, fr->t);
+                        print_time(tableWriter.get(), fr->t);
                         if (bSum)
                         {
                             sum = 0;
@@ -2056,7 +2083,7 @@ int gmx_energy(int argc, char* argv[])
                             {
                                 sum += fr->ener[set[i]].e;
                             }
-                            print1(out, bDp, sum / nmol - ezero);
+                            print1(tableWriter.get(), bDp, sum / nmol - ezero);
                         }
                         else
                         {
@@ -2064,15 +2091,15 @@ int gmx_energy(int argc, char* argv[])
                             {
                                 if (bIsEner[i])
                                 {
-                                    print1(out, bDp, (fr->ener[set[i]].e) / nmol - ezero);
+                                    print1(tableWriter.get(), bDp, (fr->ener[set[i]].e) / nmol - ezero);
                                 }
                                 else
                                 {
-                                    print1(out, bDp, fr->ener[set[i]].e);
+                                    print1(tableWriter.get(), bDp, fr->ener[set[i]].e);
                                 }
                             }
                         }
-                        fprintf(out, "\n");
+                        tableWriter->finishRow();
                     }
                 }
             }
@@ -2083,6 +2110,7 @@ int gmx_energy(int argc, char* argv[])
     done_ener_file(fp);
     if (out)
     {
+        tableWriter.reset();
         xvgrclose(out);
     }
 
@@ -53,6 +53,7 @@
 #include "gromacs/utility/arraysize.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/futil.h"
+#include "gromacs/utility/gmxomp.h"
 #include "gromacs/utility/smalloc.h"
 
 /****************************************************************************/
@@ -80,17 +81,20 @@ static void calc_h2order(const char*             fn,
                          const gmx_output_env_t* oenv)
 {
     rvec *x0,            /* coordinates with pbc */
-            dipole,      /* dipole moment due to one molecules */
             normal, com; /* center of mass of micel, with bMicel */
-    rvec*        dip;    /* sum of dipoles, unnormalized */
+    rvec *dip,           /* sum of dipoles, unnormalized */
+            *dipTh;      /* per-thread partials of dip */
     matrix       box;    /* box (3x3) */
     t_trxstatus* status;
     real         t,                      /* time from trajectory */
             *sum,                        /* sum of all cosines of dipoles, per slice */
-            *frame;                      /* order over one frame */
+            *frame,                      /* order over one frame */
+            *sumTh, *frameTh;            /* per-thread partials of sum and frame */
     int natoms,                          /* nr. atoms in trj */
             i, j, teller = 0, slice = 0, /* current slice number */
-            *count;                      /* nr. of atoms in one slice */
+            *count,                      /* nr. of atoms in one slice */
+            *countTh,                    /* per-thread partials of count */
+            nth;                         /* number of OpenMP threads */
     gmx_rmpbc_t gpbc = nullptr;
 
     if ((natoms = read_first_x(oenv, &status, fn, &t, &x0, box)) == 0)
@@ -122,11 +126,15 @@ static void calc_h2order(const char*             fn,
         default: gmx_fatal(FARGS, "No valid value for -axis-. Exiting.\n");
     }
 
-    clear_rvec(dipole);
+    nth = gmx_omp_get_max_threads();
     snew(count, *nslices);
     snew(sum, *nslices);
     snew(dip, *nslices);
     snew(frame, *nslices);
+    snew(countTh, nth * (*nslices));
+    snew(sumTh, nth * (*nslices));
+    snew(frameTh, nth * (*nslices));
+    snew(dipTh, nth * (*nslices));
 
     *slWidth = box[axis][axis] / (*nslices);
     fprintf(stderr, "Box divided in %d slices. Initial width of slice: %f\n", *nslices, *slWidth);
@@ -147,65 +155,81 @@ static void calc_h2order(const char*             fn,
             calc_xcm(x0, nmic, micel, top->atoms.atom, com, FALSE);
         }
 
-        for (i = 0; i < ngx / 3; i++)
+        /* Each water is assigned to a slice independently of the others, so
+         * the loop can run over all threads; every thread accumulates into
+         * its own slab arrays, which are merged after the last frame.
+         */
+#pragma omp parallel num_threads(nth) private(i, j, slice)
         {
-            /* put all waters in box */
-            for (j = 0; j < DIM; j++)
+            int   tid     = gmx_omp_get_thread_num();
+            int*  myCount = countTh + tid * (*nslices);
+            real* mySum   = sumTh + tid * (*nslices);
+            real* myFrame = frameTh + tid * (*nslices);
+            rvec* myDip   = dipTh + tid * (*nslices);
+
+#pragma omp for schedule(static)
+            for (i = 0; i < ngx / 3; i++)
             {
-                if (x0[index[3 * i]][j] < 0)
+                rvec dipole, radial;
+
+                /* put all waters in box */
+                for (j = 0; j < DIM; j++)
                 {
-                    x0[index[3 * i]][j] += box[j][j];
-                    x0[index[3 * i + 1]][j] += box[j][j];
-                    x0[index[3 * i + 2]][j] += box[j][j];
+                    if (x0[index[3 * i]][j] < 0)
+                    {
+                        x0[index[3 * i]][j] += box[j][j];
+                        x0[index[3 * i + 1]][j] += box[j][j];
+                        x0[index[3 * i + 2]][j] += box[j][j];
+                    }
+                    if (x0[index[3 * i]][j] > box[j][j])
+                    {
+                        x0[index[3 * i]][j] -= box[j][j];
+                        x0[index[3 * i + 1]][j] -= box[j][j];
+                        x0[index[3 * i + 2]][j] -= box[j][j];
+                    }
                 }
-                if (x0[index[3 * i]][j] > box[j][j])
+
+                for (j = 0; j < DIM; j++)
                 {
-                    x0[index[3 * i]][j] -= box[j][j];
-                    x0[index[3 * i + 1]][j] -= box[j][j];
-                    x0[index[3 * i + 2]][j] -= box[j][j];
+                    dipole[j] = x0[index[3 * i]][j] * top->atoms.atom[index[3 * i]].q
+                                + x0[index[3 * i + 1]][j] * top->atoms.atom[index[3 * i + 1]].q
+                                + x0[index[3 * i + 2]][j] * top->atoms.atom[index[3 * i + 2]].q;
                 }
-            }
-
-            for (j = 0; j < DIM; j++)
-            {
-                dipole[j] = x0[index[3 * i]][j] * top->atoms.atom[index[3 * i]].q
-                            + x0[index[3 * i + 1]][j] * top->atoms.atom[index[3 * i + 1]].q
-                            + x0[index[3 * i + 2]][j] * top->atoms.atom[index[3 * i + 2]].q;
-            }
 
-            /* now we have a dipole vector. Might as well safe it. Then the
-               rest depends on whether we're dealing with
-               a flat or a spherical interface.
-             */
+                /* now we have a dipole vector. Might as well safe it. Then the
+                   rest depends on whether we're dealing with
+                   a flat or a spherical interface.
+                 */
 
-            if (bMicel)
-            {                                            /* this is for spherical interfaces */
-                rvec_sub(com, x0[index[3 * i]], normal); /* vector from Oxygen to COM */
-                slice = static_cast<int>(norm(normal) / (*slWidth)); /* spherical slice           */
+                if (bMicel)
+                {                                            /* this is for spherical interfaces */
+                    rvec_sub(com, x0[index[3 * i]], radial); /* vector from Oxygen to COM */
+                    slice = static_cast<int>(norm(radial) / (*slWidth)); /* spherical slice */
 
-                sum[slice] += iprod(dipole, normal) / (norm(dipole) * norm(normal));
-                frame[slice] += iprod(dipole, normal) / (norm(dipole) * norm(normal));
-                count[slice]++;
-            }
-            else
-            {
-                /* this is for flat interfaces      */
-
-                /* determine which slice atom is in */
-                slice = static_cast<int>(x0[index[3 * i]][axis] / (*slWidth));
-                if (slice < 0 || slice >= *nslices)
-                {
-                    fprintf(stderr, "Coordinate: %f ", x0[index[3 * i]][axis]);
-                    fprintf(stderr, "HELP PANIC! slice = %d, OUT OF RANGE!\n", slice);
+                    mySum[slice] += iprod(dipole, radial) / (norm(dipole) * norm(radial));
+                    myFrame[slice] += iprod(dipole, radial) / (norm(dipole) * norm(radial));
+                    myCount[slice]++;
                 }
                 else
                 {
-                    rvec_add(dipole, dip[slice], dip[slice]);
-                    /* Add dipole to total. mag[slice] is total dipole in axis direction */
-                    sum[slice] += iprod(dipole, normal) / norm(dipole);
-                    frame[slice] += iprod(dipole, normal) / norm(dipole);
-                    /* increase count for that slice */
-                    count[slice]++;
+                    /* this is for flat interfaces      */
+
+                    /* determine which slice atom is in */
+                    slice = static_cast<int>(x0[index[3 * i]][axis] / (*slWidth));
+                    if (slice < 0 || slice >= *nslices)
+                    {
+                        fprintf(stderr, "Coordinate: %f ", x0[index[3 * i]][axis]);
+                        fprintf(stderr, "HELP PANIC! slice = %d, OUT OF RANGE!\n", slice);
+                    }
+                    else
+                    {
+                        rvec_inc(myDip[slice], dipole);
+                        /* Add dipole to total. mag[slice] is total dipole in axis direction */
+                        mySum[slice] += iprod(dipole, normal) / norm(dipole);
+                        myFrame[slice] += iprod(dipole, normal) / norm(dipole);
+                        /* increase count for that slice */
+                        myCount[slice]++;
+                    }
                 }
             }
         }
@@ -216,6 +240,22 @@ static void calc_h2order(const char*             fn,
     fprintf(stderr, "\nRead trajectory. Printing parameters to file\n");
     gmx_rmpbc_done(gpbc);
 
+    /* merge the per-thread partial slabs */
+    for (j = 0; j < nth; j++)
+    {
+        for (i = 0; i < *nslices; i++)
+        {
+            count[i] += countTh[j * (*nslices) + i];
+            sum[i] += sumTh[j * (*nslices) + i];
+            frame[i] += frameTh[j * (*nslices) + i];
+            rvec_inc(dip[i], dipTh[j * (*nslices) + i]);
+        }
+    }
+    sfree(countTh);
+    sfree(sumTh);
+    sfree(frameTh);
+    sfree(dipTh);
+
     for (i = 0; i < *nslices; i++) /* average over frames */
     {
         fprintf(stderr, "%d waters in slice %d\n", count[i], i);
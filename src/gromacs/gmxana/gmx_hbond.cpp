@@ -1975,31 +1975,18 @@ static void do_hbac(const char*             fn,
 
     const char* legLuzar[] = { "Ac\\sfin sys\\v{}\\z{}(t)", "Ac(t)", "Cc\\scontact,hb\\v{}\\z{}(t)",
                                "-dAc\\sfs\\v{}\\z{}/dt" };
-    gmx_bool    bNorm      = FALSE;
-    double      nhb        = 0;
-    real *      rhbex      = nullptr, *ht, *gt, *ght, *dght, *kt;
-    real *      ct, tail, tail2, dtail, *cct;
-    const real  tol     = 1e-3;
-    int         nframes = hb->nframes;
-    unsigned int **h = nullptr, **g = nullptr;
-    int            nh, nhbonds, nhydro;
-    t_hbond*       hbh;
-    int            acType;
-    int*           dondata = nullptr;
-
-    enum
-    {
-        AC_NONE,
-        AC_NN,
-        AC_GEM,
-        AC_LUZAR
-    };
+    gmx_bool   bNorm = FALSE;
+    double     nhb   = 0;
+    real *     ght, *kt;
+    real *     ct, tail, tail2, dtail, *cct;
+    const real tol     = 1e-3;
+    int        nframes = hb->nframes;
+    int        nhbonds;
 
     const bool bOMP = GMX_OPENMP;
 
     printf("Doing autocorrelation ");
 
-    acType = AC_LUZAR;
     printf("according to the theory of Luzar and Chandler.\n");
     fflush(stdout);
 
@@ -2013,149 +2000,161 @@ static void do_hbac(const char*             fn,
 
     nn = nframes / 2;
 
-    if (acType != AC_NN || bOMP)
-    {
-        snew(h, hb->maxhydro);
-        snew(g, hb->maxhydro);
-    }
-
     /* Dump hbonds for debugging */
     dump_ac(hb, bMerge || bContact, nDump);
 
     /* Total number of hbonds analyzed here */
     nhbonds = 0;
 
-    if (acType != AC_LUZAR && bOMP)
+    if (bOMP)
     {
         nThreads = std::min((nThreads <= 0) ? INT_MAX : nThreads, gmx_omp_get_max_threads());
-
         gmx_omp_set_num_threads(nThreads);
-        snew(dondata, nThreads);
-        for (i = 0; i < nThreads; i++)
-        {
-            dondata[i] = -1;
-        }
         printf("ACF calculations parallelized with OpenMP using %i threads.\n"
-               "Expect close to linear scaling over this donor-loop.\n",
+               "Expect close to linear scaling over the donor loop.\n",
                nThreads);
         fflush(stdout);
-        fprintf(stderr, "Donors: [thread no]\n");
-        {
-            char tmpstr[7];
-            for (i = 0; i < nThreads; i++)
-            {
-                snprintf(tmpstr, 7, "[%i]", i);
-                fprintf(stderr, "%-7s", tmpstr);
-            }
-        }
-        fprintf(stderr, "\n");
     }
 
-
     /* Build the ACF */
-    snew(rhbex, 2 * n2);
     snew(ct, 2 * n2);
-    snew(gt, 2 * n2);
-    snew(ht, 2 * n2);
     snew(ght, 2 * n2);
-    snew(dght, 2 * n2);
-
     snew(kt, nn);
     snew(cct, nn);
 
-    for (i = 0; (i < hb->d.nrd); i++)
+    /* Each thread accumulates the ACF for a subset of the donors into local
+     * arrays that are summed into ct and ght at the end; the expensive
+     * autocorrelation of the individual existence functions is independent
+     * between donor-acceptor pairs.
+     */
+#pragma omp parallel default(shared) private(i, j, k, m, ihb, idist) reduction(+ : nhb) if (bOMP)
     {
-        for (k = 0; (k < hb->a.nra); k++)
-        {
-            nhydro = 0;
-            hbh    = hb->hbmap[i][k];
+        unsigned int **h, **g;
+        real *         rhbex, *ht, *gt, *dght;
+        real *         ctLocal, *ghtLocal;
 
-            if (hbh)
+        snew(h, hb->maxhydro);
+        snew(g, hb->maxhydro);
+        snew(rhbex, 2 * n2);
+        snew(gt, 2 * n2);
+        snew(ht, 2 * n2);
+        snew(dght, 2 * n2);
+        snew(ctLocal, nn);
+        snew(ghtLocal, nn);
+
+#pragma omp for schedule(dynamic)
+        for (i = 0; i < hb->d.nrd; i++)
+        {
+            for (k = 0; (k < hb->a.nra); k++)
             {
-                if (bMerge || bContact)
+                int      nhydro = 0;
+                t_hbond* hbh    = hb->hbmap[i][k];
+
+                if (hbh)
                 {
-                    if (ISHB(hbh->history[0]))
+                    if (bMerge || bContact)
                     {
-                        h[0]   = hbh->h[0];
-                        g[0]   = hbh->g[0];
-                        nhydro = 1;
+                        if (ISHB(hbh->history[0]))
+                        {
+                            h[0]   = hbh->h[0];
+                            g[0]   = hbh->g[0];
+                            nhydro = 1;
+                        }
                     }
-                }
-                else
-                {
-                    for (m = 0; (m < hb->maxhydro); m++)
+                    else
                     {
-                        if (bContact ? ISDIST(hbh->history[m]) : ISHB(hbh->history[m]))
+                        for (m = 0; (m < hb->maxhydro); m++)
                         {
-                            g[nhydro] = hbh->g[m];
-                            h[nhydro] = hbh->h[m];
-                            nhydro++;
+                            if (bContact ? ISDIST(hbh->history[m]) : ISHB(hbh->history[m]))
+                            {
+                                g[nhydro] = hbh->g[m];
+                                h[nhydro] = hbh->h[m];
+                                nhydro++;
+                            }
                         }
                     }
-                }
 
-                int nf = hbh->nframes;
-                for (nh = 0; (nh < nhydro); nh++)
-                {
-                    int nrint = bContact ? hb->nrdist : hb->nrhb;
-                    if ((((nhbonds + 1) % 10) == 0) || (nhbonds + 1 == nrint))
+                    int nf = hbh->nframes;
+                    for (int nh = 0; (nh < nhydro); nh++)
                     {
-                        fprintf(stderr, "\rACF %d/%d", nhbonds + 1, nrint);
-                        fflush(stderr);
-                    }
-                    nhbonds++;
-                    for (j = 0; (j < nframes); j++)
-                    {
-                        if (j <= nf)
-                        {
-                            ihb   = static_cast<int>(is_hb(h[nh], j));
-                            idist = static_cast<int>(is_hb(g[nh], j));
-                        }
-                        else
+                        int nrint = bContact ? hb->nrdist : hb->nrhb;
+                        int nDone;
+#pragma omp critical
                         {
-                            ihb = idist = 0;
+                            nDone = ++nhbonds;
                         }
-                        rhbex[j] = ihb;
-                        /* For contacts: if a second cut-off is provided, use it,
-                         * otherwise use g(t) = 1-h(t) */
-                        if (!R2 && bContact)
+                        if (((nDone % 10) == 0) || (nDone == nrint))
                         {
-                            gt[j] = 1 - ihb;
+                            fprintf(stderr, "\rACF %d/%d", nDone, nrint);
+                            fflush(stderr);
                         }
-                        else
+                        for (j = 0; (j < nframes); j++)
                         {
-                            gt[j] = idist * (1 - ihb);
+                            if (j <= nf)
+                            {
+                                ihb   = static_cast<int>(is_hb(h[nh], j));
+                                idist = static_cast<int>(is_hb(g[nh], j));
+                            }
+                            else
+                            {
+                                ihb = idist = 0;
+                            }
+                            rhbex[j] = ihb;
+                            /* For contacts: if a second cut-off is provided, use it,
+                             * otherwise use g(t) = 1-h(t) */
+                            if (!R2 && bContact)
+                            {
+                                gt[j] = 1 - ihb;
+                            }
+                            else
+                            {
+                                gt[j] = idist * (1 - ihb);
+                            }
+                            ht[j] = rhbex[j];
+                            nhb += ihb;
                         }
-                        ht[j] = rhbex[j];
-                        nhb += ihb;
-                    }
 
-                    /* The autocorrelation function is normalized after summation only */
-                    low_do_autocorr(nullptr, oenv, nullptr, nframes, 1, -1, &rhbex,
-                                    hb->time[1] - hb->time[0], eacNormal, 1, FALSE, bNorm, FALSE, 0,
-                                    -1, 0);
+                        /* The autocorrelation function is normalized after summation only */
+                        low_do_autocorr(nullptr, oenv, nullptr, nframes, 1, -1, &rhbex,
+                                        hb->time[1] - hb->time[0], eacNormal, 1, FALSE, bNorm,
+                                        FALSE, 0, -1, 0);
 
-                    /* Cross correlation analysis for thermodynamics */
-                    for (j = nframes; (j < n2); j++)
-                    {
-                        ht[j] = 0;
-                        gt[j] = 0;
-                    }
+                        /* Cross correlation analysis for thermodynamics */
+                        for (j = nframes; (j < n2); j++)
+                        {
+                            ht[j] = 0;
+                            gt[j] = 0;
+                        }
 
-                    cross_corr(n2, ht, gt, dght);
+                        cross_corr(n2, ht, gt, dght);
 
-                    for (j = 0; (j < nn); j++)
-                    {
-                        ct[j] += rhbex[j];
-                        ght[j] += dght[j];
+                        for (j = 0; (j < nn); j++)
+                        {
+                            ctLocal[j] += rhbex[j];
+                            ghtLocal[j] += dght[j];
+                        }
                     }
                 }
             }
         }
+#pragma omp critical
+        {
+            for (j = 0; j < nn; j++)
+            {
+                ct[j] += ctLocal[j];
+                ght[j] += ghtLocal[j];
+            }
+        }
+        sfree(ghtLocal);
+        sfree(ctLocal);
+        sfree(dght);
+        sfree(ht);
+        sfree(gt);
+        sfree(rhbex);
+        sfree(g);
+        sfree(h);
     }
     fprintf(stderr, "\n");
-    sfree(h);
-    sfree(g);
     normalizeACF(ct, ght, static_cast<int>(nhb), nn);
 
     /* Determine tail value for statistics */
@@ -2212,12 +2211,8 @@ static void do_hbac(const char*             fn,
     analyse_corr(nn, hb->time, ct, ght, kt, nullptr, nullptr, nullptr, fit_start, temp);
 
     do_view(oenv, fn, nullptr);
-    sfree(rhbex);
     sfree(ct);
-    sfree(gt);
-    sfree(ht);
     sfree(ght);
-    sfree(dght);
     sfree(cct);
     sfree(kt);
 }
@@ -190,13 +190,18 @@ int gmx_mdmat(int argc, char* argv[])
         "trajectory is output.",
         "Also a count of the number of different atomic contacts between",
         "residues over the whole trajectory can be made.",
-        "The output can be processed with [gmx-xpm2ps] to make a PostScript (tm) plot."
+        "The output can be processed with [gmx-xpm2ps] to make a PostScript (tm) plot.[PAR]",
+        "With [TT]-binmat[tt] the matrices are written in a compact binary format",
+        "instead of text [REF].xpm[ref], which is much smaller and faster to write",
+        "for long trajectories. [gmx-xpm2ps] reads both formats."
     };
-    static real truncate = 1.5;
-    static int  nlevels  = 40;
-    t_pargs     pa[]     = {
+    static real     truncate = 1.5;
+    static int      nlevels  = 40;
+    static gmx_bool bBinary  = FALSE;
+    t_pargs         pa[]     = {
         { "-t", FALSE, etREAL, { &truncate }, "trunc distance" },
-        { "-nlevels", FALSE, etINT, { &nlevels }, "Discretize distance in this number of levels" }
+        { "-nlevels", FALSE, etINT, { &nlevels }, "Discretize distance in this number of levels" },
+        { "-binmat", FALSE, etBOOL, { &bBinary }, "Write the matrices in the compact binary format" }
     };
     t_filenm fnm[] = {
         { efTRX, "-f", nullptr, ffREAD },     { efTPS, nullptr, nullptr, ffREAD },
@@ -344,8 +349,18 @@ int gmx_mdmat(int argc, char* argv[])
         if (bFrames)
         {
             sprintf(label, "t=%.0f ps", t);
-            write_xpm(out, 0, label, "Distance (nm)", "Residue Index", "Residue Index", nres, nres,
-                      resnr, resnr, mdmat, 0, truncate, rlo, rhi, &nlevels);
+            if (bBinary)
+            {
+                t_matrix m = real2matrix(0, label, "Distance (nm)", "Residue Index",
+                                         "Residue Index", nres, nres, resnr, resnr, mdmat, 0,
+                                         truncate, rlo, rhi, &nlevels);
+                write_binary_matrix(out, m);
+            }
+            else
+            {
+                write_xpm(out, 0, label, "Distance (nm)", "Residue Index", "Residue Index", nres,
+                          nres, resnr, resnr, mdmat, 0, truncate, rlo, rhi, &nlevels);
+            }
         }
     } while (read_next_x(oenv, status, &t, x, box));
     fprintf(stderr, "\n");
@@ -365,9 +380,21 @@ int gmx_mdmat(int argc, char* argv[])
             totmdmat[i][j] /= nframes;
         }
     }
-    write_xpm(opt2FILE("-mean", NFILE, fnm, "w"), 0, "Mean smallest distance", "Distance (nm)",
-              "Residue Index", "Residue Index", nres, nres, resnr, resnr, totmdmat, 0, truncate,
-              rlo, rhi, &nlevels);
+    if (bBinary)
+    {
+        t_matrix m = real2matrix(0, "Mean smallest distance", "Distance (nm)", "Residue Index",
+                                 "Residue Index", nres, nres, resnr, resnr, totmdmat, 0, truncate,
+                                 rlo, rhi, &nlevels);
+        fp = opt2FILE("-mean", NFILE, fnm, "w");
+        write_binary_matrix(fp, m);
+        gmx_ffclose(fp);
+    }
+    else
+    {
+        write_xpm(opt2FILE("-mean", NFILE, fnm, "w"), 0, "Mean smallest distance", "Distance (nm)",
+                  "Residue Index", "Residue Index", nres, nres, resnr, resnr, totmdmat, 0, truncate,
+                  rlo, rhi, &nlevels);
+    }
 
     if (bCalcN)
     {
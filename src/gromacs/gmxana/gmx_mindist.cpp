@@ -216,24 +216,66 @@ static void periodic_mindist_plot(const char*             trxfn,
             index[ind_mini] + 1, index[ind_minj] + 1);
 }
 
-static void calc_dist(real     rcut,
-                      gmx_bool bPBC,
-                      PbcType  pbcType,
-                      matrix   box,
-                      rvec     x[],
-                      int      nx1,
-                      int      nx2,
-                      int      index1[],
-                      int      index2[],
-                      gmx_bool bGroup,
-                      real*    rmin,
-                      real*    rmax,
-                      int*     nmin,
-                      int*     nmax,
-                      int*     ixmin,
-                      int*     jxmin,
-                      int*     ixmax,
-                      int*     jxmax)
+/* Cache of the near-cutoff pairs of one group pair, so that frames with
+ * small atomic displacements can be processed without a full group against
+ * group distance scan (Verlet-list style). Pairs within rlist at the last
+ * full scan are kept together with the positions of both groups at that
+ * scan; as long as the summed maximum displacement of the two groups stays
+ * below rlist - rcut, pairs outside the cache are guaranteed to still be
+ * beyond the cutoff.
+ */
+typedef struct {
+    gmx_bool bValid;      /* cache holds pairs from a full scan           */
+    real     rlist;       /* pairs within this radius at the scan are kept */
+    int      npair;       /* number of cached pairs                       */
+    int      npair_alloc; /* allocation size of pairs                     */
+    int*     pairs;       /* cached pairs as (i,j) atom index tuples      */
+    rvec*    xref1;       /* group 1 positions at the last full scan      */
+    rvec*    xref2;       /* group 2 positions at the last full scan      */
+} t_distcache;
+
+/* Returns the maximum displacement of the indexed atoms relative to the
+ * reference positions stored at the last full scan. */
+static real max_drift(const t_pbc* pbc, rvec x[], int n, const int index[], rvec xref[])
+{
+    rvec dx;
+    real maxd2 = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        if (pbc)
+        {
+            pbc_dx(pbc, x[index[i]], xref[i], dx);
+        }
+        else
+        {
+            rvec_sub(x[index[i]], xref[i], dx);
+        }
+        maxd2 = std::max(maxd2, iprod(dx, dx));
+    }
+
+    return std::sqrt(maxd2);
+}
+
+static void calc_dist(real         rcut,
+                      gmx_bool     bPBC,
+                      PbcType      pbcType,
+                      matrix       box,
+                      rvec         x[],
+                      int          nx1,
+                      int          nx2,
+                      int          index1[],
+                      int          index2[],
+                      gmx_bool     bGroup,
+                      real*        rmin,
+                      real*        rmax,
+                      int*         nmin,
+                      int*         nmax,
+                      int*         ixmin,
+                      int*         jxmin,
+                      int*         ixmax,
+                      int*         jxmax,
+                      t_distcache* cache)
 {
     int   i, j, i0 = 0, j1;
     int   ix, jx;
@@ -270,6 +312,90 @@ static void calc_dist(real     rcut,
     }
     GMX_RELEASE_ASSERT(index1 != nullptr, "Need a valid index for plotting distances");
 
+    if (cache != nullptr && cache->bValid)
+    {
+        /* With small enough displacements since the last full scan, pairs
+         * outside the cache are still beyond the cutoff, so the contact
+         * count and (as long as it stays within the validity radius) the
+         * minimum distance only need the cached pairs. The maximum
+         * distance outputs are not maintained here; the cache is only
+         * used when they are not requested.
+         */
+        real maxdrift = max_drift(bPBC ? &pbc : nullptr, x, nx1, index1, cache->xref1);
+        if (index2)
+        {
+            maxdrift += max_drift(bPBC ? &pbc : nullptr, x, j1, index3, cache->xref2);
+        }
+        else
+        {
+            /* Within one group both pair atoms can move */
+            maxdrift *= 2;
+        }
+        if (maxdrift < cache->rlist - rcut)
+        {
+            int lastj  = -1;
+            int nmin_c = 0;
+            rmin2      = 1e12;
+            for (int k = 0; k < cache->npair; k++)
+            {
+                ix = cache->pairs[2 * k];
+                jx = cache->pairs[2 * k + 1];
+                if (bPBC)
+                {
+                    pbc_dx(&pbc, x[ix], x[jx], dx);
+                }
+                else
+                {
+                    rvec_sub(x[ix], x[jx], dx);
+                }
+                r2 = iprod(dx, dx);
+                if (r2 < rmin2)
+                {
+                    rmin2  = r2;
+                    *ixmin = ix;
+                    *jxmin = jx;
+                }
+                if (r2 <= rcut2)
+                {
+                    if (bGroup)
+                    {
+                        /* The pairs are stored with the j loop outermost,
+                         * so each j atom forms one consecutive run */
+                        if (jx != lastj)
+                        {
+                            nmin_c++;
+                            lastj = jx;
+                        }
+                    }
+                    else
+                    {
+                        nmin_c++;
+                    }
+                }
+            }
+            /* The true minimum is only guaranteed to be a cached pair
+             * when it lies within the validity radius; otherwise fall
+             * through to a full scan.
+             */
+            if (std::sqrt(rmin2) < cache->rlist - maxdrift)
+            {
+                *rmin = std::sqrt(rmin2);
+                *rmax = 0;
+                *nmin = nmin_c;
+                return;
+            }
+        }
+    }
+
+    real rlist2 = 0;
+    if (cache != nullptr)
+    {
+        /* Keep a quarter of the cutoff as displacement margin */
+        cache->rlist = 1.25 * rcut;
+        rlist2       = gmx::square(cache->rlist);
+        cache->npair = 0;
+    }
+
     rmin2 = 1e12;
     rmax2 = -1e12;
 
@@ -316,6 +442,17 @@ static void calc_dist(real     rcut,
                 {
                     nmax_j++;
                 }
+                if (cache != nullptr && r2 < rlist2)
+                {
+                    if (2 * (cache->npair + 1) > cache->npair_alloc)
+                    {
+                        cache->npair_alloc = std::max(64, 2 * cache->npair_alloc);
+                        srenew(cache->pairs, cache->npair_alloc);
+                    }
+                    cache->pairs[2 * cache->npair]     = ix;
+                    cache->pairs[2 * cache->npair + 1] = jx;
+                    cache->npair++;
+                }
             }
         }
         if (bGroup)
@@ -335,6 +472,29 @@ static void calc_dist(real     rcut,
             *nmax += nmax_j;
         }
     }
+    if (cache != nullptr)
+    {
+        if (cache->xref1 == nullptr)
+        {
+            snew(cache->xref1, nx1);
+            if (index2)
+            {
+                snew(cache->xref2, j1);
+            }
+        }
+        for (i = 0; i < nx1; i++)
+        {
+            copy_rvec(x[index1[i]], cache->xref1[i]);
+        }
+        if (index2)
+        {
+            for (j = 0; j < j1; j++)
+            {
+                copy_rvec(x[index3[j]], cache->xref2[j]);
+            }
+        }
+        cache->bValid = TRUE;
+    }
     *rmin = std::sqrt(rmin2);
     *rmax = std::sqrt(rmax2);
 }
@@ -458,6 +618,26 @@ static void dist_plot(const char*             fn,
         }
     }
 
+    /* With only the minimum distance outputs requested, pair caches let
+     * frames with small displacements skip the full group against group
+     * scans; one cache per group (or residue) pair. The maximum distance
+     * outputs always need a full scan, so no caches are used then.
+     */
+    t_distcache* caches = nullptr;
+    int          ncache;
+    if (bMat)
+    {
+        ncache = (ng == 1) ? 1 : (ng * (ng - 1)) / 2;
+    }
+    else
+    {
+        ncache = (ng - 1) * (1 + nres);
+    }
+    if (bMin)
+    {
+        snew(caches, ncache);
+    }
+
     if (nres)
     {
         snew(mindres, ng - 1);
@@ -499,7 +679,8 @@ static void dist_plot(const char*             fn,
             if (ng == 1)
             {
                 calc_dist(rcut, bPBC, pbcType, box, x0, gnx[0], gnx[0], index[0], index[0], bGroup,
-                          &dmin, &dmax, &nmin, &nmax, &min1, &min2, &max1, &max2);
+                          &dmin, &dmax, &nmin, &nmax, &min1, &min2, &max1, &max2,
+                          bMin ? &caches[0] : nullptr);
                 fprintf(dist, "  %12e", bMin ? dmin : dmax);
                 if (num)
                 {
@@ -508,12 +689,14 @@ static void dist_plot(const char*             fn,
             }
             else
             {
+                int cc = 0;
                 for (i = 0; (i < ng - 1); i++)
                 {
-                    for (k = i + 1; (k < ng); k++)
+                    for (k = i + 1; (k < ng); k++, cc++)
                     {
                         calc_dist(rcut, bPBC, pbcType, box, x0, gnx[i], gnx[k], index[i], index[k],
-                                  bGroup, &dmin, &dmax, &nmin, &nmax, &min1, &min2, &max1, &max2);
+                                  bGroup, &dmin, &dmax, &nmin, &nmax, &min1, &min2, &max1, &max2,
+                                  bMin ? &caches[cc] : nullptr);
                         fprintf(dist, "  %12e", bMin ? dmin : dmax);
                         if (num)
                         {
@@ -529,7 +712,8 @@ static void dist_plot(const char*             fn,
             for (i = 1; (i < ng); i++)
             {
                 calc_dist(rcut, bPBC, pbcType, box, x0, gnx[0], gnx[i], index[0], index[i], bGroup,
-                          &dmin, &dmax, &nmin, &nmax, &min1, &min2, &max1, &max2);
+                          &dmin, &dmax, &nmin, &nmax, &min1, &min2, &max1, &max2,
+                          bMin ? &caches[i - 1] : nullptr);
                 fprintf(dist, "  %12e", bMin ? dmin : dmax);
                 if (num)
                 {
@@ -541,7 +725,8 @@ static void dist_plot(const char*             fn,
                     {
                         calc_dist(rcut, bPBC, pbcType, box, x0, residue[j + 1] - residue[j], gnx[i],
                                   &(index[0][residue[j]]), index[i], bGroup, &dmin, &dmax, &nmin,
-                                  &nmax, &min1r, &min2r, &max1r, &max2r);
+                                  &nmax, &min1r, &min2r, &max1r, &max2r,
+                                  bMin ? &caches[(ng - 1) + (i - 1) * nres + j] : nullptr);
                         mindres[i - 1][j] = std::min(mindres[i - 1][j], dmin);
                         maxdres[i - 1][j] = std::max(maxdres[i - 1][j], dmax);
                     }
@@ -625,6 +810,17 @@ static void dist_plot(const char*             fn,
         xvgrclose(res);
     }
 
+    if (caches)
+    {
+        for (i = 0; i < ncache; i++)
+        {
+            sfree(caches[i].pairs);
+            sfree(caches[i].xref1);
+            sfree(caches[i].xref2);
+        }
+        sfree(caches);
+    }
+
     if (x0)
     {
         sfree(x0);
@@ -40,10 +40,13 @@
 #include <cmath>
 #include <cstring>
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "gromacs/commandline/pargs.h"
 #include "gromacs/commandline/viewit.h"
+#include "gromacs/correlationfunctions/manyautocorrelation.h"
 #include "gromacs/fileio/confio.h"
 #include "gromacs/fileio/trxio.h"
 #include "gromacs/fileio/xvgr.h"
@@ -61,6 +64,7 @@
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/futil.h"
 #include "gromacs/utility/gmxassert.h"
+#include "gromacs/utility/gmxomp.h"
 #include "gromacs/utility/smalloc.h"
 
 static constexpr double diffusionConversionFactor = 1000.0; /* Convert nm^2/ps to 10e-5 cm^2/s */
@@ -651,6 +655,176 @@ static void printmol(t_corr*                 curr,
     }
 }
 
+/* returns the number of dimensions contributing to the msd type and
+   fills dims[] with their indices */
+static int msd_dims(const t_corr* curr, int dims[DIM])
+{
+    int m, ndim;
+
+    ndim = 0;
+    switch (curr->type)
+    {
+        case NORMAL:
+            for (m = 0; (m < DIM); m++)
+            {
+                dims[ndim++] = m;
+            }
+            break;
+        case X:
+        case Y:
+        case Z: dims[ndim++] = curr->type - X; break;
+        case LATERAL:
+            for (m = 0; (m < DIM); m++)
+            {
+                if (m != curr->axis)
+                {
+                    dims[ndim++] = m;
+                }
+            }
+            break;
+        default: gmx_fatal(FARGS, "Error: did not expect option value %d", curr->type);
+    }
+    return ndim;
+}
+
+/* store one frame of coordinates for the FFT-based msd calculation:
+   one time series per particle and contributing dimension, with the
+   center of mass removed per frame when requested */
+static void store_fft_frame(t_corr*                         curr,
+                            std::vector<std::vector<real>>* series,
+                            int                             nx,
+                            const int                       index[],
+                            rvec                            xc[],
+                            gmx_bool                        bRmCOMM,
+                            const rvec                      com)
+{
+    int       i, d, dims[DIM];
+    const int ndim = msd_dims(curr, dims);
+
+    if (series->empty())
+    {
+        series->resize(static_cast<size_t>(nx) * ndim);
+    }
+    for (i = 0; (i < nx); i++)
+    {
+        for (d = 0; d < ndim; d++)
+        {
+            real v = xc[index[i]][dims[d]];
+            if (bRmCOMM)
+            {
+                v -= com[dims[d]];
+            }
+            (*series)[static_cast<size_t>(i) * ndim + d].push_back(v);
+        }
+    }
+}
+
+/* subtracts twice the FFT autocorrelation of each series in the chunk,
+   weighted per series, from the running msd sums */
+static void accumulate_fft_chunk(gmx::ManyAutocorrelation*       engine,
+                                 std::vector<std::vector<real>>* chunk,
+                                 const std::vector<real>&        weights,
+                                 int                             nframes,
+                                 std::vector<double>*            msdSum)
+{
+    if (chunk->empty())
+    {
+        return;
+    }
+    engine->compute(chunk);
+    for (size_t s = 0; s < chunk->size(); s++)
+    {
+        for (int m = 0; m < nframes; m++)
+        {
+            (*msdSum)[m] -= 2.0 * weights[s] * (*chunk)[s][m];
+        }
+    }
+    chunk->clear();
+}
+
+/* computes the msd over all time origins from the stored time series,
+   using the FFT identity msd(m) = (S1(m) - 2 S2(m))/(nframes - m):
+   S2 is the coordinate autocorrelation, evaluated with a shared
+   gmx::ManyAutocorrelation engine
+   on series zero-padded to twice their length so that all lags are free
+   of wrap-around, and S1 follows a running-sum recursion over the
+   squared coordinates */
+static void calc_fft_msd(t_corr* curr, std::vector<std::vector<std::vector<real>>>* series, const int gnx[], int* index[])
+{
+    const int N = curr->nframes;
+    int       dims[DIM];
+    const int ndim = msd_dims(curr, dims);
+    /* enough series per autocorrelation batch to keep all threads busy
+       while bounding the transform workspace */
+    const size_t chunkSize = std::max(64, gmx_omp_get_max_threads());
+    /* plan the FFTs once for all chunks of all groups */
+    gmx::ManyAutocorrelation engine(2 * N);
+
+    for (int g = 0; g < curr->ngrp; g++)
+    {
+        std::vector<double>            msdSum(N, 0.0);
+        std::vector<double>            sq(N);
+        std::vector<std::vector<real>> chunk;
+        std::vector<real>              chunkWeight;
+        double                         wtot = 0;
+
+        for (int i = 0; i < gnx[g]; i++)
+        {
+            const real w = curr->mass.empty() ? 1 : curr->mass[index[g][i]];
+            if (w == 0)
+            {
+                continue;
+            }
+            wtot += w;
+            /* the S1 term for this particle */
+            double s1 = 0;
+            for (int k = 0; k < N; k++)
+            {
+                double r2 = 0;
+                for (int d = 0; d < ndim; d++)
+                {
+                    const double x = (*series)[g][static_cast<size_t>(i) * ndim + d][k];
+                    r2 += x * x;
+                }
+                sq[k] = r2;
+                s1 += 2 * r2;
+            }
+            for (int m = 0; m < N; m++)
+            {
+                msdSum[m] += w * s1;
+                if (m + 1 < N)
+                {
+                    s1 -= sq[m] + sq[N - 1 - m];
+                }
+            }
+            /* queue the coordinate series for the S2 autocorrelations */
+            for (int d = 0; d < ndim; d++)
+            {
+                std::vector<real>& x = (*series)[g][static_cast<size_t>(i) * ndim + d];
+                x.resize(2 * N, 0);
+                chunk.push_back(std::move(x));
+                chunkWeight.push_back(w);
+                if (chunk.size() == chunkSize)
+                {
+                    accumulate_fft_chunk(&engine, &chunk, chunkWeight, N, &msdSum);
+                    chunkWeight.clear();
+                }
+            }
+        }
+        accumulate_fft_chunk(&engine, &chunk, chunkWeight, N, &msdSum);
+
+        if (wtot <= 0)
+        {
+            gmx_fatal(FARGS, "The total mass of group %d is zero", g + 1);
+        }
+        for (int m = 0; m < N; m++)
+        {
+            curr->data[g][m]  = msdSum[m] / (wtot * (N - m));
+            curr->ndata[g][m] = 1;
+        }
+    }
+}
+
 /* this is the main loop for the correlation type functions
  * fx and nx are file pointers to things like read_first_x and
  * read_next_x
@@ -664,6 +838,7 @@ static int corr_loop(t_corr*                  curr,
                      int*                     index[],
                      t_calc_func*             calc1,
                      gmx_bool                 bTen,
+                     gmx_bool                 bFFT,
                      gmx::ArrayRef<const int> gnx_com,
                      int*                     index_com[],
                      real                     dt,
@@ -682,6 +857,13 @@ static int corr_loop(t_corr*                  curr,
     matrix      box;
     gmx_bool    bFirst;
     gmx_rmpbc_t gpbc = nullptr;
+    /* per-group coordinate time series for the FFT-based algorithm */
+    std::vector<std::vector<std::vector<real>>> series;
+
+    if (bFFT)
+    {
+        series.resize(curr->ngrp);
+    }
 
     natoms = read_first_x(oenv, &status, fn, &curr->t0, &(x[cur]), box);
 #ifdef DEBUG
@@ -743,8 +925,9 @@ static int corr_loop(t_corr*                  curr,
         }
 
 
-        /* check whether we've reached a restart point */
-        if (bRmod(t, curr->t0, dt))
+        /* check whether we've reached a restart point; the FFT-based
+         * algorithm uses every frame as a time origin instead */
+        if (!bFFT && bRmod(t, curr->t0, dt))
         {
             curr->nrestart++;
 
@@ -841,18 +1024,39 @@ static int corr_loop(t_corr*                  curr,
         /* loop over all groups in index file */
         for (i = 0; (i < curr->ngrp); i++)
         {
-            /* calculate something useful, like mean square displacements */
-            calc_corr(curr, i, gnx[i], index[i], xa[cur], (!gnx_com.empty()), com, calc1, bTen);
+            if (bFFT)
+            {
+                /* only store the coordinates; the msd follows from the
+                 * autocorrelations once all frames have been read */
+                store_fft_frame(curr, &series[i], gnx[i], index[i], xa[cur], (!gnx_com.empty()), com);
+            }
+            else
+            {
+                /* calculate something useful, like mean square displacements */
+                calc_corr(curr, i, gnx[i], index[i], xa[cur], (!gnx_com.empty()), com, calc1, bTen);
+            }
         }
         cur    = prev;
         t_prev = t;
 
         curr->nframes++;
     } while (read_next_x(oenv, status, &t, x[cur], box));
-    fprintf(stderr, "\nUsed %d restart points spaced %g %s over %g %s\n\n", curr->nrestart,
-            output_env_conv_time(oenv, dt), output_env_get_time_unit(oenv).c_str(),
-            output_env_conv_time(oenv, curr->time[curr->nframes - 1]),
-            output_env_get_time_unit(oenv).c_str());
+    if (bFFT)
+    {
+        /* every frame has served as a time origin */
+        curr->nrestart = curr->nframes;
+        fprintf(stderr, "\nComputing the MSD with FFTs using all %d frames as time origins over %g %s\n\n",
+                curr->nframes, output_env_conv_time(oenv, curr->time[curr->nframes - 1]),
+                output_env_get_time_unit(oenv).c_str());
+        calc_fft_msd(curr, &series, gnx, index);
+    }
+    else
+    {
+        fprintf(stderr, "\nUsed %d restart points spaced %g %s over %g %s\n\n", curr->nrestart,
+                output_env_conv_time(oenv, dt), output_env_get_time_unit(oenv).c_str(),
+                output_env_conv_time(oenv, curr->time[curr->nframes - 1]),
+                output_env_get_time_unit(oenv).c_str());
+    }
 
     if (bMol)
     {
@@ -910,6 +1114,7 @@ static void do_corr(const char*             trx_file,
                     gmx_bool                bTen,
                     gmx_bool                bMW,
                     gmx_bool                bRmCOMM,
+                    gmx_bool                bFFT,
                     int                     type,
                     real                    dim_factor,
                     int                     axis,
@@ -957,7 +1162,7 @@ static void do_corr(const char*             trx_file,
 
     nat_trx = corr_loop(msd.get(), trx_file, top, pbcType, mol_file ? gnx[0] != 0 : false, gnx.data(),
                         index, (mol_file != nullptr) ? calc1_mol : (bMW ? calc1_mw : calc1_norm),
-                        bTen, gnx_com, index_com, dt, t_pdb, pdb_file ? &x : nullptr, box, oenv);
+                        bTen, bFFT, gnx_com, index_com, dt, t_pdb, pdb_file ? &x : nullptr, box, oenv);
 
     /* Correct for the number of points */
     for (j = 0; (j < msd->ngrp); j++)
@@ -1080,6 +1285,13 @@ int gmx_msd(int argc, char* argv[])
         "molecules.[PAR]",
         "The default way to calculate a MSD is by using mass-weighted averages.",
         "This can be turned off with [TT]-nomw[tt].[PAR]",
+        "With [TT]-fft[tt] the MSD is computed with an FFT-based algorithm that",
+        "uses every frame as a time origin at a cost that grows only",
+        "log-linearly with the number of frames, instead of quadratically as",
+        "for the restart-point sum. This ignores [TT]-trestart[tt], requires",
+        "the coordinates of the selected groups to fit in memory for the whole",
+        "trajectory, and is not available together with [TT]-ten[tt] or",
+        "[TT]-mol[tt].[PAR]",
         "With the option [TT]-rmcomm[tt], the center of mass motion of a ",
         "specific group can be removed. For trajectories produced with ",
         "GROMACS this is usually not necessary, ",
@@ -1111,6 +1323,7 @@ int gmx_msd(int argc, char* argv[])
     static gmx_bool    bTen       = FALSE;
     static gmx_bool    bMW        = TRUE;
     static gmx_bool    bRmCOMM    = FALSE;
+    static gmx_bool    bFFT       = FALSE;
     t_pargs            pa[]       = {
         { "-type", FALSE, etENUM, { normtype }, "Compute diffusion coefficient in one direction" },
         { "-lateral",
@@ -1122,6 +1335,11 @@ int gmx_msd(int argc, char* argv[])
         { "-ngroup", FALSE, etINT, { &ngroup }, "Number of groups to calculate MSD for" },
         { "-mw", FALSE, etBOOL, { &bMW }, "Mass weighted MSD" },
         { "-rmcomm", FALSE, etBOOL, { &bRmCOMM }, "Remove center of mass motion" },
+        { "-fft",
+          FALSE,
+          etBOOL,
+          { &bFFT },
+          "Use the FFT-based MSD algorithm with every frame as a time origin" },
         { "-tpdb", FALSE, etTIME, { &t_pdb }, "The frame to use for option [TT]-pdb[tt] (%t)" },
         { "-trestart", FALSE, etTIME, { &dt }, "Time between restarting points in trajectory (%t)" },
         { "-beginfit",
@@ -1212,6 +1430,16 @@ int gmx_msd(int argc, char* argv[])
     {
         gmx_fatal(FARGS, "Can only calculate the full tensor for 3D msd");
     }
+    if (bFFT && bTen)
+    {
+        gmx_fatal(FARGS, "The full tensor is not implemented for the FFT-based MSD algorithm");
+    }
+    if (bFFT && mol_file)
+    {
+        gmx_fatal(FARGS,
+                  "Molecular diffusion coefficients are not implemented for the FFT-based MSD "
+                  "algorithm");
+    }
 
     bTop = read_tps_conf(tps_file, &top, &pbcType, &xdum, nullptr, box, bMW || bRmCOMM);
     if (mol_file && !bTop)
@@ -1220,7 +1448,7 @@ int gmx_msd(int argc, char* argv[])
     }
 
     do_corr(trx_file, ndx_file, msd_file, mol_file, pdb_file, t_pdb, ngroup, &top, pbcType, bTen,
-            bMW, bRmCOMM, type, dim_factor, axis, dt, beginfit, endfit, oenv);
+            bMW, bRmCOMM, bFFT, type, dim_factor, axis, dt, beginfit, endfit, oenv);
 
     done_top(&top);
     view_all(oenv, NFILE, fnm);
@@ -50,6 +50,7 @@
 #include "gromacs/gmxana/cmat.h"
 #include "gromacs/gmxana/gmx_ana.h"
 #include "gromacs/gmxana/gstat.h"
+#include "gromacs/gmxana/slabbin.h"
 #include "gromacs/math/functions.h"
 #include "gromacs/math/utilities.h"
 #include "gromacs/math/vec.h"
@@ -670,12 +671,7 @@ static void calc_order(const char*             fn,
                     z1    = x1[a[index[i - 1] + j]][axis];
                     z2    = x1[a[index[i + 1] + j]][axis];
                     z_ave = 0.5 * (z1 + z2);
-                    slice = static_cast<int>((static_cast<real>(nslices) * z_ave) / box[axis][axis]);
-                    while (slice < 0)
-                    {
-                        slice += static_cast<real>(nslices);
-                    }
-                    slice = slice % nslices;
+                    slice = slab_index(z_ave, box[axis][axis], *slWidth, 0.0, nslices, FALSE, FALSE);
 
                     slCount[slice]++; /* determine slice, increase count */
 
@@ -47,6 +47,7 @@
 #include "gromacs/fileio/xvgr.h"
 #include "gromacs/gmxana/gmx_ana.h"
 #include "gromacs/gmxana/princ.h"
+#include "gromacs/gmxana/slabbin.h"
 #include "gromacs/math/functions.h"
 #include "gromacs/math/utilities.h"
 #include "gromacs/math/vec.h"
@@ -57,6 +58,7 @@
 #include "gromacs/utility/cstringutil.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/futil.h"
+#include "gromacs/utility/gmxomp.h"
 #include "gromacs/utility/smalloc.h"
 
 #define EPS0 8.85419E-12
@@ -128,7 +130,8 @@ static void calc_potential(const char*             fn,
     double      slVolume; /* volume of slice for spherical averaging */
     double      qsum, nn;
     real        t;
-    double      z;
+    real*       qtab; /* charge per atom, for the slab binning */
+    int         nth;  /* number of OpenMP threads for binning */
     rvec        xcm;
     gmx_rmpbc_t gpbc = nullptr;
 
@@ -172,6 +175,13 @@ static void calc_potential(const char*             fn,
     }
 
 
+    nth = gmx_omp_get_max_threads();
+    snew(qtab, top->atoms.nr);
+    for (i = 0; i < top->atoms.nr; i++)
+    {
+        qtab[i] = top->atoms.atom[i].q;
+    }
+
     gpbc = gmx_rmpbc_init(&top->idef, pbcType, natoms);
 
     /*********** Start processing trajectory ***********/
@@ -196,9 +206,9 @@ static void calc_potential(const char*             fn,
                           "were found in the trajectory.\n",
                           gnx[n], natoms);
             }
-            for (i = 0; i < gnx[n]; i++) /* loop over all atoms in index file */
+            if (bSpherical)
             {
-                if (bSpherical)
+                for (i = 0; i < gnx[n]; i++) /* loop over all atoms in index file */
                 {
                     rvec_add(x0[index[n][i]], xcm, x0[index[n][i]]);
                     /* only distance from origin counts, not sign */
@@ -214,22 +224,11 @@ static void calc_potential(const char*             fn,
                      */
                     (*slCharge)[n][slice] += top->atoms.atom[index[n][i]].q;
                 }
-                else
-                {
-                    z = x0[index[n][i]][axis];
-                    z = z + fudge_z;
-                    if (z < 0)
-                    {
-                        z += box[axis][axis];
-                    }
-                    if (z > box[axis][axis])
-                    {
-                        z -= box[axis][axis];
-                    }
-                    /* determine which slice atom is in */
-                    slice = static_cast<int>((z / (*slWidth)));
-                    (*slCharge)[n][slice] += top->atoms.atom[index[n][i]].q;
-                }
+            }
+            else
+            {
+                bin_slab_weights(x0, axis, index[n], gnx[n], qtab, 1.0, box[axis][axis], *slWidth,
+                                 fudge_z, *nslices, FALSE, FALSE, (*slCharge)[n], nth);
             }
         }
         nr_frames++;
@@ -368,6 +367,7 @@ static void calc_potential(const char*             fn,
     }
 
     sfree(x0); /* free memory used by coordinate array */
+    sfree(qtab);
 }
 
 static void plot_potential(double*                 potential[],
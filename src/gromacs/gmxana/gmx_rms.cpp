@@ -142,12 +142,16 @@ int gmx_rms(int argc, char* argv[])
 
         "Option [TT]-bin[tt] does a binary dump of the comparison matrix.[PAR]",
 
+        "Option [TT]-binmat[tt] writes the [TT]-m[tt] matrix in a compact binary",
+        "format instead of text [REF].xpm[ref], which is much smaller for large",
+        "matrices. [gmx-xpm2ps] reads both formats.[PAR]",
+
         "Option [TT]-bm[tt] produces a matrix of average bond angle deviations",
         "analogously to the [TT]-m[tt] option. Only bonds between atoms in the",
         "comparison group are considered."
     };
     static gmx_bool bPBC = TRUE, bFitAll = TRUE, bSplit = FALSE;
-    static gmx_bool bDeltaLog = FALSE;
+    static gmx_bool bDeltaLog = FALSE, bBinMat = FALSE;
     static int      prev = 0, freq = 1, freq2 = 1, nlevels = 80, avl = 0;
     static real     rmsd_user_max = -1, rmsd_user_min = -1, bond_user_max = -1, bond_user_min = -1,
                 delta_maxy = 0.0;
@@ -195,6 +199,7 @@ int gmx_rms(int argc, char* argv[])
         { "-bmin", FALSE, etREAL, { &bond_user_min }, "Minimum level in bond angle matrix" },
         { "-mw", FALSE, etBOOL, { &bMassWeighted }, "Use mass weighting for superposition" },
         { "-nlevels", FALSE, etINT, { &nlevels }, "Number of levels in the matrices" },
+        { "-binmat", FALSE, etBOOL, { &bBinMat }, "Write the [TT]-m[tt] matrix in the compact binary format" },
         { "-ng", FALSE, etINT, { &nrms }, "Number of groups to compute RMS between" },
         { "-dlog", FALSE, etBOOL, { &bDeltaLog }, "HIDDENUse a log x-axis in the delta t matrix" },
         { "-dmax", FALSE, etREAL, { &delta_maxy }, "HIDDENMaximum level in delta matrix" },
@@ -972,9 +977,21 @@ int gmx_rms(int argc, char* argv[])
                 fprintf(stderr, "Min and Max value set to resp. %f and %f\n", rmsd_min, rmsd_max);
             }
             sprintf(buf, "%s %s matrix", gn_rms[0], whatname[ewhat]);
-            write_xpm(opt2FILE("-m", NFILE, fnm, "w"), 0, buf, whatlabel[ewhat],
-                      output_env_get_time_label(oenv), output_env_get_time_label(oenv), tel_mat,
-                      tel_mat2, axis, axis2, rmsd_mat, rmsd_min, rmsd_max, rlo, rhi, &nlevels);
+            if (bBinMat)
+            {
+                t_matrix mrms = real2matrix(0, buf, whatlabel[ewhat], output_env_get_time_label(oenv),
+                                            output_env_get_time_label(oenv), tel_mat, tel_mat2, axis,
+                                            axis2, rmsd_mat, rmsd_min, rmsd_max, rlo, rhi, &nlevels);
+                fp = opt2FILE("-m", NFILE, fnm, "w");
+                write_binary_matrix(fp, mrms);
+                gmx_ffclose(fp);
+            }
+            else
+            {
+                write_xpm(opt2FILE("-m", NFILE, fnm, "w"), 0, buf, whatlabel[ewhat],
+                          output_env_get_time_label(oenv), output_env_get_time_label(oenv), tel_mat,
+                          tel_mat2, axis, axis2, rmsd_mat, rmsd_min, rmsd_max, rlo, rhi, &nlevels);
+            }
             /* Print the distribution of RMSD values */
             if (opt2bSet("-dist", NFILE, fnm))
             {
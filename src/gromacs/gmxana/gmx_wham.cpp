@@ -333,8 +333,6 @@ typedef struct // NOLINT(clang-analyzer-optin.performance.Padding)
     double * tabX, *tabY, tabMin, tabMax, tabDz;
     int      tabNbins;
     /*!\}*/
-    gmx::DefaultRandomEngine           rng;                //!< gromacs random number generator
-    gmx::TabulatedNormalDistribution<> normalDistribution; //!< Uses default: real output, 14-bit table
 } t_UmbrellaOptions;
 
 //! Make an umbrella window (may contain several histograms)
@@ -968,7 +966,10 @@ static void calc_profile(double* profile, t_UmbrellaWindow* window, int nWindows
     {
         try
         {
-            int nthreads  = gmx_omp_get_max_threads();
+            /* Use the team size, not the maximum thread count, so that the
+             * whole range is covered when this runs single-threaded inside
+             * the parallel bootstrap loop. */
+            int nthreads  = gmx_omp_get_num_threads();
             int thread_id = gmx_omp_get_thread_num();
             int i;
             int i0 = thread_id * opt->bins / nthreads;
@@ -1036,7 +1037,8 @@ static double calc_z(const double* profile, t_UmbrellaWindow* window, int nWindo
     {
         try
         {
-            int    nthreads  = gmx_omp_get_max_threads();
+            /* See calc_profile() for why the team size is used here. */
+            int    nthreads  = gmx_omp_get_num_threads();
             int    thread_id = gmx_omp_get_thread_num();
             int    i;
             int    i0     = thread_id * nWindows / nthreads;
@@ -1267,9 +1269,11 @@ static void copy_pullgrp_to_synthwindow(t_UmbrellaWindow* synthWindow, t_Umbrell
     synthWindow->pos[0]      = thisWindow->pos[pullid];
     synthWindow->z[0]        = thisWindow->z[pullid];
     synthWindow->k[0]        = thisWindow->k[pullid];
-    synthWindow->bContrib[0] = thisWindow->bContrib[pullid];
     synthWindow->g[0]        = thisWindow->g[pullid];
     synthWindow->bsWeight[0] = thisWindow->bsWeight[pullid];
+    /* Note: bContrib is not copied. The synthetic windows own their
+       contribution flags, so that concurrent bootstrap threads do not write
+       through shared pointers; setup_acc_wham() fills them before use. */
 }
 
 /*! \brief Calculate cumulative distribution function of of all histograms.
@@ -1375,14 +1379,17 @@ static void searchCumulative(const double xx[], int n, double x, int* j)
 }
 
 //! Bootstrap new trajectories and thereby generate new (bootstrapped) histograms
-static void create_synthetic_histo(t_UmbrellaWindow*  synthWindow,
-                                   t_UmbrellaWindow*  thisWindow,
-                                   int                pullid,
-                                   t_UmbrellaOptions* opt)
+static void create_synthetic_histo(t_UmbrellaWindow*         synthWindow,
+                                   t_UmbrellaWindow*         thisWindow,
+                                   int                       pullid,
+                                   t_UmbrellaOptions*        opt,
+                                   gmx::DefaultRandomEngine* rng)
 {
     int    N, i, nbins, r_index, ibin;
     double r, tausteps = 0.0, a, ap, dt, x, invsqrt2, g, y, sig = 0., z, mu = 0.;
-    char   errstr[1024];
+    /* the distribution keeps cached random bits, so use a private instance
+       instead of sharing one between bootstrap threads */
+    gmx::TabulatedNormalDistribution<> normalDistribution;
 
     N     = thisWindow->N[pullid];
     dt    = thisWindow->dt;
@@ -1401,25 +1408,16 @@ static void create_synthetic_histo(t_UmbrellaWindow*  synthWindow,
     }
     else
     {
-        sprintf(errstr,
-                "When generating hypothetical trajectories from given umbrella histograms,\n"
-                "autocorrelation times (ACTs) are required. Otherwise the statistical error\n"
-                "cannot be predicted. You have 3 options:\n"
-                "1) Make gmx wham estimate the ACTs (options -ac and -acsig).\n"
-                "2) Calculate the ACTs by yourself (e.g. with g_analyze) and provide them\n");
-        std::strcat(errstr,
-                    "   with option -iiact for all umbrella windows.\n"
-                    "3) If all ACTs are identical and know, you can define them with -bs-tau.\n"
-                    "   Use option (3) only if you are sure what you're doing, you may severely\n"
-                    "   underestimate the error if a too small ACT is given.\n");
-        gmx_fatal(FARGS, "%s", errstr);
+        /* do_bootstrapping() checks for this before entering the parallel loop */
+        gmx_fatal(FARGS, "No autocorrelation time for synthetic histogram. That should not happen.\n");
     }
 
+    /* bContrib stays private to the synthetic window (see
+       copy_pullgrp_to_synthwindow) */
     synthWindow->N[0]        = N;
     synthWindow->pos[0]      = thisWindow->pos[pullid];
     synthWindow->z[0]        = thisWindow->z[pullid];
     synthWindow->k[0]        = thisWindow->k[pullid];
-    synthWindow->bContrib[0] = thisWindow->bContrib[pullid];
     synthWindow->g[0]        = thisWindow->g[pullid];
     synthWindow->bsWeight[0] = thisWindow->bsWeight[pullid];
 
@@ -1455,14 +1453,14 @@ static void create_synthetic_histo(t_UmbrellaWindow*  synthWindow,
     invsqrt2 = 1.0 / std::sqrt(2.0);
 
     /* init random sequence */
-    x = opt->normalDistribution(opt->rng);
+    x = normalDistribution(*rng);
 
     if (opt->bsMethod == bsMethod_traj)
     {
         /* bootstrap points from the umbrella histograms */
         for (i = 0; i < N; i++)
         {
-            y = opt->normalDistribution(opt->rng);
+            y = normalDistribution(*rng);
             x = a * x + ap * y;
             /* get flat distribution in [0,1] using cumulative distribution function of Gauusian
                Note: CDF(Gaussian) = 0.5*{1+erf[x/sqrt(2)]}
@@ -1482,7 +1480,7 @@ static void create_synthetic_histo(t_UmbrellaWindow*  synthWindow,
         i = 0;
         while (i < N)
         {
-            y    = opt->normalDistribution(opt->rng);
+            y    = normalDistribution(*rng);
             x    = a * x + ap * y;
             z    = x * sig + mu;
             ibin = static_cast<int>(std::floor((z - opt->min) / opt->dz));
@@ -1560,7 +1558,7 @@ static void print_histograms(const char*        fnhist,
 }
 
 //! Make random weights for histograms for the Bayesian bootstrap of complete histograms)
-static void setRandomBsWeights(t_UmbrellaWindow* synthwin, int nAllPull, t_UmbrellaOptions* opt)
+static void setRandomBsWeights(t_UmbrellaWindow* synthwin, int nAllPull, gmx::DefaultRandomEngine* rng)
 {
     int                                i;
     double*                            r;
@@ -1571,7 +1569,7 @@ static void setRandomBsWeights(t_UmbrellaWindow* synthwin, int nAllPull, t_Umbre
     /* generate ordered random numbers between 0 and nAllPull  */
     for (i = 0; i < nAllPull - 1; i++)
     {
-        r[i] = dist(opt->rng);
+        r[i] = dist(*rng);
     }
     std::sort(r, r + nAllPull - 1);
     r[nAllPull - 1] = 1.0 * nAllPull;
@@ -1605,21 +1603,18 @@ static void do_bootstrapping(const char*        fnres,
                              int                nWindows,
                              t_UmbrellaOptions* opt)
 {
-    t_UmbrellaWindow* synthWindow;
-    double *          bsProfile, *bsProfiles_av, *bsProfiles_av2, maxchange = 1e20, tmp, stddev;
-    int               i, j, *randomArray = nullptr, winid, pullid, ib;
-    int               iAllPull, nAllPull, *allPull_winId, *allPull_pullId;
-    FILE*             fp;
-    gmx_bool          bExact = FALSE;
+    double *bsAllProfiles, *bsProfiles_av, *bsProfiles_av2, tmp, stddev;
+    int     i, j, ib;
+    int     iAllPull, nAllPull, *allPull_winId, *allPull_pullId;
+    FILE*   fp;
 
     /* init random generator */
     if (opt->bsSeed == 0)
     {
         opt->bsSeed = static_cast<int>(gmx::makeRandomSeed());
     }
-    opt->rng.seed(opt->bsSeed);
 
-    snew(bsProfile, opt->bins);
+    snew(bsAllProfiles, opt->nBootStrap * opt->bins);
     snew(bsProfiles_av, opt->bins);
     snew(bsProfiles_av2, opt->bins);
 
@@ -1645,131 +1640,210 @@ static void do_bootstrapping(const char*        fnres,
         }
     }
 
-    /* setup stuff for synthetic windows */
-    snew(synthWindow, nAllPull);
-    for (i = 0; i < nAllPull; i++)
-    {
-        synthWindow[i].nPull = 1;
-        synthWindow[i].nBin  = opt->bins;
-        snew(synthWindow[i].Histo, 1);
-        if (opt->bsMethod == bsMethod_traj || opt->bsMethod == bsMethod_trajGauss)
-        {
-            snew(synthWindow[i].Histo[0], opt->bins);
-        }
-        snew(synthWindow[i].N, 1);
-        snew(synthWindow[i].pos, 1);
-        snew(synthWindow[i].z, 1);
-        snew(synthWindow[i].k, 1);
-        snew(synthWindow[i].bContrib, 1);
-        snew(synthWindow[i].g, 1);
-        snew(synthWindow[i].bsWeight, 1);
-    }
-
     switch (opt->bsMethod)
     {
         case bsMethod_hist:
             printf("\n\nWhen computing statistical errors by bootstrapping entire histograms:\n");
             please_cite(stdout, "Hub2006");
             break;
-        case bsMethod_BayesianHist:
-            /* just copy all histogams into synthWindow array */
-            for (i = 0; i < nAllPull; i++)
+        case bsMethod_BayesianHist: break;
+        case bsMethod_traj:
+        case bsMethod_trajGauss:
+            if (!(opt->tauBootStrap > 0.0 || opt->bTauIntGiven || opt->bCalcTauInt))
             {
-                winid  = allPull_winId[i];
-                pullid = allPull_pullId[i];
-                copy_pullgrp_to_synthwindow(synthWindow + i, window + winid, pullid);
-            }
+                gmx_fatal(FARGS,
+                          "When generating hypothetical trajectories from given umbrella "
+                          "histograms,\n"
+                          "autocorrelation times (ACTs) are required. Otherwise the statistical "
+                          "error\n"
+                          "cannot be predicted. You have 3 options:\n"
+                          "1) Make gmx wham estimate the ACTs (options -ac and -acsig).\n"
+                          "2) Calculate the ACTs by yourself (e.g. with g_analyze) and provide "
+                          "them\n"
+                          "   with option -iiact for all umbrella windows.\n"
+                          "3) If all ACTs are identical and know, you can define them with "
+                          "-bs-tau.\n"
+                          "   Use option (3) only if you are sure what you're doing, you may "
+                          "severely\n"
+                          "   underestimate the error if a too small ACT is given.\n");
+            }
+            calc_cumulatives(window, nWindows, opt, fnhist, xlabel);
             break;
-        case bsMethod_traj:
-        case bsMethod_trajGauss: calc_cumulatives(window, nWindows, opt, fnhist, xlabel); break;
         default: gmx_fatal(FARGS, "Unknown bootstrap method. That should not have happened.\n");
     }
 
-    /* do bootstrapping */
-    fp = xvgropen(fnprof, "Bootstrap profiles", xlabel, ylabel, opt->oenv);
-    for (ib = 0; ib < opt->nBootStrap; ib++)
+    /* do bootstrapping; the replicas are independent once each has its own
+       random stream, so they are distributed over the OpenMP threads */
+#pragma omp parallel
     {
-        printf("  *******************************************\n"
-               "  ******** Start bootstrap nr %d ************\n"
-               "  *******************************************\n",
-               ib + 1);
-
-        switch (opt->bsMethod)
+        try
         {
-            case bsMethod_hist:
-                /* bootstrap complete histograms from given histograms */
-                srenew(randomArray, nAllPull);
-                getRandomIntArray(nAllPull, opt->histBootStrapBlockLength, randomArray, &opt->rng);
-                for (i = 0; i < nAllPull; i++)
+            t_UmbrellaWindow*        synthWindow;
+            double*                  bsProfile;
+            int*                     randomArray = nullptr;
+            double                   maxchange;
+            gmx_bool                 bExact;
+            int                      it, iter, winid, pullid, ibs;
+            gmx::DefaultRandomEngine rng(opt->bsSeed);
+
+            /* setup stuff for synthetic windows; each thread bootstraps into
+               its own set, so the replicas do not interfere */
+            snew(synthWindow, nAllPull);
+            for (it = 0; it < nAllPull; it++)
+            {
+                synthWindow[it].nPull = 1;
+                synthWindow[it].nBin  = opt->bins;
+                snew(synthWindow[it].Histo, 1);
+                if (opt->bsMethod == bsMethod_traj || opt->bsMethod == bsMethod_trajGauss)
                 {
-                    winid  = allPull_winId[randomArray[i]];
-                    pullid = allPull_pullId[randomArray[i]];
-                    copy_pullgrp_to_synthwindow(synthWindow + i, window + winid, pullid);
+                    snew(synthWindow[it].Histo[0], opt->bins);
                 }
-                break;
-            case bsMethod_BayesianHist:
-                /* keep histos, but assign random weights ("Bayesian bootstrap") */
-                setRandomBsWeights(synthWindow, nAllPull, opt);
-                break;
-            case bsMethod_traj:
-            case bsMethod_trajGauss:
-                /* create new histos from given histos, that is generate new hypothetical
-                   trajectories */
-                for (i = 0; i < nAllPull; i++)
+                snew(synthWindow[it].N, 1);
+                snew(synthWindow[it].pos, 1);
+                snew(synthWindow[it].z, 1);
+                snew(synthWindow[it].k, 1);
+                snew(synthWindow[it].bContrib, 1);
+                /* private contribution flags, filled by setup_acc_wham() */
+                snew(synthWindow[it].bContrib[0], opt->bins);
+                snew(synthWindow[it].g, 1);
+                snew(synthWindow[it].bsWeight, 1);
+            }
+            if (opt->bsMethod == bsMethod_BayesianHist)
+            {
+                /* just copy all histogams into synthWindow array */
+                for (it = 0; it < nAllPull; it++)
                 {
-                    winid  = allPull_winId[i];
-                    pullid = allPull_pullId[i];
-                    create_synthetic_histo(synthWindow + i, window + winid, pullid, opt);
+                    winid  = allPull_winId[it];
+                    pullid = allPull_pullId[it];
+                    copy_pullgrp_to_synthwindow(synthWindow + it, window + winid, pullid);
                 }
-                break;
-        }
-
-        /* write histos in case of verbose output */
-        if (opt->bs_verbose)
-        {
-            print_histograms(fnhist, synthWindow, nAllPull, ib, opt, xlabel);
-        }
-
-        /* do wham */
-        i         = 0;
-        bExact    = FALSE;
-        maxchange = 1e20;
-        std::memcpy(bsProfile, profile, opt->bins * sizeof(double)); /* use profile as guess */
-        do
-        {
-            if ((i % opt->stepUpdateContrib) == 0)
-            {
-                setup_acc_wham(bsProfile, synthWindow, nAllPull, opt);
             }
-            if (maxchange < opt->Tolerance)
+            snew(bsProfile, opt->bins);
+            if (opt->bsMethod == bsMethod_hist)
             {
-                bExact = TRUE;
+                snew(randomArray, nAllPull);
             }
-            if (((i % opt->stepchange) == 0 || i == 1) && i != 0)
+
+#pragma omp for schedule(dynamic)
+            for (ibs = 0; ibs < opt->nBootStrap; ibs++)
             {
-                printf("\t%4d) Maximum change %e\n", i, maxchange);
-            }
-            calc_profile(bsProfile, synthWindow, nAllPull, opt, bExact);
-            i++;
-        } while ((maxchange = calc_z(bsProfile, synthWindow, nAllPull, opt, bExact)) > opt->Tolerance
-                 || !bExact);
-        printf("\tConverged in %d iterations. Final maximum change %g\n", i, maxchange);
+                printf("  *******************************************\n"
+                       "  ******** Start bootstrap nr %d ************\n"
+                       "  *******************************************\n",
+                       ibs + 1);
 
-        if (opt->bLog)
-        {
-            prof_normalization_and_unit(bsProfile, opt);
-        }
+                /* restart the random engine so each replica consumes its own
+                   stream, independent of the thread that runs it */
+                rng.restart(ibs, 0);
 
-        /* symmetrize profile around z=0 */
-        if (opt->bSym)
-        {
-            symmetrizeProfile(bsProfile, opt);
+                switch (opt->bsMethod)
+                {
+                    case bsMethod_hist:
+                        /* bootstrap complete histograms from given histograms */
+                        getRandomIntArray(nAllPull, opt->histBootStrapBlockLength, randomArray, &rng);
+                        for (it = 0; it < nAllPull; it++)
+                        {
+                            winid  = allPull_winId[randomArray[it]];
+                            pullid = allPull_pullId[randomArray[it]];
+                            copy_pullgrp_to_synthwindow(synthWindow + it, window + winid, pullid);
+                        }
+                        break;
+                    case bsMethod_BayesianHist:
+                        /* keep histos, but assign random weights ("Bayesian bootstrap") */
+                        setRandomBsWeights(synthWindow, nAllPull, &rng);
+                        break;
+                    case bsMethod_traj:
+                    case bsMethod_trajGauss:
+                        /* create new histos from given histos, that is generate new hypothetical
+                           trajectories */
+                        for (it = 0; it < nAllPull; it++)
+                        {
+                            winid  = allPull_winId[it];
+                            pullid = allPull_pullId[it];
+                            create_synthetic_histo(synthWindow + it, window + winid, pullid, opt, &rng);
+                        }
+                        break;
+                }
+
+                /* write histos in case of verbose output */
+                if (opt->bs_verbose)
+                {
+                    print_histograms(fnhist, synthWindow, nAllPull, ibs, opt, xlabel);
+                }
+
+                /* do wham */
+                iter      = 0;
+                bExact    = FALSE;
+                maxchange = 1e20;
+                std::memcpy(bsProfile, profile, opt->bins * sizeof(double)); /* use profile as guess */
+                do
+                {
+                    if ((iter % opt->stepUpdateContrib) == 0)
+                    {
+                        setup_acc_wham(bsProfile, synthWindow, nAllPull, opt);
+                    }
+                    if (maxchange < opt->Tolerance)
+                    {
+                        bExact = TRUE;
+                    }
+                    if (((iter % opt->stepchange) == 0 || iter == 1) && iter != 0)
+                    {
+                        printf("\t%4d) Maximum change %e\n", iter, maxchange);
+                    }
+                    calc_profile(bsProfile, synthWindow, nAllPull, opt, bExact);
+                    iter++;
+                } while ((maxchange = calc_z(bsProfile, synthWindow, nAllPull, opt, bExact)) > opt->Tolerance
+                         || !bExact);
+                printf("\tBootstrap nr %d converged in %d iterations. Final maximum change %g\n",
+                       ibs + 1, iter, maxchange);
+
+                if (opt->bLog)
+                {
+                    prof_normalization_and_unit(bsProfile, opt);
+                }
+
+                /* symmetrize profile around z=0 */
+                if (opt->bSym)
+                {
+                    symmetrizeProfile(bsProfile, opt);
+                }
+
+                /* keep the profile; averaging and output happen in replica
+                   order after the parallel loop */
+                std::memcpy(bsAllProfiles + static_cast<size_t>(ibs) * opt->bins, bsProfile,
+                            opt->bins * sizeof(double));
+            }
+
+            for (it = 0; it < nAllPull; it++)
+            {
+                if (opt->bsMethod == bsMethod_traj || opt->bsMethod == bsMethod_trajGauss)
+                {
+                    sfree(synthWindow[it].Histo[0]);
+                }
+                sfree(synthWindow[it].Histo);
+                sfree(synthWindow[it].N);
+                sfree(synthWindow[it].pos);
+                sfree(synthWindow[it].z);
+                sfree(synthWindow[it].k);
+                sfree(synthWindow[it].bContrib[0]);
+                sfree(synthWindow[it].bContrib);
+                sfree(synthWindow[it].g);
+                sfree(synthWindow[it].bsWeight);
+            }
+            sfree(synthWindow);
+            sfree(bsProfile);
+            sfree(randomArray);
         }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+    }
 
-        /* save stuff to get average and stddev */
+    /* save stuff to get average and stddev */
+    fp = xvgropen(fnprof, "Bootstrap profiles", xlabel, ylabel, opt->oenv);
+    for (ib = 0; ib < opt->nBootStrap; ib++)
+    {
         for (i = 0; i < opt->bins; i++)
         {
-            tmp = bsProfile[i];
+            tmp = bsAllProfiles[static_cast<size_t>(ib) * opt->bins + i];
             bsProfiles_av[i] += tmp;
             bsProfiles_av2[i] += tmp * tmp;
             fprintf(fp, "%e\t%e\n", (i + 0.5) * opt->dz + opt->min, tmp);
@@ -1777,6 +1851,7 @@ static void do_bootstrapping(const char*        fnres,
         fprintf(fp, "%s\n", output_env_get_print_xvgr_codes(opt->oenv) ? "&" : "");
     }
     xvgrclose(fp);
+    sfree(bsAllProfiles);
 
     /* write average and stddev */
     fp = xvgropen(fnres, "Average and stddev from bootstrapping", xlabel, ylabel, opt->oenv);
@@ -688,7 +688,7 @@ static void xpm_mat(const char*             outf,
 
     out = gmx_ffopen(outf, "w");
 
-    GMX_RELEASE_ASSERT(mat.size() == mat2.size(),
+    GMX_RELEASE_ASSERT(mat2.empty() || mat.size() == mat2.size(),
                        "Combined matrix write requires matrices of the same size");
     for (gmx::index i = 0; i != gmx::ssize(mat); ++i)
     {
@@ -929,7 +929,7 @@ static void ps_mat(const char*             outf,
             ps_rgb(&out, BLACK);
             ps_strfont(&out, psr->titfont, psr->titfontsize);
             std::string buf;
-            if (!mat2.empty() || mat[i].title == mat2[i].title)
+            if (mat2.empty() || mat[i].title == mat2[i].title)
             {
                 buf = mat[i].title;
             }
@@ -1068,7 +1068,7 @@ static void make_axis_labels(gmx::ArrayRef<t_matrix> mat1)
 
 static void prune_mat(gmx::ArrayRef<t_matrix> mat, gmx::ArrayRef<t_matrix> mat2, int skip)
 {
-    GMX_RELEASE_ASSERT(mat.size() == mat2.size(),
+    GMX_RELEASE_ASSERT(mat2.empty() || mat.size() == mat2.size(),
                        "Matrix pruning requires matrices of the same size");
     for (gmx::index i = 0; i != gmx::ssize(mat); ++i)
     {
@@ -1254,7 +1254,7 @@ static void do_mat(gmx::ArrayRef<t_matrix> mat,
                    int                     skip,
                    int                     mapoffset)
 {
-    GMX_RELEASE_ASSERT(mat.size() == mat2.size(),
+    GMX_RELEASE_ASSERT(mat2.empty() || mat.size() == mat2.size(),
                        "Combined matrix write requires matrices of the same size");
     if (!mat2.empty())
     {
@@ -43,7 +43,9 @@
 #include <cstring>
 
 #include <algorithm>
+#include <vector>
 
+#include "gromacs/gmxana/dihbatch.h"
 #include "gromacs/listed_forces/bonded.h"
 #include "gromacs/pbcutil/rmpbc.h"
 #include "gromacs/utility/cstringutil.h"
@@ -73,20 +75,26 @@ static bool d_comp(const t_dih& a, const t_dih& b)
 
 static void calc_dihs(t_xrama* xr)
 {
-    int         i, t1, t2, t3;
-    rvec        r_ij, r_kj, r_kl, m, n;
-    t_dih*      dd;
+    int         i, j;
     gmx_rmpbc_t gpbc = nullptr;
 
     gpbc = gmx_rmpbc_init(xr->idef, xr->pbcType, xr->natoms);
     gmx_rmpbc(gpbc, xr->natoms, xr->box, xr->x);
     gmx_rmpbc_done(gpbc);
 
+    std::vector<int>  index(4 * xr->ndih);
+    std::vector<real> ang(xr->ndih);
     for (i = 0; (i < xr->ndih); i++)
     {
-        dd      = &(xr->dih[i]);
-        dd->ang = dih_angle(xr->x[dd->ai[0]], xr->x[dd->ai[1]], xr->x[dd->ai[2]], xr->x[dd->ai[3]],
-                            nullptr, r_ij, r_kj, r_kl, m, n, &t1, &t2, &t3);
+        for (j = 0; (j < 4); j++)
+        {
+            index[4 * i + j] = xr->dih[i].ai[j];
+        }
+    }
+    dih_angle_batch(nullptr, xr->ndih, index.data(), xr->x, ang.data());
+    for (i = 0; (i < xr->ndih); i++)
+    {
+        xr->dih[i].ang = ang[i];
     }
 }
 
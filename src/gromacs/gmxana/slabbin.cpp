@@ -0,0 +1,141 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+
+#include "gmxpre.h"
+
+#include "slabbin.h"
+
+#include <cmath>
+
+#include "gromacs/utility/gmxomp.h"
+#include "gromacs/utility/smalloc.h"
+
+int slab_index(real z, real boxLen, real slWidth, real zShift, int nslices, gmx_bool bCenter, gmx_bool bRelative)
+{
+    int slice;
+
+    z += zShift;
+    while (z < 0)
+    {
+        z += boxLen;
+    }
+    while (z > boxLen)
+    {
+        z -= boxLen;
+    }
+
+    if (bRelative)
+    {
+        z = z / boxLen;
+    }
+
+    if (bCenter)
+    {
+        real boxSz = bRelative ? 1.0 : boxLen;
+        slice = static_cast<int>(std::floor((z - (boxSz / 2.0)) / slWidth) + nslices / 2.);
+    }
+    else
+    {
+        slice = static_cast<int>(std::floor(z / slWidth));
+    }
+
+    /* Slice should already be 0<=slice<nslices, but we just make
+     * sure we are not hit by IEEE rounding errors since we do
+     * math operations after applying PBC above.
+     */
+    if (slice < 0)
+    {
+        slice += nslices;
+    }
+    else if (slice >= nslices)
+    {
+        slice -= nslices;
+    }
+
+    return slice;
+}
+
+void bin_slab_weights(const rvec  x0[],
+                      int         axis,
+                      const int   index[],
+                      int         nindex,
+                      const real  weights[],
+                      double      scale,
+                      real        boxLen,
+                      real        slWidth,
+                      real        zShift,
+                      int         nslices,
+                      gmx_bool    bCenter,
+                      gmx_bool    bRelative,
+                      double      slab[],
+                      int         nth)
+{
+    int i, t;
+
+    if (nth <= 1)
+    {
+        for (i = 0; i < nindex; i++)
+        {
+            int slice = slab_index(x0[index[i]][axis], boxLen, slWidth, zShift, nslices, bCenter, bRelative);
+            slab[slice] += (weights ? weights[index[i]] : 1.0) * scale;
+        }
+        return;
+    }
+
+    double* partial;
+    snew(partial, nth * nslices);
+
+    /* Pure arithmetic, no exceptions can be thrown here */
+#pragma omp parallel num_threads(nth) private(i)
+    {
+        double* mySlab = partial + gmx_omp_get_thread_num() * nslices;
+
+#pragma omp for schedule(static)
+        for (i = 0; i < nindex; i++)
+        {
+            int slice = slab_index(x0[index[i]][axis], boxLen, slWidth, zShift, nslices, bCenter, bRelative);
+            mySlab[slice] += (weights ? weights[index[i]] : 1.0) * scale;
+        }
+    }
+
+    for (t = 0; t < nth; t++)
+    {
+        for (i = 0; i < nslices; i++)
+        {
+            slab[i] += partial[t * nslices + i];
+        }
+    }
+    sfree(partial);
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+
+#ifndef _slabbin_h
+#define _slabbin_h
+
+#include "gromacs/math/vectypes.h"
+#include "gromacs/utility/basedefinitions.h"
+#include "gromacs/utility/real.h"
+
+/* Shared slab binning for the slice-based analysis tools (gmx density,
+ * gmx potential, gmx h2order, gmx order).
+ *
+ * All of these tools wrap a coordinate along one box axis back into the
+ * box and accumulate a per-atom weight into the slab it falls in. The
+ * routines here centralize that index computation and provide a threaded
+ * accumulation over an index group that merges per-thread partial slab
+ * arrays, so the per-frame work scales with the number of OpenMP threads
+ * while the summation order within each slab stays deterministic for a
+ * given thread count.
+ */
+
+/* Return the slab an atom at position z along the slicing axis belongs to.
+ *
+ * zShift is added to z before wrapping (gmx potential uses this to shift
+ * the histogram). With bCenter the slabs are centered on the box center,
+ * with bRelative the slab width is a fraction of the (fluctuating) box
+ * length and slWidth must be 1/nslices. The result is always in
+ * [0, nslices), also when rounding puts the wrapped coordinate just
+ * outside the box.
+ */
+int slab_index(real z, real boxLen, real slWidth, real zShift, int nslices, gmx_bool bCenter, gmx_bool bRelative);
+
+/* Accumulate per-atom weights into slab[0..nslices-1] for one frame.
+ *
+ * For each of the nindex atoms in index[], weights[index[i]]*scale is
+ * added to the slab found by slab_index(); pass weights = nullptr to
+ * count atoms (weight 1). The loop is parallelized over nth OpenMP
+ * threads with per-thread partial slab arrays that are reduced into
+ * slab[] afterwards; nth = 1 gives the plain serial accumulation.
+ */
+void bin_slab_weights(const rvec  x0[],
+                      int         axis,
+                      const int   index[],
+                      int         nindex,
+                      const real  weights[],
+                      double      scale,
+                      real        boxLen,
+                      real        slWidth,
+                      real        zShift,
+                      int         nslices,
+                      gmx_bool    bCenter,
+                      gmx_bool    bRelative,
+                      double      slab[],
+                      int         nth);
+
+#endif
@@ -49,6 +49,7 @@
 #include "gromacs/commandline/filenm.h"
 #include "gromacs/mdrunutility/multisim.h"
 #include "gromacs/mdtypes/commrec.h"
+#include "gromacs/timing/mpi_profile.h"
 #include "gromacs/utility/basenetwork.h"
 #include "gromacs/utility/cstringutil.h"
 #include "gromacs/utility/fatalerror.h"
@@ -271,6 +272,8 @@ void gmx_sumd(int gmx_unused nr, double gmx_unused r[], const t_commrec gmx_unus
 #if !GMX_MPI
     gmx_call("gmx_sumd");
 #else
+    const double profileStart = mpi_profile_start();
+
 #    if MPI_IN_PLACE_EXISTS
     if (cr->nc.bUse)
     {
@@ -321,6 +324,7 @@ void gmx_sumd(int gmx_unused nr, double gmx_unused r[], const t_commrec gmx_unus
         }
     }
 #    endif
+    mpi_profile_record(empcGLOBALSUM, profileStart, nr * sizeof(double), nr * sizeof(double));
 #endif
 }
 
@@ -329,6 +333,8 @@ void gmx_sumf(int gmx_unused nr, float gmx_unused r[], const t_commrec gmx_unuse
 #if !GMX_MPI
     gmx_call("gmx_sumf");
 #else
+    const double profileStart = mpi_profile_start();
+
 #    if MPI_IN_PLACE_EXISTS
     if (cr->nc.bUse)
     {
@@ -379,6 +385,7 @@ void gmx_sumf(int gmx_unused nr, float gmx_unused r[], const t_commrec gmx_unuse
         }
     }
 #    endif
+    mpi_profile_record(empcGLOBALSUM, profileStart, nr * sizeof(float), nr * sizeof(float));
 #endif
 }
 
@@ -387,6 +394,8 @@ void gmx_sumi(int gmx_unused nr, int gmx_unused r[], const t_commrec gmx_unused*
 #if !GMX_MPI
     gmx_call("gmx_sumi");
 #else
+    const double profileStart = mpi_profile_start();
+
 #    if MPI_IN_PLACE_EXISTS
     if (cr->nc.bUse)
     {
@@ -437,6 +446,7 @@ void gmx_sumi(int gmx_unused nr, int gmx_unused r[], const t_commrec gmx_unused*
         }
     }
 #    endif
+    mpi_profile_record(empcGLOBALSUM, profileStart, nr * sizeof(int), nr * sizeof(int));
 #endif
 }
 
@@ -445,6 +455,8 @@ void gmx_sumli(int gmx_unused nr, int64_t gmx_unused r[], const t_commrec gmx_un
 #if !GMX_MPI
     gmx_call("gmx_sumli");
 #else
+    const double profileStart = mpi_profile_start();
+
 #    if MPI_IN_PLACE_EXISTS
     if (cr->nc.bUse)
     {
@@ -495,6 +507,7 @@ void gmx_sumli(int gmx_unused nr, int64_t gmx_unused r[], const t_commrec gmx_un
         }
     }
 #    endif
+    mpi_profile_record(empcGLOBALSUM, profileStart, nr * sizeof(int64_t), nr * sizeof(int64_t));
 #endif
 }
 
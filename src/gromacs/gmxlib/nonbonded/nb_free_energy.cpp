@@ -42,6 +42,7 @@
 #include <cmath>
 
 #include <algorithm>
+#include <vector>
 
 #include "gromacs/gmxlib/nrnb.h"
 #include "gromacs/gmxlib/nonbonded/nb_kernel.h"
@@ -54,24 +55,34 @@
 #include "gromacs/mdtypes/md_enums.h"
 #include "gromacs/mdtypes/mdatom.h"
 #include "gromacs/simd/simd.h"
+#include "gromacs/simd/simd_math.h"
 #include "gromacs/utility/fatalerror.h"
 
 
+//! The SIMD kernel needs masked table gathers in addition to the usual SIMD support
+#if GMX_SIMD_HAVE_REAL && GMX_SIMD_HAVE_INT32_ARITHMETICS && GMX_SIMD_HAVE_GATHER_LOADU_BYSIMDINT_TRANSPOSE_REAL
+#    define GMX_NB_FREE_ENERGY_USE_SIMD 1
+#else
+#    define GMX_NB_FREE_ENERGY_USE_SIMD 0
+#endif
+
 //! Scalar (non-SIMD) data types.
 struct ScalarDataTypes
 {
     using RealType                     = real; //!< The data type to use as real.
     using IntType                      = int;  //!< The data type to use as int.
+    using BoolType                     = bool; //!< The data type to use as bool.
     static constexpr int simdRealWidth = 1;    //!< The width of the RealType.
     static constexpr int simdIntWidth  = 1;    //!< The width of the IntType.
 };
 
-#if GMX_SIMD_HAVE_REAL && GMX_SIMD_HAVE_INT32_ARITHMETICS
+#if GMX_NB_FREE_ENERGY_USE_SIMD
 //! SIMD data types.
 struct SimdDataTypes
 {
     using RealType                     = gmx::SimdReal;         //!< The data type to use as real.
     using IntType                      = gmx::SimdInt32;        //!< The data type to use as int.
+    using BoolType                     = gmx::SimdBool;         //!< The data type to use as bool.
     static constexpr int simdRealWidth = GMX_SIMD_REAL_WIDTH;   //!< The width of the RealType.
     static constexpr int simdIntWidth  = GMX_SIMD_FINT32_WIDTH; //!< The width of the IntType.
 };
@@ -81,8 +92,10 @@ struct SimdDataTypes
 template<class RealType>
 static inline void pthRoot(const RealType r, RealType* pthRoot, RealType* invPthRoot)
 {
-    *invPthRoot = gmx::invsqrt(std::cbrt(r));
-    *pthRoot    = 1 / (*invPthRoot);
+    /* With unqualified cbrt the SIMD overload is found through ADL */
+    using std::cbrt;
+    *invPthRoot = gmx::invsqrt(cbrt(r));
+    *pthRoot    = gmx::inv(*invPthRoot);
 }
 
 template<class RealType>
@@ -156,41 +169,31 @@ static inline RealType lennardJonesPotential(const RealType v6,
 }
 
 /* Ewald LJ */
-static inline real ewaldLennardJonesGridSubtract(const real c6grid, const real potentialShift, const real onesixth)
+template<class RealType>
+static inline RealType ewaldLennardJonesGridSubtract(const RealType c6grid,
+                                                     const real     potentialShift,
+                                                     const real     onesixth)
 {
     return (c6grid * potentialShift * onesixth);
 }
 
 /* LJ Potential switch */
-template<class RealType>
+template<class RealType, class BoolType>
 static inline RealType potSwitchScalarForceMod(const RealType fScalarInp,
                                                const RealType potential,
                                                const RealType sw,
                                                const RealType r,
-                                               const RealType rVdw,
                                                const RealType dsw,
-                                               const real     zero)
+                                               const BoolType mask)
 {
-    if (r < rVdw)
-    {
-        real fScalar = fScalarInp * sw - r * potential * dsw;
-        return (fScalar);
-    }
-    return (zero);
+    /* The mask should select on rV < rVdw */
+    return (gmx::selectByMask(fScalarInp * sw - r * potential * dsw, mask));
 }
-template<class RealType>
-static inline RealType potSwitchPotentialMod(const RealType potentialInp,
-                                             const RealType sw,
-                                             const RealType r,
-                                             const RealType rVdw,
-                                             const real     zero)
+template<class RealType, class BoolType>
+static inline RealType potSwitchPotentialMod(const RealType potentialInp, const RealType sw, const BoolType mask)
 {
-    if (r < rVdw)
-    {
-        real potential = potentialInp * sw;
-        return (potential);
-    }
-    return (zero);
+    /* The mask should select on rV < rVdw */
+    return (gmx::selectByMask(potentialInp * sw, mask));
 }
 
 
@@ -210,15 +213,15 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
 
     using RealType = typename DataTypes::RealType;
     using IntType  = typename DataTypes::IntType;
+    using BoolType = typename DataTypes::BoolType;
 
-    /* FIXME: How should these be handled with SIMD? */
+    /* Scalar constants; these broadcast to all SIMD lanes where needed */
     constexpr real onetwelfth = 1.0 / 12.0;
     constexpr real onesixth   = 1.0 / 6.0;
     constexpr real zero       = 0.0;
     constexpr real half       = 0.5;
     constexpr real one        = 1.0;
     constexpr real two        = 2.0;
-    constexpr real six        = 6.0;
 
     /* Extract pointer to non-bonded interaction constants */
     const interaction_const_t* ic = fr->ic;
@@ -329,8 +332,8 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
     GMX_RELEASE_ASSERT(!(vdwInteractionTypeIsEwald && vdwModifierIsPotSwitch),
                        "Can not apply soft-core to switched Ewald potentials");
 
-    real dvdl_coul = 0;
-    real dvdl_vdw  = 0;
+    RealType dvdl_coul(zero);
+    RealType dvdl_vdw(zero);
 
     /* Lambda factor for state A, 1-lambda*/
     real LFC[NSTATES], LFV[NSTATES];
@@ -361,46 +364,113 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
     real* gmx_restrict f      = &(forceWithShiftForces->force()[0][0]);
     real* gmx_restrict fshift = &(forceWithShiftForces->shiftForces()[0][0]);
 
+    constexpr int simdRealWidth = DataTypes::simdRealWidth;
+
     for (int n = 0; n < nri; n++)
     {
-        int npair_within_cutoff = 0;
-
-        const int  is3   = 3 * shift[n];
-        const real shX   = shiftvec[is3];
-        const real shY   = shiftvec[is3 + 1];
-        const real shZ   = shiftvec[is3 + 2];
-        const int  nj0   = jindex[n];
-        const int  nj1   = jindex[n + 1];
-        const int  ii    = iinr[n];
-        const int  ii3   = 3 * ii;
-        const real ix    = shX + x[ii3 + 0];
-        const real iy    = shY + x[ii3 + 1];
-        const real iz    = shZ + x[ii3 + 2];
-        const real iqA   = facel * chargeA[ii];
-        const real iqB   = facel * chargeB[ii];
-        const int  ntiA  = 2 * ntype * typeA[ii];
-        const int  ntiB  = 2 * ntype * typeB[ii];
-        real       vctot = 0;
-        real       vvtot = 0;
-        real       fix   = 0;
-        real       fiy   = 0;
-        real       fiz   = 0;
-
-        for (int k = nj0; k < nj1; k++)
+        bool havePairsWithinCutoff = false;
+
+        const int  is3  = 3 * shift[n];
+        const real shX  = shiftvec[is3];
+        const real shY  = shiftvec[is3 + 1];
+        const real shZ  = shiftvec[is3 + 2];
+        const int  nj0  = jindex[n];
+        const int  nj1  = jindex[n + 1];
+        const int  ii   = iinr[n];
+        const int  ii3  = 3 * ii;
+        const real ix   = shX + x[ii3 + 0];
+        const real iy   = shY + x[ii3 + 1];
+        const real iz   = shZ + x[ii3 + 2];
+        const real iqA  = facel * chargeA[ii];
+        const real iqB  = facel * chargeB[ii];
+        const int  ntiA = 2 * ntype * typeA[ii];
+        const int  ntiB = 2 * ntype * typeB[ii];
+        RealType   vctot(zero);
+        RealType   vvtot(zero);
+        RealType   fix(zero);
+        RealType   fiy(zero);
+        RealType   fiz(zero);
+
+        for (int k = nj0; k < nj1; k += simdRealWidth)
         {
-            int            tj[NSTATES];
-            const int      jnr = jjnr[k];
-            const int      j3  = 3 * jnr;
-            RealType       c6[NSTATES], c12[NSTATES], qq[NSTATES], Vcoul[NSTATES], Vvdw[NSTATES];
-            RealType       r, rinv, rp, rpm2;
-            RealType       alpha_vdw_eff, alpha_coul_eff, sigma6[NSTATES];
-            const RealType dx  = ix - x[j3];
-            const RealType dy  = iy - x[j3 + 1];
-            const RealType dz  = iz - x[j3 + 2];
+            /* Load (up to) simdRealWidth pairs into aligned buffers.
+             * An incomplete last chunk duplicates the final list entry
+             * in the padding lanes; those lanes are masked out of all
+             * contributions below through preloadPairIsValid.
+             */
+            int jnrs[simdRealWidth];
+            alignas(GMX_SIMD_ALIGNMENT) real preloadPairIsValid[simdRealWidth];
+            alignas(GMX_SIMD_ALIGNMENT) real preloadPairIncluded[simdRealWidth];
+            alignas(GMX_SIMD_ALIGNMENT) real preloadIiEqJnr[simdRealWidth];
+            alignas(GMX_SIMD_ALIGNMENT) real preloadJx[simdRealWidth];
+            alignas(GMX_SIMD_ALIGNMENT) real preloadJy[simdRealWidth];
+            alignas(GMX_SIMD_ALIGNMENT) real preloadJz[simdRealWidth];
+            alignas(GMX_SIMD_ALIGNMENT) real preloadQq[NSTATES][simdRealWidth];
+            alignas(GMX_SIMD_ALIGNMENT) real preloadC6[NSTATES][simdRealWidth];
+            alignas(GMX_SIMD_ALIGNMENT) real preloadC12[NSTATES][simdRealWidth];
+            alignas(GMX_SIMD_ALIGNMENT) real preloadLjPmeC6Grid[NSTATES][simdRealWidth];
+            for (int s = 0; s < simdRealWidth; s++)
+            {
+                const int ks  = (k + s < nj1) ? k + s : nj1 - 1;
+                const int jnr = jjnr[ks];
+                jnrs[s]       = jnr;
+
+                preloadPairIsValid[s] = (k + s < nj1) ? one : zero;
+                preloadPairIncluded[s] =
+                        (nlist->excl_fep == nullptr || nlist->excl_fep[ks]) ? one : zero;
+                preloadIiEqJnr[s] = (ii == jnr) ? one : zero;
+
+                preloadJx[s] = x[3 * jnr + 0];
+                preloadJy[s] = x[3 * jnr + 1];
+                preloadJz[s] = x[3 * jnr + 2];
+
+                preloadQq[STATE_A][s] = iqA * chargeA[jnr];
+                preloadQq[STATE_B][s] = iqB * chargeB[jnr];
+
+                const int tjA          = ntiA + 2 * typeA[jnr];
+                const int tjB          = ntiB + 2 * typeB[jnr];
+                preloadC6[STATE_A][s]  = nbfp[tjA];
+                preloadC6[STATE_B][s]  = nbfp[tjB];
+                preloadC12[STATE_A][s] = nbfp[tjA + 1];
+                preloadC12[STATE_B][s] = nbfp[tjB + 1];
+                if (vdwInteractionTypeIsEwald)
+                {
+                    preloadLjPmeC6Grid[STATE_A][s] = nbfp_grid[tjA];
+                    preloadLjPmeC6Grid[STATE_B][s] = nbfp_grid[tjB];
+                }
+                else
+                {
+                    preloadLjPmeC6Grid[STATE_A][s] = zero;
+                    preloadLjPmeC6Grid[STATE_B][s] = zero;
+                }
+            }
+
+            RealType qq[NSTATES], c6[NSTATES], c12[NSTATES], ljPmeC6Grid[NSTATES];
+            for (int i = 0; i < NSTATES; i++)
+            {
+                qq[i]          = gmx::load<RealType>(preloadQq[i]);
+                c6[i]          = gmx::load<RealType>(preloadC6[i]);
+                c12[i]         = gmx::load<RealType>(preloadC12[i]);
+                ljPmeC6Grid[i] = gmx::load<RealType>(preloadLjPmeC6Grid[i]);
+            }
+
+            const RealType jx = gmx::load<RealType>(preloadJx);
+            const RealType jy = gmx::load<RealType>(preloadJy);
+            const RealType jz = gmx::load<RealType>(preloadJz);
+
+            const RealType dx  = ix - jx;
+            const RealType dy  = iy - jy;
+            const RealType dz  = iz - jz;
             const RealType rsq = dx * dx + dy * dy + dz * dz;
-            RealType       FscalC[NSTATES], FscalV[NSTATES];
 
-            if (rsq >= rcutoff_max2)
+            const BoolType bPairIsValid   = (gmx::load<RealType>(preloadPairIsValid) != zero);
+            const BoolType bWithinCutoff  = (rsq < rcutoff_max2) && bPairIsValid;
+            const BoolType bPairIncluded  = (gmx::load<RealType>(preloadPairIncluded) != zero);
+            const BoolType bIiEqJnr       = (gmx::load<RealType>(preloadIiEqJnr) != zero);
+            const BoolType bPairNotSkipped = bWithinCutoff && bPairIncluded;
+            const BoolType bPairExcluded   = bWithinCutoff && (gmx::load<RealType>(preloadPairIncluded) == zero);
+
+            if (!gmx::anyTrue(bWithinCutoff))
             {
                 /* We save significant time by skipping all code below.
                  * Note that with soft-core interactions, the actual cut-off
@@ -409,29 +479,22 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                  */
                 continue;
             }
-            npair_within_cutoff++;
-
-            if (rsq > 0)
-            {
-                /* Note that unlike in the nbnxn kernels, we do not need
-                 * to clamp the value of rsq before taking the invsqrt
-                 * to avoid NaN in the LJ calculation, since here we do
-                 * not calculate LJ interactions when C6 and C12 are zero.
-                 */
-
-                rinv = gmx::invsqrt(rsq);
-                r    = rsq * rinv;
-            }
-            else
-            {
-                /* The force at r=0 is zero, because of symmetry.
-                 * But note that the potential is in general non-zero,
-                 * since the soft-cored r will be non-zero.
-                 */
-                rinv = 0;
-                r    = 0;
-            }
-
+            havePairsWithinCutoff = true;
+
+            /* The force at r=0 is zero, because of symmetry.
+             * But note that the potential is in general non-zero,
+             * since the soft-cored r will be non-zero.
+             *
+             * Note that unlike in the nbnxn kernels, we do not need
+             * to clamp the value of rsq before taking the invsqrt
+             * to avoid NaN in the LJ calculation, since here we do
+             * not calculate LJ interactions when C6 and C12 are zero.
+             */
+            const BoolType bRsqNonZero = (zero < rsq);
+            const RealType rinv        = gmx::maskzInvsqrt(rsq, bRsqNonZero);
+            const RealType r           = rsq * rinv;
+
+            RealType rp, rpm2;
             if (useSoftCore)
             {
                 rpm2 = rsq * rsq;  /* r4 */
@@ -444,78 +507,64 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                  * the simplest math and cheapest code.
                  */
                 rpm2 = rinv * rinv;
-                rp   = 1;
+                rp   = one;
             }
 
-            RealType Fscal = 0;
+            RealType Fscal(zero);
 
-            qq[STATE_A] = iqA * chargeA[jnr];
-            qq[STATE_B] = iqB * chargeB[jnr];
-
-            tj[STATE_A] = ntiA + 2 * typeA[jnr];
-            tj[STATE_B] = ntiB + 2 * typeB[jnr];
-
-            if (nlist->excl_fep == nullptr || nlist->excl_fep[k])
+            if (gmx::anyTrue(bPairNotSkipped))
             {
-                c6[STATE_A] = nbfp[tj[STATE_A]];
-                c6[STATE_B] = nbfp[tj[STATE_B]];
-
-                for (int i = 0; i < NSTATES; i++)
+                RealType sigma6[NSTATES];
+                RealType alpha_vdw_eff(zero);
+                RealType alpha_coul_eff(zero);
+                if (useSoftCore)
                 {
-                    c12[i] = nbfp[tj[i] + 1];
-                    if (useSoftCore)
+                    for (int i = 0; i < NSTATES; i++)
                     {
-                        if ((c6[i] > 0) && (c12[i] > 0))
-                        {
-                            /* c12 is stored scaled with 12.0 and c6 is scaled with 6.0 - correct for this */
-                            sigma6[i] = half * c12[i] / c6[i];
-                            if (sigma6[i] < sigma6_min) /* for disappearing coul and vdw with soft core at the same time */
-                            {
-                                sigma6[i] = sigma6_min;
-                            }
-                        }
-                        else
-                        {
-                            sigma6[i] = sigma6_def;
-                        }
+                        const BoolType bC6C12NonZero = (zero < c6[i]) && (zero < c12[i]);
+                        /* c12 is stored scaled with 12.0 and c6 is scaled with 6.0 - correct for this.
+                         * Clamp to sigma6_min for disappearing coul and vdw with soft core at the
+                         * same time; lanes where c6 or c12 is zero get sigma6_def instead.
+                         */
+                        sigma6[i] = gmx::blend(
+                                RealType(sigma6_def),
+                                gmx::max(half * c12[i] * gmx::maskzInv(c6[i], bC6C12NonZero),
+                                         RealType(sigma6_min)),
+                                bC6C12NonZero);
                     }
-                }
 
-                if (useSoftCore)
-                {
                     /* only use softcore if one of the states has a zero endstate - softcore is for avoiding infinities!*/
-                    if ((c12[STATE_A] > 0) && (c12[STATE_B] > 0))
-                    {
-                        alpha_vdw_eff  = 0;
-                        alpha_coul_eff = 0;
-                    }
-                    else
-                    {
-                        alpha_vdw_eff  = alpha_vdw;
-                        alpha_coul_eff = alpha_coul;
-                    }
+                    const BoolType bBothStatesHaveRepulsion =
+                            (zero < c12[STATE_A]) && (zero < c12[STATE_B]);
+                    alpha_vdw_eff  = gmx::selectByNotMask(RealType(alpha_vdw), bBothStatesHaveRepulsion);
+                    alpha_coul_eff = gmx::selectByNotMask(RealType(alpha_coul), bBothStatesHaveRepulsion);
                 }
 
+                RealType FscalC[NSTATES], FscalV[NSTATES], Vcoul[NSTATES], Vvdw[NSTATES];
                 for (int i = 0; i < NSTATES; i++)
                 {
-                    FscalC[i] = 0;
-                    FscalV[i] = 0;
-                    Vcoul[i]  = 0;
-                    Vvdw[i]   = 0;
+                    FscalC[i] = zero;
+                    FscalV[i] = zero;
+                    Vcoul[i]  = zero;
+                    Vvdw[i]   = zero;
 
-                    RealType rinvC, rinvV, rC, rV, rpinvC, rpinvV;
+                    RealType rinvC(zero), rinvV(zero), rC(zero), rV(zero), rpinvC(zero), rpinvV(zero);
 
                     /* Only spend time on A or B state if it is non-zero */
-                    if ((qq[i] != 0) || (c6[i] != 0) || (c12[i] != 0))
+                    const BoolType bNonZeroState =
+                            ((qq[i] != zero) || (c6[i] != zero) || (c12[i] != zero)) && bPairNotSkipped;
+                    if (gmx::anyTrue(bNonZeroState))
                     {
                         /* this section has to be inside the loop because of the dependence on sigma6 */
                         if (useSoftCore)
                         {
-                            rpinvC = one / (alpha_coul_eff * lfac_coul[i] * sigma6[i] + rp);
+                            rpinvC = gmx::maskzInv(alpha_coul_eff * lfac_coul[i] * sigma6[i] + rp,
+                                                   bNonZeroState);
                             pthRoot(rpinvC, &rinvC, &rC);
                             if (scLambdasOrAlphasDiffer)
                             {
-                                rpinvV = one / (alpha_vdw_eff * lfac_vdw[i] * sigma6[i] + rp);
+                                rpinvV = gmx::maskzInv(alpha_vdw_eff * lfac_vdw[i] * sigma6[i] + rp,
+                                                       bNonZeroState);
                                 pthRoot(rpinvV, &rinvV, &rV);
                             }
                             else
@@ -528,11 +577,11 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                         }
                         else
                         {
-                            rpinvC = 1;
+                            rpinvC = one;
                             rinvC  = rinv;
                             rC     = r;
 
-                            rpinvV = 1;
+                            rpinvV = one;
                             rinvV  = rinv;
                             rV     = r;
                         }
@@ -541,10 +590,11 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                          * and if we either include all entries in the list (no cutoff
                          * used in the kernel), or if we are within the cutoff.
                          */
-                        bool computeElecInteraction = (elecInteractionTypeIsEwald && r < rcoulomb)
-                                                      || (!elecInteractionTypeIsEwald && rC < rcoulomb);
-
-                        if ((qq[i] != 0) && computeElecInteraction)
+                        const BoolType computeElecInteraction =
+                                elecInteractionTypeIsEwald ? (r < rcoulomb) : (rC < rcoulomb);
+                        const BoolType bComputeElecInteraction =
+                                (qq[i] != zero) && computeElecInteraction && bNonZeroState;
+                        if (gmx::anyTrue(bComputeElecInteraction))
                         {
                             if (elecInteractionTypeIsEwald)
                             {
@@ -556,6 +606,8 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                                 Vcoul[i]  = reactionFieldPotential(qq[i], rinvC, rC, krf, crf);
                                 FscalC[i] = reactionFieldScalarForce(qq[i], rinvC, rC, krf, two);
                             }
+                            Vcoul[i]  = gmx::selectByMask(Vcoul[i], bComputeElecInteraction);
+                            FscalC[i] = gmx::selectByMask(FscalC[i], bComputeElecInteraction);
                         }
 
                         /* Only process the VDW interactions if we have
@@ -563,9 +615,12 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                          * include all entries in the list (no cutoff used
                          * in the kernel), or if we are within the cutoff.
                          */
-                        bool computeVdwInteraction = (vdwInteractionTypeIsEwald && r < rvdw)
-                                                     || (!vdwInteractionTypeIsEwald && rV < rvdw);
-                        if ((c6[i] != 0 || c12[i] != 0) && computeVdwInteraction)
+                        const BoolType computeVdwInteraction =
+                                vdwInteractionTypeIsEwald ? (r < rvdw) : (rV < rvdw);
+                        const BoolType bComputeVdwInteraction =
+                                ((c6[i] != zero) || (c12[i] != zero)) && computeVdwInteraction
+                                && bNonZeroState;
+                        if (gmx::anyTrue(bComputeVdwInteraction))
                         {
                             RealType rinv6;
                             if (useSoftCore)
@@ -586,23 +641,27 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                             if (vdwInteractionTypeIsEwald)
                             {
                                 /* Subtract the grid potential at the cut-off */
-                                Vvdw[i] += ewaldLennardJonesGridSubtract(nbfp_grid[tj[i]],
-                                                                         sh_lj_ewald, onesixth);
+                                Vvdw[i] = Vvdw[i]
+                                          + ewaldLennardJonesGridSubtract(ljPmeC6Grid[i],
+                                                                          sh_lj_ewald, onesixth);
                             }
 
                             if (vdwModifierIsPotSwitch)
                             {
                                 RealType d        = rV - ic->rvdw_switch;
-                                d                 = (d > zero) ? d : zero;
+                                d                 = gmx::max(d, RealType(zero));
                                 const RealType d2 = d * d;
                                 const RealType sw =
                                         one + d2 * d * (vdw_swV3 + d * (vdw_swV4 + d * vdw_swV5));
                                 const RealType dsw = d2 * (vdw_swF2 + d * (vdw_swF3 + d * vdw_swF4));
 
-                                FscalV[i] = potSwitchScalarForceMod(FscalV[i], Vvdw[i], sw, rV,
-                                                                    rvdw, dsw, zero);
-                                Vvdw[i]   = potSwitchPotentialMod(Vvdw[i], sw, rV, rvdw, zero);
+                                const BoolType bWithinVdwCutoff = (rV < rvdw);
+                                FscalV[i] = potSwitchScalarForceMod(FscalV[i], Vvdw[i], sw, rV, dsw,
+                                                                    bWithinVdwCutoff);
+                                Vvdw[i]   = potSwitchPotentialMod(Vvdw[i], sw, bWithinVdwCutoff);
                             }
+                            Vvdw[i]   = gmx::selectByMask(Vvdw[i], bComputeVdwInteraction);
+                            FscalV[i] = gmx::selectByMask(FscalV[i], bComputeVdwInteraction);
                         }
 
                         /* FscalC (and FscalV) now contain: dV/drC * rC
@@ -610,151 +669,170 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                          * Further down we first multiply by r^p-2 and then by
                          * the vector r, which in total gives: dV/drC * (r/rC)^1-p
                          */
-                        FscalC[i] *= rpinvC;
-                        FscalV[i] *= rpinvV;
+                        FscalC[i] = FscalC[i] * rpinvC;
+                        FscalV[i] = FscalV[i] * rpinvV;
                     }
                 }
 
                 /* Assemble A and B states */
                 for (int i = 0; i < NSTATES; i++)
                 {
-                    vctot += LFC[i] * Vcoul[i];
-                    vvtot += LFV[i] * Vvdw[i];
+                    vctot = vctot + LFC[i] * Vcoul[i];
+                    vvtot = vvtot + LFV[i] * Vvdw[i];
 
-                    Fscal += LFC[i] * FscalC[i] * rpm2;
-                    Fscal += LFV[i] * FscalV[i] * rpm2;
+                    Fscal = Fscal + LFC[i] * FscalC[i] * rpm2;
+                    Fscal = Fscal + LFV[i] * FscalV[i] * rpm2;
 
                     if (useSoftCore)
                     {
-                        dvdl_coul += Vcoul[i] * DLF[i]
-                                     + LFC[i] * alpha_coul_eff * dlfac_coul[i] * FscalC[i] * sigma6[i];
-                        dvdl_vdw += Vvdw[i] * DLF[i]
-                                    + LFV[i] * alpha_vdw_eff * dlfac_vdw[i] * FscalV[i] * sigma6[i];
+                        dvdl_coul = dvdl_coul + Vcoul[i] * DLF[i]
+                                    + LFC[i] * alpha_coul_eff * dlfac_coul[i] * FscalC[i] * sigma6[i];
+                        dvdl_vdw = dvdl_vdw + Vvdw[i] * DLF[i]
+                                   + LFV[i] * alpha_vdw_eff * dlfac_vdw[i] * FscalV[i] * sigma6[i];
                     }
                     else
                     {
-                        dvdl_coul += Vcoul[i] * DLF[i];
-                        dvdl_vdw += Vvdw[i] * DLF[i];
+                        dvdl_coul = dvdl_coul + Vcoul[i] * DLF[i];
+                        dvdl_vdw  = dvdl_vdw + Vvdw[i] * DLF[i];
                     }
                 }
             }
-            else if (icoul == GMX_NBKERNEL_ELEC_REACTIONFIELD)
+
+            if (icoul == GMX_NBKERNEL_ELEC_REACTIONFIELD && gmx::anyTrue(bPairExcluded))
             {
                 /* For excluded pairs, which are only in this pair list when
                  * using the Verlet scheme, we don't use soft-core.
                  * As there is no singularity, there is no need for soft-core.
                  */
-                const real FF = -two * krf;
-                RealType   VV = krf * rsq - crf;
+                const RealType FF = gmx::selectByMask(RealType(-two * krf), bPairExcluded);
+                RealType       VV = krf * rsq - crf;
 
-                if (ii == jnr)
-                {
-                    VV *= half;
-                }
+                /* Self-interactions appear twice in the list; scale them
+                 * down by 50% to only include them once.
+                 */
+                VV = VV * gmx::blend(RealType(one), RealType(half), bIiEqJnr);
+                VV = gmx::selectByMask(VV, bPairExcluded);
 
                 for (int i = 0; i < NSTATES; i++)
                 {
-                    vctot += LFC[i] * qq[i] * VV;
-                    Fscal += LFC[i] * qq[i] * FF;
-                    dvdl_coul += DLF[i] * qq[i] * VV;
+                    vctot     = vctot + LFC[i] * qq[i] * VV;
+                    Fscal     = Fscal + LFC[i] * qq[i] * FF;
+                    dvdl_coul = dvdl_coul + DLF[i] * qq[i] * VV;
                 }
             }
 
-            if (elecInteractionTypeIsEwald && r < rcoulomb)
+            if (elecInteractionTypeIsEwald)
             {
-                /* See comment in the preamble. When using Ewald interactions
-                 * (unless we use a switch modifier) we subtract the reciprocal-space
-                 * Ewald component here which made it possible to apply the free
-                 * energy interaction to 1/r (vanilla coulomb short-range part)
-                 * above. This gets us closer to the ideal case of applying
-                 * the softcore to the entire electrostatic interaction,
-                 * including the reciprocal-space component.
-                 */
-                real v_lr, f_lr;
-
-                const RealType ewrt   = r * ewtabscale;
-                IntType        ewitab = static_cast<IntType>(ewrt);
-                const RealType eweps  = ewrt - ewitab;
-                ewitab                = 4 * ewitab;
-                f_lr                  = ewtab[ewitab] + eweps * ewtab[ewitab + 1];
-                v_lr = (ewtab[ewitab + 2] - ewtabhalfspace * eweps * (ewtab[ewitab] + f_lr));
-                f_lr *= rinv;
-
-                /* Note that any possible Ewald shift has already been applied in
-                 * the normal interaction part above.
-                 */
-
-                if (ii == jnr)
+                const BoolType bComputeEwaldInteraction = (r < rcoulomb) && bWithinCutoff;
+                if (gmx::anyTrue(bComputeEwaldInteraction))
                 {
-                    /* If we get here, the i particle (ii) has itself (jnr)
+                    /* See comment in the preamble. When using Ewald interactions
+                     * (unless we use a switch modifier) we subtract the reciprocal-space
+                     * Ewald component here which made it possible to apply the free
+                     * energy interaction to 1/r (vanilla coulomb short-range part)
+                     * above. This gets us closer to the ideal case of applying
+                     * the softcore to the entire electrostatic interaction,
+                     * including the reciprocal-space component.
+                     */
+
+                    /* Lanes without Ewald correction are given table index 0;
+                     * their contributions are masked out below.
+                     */
+                    const RealType ewrt = gmx::selectByMask(r, bComputeEwaldInteraction) * ewtabscale;
+                    const IntType  ewitab = gmx::cvttR2I(ewrt);
+                    const RealType eweps  = ewrt - gmx::cvtI2R(ewitab);
+
+                    RealType ewtabF, ewtabD, ewtabV, ewtabZero;
+                    gmx::gatherLoadBySimdIntTranspose<4>(ewtab, ewitab, &ewtabF, &ewtabD, &ewtabV,
+                                                         &ewtabZero);
+                    RealType f_lr = ewtabF + eweps * ewtabD;
+                    RealType v_lr = ewtabV - ewtabhalfspace * eweps * (ewtabF + f_lr);
+                    f_lr          = f_lr * rinv;
+
+                    /* Note that any possible Ewald shift has already been applied in
+                     * the normal interaction part above.
+                     */
+
+                    /* If ii == jnr, the i particle (ii) has itself (jnr)
                      * in its neighborlist. This can only happen with the Verlet
                      * scheme, and corresponds to a self-interaction that will
                      * occur twice. Scale it down by 50% to only include it once.
                      */
-                    v_lr *= half;
-                }
+                    v_lr = v_lr * gmx::blend(RealType(one), RealType(half), bIiEqJnr);
 
-                for (int i = 0; i < NSTATES; i++)
-                {
-                    vctot -= LFC[i] * qq[i] * v_lr;
-                    Fscal -= LFC[i] * qq[i] * f_lr;
-                    dvdl_coul -= (DLF[i] * qq[i]) * v_lr;
+                    v_lr = gmx::selectByMask(v_lr, bComputeEwaldInteraction);
+                    f_lr = gmx::selectByMask(f_lr, bComputeEwaldInteraction);
+
+                    for (int i = 0; i < NSTATES; i++)
+                    {
+                        vctot     = vctot - LFC[i] * qq[i] * v_lr;
+                        Fscal     = Fscal - LFC[i] * qq[i] * f_lr;
+                        dvdl_coul = dvdl_coul - (DLF[i] * qq[i]) * v_lr;
+                    }
                 }
             }
 
-            if (vdwInteractionTypeIsEwald && r < rvdw)
+            if (vdwInteractionTypeIsEwald)
             {
-                /* See comment in the preamble. When using LJ-Ewald interactions
-                 * (unless we use a switch modifier) we subtract the reciprocal-space
-                 * Ewald component here which made it possible to apply the free
-                 * energy interaction to r^-6 (vanilla LJ6 short-range part)
-                 * above. This gets us closer to the ideal case of applying
-                 * the softcore to the entire VdW interaction,
-                 * including the reciprocal-space component.
-                 */
-                /* We could also use the analytical form here
-                 * iso a table, but that can cause issues for
-                 * r close to 0 for non-interacting pairs.
-                 */
+                const BoolType bComputeVdwEwaldInteraction = (r < rvdw) && bWithinCutoff;
+                if (gmx::anyTrue(bComputeVdwEwaldInteraction))
+                {
+                    /* See comment in the preamble. When using LJ-Ewald interactions
+                     * (unless we use a switch modifier) we subtract the reciprocal-space
+                     * Ewald component here which made it possible to apply the free
+                     * energy interaction to r^-6 (vanilla LJ6 short-range part)
+                     * above. This gets us closer to the ideal case of applying
+                     * the softcore to the entire VdW interaction,
+                     * including the reciprocal-space component.
+                     */
+                    /* We could also use the analytical form here
+                     * iso a table, but that can cause issues for
+                     * r close to 0 for non-interacting pairs.
+                     */
 
-                const RealType rs   = rsq * rinv * ewtabscale;
-                const IntType  ri   = static_cast<IntType>(rs);
-                const RealType frac = rs - ri;
-                const RealType f_lr = (1 - frac) * tab_ewald_F_lj[ri] + frac * tab_ewald_F_lj[ri + 1];
-                /* TODO: Currently the Ewald LJ table does not contain
-                 * the factor 1/6, we should add this.
-                 */
-                const RealType FF = f_lr * rinv / six;
-                RealType       VV =
-                        (tab_ewald_V_lj[ri] - ewtabhalfspace * frac * (tab_ewald_F_lj[ri] + f_lr)) / six;
+                    const RealType rs =
+                            gmx::selectByMask(rsq * rinv, bComputeVdwEwaldInteraction) * ewtabscale;
+                    const IntType  ri   = gmx::cvttR2I(rs);
+                    const RealType frac = rs - gmx::cvtI2R(ri);
 
-                if (ii == jnr)
-                {
-                    /* If we get here, the i particle (ii) has itself (jnr)
+                    RealType fljTab0, fljTab1;
+                    gmx::gatherLoadUBySimdIntTranspose<1>(tab_ewald_F_lj, ri, &fljTab0, &fljTab1);
+                    const RealType f_lr = (one - frac) * fljTab0 + frac * fljTab1;
+                    /* TODO: Currently the Ewald LJ table does not contain
+                     * the factor 1/6, we should add this.
+                     */
+                    RealType FF = f_lr * rinv * onesixth;
+                    RealType vljTab0, vljTab1;
+                    gmx::gatherLoadUBySimdIntTranspose<1>(tab_ewald_V_lj, ri, &vljTab0, &vljTab1);
+                    RealType VV = (vljTab0 - ewtabhalfspace * frac * (fljTab0 + f_lr)) * onesixth;
+
+                    /* If ii == jnr, the i particle (ii) has itself (jnr)
                      * in its neighborlist. This can only happen with the Verlet
                      * scheme, and corresponds to a self-interaction that will
                      * occur twice. Scale it down by 50% to only include it once.
                      */
-                    VV *= half;
-                }
+                    VV = VV * gmx::blend(RealType(one), RealType(half), bIiEqJnr);
 
-                for (int i = 0; i < NSTATES; i++)
-                {
-                    const real c6grid = nbfp_grid[tj[i]];
-                    vvtot += LFV[i] * c6grid * VV;
-                    Fscal += LFV[i] * c6grid * FF;
-                    dvdl_vdw += (DLF[i] * c6grid) * VV;
+                    VV = gmx::selectByMask(VV, bComputeVdwEwaldInteraction);
+                    FF = gmx::selectByMask(FF, bComputeVdwEwaldInteraction);
+
+                    for (int i = 0; i < NSTATES; i++)
+                    {
+                        vvtot    = vvtot + LFV[i] * ljPmeC6Grid[i] * VV;
+                        Fscal    = Fscal + LFV[i] * ljPmeC6Grid[i] * FF;
+                        dvdl_vdw = dvdl_vdw + (DLF[i] * ljPmeC6Grid[i]) * VV;
+                    }
                 }
             }
 
             if (doForces)
             {
-                const real tx = Fscal * dx;
-                const real ty = Fscal * dy;
-                const real tz = Fscal * dz;
-                fix           = fix + tx;
-                fiy           = fiy + ty;
-                fiz           = fiz + tz;
+                const RealType tx = Fscal * dx;
+                const RealType ty = Fscal * dy;
+                const RealType tz = Fscal * dz;
+                fix               = fix + tx;
+                fiy               = fiy + ty;
+                fiz               = fiz + tz;
                 /* OpenMP atomics are expensive, but this kernels is also
                  * expensive, so we can take this hit, instead of using
                  * thread-local output buffers and extra reduction.
@@ -762,12 +840,22 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                  * All the OpenMP regions in this file are trivial and should
                  * not throw, so no need for try/catch.
                  */
+                alignas(GMX_SIMD_ALIGNMENT) real transferTx[simdRealWidth];
+                alignas(GMX_SIMD_ALIGNMENT) real transferTy[simdRealWidth];
+                alignas(GMX_SIMD_ALIGNMENT) real transferTz[simdRealWidth];
+                gmx::store(transferTx, tx);
+                gmx::store(transferTy, ty);
+                gmx::store(transferTz, tz);
+                for (int s = 0; s < simdRealWidth && k + s < nj1; s++)
+                {
+                    const int j3 = 3 * jnrs[s];
 #pragma omp atomic
-                f[j3] -= tx;
+                    f[j3] -= transferTx[s];
 #pragma omp atomic
-                f[j3 + 1] -= ty;
+                    f[j3 + 1] -= transferTy[s];
 #pragma omp atomic
-                f[j3 + 2] -= tz;
+                    f[j3 + 2] -= transferTz[s];
+                }
             }
         }
 
@@ -776,41 +864,44 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
          * (perturbed) j-particles in the list. Thus with a buffered list
          * we can skip a significant number of i-reductions with a check.
          */
-        if (npair_within_cutoff > 0)
+        if (havePairsWithinCutoff)
         {
+            const real fixSum = gmx::reduce(fix);
+            const real fiySum = gmx::reduce(fiy);
+            const real fizSum = gmx::reduce(fiz);
             if (doForces)
             {
 #pragma omp atomic
-                f[ii3] += fix;
+                f[ii3] += fixSum;
 #pragma omp atomic
-                f[ii3 + 1] += fiy;
+                f[ii3 + 1] += fiySum;
 #pragma omp atomic
-                f[ii3 + 2] += fiz;
+                f[ii3 + 2] += fizSum;
             }
             if (doShiftForces)
             {
 #pragma omp atomic
-                fshift[is3] += fix;
+                fshift[is3] += fixSum;
 #pragma omp atomic
-                fshift[is3 + 1] += fiy;
+                fshift[is3 + 1] += fiySum;
 #pragma omp atomic
-                fshift[is3 + 2] += fiz;
+                fshift[is3 + 2] += fizSum;
             }
             if (doPotential)
             {
                 int ggid = gid[n];
 #pragma omp atomic
-                Vc[ggid] += vctot;
+                Vc[ggid] += gmx::reduce(vctot);
 #pragma omp atomic
-                Vv[ggid] += vvtot;
+                Vv[ggid] += gmx::reduce(vvtot);
             }
         }
     }
 
 #pragma omp atomic
-    dvdl[efptCOUL] += dvdl_coul;
+    dvdl[efptCOUL] += gmx::reduce(dvdl_coul);
 #pragma omp atomic
-    dvdl[efptVDW] += dvdl_vdw;
+    dvdl[efptVDW] += gmx::reduce(dvdl_vdw);
 
     /* Estimate flops, average for free energy stuff:
      * 12  flops per outer iteration
@@ -820,6 +911,401 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
     inc_nrnb(nrnb, eNR_NBKERNEL_FREE_ENERGY, nlist->nri * 12 + nlist->jindex[nri] * 150);
 }
 
+/* Batched energy-only version of the free-energy kernel, which computes the
+ * soft-core perturbed energies for numLambdaSets sets of lambda values in a
+ * single pass over the pair list, with one pair of accumulators per set. The
+ * pair geometry and the parameter lookups are thus done once instead of once
+ * per lambda set, so many foreign lambdas do not multiply the pair-list cost.
+ * Only the potential is needed for the foreign-lambda energy differences, so
+ * no forces or lambda derivatives are computed. Soft-core has to be active,
+ * otherwise the foreign energies follow by linear interpolation and no
+ * recalculation is needed at all.
+ */
+template<bool vdwInteractionTypeIsEwald, bool elecInteractionTypeIsEwald, bool vdwModifierIsPotSwitch>
+static void nb_free_energy_foreign_kernel(const t_nblist* gmx_restrict nlist,
+                                          rvec* gmx_restrict xx,
+                                          const t_forcerec* gmx_restrict fr,
+                                          const t_mdatoms* gmx_restrict mdatoms,
+                                          const int                numLambdaSets,
+                                          const real* gmx_restrict lambdaSets,
+                                          real* gmx_restrict       vCoulombSets,
+                                          real* gmx_restrict       vVdwSets,
+                                          t_nrnb* gmx_restrict     nrnb)
+{
+    constexpr real onetwelfth = 1.0 / 12.0;
+    constexpr real onesixth   = 1.0 / 6.0;
+    constexpr real zero       = 0.0;
+    constexpr real half       = 0.5;
+    constexpr real one        = 1.0;
+    constexpr real six        = 6.0;
+
+    /* Extract pointer to non-bonded interaction constants */
+    const interaction_const_t* ic = fr->ic;
+
+    // Extract pair list data
+    const int  nri    = nlist->nri;
+    const int* iinr   = nlist->iinr;
+    const int* jindex = nlist->jindex;
+    const int* jjnr   = nlist->jjnr;
+    const int* shift  = nlist->shift;
+
+    const real* shiftvec   = fr->shift_vec[0];
+    const real* chargeA    = mdatoms->chargeA;
+    const real* chargeB    = mdatoms->chargeB;
+    const int*  typeA      = mdatoms->typeA;
+    const int*  typeB      = mdatoms->typeB;
+    const int   ntype      = fr->ntype;
+    const real* nbfp       = fr->nbfp.data();
+    const real* nbfp_grid  = fr->ljpme_c6grid;
+    const real  alpha_coul = fr->sc_alphacoul;
+    const real  alpha_vdw  = fr->sc_alphavdw;
+    const real  lam_power  = fr->sc_power;
+    const real  sigma6_def = fr->sc_sigma6_def;
+    const real  sigma6_min = fr->sc_sigma6_min;
+
+    // Extract data from interaction_const_t
+    const real facel           = ic->epsfac;
+    const real rcoulomb        = ic->rcoulomb;
+    const real krf             = ic->k_rf;
+    const real crf             = ic->c_rf;
+    const real sh_lj_ewald     = ic->sh_lj_ewald;
+    const real rvdw            = ic->rvdw;
+    const real dispersionShift = ic->dispersion_shift.cpot;
+    const real repulsionShift  = ic->repulsion_shift.cpot;
+
+    real vdw_swV3, vdw_swV4, vdw_swV5;
+    if (vdwModifierIsPotSwitch)
+    {
+        const real d = ic->rvdw - ic->rvdw_switch;
+        vdw_swV3     = -10.0 / (d * d * d);
+        vdw_swV4     = 15.0 / (d * d * d * d);
+        vdw_swV5     = -6.0 / (d * d * d * d * d);
+    }
+    else
+    {
+        /* Avoid warnings from stupid compilers (looking at you, Clang!) */
+        vdw_swV3 = vdw_swV4 = vdw_swV5 = 0.0;
+    }
+
+    int icoul;
+    if (ic->eeltype == eelCUT || EEL_RF(ic->eeltype))
+    {
+        icoul = GMX_NBKERNEL_ELEC_REACTIONFIELD;
+    }
+    else
+    {
+        icoul = GMX_NBKERNEL_ELEC_NONE;
+    }
+
+    real rcutoff_max2 = std::max(ic->rcoulomb, ic->rvdw);
+    rcutoff_max2      = rcutoff_max2 * rcutoff_max2;
+
+    const real* tab_ewald_F_lj = nullptr;
+    const real* tab_ewald_V_lj = nullptr;
+    const real* ewtab          = nullptr;
+    real        ewtabscale     = 0;
+    real        ewtabhalfspace = 0;
+    real        sh_ewald       = 0;
+    if (elecInteractionTypeIsEwald || vdwInteractionTypeIsEwald)
+    {
+        const auto& tables = *ic->coulombEwaldTables;
+        sh_ewald           = ic->sh_ewald;
+        ewtab              = tables.tableFDV0.data();
+        ewtabscale         = tables.scale;
+        ewtabhalfspace     = half / ewtabscale;
+        tab_ewald_F_lj     = tables.tableF.data();
+        tab_ewald_V_lj     = tables.tableV.data();
+    }
+
+    /* See the comment in nb_free_energy_kernel on Ewald with soft-core */
+    GMX_RELEASE_ASSERT(!(vdwInteractionTypeIsEwald && vdwModifierIsPotSwitch),
+                       "Can not apply soft-core to switched Ewald potentials");
+
+    /* The lambda factors for all sets, layout [set][NSTATES] */
+    std::vector<real> LFC(numLambdaSets * NSTATES);
+    std::vector<real> LFV(numLambdaSets * NSTATES);
+    std::vector<real> lfac_coul(numLambdaSets * NSTATES);
+    std::vector<real> lfac_vdw(numLambdaSets * NSTATES);
+    for (int s = 0; s < numLambdaSets; s++)
+    {
+        const real lambda_coul = lambdaSets[s * efptNR + efptCOUL];
+        const real lambda_vdw  = lambdaSets[s * efptNR + efptVDW];
+
+        LFC[s * NSTATES + STATE_A] = one - lambda_coul;
+        LFV[s * NSTATES + STATE_A] = one - lambda_vdw;
+        LFC[s * NSTATES + STATE_B] = lambda_coul;
+        LFV[s * NSTATES + STATE_B] = lambda_vdw;
+
+        for (int i = 0; i < NSTATES; i++)
+        {
+            const real lfc = LFC[s * NSTATES + i];
+            const real lfv = LFV[s * NSTATES + i];
+
+            lfac_coul[s * NSTATES + i] = (lam_power == 2 ? (1 - lfc) * (1 - lfc) : (1 - lfc));
+            lfac_vdw[s * NSTATES + i]  = (lam_power == 2 ? (1 - lfv) * (1 - lfv) : (1 - lfv));
+        }
+    }
+
+    /* Thread-local energy accumulators per lambda set, reduced at the end */
+    std::vector<real> vctot(numLambdaSets, 0.0_real);
+    std::vector<real> vvtot(numLambdaSets, 0.0_real);
+
+    const real* x = xx[0];
+
+    for (int n = 0; n < nri; n++)
+    {
+        const int  is3  = 3 * shift[n];
+        const real shX  = shiftvec[is3];
+        const real shY  = shiftvec[is3 + 1];
+        const real shZ  = shiftvec[is3 + 2];
+        const int  nj0  = jindex[n];
+        const int  nj1  = jindex[n + 1];
+        const int  ii   = iinr[n];
+        const int  ii3  = 3 * ii;
+        const real ix   = shX + x[ii3 + 0];
+        const real iy   = shY + x[ii3 + 1];
+        const real iz   = shZ + x[ii3 + 2];
+        const real iqA  = facel * chargeA[ii];
+        const real iqB  = facel * chargeB[ii];
+        const int  ntiA = 2 * ntype * typeA[ii];
+        const int  ntiB = 2 * ntype * typeB[ii];
+
+        for (int k = nj0; k < nj1; k++)
+        {
+            int        tj[NSTATES];
+            const int  jnr = jjnr[k];
+            const int  j3  = 3 * jnr;
+            real       c6[NSTATES], c12[NSTATES], qq[NSTATES], sigma6[NSTATES];
+            real       r, rinv;
+            real       alpha_vdw_eff, alpha_coul_eff;
+            const real dx  = ix - x[j3];
+            const real dy  = iy - x[j3 + 1];
+            const real dz  = iz - x[j3 + 2];
+            const real rsq = dx * dx + dy * dy + dz * dz;
+
+            if (rsq >= rcutoff_max2)
+            {
+                /* As in the force kernel, we can skip everything. */
+                continue;
+            }
+
+            if (rsq > 0)
+            {
+                rinv = gmx::invsqrt(rsq);
+                r    = rsq * rinv;
+            }
+            else
+            {
+                /* See the corresponding comment in nb_free_energy_kernel */
+                rinv = 0;
+                r    = 0;
+            }
+
+            /* With soft-core we always use the power p = 6 of the distance */
+            const real rp = rsq * rsq * rsq; /* r6 */
+
+            qq[STATE_A] = iqA * chargeA[jnr];
+            qq[STATE_B] = iqB * chargeB[jnr];
+
+            tj[STATE_A] = ntiA + 2 * typeA[jnr];
+            tj[STATE_B] = ntiB + 2 * typeB[jnr];
+
+            if (nlist->excl_fep == nullptr || nlist->excl_fep[k])
+            {
+                c6[STATE_A] = nbfp[tj[STATE_A]];
+                c6[STATE_B] = nbfp[tj[STATE_B]];
+
+                for (int i = 0; i < NSTATES; i++)
+                {
+                    c12[i] = nbfp[tj[i] + 1];
+                    if ((c6[i] > 0) && (c12[i] > 0))
+                    {
+                        /* c12 is stored scaled with 12.0 and c6 is scaled with 6.0 - correct for this */
+                        sigma6[i] = half * c12[i] / c6[i];
+                        if (sigma6[i] < sigma6_min) /* for disappearing coul and vdw with soft core at the same time */
+                        {
+                            sigma6[i] = sigma6_min;
+                        }
+                    }
+                    else
+                    {
+                        sigma6[i] = sigma6_def;
+                    }
+                }
+
+                /* only use softcore if one of the states has a zero endstate - softcore is for avoiding infinities!*/
+                if ((c12[STATE_A] > 0) && (c12[STATE_B] > 0))
+                {
+                    alpha_vdw_eff  = 0;
+                    alpha_coul_eff = 0;
+                }
+                else
+                {
+                    alpha_vdw_eff  = alpha_vdw;
+                    alpha_coul_eff = alpha_coul;
+                }
+
+                /* The interaction parameters above do not depend on lambda,
+                 * so they are computed once for all lambda sets.
+                 */
+                for (int s = 0; s < numLambdaSets; s++)
+                {
+                    for (int i = 0; i < NSTATES; i++)
+                    {
+                        /* Only spend time on A or B state if it is non-zero */
+                        if ((qq[i] != 0) || (c6[i] != 0) || (c12[i] != 0))
+                        {
+                            real rinvC, rC, rinvV, rV;
+
+                            const real rpinvC =
+                                    one / (alpha_coul_eff * lfac_coul[s * NSTATES + i] * sigma6[i] + rp);
+                            pthRoot(rpinvC, &rinvC, &rC);
+                            const real rpinvV =
+                                    one / (alpha_vdw_eff * lfac_vdw[s * NSTATES + i] * sigma6[i] + rp);
+                            pthRoot(rpinvV, &rinvV, &rV);
+
+                            bool computeElecInteraction =
+                                    (elecInteractionTypeIsEwald && r < rcoulomb)
+                                    || (!elecInteractionTypeIsEwald && rC < rcoulomb);
+
+                            if ((qq[i] != 0) && computeElecInteraction)
+                            {
+                                real vCoul;
+                                if (elecInteractionTypeIsEwald)
+                                {
+                                    vCoul = ewaldPotential(qq[i], rinvC, sh_ewald);
+                                }
+                                else
+                                {
+                                    vCoul = reactionFieldPotential(qq[i], rinvC, rC, krf, crf);
+                                }
+                                vctot[s] += LFC[s * NSTATES + i] * vCoul;
+                            }
+
+                            bool computeVdwInteraction = (vdwInteractionTypeIsEwald && r < rvdw)
+                                                         || (!vdwInteractionTypeIsEwald && rV < rvdw);
+                            if ((c6[i] != 0 || c12[i] != 0) && computeVdwInteraction)
+                            {
+                                const real rinv6  = rpinvV;
+                                const real vVdw6  = calculateVdw6(c6[i], rinv6);
+                                const real vVdw12 = calculateVdw12(c12[i], rinv6);
+
+                                real vVdw = lennardJonesPotential(vVdw6, vVdw12, c6[i], c12[i], repulsionShift,
+                                                                  dispersionShift, onesixth, onetwelfth);
+
+                                if (vdwInteractionTypeIsEwald)
+                                {
+                                    /* Subtract the grid potential at the cut-off */
+                                    vVdw += ewaldLennardJonesGridSubtract(nbfp_grid[tj[i]],
+                                                                          sh_lj_ewald, onesixth);
+                                }
+
+                                if (vdwModifierIsPotSwitch)
+                                {
+                                    real d        = rV - ic->rvdw_switch;
+                                    d             = (d > zero) ? d : zero;
+                                    const real d2 = d * d;
+                                    const real sw =
+                                            one + d2 * d * (vdw_swV3 + d * (vdw_swV4 + d * vdw_swV5));
+
+                                    vVdw = potSwitchPotentialMod(vVdw, sw, rV < rvdw);
+                                }
+
+                                vvtot[s] += LFV[s * NSTATES + i] * vVdw;
+                            }
+                        }
+                    }
+                }
+            }
+            else if (icoul == GMX_NBKERNEL_ELEC_REACTIONFIELD)
+            {
+                /* For excluded pairs we don't use soft-core, see the force kernel */
+                real VV = krf * rsq - crf;
+
+                if (ii == jnr)
+                {
+                    VV *= half;
+                }
+
+                for (int s = 0; s < numLambdaSets; s++)
+                {
+                    for (int i = 0; i < NSTATES; i++)
+                    {
+                        vctot[s] += LFC[s * NSTATES + i] * qq[i] * VV;
+                    }
+                }
+            }
+
+            if (elecInteractionTypeIsEwald && r < rcoulomb)
+            {
+                /* Subtract the reciprocal-space Ewald component, see the
+                 * corresponding comment in nb_free_energy_kernel. The
+                 * correction does not depend on lambda, only its weights do.
+                 */
+                const real ewrt   = r * ewtabscale;
+                int        ewitab = static_cast<int>(ewrt);
+                const real eweps  = ewrt - ewitab;
+                ewitab            = 4 * ewitab;
+                const real f_lr   = ewtab[ewitab] + eweps * ewtab[ewitab + 1];
+                real v_lr = (ewtab[ewitab + 2] - ewtabhalfspace * eweps * (ewtab[ewitab] + f_lr));
+
+                if (ii == jnr)
+                {
+                    /* Self-interaction, counted twice; see the force kernel */
+                    v_lr *= half;
+                }
+
+                for (int s = 0; s < numLambdaSets; s++)
+                {
+                    for (int i = 0; i < NSTATES; i++)
+                    {
+                        vctot[s] -= LFC[s * NSTATES + i] * qq[i] * v_lr;
+                    }
+                }
+            }
+
+            if (vdwInteractionTypeIsEwald && r < rvdw)
+            {
+                /* Subtract the reciprocal-space LJ-Ewald component, see the
+                 * corresponding comment in nb_free_energy_kernel.
+                 */
+                const real rs   = rsq * rinv * ewtabscale;
+                const int  ri   = static_cast<int>(rs);
+                const real frac = rs - ri;
+                const real f_lr = (1 - frac) * tab_ewald_F_lj[ri] + frac * tab_ewald_F_lj[ri + 1];
+                real       VV =
+                        (tab_ewald_V_lj[ri] - ewtabhalfspace * frac * (tab_ewald_F_lj[ri] + f_lr)) / six;
+
+                if (ii == jnr)
+                {
+                    VV *= half;
+                }
+
+                for (int s = 0; s < numLambdaSets; s++)
+                {
+                    for (int i = 0; i < NSTATES; i++)
+                    {
+                        vvtot[s] += LFV[s * NSTATES + i] * nbfp_grid[tj[i]] * VV;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int s = 0; s < numLambdaSets; s++)
+    {
+#pragma omp atomic
+        vCoulombSets[s] += vctot[s];
+#pragma omp atomic
+        vVdwSets[s] += vvtot[s];
+    }
+
+    /* Estimate flops, as for the force kernel, but per lambda set */
+#pragma omp atomic
+    inc_nrnb(nrnb, eNR_NBKERNEL_FREE_ENERGY,
+             numLambdaSets * (nlist->nri * 12 + nlist->jindex[nri] * 150));
+}
+
 typedef void (*KernelFunction)(const t_nblist* gmx_restrict nlist,
                                rvec* gmx_restrict         xx,
                                gmx::ForceWithShiftForces* forceWithShiftForces,
@@ -833,9 +1319,8 @@ static KernelFunction dispatchKernelOnUseSimd(const bool useSimd)
 {
     if (useSimd)
     {
-#if GMX_SIMD_HAVE_REAL && GMX_SIMD_HAVE_INT32_ARITHMETICS
-        /* FIXME: Here SimdDataTypes should be used to enable SIMD. So far, the code in nb_free_energy_kernel is not adapted to SIMD */
-        return (nb_free_energy_kernel<ScalarDataTypes, useSoftCore, scLambdasOrAlphasDiffer, vdwInteractionTypeIsEwald,
+#if GMX_NB_FREE_ENERGY_USE_SIMD
+        return (nb_free_energy_kernel<SimdDataTypes, useSoftCore, scLambdasOrAlphasDiffer, vdwInteractionTypeIsEwald,
                                       elecInteractionTypeIsEwald, vdwModifierIsPotSwitch>);
 #else
         return (nb_free_energy_kernel<ScalarDataTypes, useSoftCore, scLambdasOrAlphasDiffer, vdwInteractionTypeIsEwald,
@@ -978,3 +1463,82 @@ void gmx_nb_free_energy_kernel(const t_nblist*            nlist,
                                 elecInteractionTypeIsEwald, vdwModifierIsPotSwitch, useSimd, fr);
     kernelFunc(nlist, xx, ff, fr, mdatoms, kernel_data, nrnb);
 }
+
+typedef void (*ForeignKernelFunction)(const t_nblist* gmx_restrict nlist,
+                                      rvec* gmx_restrict xx,
+                                      const t_forcerec* gmx_restrict fr,
+                                      const t_mdatoms* gmx_restrict mdatoms,
+                                      int                      numLambdaSets,
+                                      const real* gmx_restrict lambdaSets,
+                                      real* gmx_restrict       vCoulombSets,
+                                      real* gmx_restrict       vVdwSets,
+                                      t_nrnb* gmx_restrict     nrnb);
+
+template<bool vdwInteractionTypeIsEwald, bool elecInteractionTypeIsEwald>
+static ForeignKernelFunction dispatchForeignKernelOnVdwModifier(const bool vdwModifierIsPotSwitch)
+{
+    if (vdwModifierIsPotSwitch)
+    {
+        return (nb_free_energy_foreign_kernel<vdwInteractionTypeIsEwald, elecInteractionTypeIsEwald, true>);
+    }
+    else
+    {
+        return (nb_free_energy_foreign_kernel<vdwInteractionTypeIsEwald, elecInteractionTypeIsEwald, false>);
+    }
+}
+
+template<bool vdwInteractionTypeIsEwald>
+static ForeignKernelFunction dispatchForeignKernelOnElecInteractionType(const bool elecInteractionTypeIsEwald,
+                                                                        const bool vdwModifierIsPotSwitch)
+{
+    if (elecInteractionTypeIsEwald)
+    {
+        return (dispatchForeignKernelOnVdwModifier<vdwInteractionTypeIsEwald, true>(vdwModifierIsPotSwitch));
+    }
+    else
+    {
+        return (dispatchForeignKernelOnVdwModifier<vdwInteractionTypeIsEwald, false>(vdwModifierIsPotSwitch));
+    }
+}
+
+static ForeignKernelFunction dispatchForeignKernel(const bool vdwInteractionTypeIsEwald,
+                                                   const bool elecInteractionTypeIsEwald,
+                                                   const bool vdwModifierIsPotSwitch)
+{
+    if (vdwInteractionTypeIsEwald)
+    {
+        return (dispatchForeignKernelOnElecInteractionType<true>(elecInteractionTypeIsEwald,
+                                                                 vdwModifierIsPotSwitch));
+    }
+    else
+    {
+        return (dispatchForeignKernelOnElecInteractionType<false>(elecInteractionTypeIsEwald,
+                                                                  vdwModifierIsPotSwitch));
+    }
+}
+
+void gmx_nb_free_energy_foreign_kernel(const t_nblist*   nlist,
+                                       rvec*             xx,
+                                       const t_forcerec* fr,
+                                       const t_mdatoms*  mdatoms,
+                                       const int         numLambdaSets,
+                                       const real*       lambdaSets,
+                                       real*             vCoulombSets,
+                                       real*             vVdwSets,
+                                       t_nrnb*           nrnb)
+{
+    GMX_ASSERT(EEL_PME_EWALD(fr->ic->eeltype) || fr->ic->eeltype == eelCUT || EEL_RF(fr->ic->eeltype),
+               "Unsupported eeltype with free energy");
+    GMX_RELEASE_ASSERT(fr->sc_alphacoul != 0 || fr->sc_alphavdw != 0,
+                       "Without soft-core the foreign energies interpolate linearly in lambda and "
+                       "do not need recalculation");
+    GMX_RELEASE_ASSERT(fr->sc_r_power == 6.0_real, "Unsupported soft-core r-power");
+
+    const bool vdwInteractionTypeIsEwald  = (EVDW_PME(fr->ic->vdwtype));
+    const bool elecInteractionTypeIsEwald = (EEL_PME_EWALD(fr->ic->eeltype));
+    const bool vdwModifierIsPotSwitch     = (fr->ic->vdw_modifier == eintmodPOTSWITCH);
+
+    ForeignKernelFunction kernelFunc = dispatchForeignKernel(
+            vdwInteractionTypeIsEwald, elecInteractionTypeIsEwald, vdwModifierIsPotSwitch);
+    kernelFunc(nlist, xx, fr, mdatoms, numLambdaSets, lambdaSets, vCoulombSets, vVdwSets, nrnb);
+}
@@ -58,4 +58,22 @@ void gmx_nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                                nb_kernel_data_t* gmx_restrict kernel_data,
                                t_nrnb* gmx_restrict nrnb);
 
+/* Computes the perturbed energies for numLambdaSets sets of lambda values
+ * in one pass over the pair list. Set s uses the efptNR lambda values at
+ * lambdaSets[s*efptNR] and its Coulomb and Van der Waals energies, summed
+ * over energy groups, are accumulated into vCoulombSets[s] and vVdwSets[s].
+ * No forces or lambda derivatives are computed. Only needed, and only
+ * valid, with soft-core interactions; without soft-core the foreign
+ * energies interpolate linearly in lambda.
+ */
+void gmx_nb_free_energy_foreign_kernel(const t_nblist* gmx_restrict nlist,
+                                       rvec* gmx_restrict xx,
+                                       const t_forcerec* gmx_restrict fr,
+                                       const t_mdatoms* gmx_restrict mdatoms,
+                                       int                      numLambdaSets,
+                                       const real* gmx_restrict lambdaSets,
+                                       real* gmx_restrict       vCoulombSets,
+                                       real* gmx_restrict       vVdwSets,
+                                       t_nrnb* gmx_restrict     nrnb);
+
 #endif
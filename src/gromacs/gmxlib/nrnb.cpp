@@ -47,6 +47,7 @@
 
 #include "gromacs/mdtypes/commrec.h"
 #include "gromacs/mdtypes/md_enums.h"
+#include "gromacs/simd/simd.h"
 #include "gromacs/utility/arraysize.h"
 
 typedef struct
@@ -423,6 +424,74 @@ void print_flop(FILE* out, t_nrnb* nrnb, double* nbfs, double* mflop)
     }
 }
 
+/* Returns the total flop count of the nonbonded kernels in Mflop,
+ * including the cost of the LJ modification additions.
+ */
+static double nonbonded_mflop(t_nrnb* nrnb)
+{
+    double mflopNB = 0;
+
+    for (int i = 0; i <= eNR_NBNXN_EWALD_E; i++)
+    {
+        int flop = nbdata[i].flop;
+
+        if (nrnb_is_nbnxn_vdw_kernel(i))
+        {
+            /* Possibly add the cost of an LJ switch/Ewald function */
+            for (int j = eNR_NBNXN_ADD_LJ_FSW; j <= eNR_NBNXN_ADD_LJ_EWALD; j += 2)
+            {
+                /* Select the force or energy flop count */
+                const int e_kernel_add = j + ((i - eNR_NBNXN_LJ_RF) % 2);
+
+                if (nrnb->n[e_kernel_add] > 0)
+                {
+                    flop += nbdata[e_kernel_add].flop;
+                }
+            }
+        }
+        mflopNB += 1e-6 * nrnb->n[i] * flop;
+    }
+
+    return mflopNB;
+}
+
+void print_flop_efficiency(FILE* out, t_nrnb* nrnb, double mflop, double runCycles, double forceCycles)
+{
+#if GMX_SIMD_HAVE_REAL
+    const int simdWidth     = GMX_SIMD_REAL_WIDTH;
+    const int flopsPerCycle = GMX_SIMD_REAL_WIDTH * (GMX_SIMD_HAVE_FMA ? 2 : 1);
+#else
+    const int simdWidth     = 1;
+    const int flopsPerCycle = 1;
+#endif
+
+    if (out == nullptr || mflop <= 0 || runCycles <= 0)
+    {
+        return;
+    }
+
+    fprintf(out, "\tF L O P   E F F I C I E N C Y   E S T I M A T E\n\n");
+    fprintf(out,
+            " Assumed SIMD peak: %d flops/cycle/core (SIMD width %d, one SIMD %s\n"
+            " issued per cycle). Many cores can issue two SIMD operations per cycle,\n"
+            " so compare these numbers between versions and settings rather than\n"
+            " against 100%%. The Force region also contains non-kernel work, which\n"
+            " makes the nonbonded kernel number a lower bound.\n\n",
+            flopsPerCycle, simdWidth, (flopsPerCycle > simdWidth) ? "fused multiply-add" : "multiply or add");
+
+    fprintf(out, " %-24s %8.3f flops/cycle/core  %5.1f%% of assumed peak\n", "Whole run:",
+            1e6 * mflop / runCycles, 100.0 * 1e6 * mflop / (runCycles * flopsPerCycle));
+
+    const double mflopNB = nonbonded_mflop(nrnb);
+    if (mflopNB > 0 && forceCycles > 0)
+    {
+        fprintf(out, " %-24s %8.3f flops/cycle/core  %5.1f%% of assumed peak\n",
+                "Nonbonded kernels:", 1e6 * mflopNB / forceCycles,
+                100.0 * 1e6 * mflopNB / (forceCycles * flopsPerCycle));
+    }
+    fprintf(out, "\n");
+}
+
 void print_perf(FILE*   out,
                 double  time_per_thread,
                 double  time_per_node,
@@ -199,6 +199,14 @@ void print_flop(FILE* out, t_nrnb* nrnb, double* nbfs, double* mflop);
  * When out!=NULL also prints the full count table.
  */
 
+void print_flop_efficiency(FILE* out, t_nrnb* nrnb, double mflop, double runCycles, double forceCycles);
+/* Prints the achieved flop rate per core clock cycle and the fraction of
+ * the SIMD peak assumed for the build, for the whole run and for the
+ * nonbonded kernels. mflop comes from print_flop; runCycles and
+ * forceCycles are the thread-summed wallcycle counts of the Run and
+ * Force regions over all ranks.
+ */
+
 void print_perf(FILE* out, double nodetime, double realtime, int64_t nsteps, double delta_t, double nbfs, double mflop);
 /* Prints the performance, nbfs and mflop come from print_flop */
 
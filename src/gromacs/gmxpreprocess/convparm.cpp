@@ -45,6 +45,8 @@
 #include <cstring>
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include "gromacs/gmxpreprocess/gpp_atomtype.h"
 #include "gromacs/gmxpreprocess/grompp_impl.h"
@@ -441,13 +443,22 @@ static int assign_param(t_functype ftype, t_iparams* newparam, gmx::ArrayRef<con
     return 0;
 }
 
-static int enter_params(gmx_ffparams_t*           ffparams,
-                        t_functype                ftype,
-                        gmx::ArrayRef<const real> forceparams,
-                        int                       comb,
-                        real                      reppow,
-                        int                       start,
-                        bool                      bAppend)
+/* Checks if newparam equals an earlier entered parameter set and returns its
+ * type if so, otherwise adds a new type and returns that.
+ *
+ * The parameter sets entered since \p paramIndex was cleared are indexed by
+ * their raw bytes in \p paramIndex, so duplicates are found in constant time
+ * instead of by scanning all previously entered sets, which made the type
+ * assignment quadratic in the interaction count. assign_param() zeroes all
+ * of t_iparams, so the byte comparison is deterministic.
+ */
+static int enter_params(gmx_ffparams_t*                       ffparams,
+                        t_functype                            ftype,
+                        gmx::ArrayRef<const real>             forceparams,
+                        int                                   comb,
+                        real                                  reppow,
+                        bool                                  bAppend,
+                        std::unordered_map<std::string, int>* paramIndex)
 {
     t_iparams newparam;
     int       type;
@@ -459,23 +470,18 @@ static int enter_params(gmx_ffparams_t*           ffparams,
         return rc;
     }
 
+    type = ffparams->numTypes();
     if (!bAppend)
     {
-        for (type = start; (type < ffparams->numTypes()); type++)
+        std::string key(reinterpret_cast<const char*>(&newparam), sizeof(newparam));
+
+        const auto inserted = paramIndex->emplace(std::move(key), type);
+        if (!inserted.second)
         {
-            if (ffparams->functype[type] == ftype)
-            {
-                if (memcmp(&newparam, &ffparams->iparams[type], static_cast<size_t>(sizeof(newparam))) == 0)
-                {
-                    return type;
-                }
-            }
+            /* An identical parameter set was entered before */
+            return inserted.first->second;
         }
     }
-    else
-    {
-        type = ffparams->numTypes();
-    }
 
     ffparams->iparams.push_back(newparam);
     ffparams->functype.push_back(ftype);
@@ -503,11 +509,14 @@ static void enter_function(const InteractionsOfType* p,
                            bool                      bNB,
                            bool                      bAppend)
 {
-    int start = ffparams->numTypes();
+    /* Duplicates are only merged among the parameter sets entered by this
+     * call, as before when the scan started at the old end of ffparams.
+     */
+    std::unordered_map<std::string, int> paramIndex;
 
     for (auto& parm : p->interactionTypes)
     {
-        int type = enter_params(ffparams, ftype, parm.forceParam(), comb, reppow, start, bAppend);
+        int type = enter_params(ffparams, ftype, parm.forceParam(), comb, reppow, bAppend, &paramIndex);
         /* Type==-1 is used as a signal that this interaction is all-zero and should not be added. */
         if (!bNB && type >= 0)
         {
@@ -41,6 +41,8 @@
 #include <cstring>
 #include <ctime>
 
+#include <vector>
+
 #include "gromacs/fileio/confio.h"
 #include "gromacs/gmxlib/network.h"
 #include "gromacs/gmxpreprocess/calch.h"
@@ -66,13 +68,29 @@ static void copy_atom(const t_atoms* atoms1, int a1, t_atoms* atoms2, int a2, t_
     atoms2->atomname[a2] = put_symtab(symtab, *atoms1->atomname[a1]);
 }
 
-static int pdbasearch_atom(const char* name, int resind, const t_atoms* pdba, const char* searchtype, bool bAllowMissing)
+/* Returns for each residue the index of its first atom, or pdba->nr for
+ * residues without atoms, so that the many atom searches during hydrogen
+ * addition do not each have to rescan the whole structure for the start
+ * of their residue.
+ */
+static std::vector<int> firstResidueAtoms(const t_atoms* pdba)
 {
-    int i;
-
-    for (i = 0; (i < pdba->nr) && (pdba->atom[i].resind != resind); i++) {}
+    std::vector<int> firstAtom(pdba->nres, pdba->nr);
+    for (int i = pdba->nr - 1; i >= 0; i--)
+    {
+        firstAtom[pdba->atom[i].resind] = i;
+    }
+    return firstAtom;
+}
 
-    return search_atom(name, i, pdba, searchtype, bAllowMissing);
+static int pdbasearch_atom(const char*              name,
+                           int                      resind,
+                           const t_atoms*           pdba,
+                           gmx::ArrayRef<const int> firstResidueAtom,
+                           const char*              searchtype,
+                           bool                     bAllowMissing)
+{
+    return search_atom(name, firstResidueAtom[resind], pdba, searchtype, bAllowMissing);
 }
 
 static void hacksearch_atom(int*                                            ii,
@@ -80,7 +98,8 @@ static void hacksearch_atom(int*                                            ii,
                             const char*                                     name,
                             gmx::ArrayRef<const std::vector<MoleculePatch>> patches,
                             int                                             resind,
-                            const t_atoms*                                  pdba)
+                            const t_atoms*                                  pdba,
+                            gmx::ArrayRef<const int>                        firstResidueAtom)
 {
     int i;
 
@@ -90,7 +109,7 @@ static void hacksearch_atom(int*                                            ii,
         name++;
         resind--;
     }
-    for (i = 0; (i < pdba->nr) && (pdba->atom[i].resind != resind); i++) {}
+    i = (resind >= 0) ? firstResidueAtom[resind] : pdba->nr;
     for (; (i < pdba->nr) && (pdba->atom[i].resind == resind) && (*ii < 0); i++)
     {
         int j = 0;
@@ -269,7 +288,9 @@ static void expand_hackblocks(const t_atoms*                             pdba,
     }
 }
 
-static int check_atoms_present(const t_atoms* pdba, gmx::ArrayRef<std::vector<MoleculePatch>> patches)
+static int check_atoms_present(const t_atoms*                            pdba,
+                               gmx::ArrayRef<std::vector<MoleculePatch>> patches,
+                               gmx::ArrayRef<const int>                  firstResidueAtom)
 {
     int nadd = 0;
     for (int i = 0; i < pdba->nr; i++)
@@ -283,7 +304,8 @@ static int check_atoms_present(const t_atoms* pdba, gmx::ArrayRef<std::vector<Mo
                 {
                     /* we're adding */
                     /* check if the atom is already present */
-                    int k = pdbasearch_atom(patch->nname.c_str(), rnr, pdba, "check", TRUE);
+                    int k = pdbasearch_atom(patch->nname.c_str(), rnr, pdba, firstResidueAtom,
+                                            "check", TRUE);
                     if (k != -1)
                     {
                         /* We found the added atom. */
@@ -316,6 +338,7 @@ static int check_atoms_present(const t_atoms* pdba, gmx::ArrayRef<std::vector<Mo
 static void calc_all_pos(const t_atoms*                            pdba,
                          gmx::ArrayRef<const gmx::RVec>            x,
                          gmx::ArrayRef<std::vector<MoleculePatch>> patches,
+                         gmx::ArrayRef<const int>                  firstResidueAtom,
                          bool                                      bCheckMissing)
 {
     int ii, l = 0;
@@ -339,13 +362,14 @@ static void calc_all_pos(const t_atoms*                            pdba,
                 bool bFoundAll = true;
                 for (int m = 0; (m < patch->nctl && bFoundAll); m++)
                 {
-                    int ia = pdbasearch_atom(patch->a[m].c_str(), rnr, pdba,
+                    int ia = pdbasearch_atom(patch->a[m].c_str(), rnr, pdba, firstResidueAtom,
                                              bCheckMissing ? "atom" : "check", !bCheckMissing);
                     if (ia < 0)
                     {
                         /* not found in original atoms, might still be in
                          * the patch Instructions (patches) */
-                        hacksearch_atom(&ii, &jj, patch->a[m].c_str(), patches, rnr, pdba);
+                        hacksearch_atom(&ii, &jj, patch->a[m].c_str(), patches, rnr, pdba,
+                                        firstResidueAtom);
                         if (ii >= 0)
                         {
                             copy_rvec(patches[ii][jj].newx, xa[m]);
@@ -431,12 +455,15 @@ static int add_h_low(t_atoms**                                   initialAtoms,
         expand_hackblocks(pdba, hb, patches, nterpairs, rN, rC);
     }
 
+    /* locate the first atom of each residue once for all the atom searches below */
+    const std::vector<int> firstResidueAtom = firstResidueAtoms(pdba);
+
     /* Now calc the positions */
-    calc_all_pos(pdba, *xptr, patches, bCheckMissing);
+    calc_all_pos(pdba, *xptr, patches, firstResidueAtom, bCheckMissing);
 
     /* we don't have to add atoms that are already present in initialAtoms,
        so we will remove them from the patches (MoleculePatch) */
-    nadd = check_atoms_present(pdba, patches);
+    nadd = check_atoms_present(pdba, patches, firstResidueAtom);
 
     /* Copy old atoms, making space for new ones */
     if (nadd > 0)
@@ -56,6 +56,7 @@
 #include "gromacs/pbcutil/pbc.h"
 #include "gromacs/random/threefry.h"
 #include "gromacs/random/uniformintdistribution.h"
+#include "gromacs/selection/nbsearch.h"
 #include "gromacs/topology/index.h"
 #include "gromacs/topology/topology.h"
 #include "gromacs/utility/arrayref.h"
@@ -67,39 +68,6 @@
 #include "gromacs/utility/smalloc.h"
 
 
-/*! \brief Return whether any atoms of two groups are below minimum distance.
- *
- * \param[in] pbc the periodic boundary conditions
- * \param[in] x the coordinates
- * \param[in] smallerGroupIndices the atom indices of the first group to check
- * \param[in] largerGroupIndices the atom indices of the second group to check
- * \param[in] minimumDistance the minimum required distance betwenn any atom in
- *                            the first and second group
- * \returns true if any distance between an atom from group A and group B is
- *               smaller than a minimum distance.
- */
-static bool groupsCloserThanCutoffWithPbc(t_pbc*                   pbc,
-                                          rvec                     x[],
-                                          gmx::ArrayRef<const int> smallerGroupIndices,
-                                          gmx::ArrayRef<const int> largerGroupIndices,
-                                          real                     minimumDistance)
-{
-    const real minimumDistance2 = minimumDistance * minimumDistance;
-    for (int aIndex : largerGroupIndices)
-    {
-        for (int bIndex : smallerGroupIndices)
-        {
-            rvec dx;
-            pbc_dx(pbc, x[aIndex], x[bIndex], dx);
-            if (norm2(dx) < minimumDistance2)
-            {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 /*! \brief Calculate the solvent molecule atom indices from molecule number.
  *
  * \note the solvent group index has to be continuous
@@ -123,31 +91,26 @@ static std::vector<int> solventMoleculeIndices(int solventMoleculeNumber,
     return indices;
 }
 
-static void insert_ion(int                      nsa,
-                       std::vector<int>*        solventMoleculesForReplacement,
-                       int                      repl[],
-                       gmx::ArrayRef<const int> index,
-                       rvec                     x[],
-                       t_pbc*                   pbc,
-                       int                      sign,
-                       int                      q,
-                       const char*              ionname,
-                       t_atoms*                 atoms,
-                       real                     rmin,
-                       std::vector<int>*        notSolventGroup)
+static void insert_ion(int                              nsa,
+                       std::vector<int>*                solventMoleculesForReplacement,
+                       int                              repl[],
+                       gmx::ArrayRef<const int>         index,
+                       rvec                             x[],
+                       int                              sign,
+                       int                              q,
+                       const char*                      ionname,
+                       t_atoms*                         atoms,
+                       real                             rmin,
+                       std::vector<bool>*               notReplaceable,
+                       gmx::AnalysisNeighborhoodSearch* solventSearch)
 {
-    std::vector<int> solventMoleculeAtomsToBeReplaced =
-            solventMoleculeIndices(solventMoleculesForReplacement->back(), nsa, index);
-
     if (rmin > 0.0)
     {
-        // check for proximity to non-solvent
-        while (groupsCloserThanCutoffWithPbc(pbc, x, solventMoleculeAtomsToBeReplaced, *notSolventGroup, rmin)
-               && !solventMoleculesForReplacement->empty())
+        // reject candidates that are too close to non-solvent or placed ions
+        while (!solventMoleculesForReplacement->empty()
+               && (*notReplaceable)[solventMoleculesForReplacement->back()])
         {
             solventMoleculesForReplacement->pop_back();
-            solventMoleculeAtomsToBeReplaced =
-                    solventMoleculeIndices(solventMoleculesForReplacement->back(), nsa, index);
         }
     }
 
@@ -156,11 +119,13 @@ static void insert_ion(int                      nsa,
         gmx_fatal(FARGS, "No more replaceable solvent!");
     }
 
+    const std::vector<int> solventMoleculeAtomsToBeReplaced =
+            solventMoleculeIndices(solventMoleculesForReplacement->back(), nsa, index);
+
     fprintf(stderr, "Replacing solvent molecule %d (atom %d) with %s\n",
             solventMoleculesForReplacement->back(), solventMoleculeAtomsToBeReplaced[0], ionname);
 
     /* Replace solvent molecule charges with ion charge */
-    notSolventGroup->push_back(solventMoleculeAtomsToBeReplaced[0]);
     repl[solventMoleculesForReplacement->back()] = sign;
 
     // The first solvent molecule atom is replaced with an ion and the respective
@@ -172,6 +137,20 @@ static void insert_ion(int                      nsa,
         atoms->atom[*replacedMoleculeAtom].q = 0;
     }
     solventMoleculesForReplacement->pop_back();
+
+    if (rmin > 0.0)
+    {
+        /* Mark all solvent molecules with an atom within rmin of the new ion
+         * as not replaceable for the remaining insertions.
+         */
+        gmx::AnalysisNeighborhoodPairSearch pairSearch =
+                solventSearch->startPairSearch(x[solventMoleculeAtomsToBeReplaced.front()]);
+        gmx::AnalysisNeighborhoodPair pair;
+        while (pairSearch.findNextPair(&pair))
+        {
+            (*notReplaceable)[pair.refIndex() / nsa] = true;
+        }
+    }
 }
 
 
@@ -644,16 +623,49 @@ int gmx_genion(int argc, char* argv[])
         std::shuffle(std::begin(solventMoleculesForReplacement),
                      std::end(solventMoleculesForReplacement), rng);
 
+        /* Put the solvent atoms on a grid, so that looking up the solvent
+         * molecules within rmin of a point costs only the neighboring grid
+         * cells. All molecules too close to the non-solvent atoms can then
+         * be rejected in one batch before any ion is placed; the molecules
+         * too close to a placed ion are marked as it is inserted.
+         */
+        std::vector<bool>               notReplaceable(nw, false);
+        gmx::AnalysisNeighborhood       neighborhood;
+        gmx::AnalysisNeighborhoodSearch solventSearch;
+        if (rmin > 0)
+        {
+            neighborhood.setCutoff(rmin);
+            solventSearch = neighborhood.initSearch(
+                    &pbc, gmx::AnalysisNeighborhoodPositions(
+                                  x + solventGroup[0], static_cast<int>(solventGroup.size())));
+            if (!notSolventGroup.empty())
+            {
+                std::vector<gmx::RVec> notSolventPositions;
+                notSolventPositions.reserve(notSolventGroup.size());
+                for (int notSolventAtom : notSolventGroup)
+                {
+                    notSolventPositions.emplace_back(x[notSolventAtom]);
+                }
+                gmx::AnalysisNeighborhoodPairSearch pairSearch =
+                        solventSearch.startPairSearch(notSolventPositions);
+                gmx::AnalysisNeighborhoodPair pair;
+                while (pairSearch.findNextPair(&pair))
+                {
+                    notReplaceable[pair.refIndex() / nsa] = true;
+                }
+            }
+        }
+
         /* Now loop over the ions that have to be placed */
         while (p_num-- > 0)
         {
-            insert_ion(nsa, &solventMoleculesForReplacement, repl, solventGroup, x, &pbc, 1, p_q,
-                       p_name, &atoms, rmin, &notSolventGroup);
+            insert_ion(nsa, &solventMoleculesForReplacement, repl, solventGroup, x, 1, p_q, p_name,
+                       &atoms, rmin, &notReplaceable, &solventSearch);
         }
         while (n_num-- > 0)
         {
-            insert_ion(nsa, &solventMoleculesForReplacement, repl, solventGroup, x, &pbc, -1, n_q,
-                       n_name, &atoms, rmin, &notSolventGroup);
+            insert_ion(nsa, &solventMoleculesForReplacement, repl, solventGroup, x, -1, n_q, n_name,
+                       &atoms, rmin, &notReplaceable, &solventSearch);
         }
         fprintf(stderr, "\n");
 
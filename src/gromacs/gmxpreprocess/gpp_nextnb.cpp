@@ -304,7 +304,11 @@ static void do_gen(int       nrbonds, /* total number of bonds in s	*/
     /* for the nr of exclusions per atom */
     for (n = 1; (n < nnb->nrex); n++)
     {
-        /* now for all atoms */
+        /* now for all atoms; each iteration only writes the n+1-th list
+         * of its own atom and reads the completed n-th lists, so the
+         * atoms can be distributed over threads.
+         */
+#pragma omp parallel for schedule(dynamic, 64) private(j, k, nb)
         for (i = 0; (i < nnb->nr); i++)
         {
             /* for all directly bonded atoms of atom i */
@@ -394,6 +398,8 @@ static void sort_and_purge_nnb(t_nextnb* nnb)
     int  i, j, k, m, n, cnt, prev, idx;
     bool found;
 
+    /* Each iteration only touches the lists of its own atom */
+#pragma omp parallel for schedule(dynamic, 64) private(j, k, m, n, cnt, prev, idx, found)
     for (i = 0; (i < nnb->nr); i++)
     {
         for (n = 0; (n <= nnb->nrex); n++)
@@ -1710,7 +1710,14 @@ int gmx_grompp(int argc, char* argv[])
         "",
         "For further information a C-programming textbook may help you out.",
         "Specifying the [TT]-pp[tt] flag will get the pre-processed",
-        "topology file written out so that you can verify its contents.[PAR]",
+        "topology file written out so that you can verify its contents.",
+        "When generating many run input files that differ only in their",
+        "[REF].mdp[ref] settings, e.g. free-energy lambda windows, this file",
+        "can also be used as the input topology for the remaining invocations,",
+        "which avoids resolving the [TT]#include[tt] hierarchy of the force",
+        "field again on every run. Note that the pre-processed topology has",
+        "all [TT]#define[tt] macros expanded, so [TT]define[tt] statements in",
+        "the [REF].mdp[ref] file no longer affect it.[PAR]",
 
         "When using position restraints, a file with restraint coordinates",
         "must be supplied with [TT]-r[tt] (can be the same file as supplied",
@@ -40,6 +40,7 @@
 #define GMX_GMXPREPROCESS_GROMPP_IMPL_H
 
 #include <string>
+#include <unordered_map>
 
 #include "gromacs/gmxpreprocess/notset.h"
 #include "gromacs/topology/atoms.h"
@@ -145,6 +146,18 @@ struct InteractionsOfType
     //! The five atomtypes followed by a number that identifies the type.
     std::vector<int> cmapAtomTypes;
 
+    /*! \brief Index from exact atom-type tuples to the first matching entry
+     *
+     * Maps the packed atom-type tuple of each entry in interactionTypes to
+     * the lowest index with that tuple. Built lazily for parameter lookups
+     * without wildcards, see defaultInteractionsOfType(); it only covers the
+     * first numIndexedInteractions entries and is refreshed when entries
+     * have been appended since it was built.
+     */
+    std::unordered_map<std::string, int> exactTupleIndex;
+    //! Number of entries of interactionTypes covered by exactTupleIndex.
+    size_t numIndexedInteractions = 0;
+
     //! Number of parameters.
     size_t size() const { return interactionTypes.size(); }
     //! Elements in cmap grid data.
@@ -245,6 +245,12 @@ static void insert_mols(int                  nmol_insrt,
     int                                failed     = 0;
     gmx::UniformRealDistribution<real> dist;
 
+    /* The search grid over the present configuration only needs to be
+     * rebuilt when an insertion succeeded; failed trials reuse it.
+     */
+    gmx::AnalysisNeighborhoodSearch search;
+    bool                            searchNeedsUpdate = true;
+
     while (mol < nmol_insrt && trial < ntry * nmol_insrt)
     {
         rvec offset_x;
@@ -276,8 +282,12 @@ static void insert_mols(int                  nmol_insrt,
         fflush(stderr);
 
         generate_trial_conf(x_insrt, offset_x, enum_rot, &rng, &x_n);
-        gmx::AnalysisNeighborhoodPositions pos(*x);
-        gmx::AnalysisNeighborhoodSearch    search = nb.initSearch(&pbc, pos);
+        if (searchNeedsUpdate)
+        {
+            gmx::AnalysisNeighborhoodPositions pos(*x);
+            search            = nb.initSearch(&pbc, pos);
+            searchNeedsUpdate = false;
+        }
         if (isInsertionAllowed(&search, exclusionDistances, x_n, exclusionDistances_insrt, *atoms,
                                removableAtoms, &remover))
         {
@@ -286,7 +296,8 @@ static void insert_mols(int                  nmol_insrt,
                                       exclusionDistances_insrt.end());
             builder.mergeAtoms(atoms_insrt);
             ++mol;
-            firstTrial = trial;
+            firstTrial        = trial;
+            searchNeedsUpdate = true;
             fprintf(stderr, " success (now %d atoms)!\n", builder.currentAtomCount());
         }
     }
@@ -46,6 +46,7 @@
 
 #include <algorithm>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "gromacs/fileio/pdbio.h"
@@ -1002,6 +1003,7 @@ void get_hackblocks_rtp(std::vector<MoleculePatchDatabase>*    globalPatches,
     }
 
     /* then the whole rtp */
+    const std::unordered_map<std::string, int> rtpIndex = buildResidueDatabaseIndex(rtpFFDB);
     for (int i = 0; i < nres; i++)
     {
         /* Here we allow a mismatch of one character when looking for the rtp entry.
@@ -1013,8 +1015,8 @@ void get_hackblocks_rtp(std::vector<MoleculePatchDatabase>*    globalPatches,
          */
         key = *resinfo[i].rtp;
 
-        resinfo[i].rtp = put_symtab(symtab, searchResidueDatabase(key, rtpFFDB, logger).c_str());
-        auto res       = getDatabaseEntry(*resinfo[i].rtp, rtpFFDB);
+        resinfo[i].rtp = put_symtab(symtab, searchResidueDatabase(key, rtpFFDB, rtpIndex, logger).c_str());
+        auto res       = getDatabaseEntry(*resinfo[i].rtp, rtpFFDB, rtpIndex);
         usedPpResidues->push_back(PreprocessResidue());
         PreprocessResidue* newentry = &usedPpResidues->back();
         copyPreprocessResidues(*res, newentry, symtab);
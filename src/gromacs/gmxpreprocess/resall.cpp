@@ -45,6 +45,7 @@
 
 #include <algorithm>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "gromacs/gmxpreprocess/fflibutil.h"
@@ -609,6 +610,42 @@ std::string searchResidueDatabase(const std::string&                     key,
     return rtpDBEntry[besti].resname;
 }
 
+/* Returns the residue name converted to lower case, for use as index key. */
+static std::string lowerCaseKey(const std::string& name)
+{
+    std::string key(name);
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](char c) { return std::tolower(c); });
+    return key;
+}
+
+std::unordered_map<std::string, int> buildResidueDatabaseIndex(gmx::ArrayRef<const PreprocessResidue> rtpDBEntry)
+{
+    std::unordered_map<std::string, int> index;
+    index.reserve(rtpDBEntry.size());
+    for (auto it = rtpDBEntry.begin(); it != rtpDBEntry.end(); it++)
+    {
+        /* Keep the first entry with each name, matching the linear searches */
+        index.emplace(lowerCaseKey(it->resname), std::distance(rtpDBEntry.begin(), it));
+    }
+    return index;
+}
+
+std::string searchResidueDatabase(const std::string&                          key,
+                                  gmx::ArrayRef<const PreprocessResidue>      rtpDBEntry,
+                                  const std::unordered_map<std::string, int>& index,
+                                  const gmx::MDLogger&                        logger)
+{
+    auto entry = index.find(lowerCaseKey(key));
+    if (entry != index.end())
+    {
+        /* An exact match always wins over a near match, and does not warn */
+        return rtpDBEntry[entry->second].resname;
+    }
+    /* Fall back to the linear scan, which allows a sign mismatch */
+    return searchResidueDatabase(key, rtpDBEntry, logger);
+}
+
 gmx::ArrayRef<const PreprocessResidue>::const_iterator
 getDatabaseEntry(const std::string& rtpname, gmx::ArrayRef<const PreprocessResidue> rtpDBEntry)
 {
@@ -626,3 +663,20 @@ getDatabaseEntry(const std::string& rtpname, gmx::ArrayRef<const PreprocessResid
 
     return found;
 }
+
+gmx::ArrayRef<const PreprocessResidue>::const_iterator
+getDatabaseEntry(const std::string&                          rtpname,
+                 gmx::ArrayRef<const PreprocessResidue>      rtpDBEntry,
+                 const std::unordered_map<std::string, int>& index)
+{
+    auto entry = index.find(lowerCaseKey(rtpname));
+    if (entry == index.end())
+    {
+        /* This should never happen, since searchResidueDatabase should have been called
+         * before calling getDatabaseEntry.
+         */
+        gmx_fatal(FARGS, "Residue type '%s' not found in residue topology database", rtpname.c_str());
+    }
+
+    return rtpDBEntry.begin() + entry->second;
+}
@@ -43,6 +43,8 @@
 
 #include <cstdio>
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "gromacs/utility/arrayref.h"
@@ -72,6 +74,40 @@ std::string searchResidueDatabase(const std::string&                     key,
                                   gmx::ArrayRef<const PreprocessResidue> rtpDBEntry,
                                   const gmx::MDLogger&                   logger);
 
+/*! \brief
+ * Builds a hashed index into the rtp database.
+ *
+ * Maps the lower-case residue name of each entry in \p rtpDBEntry to the
+ * position of the first entry with that name. Callers that look up many
+ * residues against the same database can build the index once and pass it
+ * to searchResidueDatabase() and getDatabaseEntry() to replace repeated
+ * linear scans over the database with hash lookups.
+ *
+ * \param[in] rtpDBEntry Database with residue information.
+ * \returns Index from lower-case residue name to database position.
+ */
+std::unordered_map<std::string, int>
+buildResidueDatabaseIndex(gmx::ArrayRef<const PreprocessResidue> rtpDBEntry);
+
+/*! \brief
+ * Search for an entry in the rtp database, using a hashed index.
+ *
+ * As searchResidueDatabase(), but exact (case-insensitive) matches are
+ * resolved through \p index; only near matches fall back to the
+ * linear scan. \p index must have been built from \p rtpDBEntry with
+ * buildResidueDatabaseIndex().
+ *
+ * \param[in] key The atomname to search for.
+ * \param[in] rtpDBEntry Database with residue information.
+ * \param[in] index Hashed index built from \p rtpDBEntry.
+ * \param[in] logger Logging object.
+ * \returns The rtp residue name.
+ */
+std::string searchResidueDatabase(const std::string&                          key,
+                                  gmx::ArrayRef<const PreprocessResidue>      rtpDBEntry,
+                                  const std::unordered_map<std::string, int>& index,
+                                  const gmx::MDLogger&                        logger);
+
 /*! \brief
  * Returns matching entry in database.
  *
@@ -82,6 +118,22 @@ std::string searchResidueDatabase(const std::string&                     key,
 gmx::ArrayRef<const PreprocessResidue>::const_iterator
 getDatabaseEntry(const std::string& rtpname, gmx::ArrayRef<const PreprocessResidue> rtpDBEntry);
 
+/*! \brief
+ * Returns matching entry in database, using a hashed index.
+ *
+ * As getDatabaseEntry(), but resolves \p rtpname through \p index, which
+ * must have been built from \p rtpDBEntry with buildResidueDatabaseIndex().
+ *
+ * \param[in] rtpname Name of the entry looked for.
+ * \param[in] rtpDBEntry Database to search.
+ * \param[in] index Hashed index built from \p rtpDBEntry.
+ * \throws If the name can not be found in the database.
+ */
+gmx::ArrayRef<const PreprocessResidue>::const_iterator
+getDatabaseEntry(const std::string&                          rtpname,
+                 gmx::ArrayRef<const PreprocessResidue>      rtpDBEntry,
+                 const std::unordered_map<std::string, int>& index);
+
 /*! \brief
  * Read atom types into database.
  *
@@ -45,7 +45,9 @@
 #include <cstring>
 
 #include <algorithm>
+#include <array>
 #include <string>
+#include <unordered_map>
 
 #include "gromacs/fileio/warninp.h"
 #include "gromacs/gmxpreprocess/gpp_atomtype.h"
@@ -1828,14 +1830,42 @@ static std::vector<InteractionOfType>::iterator defaultInteractionsOfType(int ft
     }
     else /* Not a dihedral */
     {
-        gmx::ArrayRef<const int> atomParam = p.atoms();
-        auto                     found     = std::find_if(
-                bt[ftype].interactionTypes.begin(), bt[ftype].interactionTypes.end(),
-                [&atomParam, &at, &atypes, &bB](const auto& param) {
-                    return findIfAllParameterAtomsMatch(param.atoms(), atomParam, at, atypes, bB);
-                });
-        if (found != bt[ftype].interactionTypes.end())
+        /* Without wildcards the match is an exact comparison of the
+         * atom-type tuple, so we look it up in a hash index over the
+         * parameter list instead of scanning it for every bonded term.
+         * Entries are only ever appended (overriding a duplicate type
+         * replaces the force parameters, not the atom types), so the
+         * index is rebuilt when the list has grown since it was built.
+         */
+        InteractionsOfType& bondTypes = bt[ftype];
+        if (bondTypes.numIndexedInteractions != bondTypes.interactionTypes.size())
+        {
+            bondTypes.exactTupleIndex.clear();
+            for (int idx = 0; idx < gmx::ssize(bondTypes.interactionTypes); idx++)
+            {
+                gmx::ArrayRef<const int> atoms = bondTypes.interactionTypes[idx].atoms();
+                std::string key(reinterpret_cast<const char*>(atoms.data()), atoms.size() * sizeof(int));
+                /* Keep the first entry with this tuple, as find_if did */
+                bondTypes.exactTupleIndex.emplace(std::move(key), idx);
+            }
+            bondTypes.numIndexedInteractions = bondTypes.interactionTypes.size();
+        }
+
+        std::array<int, MAXATOMLIST> queryTuple;
+        gmx::ArrayRef<const int>     atomParam = p.atoms();
+        for (gmx::index i = 0; i < atomParam.ssize(); i++)
+        {
+            queryTuple[i] = atypes->bondAtomTypeFromAtomType(
+                    bB ? at->atom[atomParam[i]].typeB : at->atom[atomParam[i]].type);
+        }
+        const std::string queryKey(reinterpret_cast<const char*>(queryTuple.data()),
+                                   atomParam.size() * sizeof(int));
+
+        auto       found = bondTypes.interactionTypes.end();
+        const auto entry = bondTypes.exactTupleIndex.find(queryKey);
+        if (entry != bondTypes.exactTupleIndex.end())
         {
+            found        = bondTypes.interactionTypes.begin() + entry->second;
             nparam_found = 1;
         }
         *nparam_def = nparam_found;
@@ -53,10 +53,12 @@
 
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <iterator>
 #include <string>
 #include <vector>
 
+#include "gromacs/utility/baseversion.h"
 #include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/programcontext.h"
 #include "gromacs/utility/smalloc.h"
@@ -69,7 +71,9 @@ namespace gmx
 namespace ocl
 {
 
-std::string makeBinaryCacheFilename(const std::string& kernelFilename, cl_device_id deviceId)
+std::string makeBinaryCacheFilename(const std::string& kernelFilename,
+                                    cl_device_id       deviceId,
+                                    const std::string& buildOptions)
 {
     // Note that the OpenCL API is defined in terms of bytes, and we
     // assume that sizeof(char) is one byte.
@@ -83,6 +87,28 @@ std::string makeBinaryCacheFilename(const std::string& kernelFilename, cl_device
                                              ocl_get_error_string(cl_error).c_str())));
     }
 
+    std::array<char, 1024> driverVersion;
+    size_t                 driverVersionLength;
+    cl_error = clGetDeviceInfo(deviceId, CL_DRIVER_VERSION, driverVersion.size(),
+                               driverVersion.data(), &driverVersionLength);
+    if (cl_error != CL_SUCCESS)
+    {
+        GMX_THROW(InternalError(formatString("Could not get OpenCL driver version, error was %s",
+                                             ocl_get_error_string(cl_error).c_str())));
+    }
+
+    /* A cached binary is only valid for the device, driver, compiler
+       options and GROMACS build that produced it, so all of them form
+       part of the key. They are hashed to keep the filename length
+       reasonable, while the kernel and device names stay readable. */
+    std::string key;
+    key.append(deviceName.data(), deviceNameLength);
+    key.append(driverVersion.data(), driverVersionLength);
+    key += buildOptions;
+    key += gmx_version();
+    key += gmx_version_git_full_hash();
+    const size_t keyHash = std::hash<std::string>()(key);
+
     std::string cacheFilename = "OCL-cache";
     /* remove the kernel source suffix */
     cacheFilename += "_" + stripSuffixIfPresent(kernelFilename, ".cl") + "_";
@@ -96,7 +122,7 @@ std::string makeBinaryCacheFilename(const std::string& kernelFilename, cl_device
        filename. */
     std::copy_if(deviceName.begin(), deviceName.begin() + deviceNameLength,
                  std::back_inserter(cacheFilename), isalnum);
-    cacheFilename += ".bin";
+    cacheFilename += formatString("_%08zx.bin", keyHash);
 
     return cacheFilename;
 }
@@ -125,12 +151,11 @@ cl_program makeProgramFromCache(const std::string& filename, cl_context context,
         GMX_THROW(FileIOError("Failed to read binary cache file " + filename));
     }
 
-    /* TODO If/when caching is re-enabled, compare current build
-     * options and code against the build options and the code
-     * corresponding to the cache. If any change is detected then the
-     * cache cannot be used.
-     *
-     * Also caching functionality will need full re-testing. */
+    /* The cache filename is keyed by the device, the driver version,
+     * the build options and the GROMACS build, so a file found under
+     * the expected name was produced by an equivalent configuration.
+     * If the contents are nevertheless unusable, program creation or
+     * the subsequent build fails and compilation from source is used. */
 
     /* Create program from pre-built binary */
     cl_int     cl_error;
@@ -57,20 +57,24 @@ namespace ocl
 {
 
 /*! \brief Construct the name for the binary cache file
+ *
+ * The name contains a hash over the device name, the driver version,
+ * the build options and the GROMACS version, so that a change in any
+ * of them leads to a different file, rather than to reuse of a stale
+ * binary.
  *
  * \param[in]  kernelFilename  Name of the kernel from which the binary will be compiled.
  * \param[in]  deviceId        ID of the device upon which the binary is used.
- *
- * \todo The set of preprocessor options should also form part of the
- * identification of the cached binary. Also perhaps compiler, runtime
- * and device version info?
+ * \param[in]  buildOptions    Full set of options passed to the OpenCL compiler.
  *
  * \todo Mutual exclusion of ranks and nodes should also be implemented
  * if/when caching is re-enabled.
  *
  * \returns The name of the cache file.
  */
-std::string makeBinaryCacheFilename(const std::string& kernelFilename, cl_device_id deviceId);
+std::string makeBinaryCacheFilename(const std::string& kernelFilename,
+                                    cl_device_id       deviceId,
+                                    const std::string& buildOptions);
 
 /*! \brief Check if there's a valid cache available, and return it if so
  *
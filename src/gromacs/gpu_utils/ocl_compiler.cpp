@@ -430,7 +430,7 @@ cl_program compileProgram(FILE*              fplog,
     std::string cacheFilename;
     if (useBuildCache)
     {
-        cacheFilename = makeBinaryCacheFilename(kernelBaseFilename, deviceId);
+        cacheFilename = makeBinaryCacheFilename(kernelBaseFilename, deviceId, preprocessorOptions);
     }
 
     /* Create OpenCL program */
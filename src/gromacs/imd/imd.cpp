@@ -205,6 +205,13 @@ public:
     void prepareForPositionAssembly(const t_commrec* cr, const rvec x[]);
     /*! \brief Interact with any connected VMD session */
     bool run(int64_t step, bool bNS, const matrix box, const rvec x[], double t);
+    /*! \brief Send out as much of the pending send record as the connection accepts.
+     *
+     * Never blocks, so a client that reads slowly does not stall the simulation.
+     *
+     * \returns whether the complete record has been sent.
+     */
+    bool flushPendingSends();
 
     // TODO rename all the data members to have underscore suffixes
 
@@ -281,10 +288,12 @@ public:
 
     //! Buffer for force sending.
     char* forcesendbuf = nullptr;
-    //! Buffer for coordinate sending.
-    char* coordsendbuf = nullptr;
-    //! Send buffer for energies.
-    char* energysendbuf = nullptr;
+    //! Buffer holding the assembled energy and coordinate records to send.
+    char* sendrecordbuf = nullptr;
+    //! Size of the currently assembled send record.
+    int sendrecordsize = 0;
+    //! Number of bytes of the send record that still await sending.
+    int sendbytesleft = 0;
     //! Buffer to make molecules whole before sending.
     rvec* sendxbuf = nullptr;
 
@@ -458,8 +467,8 @@ static int imd_handshake(IMDSocket* socket)
 }
 
 
-/*! \brief Send energies using the energy block and the send buffer. */
-static int imd_send_energies(IMDSocket* socket, const IMDEnergyBlock* energies, char* buffer)
+/*! \brief Fill the energy record into the send buffer, returns the record size. */
+static int imd_fill_energies(char* buffer, const IMDEnergyBlock* energies)
 {
     int32_t recsize;
 
@@ -468,7 +477,7 @@ static int imd_send_energies(IMDSocket* socket, const IMDEnergyBlock* energies,
     fill_header(reinterpret_cast<IMDHeader*>(buffer), IMD_ENERGIES, 1);
     memcpy(buffer + c_headerSize, energies, sizeof(IMDEnergyBlock));
 
-    return static_cast<int>(imd_write_multiple(socket, buffer, recsize) != recsize);
+    return recsize;
 }
 
 
@@ -542,11 +551,11 @@ void ImdSession::dd_make_local_IMD_atoms(const gmx_domdec_t* dd)
 }
 
 
-/*! \brief Send positions from rvec.
+/*! \brief Fill the coordinate record into the send buffer, returns the record size.
  *
  * We need a separate send buffer and conversion to Angstrom.
  */
-static int imd_send_rvecs(IMDSocket* socket, int nat, rvec* x, char* buffer)
+static int imd_fill_rvecs(char* buffer, int nat, const rvec* x)
 {
     int32_t size;
     int     i;
@@ -567,7 +576,7 @@ static int imd_send_rvecs(IMDSocket* socket, int nat, rvec* x, char* buffer)
         memcpy(buffer + c_headerSize + i * tuplesize, sendx, tuplesize);
     }
 
-    return static_cast<int>(imd_write_multiple(socket, buffer, size) != size);
+    return size;
 }
 
 
@@ -620,9 +629,10 @@ void ImdSession::Impl::disconnectClient()
     }
 
     /* then we reset the IMD step to its default, and reset the connection boolean */
-    nstimd_new   = defaultNstImd;
-    clientsocket = nullptr;
-    bConnected   = false;
+    nstimd_new    = defaultNstImd;
+    clientsocket  = nullptr;
+    bConnected    = false;
+    sendbytesleft = 0;
 }
 
 
@@ -1430,10 +1440,6 @@ std::unique_ptr<ImdSession> makeImdSession(const t_inputrec*           ir,
     /* read environment on master and prepare socket for incoming connections */
     if (MASTER(cr))
     {
-        /* we allocate memory for our IMD energy structure */
-        int32_t recsize = c_headerSize + sizeof(IMDEnergyBlock);
-        snew(impl->energysendbuf, recsize);
-
         /* Shall we wait for a connection? */
         if (options.wait)
         {
@@ -1463,8 +1469,9 @@ std::unique_ptr<ImdSession> makeImdSession(const t_inputrec*           ir,
         /* Initialize send buffers with constant size */
         snew(impl->sendxbuf, impl->nat);
         snew(impl->energies, 1);
-        int32_t bufxsize = c_headerSize + 3 * sizeof(float) * impl->nat;
-        snew(impl->coordsendbuf, bufxsize);
+        /* One buffer holding the energy record followed by the coordinate record */
+        int32_t bufsize = c_headerSize + sizeof(IMDEnergyBlock) + c_headerSize + 3 * sizeof(float) * impl->nat;
+        snew(impl->sendrecordbuf, bufsize);
     }
 
     /* do we allow interactive pulling? If so let the other nodes know. */
@@ -1504,6 +1511,33 @@ std::unique_ptr<ImdSession> makeImdSession(const t_inputrec*           ir,
 }
 
 
+bool ImdSession::Impl::flushPendingSends()
+{
+    while (sendbytesleft > 0)
+    {
+        int ret = imdsock_write_nonblocking(
+                clientsocket, sendrecordbuf + sendrecordsize - sendbytesleft, sendbytesleft);
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                /* The send buffer is full because the client reads slowly;
+                 * keep the rest of the record for the next attempt. */
+                break;
+            }
+            issueFatalError("Connection failed while sending energies and positions. Disconnecting client.");
+            return false;
+        }
+        sendbytesleft -= ret;
+    }
+
+    return sendbytesleft == 0;
+}
+
 bool ImdSession::Impl::run(int64_t step, bool bNS, const matrix box, const rvec x[], double t)
 {
     /* IMD at all? */
@@ -1609,15 +1643,22 @@ void ImdSession::sendPositionsAndEnergies()
         return;
     }
 
-    if (imd_send_energies(impl_->clientsocket, impl_->energies, impl_->energysendbuf))
+    /* A client that reads slowly must not stall the simulation. We only
+     * assemble a new snapshot when the previous one has been sent out
+     * completely; otherwise this frame is skipped and the viewer shows
+     * the next complete one instead.
+     */
+    if (!impl_->flushPendingSends())
     {
-        impl_->issueFatalError("Error sending updated energies. Disconnecting client.");
+        return;
     }
 
-    if (imd_send_rvecs(impl_->clientsocket, impl_->nat, impl_->xa, impl_->coordsendbuf))
-    {
-        impl_->issueFatalError("Error sending updated positions. Disconnecting client.");
-    }
+    int size = imd_fill_energies(impl_->sendrecordbuf, impl_->energies);
+    size += imd_fill_rvecs(impl_->sendrecordbuf + size, impl_->nat, impl_->xa);
+    impl_->sendrecordsize = size;
+    impl_->sendbytesleft  = size;
+
+    impl_->flushPendingSends();
 }
 
 
@@ -1638,6 +1679,12 @@ void ImdSession::updateEnergyRecordAndSendPositionsAndEnergies(bool bIMDstep, in
         /* Send positions and energies to VMD client via IMD */
         sendPositionsAndEnergies();
     }
+    else if (impl_->clientsocket)
+    {
+        /* Keep draining a partially sent snapshot, so that the next IMD step
+         * can assemble a new one */
+        impl_->flushPendingSends();
+    }
 
     wallcycle_stop(impl_->wcycle, ewcIMD);
 }
@@ -325,6 +325,30 @@ int imdsock_write(IMDSocket* sock, const char* buffer, int length)
 }
 
 
+int imdsock_write_nonblocking(IMDSocket* sock, const char* buffer, int length)
+{
+#if GMX_IMD
+#    if GMX_NATIVE_WINDOWS
+    /* Winsock has no per-call equivalent of MSG_DONTWAIT, so we switch the
+     * socket to non-blocking mode around the send call. */
+    u_long mode = 1;
+    ioctlsocket(sock->sockfd, FIONBIO, &mode);
+    int ret = send(sock->sockfd, (const char*)buffer, length, c_noFlags);
+    mode    = 0;
+    ioctlsocket(sock->sockfd, FIONBIO, &mode);
+    return ret;
+#    else
+    return send(sock->sockfd, buffer, length, MSG_DONTWAIT);
+#    endif
+#else
+    GMX_UNUSED_VALUE(buffer);
+    GMX_UNUSED_VALUE(length);
+    GMX_UNUSED_VALUE(sock);
+    return 0;
+#endif
+}
+
+
 int imdsock_read(IMDSocket* sock, char* buffer, int length)
 {
 #if GMX_IMD
@@ -142,6 +142,21 @@ int imd_ntohl(int src);
 int imdsock_write(IMDSocket* sock, const char* buffer, int length);
 
 
+/*! \brief  Write to socket without blocking.
+ *
+ * Writes as many bytes as the socket send buffer accepts and returns
+ * immediately, also when nothing can be written.
+ *
+ * \param sock      The IMD socket.
+ * \param buffer    The data to write.
+ * \param length    Number of bytes to write.
+ *
+ * \returns The number of bytes written, or -1. When the send buffer is full,
+ *          -1 is returned with errno set to EAGAIN or EWOULDBLOCK.
+ */
+int imdsock_write_nonblocking(IMDSocket* sock, const char* buffer, int length);
+
+
 /*! \brief  Read from socket.
  *
  * \param sock      The IMD socket.
@@ -43,6 +43,7 @@
 
 #include <cassert>
 
+#include "gromacs/utility/gmxomp.h"
 #include "gromacs/utility/smalloc.h"
 
 gmx_sparsematrix_t* gmx_sparsematrix_init(int nrow)
@@ -249,37 +250,91 @@ void gmx_sparsematrix_vector_multiply(gmx_sparsematrix_t* A, real* x, real* y)
     real                      s, v, xi;
     int                       i, j, k;
     gmx_sparsematrix_entry_t* data; /* pointer to simplify data access */
-
-    for (i = 0; i < A->nrow; i++)
-    {
-        y[i] = 0;
-    }
+    int                       nrow     = A->nrow;
+    int                       nthreads = gmx_omp_get_max_threads();
 
     if (A->compressed_symmetric)
     {
-        for (i = 0; i < A->nrow; i++)
+        if (nthreads > 1)
         {
-            xi   = x[i];
-            s    = 0.0;
-            data = A->data[i];
+            /* With compressed symmetric storage each row also scatters into
+             * y[col], so the threads accumulate into private buffers that
+             * are reduced into y after a barrier.
+             */
+            real* ybuf;
 
-            for (k = 0; k < A->ndata[i]; k++)
+            snew(ybuf, nthreads * nrow);
+#pragma omp parallel private(s, v, xi, i, j, k, data)
             {
-                j = data[k].col;
-                v = data[k].value;
-                s += v * x[j];
-                if (i != j)
+                int   thread_id = gmx_omp_get_thread_num();
+                int   i0        = (thread_id * nrow) / nthreads;
+                int   i1        = ((thread_id + 1) * nrow) / nthreads;
+                real* yt        = ybuf + thread_id * nrow;
+
+                for (i = i0; i < i1; i++)
+                {
+                    xi   = x[i];
+                    s    = 0.0;
+                    data = A->data[i];
+
+                    for (k = 0; k < A->ndata[i]; k++)
+                    {
+                        j = data[k].col;
+                        v = data[k].value;
+                        s += v * x[j];
+                        if (i != j)
+                        {
+                            yt[j] += v * xi;
+                        }
+                    }
+                    yt[i] += s;
+                }
+#pragma omp barrier
+                for (i = i0; i < i1; i++)
+                {
+                    s = 0.0;
+                    for (k = 0; k < nthreads; k++)
+                    {
+                        s += ybuf[k * nrow + i];
+                    }
+                    y[i] = s;
+                }
+            }
+            sfree(ybuf);
+        }
+        else
+        {
+            for (i = 0; i < nrow; i++)
+            {
+                y[i] = 0;
+            }
+            for (i = 0; i < nrow; i++)
+            {
+                xi   = x[i];
+                s    = 0.0;
+                data = A->data[i];
+
+                for (k = 0; k < A->ndata[i]; k++)
                 {
-                    y[j] += v * xi;
+                    j = data[k].col;
+                    v = data[k].value;
+                    s += v * x[j];
+                    if (i != j)
+                    {
+                        y[j] += v * xi;
+                    }
                 }
+                y[i] += s;
             }
-            y[i] += s;
         }
     }
     else
     {
-        /* not compressed symmetric storage */
-        for (i = 0; i < A->nrow; i++)
+        /* Not compressed symmetric storage; each row only writes its own
+         * element of y, so the rows can be distributed directly.
+         */
+#pragma omp parallel for schedule(static) private(s, v, j, k, data)
+        for (i = 0; i < nrow; i++)
         {
             s    = 0.0;
             data = A->data[i];
@@ -290,7 +345,7 @@ void gmx_sparsematrix_vector_multiply(gmx_sparsematrix_t* A, real* x, real* y)
                 v = data[k].value;
                 s += v * x[j];
             }
-            y[i] += s;
+            y[i] = s;
         }
     }
 }
@@ -71,6 +71,8 @@
 #include "gromacs/simd/simd.h"
 #include "gromacs/simd/simd_math.h"
 #include "gromacs/simd/vector_operations.h"
+#include "gromacs/tables/cubicsplinetable.h"
+#include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/basedefinitions.h"
 #include "gromacs/utility/enumerationhelpers.h"
 #include "gromacs/utility/fatalerror.h"
@@ -2185,19 +2187,20 @@ rbdihs(int             nbonds,
 
 
 template<BondedKernelFlavor flavor>
-real idihs(int             nbonds,
-           const t_iatom   forceatoms[],
-           const t_iparams forceparams[],
-           const rvec      x[],
-           rvec4           f[],
-           rvec            fshift[],
-           const t_pbc*    pbc,
-           const t_graph*  g,
-           real            lambda,
-           real*           dvdlambda,
-           const t_mdatoms gmx_unused* md,
-           t_fcdata gmx_unused* fcd,
-           int gmx_unused* global_atom_index)
+std::enable_if_t<flavor != BondedKernelFlavor::ForcesSimdWhenAvailable || !GMX_SIMD_HAVE_REAL, real>
+idihs(int             nbonds,
+      const t_iatom   forceatoms[],
+      const t_iparams forceparams[],
+      const rvec      x[],
+      rvec4           f[],
+      rvec            fshift[],
+      const t_pbc*    pbc,
+      const t_graph*  g,
+      real            lambda,
+      real*           dvdlambda,
+      const t_mdatoms gmx_unused* md,
+      t_fcdata gmx_unused* fcd,
+      int gmx_unused* global_atom_index)
 {
     int  i, type, ai, aj, ak, al;
     int  t1, t2, t3;
@@ -2254,6 +2257,128 @@ real idihs(int             nbonds,
     return vtot;
 }
 
+#if GMX_SIMD_HAVE_REAL
+
+/* As idihs above, but using SIMD to calculate many impropers at once.
+ * This function can replace idihs() when no energy and virial are needed.
+ */
+template<BondedKernelFlavor flavor>
+std::enable_if_t<flavor == BondedKernelFlavor::ForcesSimdWhenAvailable, real>
+idihs(int             nbonds,
+      const t_iatom   forceatoms[],
+      const t_iparams forceparams[],
+      const rvec      x[],
+      rvec4           f[],
+      rvec gmx_unused fshift[],
+      const t_pbc*    pbc,
+      const t_graph gmx_unused* g,
+      real gmx_unused lambda,
+      real gmx_unused* dvdlambda,
+      const t_mdatoms gmx_unused* md,
+      t_fcdata gmx_unused* fcd,
+      int gmx_unused* global_atom_index)
+{
+    const int                                nfa1 = 5;
+    int                                      i, iu, s;
+    int                                      type;
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ai[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t aj[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t ak[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t al[GMX_SIMD_REAL_WIDTH];
+    alignas(GMX_SIMD_ALIGNMENT) real         buf[2 * GMX_SIMD_REAL_WIDTH];
+    real *                                   kk, *phi0;
+    SimdReal                                 deg2rad_S(DEG2RAD);
+    SimdReal                                 p_S, q_S;
+    SimdReal                                 phi0_S, phi_S;
+    SimdReal                                 mx_S, my_S, mz_S;
+    SimdReal                                 nx_S, ny_S, nz_S;
+    SimdReal                                 nrkj_m2_S, nrkj_n2_S;
+    SimdReal                                 kk_S, dp_S;
+    SimdReal                                 mddphi_S;
+    SimdReal                                 sf_i_S, msf_l_S;
+    alignas(GMX_SIMD_ALIGNMENT) real         pbc_simd[9 * GMX_SIMD_REAL_WIDTH];
+
+    SimdReal twoPi_S(2.0 * M_PI);
+    SimdReal oneOverTwoPi_S(1.0 / (2.0 * M_PI));
+
+    /* Extract aligned pointer for parameters and variables */
+    kk   = buf + 0 * GMX_SIMD_REAL_WIDTH;
+    phi0 = buf + 1 * GMX_SIMD_REAL_WIDTH;
+
+    set_pbc_simd(pbc, pbc_simd);
+
+    /* nbonds is the number of dihedrals times nfa1, here we step GMX_SIMD_REAL_WIDTH dihs */
+    for (i = 0; (i < nbonds); i += GMX_SIMD_REAL_WIDTH * nfa1)
+    {
+        /* Collect atoms quadruplets for GMX_SIMD_REAL_WIDTH dihedrals.
+         * iu indexes into forceatoms, we should not let iu go beyond nbonds.
+         */
+        iu = i;
+        for (s = 0; s < GMX_SIMD_REAL_WIDTH; s++)
+        {
+            type  = forceatoms[iu];
+            ai[s] = forceatoms[iu + 1];
+            aj[s] = forceatoms[iu + 2];
+            ak[s] = forceatoms[iu + 3];
+            al[s] = forceatoms[iu + 4];
+
+            /* At the end fill the arrays with the last atoms and 0 params */
+            if (i + s * nfa1 < nbonds)
+            {
+                kk[s]   = forceparams[type].harmonic.krA;
+                phi0[s] = forceparams[type].harmonic.rA;
+
+                if (iu + nfa1 < nbonds)
+                {
+                    iu += nfa1;
+                }
+            }
+            else
+            {
+                kk[s]   = 0;
+                phi0[s] = 0;
+            }
+        }
+
+        /* Caclulate GMX_SIMD_REAL_WIDTH dihedral angles at once */
+        dih_angle_simd(x, ai, aj, ak, al, pbc_simd, &phi_S, &mx_S, &my_S, &mz_S, &nx_S, &ny_S,
+                       &nz_S, &nrkj_m2_S, &nrkj_n2_S, &p_S, &q_S);
+
+        kk_S   = load<SimdReal>(kk);
+        phi0_S = load<SimdReal>(phi0) * deg2rad_S;
+
+        /* The potential is harmonic in the deviation, which we need to
+         * take modulo 2*pi into (-pi,pi), as in make_dp_periodic above.
+         * Since |phi - phi0| < 2*pi, rounding once suffices.
+         */
+        dp_S = phi_S - phi0_S;
+        dp_S = fnma(round(dp_S * oneOverTwoPi_S), twoPi_S, dp_S);
+
+        /* The minus sign matches the sign convention of the force
+         * update, as in the SIMD flavor of pdihs above.
+         */
+        mddphi_S = -(kk_S * dp_S);
+        sf_i_S   = mddphi_S * nrkj_m2_S;
+        msf_l_S  = mddphi_S * nrkj_n2_S;
+
+        /* After this m?_S will contain f[i] */
+        mx_S = sf_i_S * mx_S;
+        my_S = sf_i_S * my_S;
+        mz_S = sf_i_S * mz_S;
+
+        /* After this m?_S will contain -f[l] */
+        nx_S = msf_l_S * nx_S;
+        ny_S = msf_l_S * ny_S;
+        nz_S = msf_l_S * nz_S;
+
+        do_dih_fup_noshiftf_simd(ai, aj, ak, al, p_S, q_S, mx_S, my_S, mz_S, nx_S, ny_S, nz_S, f);
+    }
+
+    return 0;
+}
+
+#endif // GMX_SIMD_HAVE_REAL
+
 /*! \brief Computes angle restraints of two different types */
 template<BondedKernelFlavor flavor>
 real low_angres(int             nbonds,
@@ -3799,37 +3924,90 @@ real tab_bonds(int             nbonds,
                t_fcdata*                   fcd,
                int gmx_unused* global_atom_index)
 {
-    int  i, ki, ai, aj, type, table;
-    real dr, dr2, fbond, vbond, vtot;
-    rvec dx;
+    /* Number of bonds gathered per table evaluation batch */
+    constexpr int c_batchSize = 64;
 
-    vtot = 0.0;
-    for (i = 0; (i < nbonds);)
-    {
-        type = forceatoms[i++];
-        ai   = forceatoms[i++];
-        aj   = forceatoms[i++];
+    int  typeBatch[c_batchSize], aiBatch[c_batchSize], ajBatch[c_batchSize], kiBatch[c_batchSize];
+    rvec dxBatch[c_batchSize];
+    real drBatch[c_batchSize], dr2Batch[c_batchSize];
+    real vBatch[c_batchSize], fBatch[c_batchSize];
 
-        ki  = pbc_rvec_sub(pbc, x[ai], x[aj], dx); /*   3      */
-        dr2 = iprod(dx, dx);                       /*   5		*/
-        dr  = dr2 * gmx::invsqrt(dr2);             /*  10		*/
+    real vtot = 0.0;
+    int  i    = 0;
+    while (i < nbonds)
+    {
+        const int                    table  = forceparams[forceatoms[i]].tab.table;
+        const bondedtable_t*         tab    = &fcd->bondtab[table];
+        const gmx::CubicSplineTable* spline = tab->cubicSpline;
 
-        table = forceparams[type].tab.table;
+        /* Gather a batch of bonds that use the same table */
+        int nbatch = 0;
+        while (i < nbonds && nbatch < c_batchSize && forceparams[forceatoms[i]].tab.table == table)
+        {
+            const int type = forceatoms[i++];
+            const int ai   = forceatoms[i++];
+            const int aj   = forceatoms[i++];
+
+            typeBatch[nbatch] = type;
+            aiBatch[nbatch]   = ai;
+            ajBatch[nbatch]   = aj;
+            kiBatch[nbatch]   = pbc_rvec_sub(pbc, x[ai], x[aj], dxBatch[nbatch]); /*   3      */
+            dr2Batch[nbatch]  = iprod(dxBatch[nbatch], dxBatch[nbatch]);          /*   5      */
+            drBatch[nbatch]   = dr2Batch[nbatch] * gmx::invsqrt(dr2Batch[nbatch]); /*  10      */
+            nbatch++;
+        }
 
-        *dvdlambda += bonded_tab("bond", table, &fcd->bondtab[table], forceparams[type].tab.kA,
-                                 forceparams[type].tab.kB, dr, lambda, &vbond, &fbond); /*  22 */
+        if (spline != nullptr)
+        {
+            for (int b = 0; b < nbatch; b++)
+            {
+                if (drBatch[b] * tab->scale >= tab->n - 1)
+                {
+                    gmx_fatal(FARGS,
+                              "A tabulated bond interaction table number %d is out of the table "
+                              "range: r %f, between table indices %d and %d, table length %d",
+                              table, drBatch[b], static_cast<int>(drBatch[b] * tab->scale),
+                              static_cast<int>(drBatch[b] * tab->scale) + 1, tab->n);
+                }
+            }
+            spline->evaluateFunctionAndDerivativeBatch(
+                    gmx::constArrayRefFromArray(drBatch, nbatch),
+                    gmx::arrayRefFromArray(vBatch, nbatch), gmx::arrayRefFromArray(fBatch, nbatch));
+            for (int b = 0; b < nbatch; b++)
+            {
+                const real kA = forceparams[typeBatch[b]].tab.kA;
+                const real kB = forceparams[typeBatch[b]].tab.kB;
+                const real k  = (1.0 - lambda) * kA + lambda * kB;
 
-        if (dr2 == 0.0)
+                *dvdlambda += (kB - kA) * vBatch[b];
+                vBatch[b] *= k;
+                fBatch[b] *= -k;
+            }
+        }
+        else
         {
-            continue;
+            for (int b = 0; b < nbatch; b++)
+            {
+                *dvdlambda += bonded_tab("bond", table, tab, forceparams[typeBatch[b]].tab.kA,
+                                         forceparams[typeBatch[b]].tab.kB, drBatch[b], lambda,
+                                         &vBatch[b], &fBatch[b]); /*  22 */
+            }
         }
 
+        for (int b = 0; b < nbatch; b++)
+        {
+            if (dr2Batch[b] == 0.0)
+            {
+                continue;
+            }
 
-        vtot += vbond;              /* 1*/
-        fbond *= gmx::invsqrt(dr2); /*   6		*/
+            vtot += vBatch[b];                                        /* 1*/
+            const real fbond = fBatch[b] * gmx::invsqrt(dr2Batch[b]); /*   6		*/
 
-        spreadBondForces<flavor>(fbond, dx, ai, aj, f, ki, g, fshift); /* 15 */
-    }                                                                  /* 62 TOTAL	*/
+            spreadBondForces<flavor>(fbond, dxBatch[b], aiBatch[b], ajBatch[b], f, kiBatch[b], g,
+                                     fshift); /* 15 */
+        }
+    } /* 62 TOTAL	*/
     return vtot;
 }
 
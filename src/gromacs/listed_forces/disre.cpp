@@ -62,9 +62,11 @@
 #include "gromacs/pbcutil/pbc.h"
 #include "gromacs/topology/mtop_util.h"
 #include "gromacs/topology/topology.h"
+#include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/futil.h"
 #include "gromacs/utility/gmxassert.h"
+#include "gromacs/utility/gmxomp.h"
 #include "gromacs/utility/pleasecite.h"
 #include "gromacs/utility/smalloc.h"
 
@@ -218,6 +220,13 @@ void init_disres(FILE*                 fplog,
     snew(dd->Rt_6, 2 * dd->nres);
     dd->Rtav_6 = &(dd->Rt_6[dd->nres]);
 
+    /* The pair loop in calc_disres_R_6 runs thread-parallel with each
+     * thread accumulating into its own partial restraint sums, which are
+     * reduced into Rt_6 and Rtav_6 afterwards.
+     */
+    dd->nthreads = gmx_omp_get_max_threads();
+    snew(dd->Rt_6_thread, dd->nthreads * 2 * dd->nres);
+
     ptr = getenv("GMX_DISRE_ENSEMBLE_SIZE");
     if (cr && ms != nullptr && ptr != nullptr && !bIsREMD)
     {
@@ -304,7 +313,6 @@ void calc_disres_R_6(const t_commrec*      cr,
                      t_fcdata*             fcd,
                      history_t*            hist)
 {
-    rvec          dx;
     real *        rt, *rm3tav, *Rtl_6, *Rt_6, *Rtav_6;
     t_disresdata* dd;
     real          ETerm, ETerm1, cf1 = 0, cf2 = 0;
@@ -330,55 +338,83 @@ void calc_disres_R_6(const t_commrec*      cr,
         cf2 = 1.0 / (1.0 - dd->exp_min_t_tau);
     }
 
-    for (int res = 0; res < dd->nres; res++)
-    {
-        Rtav_6[res] = 0.0;
-        Rt_6[res]   = 0.0;
-    }
+    const int nthreads = dd->nthreads;
 
-    /* 'loop' over all atom pairs (pair_nr=fa/3) involved in restraints, *
-     * the total number of atoms pairs is nfa/3                          */
-    for (int fa = 0; fa < nfa; fa += 3)
+    /* 'loop' over all atom pairs (pair_nr=fa/3) involved in restraints,
+     * the total number of atoms pairs is nfa/3. Pairs belonging to the
+     * same restraint can end up in chunks assigned to different threads,
+     * so each thread accumulates into its own partial sums, which are
+     * reduced into Rt_6 and Rtav_6 below.
+     */
+#pragma omp parallel num_threads(nthreads)
     {
-        int type = forceatoms[fa];
-        int res  = type - dd->type_min;
-        int pair = fa / 3;
-        int ai   = forceatoms[fa + 1];
-        int aj   = forceatoms[fa + 2];
-
-        if (pbc)
-        {
-            pbc_dx_aiuc(pbc, x[ai], x[aj], dx);
-        }
-        else
+        try
         {
-            rvec_sub(x[ai], x[aj], dx);
-        }
-        real rt2  = iprod(dx, dx);
-        real rt_1 = gmx::invsqrt(rt2);
-        real rt_3 = rt_1 * rt_1 * rt_1;
+            real* Rt_6_t   = dd->Rt_6_thread + gmx_omp_get_thread_num() * 2 * dd->nres;
+            real* Rtav_6_t = Rt_6_t + dd->nres;
 
-        rt[pair] = rt2 * rt_1;
-        if (bTav)
-        {
-            /* Here we update rm3tav in t_fcdata using the data
-             * in history_t.
-             * Thus the results stay correct when this routine
-             * is called multiple times.
-             */
-            rm3tav[pair] = cf2 * ((ETerm - cf1) * hist->disre_rm3tav[pair] + ETerm1 * rt_3);
-        }
-        else
-        {
-            rm3tav[pair] = rt_3;
-        }
+            for (int res = 0; res < dd->nres; res++)
+            {
+                Rt_6_t[res]   = 0.0;
+                Rtav_6_t[res] = 0.0;
+            }
 
-        /* Currently divide_bondeds_over_threads() ensures that pairs within
-         * the same restraint get assigned to the same thread, so we could
-         * run this loop thread-parallel.
-         */
-        Rt_6[res] += rt_3 * rt_3;
-        Rtav_6[res] += rm3tav[pair] * rm3tav[pair];
+#pragma omp for schedule(static)
+            for (int fa = 0; fa < nfa; fa += 3)
+            {
+                int  type = forceatoms[fa];
+                int  res  = type - dd->type_min;
+                int  pair = fa / 3;
+                int  ai   = forceatoms[fa + 1];
+                int  aj   = forceatoms[fa + 2];
+                rvec dx;
+
+                if (pbc)
+                {
+                    pbc_dx_aiuc(pbc, x[ai], x[aj], dx);
+                }
+                else
+                {
+                    rvec_sub(x[ai], x[aj], dx);
+                }
+                real rt2  = iprod(dx, dx);
+                real rt_1 = gmx::invsqrt(rt2);
+                real rt_3 = rt_1 * rt_1 * rt_1;
+
+                rt[pair] = rt2 * rt_1;
+                if (bTav)
+                {
+                    /* Here we update rm3tav in t_fcdata using the data
+                     * in history_t.
+                     * Thus the results stay correct when this routine
+                     * is called multiple times.
+                     */
+                    rm3tav[pair] = cf2 * ((ETerm - cf1) * hist->disre_rm3tav[pair] + ETerm1 * rt_3);
+                }
+                else
+                {
+                    rm3tav[pair] = rt_3;
+                }
+
+                Rt_6_t[res] += rt_3 * rt_3;
+                Rtav_6_t[res] += rm3tav[pair] * rm3tav[pair];
+            }
+
+#pragma omp for schedule(static)
+            for (int res = 0; res < dd->nres; res++)
+            {
+                real sumRt   = 0.0;
+                real sumRtav = 0.0;
+                for (int t = 0; t < nthreads; t++)
+                {
+                    sumRt += dd->Rt_6_thread[t * 2 * dd->nres + res];
+                    sumRtav += dd->Rt_6_thread[t * 2 * dd->nres + dd->nres + res];
+                }
+                Rt_6[res]   = sumRt;
+                Rtav_6[res] = sumRtav;
+            }
+        }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
     }
 
     /* NOTE: Rt_6 and Rtav_6 are stored consecutively in memory */
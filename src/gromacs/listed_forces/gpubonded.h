@@ -70,7 +70,7 @@ namespace gmx
 class StepWorkload;
 
 /*! \brief The number on bonded function types supported on GPUs */
-static constexpr int numFTypesOnGpu = 8;
+static constexpr int numFTypesOnGpu = 10;
 
 /*! \brief List of all bonded function types supported on GPUs
  *
@@ -79,9 +79,10 @@ static constexpr int numFTypesOnGpu = 8;
  * \note The function types in the list are ordered on increasing value.
  * \note Currently bonded are only supported with CUDA, not with OpenCL.
  */
-constexpr std::array<int, numFTypesOnGpu> fTypesOnGpu = { F_BONDS,  F_ANGLES, F_UREY_BRADLEY,
-                                                          F_PDIHS,  F_RBDIHS, F_IDIHS,
-                                                          F_PIDIHS, F_LJ14 };
+constexpr std::array<int, numFTypesOnGpu> fTypesOnGpu = { F_BONDS, F_ANGLES, F_UREY_BRADLEY,
+                                                          F_PDIHS, F_RBDIHS, F_IDIHS,
+                                                          F_PIDIHS, F_CMAP, F_LJ14,
+                                                          F_DIHRES };
 
 /*! \brief Checks whether the GROMACS build allows to compute bonded interactions on a GPU.
  *
@@ -48,6 +48,9 @@
 
 #include "gpubonded_impl.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "gromacs/gpu_utils/cuda_arch_utils.cuh"
 #include "gromacs/gpu_utils/cudautils.cuh"
 #include "gromacs/gpu_utils/devicebuffer.h"
@@ -74,6 +77,25 @@ GpuBonded::Impl::Impl(const gmx_ffparams_t& ffparams, void* streamPtr, gmx_wallc
     // to consume additional pinned pages.
     copyToDeviceBuffer(&d_forceParams_, ffparams.iparams.data(), 0, ffparams.numTypes(), stream_,
                        GpuApiCallBehavior::Sync, nullptr);
+    /* The pre-interpolated CMAP grids are constant over the run, concatenate
+     * them over the CMAP types into a single device buffer.
+     */
+    const gmx_cmap_t& cmapGrid = ffparams.cmap_grid;
+    if (!cmapGrid.cmapdata.empty())
+    {
+        const size_t       gridSize = 4 * cmapGrid.grid_spacing * cmapGrid.grid_spacing;
+        std::vector<float> cmapData(cmapGrid.cmapdata.size() * gridSize);
+        for (size_t i = 0; i < cmapGrid.cmapdata.size(); i++)
+        {
+            GMX_RELEASE_ASSERT(cmapGrid.cmapdata[i].cmap.size() == gridSize,
+                               "All CMAP grids should have the same spacing");
+            std::copy(cmapGrid.cmapdata[i].cmap.begin(), cmapGrid.cmapdata[i].cmap.end(),
+                      cmapData.begin() + i * gridSize);
+        }
+        allocateDeviceBuffer(&d_cmapData_, cmapData.size(), nullptr);
+        copyToDeviceBuffer(&d_cmapData_, cmapData.data(), 0, cmapData.size(), stream_,
+                           GpuApiCallBehavior::Sync, nullptr);
+    }
     vTot_.resize(F_NRE);
     allocateDeviceBuffer(&d_vTot_, F_NRE, nullptr);
     clearDeviceBufferAsync(&d_vTot_, 0, F_NRE, stream_);
@@ -85,11 +107,13 @@ GpuBonded::Impl::Impl(const gmx_ffparams_t& ffparams, void* streamPtr, gmx_wallc
         d_iLists_[fType].nalloc = 0;
     }
 
-    kernelParams_.d_forceParams = d_forceParams_;
-    kernelParams_.d_xq          = d_xq_;
-    kernelParams_.d_f           = d_f_;
-    kernelParams_.d_fShift      = d_fShift_;
-    kernelParams_.d_vTot        = d_vTot_;
+    kernelParams_.d_forceParams   = d_forceParams_;
+    kernelParams_.d_cmapData      = d_cmapData_;
+    kernelParams_.cmapGridSpacing = cmapGrid.grid_spacing;
+    kernelParams_.d_xq            = d_xq_;
+    kernelParams_.d_f             = d_f_;
+    kernelParams_.d_fShift        = d_fShift_;
+    kernelParams_.d_vTot          = d_vTot_;
     for (int i = 0; i < numFTypesOnGpu; i++)
     {
         kernelParams_.d_iatoms[i]        = nullptr;
@@ -110,6 +134,7 @@ GpuBonded::Impl::~Impl()
     }
 
     freeDeviceBuffer(&d_forceParams_);
+    freeDeviceBuffer(&d_cmapData_);
     freeDeviceBuffer(&d_vTot_);
 }
 
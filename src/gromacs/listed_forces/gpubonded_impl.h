@@ -94,6 +94,10 @@ struct BondedCudaKernelParameters
 
     //! Force parameters (on GPU)
     t_iparams* d_forceParams;
+    //! CMAP grids, pre-interpolated, concatenated over the CMAP types (on GPU)
+    const float* d_cmapData;
+    //! The number of grid points along each CMAP grid dimension
+    int cmapGridSpacing;
     //! Coordinates before the timestep (on GPU)
     const float4* d_xq;
     //! Forces on atoms (on GPU)
@@ -111,12 +115,14 @@ struct BondedCudaKernelParameters
 
         setPbcAiuc(0, boxDummy, &pbcAiuc);
 
-        scaleFactor   = 1.0;
-        d_forceParams = nullptr;
-        d_xq          = nullptr;
-        d_f           = nullptr;
-        d_fShift      = nullptr;
-        d_vTot        = nullptr;
+        scaleFactor     = 1.0;
+        d_forceParams   = nullptr;
+        d_cmapData      = nullptr;
+        cmapGridSpacing = 0;
+        d_xq            = nullptr;
+        d_f             = nullptr;
+        d_fShift        = nullptr;
+        d_vTot          = nullptr;
     }
 };
 
@@ -168,6 +174,8 @@ private:
     t_ilist d_iLists_[F_NRE];
     //! Bonded parameters for device-side use.
     t_iparams* d_forceParams_ = nullptr;
+    //! CMAP grids for device-side use, concatenated over the CMAP types.
+    float* d_cmapData_ = nullptr;
     //! Position-charge vector on the device.
     const float4* d_xq_ = nullptr;
     //! Force vector on the device.
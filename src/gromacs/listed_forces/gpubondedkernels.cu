@@ -78,6 +78,7 @@
 /*------------------------------------------------------------------------------*/
 
 #define CUDA_DEG2RAD_F (CUDART_PI_F / 180.0f)
+#define CUDA_RAD2DEG_F (180.0f / CUDART_PI_F)
 
 /*---------------- BONDED CUDA kernels--------------*/
 
@@ -660,6 +661,393 @@ __device__ void idihs_gpu(const int       i,
     }
 }
 
+template<bool calcVir, bool calcEner>
+__device__ void dihres_gpu(const int       i,
+                           float*          vtot_loc,
+                           const int       numBonds,
+                           const t_iatom   d_forceatoms[],
+                           const t_iparams d_forceparams[],
+                           const float4    gm_xq[],
+                           float3          gm_f[],
+                           float3          sm_fShiftLoc[],
+                           const PbcAiuc   pbcAiuc)
+{
+    if (i < numBonds)
+    {
+        int type = d_forceatoms[5 * i];
+        int ai   = d_forceatoms[5 * i + 1];
+        int aj   = d_forceatoms[5 * i + 2];
+        int ak   = d_forceatoms[5 * i + 3];
+        int al   = d_forceatoms[5 * i + 4];
+
+        float phi0 = d_forceparams[type].dihres.phiA * CUDA_DEG2RAD_F;
+        float dphi = d_forceparams[type].dihres.dphiA * CUDA_DEG2RAD_F;
+        float kfac = d_forceparams[type].dihres.kfacA;
+
+        float3 r_ij;
+        float3 r_kj;
+        float3 r_kl;
+        float3 m;
+        float3 n;
+        int    t1;
+        int    t2;
+        int    t3;
+        float  phi = dih_angle_gpu<calcVir>(gm_xq[ai], gm_xq[aj], gm_xq[ak], gm_xq[al], pbcAiuc,
+                                           &r_ij, &r_kj, &r_kl, &m, &n, &t1, &t2, &t3);
+
+        /* As for idihs, take phi-phi0 modulo (-pi,pi) to avoid periodicity problems */
+        float dp = phi - phi0;
+
+        make_dp_periodic_gpu(&dp);
+
+        /* The restraint potential is flat within the band -dphi to dphi */
+        float ddp;
+        if (dp > dphi)
+        {
+            ddp = dp - dphi;
+        }
+        else if (dp < -dphi)
+        {
+            ddp = dp + dphi;
+        }
+        else
+        {
+            ddp = 0.0f;
+        }
+
+        if (ddp != 0.0f)
+        {
+            float ddphi = kfac * ddp;
+
+            do_dih_fup_gpu<calcVir>(ai, aj, ak, al, ddphi, r_ij, r_kj, r_kl, m, n, gm_f,
+                                    sm_fShiftLoc, pbcAiuc, gm_xq, t1, t2, t3);
+
+            if (calcEner)
+            {
+                *vtot_loc += 0.5f * kfac * ddp * ddp;
+            }
+        }
+    }
+}
+
+/* The CMAP coefficient matrix, as on the CPU side */
+__constant__ int c_cmapCoeffMatrix[] = {
+    1,  0,  -3, 2,  0,  0, 0,  0,  -3, 0,  9,  -6, 2, 0,  -6, 4,  0,  0,  0, 0,  0, 0, 0,  0,
+    3,  0,  -9, 6,  -2, 0, 6,  -4, 0,  0,  0,  0,  0, 0,  0,  0,  0,  0,  9, -6, 0, 0, -6, 4,
+    0,  0,  3,  -2, 0,  0, 0,  0,  0,  0,  -9, 6,  0, 0,  6,  -4, 0,  0,  0, 0,  1, 0, -3, 2,
+    -2, 0,  6,  -4, 1,  0, -3, 2,  0,  0,  0,  0,  0, 0,  0,  0,  -1, 0,  3, -2, 1, 0, -3, 2,
+    0,  0,  0,  0,  0,  0, 0,  0,  0,  0,  -3, 2,  0, 0,  3,  -2, 0,  0,  0, 0,  0, 0, 3,  -2,
+    0,  0,  -6, 4,  0,  0, 3,  -2, 0,  1,  -2, 1,  0, 0,  0,  0,  0,  -3, 6, -3, 0, 2, -4, 2,
+    0,  0,  0,  0,  0,  0, 0,  0,  0,  3,  -6, 3,  0, -2, 4,  -2, 0,  0,  0, 0,  0, 0, 0,  0,
+    0,  0,  -3, 3,  0,  0, 2,  -2, 0,  0,  -1, 1,  0, 0,  0,  0,  0,  0,  3, -3, 0, 0, -2, 2,
+    0,  0,  0,  0,  0,  1, -2, 1,  0,  -2, 4,  -2, 0, 1,  -2, 1,  0,  0,  0, 0,  0, 0, 0,  0,
+    0,  -1, 2,  -1, 0,  1, -2, 1,  0,  0,  0,  0,  0, 0,  0,  0,  0,  0,  1, -1, 0, 0, -1, 1,
+    0,  0,  0,  0,  0,  0, -1, 1,  0,  0,  2,  -2, 0, 0,  -1, 1
+};
+
+/* As cmap_setup_grid_index on the CPU, but only returning the indices
+ * that are actually used for the grid cell lookup.
+ */
+__device__ __forceinline__ static int cmap_setup_grid_index_gpu(int ip, const int grid_spacing, int* ipp1)
+{
+    if (ip < 0)
+    {
+        ip = ip + grid_spacing - 1;
+    }
+    else if (ip > grid_spacing)
+    {
+        ip = ip - grid_spacing - 1;
+    }
+
+    int ip1 = ip + 1;
+
+    if (ip == grid_spacing - 1)
+    {
+        ip1 = 0;
+    }
+
+    *ipp1 = ip1;
+
+    return ip;
+}
+
+/* Computes the dihedral angle of one of the two CMAP torsions together
+ * with the vectors needed for the force calculation. Following the CPU
+ * code, the angle from the cross products is refined with asin/acos for
+ * accuracy.
+ */
+template<bool returnShift>
+__device__ static float cmap_dih_angle_gpu(const float4   xi,
+                                           const float4   xj,
+                                           const float4   xk,
+                                           const float4   xl,
+                                           const PbcAiuc& pbcAiuc,
+                                           float3*        r_ij,
+                                           float3*        r_kj,
+                                           float3*        r_kl,
+                                           float3*        a,
+                                           float3*        b,
+                                           float*         ra2r,
+                                           float*         rb2r,
+                                           float*         rg,
+                                           int*           t1,
+                                           int*           t2)
+{
+    *t1 = pbcDxAiuc<returnShift>(pbcAiuc, xi, xj, *r_ij);
+    *t2 = pbcDxAiuc<returnShift>(pbcAiuc, xk, xj, *r_kj);
+    pbcDxAiuc<returnShift>(pbcAiuc, xk, xl, *r_kl);
+
+    *a = cprod(*r_ij, *r_kj);
+    *b = cprod(*r_kl, *r_kj);
+
+    float3 h;
+    pbcDxAiuc<returnShift>(pbcAiuc, xl, xk, h);
+
+    float ra2 = norm2(*a);
+    float rb2 = norm2(*b);
+    float rg2 = norm2(*r_kj);
+    *rg       = sqrtf(rg2);
+
+    *ra2r      = 1.0f / ra2;
+    *rb2r      = 1.0f / rb2;
+    float rabr = sqrtf((*ra2r) * (*rb2r));
+
+    /* b = -n of the convention in dih_angle_gpu, hence the minus sign */
+    float cos_phi = -iprod(*a, *b) * rabr;
+    float sin_phi = (*rg) * rabr * iprod(*a, h) * (-1.0f);
+
+    float phi;
+    if (cos_phi < -0.5f || cos_phi > 0.5f)
+    {
+        phi = asinf(sin_phi);
+
+        if (cos_phi < 0.0f)
+        {
+            if (phi > 0.0f)
+            {
+                phi = CUDART_PI_F - phi;
+            }
+            else
+            {
+                phi = -CUDART_PI_F - phi;
+            }
+        }
+    }
+    else
+    {
+        phi = acosf(cos_phi);
+
+        if (sin_phi < 0.0f)
+        {
+            phi = -phi;
+        }
+    }
+
+    return phi;
+}
+
+/* Spreads the forces of one CMAP torsion over its four atoms */
+template<bool calcVir>
+__device__ static void cmap_dih_fup_gpu(const int    ai,
+                                        const int    aj,
+                                        const int    ak,
+                                        const int    al,
+                                        const float  df,
+                                        const float3 r_ij,
+                                        const float3 r_kj,
+                                        const float3 r_kl,
+                                        const float3 a,
+                                        const float3 b,
+                                        const float  ra2r,
+                                        const float  rb2r,
+                                        const float  rg,
+                                        float3       gm_f[],
+                                        float3       sm_fShiftLoc[],
+                                        const PbcAiuc& pbcAiuc,
+                                        const float4 gm_xq[],
+                                        const int    t1,
+                                        const int    t2)
+{
+    float rgr = 1.0f / rg;
+
+    float fg  = iprod(r_ij, r_kj);
+    float hg  = iprod(r_kl, r_kj);
+    float fga = fg * ra2r * rgr;
+    float hgb = hg * rb2r * rgr;
+    float gaa = -ra2r * rg;
+    float gbb = rb2r * rg;
+
+    float3 fv = df * (gaa * a);
+    float3 gv = df * (fga * a - hgb * b);
+    float3 hv = df * (gbb * b);
+
+    float3 f_i = fv;
+    float3 f_j = -fv - gv;
+    float3 f_k = hv + gv;
+    float3 f_l = -hv;
+
+    atomicAdd(&gm_f[ai], f_i);
+    atomicAdd(&gm_f[aj], f_j);
+    atomicAdd(&gm_f[ak], f_k);
+    atomicAdd(&gm_f[al], f_l);
+
+    if (calcVir)
+    {
+        float3 dx_jl;
+        int    t3 = pbcDxAiuc<calcVir>(pbcAiuc, gm_xq[al], gm_xq[aj], dx_jl);
+
+        atomicAdd(&sm_fShiftLoc[t1], f_i);
+        atomicAdd(&sm_fShiftLoc[CENTRAL], f_j);
+        atomicAdd(&sm_fShiftLoc[t2], f_k);
+        atomicAdd(&sm_fShiftLoc[t3], f_l);
+    }
+}
+
+template<bool calcVir, bool calcEner>
+__device__ void cmap_dihs_gpu(const int       i,
+                              float*          vtot_loc,
+                              const int       numBonds,
+                              const t_iatom   d_forceatoms[],
+                              const t_iparams d_forceparams[],
+                              const float     gm_cmapData[],
+                              const int       cmapGridSpacing,
+                              const float4    gm_xq[],
+                              float3          gm_f[],
+                              float3          sm_fShiftLoc[],
+                              const PbcAiuc   pbcAiuc)
+{
+    if (i < numBonds)
+    {
+        int type = d_forceatoms[6 * i];
+        int ai   = d_forceatoms[6 * i + 1];
+        int aj   = d_forceatoms[6 * i + 2];
+        int ak   = d_forceatoms[6 * i + 3];
+        int al   = d_forceatoms[6 * i + 4];
+        int am   = d_forceatoms[6 * i + 5];
+
+        /* Which CMAP type is this */
+        const int    cmapA = d_forceparams[type].cmap.cmapA;
+        const float* cmapd = gm_cmapData + cmapA * 4 * cmapGridSpacing * cmapGridSpacing;
+
+        /* First torsion */
+        float3 r1_ij, r1_kj, r1_kl, a1, b1;
+        float  ra2r1, rb2r1, rg1;
+        int    t11, t21;
+        float  phi1 = cmap_dih_angle_gpu<calcVir>(gm_xq[ai], gm_xq[aj], gm_xq[ak], gm_xq[al], pbcAiuc,
+                                                 &r1_ij, &r1_kj, &r1_kl, &a1, &b1, &ra2r1, &rb2r1,
+                                                 &rg1, &t11, &t21);
+
+        /* Second torsion */
+        float3 r2_ij, r2_kj, r2_kl, a2, b2;
+        float  ra2r2, rb2r2, rg2;
+        int    t12, t22;
+        float  phi2 = cmap_dih_angle_gpu<calcVir>(gm_xq[aj], gm_xq[ak], gm_xq[al], gm_xq[am], pbcAiuc,
+                                                 &r2_ij, &r2_kj, &r2_kl, &a2, &b2, &ra2r2, &rb2r2,
+                                                 &rg2, &t12, &t22);
+
+        float xphi1 = phi1 + CUDART_PI_F;
+        float xphi2 = phi2 + CUDART_PI_F;
+
+        /* Range mangling */
+        if (xphi1 < 0.0f)
+        {
+            xphi1 = xphi1 + 2.0f * CUDART_PI_F;
+        }
+        else if (xphi1 >= 2.0f * CUDART_PI_F)
+        {
+            xphi1 = xphi1 - 2.0f * CUDART_PI_F;
+        }
+
+        if (xphi2 < 0.0f)
+        {
+            xphi2 = xphi2 + 2.0f * CUDART_PI_F;
+        }
+        else if (xphi2 >= 2.0f * CUDART_PI_F)
+        {
+            xphi2 = xphi2 - 2.0f * CUDART_PI_F;
+        }
+
+        /* Where on the grid are we */
+        float dx    = 2.0f * CUDART_PI_F / cmapGridSpacing;
+        int   iphi1 = static_cast<int>(xphi1 / dx);
+        int   iphi2 = static_cast<int>(xphi2 / dx);
+
+        int ip1p1;
+        int ip2p1;
+        iphi1 = cmap_setup_grid_index_gpu(iphi1, cmapGridSpacing, &ip1p1);
+        iphi2 = cmap_setup_grid_index_gpu(iphi2, cmapGridSpacing, &ip2p1);
+
+        int pos[4];
+        pos[0] = iphi1 * cmapGridSpacing + iphi2;
+        pos[1] = ip1p1 * cmapGridSpacing + iphi2;
+        pos[2] = ip1p1 * cmapGridSpacing + ip2p1;
+        pos[3] = iphi1 * cmapGridSpacing + ip2p1;
+
+        /* Switch to degrees */
+        dx    = 360.0f / cmapGridSpacing;
+        xphi1 = xphi1 * CUDA_RAD2DEG_F;
+        xphi2 = xphi2 * CUDA_RAD2DEG_F;
+
+        float tx[16];
+#pragma unroll
+        for (int j = 0; j < 4; j++)
+        {
+            tx[j]      = cmapd[pos[j] * 4];
+            tx[j + 4]  = cmapd[pos[j] * 4 + 1] * dx;
+            tx[j + 8]  = cmapd[pos[j] * 4 + 2] * dx;
+            tx[j + 12] = cmapd[pos[j] * 4 + 3] * dx * dx;
+        }
+
+        float tc[16];
+#pragma unroll
+        for (int idx = 0; idx < 16; idx++)
+        {
+            tc[idx] = 0.0f;
+            for (int k = 0; k < 16; k++)
+            {
+                tc[idx] += c_cmapCoeffMatrix[k * 16 + idx] * tx[k];
+            }
+        }
+
+        float tt = (xphi1 - iphi1 * dx) / dx;
+        float tu = (xphi2 - iphi2 * dx) / dx;
+
+        float e   = 0.0f;
+        float df1 = 0.0f;
+        float df2 = 0.0f;
+
+#pragma unroll
+        for (int j = 3; j >= 0; j--)
+        {
+            int l1 = 12 + j;
+            int l2 = 8 + j;
+            int l3 = 4 + j;
+
+            e = tt * e
+                + ((tc[j * 4 + 3] * tu + tc[j * 4 + 2]) * tu + tc[j * 4 + 1]) * tu + tc[j * 4];
+            df1 = tu * df1 + (3.0f * tc[l1] * tt + 2.0f * tc[l2]) * tt + tc[l3];
+            df2 = tt * df2 + (3.0f * tc[j * 4 + 3] * tu + 2.0f * tc[j * 4 + 2]) * tu + tc[j * 4 + 1];
+        }
+
+        float fac = CUDA_RAD2DEG_F / dx;
+        df1       = df1 * fac;
+        df2       = df2 * fac;
+
+        if (calcEner)
+        {
+            *vtot_loc += e;
+        }
+
+        /* Do forces - first torsion */
+        cmap_dih_fup_gpu<calcVir>(ai, aj, ak, al, df1, r1_ij, r1_kj, r1_kl, a1, b1, ra2r1, rb2r1,
+                                  rg1, gm_f, sm_fShiftLoc, pbcAiuc, gm_xq, t11, t21);
+
+        /* Do forces - second torsion */
+        cmap_dih_fup_gpu<calcVir>(aj, ak, al, am, df2, r2_ij, r2_kj, r2_kl, a2, b2, ra2r2, rb2r2,
+                                  rg2, gm_f, sm_fShiftLoc, pbcAiuc, gm_xq, t12, t22);
+    }
+}
+
 template<bool calcVir, bool calcEner>
 __device__ void pairs_gpu(const int       i,
                           const int       numBonds,
@@ -791,12 +1179,23 @@ __global__ void exec_kernel_gpu(BondedCudaKernelParameters kernelParams)
                                                  kernelParams.d_forceParams, kernelParams.d_xq,
                                                  kernelParams.d_f, sm_fShiftLoc, kernelParams.pbcAiuc);
                     break;
+                case F_CMAP:
+                    cmap_dihs_gpu<calcVir, calcEner>(fTypeTid, &vtot_loc, numBonds, iatoms,
+                                                     kernelParams.d_forceParams, kernelParams.d_cmapData,
+                                                     kernelParams.cmapGridSpacing, kernelParams.d_xq,
+                                                     kernelParams.d_f, sm_fShiftLoc, kernelParams.pbcAiuc);
+                    break;
                 case F_LJ14:
                     pairs_gpu<calcVir, calcEner>(fTypeTid, numBonds, iatoms, kernelParams.d_forceParams,
                                                  kernelParams.d_xq, kernelParams.d_f, sm_fShiftLoc,
                                                  kernelParams.pbcAiuc, kernelParams.scaleFactor,
                                                  &vtotVdw_loc, &vtotElec_loc);
                     break;
+                case F_DIHRES:
+                    dihres_gpu<calcVir, calcEner>(fTypeTid, &vtot_loc, numBonds, iatoms,
+                                                  kernelParams.d_forceParams, kernelParams.d_xq,
+                                                  kernelParams.d_f, sm_fShiftLoc, kernelParams.pbcAiuc);
+                    break;
             }
             break;
         }
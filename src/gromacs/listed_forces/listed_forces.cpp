@@ -50,6 +50,7 @@
 
 #include <algorithm>
 #include <array>
+#include <vector>
 
 #include "gromacs/gmxlib/network.h"
 #include "gromacs/gmxlib/nrnb.h"
@@ -136,8 +137,18 @@ void zero_thread_output(f_thread_t* f_t)
  * never useful performance wise. */
 #define MAX_BONDED_THREADS 256
 
+/*! \brief The maximum number of thread force buffers reduced serially for one block
+ *
+ * Blocks touched by more threads than this are first pre-reduced in chunks
+ * of this size into the buffer of the first contributing thread of each
+ * chunk, with the chunks processed in parallel. This bounds the serial work
+ * per block, which would otherwise grow linearly with the thread count for
+ * blocks that most threads contribute to.
+ */
+constexpr int c_maxThreadsDirectReduction = 16;
+
 /*! \brief Reduce thread-local force buffers */
-void reduce_thread_forces(int n, gmx::ArrayRef<gmx::RVec> force, const bonded_threading_t* bt, int nthreads)
+void reduce_thread_forces(int n, gmx::ArrayRef<gmx::RVec> force, bonded_threading_t* bt, int nthreads)
 {
     if (nthreads > MAX_BONDED_THREADS)
     {
@@ -146,6 +157,88 @@ void reduce_thread_forces(int n, gmx::ArrayRef<gmx::RVec> force, const bonded_th
 
     rvec* gmx_restrict f = as_rvec_array(force.data());
 
+    const int  numChunks =
+            (bt->nthreads + c_maxThreadsDirectReduction - 1) / c_maxThreadsDirectReduction;
+    const bool useTreeReduction = (numChunks > 1);
+    if (useTreeReduction)
+    {
+        /* Count the contributing threads per block, so we know which blocks
+         * need pre-reduction and how to divide that work over the threads.
+         */
+        bt->blockNumContributors.resize(bt->nblock_used);
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+        for (int b = 0; b < bt->nblock_used; b++)
+        {
+            const int ind = bt->block_index[b];
+            int       nfb = 0;
+            for (int ft = 0; ft < bt->nthreads; ft++)
+            {
+                if (bitmask_is_set(bt->mask[ind], ft))
+                {
+                    nfb++;
+                }
+            }
+            bt->blockNumContributors[b] = nfb;
+        }
+        bt->denseBlockIndices.clear();
+        for (int b = 0; b < bt->nblock_used; b++)
+        {
+            if (bt->blockNumContributors[b] > c_maxThreadsDirectReduction)
+            {
+                bt->denseBlockIndices.push_back(b);
+            }
+        }
+
+        /* Pre-reduce each chunk of thread buffers for the dense blocks into
+         * the buffer of the first contributing thread of the chunk. The
+         * (block, chunk) pairs are independent, since each pair writes to a
+         * different buffer block, so they can all be processed in parallel.
+         */
+        const int numDenseBlocks = gmx::ssize(bt->denseBlockIndices);
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+        for (int w = 0; w < numDenseBlocks * numChunks; w++)
+        {
+            try
+            {
+                const int ind = bt->block_index[bt->denseBlockIndices[w / numChunks]];
+                const int ft0 = (w % numChunks) * c_maxThreadsDirectReduction;
+                const int ft1 = std::min(ft0 + c_maxThreadsDirectReduction, bt->nthreads);
+
+                rvec4* fp[c_maxThreadsDirectReduction];
+                rvec4* fLeader = nullptr;
+                int    nfb     = 0;
+                for (int ft = ft0; ft < ft1; ft++)
+                {
+                    if (bitmask_is_set(bt->mask[ind], ft))
+                    {
+                        if (fLeader == nullptr)
+                        {
+                            fLeader = bt->f_t[ft]->f;
+                        }
+                        else
+                        {
+                            fp[nfb++] = bt->f_t[ft]->f;
+                        }
+                    }
+                }
+                if (nfb > 0)
+                {
+                    /* The thread buffers are padded to whole blocks */
+                    const int a0 = ind * reduction_block_size;
+                    const int a1 = (ind + 1) * reduction_block_size;
+                    for (int a = a0; a < a1; a++)
+                    {
+                        for (int fb = 0; fb < nfb; fb++)
+                        {
+                            rvec_inc(fLeader[a], fp[fb][a]);
+                        }
+                    }
+                }
+            }
+            GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+        }
+    }
+
     /* This reduction can run on any number of threads,
      * independently of bt->nthreads.
      * But if nthreads matches bt->nthreads (which it currently does)
@@ -164,11 +257,31 @@ void reduce_thread_forces(int n, gmx::ArrayRef<gmx::RVec> force, const bonded_th
 
             /* Determine which threads contribute to this block */
             int nfb = 0;
-            for (int ft = 0; ft < bt->nthreads; ft++)
+            if (useTreeReduction && bt->blockNumContributors[b] > c_maxThreadsDirectReduction)
             {
-                if (bitmask_is_set(bt->mask[ind], ft))
+                /* All contributions now reside in the chunk-leader buffers */
+                for (int chunk = 0; chunk < numChunks; chunk++)
+                {
+                    const int ft0 = chunk * c_maxThreadsDirectReduction;
+                    const int ft1 = std::min(ft0 + c_maxThreadsDirectReduction, bt->nthreads);
+                    for (int ft = ft0; ft < ft1; ft++)
+                    {
+                        if (bitmask_is_set(bt->mask[ind], ft))
+                        {
+                            fp[nfb++] = bt->f_t[ft]->f;
+                            break;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                for (int ft = 0; ft < bt->nthreads; ft++)
                 {
-                    fp[nfb++] = bt->f_t[ft]->f;
+                    if (bitmask_is_set(bt->mask[ind], ft))
+                    {
+                        fp[nfb++] = bt->f_t[ft]->f;
+                    }
                 }
             }
             if (nfb > 0)
@@ -197,7 +310,7 @@ void reduce_thread_output(int                        n,
                           real*                      ener,
                           gmx_grppairener_t*         grpp,
                           real*                      dvdl,
-                          const bonded_threading_t*  bt,
+                          bonded_threading_t*        bt,
                           const gmx::StepWorkload&   stepWork)
 {
     assert(bt->haveBondeds);
@@ -382,6 +495,45 @@ real calc_one_bond(int                      thread,
     return v;
 }
 
+/*! \brief Returns the bonded function types in the order they are processed
+ *
+ * The order is the function type order, except that the listed pair
+ * interactions directly follow the dihedrals that generate them. The pairs
+ * act on the outer atoms of those dihedrals, so processing them while these
+ * atoms are still in cache avoids a second pass over the coordinate and
+ * force arrays; with function type order e.g. the CMAP terms, which stream
+ * through their grids, would run in between.
+ */
+std::vector<int> fTypeCalculationOrder()
+{
+    std::vector<int> order;
+    order.reserve(F_NRE);
+
+    for (int ftype = 0; ftype < F_NRE; ftype++)
+    {
+        if (!ftype_is_bonded_potential(ftype) || isPairInteraction(ftype))
+        {
+            continue;
+        }
+
+        order.push_back(ftype);
+
+        if (ftype == F_PIDIHS)
+        {
+            /* This is the last of the dihedral types, insert the pair types here */
+            for (int pairType = 0; pairType < F_NRE; pairType++)
+            {
+                if (ftype_is_bonded_potential(pairType) && isPairInteraction(pairType))
+                {
+                    order.push_back(pairType);
+                }
+            }
+        }
+    }
+
+    return order;
+}
+
 } // namespace
 
 /*! \brief Compute the bonded part of the listed forces, parallelized over threads
@@ -403,13 +555,14 @@ static void calcBondedForces(const t_idef*            idef,
 {
     bonded_threading_t* bt = fr->bondedThreading;
 
+    const std::vector<int> fTypeOrder = fTypeCalculationOrder();
+
 #pragma omp parallel for num_threads(bt->nthreads) schedule(static)
     for (int thread = 0; thread < bt->nthreads; thread++)
     {
         try
         {
             f_thread_t& threadBuffers = *bt->f_t[thread];
-            int         ftype;
             real *      epot, v;
             /* thread stuff */
             rvec*              fshift;
@@ -438,10 +591,10 @@ static void calcBondedForces(const t_idef*            idef,
                 dvdlt  = threadBuffers.dvdl;
             }
             /* Loop over all bonded force types to calculate the bonded forces */
-            for (ftype = 0; (ftype < F_NRE); ftype++)
+            for (int ftype : fTypeOrder)
             {
                 const t_ilist& ilist = idef->il[ftype];
-                if (ilist.nr > 0 && ftype_is_bonded_potential(ftype))
+                if (ilist.nr > 0)
                 {
                     ArrayRef<const int> iatoms = gmx::constArrayRefFromArray(ilist.iatoms, ilist.nr);
                     v                          = calc_one_bond(
@@ -584,15 +737,14 @@ void calc_listed_lambda(const t_idef*         idef,
                         const t_forcerec*     fr,
                         const struct t_pbc*   pbc,
                         const struct t_graph* g,
-                        gmx_grppairener_t*    grpp,
-                        real*                 epot,
+                        gmx_enerdata_t*       enerd,
                         t_nrnb*               nrnb,
+                        const t_lambda*       fepvals,
                         const real*           lambda,
                         const t_mdatoms*      md,
                         t_fcdata*             fcd,
                         int*                  global_atom_index)
 {
-    real          v;
     real          dvdl_dum[efptNR] = { 0 };
     rvec4*        f;
     rvec*         fshift;
@@ -617,6 +769,27 @@ void calc_listed_lambda(const t_idef*         idef,
     snew(f, fr->natoms_force);
     snew(fshift, SHIFTS);
 
+    const int numLambdas = gmx::ssize(enerd->enerpart_lambda);
+
+    /* The lambda values for the current state and all foreign states */
+    std::vector<std::array<real, efptNR>> lambdas(numLambdas);
+    for (int i = 0; i < numLambdas; i++)
+    {
+        for (int j = 0; j < efptNR; j++)
+        {
+            lambdas[i][j] = (i == 0 ? lambda[j] : fepvals->all_lambda[j][i - 1]);
+        }
+    }
+
+    /* Per lambda point accumulators for the energies. Accumulating per
+     * lambda point allows evaluating all points in a single pass over
+     * each interaction list below, so the interaction data only has to
+     * be loaded through the caches once.
+     */
+    reset_foreign_enerdata(enerd);
+    std::vector<std::array<real, F_NRE>> epotLambda(numLambdas, { { 0 } });
+    std::vector<gmx_grppairener_t>       grppLambda(numLambdas, enerd->foreign_grpp);
+
     /* Loop over all bonded force types to calculate the bonded energies */
     for (int ftype = 0; (ftype < F_NRE); ftype++)
     {
@@ -636,14 +809,26 @@ void calc_listed_lambda(const t_idef*         idef,
             {
                 gmx::StepWorkload tempFlags;
                 tempFlags.computeEnergy = true;
-                v = calc_one_bond(0, ftype, idef, iatoms, iatoms.ssize(), workDivision, x, f,
-                                  fshift, fr, pbc_null, g, grpp, nrnb, lambda, dvdl_dum, md, fcd,
-                                  tempFlags, global_atom_index);
-                epot[ftype] += v;
+                /* Evaluate all lambda points while this list is cache hot */
+                for (int i = 0; i < numLambdas; i++)
+                {
+                    const real v = calc_one_bond(0, ftype, idef, iatoms, iatoms.ssize(),
+                                                 workDivision, x, f, fshift, fr, pbc_null, g,
+                                                 &grppLambda[i], nrnb, lambdas[i].data(), dvdl_dum,
+                                                 md, fcd, tempFlags, global_atom_index);
+                    epotLambda[i][ftype] += v;
+                }
             }
         }
     }
 
+    /* Sum the energies per lambda point */
+    for (int i = 0; i < numLambdas; i++)
+    {
+        sum_epot(&grppLambda[i], epotLambda[i].data());
+        enerd->enerpart_lambda[i] += epotLambda[i][F_EPOT];
+    }
+
     sfree(fshift);
     sfree(f);
 }
@@ -697,20 +882,8 @@ void do_force_listed(struct gmx_wallcycle*    wcycle,
             {
                 gmx_incons("The bonded interactions are not sorted for free energy");
             }
-            for (size_t i = 0; i < enerd->enerpart_lambda.size(); i++)
-            {
-                real lam_i[efptNR];
-
-                reset_foreign_enerdata(enerd);
-                for (int j = 0; j < efptNR; j++)
-                {
-                    lam_i[j] = (i == 0 ? lambda[j] : fepvals->all_lambda[j][i - 1]);
-                }
-                calc_listed_lambda(idef, x, fr, pbc, graph, &(enerd->foreign_grpp),
-                                   enerd->foreign_term, nrnb, lam_i, md, fcd, global_atom_index);
-                sum_epot(&(enerd->foreign_grpp), enerd->foreign_term);
-                enerd->enerpart_lambda[i] += enerd->foreign_term[F_EPOT];
-            }
+            calc_listed_lambda(idef, x, fr, pbc, graph, enerd, nrnb, fepvals, lambda, md, fcd,
+                               global_atom_index);
             wallcycle_sub_stop(wcycle, ewcsLISTED_FEP);
         }
     }
@@ -133,17 +133,19 @@ void calc_listed(const t_commrec*         cr,
                  const gmx::StepWorkload& stepWork);
 
 /*! \brief As calc_listed(), but only determines the potential energy
- * for the perturbed interactions.
+ * of the perturbed interactions for all foreign lambda points.
  *
+ * All lambda points are evaluated in a single pass over each interaction
+ * list and the resulting energies are added to \p enerd->enerpart_lambda.
  * The shift forces in fr are not affected. */
 void calc_listed_lambda(const t_idef*         idef,
                         const rvec            x[],
                         const t_forcerec*     fr,
                         const struct t_pbc*   pbc,
                         const struct t_graph* g,
-                        gmx_grppairener_t*    grpp,
-                        real*                 epot,
+                        gmx_enerdata_t*       enerd,
                         t_nrnb*               nrnb,
+                        const t_lambda*       fepvals,
                         const real*           lambda,
                         const t_mdatoms*      md,
                         struct t_fcdata*      fcd,
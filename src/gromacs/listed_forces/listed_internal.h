@@ -125,6 +125,10 @@ struct bonded_threading_t
     std::vector<int> block_index;
     //! Mask array, one element corresponds to a block of reduction_block_size atoms of the force array, bit corresponding to thread indices set if a thread writes to that block
     std::vector<gmx_bitmask_t> mask;
+    //! Working array for the tree force reduction: the number of threads contributing to each used block
+    std::vector<int> blockNumContributors;
+    //! Working array for the tree force reduction: indices into block_index of blocks with many contributing threads
+    std::vector<int> denseBlockIndices;
     //! true if we have and thus need to reduce bonded forces
     bool haveBondeds;
 
@@ -134,6 +138,9 @@ struct bonded_threading_t
     //! Maximum thread count for uniform distribution of bondeds over threads
     int max_nthread_uniform;
 
+    //! Whether to sort the interactions within each thread block by atom index
+    bool sortBlocksByAtomIndex = false;
+
     //! The division of work in the t_list over threads.
     WorkDivision workDivision;
 
@@ -56,8 +56,12 @@ struct t_idef;
  * thread-force buffer reduction.
  * This should be called each time the bonded setup changes;
  * i.e. at start-up without domain decomposition and at DD.
+ *
+ * With GMX_BONDED_SORT_ILIST set, the interactions in \p idef are
+ * reordered within each thread block for more cache-friendly access
+ * to the force buffer.
  */
-void setup_bonded_threading(bonded_threading_t* bt, int numAtoms, bool useGpuForBondes, const t_idef& idef);
+void setup_bonded_threading(bonded_threading_t* bt, int numAtoms, bool useGpuForBondes, t_idef* idef);
 
 //! Destructor.
 void tear_down_bonded_threading(bonded_threading_t* bt);
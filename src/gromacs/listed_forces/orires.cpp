@@ -59,7 +59,9 @@
 #include "gromacs/topology/ifunc.h"
 #include "gromacs/topology/mtop_util.h"
 #include "gromacs/topology/topology.h"
+#include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/fatalerror.h"
+#include "gromacs/utility/gmxomp.h"
 #include "gromacs/utility/pleasecite.h"
 #include "gromacs/utility/smalloc.h"
 
@@ -123,7 +125,7 @@ void init_orires(FILE*                 fplog,
     int                  nmol;
     while (const InteractionLists* il = gmx_mtop_ilistloop_next(iloop, &nmol))
     {
-        if (nmol > 1)
+        if (nmol > 1 && (*il)[F_ORIRES].size() > 0)
         {
             gmx_fatal(FARGS,
                       "Found %d copies of a molecule with orientation restrains while the current "
@@ -213,6 +215,13 @@ void init_orires(FILE*                 fplog,
     }
     snew(od->tmpEq, od->nex);
 
+    /* The restraint loops in calc_orires_dev run thread-parallel with each
+     * thread accumulating into its own partial matrix equations, which are
+     * reduced into tmpEq afterwards.
+     */
+    od->nthreads = gmx_omp_get_max_threads();
+    snew(od->tmpEqThread, od->nthreads * od->nex);
+
     od->nref = 0;
     for (int i = 0; i < mtop->natoms; i++)
     {
@@ -387,11 +396,11 @@ real calc_orires_dev(const gmx_multisim_t* ms,
                      history_t*            hist)
 {
     int           nref;
-    real          edt, edt_1, invn, pfac, r2, invr, corrfac, wsv2, sw, dev;
+    real          edt, edt_1, invn, corrfac, wsv2, sw;
     OriresMatEq*  matEq;
     real*         mref;
     double        mtot;
-    rvec *        xref, *xtmp, com, r_unrot, r;
+    rvec *        xref, *xtmp, com;
     t_oriresdata* od;
     gmx_bool      bTAV;
     const real    two_thr = 2.0 / 3.0;
@@ -462,41 +471,49 @@ real calc_orires_dev(const gmx_multisim_t* ms,
     /* Calculate the rotation matrix to rotate x to the reference orientation */
     calc_fit_R(DIM, nref, mref, xref, xtmp, od->R);
 
+    const int nthreads = od->nthreads;
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
     for (int fa = 0; fa < nfa; fa += 3)
     {
-        const int type           = forceatoms[fa];
-        const int restraintIndex = type - od->typeMin;
-        if (pbc)
-        {
-            pbc_dx_aiuc(pbc, x[forceatoms[fa + 1]], x[forceatoms[fa + 2]], r_unrot);
-        }
-        else
+        try
         {
-            rvec_sub(x[forceatoms[fa + 1]], x[forceatoms[fa + 2]], r_unrot);
-        }
-        mvmul(od->R, r_unrot, r);
-        r2   = norm2(r);
-        invr = gmx::invsqrt(r2);
-        /* Calculate the prefactor for the D tensor, this includes the factor 3! */
-        pfac = ip[type].orires.c * invr * invr * 3;
-        for (int i = 0; i < ip[type].orires.power; i++)
-        {
-            pfac *= invr;
-        }
-        rvec5& Dinsl = od->Dinsl[restraintIndex];
-        Dinsl[0]     = pfac * (2 * r[0] * r[0] + r[1] * r[1] - r2);
-        Dinsl[1]     = pfac * (2 * r[0] * r[1]);
-        Dinsl[2]     = pfac * (2 * r[0] * r[2]);
-        Dinsl[3]     = pfac * (2 * r[1] * r[1] + r[0] * r[0] - r2);
-        Dinsl[4]     = pfac * (2 * r[1] * r[2]);
-
-        if (ms)
-        {
-            for (int i = 0; i < 5; i++)
+            const int type           = forceatoms[fa];
+            const int restraintIndex = type - od->typeMin;
+            rvec      r_unrot, r;
+            if (pbc)
+            {
+                pbc_dx_aiuc(pbc, x[forceatoms[fa + 1]], x[forceatoms[fa + 2]], r_unrot);
+            }
+            else
+            {
+                rvec_sub(x[forceatoms[fa + 1]], x[forceatoms[fa + 2]], r_unrot);
+            }
+            mvmul(od->R, r_unrot, r);
+            const real r2   = norm2(r);
+            const real invr = gmx::invsqrt(r2);
+            /* Calculate the prefactor for the D tensor, this includes the factor 3! */
+            real pfac = ip[type].orires.c * invr * invr * 3;
+            for (int i = 0; i < ip[type].orires.power; i++)
+            {
+                pfac *= invr;
+            }
+            rvec5& Dinsl = od->Dinsl[restraintIndex];
+            Dinsl[0]     = pfac * (2 * r[0] * r[0] + r[1] * r[1] - r2);
+            Dinsl[1]     = pfac * (2 * r[0] * r[1]);
+            Dinsl[2]     = pfac * (2 * r[0] * r[2]);
+            Dinsl[3]     = pfac * (2 * r[1] * r[1] + r[0] * r[0] - r2);
+            Dinsl[4]     = pfac * (2 * r[1] * r[2]);
+
+            if (ms)
             {
-                od->Dins[restraintIndex][i] = Dinsl[i] * invn;
+                for (int i = 0; i < 5; i++)
+                {
+                    od->Dins[restraintIndex][i] = Dinsl[i] * invn;
+                }
             }
         }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
     }
 
     if (ms)
@@ -517,71 +534,121 @@ real calc_orires_dev(const gmx_multisim_t* ms,
         }
     }
 
-    for (int fa = 0; fa < nfa; fa += 3)
+    /* Restraints that belong to the same experiment can be assigned to
+     * different threads, so each thread accumulates into its own partial
+     * matrix equations, which are reduced into matEq below.
+     */
+#pragma omp parallel num_threads(nthreads)
     {
-        const int type           = forceatoms[fa];
-        const int restraintIndex = type - od->typeMin;
-        rvec5&    Dtav           = od->Dtav[restraintIndex];
-        if (bTAV)
+        try
         {
-            /* Here we update Dtav in t_fcdata using the data in history_t.
-             * Thus the results stay correct when this routine
-             * is called multiple times.
-             */
-            for (int i = 0; i < 5; i++)
+            OriresMatEq* matEqT = od->tmpEqThread + gmx_omp_get_thread_num() * od->nex;
+
+            for (int ex = 0; ex < od->nex; ex++)
             {
-                Dtav[i] = edt * hist->orire_Dtav[restraintIndex * 5 + i]
-                          + edt_1 * od->Dins[restraintIndex][i];
+                for (int i = 0; i < 5; i++)
+                {
+                    matEqT[ex].rhs[i] = 0;
+                    for (int j = 0; j <= i; j++)
+                    {
+                        matEqT[ex].mat[i][j] = 0;
+                    }
+                }
+            }
+
+#pragma omp for schedule(static)
+            for (int fa = 0; fa < nfa; fa += 3)
+            {
+                const int type           = forceatoms[fa];
+                const int restraintIndex = type - od->typeMin;
+                rvec5&    Dtav           = od->Dtav[restraintIndex];
+                if (bTAV)
+                {
+                    /* Here we update Dtav in t_fcdata using the data in history_t.
+                     * Thus the results stay correct when this routine
+                     * is called multiple times.
+                     */
+                    for (int i = 0; i < 5; i++)
+                    {
+                        Dtav[i] = edt * hist->orire_Dtav[restraintIndex * 5 + i]
+                                  + edt_1 * od->Dins[restraintIndex][i];
+                    }
+                }
+
+                int  ex     = ip[type].orires.ex;
+                real weight = ip[type].orires.kfac;
+                /* Calculate the vector rhs and half the matrix T for the 5 equations */
+                for (int i = 0; i < 5; i++)
+                {
+                    matEqT[ex].rhs[i] += Dtav[i] * ip[type].orires.obs * weight;
+                    for (int j = 0; j <= i; j++)
+                    {
+                        matEqT[ex].mat[i][j] += Dtav[i] * Dtav[j] * weight;
+                    }
+                }
             }
         }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+    }
 
-        int  ex     = ip[type].orires.ex;
-        real weight = ip[type].orires.kfac;
-        /* Calculate the vector rhs and half the matrix T for the 5 equations */
-        for (int i = 0; i < 5; i++)
+    for (int t = 0; t < nthreads; t++)
+    {
+        const OriresMatEq* matEqT = od->tmpEqThread + t * od->nex;
+
+        for (int ex = 0; ex < od->nex; ex++)
         {
-            matEq[ex].rhs[i] += Dtav[i] * ip[type].orires.obs * weight;
-            for (int j = 0; j <= i; j++)
+            for (int i = 0; i < 5; i++)
             {
-                matEq[ex].mat[i][j] += Dtav[i] * Dtav[j] * weight;
+                matEq[ex].rhs[i] += matEqT[ex].rhs[i];
+                for (int j = 0; j <= i; j++)
+                {
+                    matEq[ex].mat[i][j] += matEqT[ex].mat[i][j];
+                }
             }
         }
     }
-    /* Now we have all the data we can calculate S */
+    /* Now we have all the data we can calculate S. The equations for the
+     * experiments are independent, so we solve them as one batch.
+     */
+#pragma omp parallel for num_threads(nthreads) schedule(static)
     for (int ex = 0; ex < od->nex; ex++)
     {
-        OriresMatEq& eq = matEq[ex];
-        /* Correct corrfac and copy one half of T to the other half */
-        for (int i = 0; i < 5; i++)
+        try
         {
-            eq.rhs[i] *= corrfac;
-            eq.mat[i][i] *= gmx::square(corrfac);
-            for (int j = 0; j < i; j++)
+            OriresMatEq& eq = matEq[ex];
+            /* Correct corrfac and copy one half of T to the other half */
+            for (int i = 0; i < 5; i++)
             {
-                eq.mat[i][j] *= gmx::square(corrfac);
-                eq.mat[j][i] = eq.mat[i][j];
+                eq.rhs[i] *= corrfac;
+                eq.mat[i][i] *= gmx::square(corrfac);
+                for (int j = 0; j < i; j++)
+                {
+                    eq.mat[i][j] *= gmx::square(corrfac);
+                    eq.mat[j][i] = eq.mat[i][j];
+                }
             }
+            m_inv_gen(&eq.mat[0][0], 5, &eq.mat[0][0]);
+            /* Calculate the orientation tensor S for this experiment */
+            matrix& S = od->S[ex];
+            S[0][0]   = 0;
+            S[0][1]   = 0;
+            S[0][2]   = 0;
+            S[1][1]   = 0;
+            S[1][2]   = 0;
+            for (int i = 0; i < 5; i++)
+            {
+                S[0][0] += 1.5 * eq.mat[0][i] * eq.rhs[i];
+                S[0][1] += 1.5 * eq.mat[1][i] * eq.rhs[i];
+                S[0][2] += 1.5 * eq.mat[2][i] * eq.rhs[i];
+                S[1][1] += 1.5 * eq.mat[3][i] * eq.rhs[i];
+                S[1][2] += 1.5 * eq.mat[4][i] * eq.rhs[i];
+            }
+            S[1][0] = S[0][1];
+            S[2][0] = S[0][2];
+            S[2][1] = S[1][2];
+            S[2][2] = -S[0][0] - S[1][1];
         }
-        m_inv_gen(&eq.mat[0][0], 5, &eq.mat[0][0]);
-        /* Calculate the orientation tensor S for this experiment */
-        matrix& S = od->S[ex];
-        S[0][0]   = 0;
-        S[0][1]   = 0;
-        S[0][2]   = 0;
-        S[1][1]   = 0;
-        S[1][2]   = 0;
-        for (int i = 0; i < 5; i++)
-        {
-            S[0][0] += 1.5 * eq.mat[0][i] * eq.rhs[i];
-            S[0][1] += 1.5 * eq.mat[1][i] * eq.rhs[i];
-            S[0][2] += 1.5 * eq.mat[2][i] * eq.rhs[i];
-            S[1][1] += 1.5 * eq.mat[3][i] * eq.rhs[i];
-            S[1][2] += 1.5 * eq.mat[4][i] * eq.rhs[i];
-        }
-        S[1][0] = S[0][1];
-        S[2][0] = S[0][2];
-        S[2][1] = S[1][2];
-        S[2][2] = -S[0][0] - S[1][1];
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
     }
 
     const matrix* S = od->S;
@@ -589,41 +656,46 @@ real calc_orires_dev(const gmx_multisim_t* ms,
     wsv2 = 0;
     sw   = 0;
 
+#pragma omp parallel for num_threads(nthreads) schedule(static) reduction(+ : wsv2, sw)
     for (int fa = 0; fa < nfa; fa += 3)
     {
-        const int type           = forceatoms[fa];
-        const int restraintIndex = type - od->typeMin;
-        const int ex             = ip[type].orires.ex;
-
-        const rvec5& Dtav = od->Dtav[restraintIndex];
-        od->otav[restraintIndex] =
-                two_thr * corrfac
-                * (S[ex][0][0] * Dtav[0] + S[ex][0][1] * Dtav[1] + S[ex][0][2] * Dtav[2]
-                   + S[ex][1][1] * Dtav[3] + S[ex][1][2] * Dtav[4]);
-        if (bTAV)
-        {
-            const rvec5& Dins = od->Dins[restraintIndex];
-            od->oins[restraintIndex] =
-                    two_thr
-                    * (S[ex][0][0] * Dins[0] + S[ex][0][1] * Dins[1] + S[ex][0][2] * Dins[2]
-                       + S[ex][1][1] * Dins[3] + S[ex][1][2] * Dins[4]);
-        }
-        if (ms)
+        try
         {
-            /* When ensemble averaging is used recalculate the local orientation
-             * for output to the energy file.
-             */
-            const rvec5& Dinsl = od->Dinsl[restraintIndex];
-            od->oinsl[restraintIndex] =
-                    two_thr
-                    * (S[ex][0][0] * Dinsl[0] + S[ex][0][1] * Dinsl[1] + S[ex][0][2] * Dinsl[2]
-                       + S[ex][1][1] * Dinsl[3] + S[ex][1][2] * Dinsl[4]);
-        }
+            const int type           = forceatoms[fa];
+            const int restraintIndex = type - od->typeMin;
+            const int ex             = ip[type].orires.ex;
 
-        dev = od->otav[restraintIndex] - ip[type].orires.obs;
+            const rvec5& Dtav = od->Dtav[restraintIndex];
+            od->otav[restraintIndex] =
+                    two_thr * corrfac
+                    * (S[ex][0][0] * Dtav[0] + S[ex][0][1] * Dtav[1] + S[ex][0][2] * Dtav[2]
+                       + S[ex][1][1] * Dtav[3] + S[ex][1][2] * Dtav[4]);
+            if (bTAV)
+            {
+                const rvec5& Dins = od->Dins[restraintIndex];
+                od->oins[restraintIndex] =
+                        two_thr
+                        * (S[ex][0][0] * Dins[0] + S[ex][0][1] * Dins[1] + S[ex][0][2] * Dins[2]
+                           + S[ex][1][1] * Dins[3] + S[ex][1][2] * Dins[4]);
+            }
+            if (ms)
+            {
+                /* When ensemble averaging is used recalculate the local orientation
+                 * for output to the energy file.
+                 */
+                const rvec5& Dinsl = od->Dinsl[restraintIndex];
+                od->oinsl[restraintIndex] =
+                        two_thr
+                        * (S[ex][0][0] * Dinsl[0] + S[ex][0][1] * Dinsl[1] + S[ex][0][2] * Dinsl[2]
+                           + S[ex][1][1] * Dinsl[3] + S[ex][1][2] * Dinsl[4]);
+            }
 
-        wsv2 += ip[type].orires.kfac * gmx::square(dev);
-        sw += ip[type].orires.kfac;
+            const real dev = od->otav[restraintIndex] - ip[type].orires.obs;
+
+            wsv2 += ip[type].orires.kfac * gmx::square(dev);
+            sw += ip[type].orires.kfac;
+        }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
     }
     od->rmsdev = std::sqrt(wsv2 / sw);
 
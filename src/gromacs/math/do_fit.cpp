@@ -40,12 +40,18 @@
 #include "do_fit.h"
 
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
 
+#include <algorithm>
+
 #include "gromacs/linearalgebra/nrjac.h"
 #include "gromacs/math/functions.h"
 #include "gromacs/math/utilities.h"
 #include "gromacs/math/vec.h"
+#include "gromacs/math/vecbatch.h"
+#include "gromacs/simd/simd.h"
+#include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/smalloc.h"
 
@@ -259,6 +265,162 @@ void calc_fit_R(int ndim, int natoms, const real* w_rls, const rvec* xp, rvec* x
     sfree(om);
 }
 
+real calc_rmsd_qcp(int natoms, const real* w_rls, const rvec* xp, const rvec* x)
+{
+    /* Weighted inner products between the structures (S) and the
+     * self-terms entering E0; accumulated in one pass over the atoms.
+     */
+    double S[DIM][DIM] = { { 0 } };
+    double gA          = 0;
+    double gB          = 0;
+    double wTot        = 0;
+    int    i           = 0;
+
+#if GMX_SIMD_HAVE_REAL
+    {
+        alignas(GMX_SIMD_ALIGNMENT) std::int32_t offsets[GMX_SIMD_REAL_WIDTH];
+        for (int j = 0; j < GMX_SIMD_REAL_WIDTH; j++)
+        {
+            offsets[j] = j;
+        }
+
+        const real* xBase  = reinterpret_cast<const real*>(x);
+        const real* xpBase = reinterpret_cast<const real*>(xp);
+        gmx::SimdReal accS[DIM][DIM];
+        for (int d = 0; d < DIM; d++)
+        {
+            for (int m = 0; m < DIM; m++)
+            {
+                accS[d][m] = gmx::setZero();
+            }
+        }
+        gmx::SimdReal accGA = gmx::setZero();
+        gmx::SimdReal accGB = gmx::setZero();
+        gmx::SimdReal accW  = gmx::setZero();
+
+        for (; i + GMX_SIMD_REAL_WIDTH <= natoms; i += GMX_SIMD_REAL_WIDTH)
+        {
+            gmx::SimdReal w = gmx::loadU<gmx::SimdReal>(w_rls + i);
+            gmx::SimdReal xv[DIM], pv[DIM];
+
+            gmx::gatherLoadUTranspose<3>(xBase + 3 * i, offsets, &xv[XX], &xv[YY], &xv[ZZ]);
+            gmx::gatherLoadUTranspose<3>(xpBase + 3 * i, offsets, &pv[XX], &pv[YY], &pv[ZZ]);
+
+            for (int d = 0; d < DIM; d++)
+            {
+                gmx::SimdReal wp = w * pv[d];
+                for (int m = 0; m < DIM; m++)
+                {
+                    accS[d][m] = gmx::fma(wp, xv[m], accS[d][m]);
+                }
+            }
+            gmx::SimdReal xx = gmx::fma(xv[ZZ], xv[ZZ], gmx::fma(xv[YY], xv[YY], xv[XX] * xv[XX]));
+            gmx::SimdReal pp = gmx::fma(pv[ZZ], pv[ZZ], gmx::fma(pv[YY], pv[YY], pv[XX] * pv[XX]));
+            accGA            = gmx::fma(w, pp, accGA);
+            accGB            = gmx::fma(w, xx, accGB);
+            accW             = accW + w;
+        }
+
+        for (int d = 0; d < DIM; d++)
+        {
+            for (int m = 0; m < DIM; m++)
+            {
+                S[d][m] = gmx::reduce(accS[d][m]);
+            }
+        }
+        gA   = gmx::reduce(accGA);
+        gB   = gmx::reduce(accGB);
+        wTot = gmx::reduce(accW);
+    }
+#endif
+    for (; i < natoms; i++)
+    {
+        const real w = w_rls[i];
+        for (int d = 0; d < DIM; d++)
+        {
+            for (int m = 0; m < DIM; m++)
+            {
+                S[d][m] += w * xp[i][d] * x[i][m];
+            }
+        }
+        gA += w * norm2(xp[i]);
+        gB += w * norm2(x[i]);
+        wTot += w;
+    }
+
+    if (wTot <= 0)
+    {
+        gmx_fatal(FARGS, "No positive weights in QCP RMSD calculation");
+    }
+
+    const double e0 = 0.5 * (gA + gB);
+
+    /* Coefficients of the characteristic polynomial of the QCP key matrix;
+     * the notation follows Theobald, Acta Cryst. A61 (2005) 478.
+     */
+    const double sxx = S[XX][XX], sxy = S[XX][YY], sxz = S[XX][ZZ];
+    const double syx = S[YY][XX], syy = S[YY][YY], syz = S[YY][ZZ];
+    const double szx = S[ZZ][XX], szy = S[ZZ][YY], szz = S[ZZ][ZZ];
+
+    const double c2 = -2.0
+                      * (sxx * sxx + sxy * sxy + sxz * sxz + syx * syx + syy * syy + syz * syz
+                         + szx * szx + szy * szy + szz * szz);
+    const double c1 = 8.0
+                      * (sxx * syz * szy + syy * szx * sxz + szz * sxy * syx - sxx * syy * szz
+                         - syz * szx * sxy - szy * syx * sxz);
+
+    const double sxzpszx = sxz + szx;
+    const double syzpszy = syz + szy;
+    const double sxypsyx = sxy + syx;
+    const double syzmszy = syz - szy;
+    const double sxzmszx = sxz - szx;
+    const double sxymsyx = sxy - syx;
+    const double sxxpsyy = sxx + syy;
+    const double sxxmsyy = sxx - syy;
+
+    const double d1 = sxy * sxy + sxz * sxz - syx * syx - szx * szx;
+    const double d2 = syy * syy + szz * szz - sxx * sxx + syz * syz + szy * szy;
+    const double d3 = 2.0 * (syz * szy - syy * szz);
+
+    const double c0 =
+            d1 * d1 + (d2 + d3) * (d2 - d3)
+            + (-(sxzpszx) * (syzmszy) + (sxymsyx) * (sxxmsyy - szz))
+                      * (-(sxzmszx) * (syzpszy) + (sxymsyx) * (sxxmsyy + szz))
+            + (-(sxzpszx) * (syzpszy) - (sxypsyx) * (sxxpsyy - szz))
+                      * (-(sxzmszx) * (syzmszy) - (sxypsyx) * (sxxpsyy + szz))
+            + ((sxypsyx) * (syzpszy) + (sxzpszx) * (sxxmsyy + szz))
+                      * (-(sxymsyx) * (syzmszy) + (sxzpszx) * (sxxpsyy + szz))
+            + ((sxypsyx) * (syzmszy) + (sxzmszx) * (sxxmsyy - szz))
+                      * (-(sxymsyx) * (syzpszy) + (sxzmszx) * (sxxpsyy - szz));
+
+    /* Newton iteration for the largest eigenvalue, starting from the upper
+     * bound E0; converges in a handful of iterations for any sane input.
+     */
+    double lambda = e0;
+    for (int iter = 0; iter < 50; iter++)
+    {
+        const double lambdaOld = lambda;
+        const double l2        = lambda * lambda;
+        const double b         = (l2 + c2) * lambda;
+        const double a         = b + c1;
+        const double der       = 2.0 * l2 * lambda + b + a;
+        if (der == 0)
+        {
+            break;
+        }
+        lambda -= (a * lambda + c0) / der;
+        if (std::abs(lambda - lambdaOld) < std::abs(1e-11 * lambda))
+        {
+            break;
+        }
+    }
+
+    /* Numerical noise can make the argument marginally negative for identical
+     * structures, so clamp it at zero.
+     */
+    return std::sqrt(std::max(0.0, 2.0 * (e0 - lambda) / wTot));
+}
+
 void do_fit_ndim(int ndim, int natoms, real* w_rls, const rvec* xp, rvec* x)
 {
     int    j, m, r, c;
@@ -268,6 +430,13 @@ void do_fit_ndim(int ndim, int natoms, real* w_rls, const rvec* xp, rvec* x)
     /* Calculate the rotation matrix R */
     calc_fit_R(ndim, natoms, w_rls, xp, x, R);
 
+    if (ndim == DIM)
+    {
+        /* The batched routine processes GMX_SIMD_REAL_WIDTH vectors at a time */
+        gmx::rotateVectorArray(R, gmx::arrayRefFromArray(reinterpret_cast<gmx::RVec*>(x), natoms));
+        return;
+    }
+
     /*rotate X*/
     for (j = 0; j < natoms; j++)
     {
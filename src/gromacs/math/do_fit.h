@@ -57,6 +57,26 @@ real rhodev_ind(int nind, int index[], real mass[], rvec x[], rvec xp[]);
  */
 
 real rhodev(int natoms, real mass[], rvec x[], rvec xp[]);
+
+/*! \brief Calculate the minimal weighted RMSD between x and xp over all rotations.
+ *
+ * Uses the Theobald QCP method: the weighted covariance between the two
+ * structures is accumulated in one (SIMD-accelerated) pass and the largest
+ * eigenvalue of the key matrix is found analytically from its characteristic
+ * polynomial, which avoids building and rotating with the full Kabsch fit
+ * matrix when only the RMSD value is needed, e.g. when comparing many frame
+ * pairs in clustering.
+ *
+ * Both structures must have been centered on their weighted centroid
+ * (see reset_x), like for do_fit().
+ *
+ * \param[in] natoms Number of atoms
+ * \param[in] w_rls  Weights for each atom
+ * \param[in] xp     Reference structure
+ * \param[in] x      Structure to compare
+ * \returns the weighted RMSD after an optimal rotational fit.
+ */
+real calc_rmsd_qcp(int natoms, const real* w_rls, const rvec* xp, const rvec* x);
 /* Returns size-independent Rho similarity parameter over all atoms
  * Maiorov & Crippen, PROTEINS 22, 273 (1995).
  */
@@ -94,6 +94,31 @@ TEST_F(StructureSimilarityTest, YieldsCorrectRMSDWithIndex)
                        defaultRealTolerance());
 }
 
+TEST_F(StructureSimilarityTest, QcpRmsdIsZeroForSelf)
+{
+    EXPECT_REAL_EQ_TOL(0., calc_rmsd_qcp(c_nAtoms, m_, x1_, x1_), defaultRealTolerance());
+}
+
+TEST_F(StructureSimilarityTest, QcpRmsdMatchesFitPlusRmsd)
+{
+    // Center both structures, fit B onto A with the Kabsch code, and check
+    // that the QCP result matches the explicitly fitted RMSD.
+    std::array<RVec, c_nAtoms> structureA = structureA_;
+    std::array<RVec, c_nAtoms> structureB = structureB_;
+    rvec*                      xa         = gmx::as_rvec_array(structureA.data());
+    rvec*                      xb         = gmx::as_rvec_array(structureB.data());
+
+    reset_x(c_nAtoms, nullptr, c_nAtoms, nullptr, xa, m_);
+    reset_x(c_nAtoms, nullptr, c_nAtoms, nullptr, xb, m_);
+
+    const real rmsdQcp = calc_rmsd_qcp(c_nAtoms, m_, xa, xb);
+
+    do_fit(c_nAtoms, m_, xa, xb);
+    const real rmsdFit = rmsdev(c_nAtoms, m_, xa, xb);
+
+    EXPECT_REAL_EQ_TOL(rmsdFit, rmsdQcp, gmx::test::relativeToleranceAsFloatingPoint(1.0, 1e-5));
+}
+
 TEST_F(StructureSimilarityTest, YieldsCorrectRhoWidthIndex)
 {
     EXPECT_REAL_EQ_TOL(2., rhodev_ind(index_.size(), index_.data(), m_, x1_, x2_), defaultRealTolerance());
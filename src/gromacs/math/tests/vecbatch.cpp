@@ -0,0 +1,135 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for batched SIMD vector operations.
+ *
+ * \author Erik Lindahl <erik.lindahl@gmail.com>
+ * \ingroup module_math
+ */
+#include "gmxpre.h"
+
+#include "gromacs/math/vecbatch.h"
+
+#include <cmath>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/math/vec.h"
+
+#include "testutils/testasserts.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! Generate a deterministic array of test vectors of odd size
+std::vector<RVec> makeTestVectors(int n, real scale)
+{
+    std::vector<RVec> result(n);
+    for (int i = 0; i < n; i++)
+    {
+        result[i] = { scale * std::cos(1.0_real * i), scale * std::sin(0.5_real * i),
+                      scale * (i % 7 - 3) };
+    }
+    return result;
+}
+
+TEST(VecBatchTest, RotateVectorArrayMatchesScalar)
+{
+    // Odd count so both the SIMD loop and the scalar remainder are used
+    const int         n = 37;
+    std::vector<RVec> x = makeTestVectors(n, 2.5_real);
+    std::vector<RVec> xRef(x);
+
+    const matrix R = { { 0.36_real, 0.48_real, -0.8_real },
+                       { -0.8_real, 0.6_real, 0.0_real },
+                       { 0.48_real, 0.64_real, 0.6_real } };
+
+    rotateVectorArray(R, x);
+
+    FloatingPointTolerance tolerance(defaultRealTolerance());
+    for (int i = 0; i < n; i++)
+    {
+        rvec ref;
+        mvmul(R, xRef[i], ref);
+        for (int d = 0; d < DIM; d++)
+        {
+            EXPECT_REAL_EQ_TOL(ref[d], x[i][d], tolerance);
+        }
+    }
+}
+
+TEST(VecBatchTest, AccumulateOuterProductMatchesScalar)
+{
+    const int         n = 29;
+    std::vector<RVec> x = makeTestVectors(n, 1.5_real);
+    std::vector<RVec> f = makeTestVectors(n, -3.0_real);
+
+    matrix sum    = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+    matrix sumRef = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+
+    accumulateOuterProduct(x, f, sum);
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            for (int m = 0; m < DIM; m++)
+            {
+                sumRef[d][m] += x[i][d] * f[i][m];
+            }
+        }
+    }
+
+    // Allow a slightly larger tolerance since the summation order differs
+    FloatingPointTolerance tolerance = relativeToleranceAsFloatingPoint(1.0, 1e-5);
+    for (int d = 0; d < DIM; d++)
+    {
+        for (int m = 0; m < DIM; m++)
+        {
+            EXPECT_REAL_EQ_TOL(sumRef[d][m], sum[d][m], tolerance);
+        }
+    }
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
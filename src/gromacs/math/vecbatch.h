@@ -0,0 +1,177 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares batched SIMD operations on arrays of 3D vectors.
+ *
+ * These helpers process GMX_SIMD_REAL_WIDTH vectors per iteration with the
+ * SIMD lanes running across vectors rather than across components, so
+ * per-atom 3x3 matrix operations in fitting and analysis paths are not
+ * limited by scalar arithmetic. Without SIMD support they reduce to the
+ * plain scalar loops.
+ *
+ * \author Erik Lindahl <erik.lindahl@gmail.com>
+ * \inlibraryapi
+ * \ingroup module_math
+ */
+#ifndef GMX_MATH_VECBATCH_H
+#define GMX_MATH_VECBATCH_H
+
+#include <cstdint>
+
+#include "gromacs/math/vectypes.h"
+#include "gromacs/simd/simd.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/basedefinitions.h"
+#include "gromacs/utility/gmxassert.h"
+
+namespace gmx
+{
+
+/*! \brief Apply a rotation (or any 3x3) matrix to an array of vectors in place.
+ *
+ * Computes x[i] = R . x[i] for all vectors in x.
+ *
+ * \param[in]     R  Matrix to apply
+ * \param[in,out] x  Vectors to transform in place
+ */
+static inline void rotateVectorArray(const matrix R, ArrayRef<RVec> x)
+{
+    index i = 0;
+#if GMX_SIMD_HAVE_REAL
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t offsets[GMX_SIMD_REAL_WIDTH];
+    for (int j = 0; j < GMX_SIMD_REAL_WIDTH; j++)
+    {
+        offsets[j] = j;
+    }
+
+    real* xBase = reinterpret_cast<real*>(x.data());
+    for (; i + GMX_SIMD_REAL_WIDTH <= x.ssize(); i += GMX_SIMD_REAL_WIDTH)
+    {
+        SimdReal x0, x1, x2;
+
+        gatherLoadUTranspose<3>(xBase + 3 * i, offsets, &x0, &x1, &x2);
+
+        SimdReal y0 = fma(SimdReal(R[XX][ZZ]), x2,
+                          fma(SimdReal(R[XX][YY]), x1, SimdReal(R[XX][XX]) * x0));
+        SimdReal y1 = fma(SimdReal(R[YY][ZZ]), x2,
+                          fma(SimdReal(R[YY][YY]), x1, SimdReal(R[YY][XX]) * x0));
+        SimdReal y2 = fma(SimdReal(R[ZZ][ZZ]), x2,
+                          fma(SimdReal(R[ZZ][YY]), x1, SimdReal(R[ZZ][XX]) * x0));
+
+        transposeScatterStoreU<3>(xBase + 3 * i, offsets, y0, y1, y2);
+    }
+#endif
+    for (; i < x.ssize(); i++)
+    {
+        const RVec xOld = x[i];
+        for (int r = 0; r < DIM; r++)
+        {
+            x[i][r] = R[r][XX] * xOld[XX] + R[r][YY] * xOld[YY] + R[r][ZZ] * xOld[ZZ];
+        }
+    }
+}
+
+/*! \brief Accumulate the sum of outer products of two vector arrays.
+ *
+ * Computes sum[d][n] += \f$\sum_i\f$ x[i][d]*f[i][n], which is the
+ * quantity entering the virial.
+ *
+ * \param[in]     x    First vector array
+ * \param[in]     f    Second vector array; must have the same size as x
+ * \param[in,out] sum  Matrix the outer products are added to
+ */
+static inline void accumulateOuterProduct(ArrayRef<const RVec> x, ArrayRef<const RVec> f, matrix sum)
+{
+    GMX_ASSERT(x.size() == f.size(), "Vector arrays must have matching sizes");
+
+    index i = 0;
+#if GMX_SIMD_HAVE_REAL
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t offsets[GMX_SIMD_REAL_WIDTH];
+    for (int j = 0; j < GMX_SIMD_REAL_WIDTH; j++)
+    {
+        offsets[j] = j;
+    }
+
+    const real* xBase = reinterpret_cast<const real*>(x.data());
+    const real* fBase = reinterpret_cast<const real*>(f.data());
+    SimdReal    acc[DIM][DIM];
+    for (int d = 0; d < DIM; d++)
+    {
+        for (int n = 0; n < DIM; n++)
+        {
+            acc[d][n] = setZero();
+        }
+    }
+
+    for (; i + GMX_SIMD_REAL_WIDTH <= x.ssize(); i += GMX_SIMD_REAL_WIDTH)
+    {
+        SimdReal xv[DIM], fv[DIM];
+
+        gatherLoadUTranspose<3>(xBase + 3 * i, offsets, &xv[XX], &xv[YY], &xv[ZZ]);
+        gatherLoadUTranspose<3>(fBase + 3 * i, offsets, &fv[XX], &fv[YY], &fv[ZZ]);
+
+        for (int d = 0; d < DIM; d++)
+        {
+            for (int n = 0; n < DIM; n++)
+            {
+                acc[d][n] = fma(xv[d], fv[n], acc[d][n]);
+            }
+        }
+    }
+
+    for (int d = 0; d < DIM; d++)
+    {
+        for (int n = 0; n < DIM; n++)
+        {
+            sum[d][n] += reduce(acc[d][n]);
+        }
+    }
+#endif
+    for (; i < x.ssize(); i++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            for (int n = 0; n < DIM; n++)
+            {
+                sum[d][n] += x[i][d] * f[i][n];
+            }
+        }
+    }
+}
+
+} // namespace gmx
+
+#endif
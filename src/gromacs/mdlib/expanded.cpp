@@ -65,6 +65,8 @@
 #include "gromacs/mdtypes/state.h"
 #include "gromacs/random/threefry.h"
 #include "gromacs/random/uniformrealdistribution.h"
+#include "gromacs/simd/simd.h"
+#include "gromacs/simd/simd_math.h"
 #include "gromacs/timing/wallcycle.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/gmxmpi.h"
@@ -91,13 +93,47 @@ void init_expanded_ensemble(gmx_bool bStateFromCP, const t_inputrec* ir, df_hist
     }
 }
 
+/*! \brief Stores exp(ene[i] - maxene) in p_k for i in [minfep, maxfep] and returns the sum
+ *
+ * Uses SIMD batches for the exponentials when available, with a scalar
+ * loop for the remaining entries. \p maxene has to be the maximum of the
+ * energies in the range, so the arguments are non-positive and the
+ * exponentials can not overflow.
+ */
+static double exponentiateAndSum(const real* ene, int minfep, int maxfep, real maxene, double* p_k)
+{
+    double sum = 0;
+    int    i   = minfep;
+
+#if GMX_SIMD_HAVE_REAL && GMX_SIMD_HAVE_LOADU
+    alignas(GMX_SIMD_ALIGNMENT) real buf[GMX_SIMD_REAL_WIDTH];
+    const gmx::SimdReal              maxEneSimd(maxene);
+
+    for (; i + GMX_SIMD_REAL_WIDTH - 1 <= maxfep; i += GMX_SIMD_REAL_WIDTH)
+    {
+        gmx::store(buf, gmx::exp(gmx::simdLoadU(ene + i) - maxEneSimd));
+        for (int j = 0; j < GMX_SIMD_REAL_WIDTH; j++)
+        {
+            p_k[i + j] = buf[j];
+            sum += buf[j];
+        }
+    }
+#endif
+    for (; i <= maxfep; i++)
+    {
+        p_k[i] = std::exp(ene[i] - maxene);
+        sum += p_k[i];
+    }
+
+    return sum;
+}
+
 static void GenerateGibbsProbabilities(const real* ene, double* p_k, double* pks, int minfep, int maxfep)
 {
 
     int  i;
     real maxene;
 
-    *pks   = 0.0;
     maxene = ene[minfep];
     /* find the maximum value */
     for (i = minfep; i <= maxfep; i++)
@@ -107,15 +143,12 @@ static void GenerateGibbsProbabilities(const real* ene, double* p_k, double* pks
             maxene = ene[i];
         }
     }
-    /* find the denominator */
-    for (i = minfep; i <= maxfep; i++)
-    {
-        *pks += std::exp(ene[i] - maxene);
-    }
-    /*numerators*/
+    /* compute the numerators and their sum, the denominator */
+    *pks = exponentiateAndSum(ene, minfep, maxfep, maxene, p_k);
+    /* normalize */
     for (i = minfep; i <= maxfep; i++)
     {
-        p_k[i] = std::exp(ene[i] - maxene) / *pks;
+        p_k[i] /= *pks;
     }
 }
 
@@ -153,22 +186,12 @@ GenerateWeightedGibbsProbabilities(const real* ene, double* p_k, double* pks, in
         }
     }
 
-    /* subtract off the maximum, avoiding overflow */
-    for (i = 0; i < nlim; i++)
-    {
-        nene[i] -= maxene;
-    }
-
-    /* find the denominator */
-    for (i = 0; i < nlim; i++)
-    {
-        *pks += std::exp(nene[i]);
-    }
-
-    /*numerators*/
+    /* compute the numerators and their sum, the denominator */
+    *pks = exponentiateAndSum(nene, 0, nlim - 1, maxene, p_k);
+    /* normalize */
     for (i = 0; i < nlim; i++)
     {
-        p_k[i] = std::exp(nene[i]) / *pks;
+        p_k[i] /= *pks;
     }
     sfree(nene);
 }
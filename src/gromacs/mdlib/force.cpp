@@ -41,6 +41,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 
 #include "gromacs/domdec/dlbtiming.h"
@@ -75,6 +76,25 @@
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/smalloc.h"
 
+/*! \brief Returns the period with which the reciprocal-space PME forces are recomputed
+ *
+ * Returns 1, i.e. computation on every step, unless multiple time stepping
+ * for PME is requested by setting the env.var. GMX_PME_MTS to the period.
+ * On the steps in between, the reciprocal forces of the last computed step
+ * are reused; energy, virial and neighbor-search steps always recompute.
+ * Note that this is only valid for systems with small forces on the PME
+ * time scale, as is usual, and is not supported with free-energy runs.
+ */
+static int pmeMtsPeriod(const t_inputrec& ir)
+{
+    static const int period = [] {
+        const char* env = getenv("GMX_PME_MTS");
+        return (env != nullptr && atoi(env) > 1) ? atoi(env) : 1;
+    }();
+
+    return (ir.efep == efepNO) ? period : 1;
+}
+
 static void clearEwaldThreadOutput(ewald_corr_thread_t* ewc_t)
 {
     ewc_t->Vcorr_q        = 0;
@@ -266,53 +286,98 @@ void do_force_lowlevel(t_forcerec*                         fr,
                 assert(fr->n_tpi >= 0);
                 if (fr->n_tpi == 0 || stepWork.stateChanged)
                 {
-                    int pme_flags = GMX_PME_SPREAD | GMX_PME_SOLVE;
-
-                    if (stepWork.computeForces)
-                    {
-                        pme_flags |= GMX_PME_CALC_F;
-                    }
-                    if (stepWork.computeVirial)
+                    /* With multiple time stepping for PME we reuse the cached
+                     * reciprocal forces on the in-between steps. The cache is
+                     * indexed by home atom, so it has to be refreshed whenever
+                     * the local atom set can have changed, as well as on
+                     * energy/virial steps, which need fresh PME output.
+                     */
+                    const int  mtsPeriod   = pmeMtsPeriod(*ir);
+                    const bool useMtsCache = (mtsPeriod > 1 && stepWork.computeForces && fr->n_tpi == 0);
+                    const bool reusePmeForces =
+                            (useMtsCache && !stepWork.doNeighborSearch && !stepWork.computeVirial
+                             && !stepWork.computeEnergy && fr->pmeMtsStepsSinceCompute > 0
+                             && fr->pmeMtsStepsSinceCompute < mtsPeriod
+                             && fr->pmeMtsForceCache.size() == static_cast<size_t>(md->homenr));
+
+                    if (reusePmeForces)
                     {
-                        pme_flags |= GMX_PME_CALC_ENER_VIR;
+                        gmx::ArrayRef<gmx::RVec> f = forceWithVirial.force_;
+                        for (int i = 0; i < md->homenr; i++)
+                        {
+                            f[i] += fr->pmeMtsForceCache[i];
+                        }
+                        fr->pmeMtsStepsSinceCompute++;
                     }
-                    if (fr->n_tpi > 0)
+                    else
                     {
-                        /* We don't calculate f, but we do want the potential */
-                        pme_flags |= GMX_PME_CALC_POT;
-                    }
+                        int pme_flags = GMX_PME_SPREAD | GMX_PME_SOLVE;
 
-                    /* With domain decomposition we close the CPU side load
-                     * balancing region here, because PME does global
-                     * communication that acts as a global barrier.
-                     */
-                    ddBalanceRegionHandler.closeAfterForceComputationCpu();
+                        if (stepWork.computeForces)
+                        {
+                            pme_flags |= GMX_PME_CALC_F;
+                        }
+                        if (stepWork.computeVirial)
+                        {
+                            pme_flags |= GMX_PME_CALC_ENER_VIR;
+                        }
+                        if (fr->n_tpi > 0)
+                        {
+                            /* We don't calculate f, but we do want the potential */
+                            pme_flags |= GMX_PME_CALC_POT;
+                        }
 
-                    wallcycle_start(wcycle, ewcPMEMESH);
-                    status = gmx_pme_do(
-                            fr->pmedata,
-                            gmx::constArrayRefFromArray(coordinates.unpaddedConstArrayRef().data(),
-                                                        md->homenr - fr->n_tpi),
-                            forceWithVirial.force_, md->chargeA, md->chargeB, md->sqrt_c6A,
-                            md->sqrt_c6B, md->sigmaA, md->sigmaB, box, cr,
-                            DOMAINDECOMP(cr) ? dd_pme_maxshift_x(cr->dd) : 0,
-                            DOMAINDECOMP(cr) ? dd_pme_maxshift_y(cr->dd) : 0, nrnb, wcycle,
-                            ewaldOutput.vir_q, ewaldOutput.vir_lj, &Vlr_q, &Vlr_lj,
-                            lambda[efptCOUL], lambda[efptVDW], &ewaldOutput.dvdl[efptCOUL],
-                            &ewaldOutput.dvdl[efptVDW], pme_flags);
-                    wallcycle_stop(wcycle, ewcPMEMESH);
-                    if (status != 0)
-                    {
-                        gmx_fatal(FARGS, "Error %d in reciprocal PME routine", status);
-                    }
+                        /* With domain decomposition we close the CPU side load
+                         * balancing region here, because PME does global
+                         * communication that acts as a global barrier.
+                         */
+                        ddBalanceRegionHandler.closeAfterForceComputationCpu();
 
-                    /* We should try to do as little computation after
-                     * this as possible, because parallel PME synchronizes
-                     * the nodes, so we want all load imbalance of the
-                     * rest of the force calculation to be before the PME
-                     * call.  DD load balancing is done on the whole time
-                     * of the force call (without PME).
-                     */
+                        if (useMtsCache)
+                        {
+                            /* Snapshot the force buffer, so the PME contribution
+                             * can be extracted by difference below.
+                             */
+                            fr->pmeMtsForceCache.assign(forceWithVirial.force_.begin(),
+                                                        forceWithVirial.force_.begin() + md->homenr);
+                        }
+
+                        wallcycle_start(wcycle, ewcPMEMESH);
+                        status = gmx_pme_do(
+                                fr->pmedata,
+                                gmx::constArrayRefFromArray(coordinates.unpaddedConstArrayRef().data(),
+                                                            md->homenr - fr->n_tpi),
+                                forceWithVirial.force_, md->chargeA, md->chargeB, md->sqrt_c6A,
+                                md->sqrt_c6B, md->sigmaA, md->sigmaB, box, cr,
+                                DOMAINDECOMP(cr) ? dd_pme_maxshift_x(cr->dd) : 0,
+                                DOMAINDECOMP(cr) ? dd_pme_maxshift_y(cr->dd) : 0, nrnb, wcycle,
+                                ewaldOutput.vir_q, ewaldOutput.vir_lj, &Vlr_q, &Vlr_lj,
+                                lambda[efptCOUL], lambda[efptVDW], &ewaldOutput.dvdl[efptCOUL],
+                                &ewaldOutput.dvdl[efptVDW], pme_flags);
+                        wallcycle_stop(wcycle, ewcPMEMESH);
+                        if (status != 0)
+                        {
+                            gmx_fatal(FARGS, "Error %d in reciprocal PME routine", status);
+                        }
+
+                        if (useMtsCache)
+                        {
+                            gmx::ArrayRef<const gmx::RVec> f = forceWithVirial.force_;
+                            for (int i = 0; i < md->homenr; i++)
+                            {
+                                fr->pmeMtsForceCache[i] = f[i] - fr->pmeMtsForceCache[i];
+                            }
+                            fr->pmeMtsStepsSinceCompute = 1;
+                        }
+
+                        /* We should try to do as little computation after
+                         * this as possible, because parallel PME synchronizes
+                         * the nodes, so we want all load imbalance of the
+                         * rest of the force calculation to be before the PME
+                         * call.  DD load balancing is done on the whole time
+                         * of the force call (without PME).
+                         */
+                    }
                 }
                 if (fr->n_tpi > 0)
                 {
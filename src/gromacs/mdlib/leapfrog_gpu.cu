@@ -122,6 +122,8 @@ enum class VelocityScalingType
  * \param[in]     gm_tempScaleGroups               Mapping of atoms into groups.
  * \param[in]     dtPressureCouple                 Time step for pressure coupling
  * \param[in]     prVelocityScalingMatrixDiagonal  Diagonal elements of Parrinello-Rahman velocity scaling matrix
+ * \param[in]     prVelocityScalingMatrixOffDiagonal  Lower off-diagonal elements (YX, ZX, ZY) of the
+ *                                                    Parrinello-Rahman velocity scaling matrix
  */
 template<NumTempScaleValues numTempScaleValues, VelocityScalingType velocityScaling>
 __launch_bounds__(c_maxThreadsPerBlock) __global__
@@ -134,7 +136,8 @@ __launch_bounds__(c_maxThreadsPerBlock) __global__
                              const float dt,
                              const float* __restrict__ gm_lambdas,
                              const unsigned short* __restrict__ gm_tempScaleGroups,
-                             const float3 prVelocityScalingMatrixDiagonal);
+                             const float3 prVelocityScalingMatrixDiagonal,
+                             const float3 prVelocityScalingMatrixOffDiagonal);
 
 template<NumTempScaleValues numTempScaleValues, VelocityScalingType velocityScaling>
 __launch_bounds__(c_maxThreadsPerBlock) __global__
@@ -147,7 +150,8 @@ __launch_bounds__(c_maxThreadsPerBlock) __global__
                              const float dt,
                              const float* __restrict__ gm_lambdas,
                              const unsigned short* __restrict__ gm_tempScaleGroups,
-                             const float3 prVelocityScalingMatrixDiagonal)
+                             const float3 prVelocityScalingMatrixDiagonal,
+                             const float3 prVelocityScalingMatrixOffDiagonal)
 {
     int threadIndex = blockIdx.x * blockDim.x + threadIdx.x;
     if (threadIndex < numAtoms)
@@ -189,6 +193,17 @@ __launch_bounds__(c_maxThreadsPerBlock) __global__
                 vp.z -= prVelocityScalingMatrixDiagonal.z * v.z;
             }
 
+            if (velocityScaling == VelocityScalingType::Full)
+            {
+                /* The scaling matrix is lower triangular, like the box */
+                vp.x -= prVelocityScalingMatrixDiagonal.x * v.x;
+                vp.y -= prVelocityScalingMatrixOffDiagonal.x * v.x
+                        + prVelocityScalingMatrixDiagonal.y * v.y;
+                vp.z -= prVelocityScalingMatrixOffDiagonal.y * v.x
+                        + prVelocityScalingMatrixOffDiagonal.z * v.y
+                        + prVelocityScalingMatrixDiagonal.z * v.z;
+            }
+
             v = vp;
         }
 
@@ -252,10 +267,24 @@ inline auto selectLeapFrogKernelPtr(bool                doTemperatureScaling,
             kernelPtr = leapfrog_kernel<NumTempScaleValues::Multiple, VelocityScalingType::Diagonal>;
         }
     }
+    else if (prVelocityScalingType == VelocityScalingType::Full)
+    {
+        if (!doTemperatureScaling)
+        {
+            kernelPtr = leapfrog_kernel<NumTempScaleValues::None, VelocityScalingType::Full>;
+        }
+        else if (numTempScaleValues == 1)
+        {
+            kernelPtr = leapfrog_kernel<NumTempScaleValues::Single, VelocityScalingType::Full>;
+        }
+        else if (numTempScaleValues > 1)
+        {
+            kernelPtr = leapfrog_kernel<NumTempScaleValues::Multiple, VelocityScalingType::Full>;
+        }
+    }
     else
     {
-        GMX_RELEASE_ASSERT(false,
-                           "Only isotropic Parrinello-Rahman pressure coupling is supported.");
+        GMX_RELEASE_ASSERT(false, "Unknown Parrinello-Rahman velocity scaling type.");
     }
     return kernelPtr;
 }
@@ -292,25 +321,31 @@ void LeapFrogGpu::integrate(const float3*                     d_x,
         VelocityScalingType prVelocityScalingType = VelocityScalingType::None;
         if (doParrinelloRahman)
         {
-            prVelocityScalingType = VelocityScalingType::Diagonal;
-            GMX_ASSERT(prVelocityScalingMatrix[YY][XX] == 0 && prVelocityScalingMatrix[ZZ][XX] == 0
-                               && prVelocityScalingMatrix[ZZ][YY] == 0
-                               && prVelocityScalingMatrix[XX][YY] == 0
-                               && prVelocityScalingMatrix[XX][ZZ] == 0
+            /* The box, and hence the scaling matrix, is lower triangular */
+            GMX_ASSERT(prVelocityScalingMatrix[XX][YY] == 0 && prVelocityScalingMatrix[XX][ZZ] == 0
                                && prVelocityScalingMatrix[YY][ZZ] == 0,
-                       "Fully anisotropic Parrinello-Rahman pressure coupling is not yet supported "
-                       "in GPU version of Leap-Frog integrator.");
+                       "The Parrinello-Rahman velocity scaling matrix for the GPU version of the "
+                       "Leap-Frog integrator has to be lower triangular.");
+            const bool isDiagonal = (prVelocityScalingMatrix[YY][XX] == 0
+                                     && prVelocityScalingMatrix[ZZ][XX] == 0
+                                     && prVelocityScalingMatrix[ZZ][YY] == 0);
+            prVelocityScalingType = isDiagonal ? VelocityScalingType::Diagonal : VelocityScalingType::Full;
             prVelocityScalingMatrixDiagonal_ =
                     make_float3(dtPressureCouple * prVelocityScalingMatrix[XX][XX],
                                 dtPressureCouple * prVelocityScalingMatrix[YY][YY],
                                 dtPressureCouple * prVelocityScalingMatrix[ZZ][ZZ]);
+            prVelocityScalingMatrixOffDiagonal_ =
+                    make_float3(dtPressureCouple * prVelocityScalingMatrix[YY][XX],
+                                dtPressureCouple * prVelocityScalingMatrix[ZZ][XX],
+                                dtPressureCouple * prVelocityScalingMatrix[ZZ][YY]);
         }
         kernelPtr = selectLeapFrogKernelPtr(doTemperatureScaling, numTempScaleValues_, prVelocityScalingType);
     }
 
     const auto kernelArgs = prepareGpuKernelArguments(
             kernelPtr, kernelLaunchConfig_, &numAtoms_, &d_x, &d_xp, &d_v, &d_f, &d_inverseMasses_,
-            &dt, &d_lambdas_, &d_tempScaleGroups_, &prVelocityScalingMatrixDiagonal_);
+            &dt, &d_lambdas_, &d_tempScaleGroups_, &prVelocityScalingMatrixDiagonal_,
+            &prVelocityScalingMatrixOffDiagonal_);
     launchGpuKernel(kernelPtr, kernelLaunchConfig_, nullptr, "leapfrog_kernel", kernelArgs);
 
     return;
@@ -56,6 +56,13 @@
 namespace gmx
 {
 
+/*! \brief Implements Leap-Frog integration on the GPU.
+ *
+ * \todo Add a stochastic dynamics flavor, so that SD runs can also use the
+ *       GPU-resident update path. This requires a counter-based random
+ *       number generator and a normal distribution on the device with
+ *       streams matching those of the CPU implementation in update.cpp.
+ */
 class LeapFrogGpu
 {
 
@@ -148,6 +155,12 @@ private:
 
     //! Vector with diagonal elements of the Parrinello-Rahman pressure coupling velocity rescale factors
     float3 prVelocityScalingMatrixDiagonal_;
+    /*! \brief Vector with the lower off-diagonal elements (YX, ZX, ZY) of the Parrinello-Rahman
+     * pressure coupling velocity rescale factors.
+     *
+     * Only used with anisotropic coupling or a triclinic box; the upper triangle is always zero.
+     */
+    float3 prVelocityScalingMatrixOffDiagonal_;
 };
 
 } // namespace gmx
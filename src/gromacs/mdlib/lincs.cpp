@@ -208,6 +208,11 @@ public:
     std::vector<real, AlignedAllocator<real>> tmp3;
     std::vector<real, AlignedAllocator<real>> tmp4;
     /*! @} */
+    //! Extra rhs arrays used only for the extra recursions for triangle constraints.
+    /*! @{ */
+    std::vector<real, AlignedAllocator<real>> tmpTri1;
+    std::vector<real, AlignedAllocator<real>> tmpTri2;
+    /*! @} */
     //! The Lagrange multipliers times -1.
     std::vector<real, AlignedAllocator<real>> mlambda;
     //! Storage for the constraint RMS relative deviation output.
@@ -248,6 +253,8 @@ static void lincs_matrix_expand(const Lincs&              lincsd,
                                 gmx::ArrayRef<const real> blcc,
                                 gmx::ArrayRef<real>       rhs1,
                                 gmx::ArrayRef<real>       rhs2,
+                                gmx::ArrayRef<real>       rhsTri1,
+                                gmx::ArrayRef<real>       rhsTri2,
                                 gmx::ArrayRef<real>       sol)
 {
     gmx::ArrayRef<const int> blnr  = lincsd.blnr;
@@ -290,23 +297,36 @@ static void lincs_matrix_expand(const Lincs&              lincsd,
          * is around 0.4 (and 0.7*0.7=0.5).
          */
 
-        if (lincsd.bTaskDep)
+        gmx::ArrayRef<const int> triangle = li_task.triangle;
+        gmx::ArrayRef<const int> tri_bits = li_task.tri_bits;
+
+        if (lincsd.bTaskDep && !lincsd.bTaskDepTri)
         {
-            /* We need a barrier here, since other threads might still be
-             * reading the contents of rhs1 and/o rhs2.
-             * We could avoid this barrier by introducing two extra rhs
-             * arrays for the triangle constraints only.
+            /* All triangles are fully contained in our task. We copy the
+             * entries we need to rhs arrays dedicated to the triangle
+             * constraints, so we can start the extra recursions without
+             * waiting with a barrier for tasks that might still be reading
+             * rhs1 and/or rhs2 in the loop above; other tasks never access
+             * the entries for our triangle constraints.
+             */
+            for (int tb = 0; tb < li_task.ntriangle; tb++)
+            {
+                const int b = triangle[tb];
+                rhsTri1[b]  = rhs1[b];
+            }
+            rhs1 = rhsTri1;
+            rhs2 = rhsTri2;
+        }
+        else if (lincsd.bTaskDep)
+        {
+            /* Triangles cross task borders, so the recursions below access
+             * rhs entries of other tasks and we need to keep using the
+             * shared rhs arrays. We need a barrier here, since other threads
+             * might still be reading the contents of rhs1 and/or rhs2.
              */
 #pragma omp barrier
         }
 
-        /* Constraints involved in a triangle are ensured to be in the same
-         * LINCS task. This means no barriers are required during the extra
-         * iterations for the triangle constraints.
-         */
-        gmx::ArrayRef<const int> triangle = li_task.triangle;
-        gmx::ArrayRef<const int> tri_bits = li_task.tri_bits;
-
         for (int rec = 0; rec < nrec; rec++)
         {
             for (int tb = 0; tb < li_task.ntriangle; tb++)
@@ -603,10 +623,12 @@ static void do_lincsp(ArrayRefWithPadding<const RVec> xPadded,
         blc  = lincsd->blc1;
         blmf = lincsd->blmf1;
     }
-    gmx::ArrayRef<real> blcc = lincsd->tmpncc;
-    gmx::ArrayRef<real> rhs1 = lincsd->tmp1;
-    gmx::ArrayRef<real> rhs2 = lincsd->tmp2;
-    gmx::ArrayRef<real> sol  = lincsd->tmp3;
+    gmx::ArrayRef<real> blcc    = lincsd->tmpncc;
+    gmx::ArrayRef<real> rhs1    = lincsd->tmp1;
+    gmx::ArrayRef<real> rhs2    = lincsd->tmp2;
+    gmx::ArrayRef<real> rhsTri1 = lincsd->tmpTri1;
+    gmx::ArrayRef<real> rhsTri2 = lincsd->tmpTri2;
+    gmx::ArrayRef<real> sol     = lincsd->tmp3;
 
     const rvec* x = as_rvec_array(xPadded.paddedArrayRef().data());
     rvec*       f = as_rvec_array(fPadded.paddedArrayRef().data());
@@ -683,7 +705,7 @@ static void do_lincsp(ArrayRefWithPadding<const RVec> xPadded,
     }
     /* Together: 23*ncons + 6*nrtot flops */
 
-    lincs_matrix_expand(*lincsd, lincsd->task[th], blcc, rhs1, rhs2, sol);
+    lincs_matrix_expand(*lincsd, lincsd->task[th], blcc, rhs1, rhs2, rhsTri1, rhsTri2, sol);
     /* nrec*(ncons+2*nrtot) flops */
 
     if (econq == ConstraintVariable::Deriv_FlexCon)
@@ -981,6 +1003,8 @@ static void do_lincs(ArrayRefWithPadding<const RVec> xPadded,
     gmx::ArrayRef<real>           blcc    = lincsd->tmpncc;
     gmx::ArrayRef<real>           rhs1    = lincsd->tmp1;
     gmx::ArrayRef<real>           rhs2    = lincsd->tmp2;
+    gmx::ArrayRef<real>           rhsTri1 = lincsd->tmpTri1;
+    gmx::ArrayRef<real>           rhsTri2 = lincsd->tmpTri2;
     gmx::ArrayRef<real>           sol     = lincsd->tmp3;
     gmx::ArrayRef<real>           blc_sol = lincsd->tmp4;
     gmx::ArrayRef<real>           mlambda = lincsd->mlambda;
@@ -1066,7 +1090,7 @@ static void do_lincs(ArrayRefWithPadding<const RVec> xPadded,
     }
     /* Together: 26*ncons + 6*nrtot flops */
 
-    lincs_matrix_expand(*lincsd, lincsd->task[th], blcc, rhs1, rhs2, sol);
+    lincs_matrix_expand(*lincsd, lincsd->task[th], blcc, rhs1, rhs2, rhsTri1, rhsTri2, sol);
     /* nrec*(ncons+2*nrtot) flops */
 
 #if GMX_SIMD_HAVE_REAL
@@ -1124,7 +1148,7 @@ static void do_lincs(ArrayRefWithPadding<const RVec> xPadded,
         /* 20*ncons flops */
 #endif // GMX_SIMD_HAVE_REAL
 
-        lincs_matrix_expand(*lincsd, lincsd->task[th], blcc, rhs1, rhs2, sol);
+        lincs_matrix_expand(*lincsd, lincsd->task[th], blcc, rhs1, rhs2, rhsTri1, rhsTri2, sol);
         /* nrec*(ncons+2*nrtot) flops */
 
 #if GMX_SIMD_HAVE_REAL
@@ -1928,6 +1952,14 @@ void set_lincs(const t_idef& idef, const t_mdatoms& md, bool bDynamics, const t_
     li->tmp2.resize(numEntries);
     li->tmp3.resize(numEntries);
     li->tmp4.resize(numEntries);
+    if (li->ncg_triangle > 0 && li->ntask > 1)
+    {
+        /* Extra rhs buffers that allow lincs_matrix_expand to start the
+         * recursions for the triangle constraints without a barrier.
+         */
+        li->tmpTri1.resize(numEntries);
+        li->tmpTri2.resize(numEntries);
+    }
     li->mlambda.resize(numEntries);
 
     iatom = idef.il[F_CONSTR].iatoms;
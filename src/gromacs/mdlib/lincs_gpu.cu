@@ -71,10 +71,16 @@
 namespace gmx
 {
 
-//! Number of CUDA threads in a block
+//! Default number of CUDA threads in a block
 constexpr static int c_threadsPerBlock = 256;
-//! Maximum number of threads in a block (for __launch_bounds__)
-constexpr static int c_maxThreadsPerBlock = c_threadsPerBlock;
+/*! \brief Maximum supported number of threads in a block.
+ *
+ * All constraints in a group of coupled constraints have to reside in the
+ * same thread block, since the kernel only synchronizes within a block.
+ * The block size is increased up to this hardware limit in set() when the
+ * topology contains larger groups, e.g. with all-bond constraints.
+ */
+constexpr static int c_maxThreadsPerBlock = 1024;
 
 /*! \brief Main kernel for LINCS constraints.
  *
@@ -99,11 +105,13 @@ constexpr static int c_maxThreadsPerBlock = c_threadsPerBlock;
  * \todo The use of __restrict__  for gm_xp and gm_v causes failure, probably because of the atomic
          operations. Investigate this issue further.
  *
+ * \tparam        blockSize     Number of threads in a block, needed for the launch bounds.
+ *
  * \param[in,out] kernelParams  All parameters and pointers for the kernel condensed in single struct.
  * \param[in]     invdt         Inverse timestep (needed to update velocities).
  */
-template<bool updateVelocities, bool computeVirial>
-__launch_bounds__(c_maxThreadsPerBlock) __global__
+template<bool updateVelocities, bool computeVirial, int blockSize>
+__launch_bounds__(blockSize) __global__
         void lincs_kernel(LincsGpuKernelParameters kernelParams,
                           const float3* __restrict__ gm_x,
                           float3*     gm_xp,
@@ -393,38 +401,67 @@ __launch_bounds__(c_maxThreadsPerBlock) __global__
     return;
 }
 
-/*! \brief Select templated kernel.
+/*! \brief Select templated kernel for a compile-time block size.
  *
  * Returns pointer to a CUDA kernel based on provided booleans.
  *
+ * \tparam    blockSize         Number of threads in a block.
+ *
  * \param[in] updateVelocities  If the velocities should be constrained.
  * \param[in] computeVirial     If virial should be updated.
  *
  * \return                      Pointer to CUDA kernel
  */
-inline auto getLincsKernelPtr(const bool updateVelocities, const bool computeVirial)
+template<int blockSize>
+static auto getLincsKernelPtr(const bool updateVelocities, const bool computeVirial)
 {
 
-    auto kernelPtr = lincs_kernel<true, true>;
+    auto kernelPtr = lincs_kernel<true, true, blockSize>;
     if (updateVelocities && computeVirial)
     {
-        kernelPtr = lincs_kernel<true, true>;
+        kernelPtr = lincs_kernel<true, true, blockSize>;
     }
     else if (updateVelocities && !computeVirial)
     {
-        kernelPtr = lincs_kernel<true, false>;
+        kernelPtr = lincs_kernel<true, false, blockSize>;
     }
     else if (!updateVelocities && computeVirial)
     {
-        kernelPtr = lincs_kernel<false, true>;
+        kernelPtr = lincs_kernel<false, true, blockSize>;
     }
     else if (!updateVelocities && !computeVirial)
     {
-        kernelPtr = lincs_kernel<false, false>;
+        kernelPtr = lincs_kernel<false, false, blockSize>;
     }
     return kernelPtr;
 }
 
+/*! \brief Select templated kernel.
+ *
+ * Returns pointer to a CUDA kernel based on provided booleans and the block size.
+ *
+ * \param[in] updateVelocities  If the velocities should be constrained.
+ * \param[in] computeVirial     If virial should be updated.
+ * \param[in] threadsPerBlock   Number of threads in a block.
+ *
+ * \return                      Pointer to CUDA kernel
+ */
+inline auto getLincsKernelPtr(const bool updateVelocities, const bool computeVirial, const int threadsPerBlock)
+{
+    switch (threadsPerBlock)
+    {
+        case c_threadsPerBlock:
+            return getLincsKernelPtr<c_threadsPerBlock>(updateVelocities, computeVirial);
+        case 2 * c_threadsPerBlock:
+            return getLincsKernelPtr<2 * c_threadsPerBlock>(updateVelocities, computeVirial);
+        case c_maxThreadsPerBlock:
+            return getLincsKernelPtr<c_maxThreadsPerBlock>(updateVelocities, computeVirial);
+        default:
+            GMX_RELEASE_ASSERT(false, "Unsupported number of threads per block for GPU LINCS");
+            return getLincsKernelPtr<c_threadsPerBlock>(updateVelocities, computeVirial);
+    }
+}
+
 void LincsGpu::apply(const float3* d_x,
                      float3*       d_xp,
                      const bool    updateVelocities,
@@ -449,13 +486,13 @@ void LincsGpu::apply(const float3* d_x,
         clearDeviceBufferAsync(&kernelParams_.d_virialScaled, 0, 6, commandStream_);
     }
 
-    auto kernelPtr = getLincsKernelPtr(updateVelocities, computeVirial);
+    auto kernelPtr = getLincsKernelPtr(updateVelocities, computeVirial, threadsPerBlock_);
 
     KernelLaunchConfig config;
-    config.blockSize[0] = c_threadsPerBlock;
+    config.blockSize[0] = threadsPerBlock_;
     config.blockSize[1] = 1;
     config.blockSize[2] = 1;
-    config.gridSize[0] = (kernelParams_.numConstraintsThreads + c_threadsPerBlock - 1) / c_threadsPerBlock;
+    config.gridSize[0] = (kernelParams_.numConstraintsThreads + threadsPerBlock_ - 1) / threadsPerBlock_;
     config.gridSize[1] = 1;
     config.gridSize[2] = 1;
 
@@ -468,11 +505,11 @@ void LincsGpu::apply(const float3* d_x,
     // max{3, 2, 6} = 6 floats per thread are needed in case virial is computed, or max{3, 2} = 3 if not.
     if (computeVirial)
     {
-        config.sharedMemorySize = c_threadsPerBlock * 6 * sizeof(float);
+        config.sharedMemorySize = threadsPerBlock_ * 6 * sizeof(float);
     }
     else
     {
-        config.sharedMemorySize = c_threadsPerBlock * 3 * sizeof(float);
+        config.sharedMemorySize = threadsPerBlock_ * 3 * sizeof(float);
     }
     config.stream = commandStream_;
 
@@ -524,6 +561,8 @@ LincsGpu::LincsGpu(int numIterations, int expansionOrder, CommandStream commandS
     // The data arrays should be expanded/reallocated on first call of set() function.
     numConstraintsThreadsAlloc_ = 0;
     numAtomsAlloc_              = 0;
+    // The block size is adjusted in set() when the topology requires it.
+    threadsPerBlock_ = c_threadsPerBlock;
 }
 
 LincsGpu::~LincsGpu()
@@ -710,7 +749,7 @@ bool LincsGpu::isNumCoupledConstraintsSupported(const gmx_mtop_t& mtop)
         const auto numCoupledConstraints = countNumCoupledConstraints(iatoms, atomsAdjacencyList);
         for (const int numCoupled : numCoupledConstraints)
         {
-            if (numCoupled > c_threadsPerBlock)
+            if (numCoupled > c_maxThreadsPerBlock)
             {
                 return false;
             }
@@ -753,6 +792,18 @@ void LincsGpu::set(const t_idef& idef, const t_mdatoms& md)
     // Compute, how many constraints are coupled to each constraint
     const auto numCoupledConstraints = countNumCoupledConstraints(iatoms, atomsAdjacencyList);
 
+    // All constraints of a coupled group have to reside in the same thread block,
+    // since the kernel only synchronizes within a block. Double the block size,
+    // up to the hardware limit, until the largest group fits, so that e.g.
+    // all-bond constrained topologies can run on the GPU.
+    const int maxCoupledConstraintsGroup =
+            *std::max_element(numCoupledConstraints.begin(), numCoupledConstraints.end());
+    threadsPerBlock_ = c_threadsPerBlock;
+    while (maxCoupledConstraintsGroup > threadsPerBlock_ && threadsPerBlock_ < c_maxThreadsPerBlock)
+    {
+        threadsPerBlock_ *= 2;
+    }
+
     // Map of splits in the constraints data. For each 'old' constraint index gives 'new' which
     // takes into account the empty spaces which might be needed in the end of each thread block.
     std::vector<int> splitMap(numConstraints, -1);
@@ -760,27 +811,27 @@ void LincsGpu::set(const t_idef& idef, const t_mdatoms& md)
     for (int c = 0; c < numConstraints; c++)
     {
         // Check if coupled constraints all fit in one block
-        if (numCoupledConstraints.at(c) > c_threadsPerBlock)
+        if (numCoupledConstraints.at(c) > threadsPerBlock_)
         {
             gmx_fatal(FARGS,
-                      "Maximum number of coupled constraints (%d) exceeds the size of the CUDA "
-                      "thread block (%d). Most likely, you are trying to use the GPU version of "
-                      "LINCS with constraints on all-bonds, which is not supported for large "
+                      "Maximum number of coupled constraints (%d) exceeds the maximum size of the "
+                      "CUDA thread block (%d). Most likely, you are trying to use the GPU version "
+                      "of LINCS with constraints on all-bonds, which is not supported for large "
                       "molecules. When compatible with the force field and integration settings, "
                       "using constraints on H-bonds only.",
-                      numCoupledConstraints.at(c), c_threadsPerBlock);
+                      numCoupledConstraints.at(c), threadsPerBlock_);
         }
-        if (currentMapIndex / c_threadsPerBlock
-            != (currentMapIndex + numCoupledConstraints.at(c)) / c_threadsPerBlock)
+        if (currentMapIndex / threadsPerBlock_
+            != (currentMapIndex + numCoupledConstraints.at(c)) / threadsPerBlock_)
         {
-            currentMapIndex = ((currentMapIndex / c_threadsPerBlock) + 1) * c_threadsPerBlock;
+            currentMapIndex = ((currentMapIndex / threadsPerBlock_) + 1) * threadsPerBlock_;
         }
         addWithCoupled(iatoms, stride, atomsAdjacencyList, splitMap, c, &currentMapIndex);
     }
 
     kernelParams_.numConstraintsThreads =
-            currentMapIndex + c_threadsPerBlock - currentMapIndex % c_threadsPerBlock;
-    GMX_RELEASE_ASSERT(kernelParams_.numConstraintsThreads % c_threadsPerBlock == 0,
+            currentMapIndex + threadsPerBlock_ - currentMapIndex % threadsPerBlock_;
+    GMX_RELEASE_ASSERT(kernelParams_.numConstraintsThreads % threadsPerBlock_ == 0,
                        "Number of threads should be a multiple of the block size");
 
     // Initialize constraints and their target indexes taking into account the splits in the data arrays.
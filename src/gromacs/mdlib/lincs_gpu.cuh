@@ -188,6 +188,14 @@ private:
      * reallocated.
      */
     int numAtomsAlloc_;
+
+    /*! \brief Number of threads in the kernel thread block.
+     *
+     * All constraints of a coupled group have to reside in the same thread block, since
+     * the kernel only synchronizes within a block. The block size is therefore chosen in
+     * set() as the smallest supported size that fits the largest coupled group.
+     */
+    int threadsPerBlock_;
 };
 
 } // namespace gmx
@@ -37,6 +37,8 @@
 
 #include "mdoutf.h"
 
+#include <thread>
+
 #include "gromacs/commandline/filenm.h"
 #include "gromacs/domdec/collect.h"
 #include "gromacs/domdec/domdec_struct.h"
@@ -83,8 +85,35 @@ struct gmx_mdoutf
     rvec*                         f_global;
     gmx::IMDOutputProvider*       outputProvider;
     const gmx::MdModulesNotifier* mdModulesNotifier;
+    /* Optional write-behind of compressed output (GMX_ASYNC_TRAJECTORY):
+     * the master rank hands the frame to a writer thread so compression
+     * and I/O overlap with the following MD steps. */
+    gmx_bool     bAsyncXtcWrite;
+    std::thread* xtcWriteThread;
+    rvec*        xtcWriteBuf;
+    matrix       xtcWriteBox;
+    gmx_bool     xtcWriteFailed;
 };
 
+/* Waits for an outstanding write-behind frame and raises the error it
+ * recorded, if any. A no-op when no write is pending. */
+static void mdoutf_wait_for_xtc_write(gmx_mdoutf_t of)
+{
+    if (of->xtcWriteThread != nullptr)
+    {
+        of->xtcWriteThread->join();
+        delete of->xtcWriteThread;
+        of->xtcWriteThread = nullptr;
+        if (of->xtcWriteFailed)
+        {
+            gmx_fatal(FARGS,
+                      "XTC error. This indicates you are out of disk space, or a "
+                      "simulation with major instabilities resulting in coordinates "
+                      "that are NaN or too large to be represented in the XTC format.\n");
+        }
+    }
+}
+
 
 gmx_mdoutf_t init_mdoutf(FILE*                         fplog,
                          int                           nfile,
@@ -122,6 +151,10 @@ gmx_mdoutf_t init_mdoutf(FILE*                         fplog,
     of->wcycle                  = wcycle;
     of->f_global                = nullptr;
     of->outputProvider          = outputProvider;
+    of->bAsyncXtcWrite          = FALSE;
+    of->xtcWriteThread          = nullptr;
+    of->xtcWriteBuf             = nullptr;
+    of->xtcWriteFailed          = FALSE;
 
     if (MASTER(cr))
     {
@@ -135,7 +168,13 @@ gmx_mdoutf_t init_mdoutf(FILE*                         fplog,
             filename = ftp2fn(efCOMPRESSED, nfile, fnm);
             switch (fn2ftp(filename))
             {
-                case efXTC: of->fp_xtc = open_xtc(filename, filemode); break;
+                case efXTC:
+                    of->fp_xtc = open_xtc(filename, filemode);
+                    if (getenv("GMX_ASYNC_TRAJECTORY") != nullptr)
+                    {
+                        of->bAsyncXtcWrite = TRUE;
+                    }
+                    break;
                 case efTNG:
                     gmx_tng_open(filename, filemode[0], &of->tng_low_prec);
                     if (filemode[0] == 'w')
@@ -294,6 +333,9 @@ void mdoutf_write_to_trajectory_files(FILE*                    fplog,
     {
         if (mdof_flags & MDOF_CPT)
         {
+            /* The checkpoint syncs all output files, so an outstanding
+             * write-behind frame has to be complete first. */
+            mdoutf_wait_for_xtc_write(of);
             fflush_tng(of->tng);
             fflush_tng(of->tng_low_prec);
             ivec one_ivec = { 1, 1, 1 };
@@ -339,7 +381,18 @@ void mdoutf_write_to_trajectory_files(FILE*                    fplog,
         {
             rvec* xxtc = nullptr;
 
-            if (of->natoms_x_compressed == of->natoms_global)
+            if (of->bAsyncXtcWrite)
+            {
+                /* The previous frame has to be written out before its
+                   buffer can be reused. */
+                mdoutf_wait_for_xtc_write(of);
+                if (of->xtcWriteBuf == nullptr)
+                {
+                    snew(of->xtcWriteBuf, of->natoms_x_compressed);
+                }
+                xxtc = of->xtcWriteBuf;
+            }
+            else if (of->natoms_x_compressed == of->natoms_global)
             {
                 /* We are writing the positions of all of the atoms to
                    the compressed output */
@@ -350,32 +403,56 @@ void mdoutf_write_to_trajectory_files(FILE*                    fplog,
                 /* We are writing the positions of only a subset of
                    the atoms to the compressed output, so we have to
                    make a copy of the subset of coordinates. */
-                int i, j;
-
                 snew(xxtc, of->natoms_x_compressed);
+            }
+            if (xxtc != state_global->x.rvec_array())
+            {
+                int  i, j;
                 auto x = makeArrayRef(state_global->x);
                 for (i = 0, j = 0; (i < of->natoms_global); i++)
                 {
-                    if (getGroupType(*of->groups, SimulationAtomGroupType::CompressedPositionOutput, i) == 0)
+                    if (of->natoms_x_compressed == of->natoms_global
+                        || getGroupType(*of->groups, SimulationAtomGroupType::CompressedPositionOutput, i) == 0)
                     {
                         copy_rvec(x[i], xxtc[j++]);
                     }
                 }
             }
-            if (write_xtc(of->fp_xtc, of->natoms_x_compressed, step, t, state_local->box, xxtc,
-                          of->x_compression_precision)
-                == 0)
+            if (of->bAsyncXtcWrite)
             {
-                gmx_fatal(FARGS,
-                          "XTC error. This indicates you are out of disk space, or a "
-                          "simulation with major instabilities resulting in coordinates "
-                          "that are NaN or too large to be represented in the XTC format.\n");
+                /* Hand the frame to a writer thread, so compression and
+                   I/O overlap with the steps until the next output.
+                   write_xtc goes through gmx_fio, whose per-file locking
+                   makes this safe against the other output streams; an
+                   error is raised when the thread is joined. */
+                copy_mat(state_local->box, of->xtcWriteBox);
+                of->xtcWriteFailed = FALSE;
+                of->xtcWriteThread = new std::thread([of, step, t]() {
+                    if (write_xtc(of->fp_xtc, of->natoms_x_compressed, step, t, of->xtcWriteBox,
+                                  of->xtcWriteBuf, of->x_compression_precision)
+                        == 0)
+                    {
+                        of->xtcWriteFailed = TRUE;
+                    }
+                });
             }
-            gmx_fwrite_tng(of->tng_low_prec, TRUE, step, t, state_local->lambda[efptFEP],
-                           state_local->box, of->natoms_x_compressed, xxtc, nullptr, nullptr);
-            if (of->natoms_x_compressed != of->natoms_global)
+            else
             {
-                sfree(xxtc);
+                if (write_xtc(of->fp_xtc, of->natoms_x_compressed, step, t, state_local->box, xxtc,
+                              of->x_compression_precision)
+                    == 0)
+                {
+                    gmx_fatal(FARGS,
+                              "XTC error. This indicates you are out of disk space, or a "
+                              "simulation with major instabilities resulting in coordinates "
+                              "that are NaN or too large to be represented in the XTC format.\n");
+                }
+                gmx_fwrite_tng(of->tng_low_prec, TRUE, step, t, state_local->lambda[efptFEP],
+                               state_local->box, of->natoms_x_compressed, xxtc, nullptr, nullptr);
+                if (of->natoms_x_compressed != of->natoms_global)
+                {
+                    sfree(xxtc);
+                }
             }
         }
         if (mdof_flags & (MDOF_BOX | MDOF_LAMBDA) && !(mdof_flags & (MDOF_X | MDOF_V | MDOF_F)))
@@ -430,6 +507,12 @@ void mdoutf_tng_close(gmx_mdoutf_t of)
 
 void done_mdoutf(gmx_mdoutf_t of)
 {
+    /* A frame or checkpoint may still be writing on a background thread;
+     * they have to finish before we close the files they refer to.
+     */
+    mdoutf_wait_for_xtc_write(of);
+    wait_for_pending_checkpoint();
+
     if (of->fp_ene != nullptr)
     {
         done_ener_file(of->fp_ene);
@@ -451,6 +534,10 @@ void done_mdoutf(gmx_mdoutf_t of)
     {
         sfree(of->f_global);
     }
+    if (of->xtcWriteBuf != nullptr)
+    {
+        sfree(of->xtcWriteBuf);
+    }
 
     gmx_tng_close(&of->tng);
     gmx_tng_close(&of->tng_low_prec);
@@ -532,6 +532,31 @@ void init_QMMMrec(const t_commrec* cr, const gmx_mtop_t* mtop, const t_inputrec*
         qr->mm          = mm;
     }
 
+    /* Optionally the QM forces can be reused while the QM/MM region barely
+     * moves, which avoids most QM calls in runs where the region is (nearly)
+     * converged. This expert feature is enabled by setting the maximum atom
+     * displacement (nm) in the GMX_QMMM_FORCE_CACHE_TOL environment variable.
+     * It is not implemented for the multi-layer ONIOM scheme. */
+    qr->forceCache = nullptr;
+    if (qr->QMMMscheme != eQMMMschemeoniom)
+    {
+        const char* env = getenv("GMX_QMMM_FORCE_CACHE_TOL");
+        if (env != nullptr)
+        {
+            double tolerance = 0;
+            sscanf(env, "%lf", &tolerance);
+            if (tolerance > 0)
+            {
+                snew(qr->forceCache, 1);
+                qr->forceCache->tolerance = tolerance;
+                fprintf(stderr,
+                        "\nQM/MM: Reusing QM forces while no QM/MM atom moves more than %g nm "
+                        "since the last QM call (GMX_QMMM_FORCE_CACHE_TOL).\n",
+                        tolerance);
+            }
+        }
+    }
+
     /* these variables get updated in the update QMMMrec */
 
     if (qr->nrQMlayers == 1)
@@ -828,6 +853,86 @@ void update_QMMMrec(const t_commrec* cr, const t_forcerec* fr, const rvec* x, co
     }
 } /* update_QMMM_rec */
 
+/* Returns whether no QM or MM atom moved further than cache->tolerance since
+ * the cached QM call, so that the cached forces can be reused. A changed MM
+ * environment list always triggers a fresh QM call.
+ */
+static gmx_bool QMMM_region_is_unchanged(const t_QMMMforceCache* cache, const t_QMrec* qm, const t_MMrec* mm)
+{
+    int  i;
+    rvec dx;
+
+    if (!cache->bValid || cache->nrQMatoms != qm->nrQMatoms || cache->nrMMatoms != mm->nrMMatoms)
+    {
+        return FALSE;
+    }
+    for (i = 0; i < mm->nrMMatoms; i++)
+    {
+        if (cache->indexMM[i] != mm->indexMM[i])
+        {
+            return FALSE;
+        }
+    }
+
+    const real tolerance2 = cache->tolerance * cache->tolerance;
+
+    for (i = 0; i < qm->nrQMatoms; i++)
+    {
+        rvec_sub(qm->xQM[i], cache->xQM[i], dx);
+        if (norm2(dx) > tolerance2)
+        {
+            return FALSE;
+        }
+    }
+    for (i = 0; i < mm->nrMMatoms; i++)
+    {
+        rvec_sub(mm->xMM[i], cache->xMM[i], dx);
+        if (norm2(dx) > tolerance2)
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/* Store the region geometry together with the forces and energy of a QM call,
+ * so that subsequent steps can reuse them while the region barely moves.
+ */
+static void store_QMMM_force_cache(t_QMMMforceCache* cache,
+                                   const t_QMrec*    qm,
+                                   const t_MMrec*    mm,
+                                   const rvec*       forces,
+                                   const rvec*       fshift,
+                                   real              QMener)
+{
+    int i;
+
+    cache->nrQMatoms = qm->nrQMatoms;
+    cache->nrMMatoms = mm->nrMMatoms;
+    srenew(cache->xQM, qm->nrQMatoms);
+    srenew(cache->xMM, mm->nrMMatoms);
+    srenew(cache->indexMM, mm->nrMMatoms);
+    srenew(cache->forces, qm->nrQMatoms + mm->nrMMatoms);
+    srenew(cache->fshift, qm->nrQMatoms + mm->nrMMatoms);
+    for (i = 0; i < qm->nrQMatoms; i++)
+    {
+        copy_rvec(qm->xQM[i], cache->xQM[i]);
+    }
+    for (i = 0; i < mm->nrMMatoms; i++)
+    {
+        copy_rvec(mm->xMM[i], cache->xMM[i]);
+        cache->indexMM[i] = mm->indexMM[i];
+    }
+    for (i = 0; i < qm->nrQMatoms + mm->nrMMatoms; i++)
+    {
+        copy_rvec(forces[i], cache->forces[i]);
+        copy_rvec(fshift[i], cache->fshift[i]);
+    }
+    cache->QMener = QMener;
+    cache->bValid = TRUE;
+}
+
 real calculate_QMMM(const t_commrec* cr, gmx::ForceWithShiftForces* forceWithShiftForces, const t_QMMMrec* qr)
 {
     real QMener = 0.0;
@@ -860,7 +965,26 @@ real calculate_QMMM(const t_commrec* cr, gmx::ForceWithShiftForces* forceWithShi
         qm = qr->qm[0];
         snew(forces, (qm->nrQMatoms + mm->nrMMatoms));
         snew(fshift, (qm->nrQMatoms + mm->nrMMatoms));
-        QMener = call_QMroutine(cr, qr, qm, mm, forces, fshift);
+        if (qr->forceCache != nullptr && QMMM_region_is_unchanged(qr->forceCache, qm, mm))
+        {
+            /* The region barely moved since the last QM call, reuse the
+             * cached QM forces and energy instead of calling the QM package.
+             * The forces are still applied with the current shift indices. */
+            for (i = 0; i < qm->nrQMatoms + mm->nrMMatoms; i++)
+            {
+                copy_rvec(qr->forceCache->forces[i], forces[i]);
+                copy_rvec(qr->forceCache->fshift[i], fshift[i]);
+            }
+            QMener = qr->forceCache->QMener;
+        }
+        else
+        {
+            QMener = call_QMroutine(cr, qr, qm, mm, forces, fshift);
+            if (qr->forceCache != nullptr)
+            {
+                store_QMMM_force_cache(qr->forceCache, qm, mm, forces, fshift, QMener);
+            }
+        }
         for (i = 0; i < qm->nrQMatoms; i++)
         {
             for (j = 0; j < DIM; j++)
@@ -112,12 +112,29 @@ typedef struct
 } t_MMrec;
 
 
+typedef struct t_QMMMforceCache
+{
+    real     tolerance; /* max. displacement (nm) for force reuse  */
+    gmx_bool bValid;    /* do the cached data match a QM call?     */
+    int      nrQMatoms; /* nr of QM atoms at the cached QM call    */
+    int      nrMMatoms; /* nr of MM atoms at the cached QM call    */
+    rvec*    xQM;       /* QM positions at the cached QM call      */
+    rvec*    xMM;       /* MM positions at the cached QM call      */
+    int*     indexMM;   /* MM atom indices at the cached QM call   */
+    rvec*    forces;    /* cached QM+MM forces                     */
+    rvec*    fshift;    /* cached QM+MM shift forces               */
+    real     QMener;    /* cached QM energy                        */
+} t_QMMMforceCache;
+
 typedef struct t_QMMMrec
 {
     int       QMMMscheme; /* ONIOM (multi-layer) or normal          */
     int       nrQMlayers; /* number of QM layers (total layers +1 (MM)) */
     t_QMrec** qm;         /* atoms and run params for each QM group */
     t_MMrec*  mm;         /* there can only be one MM subsystem !   */
+    t_QMMMforceCache* forceCache; /* reuse QM forces while the region
+                                     barely moves, see calculate_QMMM;
+                                     NULL when caching is not enabled  */
 } t_QMMMrec;
 
 void atomic_number(int nr, char*** atomtype, int* nucnum);
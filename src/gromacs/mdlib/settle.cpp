@@ -51,6 +51,8 @@
 #include <cstdio>
 
 #include <algorithm>
+#include <numeric>
+#include <vector>
 
 #include "gromacs/math/arrayrefwithpadding.h"
 #include "gromacs/math/functions.h"
@@ -293,6 +295,36 @@ void settle_set_constraints(settledata* settled, const t_ilist* il_settle, const
             settled->virfac[i] = (iatoms[i * nral1 + 1] < mdatoms.homenr ? 1 : 0);
         }
 
+        /* With domain decomposition the settles can be ordered by home
+         * charge group instead of by atom index. Sort them by oxygen atom
+         * index, so the gathers and scatters in the kernel walk through
+         * the coordinate arrays in memory order, which makes them stream
+         * with hardware prefetching. The constrained coordinates do not
+         * depend on the order; only the virial summation order, and
+         * thereby its last bits, can change.
+         */
+        if (!std::is_sorted(settled->ow1, settled->ow1 + nsettle))
+        {
+            std::vector<int> order(nsettle);
+            std::iota(order.begin(), order.end(), 0);
+            const int* ow1 = settled->ow1;
+            std::sort(order.begin(), order.end(), [ow1](int a, int b) { return ow1[a] < ow1[b]; });
+
+            std::vector<real> virfacBuffer(settled->virfac, settled->virfac + nsettle);
+            for (int* index : { settled->ow1, settled->hw2, settled->hw3 })
+            {
+                std::vector<int> buffer(index, index + nsettle);
+                for (int i = 0; i < nsettle; i++)
+                {
+                    index[i] = buffer[order[i]];
+                }
+            }
+            for (int i = 0; i < nsettle; i++)
+            {
+                settled->virfac[i] = virfacBuffer[order[i]];
+            }
+        }
+
         /* Pack the index array to the full SIMD width with copies from
          * the last normal entry, but with no virial contribution.
          */
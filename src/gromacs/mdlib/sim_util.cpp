@@ -362,7 +362,7 @@ static void do_nb_verlet(t_forcerec*                fr,
              * the current coordinates of the atoms.
              */
             wallcycle_sub_start(wcycle, ewcsNONBONDED_PRUNING);
-            nbv->dispatchPruneKernelCpu(ilocality, fr->shift_vec);
+            nbv->dispatchPruneKernelCpu(ilocality, fr->shift_vec, step);
             wallcycle_sub_stop(wcycle, ewcsNONBONDED_PRUNING);
         }
     }
@@ -1026,7 +1026,7 @@ void do_force(FILE*                               fplog,
     // operations were checked before construction, so here we can
     // just use it and assert upon any conditions.
     const bool ddUsesGpuDirectCommunication =
-            ((cr->dd != nullptr) && (!cr->dd->gpuHaloExchange.empty()));
+            ((cr->dd != nullptr) && (!cr->dd->gpuHaloExchange[0].empty()));
     GMX_ASSERT(!ddUsesGpuDirectCommunication || stepWork.useGpuXBufferOps,
                "Must use coordinate buffer ops with GPU halo exchange");
     const bool useGpuForcesHaloExchange = ddUsesGpuDirectCommunication && stepWork.useGpuFBufferOps;
@@ -1736,7 +1736,8 @@ void do_force(FILE*                               fplog,
             }
             if (useGpuForcesHaloExchange)
             {
-                dependencyList.push_back(cr->dd->gpuHaloExchange[0]->getForcesReadyOnDeviceEvent());
+                dependencyList.push_back(
+                        cr->dd->gpuHaloExchange[0][0]->getForcesReadyOnDeviceEvent());
             }
             nbv->atomdata_add_nbat_f_to_f_gpu(AtomLocality::Local, stateGpu->getForces(), pmeForcePtr,
                                               dependencyList, stepWork.useGpuPmeFReduction,
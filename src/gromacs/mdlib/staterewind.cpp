@@ -0,0 +1,393 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Implements an in-memory ring of recent simulation states for rewinding
+ *
+ * \ingroup module_mdlib
+ */
+#include "gmxpre.h"
+
+#include "staterewind.h"
+
+#include <cstring>
+
+#include <algorithm>
+
+#include "gromacs/mdtypes/state.h"
+#include "gromacs/utility/gmxassert.h"
+
+namespace gmx
+{
+
+namespace
+{
+
+//! Append the raw bytes of \p value to \p buffer.
+template<typename T>
+void appendValue(std::vector<char>* buffer, const T& value)
+{
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer->insert(buffer->end(), bytes, bytes + sizeof(T));
+}
+
+//! Append the size and contents of \p values to \p buffer.
+template<typename T>
+void appendVector(std::vector<char>* buffer, const std::vector<T>& values)
+{
+    appendValue(buffer, static_cast<int64_t>(values.size()));
+    const char* bytes = reinterpret_cast<const char*>(values.data());
+    buffer->insert(buffer->end(), bytes, bytes + values.size() * sizeof(T));
+}
+
+//! Append \p numElements RVecs starting at \p values to \p buffer.
+void appendRVecs(std::vector<char>* buffer, const RVec* values, int64_t numElements)
+{
+    appendValue(buffer, numElements);
+    const char* bytes = reinterpret_cast<const char*>(values);
+    buffer->insert(buffer->end(), bytes, bytes + numElements * sizeof(RVec));
+}
+
+//! Read the raw bytes of \p value from \p buffer at \p offset, advancing it.
+template<typename T>
+void readValue(const std::vector<char>& buffer, std::size_t* offset, T* value)
+{
+    GMX_RELEASE_ASSERT(*offset + sizeof(T) <= buffer.size(), "Snapshot buffer overrun");
+    std::memcpy(value, buffer.data() + *offset, sizeof(T));
+    *offset += sizeof(T);
+}
+
+//! Read a size-prefixed vector from \p buffer at \p offset, advancing it.
+template<typename T>
+void readVector(const std::vector<char>& buffer, std::size_t* offset, std::vector<T>* values)
+{
+    int64_t size;
+    readValue(buffer, offset, &size);
+    GMX_RELEASE_ASSERT(*offset + size * sizeof(T) <= buffer.size(), "Snapshot buffer overrun");
+    values->resize(size);
+    std::memcpy(values->data(), buffer.data() + *offset, size * sizeof(T));
+    *offset += size * sizeof(T);
+}
+
+//! Read a size-prefixed RVec array from \p buffer at \p offset, advancing it.
+void readRVecs(const std::vector<char>& buffer, std::size_t* offset, PaddedHostVector<RVec>* values)
+{
+    int64_t size;
+    readValue(buffer, offset, &size);
+    GMX_RELEASE_ASSERT(*offset + size * sizeof(RVec) <= buffer.size(), "Snapshot buffer overrun");
+    values->resizeWithPadding(size);
+    std::memcpy(values->data(), buffer.data() + *offset, size * sizeof(RVec));
+    *offset += size * sizeof(RVec);
+}
+
+/*! \brief Serialize the dynamical fields of \p state into a byte buffer.
+ *
+ * The field set matches what do_cpt_state() writes for the t_state part
+ * of a checkpoint, minus the histories that this class does not capture.
+ */
+std::vector<char> serializeState(const t_state& state)
+{
+    std::vector<char> buffer;
+
+    appendValue(&buffer, state.natoms);
+    appendValue(&buffer, state.ngtc);
+    appendValue(&buffer, state.nnhpres);
+    appendValue(&buffer, state.nhchainlength);
+    appendValue(&buffer, state.flags);
+    appendValue(&buffer, state.fep_state);
+    appendValue(&buffer, state.lambda);
+    appendValue(&buffer, state.box);
+    appendValue(&buffer, state.box_rel);
+    appendValue(&buffer, state.boxv);
+    appendValue(&buffer, state.pres_prev);
+    appendValue(&buffer, state.svir_prev);
+    appendValue(&buffer, state.fvir_prev);
+    appendVector(&buffer, state.nosehoover_xi);
+    appendVector(&buffer, state.nosehoover_vxi);
+    appendVector(&buffer, state.nhpres_xi);
+    appendVector(&buffer, state.nhpres_vxi);
+    appendVector(&buffer, state.therm_integral);
+    appendValue(&buffer, state.baros_integral);
+    appendValue(&buffer, state.veta);
+    appendValue(&buffer, state.vol0);
+    appendRVecs(&buffer, state.x.data(), (state.flags & (1 << estX)) ? state.natoms : 0);
+    appendRVecs(&buffer, state.v.data(), (state.flags & (1 << estV)) ? state.natoms : 0);
+    appendVector(&buffer, state.pull_com_prev_step);
+
+    return buffer;
+}
+
+//! Restore the fields written by serializeState() from \p buffer into \p state.
+void deserializeState(const std::vector<char>& buffer, t_state* state)
+{
+    std::size_t offset = 0;
+
+    readValue(buffer, &offset, &state->natoms);
+    readValue(buffer, &offset, &state->ngtc);
+    readValue(buffer, &offset, &state->nnhpres);
+    readValue(buffer, &offset, &state->nhchainlength);
+    readValue(buffer, &offset, &state->flags);
+    readValue(buffer, &offset, &state->fep_state);
+    readValue(buffer, &offset, &state->lambda);
+    readValue(buffer, &offset, &state->box);
+    readValue(buffer, &offset, &state->box_rel);
+    readValue(buffer, &offset, &state->boxv);
+    readValue(buffer, &offset, &state->pres_prev);
+    readValue(buffer, &offset, &state->svir_prev);
+    readValue(buffer, &offset, &state->fvir_prev);
+    readVector(buffer, &offset, &state->nosehoover_xi);
+    readVector(buffer, &offset, &state->nosehoover_vxi);
+    readVector(buffer, &offset, &state->nhpres_xi);
+    readVector(buffer, &offset, &state->nhpres_vxi);
+    readVector(buffer, &offset, &state->therm_integral);
+    readValue(buffer, &offset, &state->baros_integral);
+    readValue(buffer, &offset, &state->veta);
+    readValue(buffer, &offset, &state->vol0);
+    readRVecs(buffer, &offset, &state->x);
+    readRVecs(buffer, &offset, &state->v);
+    readVector(buffer, &offset, &state->pull_com_prev_step);
+    GMX_RELEASE_ASSERT(offset == buffer.size(), "Snapshot buffer not fully consumed");
+}
+
+//! Word size for the byte shuffle; matches the field granularity of real.
+constexpr std::size_t c_shuffleWord = 4;
+
+/*! \brief Run-length encode the XOR of two equally long buffers.
+ *
+ * Successive states share the sign, exponent and high-order mantissa
+ * bytes of most values, so their XOR is zero except for the low-order
+ * bytes. Those zeros are interleaved per value, so before encoding the
+ * XOR bytes are shuffled by their position within each 4-byte word
+ * (as in the HDF5 shuffle filter), which gathers them into long runs.
+ * The encoding is a sequence of (zero-run length, literal length,
+ * literal bytes) records with 32-bit lengths.
+ */
+std::vector<char> encodeDelta(const std::vector<char>& older, const std::vector<char>& newer)
+{
+    GMX_ASSERT(older.size() == newer.size(), "Can only delta-encode equal-size buffers");
+
+    const std::size_t size     = older.size();
+    const std::size_t numWords = size / c_shuffleWord;
+    std::vector<char> shuffled(size);
+    for (std::size_t w = 0; w < numWords; w++)
+    {
+        for (std::size_t p = 0; p < c_shuffleWord; p++)
+        {
+            shuffled[p * numWords + w] = older[w * c_shuffleWord + p] ^ newer[w * c_shuffleWord + p];
+        }
+    }
+    for (std::size_t i = numWords * c_shuffleWord; i < size; i++)
+    {
+        shuffled[i] = older[i] ^ newer[i];
+    }
+
+    std::vector<char> delta;
+    std::size_t       i = 0;
+    while (i < size)
+    {
+        std::size_t zeroRun = i;
+        while (zeroRun < size && shuffled[zeroRun] == 0)
+        {
+            zeroRun++;
+        }
+        /* Short zero gaps between literals are cheaper than a new record */
+        std::size_t literalEnd = zeroRun;
+        while (literalEnd < size)
+        {
+            std::size_t nextZeroRun = literalEnd;
+            while (nextZeroRun < size && shuffled[nextZeroRun] != 0)
+            {
+                nextZeroRun++;
+            }
+            std::size_t runLength = 0;
+            while (nextZeroRun + runLength < size && shuffled[nextZeroRun + runLength] == 0)
+            {
+                runLength++;
+            }
+            if (runLength > 2 * sizeof(uint32_t) || nextZeroRun + runLength == size)
+            {
+                literalEnd = nextZeroRun;
+                break;
+            }
+            literalEnd = nextZeroRun + runLength;
+        }
+        appendValue(&delta, static_cast<uint32_t>(zeroRun - i));
+        appendValue(&delta, static_cast<uint32_t>(literalEnd - zeroRun));
+        delta.insert(delta.end(), shuffled.begin() + zeroRun, shuffled.begin() + literalEnd);
+        i = literalEnd;
+    }
+
+    return delta;
+}
+
+//! Recover the older buffer by applying \p delta to \p newer in place.
+void applyDelta(const std::vector<char>& delta, std::vector<char>* newer)
+{
+    const std::size_t size = newer->size();
+    std::vector<char> shuffled(size, 0);
+    std::size_t       in  = 0;
+    std::size_t       out = 0;
+    while (in < delta.size())
+    {
+        uint32_t zeroRun;
+        uint32_t literalLength;
+        readValue(delta, &in, &zeroRun);
+        readValue(delta, &in, &literalLength);
+        out += zeroRun;
+        GMX_RELEASE_ASSERT(out + literalLength <= size && in + literalLength <= delta.size(),
+                           "Corrupted state snapshot delta");
+        std::memcpy(shuffled.data() + out, delta.data() + in, literalLength);
+        in += literalLength;
+        out += literalLength;
+    }
+    GMX_RELEASE_ASSERT(out <= size, "Corrupted state snapshot delta");
+
+    const std::size_t numWords = size / c_shuffleWord;
+    for (std::size_t w = 0; w < numWords; w++)
+    {
+        for (std::size_t p = 0; p < c_shuffleWord; p++)
+        {
+            (*newer)[w * c_shuffleWord + p] ^= shuffled[p * numWords + w];
+        }
+    }
+    for (std::size_t i = numWords * c_shuffleWord; i < size; i++)
+    {
+        (*newer)[i] ^= shuffled[i];
+    }
+}
+
+} // namespace
+
+StateRewindRing::StateRewindRing(int capacity) : capacity_(capacity), newestStep_(-1)
+{
+    GMX_RELEASE_ASSERT(capacity >= 1, "Need space for at least one snapshot");
+}
+
+void StateRewindRing::saveSnapshot(int64_t step, const t_state& state)
+{
+    std::vector<char> buffer = serializeState(state);
+
+    if (newestStep_ >= 0)
+    {
+        /* Demote the previous newest snapshot to a delta against the new one */
+        Snapshot snapshot;
+        snapshot.step    = newestStep_;
+        snapshot.rawSize = newestBuffer_.size();
+        if (newestBuffer_.size() == buffer.size())
+        {
+            snapshot.isDelta = true;
+            snapshot.data    = encodeDelta(newestBuffer_, buffer);
+        }
+        else
+        {
+            /* A repartitioned state changed size; keep it verbatim */
+            snapshot.isDelta = false;
+            snapshot.data    = std::move(newestBuffer_);
+        }
+        older_.push_back(std::move(snapshot));
+        while (static_cast<int>(older_.size()) + 1 > capacity_)
+        {
+            older_.pop_front();
+        }
+    }
+    newestStep_   = step;
+    newestBuffer_ = std::move(buffer);
+}
+
+int StateRewindRing::numSnapshots() const
+{
+    return older_.size() + (newestStep_ >= 0 ? 1 : 0);
+}
+
+int64_t StateRewindRing::oldestStep() const
+{
+    if (!older_.empty())
+    {
+        return older_.front().step;
+    }
+    return newestStep_;
+}
+
+int64_t StateRewindRing::newestStep() const
+{
+    return newestStep_;
+}
+
+int64_t StateRewindRing::rewindTo(int64_t step, t_state* state) const
+{
+    if (newestStep_ < 0 || step < oldestStep())
+    {
+        return -1;
+    }
+    if (step >= newestStep_)
+    {
+        deserializeState(newestBuffer_, state);
+        return newestStep_;
+    }
+    /* Replay the deltas backwards from the newest snapshot */
+    std::vector<char> buffer = newestBuffer_;
+    for (auto snapshot = older_.rbegin(); snapshot != older_.rend(); ++snapshot)
+    {
+        if (snapshot->isDelta)
+        {
+            GMX_RELEASE_ASSERT(snapshot->rawSize == buffer.size(),
+                               "Size mismatch while replaying state snapshot deltas");
+            applyDelta(snapshot->data, &buffer);
+        }
+        else
+        {
+            buffer = snapshot->data;
+        }
+        if (snapshot->step <= step)
+        {
+            deserializeState(buffer, state);
+            return snapshot->step;
+        }
+    }
+
+    return -1;
+}
+
+std::size_t StateRewindRing::memoryUsage() const
+{
+    std::size_t bytes = newestBuffer_.size();
+    for (const Snapshot& snapshot : older_)
+    {
+        bytes += snapshot.data.size();
+    }
+    return bytes;
+}
+
+} // namespace gmx
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares an in-memory ring of recent simulation states for rewinding
+ *
+ * \inlibraryapi
+ * \ingroup module_mdlib
+ */
+#ifndef GMX_MDLIB_STATEREWIND_H
+#define GMX_MDLIB_STATEREWIND_H
+
+#include <cstdint>
+
+#include <deque>
+#include <vector>
+
+#include "gromacs/utility/classhelpers.h"
+
+class t_state;
+
+namespace gmx
+{
+
+/*! \libinternal \brief
+ * In-memory ring of recent simulation states for rolling-window rewind.
+ *
+ * Workflows that repeatedly restart from recent frames, such as committor
+ * analysis, pay full checkpoint write and process restart costs for every
+ * shot. This class keeps the last N snapshots of the dynamical part of
+ * t_state in memory, so a driver can rewind the running simulation a
+ * bounded number of steps without touching the filesystem.
+ *
+ * Only the most recent snapshot is stored verbatim; older snapshots are
+ * stored as run-length encoded XOR deltas against their successor, which
+ * compresses well because successive states share most of their high-order
+ * mantissa and exponent bytes. Restoring replays the deltas backwards from
+ * the newest snapshot.
+ *
+ * The snapshot covers the same dynamical t_state fields that a checkpoint
+ * stores: positions, velocities, box and virial matrices, coupling
+ * degrees of freedom and the free-energy state. Restraint time averages
+ * (history_t), free-energy and AWH histories and the kinetic-energy state
+ * are not captured, matching what a rewind within a window of a few
+ * thousand steps needs.
+ */
+class StateRewindRing
+{
+public:
+    //! Create a ring holding at most \p capacity snapshots.
+    explicit StateRewindRing(int capacity);
+
+    //! Record a snapshot of \p state at \p step, evicting the oldest when full.
+    void saveSnapshot(int64_t step, const t_state& state);
+
+    //! Return the number of snapshots currently held.
+    int numSnapshots() const;
+
+    //! Return the step of the oldest held snapshot, or -1 when empty.
+    int64_t oldestStep() const;
+
+    //! Return the step of the newest held snapshot, or -1 when empty.
+    int64_t newestStep() const;
+
+    /*! \brief Restore into \p state the newest snapshot taken at or before \p step.
+     *
+     * \returns the step of the restored snapshot, or -1 when no snapshot
+     *          at or before \p step is held, in which case \p state is
+     *          not modified.
+     */
+    int64_t rewindTo(int64_t step, t_state* state) const;
+
+    //! Return the number of bytes of snapshot storage in use.
+    std::size_t memoryUsage() const;
+
+private:
+    //! A stored snapshot; all but the newest hold a delta against their successor.
+    struct Snapshot
+    {
+        //! The step the snapshot was taken at.
+        int64_t step;
+        //! Whether data holds an XOR delta instead of a verbatim buffer.
+        bool isDelta;
+        //! Size of the serialized state the entry decodes to.
+        std::size_t rawSize;
+        //! Delta-compressed or verbatim serialized state.
+        std::vector<char> data;
+    };
+
+    //! Maximum number of snapshots held.
+    int capacity_;
+    //! Older snapshots, oldest first; deltas against their successor.
+    std::deque<Snapshot> older_;
+    //! Step of the newest snapshot, or -1 when empty.
+    int64_t newestStep_;
+    //! Serialized newest snapshot.
+    std::vector<char> newestBuffer_;
+
+    GMX_DISALLOW_COPY_AND_ASSIGN(StateRewindRing);
+};
+
+} // namespace gmx
+
+#endif
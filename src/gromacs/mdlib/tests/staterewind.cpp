@@ -0,0 +1,203 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the in-memory state rewind ring
+ *
+ * \ingroup module_mdlib
+ */
+#include "gmxpre.h"
+
+#include "gromacs/mdlib/staterewind.h"
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/math/vec.h"
+#include "gromacs/mdtypes/state.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! Build a state whose dynamical fields vary deterministically with \p step.
+t_state makeState(int numAtoms, int64_t step)
+{
+    t_state state;
+
+    state.flags = (1 << estX) | (1 << estV) | (1 << estBOX);
+    state_change_natoms(&state, numAtoms);
+    for (int i = 0; i < numAtoms; i++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            /* Slowly drifting values, as in a real trajectory */
+            state.x[i][d] = std::sin(0.1 * i + 0.001 * step) + i;
+            state.v[i][d] = 0.01 * std::cos(0.2 * i + 0.001 * step);
+        }
+    }
+    clear_mat(state.box);
+    state.box[XX][XX] = state.box[YY][YY] = state.box[ZZ][ZZ] = 3.0 + 1e-6 * step;
+    state.veta                                                = 1e-4 * step;
+    state.baros_integral                                      = 1e-5 * step;
+    state.therm_integral.assign(3, 0.5 * step);
+
+    return state;
+}
+
+//! Check that the dynamical fields of \p a and \p b are bitwise equal.
+void checkStatesEqual(const t_state& a, const t_state& b)
+{
+    ASSERT_EQ(a.natoms, b.natoms);
+    for (int i = 0; i < a.natoms; i++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            EXPECT_EQ(a.x[i][d], b.x[i][d]);
+            EXPECT_EQ(a.v[i][d], b.v[i][d]);
+        }
+    }
+    EXPECT_EQ(a.box[XX][XX], b.box[XX][XX]);
+    EXPECT_EQ(a.veta, b.veta);
+    EXPECT_EQ(a.baros_integral, b.baros_integral);
+    ASSERT_EQ(a.therm_integral.size(), b.therm_integral.size());
+    for (size_t i = 0; i < a.therm_integral.size(); i++)
+    {
+        EXPECT_EQ(a.therm_integral[i], b.therm_integral[i]);
+    }
+}
+
+TEST(StateRewindRingTest, EmptyRingReportsNoSnapshots)
+{
+    StateRewindRing ring(4);
+
+    EXPECT_EQ(ring.numSnapshots(), 0);
+    EXPECT_EQ(ring.oldestStep(), -1);
+    EXPECT_EQ(ring.newestStep(), -1);
+
+    t_state state;
+    EXPECT_EQ(ring.rewindTo(100, &state), -1);
+}
+
+TEST(StateRewindRingTest, RestoresNewestSnapshotExactly)
+{
+    StateRewindRing ring(4);
+    const t_state   saved = makeState(50, 1000);
+
+    ring.saveSnapshot(1000, saved);
+    EXPECT_EQ(ring.numSnapshots(), 1);
+
+    t_state restored;
+    EXPECT_EQ(ring.rewindTo(1000, &restored), 1000);
+    checkStatesEqual(saved, restored);
+}
+
+TEST(StateRewindRingTest, RewindsThroughDeltaChain)
+{
+    StateRewindRing ring(8);
+    for (int64_t step = 0; step <= 500; step += 100)
+    {
+        ring.saveSnapshot(step, makeState(50, step));
+    }
+    EXPECT_EQ(ring.numSnapshots(), 6);
+    EXPECT_EQ(ring.oldestStep(), 0);
+    EXPECT_EQ(ring.newestStep(), 500);
+
+    for (int64_t step = 0; step <= 500; step += 100)
+    {
+        t_state restored;
+        EXPECT_EQ(ring.rewindTo(step, &restored), step);
+        checkStatesEqual(makeState(50, step), restored);
+    }
+    /* A step between snapshots rewinds to the nearest older one */
+    t_state restored;
+    EXPECT_EQ(ring.rewindTo(250, &restored), 200);
+    checkStatesEqual(makeState(50, 200), restored);
+}
+
+TEST(StateRewindRingTest, EvictsOldestWhenFull)
+{
+    StateRewindRing ring(3);
+    for (int64_t step = 0; step < 6; step++)
+    {
+        ring.saveSnapshot(step, makeState(20, step));
+    }
+    EXPECT_EQ(ring.numSnapshots(), 3);
+    EXPECT_EQ(ring.oldestStep(), 3);
+    EXPECT_EQ(ring.newestStep(), 5);
+
+    t_state restored;
+    EXPECT_EQ(ring.rewindTo(2, &restored), -1);
+    EXPECT_EQ(ring.rewindTo(3, &restored), 3);
+    checkStatesEqual(makeState(20, 3), restored);
+}
+
+TEST(StateRewindRingTest, HandlesChangingStateSize)
+{
+    StateRewindRing ring(4);
+    ring.saveSnapshot(0, makeState(20, 0));
+    ring.saveSnapshot(1, makeState(30, 1));
+    ring.saveSnapshot(2, makeState(30, 2));
+
+    t_state restored;
+    EXPECT_EQ(ring.rewindTo(0, &restored), 0);
+    checkStatesEqual(makeState(20, 0), restored);
+    EXPECT_EQ(ring.rewindTo(2, &restored), 2);
+    checkStatesEqual(makeState(30, 2), restored);
+}
+
+TEST(StateRewindRingTest, DeltaCompressionSavesMemory)
+{
+    StateRewindRing ring(16);
+    for (int64_t step = 0; step < 16; step++)
+    {
+        ring.saveSnapshot(step, makeState(1000, step));
+    }
+    /* With only the low-order bytes of each value changing per step,
+     * the shuffled delta chain should beat 16 verbatim snapshots
+     * clearly; in practice roughly the high half of each value is
+     * unchanged between snapshots.
+     */
+    const std::size_t verbatimSize = 16 * (1000 * 2 * sizeof(RVec));
+    EXPECT_LT(ring.memoryUsage(), 2 * verbatimSize / 3);
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
@@ -76,6 +76,7 @@
 #include "gromacs/random/tabulatednormaldistribution.h"
 #include "gromacs/random/threefry.h"
 #include "gromacs/simd/simd.h"
+#include "gromacs/simd/simd_math.h"
 #include "gromacs/timing/wallcycle.h"
 #include "gromacs/topology/atoms.h"
 #include "gromacs/utility/exceptions.h"
@@ -968,6 +969,200 @@ static void doSDUpdateGeneral(const gmx_stochd_t&  sd,
     }
 }
 
+#if GMX_HAVE_SIMD_UPDATE
+/*! \brief SD integrator update for the common case, using SIMD
+ *
+ * SIMD version of doSDUpdateGeneral() for the case without freeze and
+ * acceleration groups and with a single temperature group. Velocities
+ * of virtual sites have to be cleared before calling this; massless
+ * particles then stay put, since their inverse mass is zero, just as
+ * in updateMDLeapfrogSimpleSimd(). The Gaussian random numbers are
+ * drawn with the same counter-based generator and the same per-atom
+ * streams as in the general routine, so the noise does not depend on
+ * the number of threads or on which path is chosen, but the numbers
+ * are generated in blocks of GMX_SIMD_REAL_WIDTH atoms and all
+ * integration arithmetic is SIMD.
+ *
+ * \tparam       updateType  The type of update to perform
+ * \param[in]    sd          Stochastic dynamics parameters
+ * \param[in]    start       Index of first atom to update
+ * \param[in]    nrend       Last atom to update: \p nrend - 1
+ * \param[in]    dt          The time step
+ * \param[in]    invmass     1/mass per atom, has to be aligned and padded
+ * \param[in]    x           Input coordinates
+ * \param[inout] xprime      Updated coordinates
+ * \param[inout] v           Velocities
+ * \param[in]    f           Forces, can be nullptr when not used by \p updateType
+ * \param[in]    step        The current step
+ * \param[in]    seed        The RNG seed
+ * \param[in]    gatindex    Map from local to global atom index, can be nullptr
+ */
+template<SDUpdate updateType>
+static void doSDUpdateSimpleSimd(const gmx_stochd_t& sd,
+                                 int                 start,
+                                 int                 nrend,
+                                 real                dt,
+                                 const real* gmx_restrict invmass,
+                                 const rvec* gmx_restrict x,
+                                 rvec* gmx_restrict xprime,
+                                 rvec* gmx_restrict v,
+                                 const rvec* gmx_restrict f,
+                                 int64_t    step,
+                                 int        seed,
+                                 const int* gatindex)
+{
+    gmx::ThreeFry2x64<0>                       rng(seed, gmx::RandomDomain::UpdateCoordinates);
+    gmx::TabulatedNormalDistribution<real, 14> dist;
+
+    GMX_ASSERT(isSimdAligned(invmass), "invmass should be aligned");
+
+    const SimdReal timestep(dt);
+    const SimdReal halfTimestep(0.5 * dt);
+    const SimdReal frictionFactor(static_cast<real>(sd.sdc[0].em));
+    const SimdReal noiseSigma(sd.sdsig[0].V);
+
+    alignas(GMX_SIMD_ALIGNMENT) real gaussian[DIM * GMX_SIMD_REAL_WIDTH];
+
+    for (int a = start; a < nrend; a += GMX_SIMD_REAL_WIDTH)
+    {
+        if (updateType != SDUpdate::ForcesOnly)
+        {
+            if (gatindex == nullptr && a + GMX_SIMD_REAL_WIDTH <= nrend)
+            {
+                /* The local atom indices are the counter values, so the
+                 * whole block can be drawn in one call; the variates are
+                 * bitwise identical to the restart-per-atom pattern below.
+                 */
+                gmx::TabulatedNormalDistribution<real, 14>::generateBatch(
+                        &rng, step, a, DIM,
+                        gmx::ArrayRef<real>(gaussian, gaussian + DIM * GMX_SIMD_REAL_WIDTH));
+            }
+            else
+            {
+                /* Draw the noise with the scalar generator, restarted per
+                 * atom, so each atom gets the same stream as with
+                 * doSDUpdateGeneral(). The padding region of the last block
+                 * gets zeros; the corresponding results end up in the buffer
+                 * padding as well.
+                 */
+                for (int i = 0; i < GMX_SIMD_REAL_WIDTH; i++)
+                {
+                    int n = a + i;
+                    if (n < nrend)
+                    {
+                        rng.restart(step, gatindex ? gatindex[n] : n);
+                        dist.reset();
+                        for (int d = 0; d < DIM; d++)
+                        {
+                            gaussian[i * DIM + d] = dist(rng);
+                        }
+                    }
+                    else
+                    {
+                        for (int d = 0; d < DIM; d++)
+                        {
+                            gaussian[i * DIM + d] = 0;
+                        }
+                    }
+                }
+            }
+        }
+
+        SimdReal invMassSimd = simdLoad(invmass + a);
+
+        SimdReal v0, v1, v2;
+        simdLoadRvecs(v, a, &v0, &v1, &v2);
+
+        if (updateType == SDUpdate::ForcesOnly)
+        {
+            SimdReal invMass0, invMass1, invMass2;
+            expandScalarsToTriplets(invMassSimd, &invMass0, &invMass1, &invMass2);
+
+            SimdReal f0, f1, f2;
+            simdLoadRvecs(f, a, &f0, &f1, &f2);
+
+            v0 = fma(f0 * invMass0, timestep, v0);
+            v1 = fma(f1 * invMass1, timestep, v1);
+            v2 = fma(f2 * invMass2, timestep, v2);
+
+            simdStoreRvecs(v, a, v0, v1, v2);
+
+            SimdReal x0, x1, x2;
+            simdLoadRvecs(x, a, &x0, &x1, &x2);
+
+            SimdReal xprime0 = fma(v0, timestep, x0);
+            SimdReal xprime1 = fma(v1, timestep, x1);
+            SimdReal xprime2 = fma(v2, timestep, x2);
+
+            simdStoreRvecs(xprime, a, xprime0, xprime1, xprime2);
+        }
+        else
+        {
+            /* Massless particles have zero inverse mass,
+             * so they get zero noise as well.
+             */
+            SimdReal noise0, noise1, noise2;
+            expandScalarsToTriplets(noiseSigma * gmx::sqrt(invMassSimd), &noise0, &noise1, &noise2);
+
+            SimdReal g0 = simdLoad(gaussian + 0 * GMX_SIMD_REAL_WIDTH);
+            SimdReal g1 = simdLoad(gaussian + 1 * GMX_SIMD_REAL_WIDTH);
+            SimdReal g2 = simdLoad(gaussian + 2 * GMX_SIMD_REAL_WIDTH);
+
+            if (updateType == SDUpdate::FrictionAndNoiseOnly)
+            {
+                SimdReal vNew0 = fma(noise0, g0, frictionFactor * v0);
+                SimdReal vNew1 = fma(noise1, g1, frictionFactor * v1);
+                SimdReal vNew2 = fma(noise2, g2, frictionFactor * v2);
+
+                simdStoreRvecs(v, a, vNew0, vNew1, vNew2);
+
+                SimdReal xprime0, xprime1, xprime2;
+                simdLoadRvecs(xprime, a, &xprime0, &xprime1, &xprime2);
+
+                /* The previous phase already updated the positions with a
+                 * full v*dt term that must now be half removed.
+                 */
+                xprime0 = fma(vNew0 - v0, halfTimestep, xprime0);
+                xprime1 = fma(vNew1 - v1, halfTimestep, xprime1);
+                xprime2 = fma(vNew2 - v2, halfTimestep, xprime2);
+
+                simdStoreRvecs(xprime, a, xprime0, xprime1, xprime2);
+            }
+            else
+            {
+                SimdReal invMass0, invMass1, invMass2;
+                expandScalarsToTriplets(invMassSimd, &invMass0, &invMass1, &invMass2);
+
+                SimdReal f0, f1, f2;
+                simdLoadRvecs(f, a, &f0, &f1, &f2);
+
+                SimdReal vn0 = fma(f0 * invMass0, timestep, v0);
+                SimdReal vn1 = fma(f1 * invMass1, timestep, v1);
+                SimdReal vn2 = fma(f2 * invMass2, timestep, v2);
+
+                SimdReal vNew0 = fma(noise0, g0, frictionFactor * vn0);
+                SimdReal vNew1 = fma(noise1, g1, frictionFactor * vn1);
+                SimdReal vNew2 = fma(noise2, g2, frictionFactor * vn2);
+
+                simdStoreRvecs(v, a, vNew0, vNew1, vNew2);
+
+                SimdReal x0, x1, x2;
+                simdLoadRvecs(x, a, &x0, &x1, &x2);
+
+                /* Here we include half of the friction+noise
+                 * update of v into the position update.
+                 */
+                SimdReal xprime0 = fma(vn0 + vNew0, halfTimestep, x0);
+                SimdReal xprime1 = fma(vn1 + vNew1, halfTimestep, x1);
+                SimdReal xprime2 = fma(vn2 + vNew2, halfTimestep, x2);
+
+                simdStoreRvecs(xprime, a, xprime0, xprime1, xprime2);
+            }
+        }
+    }
+}
+#endif // GMX_HAVE_SIMD_UPDATE
+
 static void do_update_bd(int                  start,
                          int                  nrend,
                          real                 dt,
@@ -1105,35 +1300,70 @@ static void calc_ke_part_normal(ArrayRef<const RVec> v,
         }
         *dekindl_sum = 0.0;
 
-        ga = 0;
-        gt = 0;
-        for (n = start_t; n < end_t; n++)
+        if (md->cACC == nullptr && md->cTC == nullptr && md->nMassPerturbed == 0 && !ekind->bNEMD)
         {
-            if (md->cACC)
-            {
-                ga = md->cACC[n];
-            }
-            if (md->cTC)
-            {
-                gt = md->cTC[n];
-            }
-            hm = 0.5 * md->massT[n];
+            /* Common case: a single temperature group without acceleration
+             * groups or perturbed masses. The kinetic energy tensor is
+             * symmetric, so we accumulate its six unique components in
+             * local variables, which keeps the sums in registers and makes
+             * the loop only stream the masses and velocities.
+             */
+            real exx = 0, eyy = 0, ezz = 0, exy = 0, exz = 0, eyz = 0;
 
-            for (d = 0; (d < DIM); d++)
+            for (n = start_t; n < end_t; n++)
             {
-                v_corrt[d] = v[n][d] - grpstat[ga].u[d];
+                hm = 0.5 * md->massT[n];
+
+                exx += hm * v[n][XX] * v[n][XX];
+                eyy += hm * v[n][YY] * v[n][YY];
+                ezz += hm * v[n][ZZ] * v[n][ZZ];
+                exy += hm * v[n][XX] * v[n][YY];
+                exz += hm * v[n][XX] * v[n][ZZ];
+                eyz += hm * v[n][YY] * v[n][ZZ];
             }
-            for (d = 0; (d < DIM); d++)
+
+            ekin_sum[0][XX][XX] = exx;
+            ekin_sum[0][YY][YY] = eyy;
+            ekin_sum[0][ZZ][ZZ] = ezz;
+            ekin_sum[0][XX][YY] = exy;
+            ekin_sum[0][YY][XX] = exy;
+            ekin_sum[0][XX][ZZ] = exz;
+            ekin_sum[0][ZZ][XX] = exz;
+            ekin_sum[0][YY][ZZ] = eyz;
+            ekin_sum[0][ZZ][YY] = eyz;
+        }
+        else
+        {
+            ga = 0;
+            gt = 0;
+            for (n = start_t; n < end_t; n++)
             {
-                for (m = 0; (m < DIM); m++)
+                if (md->cACC)
                 {
-                    /* if we're computing a full step velocity, v_corrt[d] has v(t).  Otherwise, v(t+dt/2) */
-                    ekin_sum[gt][m][d] += hm * v_corrt[m] * v_corrt[d];
+                    ga = md->cACC[n];
+                }
+                if (md->cTC)
+                {
+                    gt = md->cTC[n];
+                }
+                hm = 0.5 * md->massT[n];
+
+                for (d = 0; (d < DIM); d++)
+                {
+                    v_corrt[d] = v[n][d] - grpstat[ga].u[d];
+                }
+                for (d = 0; (d < DIM); d++)
+                {
+                    for (m = 0; (m < DIM); m++)
+                    {
+                        /* if we're computing a full step velocity, v_corrt[d] has v(t).  Otherwise, v(t+dt/2) */
+                        ekin_sum[gt][m][d] += hm * v_corrt[m] * v_corrt[d];
+                    }
+                }
+                if (md->nMassPerturbed && md->bPerturbed[n])
+                {
+                    *dekindl_sum += 0.5 * (md->massB[n] - md->massA[n]) * iprod(v_corrt, v_corrt);
                 }
-            }
-            if (md->nMassPerturbed && md->bPerturbed[n])
-            {
-                *dekindl_sum += 0.5 * (md->massB[n] - md->massA[n]) * iprod(v_corrt, v_corrt);
             }
         }
     }
@@ -1554,11 +1784,25 @@ void update_sd_second_half(int64_t step,
                 int start_th, end_th;
                 getThreadAtomRange(nth, th, homenr, &start_th, &end_th);
 
-                doSDUpdateGeneral<SDUpdate::FrictionAndNoiseOnly>(
-                        *upd->sd(), start_th, end_th, dt, inputrec->opts.acc, inputrec->opts.nFreeze,
-                        md->invmass, md->ptype, md->cFREEZE, nullptr, md->cTC, state->x.rvec_array(),
-                        upd->xp()->rvec_array(), state->v.rvec_array(), nullptr, step, inputrec->ld_seed,
-                        DOMAINDECOMP(cr) ? cr->dd->globalAtomIndices.data() : nullptr);
+#if GMX_HAVE_SIMD_UPDATE
+                if (inputrec->opts.ngtc == 1 && md->cFREEZE == nullptr)
+                {
+                    doSDUpdateSimpleSimd<SDUpdate::FrictionAndNoiseOnly>(
+                            *upd->sd(), start_th, end_th, dt, md->invmass, state->x.rvec_array(),
+                            upd->xp()->rvec_array(), state->v.rvec_array(), nullptr, step,
+                            inputrec->ld_seed,
+                            DOMAINDECOMP(cr) ? cr->dd->globalAtomIndices.data() : nullptr);
+                }
+                else
+#endif
+                {
+                    doSDUpdateGeneral<SDUpdate::FrictionAndNoiseOnly>(
+                            *upd->sd(), start_th, end_th, dt, inputrec->opts.acc,
+                            inputrec->opts.nFreeze, md->invmass, md->ptype, md->cFREEZE, nullptr,
+                            md->cTC, state->x.rvec_array(), upd->xp()->rvec_array(),
+                            state->v.rvec_array(), nullptr, step, inputrec->ld_seed,
+                            DOMAINDECOMP(cr) ? cr->dd->globalAtomIndices.data() : nullptr);
+                }
             }
             GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
         }
@@ -1816,6 +2060,36 @@ void update_coords(int64_t           step,
                                  x_rvec, xp_rvec, v_rvec, f_rvec, state->nosehoover_vxi.data(), M);
                     break;
                 case (eiSD1):
+#if GMX_HAVE_SIMD_UPDATE
+                    /* Use the SIMD update for the common case of a single
+                     * temperature group without freeze or acceleration groups.
+                     * As for leap-frog, virtual site velocities need to be
+                     * cleared in advance; their inverse mass is zero, so the
+                     * update then leaves them in place.
+                     */
+                    if (inputrec->opts.ngtc == 1 && md->cFREEZE == nullptr && !ekind->bNEMD)
+                    {
+                        if (md->haveVsites)
+                        {
+                            clearVsiteVelocities(start_th, end_th, md->ptype, v_rvec);
+                        }
+                        if (bDoConstr)
+                        {
+                            // With constraints, the SD update is done in 2 parts
+                            doSDUpdateSimpleSimd<SDUpdate::ForcesOnly>(
+                                    *upd->sd(), start_th, end_th, dt, md->invmass, x_rvec, xp_rvec,
+                                    v_rvec, f_rvec, step, inputrec->ld_seed, nullptr);
+                        }
+                        else
+                        {
+                            doSDUpdateSimpleSimd<SDUpdate::Combined>(
+                                    *upd->sd(), start_th, end_th, dt, md->invmass, x_rvec, xp_rvec,
+                                    v_rvec, f_rvec, step, inputrec->ld_seed,
+                                    DOMAINDECOMP(cr) ? cr->dd->globalAtomIndices.data() : nullptr);
+                        }
+                        break;
+                    }
+#endif
                     if (bDoConstr)
                     {
                         // With constraints, the SD update is done in 2 parts
@@ -227,6 +227,10 @@ void calc_ke_part(gmx::ArrayRef<const gmx::RVec> x,
  * Now also computes the contribution of the kinetic energy to the
  * free energy
  *
+ * \todo This is a separate sweep over the velocities on every coupling
+ *       step. It could be folded into the integrator loop, but only for
+ *       unconstrained runs, since constraining modifies the velocities
+ *       between the update and this call.
  */
 
 
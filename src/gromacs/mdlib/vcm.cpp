@@ -182,37 +182,63 @@ void calc_vcm_grp(const t_mdatoms&               md,
                 }
             }
 
-#pragma omp for schedule(static)
-            for (int i = 0; i < md.homenr; i++)
+            if (vcm->mode != ecmANGULAR && md.cVCM == nullptr)
             {
-                int  g  = 0;
-                real m0 = md.massT[i];
-                if (md.cVCM)
-                {
-                    g = md.cVCM[i];
-                }
-                t_vcm_thread* vcm_t = &vcm->thread_vcm[t * vcm->stride + g];
-                /* Calculate linear momentum */
-                vcm_t->mass += m0;
-                int m;
-                for (m = 0; (m < DIM); m++)
+                /* Common case: linear momentum of a single group.
+                 * Accumulate in local variables, so the sums stay in
+                 * registers and the loop only streams the masses and
+                 * velocities once.
+                 */
+                real mass = 0;
+                rvec p    = { 0, 0, 0 };
+#pragma omp for schedule(static)
+                for (int i = 0; i < md.homenr; i++)
                 {
-                    vcm_t->p[m] += m0 * v[i][m];
+                    const real m0 = md.massT[i];
+                    mass += m0;
+                    for (int m = 0; (m < DIM); m++)
+                    {
+                        p[m] += m0 * v[i][m];
+                    }
                 }
-
-                if (vcm->mode == ecmANGULAR)
+                t_vcm_thread* vcm_t = &vcm->thread_vcm[t * vcm->stride];
+                vcm_t->mass         = mass;
+                copy_rvec(p, vcm_t->p);
+            }
+            else
+            {
+#pragma omp for schedule(static)
+                for (int i = 0; i < md.homenr; i++)
                 {
-                    /* Calculate angular momentum */
-                    rvec j0;
-                    cprod(x[i], v[i], j0);
-
+                    int  g  = 0;
+                    real m0 = md.massT[i];
+                    if (md.cVCM)
+                    {
+                        g = md.cVCM[i];
+                    }
+                    t_vcm_thread* vcm_t = &vcm->thread_vcm[t * vcm->stride + g];
+                    /* Calculate linear momentum */
+                    vcm_t->mass += m0;
+                    int m;
                     for (m = 0; (m < DIM); m++)
                     {
-                        vcm_t->j[m] += m0 * j0[m];
-                        vcm_t->x[m] += m0 * x[i][m];
+                        vcm_t->p[m] += m0 * v[i][m];
+                    }
+
+                    if (vcm->mode == ecmANGULAR)
+                    {
+                        /* Calculate angular momentum */
+                        rvec j0;
+                        cprod(x[i], v[i], j0);
+
+                        for (m = 0; (m < DIM); m++)
+                        {
+                            vcm_t->j[m] += m0 * j0[m];
+                            vcm_t->x[m] += m0 * x[i][m];
+                        }
+                        /* Update inertia tensor */
+                        update_tensor(x[i], m0, vcm_t->i);
                     }
-                    /* Update inertia tensor */
-                    update_tensor(x[i], m0, vcm_t->i);
                 }
             }
         }
@@ -118,7 +118,17 @@ struct t_vcm
 void reportComRemovalInfo(FILE* fp, const t_vcm& vcm);
 
 
-/* Do a per group center of mass things */
+/* Do a per group center of mass things.
+ *
+ * \todo This makes a separate pass over the masses and velocities every
+ *       nstcomm steps. Folding the accumulation into the integrator loop
+ *       would avoid that sweep, but is only correct without constraints,
+ *       since constraining modifies the velocities afterwards, and
+ *       maintaining running partial sums across steps instead would
+ *       accumulate rounding drift, which is exactly what COM removal is
+ *       there to correct. So any fusion needs to be limited to
+ *       unconstrained runs and to the steps where the sums are consumed.
+ */
 void calc_vcm_grp(const t_mdatoms&               md,
                   gmx::ArrayRef<const gmx::RVec> x,
                   gmx::ArrayRef<const gmx::RVec> v,
@@ -123,6 +123,7 @@
 #include "gromacs/modularsimulator/energyelement.h"
 #include "gromacs/nbnxm/gpu_data_mgmt.h"
 #include "gromacs/nbnxm/nbnxm.h"
+#include "gromacs/nbnxm/pairlist_tuning.h"
 #include "gromacs/pbcutil/mshift.h"
 #include "gromacs/pbcutil/pbc.h"
 #include "gromacs/pulling/output.h"
@@ -438,6 +439,12 @@ void gmx::LegacySimulator::do_md()
                          fr->nbv->useGpu());
     }
 
+    NstlistTuning* nstlistTuning = nullptr;
+    if (!mdrunOptions.reproducible)
+    {
+        nstlistTuningInit(&nstlistTuning, cr, mdlog, *ir, top_global, *fr->nbv);
+    }
+
     if (!ir->bContinuation)
     {
         if (state->flags & (1U << estV))
@@ -751,6 +758,13 @@ void gmx::LegacySimulator::do_md()
                            &bPMETunePrinting, simulationWork.useGpuPmePpCommunication);
         }
 
+        if (nstlistTuning != nullptr && bNStList)
+        {
+            /* Online nstlist tuning; waits while PME load balancing is active */
+            nstlistTuningDo(nstlistTuning, cr, mdlog, ir, fr, state->box, state->x, wcycle,
+                            step_rel, pme_loadbal_is_active(pme_loadbal));
+        }
+
         wallcycle_start(wcycle, ewcSTEP);
 
         bLastStep = (step_rel == ir->nsteps);
@@ -1670,6 +1684,8 @@ void gmx::LegacySimulator::do_md()
         pme_loadbal_done(pme_loadbal, fplog, mdlog, fr->nbv->useGpu());
     }
 
+    nstlistTuningDone(nstlistTuning);
+
     done_shellfc(fplog, shellfc, step_rel);
 
     if (useReplicaExchange && MASTER(cr))
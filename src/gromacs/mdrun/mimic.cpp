@@ -113,6 +113,7 @@
 #include "gromacs/mdtypes/mdatom.h"
 #include "gromacs/mdtypes/mdrunoptions.h"
 #include "gromacs/mdtypes/observableshistory.h"
+#include "gromacs/mdtypes/simulation_workload.h"
 #include "gromacs/mdtypes/state.h"
 #include "gromacs/mimic/communicator.h"
 #include "gromacs/mimic/utilities.h"
@@ -280,6 +281,25 @@ void gmx::LegacySimulator::do_mimic()
 
     auto mdatoms = mdAtoms->mdatoms();
 
+    const auto& simulationWork     = runScheduleWork->simulationWork;
+    const bool  useGpuForPme       = simulationWork.useGpuPme;
+    const bool  useGpuForNonbonded = simulationWork.useGpuNonbonded;
+    const bool  useGpuForBufferOps = simulationWork.useGpuBufferOps;
+
+    /* The coordinates received from the MiMiC server are stored in
+     * state->x and transferred to the GPU from there, so pin the host
+     * buffers, as in do_md(), to avoid staging copies around every
+     * transfer.
+     */
+    if (useGpuForPme || (useGpuForNonbonded && useGpuForBufferOps))
+    {
+        changePinningPolicy(&state->x, PinningPolicy::PinnedIfSupported);
+    }
+    if (useGpuForNonbonded && useGpuForBufferOps)
+    {
+        changePinningPolicy(&f, PinningPolicy::PinnedIfSupported);
+    }
+
     // NOTE: The global state is no longer used at this point.
     // But state_global is still used as temporary storage space for writing
     // the global state to file and potentially for replica exchange.
@@ -355,6 +375,15 @@ void gmx::LegacySimulator::do_mimic()
 
     const DDBalanceRegionHandler ddBalanceRegionHandler(cr);
 
+    /* Buffer for collecting the global forces to send to MiMiC,
+     * allocated once instead of at every step.
+     */
+    gmx::HostVector<gmx::RVec> fglobal;
+    if (DOMAINDECOMP(cr))
+    {
+        fglobal.resize(top_global->natoms);
+    }
+
     step     = ir->init_step;
     step_rel = 0;
 
@@ -442,42 +471,8 @@ void gmx::LegacySimulator::do_mimic()
         /* Now we have the energies and forces corresponding to the
          * coordinates at time t.
          */
-        {
-            const bool isCheckpointingStep = false;
-            const bool doRerun             = false;
-            const bool bSumEkinhOld        = false;
-            do_md_trajectory_writing(fplog, cr, nfile, fnm, step, step_rel, t, ir, state,
-                                     state_global, observablesHistory, top_global, fr, outf,
-                                     energyOutput, ekind, f, isCheckpointingStep, doRerun,
-                                     isLastStep, mdrunOptions.writeConfout, bSumEkinhOld);
-        }
-
         stopHandler->setSignal();
 
-        if (graph)
-        {
-            /* Need to unshift here */
-            unshift_self(graph, state->box, as_rvec_array(state->x.data()));
-        }
-
-        if (vsite != nullptr)
-        {
-            wallcycle_start(wcycle, ewcVSITECONSTR);
-            if (graph != nullptr)
-            {
-                shift_self(graph, state->box, as_rvec_array(state->x.data()));
-            }
-            construct_vsites(vsite, as_rvec_array(state->x.data()), ir->delta_t,
-                             as_rvec_array(state->v.data()), top.idef.iparams, top.idef.il,
-                             fr->pbcType, fr->bMolPBC, cr, state->box);
-
-            if (graph != nullptr)
-            {
-                unshift_self(graph, state->box, as_rvec_array(state->x.data()));
-            }
-            wallcycle_stop(wcycle, ewcVSITECONSTR);
-        }
-
         {
             const bool          doInterSimSignal = false;
             const bool          doIntraSimSignal = true;
@@ -497,8 +492,11 @@ void gmx::LegacySimulator::do_mimic()
                                             &shouldCheckNumberOfBondedInteractions);
         }
 
+        /* Send the energies and forces to MiMiC as soon as they are
+         * complete, so that the QM side can proceed with its part of the
+         * force calculation while we do output below.
+         */
         {
-            gmx::HostVector<gmx::RVec>     fglobal(top_global->natoms);
             gmx::ArrayRef<gmx::RVec>       ftemp;
             gmx::ArrayRef<const gmx::RVec> flocal = gmx::makeArrayRef(f);
             if (DOMAINDECOMP(cr))
@@ -518,6 +516,40 @@ void gmx::LegacySimulator::do_mimic()
             }
         }
 
+        {
+            const bool isCheckpointingStep = false;
+            const bool doRerun             = false;
+            const bool bSumEkinhOld        = false;
+            do_md_trajectory_writing(fplog, cr, nfile, fnm, step, step_rel, t, ir, state,
+                                     state_global, observablesHistory, top_global, fr, outf,
+                                     energyOutput, ekind, f, isCheckpointingStep, doRerun,
+                                     isLastStep, mdrunOptions.writeConfout, bSumEkinhOld);
+        }
+
+        if (graph)
+        {
+            /* Need to unshift here */
+            unshift_self(graph, state->box, as_rvec_array(state->x.data()));
+        }
+
+        if (vsite != nullptr)
+        {
+            wallcycle_start(wcycle, ewcVSITECONSTR);
+            if (graph != nullptr)
+            {
+                shift_self(graph, state->box, as_rvec_array(state->x.data()));
+            }
+            construct_vsites(vsite, as_rvec_array(state->x.data()), ir->delta_t,
+                             as_rvec_array(state->v.data()), top.idef.iparams, top.idef.il,
+                             fr->pbcType, fr->bMolPBC, cr, state->box);
+
+            if (graph != nullptr)
+            {
+                unshift_self(graph, state->box, as_rvec_array(state->x.data()));
+            }
+            wallcycle_stop(wcycle, ewcVSITECONSTR);
+        }
+
 
         /* Note: this is OK, but there are some numerical precision issues with using the convergence of
            the virial that should probably be addressed eventually. state->veta has better properies,
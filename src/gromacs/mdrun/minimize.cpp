@@ -106,6 +106,7 @@
 #include "gromacs/utility/cstringutil.h"
 #include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/fatalerror.h"
+#include "gromacs/utility/gmxmpi.h"
 #include "gromacs/utility/logger.h"
 #include "gromacs/utility/smalloc.h"
 
@@ -832,6 +833,14 @@ void EnergyEvaluator::run(em_state_t* ems, rvec mu_tot, tensor vir, tensor pres,
         {
             bNS = TRUE;
         }
+        if (DOMAINDECOMP(cr) && inputrec->eI == eiLBFGS)
+        {
+            /* The L-BFGS correction history is indexed by the local atom
+             * order, so the domain partition made by the first search is
+             * kept for the rest of the run.
+             */
+            bNS = FALSE;
+        }
     }
 
     if (vsite)
@@ -1666,11 +1675,6 @@ void LegacySimulator::do_lbfgs()
                     "be available in a different form in a future version of GROMACS, "
                     "e.g. gmx minimize and an .mdp option.");
 
-    if (PAR(cr))
-    {
-        gmx_fatal(FARGS, "L-BFGS minimization only supports a single rank");
-    }
-
     if (nullptr != constr)
     {
         gmx_fatal(
@@ -1679,27 +1683,11 @@ void LegacySimulator::do_lbfgs()
                 "do not use constraints, or use another minimizer (e.g. steepest descent).");
     }
 
-    n        = 3 * state_global->natoms;
     nmaxcorr = inputrec->nbfgscorr;
 
-    snew(frozen, n);
-
-    snew(p, n);
     snew(rho, nmaxcorr);
     snew(alpha, nmaxcorr);
 
-    snew(dx, nmaxcorr);
-    for (i = 0; i < nmaxcorr; i++)
-    {
-        snew(dx[i], n);
-    }
-
-    snew(dg, nmaxcorr);
-    for (i = 0; i < nmaxcorr; i++)
-    {
-        snew(dg[i], n);
-    }
-
     step  = 0;
     neval = 0;
 
@@ -1712,20 +1700,6 @@ void LegacySimulator::do_lbfgs()
     gmx::EnergyOutput energyOutput(mdoutf_get_fp_ene(outf), top_global, inputrec, pull_work, nullptr,
                                    false, StartingBehavior::NewSimulation, mdModulesNotifier);
 
-    start = 0;
-    end   = mdatoms->homenr;
-
-    /* We need 4 working states */
-    em_state_t  s0{}, s1{}, s2{}, s3{};
-    em_state_t* sa   = &s0;
-    em_state_t* sb   = &s1;
-    em_state_t* sc   = &s2;
-    em_state_t* last = &s3;
-    /* Initialize by copying the state from ems (we could skip x and f here) */
-    *sa = ems;
-    *sb = ems;
-    *sc = ems;
-
     /* Print to log file */
     print_em_start(fplog, cr, walltime_accounting, wcycle, LBFGS);
 
@@ -1734,19 +1708,6 @@ void LegacySimulator::do_lbfgs()
     /* Max number of steps */
     number_steps = inputrec->nsteps;
 
-    /* Create a 3*natoms index to tell whether each degree of freedom is frozen */
-    gf = 0;
-    for (i = start; i < end; i++)
-    {
-        if (mdatoms->cFREEZE)
-        {
-            gf = mdatoms->cFREEZE[i];
-        }
-        for (m = 0; m < DIM; m++)
-        {
-            frozen[3 * i + m] = (inputrec->opts.nFreeze[gf][m] != 0);
-        }
-    }
     if (MASTER(cr))
     {
         sp_header(stderr, LBFGS, inputrec->em_tol, number_steps);
@@ -1756,7 +1717,10 @@ void LegacySimulator::do_lbfgs()
         sp_header(fplog, LBFGS, inputrec->em_tol, number_steps);
     }
 
-    if (vsite)
+    /* With domain decomposition the energy evaluator constructs the
+     * virtual sites from the local state instead.
+     */
+    if (vsite && !DOMAINDECOMP(cr))
     {
         construct_vsites(vsite, state_global->x.rvec_array(), 1, nullptr, top.idef.iparams,
                          top.idef.il, fr->pbcType, fr->bMolPBC, cr, state_global->box);
@@ -1774,6 +1738,59 @@ void LegacySimulator::do_lbfgs()
     };
     energyEvaluator.run(&ems, mu_tot, vir, pres, -1, TRUE);
 
+    start = 0;
+    end   = mdatoms->homenr;
+
+    /* The correction history covers the degrees of freedom local to this
+     * rank; with domain decomposition the inner products over the history
+     * are summed over the ranks where needed. The local atom assignment
+     * was just made final by the first evaluation and does not change
+     * during the run, since all later force evaluations reuse the
+     * initial pair search.
+     */
+    n = 3 * end;
+
+    snew(frozen, n);
+
+    snew(p, n);
+
+    snew(dx, nmaxcorr);
+    for (i = 0; i < nmaxcorr; i++)
+    {
+        snew(dx[i], n);
+    }
+
+    snew(dg, nmaxcorr);
+    for (i = 0; i < nmaxcorr; i++)
+    {
+        snew(dg[i], n);
+    }
+
+    /* We need 4 working states */
+    em_state_t  s0{}, s1{}, s2{}, s3{};
+    em_state_t* sa   = &s0;
+    em_state_t* sb   = &s1;
+    em_state_t* sc   = &s2;
+    em_state_t* last = &s3;
+    /* Initialize by copying the state from ems (we could skip x and f here) */
+    *sa = ems;
+    *sb = ems;
+    *sc = ems;
+
+    /* Create a 3*natoms index to tell whether each degree of freedom is frozen */
+    gf = 0;
+    for (i = start; i < end; i++)
+    {
+        if (mdatoms->cFREEZE)
+        {
+            gf = mdatoms->cFREEZE[i];
+        }
+        for (m = 0; m < DIM; m++)
+        {
+            frozen[3 * i + m] = (inputrec->opts.nFreeze[gf][m] != 0);
+        }
+    }
+
     if (MASTER(cr))
     {
         /* Copy stuff to the energy bin for easy printing etc. */
@@ -1879,6 +1896,11 @@ void LegacySimulator::do_lbfgs()
         {
             gpa -= s[i] * ff[i];
         }
+        /* Sum the gradient along the line across CPUs */
+        if (PAR(cr))
+        {
+            gmx_sumd(1, &gpa, cr);
+        }
 
         /* Calculate minimum allowed stepsize along the line, before the average (norm)
          * relative change in coordinate is smaller than precision
@@ -1893,7 +1915,12 @@ void LegacySimulator::do_lbfgs()
             tmp = s[i] / tmp;
             minstep += tmp * tmp;
         }
-        minstep = GMX_REAL_EPS / sqrt(minstep / n);
+        /* Add up from all CPUs */
+        if (PAR(cr))
+        {
+            gmx_sumd(1, &minstep, cr);
+        }
+        minstep = GMX_REAL_EPS / sqrt(minstep / (3 * top_global->natoms));
 
         if (stepsize < minstep)
         {
@@ -1957,6 +1984,17 @@ void LegacySimulator::do_lbfgs()
                     maxdelta = delta;
                 }
             }
+            /* All ranks need to agree on the largest displacement, so the
+             * stepsize stays in sync.
+             */
+            if (PAR(cr))
+            {
+#if GMX_MPI
+                double buf = maxdelta;
+                MPI_Allreduce(MPI_IN_PLACE, &buf, 1, MPI_DOUBLE, MPI_MAX, cr->mpi_comm_mygroup);
+                maxdelta = buf;
+#endif
+            }
             // If any displacement is larger than the stepsize limit, reduce the step
             if (maxdelta > inputrec->em_stepsize)
             {
@@ -2167,6 +2205,15 @@ void LegacySimulator::do_lbfgs()
             dgdg += dg[point][i] * dg[point][i];
             dgdx += dg[point][i] * dx[point][i];
         }
+        /* Sum the history inner products across CPUs */
+        if (PAR(cr))
+        {
+            double buf[2] = { dgdg, dgdx };
+
+            gmx_sumd(2, buf, cr);
+            dgdg = buf[0];
+            dgdx = buf[1];
+        }
 
         diag = dgdx / dgdg;
 
@@ -2200,6 +2247,13 @@ void LegacySimulator::do_lbfgs()
             {
                 sq += dx[cp][i] * p[i];
             }
+            if (PAR(cr))
+            {
+                double buf = sq;
+
+                gmx_sumd(1, &buf, cr);
+                sq = buf;
+            }
 
             alpha[cp] = rho[cp] * sq;
 
@@ -2222,6 +2276,13 @@ void LegacySimulator::do_lbfgs()
             {
                 yr += p[i] * dg[cp][i];
             }
+            if (PAR(cr))
+            {
+                double buf = yr;
+
+                gmx_sumd(1, &buf, cr);
+                yr = buf;
+            }
 
             beta = rho[cp] * yr;
             beta = alpha[cp] - beta;
@@ -2280,7 +2341,7 @@ void LegacySimulator::do_lbfgs()
         }
 
         /* Send x and E to IMD client, if bIMD is TRUE. */
-        if (imdSession->run(step, TRUE, state_global->box, state_global->x.rvec_array(), 0) && MASTER(cr))
+        if (MASTER(cr) && imdSession->run(step, TRUE, state_global->box, state_global->x.rvec_array(), 0))
         {
             imdSession->sendPositionsAndEnergies();
         }
@@ -2335,7 +2396,7 @@ void LegacySimulator::do_lbfgs()
      * above (which we did if do_x or do_f was true).
      */
     do_x = !do_per_step(step, inputrec->nstxout);
-    do_f = !do_per_step(step, inputrec->nstfout);
+    do_f = (inputrec->nstfout > 0 && !do_per_step(step, inputrec->nstfout));
     write_em_traj(fplog, cr, outf, do_x, do_f, ftp2fn(efSTO, nfile, fnm), top_global, inputrec,
                   step, &ems, state_global, observablesHistory);
 
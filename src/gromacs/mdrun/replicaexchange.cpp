@@ -125,6 +125,8 @@ struct gmx_repl_ex
     int nst;
     //! Number of exchanges per interval
     int nex;
+    //! Whether exchange attempts communicate only between the partner replicas
+    gmx_bool bPairwiseComm;
     //! Random seed
     int seed;
     //! Number of even and odd replica change attempts
@@ -492,6 +494,34 @@ gmx_repl_ex_t init_replica_exchange(FILE*                            fplog,
         snew(re->de[i], re->nrepl);
     }
     re->nex = replExParams.numExchanges;
+
+    /* With nearest neighbor exchange, the acceptance decision for a pair
+     * only needs quantities of the two partners. By default we still use
+     * collective communication over all replicas at every attempt, which
+     * makes the whole ensemble run at the pace of the slowest replica.
+     * With this option set, an attempt only synchronizes each pair of
+     * exchange partners.
+     */
+    re->bPairwiseComm = FALSE;
+    if (getenv("GMX_REPLEX_ASYNC") != nullptr)
+    {
+        if (re->nex > 1)
+        {
+            fprintf(fplog,
+                    "\nNOTE: found env.var. GMX_REPLEX_ASYNC, but multiple exchanges per attempt "
+                    "(-nex) need information of all replicas, so it is ignored\n");
+        }
+        else
+        {
+            re->bPairwiseComm = TRUE;
+            fprintf(fplog,
+                    "\nFound env.var. GMX_REPLEX_ASYNC: exchange attempts will only communicate "
+                    "between the two exchange partners instead of over the whole ensemble.\n"
+                    "Note that the exchange and probability statistics in this log file then "
+                    "only cover the pairs this replica participated in.\n");
+        }
+    }
+
     return re;
 }
 
@@ -926,19 +956,59 @@ static void test_for_replica_exchange(FILE*                 fplog,
     }
 
     /* now actually do the communication */
-    if (bVol)
-    {
-        gmx_sum_sim(re->nrepl, re->Vol, ms);
-    }
-    if (bEpot)
+    if (re->bPairwiseComm && !bMultiEx)
     {
-        gmx_sum_sim(re->nrepl, re->Epot, ms);
+        /* Only communicate with the exchange partner of this attempt,
+         * so that a slow replica only delays its partner and not the
+         * whole ensemble. With nearest neighbor exchange each replica
+         * is part of at most one pair per attempt.
+         */
+        m = (step / re->nst) % 2;
+        for (i = 1; i < re->nrepl; i++)
+        {
+            a = re->ind[i - 1];
+            b = re->ind[i];
+            if (i % 2 == m && (re->repl == a || re->repl == b))
+            {
+                const int partner = (re->repl == a ? b : a);
+                real      buf[4];
+                buf[0] = bEpot ? re->Epot[re->repl] : 0;
+                buf[1] = bVol ? re->Vol[re->repl] : 0;
+                buf[2] = bDLambda ? re->de[a][re->repl] : 0;
+                buf[3] = bDLambda ? re->de[b][re->repl] : 0;
+                exchange_reals(ms, partner, buf, 4);
+                if (bEpot)
+                {
+                    re->Epot[partner] = buf[0];
+                }
+                if (bVol)
+                {
+                    re->Vol[partner] = buf[1];
+                }
+                if (bDLambda)
+                {
+                    re->de[a][partner] = buf[2];
+                    re->de[b][partner] = buf[3];
+                }
+            }
+        }
     }
-    if (bDLambda)
+    else
     {
-        for (i = 0; i < re->nrepl; i++)
+        if (bVol)
         {
-            gmx_sum_sim(re->nrepl, re->de[i], ms);
+            gmx_sum_sim(re->nrepl, re->Vol, ms);
+        }
+        if (bEpot)
+        {
+            gmx_sum_sim(re->nrepl, re->Epot, ms);
+        }
+        if (bDLambda)
+        {
+            for (i = 0; i < re->nrepl; i++)
+            {
+                gmx_sum_sim(re->nrepl, re->de[i], ms);
+            }
         }
     }
 
@@ -1036,8 +1106,18 @@ static void test_for_replica_exchange(FILE*                 fplog,
             b = re->ind[i];
 
             bPrint = (re->repl == a || re->repl == b);
-            if (i % 2 == m)
+            if (i % 2 == m && !(re->bPairwiseComm && !bPrint))
             {
+                if (re->bPairwiseComm)
+                {
+                    /* We did not evaluate the other pairs, so the number
+                     * of random numbers drawn before this pair is not
+                     * known here. Restart the stream with the pair index
+                     * as sub-counter, so both partners draw identical
+                     * numbers for this pair.
+                     */
+                    rng.restart(step, i);
+                }
                 delta = calc_delta(fplog, bPrint, re, a, b, a, b);
                 if (delta <= 0)
                 {
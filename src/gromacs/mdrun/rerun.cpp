@@ -47,9 +47,11 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "gromacs/awh/awh.h"
 #include "gromacs/commandline/filenm.h"
@@ -113,6 +115,7 @@
 #include "gromacs/mdtypes/mdatom.h"
 #include "gromacs/mdtypes/mdrunoptions.h"
 #include "gromacs/mdtypes/observableshistory.h"
+#include "gromacs/mdtypes/simulation_workload.h"
 #include "gromacs/mdtypes/state.h"
 #include "gromacs/mimic/utilities.h"
 #include "gromacs/pbcutil/mshift.h"
@@ -201,7 +204,8 @@ void gmx::LegacySimulator::do_rerun()
     bool                        doFreeEnergyPerturbation = false;
     unsigned int                force_flags;
     tensor                      force_vir, shake_vir, total_vir, pres;
-    t_trxstatus*                status = nullptr;
+    t_trxstatus*                status    = nullptr;
+    t_trxreadahead*             readAhead = nullptr;
     rvec                        mu_tot;
     t_trxframe                  rerun_fr;
     gmx_localtop_t              top;
@@ -355,6 +359,24 @@ void gmx::LegacySimulator::do_rerun()
 
     auto mdatoms = mdAtoms->mdatoms();
 
+    const auto& simulationWork     = runScheduleWork->simulationWork;
+    const bool  useGpuForPme       = simulationWork.useGpuPme;
+    const bool  useGpuForNonbonded = simulationWork.useGpuNonbonded;
+    const bool  useGpuForBufferOps = simulationWork.useGpuBufferOps;
+
+    /* The rerun coordinates are loaded into state->x for every frame and
+     * transferred to the GPU from there, so pin the host buffers, as in
+     * do_md(), to avoid staging copies around every transfer.
+     */
+    if (useGpuForPme || (useGpuForNonbonded && useGpuForBufferOps))
+    {
+        changePinningPolicy(&state->x, PinningPolicy::PinnedIfSupported);
+    }
+    if (useGpuForNonbonded && useGpuForBufferOps)
+    {
+        changePinningPolicy(&f, PinningPolicy::PinnedIfSupported);
+    }
+
     // NOTE: The global state is no longer used at this point.
     // But state_global is still used as temporary storage space for writing
     // the global state to file and potentially for replica exchange.
@@ -446,6 +468,22 @@ void gmx::LegacySimulator::do_rerun()
                           rerun_fr.step, rerun_fr.time);
             }
         }
+
+        /* With closely spaced frames, decoding the trajectory is a
+         * significant part of the cost of a rerun, so upcoming frames are
+         * decoded on a reader thread while the forces for the frames
+         * already delivered are computed. GMX_RERUN_READAHEAD sets the
+         * number of frames read ahead; 0 disables the reader thread.
+         */
+        int readAheadDepth = 4;
+        if (const char* env = getenv("GMX_RERUN_READAHEAD"))
+        {
+            readAheadDepth = std::atoi(env);
+        }
+        if (!isLastStep && readAheadDepth > 0)
+        {
+            readAhead = start_trx_readahead(oenv, status, &rerun_fr, readAheadDepth);
+        }
     }
 
     GMX_LOG(mdlog.info)
@@ -467,6 +505,22 @@ void gmx::LegacySimulator::do_rerun()
         calc_shifts(rerun_fr.box, fr->shift_vec);
     }
 
+    /* When frames are closely spaced, the pair list built for an earlier
+     * frame is still valid when no atom has moved further than half of
+     * the Verlet buffer since the search and the box is unchanged, in
+     * which case the search can be skipped without affecting the result.
+     * With domain decomposition every frame repartitions from the master
+     * state, which requires a fresh search.
+     */
+    const real maxInteractionCutoff = std::max(fr->ic->rcoulomb, fr->ic->rvdw);
+    const real halfListBuffer       = 0.5 * (fr->rlist - maxInteractionCutoff);
+    const bool canReusePairlist =
+            (!DOMAINDECOMP(cr) && shellfc == nullptr && graph == nullptr && halfListBuffer > 0);
+    std::vector<gmx::RVec> xLastSearch;
+    matrix                 boxLastSearch;
+    int64_t                numListReuses = 0;
+    clear_mat(boxLastSearch);
+
     auto stopHandler = stopHandlerBuilder->getStopHandlerMD(
             compat::not_null<SimulationSignal*>(&signals[eglsSTOPCOND]), false, MASTER(cr),
             ir->nstlist, mdrunOptions.reproducible, nstglobalcomm, mdrunOptions.maximumHoursToRun,
@@ -545,6 +599,23 @@ void gmx::LegacySimulator::do_rerun()
                        | (GMX_GPU ? GMX_FORCE_VIRIAL : 0) | // TODO: Get rid of this once #2649 is solved
                        GMX_FORCE_ENERGY | (doFreeEnergyPerturbation ? GMX_FORCE_DHDL : 0));
 
+        bool doPairSearch = true;
+        if (canReusePairlist && !xLastSearch.empty())
+        {
+            real maxDistanceSquared = 0;
+            auto x                  = makeConstArrayRef(state->x);
+            for (int i = 0; i < state->natoms; i++)
+            {
+                maxDistanceSquared = std::max(maxDistanceSquared, norm2(x[i] - xLastSearch[i]));
+            }
+            if (maxDistanceSquared < gmx::square(halfListBuffer)
+                && std::memcmp(state->box, boxLastSearch, sizeof(matrix)) == 0)
+            {
+                doPairSearch = false;
+                numListReuses++;
+            }
+        }
+
         if (shellfc)
         {
             /* Now is the time to relax the shells */
@@ -567,8 +638,18 @@ void gmx::LegacySimulator::do_rerun()
             do_force(fplog, cr, ms, ir, awh, enforcedRotation, imdSession, pull_work, step, nrnb,
                      wcycle, &top, state->box, state->x.arrayRefWithPadding(), &state->hist,
                      f.arrayRefWithPadding(), force_vir, mdatoms, enerd, fcd, state->lambda, graph,
-                     fr, runScheduleWork, vsite, mu_tot, t, ed, GMX_FORCE_NS | force_flags,
-                     ddBalanceRegionHandler);
+                     fr, runScheduleWork, vsite, mu_tot, t, ed,
+                     (doPairSearch ? GMX_FORCE_NS : 0) | force_flags, ddBalanceRegionHandler);
+        }
+
+        if (canReusePairlist && doPairSearch)
+        {
+            /* The search put the atoms in the box, so the displacement
+             * check compares against the coordinates as used for the list.
+             */
+            auto x = makeConstArrayRef(state->x);
+            xLastSearch.assign(x.begin(), x.begin() + state->natoms);
+            copy_mat(state->box, boxLastSearch);
         }
 
         /* Now we have the energies and forces corresponding to the
@@ -692,7 +773,14 @@ void gmx::LegacySimulator::do_rerun()
         if (MASTER(cr))
         {
             /* read next frame from input trajectory */
-            isLastStep = !read_next_frame(oenv, status, &rerun_fr);
+            if (readAhead != nullptr)
+            {
+                isLastStep = !read_next_frame_readahead(readAhead, &rerun_fr);
+            }
+            else
+            {
+                isLastStep = !read_next_frame(oenv, status, &rerun_fr);
+            }
         }
 
         if (PAR(cr))
@@ -715,6 +803,15 @@ void gmx::LegacySimulator::do_rerun()
     }
     /* End of main MD loop */
 
+    if (canReusePairlist && MASTER(cr))
+    {
+        GMX_LOG(mdlog.info)
+                .asParagraph()
+                .appendTextFormatted("Rerun reused the pair list for %" PRId64 " of %" PRId64
+                                     " frames based on the displacement since the last search.",
+                                     numListReuses, step_rel + 1);
+    }
+
     /* Closing TNG files can include compressing data. Therefore it is good to do that
      * before stopping the time measurements. */
     mdoutf_tng_close(outf);
@@ -724,6 +821,10 @@ void gmx::LegacySimulator::do_rerun()
 
     if (MASTER(cr))
     {
+        if (readAhead != nullptr)
+        {
+            done_trx_readahead(readAhead);
+        }
         close_trx(status);
     }
 
@@ -55,6 +55,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "gromacs/commandline/filenm.h"
 #include "gromacs/domdec/builder.h"
@@ -139,6 +141,7 @@
 #include "gromacs/taskassignment/taskassignment.h"
 #include "gromacs/taskassignment/usergpuids.h"
 #include "gromacs/timing/gpu_timing.h"
+#include "gromacs/timing/mpi_profile.h"
 #include "gromacs/timing/wallcycle.h"
 #include "gromacs/timing/wallcyclereporting.h"
 #include "gromacs/topology/mtop_util.h"
@@ -584,6 +587,50 @@ static TaskTarget findTaskTarget(const char* optionString)
     return returnValue;
 }
 
+/*! \brief Collects wall times of the mdrun setup phases for reporting
+ *
+ * Short jobs in large ensembles can lose several percent of their
+ * allocation to the serial setup before the first MD step. This report
+ * shows in the log where that time is spent, so regressions and
+ * system-specific setup costs can be identified without a profiler.
+ */
+class SetupTimeReport
+{
+public:
+    SetupTimeReport() : startTime_(gmx_gettime()), phaseStartTime_(startTime_) {}
+
+    //! Ends the current setup phase, reported under \p name
+    void finishPhase(const char* name)
+    {
+        const double now = gmx_gettime();
+
+        phases_.emplace_back(name, now - phaseStartTime_);
+        phaseStartTime_ = now;
+    }
+
+    //! Writes the setup timings to the log
+    void report(const MDLogger& mdlog)
+    {
+        const double total = gmx_gettime() - startTime_;
+
+        GMX_LOG(mdlog.info)
+                .asParagraph()
+                .appendTextFormatted("mdrun setup took %.1f s before the first MD step:", total);
+        for (const auto& phase : phases_)
+        {
+            GMX_LOG(mdlog.info).appendTextFormatted("    %-46s %6.1f s", phase.first, phase.second);
+        }
+    }
+
+private:
+    //! Time at which the setup started
+    double startTime_;
+    //! Time at which the current phase started
+    double phaseStartTime_;
+    //! Names and durations of the finished phases
+    std::vector<std::pair<const char*, double>> phases_;
+};
+
 //! Finish run, aggregate data to print performance info.
 static void finish_run(FILE*                     fplog,
                        const gmx::MDLogger&      mdlog,
@@ -694,6 +741,11 @@ static void finish_run(FILE*                     fplog,
                         elapsed_time_over_all_ranks, wcycle, cycle_sum, nbnxn_gpu_timings,
                         &pme_gpu_timings);
 
+        if (fplog)
+        {
+            print_flop_efficiency(fplog, nrnb_tot, mflop, cycle_sum[ewcRUN], cycle_sum[ewcFORCE]);
+        }
+
         if (EI_DYNAMICS(inputrec->eI))
         {
             delta_t = inputrec->delta_t;
@@ -712,6 +764,14 @@ static void finish_run(FILE*                     fplog,
                        delta_t, nbfs, mflop);
         }
     }
+
+    if (mpi_profile_enabled())
+    {
+        /* This involves a reduction over all ranks of the simulation,
+         * so all ranks need to make the call; only the master prints.
+         */
+        mpi_profile_print(printReport ? fplog : nullptr, cr, elapsed_time_over_all_ranks);
+    }
 }
 
 int Mdrunner::mdrunner()
@@ -765,6 +825,8 @@ int Mdrunner::mdrunner()
     gmx::LoggerOwner logOwner(buildLogger(fplog, isSimulationMasterRank));
     gmx::MDLogger    mdlog(logOwner.logger());
 
+    SetupTimeReport setupTimeReport;
+
     // TODO The thread-MPI master rank makes a working
     // PhysicalNodeCommunicator here, but it gets rebuilt by all ranks
     // after the threads have been launched. This works because no use
@@ -783,6 +845,8 @@ int Mdrunner::mdrunner()
     // Print citation requests after all software/hardware printing
     pleaseCiteGromacs(fplog);
 
+    setupTimeReport.finishPhase("Hardware detection");
+
     // TODO Replace this by unique_ptr once t_inputrec is C++
     t_inputrec               inputrecInstance;
     t_inputrec*              inputrec = nullptr;
@@ -862,6 +926,8 @@ int Mdrunner::mdrunner()
     GMX_RELEASE_ASSERT(inputrec != nullptr, "All ranks should have a valid inputrec now");
     partialDeserializedTpr.reset(nullptr);
 
+    setupTimeReport.finishPhase("Reading and distributing the run input");
+
     // Now the number of ranks is known to all ranks, and each knows
     // the inputrec read by the master rank. The ranks can now all run
     // the task-deciding functions and will agree on the result
@@ -1172,6 +1238,8 @@ int Mdrunner::mdrunner()
         // Note that local state still does not exist yet.
     }
 
+    setupTimeReport.finishPhase("Task assignment and domain decomposition setup");
+
     // The GPU update is decided here because we need to know whether the constraints or
     // SETTLEs can span accross the domain borders (i.e. whether or not update groups are
     // defined). This is only known after DD is initialized, hence decision on using GPU
@@ -1354,6 +1422,13 @@ int Mdrunner::mdrunner()
                                         &mtop, box, wcycle);
         if (useGpuForBonded)
         {
+            /* The bonded kernels accumulate into the nonbonded module's
+             * device force and shift-force buffers, so they share a
+             * nonbonded stream: the in-stream ordering with respect to
+             * clearing and consuming those buffers is the data
+             * dependency. With domain decomposition the (higher
+             * priority) non-local stream is used, so that the bonded
+             * work overlaps with the local nonbonded kernel. */
             auto stream = havePPDomainDecomposition(cr)
                                   ? Nbnxm::gpu_get_command_stream(
                                             fr->nbv->gpu_nbv, gmx::InteractionLocality::NonLocal)
@@ -1427,6 +1502,8 @@ int Mdrunner::mdrunner()
                "Double-checking that only PME-only ranks have no forcerec");
     gmx_pme_t*& pmedata = fr ? fr->pmedata : sepPmeData;
 
+    setupTimeReport.finishPhase("Force record and nonbonded setup");
+
     // TODO should live in ewald module once its testing is improved
     //
     // Later, this program could contain kernels that might be later
@@ -1470,6 +1547,7 @@ int Mdrunner::mdrunner()
         }
     }
 
+    setupTimeReport.finishPhase("PME initialization");
 
     if (EI_DYNAMICS(inputrec->eI))
     {
@@ -1551,7 +1629,8 @@ int Mdrunner::mdrunner()
 
         const bool inputIsCompatibleWithModularSimulator = ModularSimulator::isInputCompatible(
                 false, inputrec, doRerun, vsite.get(), ms, replExParams, fcd,
-                static_cast<int>(filenames.size()), filenames.data(), &observablesHistory, membed);
+                static_cast<int>(filenames.size()), filenames.data(), &observablesHistory, membed,
+                useGpuForUpdate);
 
         const bool useModularSimulator = inputIsCompatibleWithModularSimulator
                                          && !(getenv("GMX_DISABLE_MODULAR_SIMULATOR") != nullptr);
@@ -1604,6 +1683,9 @@ int Mdrunner::mdrunner()
                 pull_work, swap, &mtop, fcd, globalState.get(), &observablesHistory, mdAtoms.get(),
                 &nrnb, wcycle, fr, &enerd, &ekind, &runScheduleWork, replExParams, membed,
                 walltime_accounting, std::move(stopHandlerBuilder_), doRerun);
+        setupTimeReport.finishPhase("Remaining simulation setup");
+        setupTimeReport.report(mdlog);
+
         simulator->run();
 
         if (fr->pmePpCommGpu)
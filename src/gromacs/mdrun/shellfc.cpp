@@ -654,42 +654,37 @@ static void shell_pos_sd(ArrayRef<const RVec> xcur,
 {
     const real step_scale_min = 0.8, step_scale_increment = 0.2, step_scale_max = 1.2,
                step_scale_multiple = (step_scale_max - step_scale_min) / step_scale_increment;
-    int        d;
-    real       dx, df, k_est;
-    const real zero = 0;
-#ifdef PRINT_STEP
-    real step_min, step_max;
+    const real zero                = 0;
 
-    step_min = 1e30;
-    step_max = 0;
-#endif
-    for (t_shell& shell : shells)
+    /* The shells are independent, so this loop, which runs every inner
+     * relaxation iteration, can be parallelized over threads.
+     */
+    const int nthreads = gmx_omp_nthreads_get(emntDefault);
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+    for (int s = 0; s < shells.ssize(); s++)
     {
-        const int ind = shell.shellIndex;
+        t_shell&  shell = shells[s];
+        const int ind   = shell.shellIndex;
         if (count == 1)
         {
-            for (d = 0; d < DIM; d++)
+            for (int d = 0; d < DIM; d++)
             {
                 shell.step[d] = shell.k_1;
-#ifdef PRINT_STEP
-                step_min = std::min(step_min, shell.step[d]);
-                step_max = std::max(step_max, shell.step[d]);
-#endif
             }
         }
         else
         {
-            for (d = 0; d < DIM; d++)
+            for (int d = 0; d < DIM; d++)
             {
-                dx = xcur[ind][d] - shell.xold[d];
-                df = f[ind][d] - shell.fold[d];
+                real dx = xcur[ind][d] - shell.xold[d];
+                real df = f[ind][d] - shell.fold[d];
                 /* -dx/df gets used to generate an interpolated value, but would
                  * cause a NaN if df were binary-equal to zero. Values close to
                  * zero won't cause problems (because of the min() and max()), so
                  * just testing for binary inequality is OK. */
                 if (zero != df)
                 {
-                    k_est = -dx / df;
+                    real k_est = -dx / df;
                     /* Scale the step size by a factor interpolated from
                      * step_scale_min to step_scale_max, as k_est goes from 0 to
                      * step_scale_multiple * shell.step[d] */
@@ -711,10 +706,6 @@ static void shell_pos_sd(ArrayRef<const RVec> xcur,
                         shell.step[d] *= step_scale_max;
                     }
                 }
-#ifdef PRINT_STEP
-                step_min = std::min(step_min, shell.step[d]);
-                step_max = std::max(step_max, shell.step[d]);
-#endif
             }
         }
         copy_rvec(xcur[ind], shell.xold);
@@ -732,6 +723,15 @@ static void shell_pos_sd(ArrayRef<const RVec> xcur,
         }
     }
 #ifdef PRINT_STEP
+    real step_min = 1e30, step_max = 0;
+    for (const t_shell& shell : shells)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            step_min = std::min(step_min, shell.step[d]);
+            step_max = std::max(step_max, shell.step[d]);
+        }
+    }
     printf("step %.3e %.3e\n", step_min, step_max);
 #endif
 }
@@ -770,11 +770,16 @@ static real rms_force(const t_commrec*        cr,
     double      buf[4];
     const rvec* f = as_rvec_array(force.data());
 
-    buf[0] = *sf_dir;
-    for (const t_shell& shell : shells)
+    double sumForce2 = 0;
+
+    const int nthreads = gmx_omp_nthreads_get(emntDefault);
+#pragma omp parallel for num_threads(nthreads) schedule(static) reduction(+ : sumForce2)
+    for (int s = 0; s < shells.ssize(); s++)
     {
-        buf[0] += norm2(f[shell.shellIndex]);
+        sumForce2 += norm2(f[shells[s].shellIndex]);
     }
+
+    buf[0] = *sf_dir + sumForce2;
     int ntot = shells.ssize();
 
     if (PAR(cr))
@@ -78,7 +78,15 @@ gmx_shellfc_t* init_shell_flexcon(FILE*             fplog,
                                   int               nstcalcenergy,
                                   bool              usingDomainDecomposition);
 
-/* Optimize shell positions */
+/* Optimize shell positions
+ *
+ * \todo Each inner iteration does the shell position update and the
+ *       convergence check on the host, which forces a GPU sync per
+ *       iteration when the forces are computed on a GPU. Moving the
+ *       update and the force-norm reduction onto the device would let
+ *       the iterations launch back-to-back, but needs device-resident
+ *       shell parameters and an asynchronous convergence signal.
+ */
 void relax_shell_flexcon(FILE*                               log,
                          const t_commrec*                    cr,
                          const gmx_multisim_t*               ms,
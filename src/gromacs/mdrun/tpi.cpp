@@ -67,6 +67,7 @@
 #include "gromacs/math/vec.h"
 #include "gromacs/mdlib/constr.h"
 #include "gromacs/mdlib/dispersioncorrection.h"
+#include "gromacs/mdlib/enerdata_utils.h"
 #include "gromacs/mdlib/energyoutput.h"
 #include "gromacs/mdlib/force.h"
 #include "gromacs/mdlib/force_flags.h"
@@ -84,6 +85,7 @@
 #include "gromacs/mdtypes/md_enums.h"
 #include "gromacs/mdtypes/mdatom.h"
 #include "gromacs/mdtypes/mdrunoptions.h"
+#include "gromacs/mdtypes/simulation_workload.h"
 #include "gromacs/mdtypes/state.h"
 #include "gromacs/nbnxm/nbnxm.h"
 #include "gromacs/pbcutil/pbc.h"
@@ -455,6 +457,35 @@ void LegacySimulator::do_tpi()
     }
     snew(sum_UgembU, nener);
 
+    /* The TPI pair list only holds pairs of the inserted molecule with
+     * the rest of the system. When all energy terms that depend on the
+     * insertion position are produced by the short-ranged non-bonded
+     * kernel, all insertions that reuse a pair list can be evaluated by
+     * dispatching that kernel directly on the cached list. This avoids
+     * the coordinate conversion and force reduction over the whole
+     * system, as well as the reciprocal-space calculation, for every
+     * trial position. With a charged molecule and full electrostatics
+     * the reciprocal-space energy depends on the insertion position,
+     * so there we need the complete force calculation for every trial.
+     */
+    const bool bDispatchKernelDirectly =
+            (!fr->nbv->useGpu() && inputrec->efep == efepNO
+             && !(bCharge && EEL_FULL(fr->ic->eeltype)) && !EVDW_PME(fr->ic->vdwtype));
+    StepWorkload insertionWork;
+    insertionWork.computeNonbondedForces = true;
+    insertionWork.computeForces          = true;
+    insertionWork.computeEnergy          = true;
+    /* The energy terms that do not depend on the insertion position,
+     * cached at the last full force calculation.
+     */
+    real insertionIndependentEnergy = 0;
+    if (fplog && bDispatchKernelDirectly)
+    {
+        fprintf(fplog,
+                "Insertions that reuse a pair list are evaluated with the non-bonded kernel "
+                "only\n");
+    }
+
     /* Copy the random seed set by the user */
     seed = inputrec->ld_seed;
 
@@ -655,6 +686,8 @@ void LegacySimulator::do_tpi()
                 }
             }
 
+            const bool bRebuiltPairlist = (bNS != FALSE);
+
             if (bNS)
             {
                 for (int a = a_tp0; a < a_tp1; a++)
@@ -745,12 +778,47 @@ void LegacySimulator::do_tpi()
             // might raise, then restore the old behaviour.
             std::fenv_t floatingPointEnvironment;
             std::feholdexcept(&floatingPointEnvironment);
-            do_force(fplog, cr, ms, inputrec, nullptr, nullptr, imdSession, pull_work, step, nrnb,
-                     wcycle, &top, state_global->box, state_global->x.arrayRefWithPadding(),
-                     &state_global->hist, f.arrayRefWithPadding(), force_vir, mdatoms, enerd, fcd,
-                     state_global->lambda, nullptr, fr, runScheduleWork, nullptr, mu_tot, t, nullptr,
-                     GMX_FORCE_NONBONDED | GMX_FORCE_ENERGY | (bStateChanged ? GMX_FORCE_STATECHANGED : 0),
-                     DDBalanceRegionHandler(nullptr));
+            if (!bDispatchKernelDirectly || bRebuiltPairlist)
+            {
+                do_force(fplog, cr, ms, inputrec, nullptr, nullptr, imdSession, pull_work, step, nrnb,
+                         wcycle, &top, state_global->box, state_global->x.arrayRefWithPadding(),
+                         &state_global->hist, f.arrayRefWithPadding(), force_vir, mdatoms, enerd, fcd,
+                         state_global->lambda, nullptr, fr, runScheduleWork, nullptr, mu_tot, t, nullptr,
+                         GMX_FORCE_NONBONDED | GMX_FORCE_ENERGY | (bStateChanged ? GMX_FORCE_STATECHANGED : 0),
+                         DDBalanceRegionHandler(nullptr));
+                if (bDispatchKernelDirectly)
+                {
+                    /* Everything that the short-ranged kernel did not
+                     * produce is independent of the insertion position
+                     * and is reused until the next pair search.
+                     */
+                    insertionIndependentEnergy =
+                            enerd->term[F_EPOT]
+                            - (enerd->term[F_LJ] + enerd->term[F_BHAM] + enerd->term[F_COUL_SR]);
+                }
+            }
+            else
+            {
+                /* This trial position reuses the pair list, so only the
+                 * short-ranged interactions of the inserted molecule with
+                 * the system change and we can dispatch the non-bonded
+                 * kernel directly on the cached list.
+                 */
+                wallcycle_start(wcycle, ewcFORCE);
+                reset_enerdata(enerd);
+                if (fr->nbv->isDynamicPruningStepCpu(step))
+                {
+                    fr->nbv->dispatchPruneKernelCpu(InteractionLocality::Local, fr->shift_vec, step);
+                }
+                /* We do not use the forces, so we pass enbvClearFNo to
+                 * avoid clearing the whole force buffer for each trial.
+                 */
+                fr->nbv->dispatchNonbondedKernel(InteractionLocality::Local, *fr->ic, insertionWork,
+                                                 enbvClearFNo, *fr, enerd, nrnb);
+                sum_epot(&enerd->grpp, enerd->term);
+                enerd->term[F_EPOT] += insertionIndependentEnergy;
+                wallcycle_stop(wcycle, ewcFORCE);
+            }
             std::feclearexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW);
             std::feupdateenv(&floatingPointEnvironment);
 
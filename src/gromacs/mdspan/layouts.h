@@ -76,7 +76,7 @@
  * Questions? Contact Christian R. Trott (crtrott@sandia.gov)
  */
 /*! \libinternal \file
- * \brief Declares gmx::layout_right for mdspan.
+ * \brief Declares gmx::layout_right and gmx::layout_tiled_3d for mdspan.
  *
  * \author David Hollman <dshollm@sandia.gov>
  * \author Christian Blau <cblau@gwdg.de>
@@ -220,5 +220,133 @@ public:
 
 }; // class layout_right
 
+/*! \libinternal \brief Blocked three-dimensional array layout indexer.
+ *
+ * Maps rank-three indices so that data is stored as right-aligned bricks of
+ * BlockX x BlockY x BlockZ elements, with the bricks themselves arranged in
+ * right-aligned order. Sweeps over spatially compact regions, like the
+ * spreading and gathering loops on density and PME grids, then touch
+ * contiguous memory one brick at a time instead of strided rows, which makes
+ * them cache-tile-friendly without hand-rolled index math in every module.
+ *
+ * Extents that are not multiples of the block size are padded up to complete
+ * bricks, so the mapping is unique but not contiguous in that case, and
+ * required_span_size() must be used to size the underlying buffer.
+ *
+ * \tparam BlockX Brick extent along the slowest dimension.
+ * \tparam BlockY Brick extent along the middle dimension.
+ * \tparam BlockZ Brick extent along the fastest dimension.
+ */
+template<ptrdiff_t BlockX, ptrdiff_t BlockY, ptrdiff_t BlockZ>
+class layout_tiled_3d
+{
+    static_assert(BlockX > 0 && BlockY > 0 && BlockZ > 0, "Block extents must be positive");
+
+public:
+    /*! \libinternal \brief Mapping from multidimensional indices within extents to 1D index.
+     * \tparam Extents the extents of the multidimensional integers for the mapping.
+     */
+    template<class Extents>
+    class mapping
+    {
+        static_assert(Extents::rank() == 3, "layout_tiled_3d requires rank-three extents");
+
+    private:
+        //! The extents.
+        Extents m_extents;
+
+    public:
+        //! exposing the type of indices
+        using index_type = ptrdiff_t;
+        //! exposing the type of the extents
+        using extents_type = Extents;
+        //! Default constructor.
+        constexpr mapping() noexcept = default;
+        //! Default move constructor.
+        constexpr mapping(mapping&&) noexcept = default;
+        //! Default copy constructor.
+        constexpr mapping(const mapping&) noexcept = default;
+        //! Default move assignment
+        mapping& operator=(mapping&&) noexcept = default;
+        //! Default copy assignment
+        mapping& operator=(const mapping&) noexcept = default;
+        /*! \brief Construct mapping, setting extents
+         * \param[in] ext the extents
+         */
+        constexpr mapping(const Extents& ext) noexcept : m_extents(ext) {}
+        /*! \brief Return the extents.
+         * \returns extents
+         */
+        constexpr const Extents& extents() const noexcept { return m_extents; }
+
+    private:
+        /*! \brief Return the number of bricks along dimension r.
+         * \param[in] r the dimension to query
+         * \returns number of (possibly partially filled) bricks
+         */
+        constexpr index_type numBlocks(const size_t r) const noexcept
+        {
+            return (m_extents.extent(r) + blockExtent(r) - 1) / blockExtent(r);
+        }
+        /*! \brief Return the brick extent along dimension r.
+         * \param[in] r the dimension to query
+         * \returns the brick extent
+         */
+        static constexpr index_type blockExtent(const size_t r) noexcept
+        {
+            return (r == 0) ? BlockX : (r == 1) ? BlockY : BlockZ;
+        }
+
+    public:
+        /*! \brief Return the size of the underlying one-dimensional
+         * data structure, so that the mapping is always valid.
+         *
+         * Note that this includes the padding up to complete bricks.
+         *
+         * \returns number of span elements
+         */
+        constexpr index_type required_span_size() const noexcept
+        {
+            return numBlocks(0) * numBlocks(1) * numBlocks(2) * BlockX * BlockY * BlockZ;
+        }
+
+        /*! \brief Map the multidimensional indices to 1D.
+         * \param[in] x index along the slowest dimension
+         * \param[in] y index along the middle dimension
+         * \param[in] z index along the fastest dimension
+         * \returns One-dimensional integer index.
+         */
+        constexpr index_type operator()(const index_type x, const index_type y, const index_type z) const
+                noexcept
+        {
+            return ((x / BlockX * numBlocks(1) + y / BlockY) * numBlocks(2) + z / BlockZ)
+                           * (BlockX * BlockY * BlockZ)
+                   + ((x % BlockX) * BlockY + y % BlockY) * BlockZ + z % BlockZ;
+        }
+
+        //! Report that this mapping is always unique.
+        static constexpr bool is_always_unique() noexcept { return true; }
+        //! Report that this mapping is not always contiguous due to brick padding.
+        static constexpr bool is_always_contiguous() noexcept { return false; }
+        //! Report that this mapping is not strided.
+        static constexpr bool is_always_strided() noexcept { return false; }
+
+        //! Report that this mapping is unique.
+        constexpr bool is_unique() const noexcept { return true; }
+        /*! \brief Report whether this mapping is contiguous.
+         * \returns true when all extents are multiples of the brick extents.
+         */
+        constexpr bool is_contiguous() const noexcept
+        {
+            return m_extents.extent(0) % BlockX == 0 && m_extents.extent(1) % BlockY == 0
+                   && m_extents.extent(2) % BlockZ == 0;
+        }
+        //! Report that this mapping is not strided.
+        constexpr bool is_strided() const noexcept { return false; }
+
+    }; // class mapping
+
+}; // class layout_tiled_3d
+
 } // namespace gmx
 #endif /* end of include guard: MDSPAN_LAYOUTS_H */
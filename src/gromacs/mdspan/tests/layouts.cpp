@@ -43,6 +43,9 @@
 
 #include "gromacs/mdspan/layouts.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "gromacs/mdspan/extents.h"
@@ -157,4 +160,57 @@ TEST(LayoutTests, LayoutRightOperator)
     test.check_operator(0, 0, 0, 0, 0, 0);
 }
 
+TEST(LayoutTests, LayoutTiled3DProperties)
+{
+    LayoutTests<layout_tiled_3d<4, 4, 4>, 8, dynamic_extent, 4> test(6);
+
+    test.check_rank(3);
+    test.check_extents(8, 6, 4);
+    // 8x6x4 extents need 2x2x1 bricks of 64 elements each
+    test.check_required_span_size(256);
+    // Padding along the middle dimension makes this mapping non-contiguous
+    test.check_properties(true, false, false, true, false, false);
+}
+
+TEST(LayoutTests, LayoutTiled3DOperator)
+{
+    LayoutTests<layout_tiled_3d<4, 4, 4>, 8, 8, 8> test;
+
+    // First element of the first brick
+    test.check_operator(0, 0, 0, 0);
+    // Within one brick the layout is right-aligned
+    test.check_operator(1, 0, 0, 1);
+    test.check_operator(4, 0, 1, 0);
+    test.check_operator(16, 1, 0, 0);
+    // Crossing a brick boundary jumps a whole brick
+    test.check_operator(64, 0, 0, 4);
+    test.check_operator(128, 0, 4, 0);
+    test.check_operator(256, 4, 0, 0);
+    test.check_operator(7 * 64 + 63, 7, 7, 7);
+}
+
+TEST(LayoutTests, LayoutTiled3DIsUnique)
+{
+    // Exhaustively check that no two indices map to the same offset for
+    // extents that are not multiples of the brick size
+    using Mapping = layout_tiled_3d<4, 4, 4>::mapping<extents<5, 6, 7>>;
+    Mapping mapping;
+
+    std::vector<int> hits(mapping.required_span_size(), 0);
+    for (ptrdiff_t x = 0; x < 5; x++)
+    {
+        for (ptrdiff_t y = 0; y < 6; y++)
+        {
+            for (ptrdiff_t z = 0; z < 7; z++)
+            {
+                ptrdiff_t offset = mapping(x, y, z);
+                ASSERT_GE(offset, 0);
+                ASSERT_LT(offset, mapping.required_span_size());
+                hits[offset]++;
+            }
+        }
+    }
+    EXPECT_EQ(*std::max_element(hits.begin(), hits.end()), 1);
+}
+
 } // namespace gmx
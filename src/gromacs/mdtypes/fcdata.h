@@ -43,6 +43,11 @@
 #include "gromacs/utility/basedefinitions.h"
 #include "gromacs/utility/real.h"
 
+namespace gmx
+{
+class CubicSplineTable;
+}
+
 typedef real rvec5[5];
 
 /* Distance restraining stuff */
@@ -68,6 +73,9 @@ typedef struct t_disresdata
     real* Rt_6;            /* The instantaneous ensemble averaged r^-6 (nres)  */
     real* Rtav_6;          /* The time and ensemble averaged r^-6 (nres)       */
     int   nsystems;        /* The number of systems for ensemble averaging     */
+    int   nthreads;        /* The number of threads used in calc_disres_R_6    */
+    real* Rt_6_thread;     /* Per-thread partial sums of Rt_6 and Rtav_6       *
+                            * (nthreads x 2 x nres)                            */
 
     /* TODO: Implement a proper solution for parallel disre indexing */
     const t_iatom* forceatomsStart; /* Pointer to the start of the disre forceatoms */
@@ -104,6 +112,8 @@ typedef struct t_oriresdata
     real*        otav;          /* The calculated time and ensemble averaged orient.  */
     real         rmsdev;        /* The weighted (using kfac) RMS deviation            */
     OriresMatEq* tmpEq;         /* An temporary array of matrix + rhs                 */
+    int          nthreads;      /* The number of threads used in calc_orires_dev      */
+    OriresMatEq* tmpEqThread;   /* Per-thread partial sums of tmpEq (nthreads x nex)  */
     real*        eig;           /* Eigenvalues/vectors, for output only (nex x 12)    */
 
     /* variables for diagonalization with diagonalize_orires_tensors()*/
@@ -117,6 +127,11 @@ typedef struct bondedtable_t
     int   n;     /* n+1 is the number of points */
     real  scale; /* distance between two points */
     real* data;  /* the actual table data, per point there are 4 numbers */
+    /* Spline table for batched evaluation; only set for distance-based
+     * tables and only when the input table is fine enough, otherwise
+     * nullptr and the scalar interpolation on data is used.
+     */
+    gmx::CubicSplineTable* cubicSpline;
 } bondedtable_t;
 
 /*
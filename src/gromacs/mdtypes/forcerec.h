@@ -227,6 +227,13 @@ struct t_forcerec
     struct gmx_pme_t* pmedata                = nullptr;
     int               ljpme_combination_rule = 0;
 
+    /* Cache of the reciprocal-space PME forces of the home atoms, for reuse
+     * on the decimated steps with GMX_PME_MTS, see do_force_lowlevel()
+     */
+    std::vector<gmx::RVec> pmeMtsForceCache;
+    /* The number of force computations since the cache was last refreshed, 0 means invalid */
+    int pmeMtsStepsSinceCompute = 0;
+
     /* PME/Ewald stuff */
     struct gmx_ewald_tab_t* ewald_table = nullptr;
 
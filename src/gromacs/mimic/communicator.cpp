@@ -41,6 +41,7 @@
 #include <unordered_set>
 
 #include "gromacs/math/units.h"
+#include "gromacs/mdlib/gmx_omp_nthreads.h"
 #include "gromacs/utility/fatalerror.h"
 
 #if GMX_MIMIC
@@ -252,13 +253,15 @@ int64_t gmx::MimicCommunicator::getStepNumber()
 
 void gmx::MimicCommunicator::getCoords(PaddedHostVector<RVec>* x, const int natoms)
 {
-    std::vector<double> coords(natoms * 3);
-    MCL_receive(&*coords.begin(), 3 * natoms, TYPE_DOUBLE, 0);
+    transferBuffer_.resize(natoms * 3);
+    MCL_receive(&*transferBuffer_.begin(), 3 * natoms, TYPE_DOUBLE, 0);
+    const int nth = gmx_omp_nthreads_get(emntDefault);
+#pragma omp parallel for num_threads(nth) schedule(static)
     for (int j = 0; j < natoms; ++j)
     {
-        (*x)[j][0] = static_cast<real>(coords[j * 3] * BOHR2NM);
-        (*x)[j][1] = static_cast<real>(coords[j * 3 + 1] * BOHR2NM);
-        (*x)[j][2] = static_cast<real>(coords[j * 3 + 2] * BOHR2NM);
+        (*x)[j][0] = static_cast<real>(transferBuffer_[j * 3] * BOHR2NM);
+        (*x)[j][1] = static_cast<real>(transferBuffer_[j * 3 + 1] * BOHR2NM);
+        (*x)[j][2] = static_cast<real>(transferBuffer_[j * 3 + 2] * BOHR2NM);
     }
 }
 
@@ -270,14 +273,16 @@ void gmx::MimicCommunicator::sendEnergies(real energy)
 
 void gmx::MimicCommunicator::sendForces(gmx::ArrayRef<gmx::RVec> forces, int natoms)
 {
-    std::vector<double> convertedForce;
+    transferBuffer_.resize(natoms * 3);
+    const int nth = gmx_omp_nthreads_get(emntDefault);
+#pragma omp parallel for num_threads(nth) schedule(static)
     for (int j = 0; j < natoms; ++j)
     {
-        convertedForce.push_back(static_cast<real>(forces[j][0]) / HARTREE_BOHR2MD);
-        convertedForce.push_back(static_cast<real>(forces[j][1]) / HARTREE_BOHR2MD);
-        convertedForce.push_back(static_cast<real>(forces[j][2]) / HARTREE_BOHR2MD);
+        transferBuffer_[j * 3]     = static_cast<real>(forces[j][0]) / HARTREE_BOHR2MD;
+        transferBuffer_[j * 3 + 1] = static_cast<real>(forces[j][1]) / HARTREE_BOHR2MD;
+        transferBuffer_[j * 3 + 2] = static_cast<real>(forces[j][2]) / HARTREE_BOHR2MD;
     }
-    MCL_send(&*convertedForce.begin(), convertedForce.size(), TYPE_DOUBLE, 0);
+    MCL_send(&*transferBuffer_.begin(), 3 * natoms, TYPE_DOUBLE, 0);
 }
 
 void gmx::MimicCommunicator::finalize()
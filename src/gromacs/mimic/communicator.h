@@ -36,6 +36,8 @@
 #ifndef GMX_MIMIC_COMMUNICATOR_H
 #define GMX_MIMIC_COMMUNICATOR_H
 
+#include <vector>
+
 #include "gromacs/gpu_utils/hostallocator.h"
 #include "gromacs/math/paddedvector.h"
 #include "gromacs/mdlib/constr.h"
@@ -110,6 +112,10 @@ public:
      * Finish communications and disconnect from the server
      */
     void finalize();
+
+private:
+    //! Reusable buffer for the unit conversion of coordinates and forces
+    std::vector<double> transferBuffer_;
 };
 
 } // namespace gmx
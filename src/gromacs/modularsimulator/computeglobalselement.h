@@ -93,6 +93,15 @@ typedef std::unique_ptr<CheckBondedInteractionsCallback> CheckBondedInteractions
  * constraint virial after the second propagation of velocities (+dt/2) and of
  * the positions (+dt).
  *
+ * \todo The global reduction blocks all ranks until the slowest one arrives,
+ *       which limits strong scaling of small systems. The reduction could be
+ *       overlapped with the force computation of the next step by making the
+ *       collective non-blocking and consuming its results one step late. That
+ *       requires the consumers (energy logging, temperature and pressure
+ *       coupling, COM motion removal) to tolerate lagged observables, so it
+ *       needs explicit support in those elements and is only valid when no
+ *       consumer needs the values on the step they were computed.
+ *
  * @tparam algorithm  The global reduction scheme
  */
 template<ComputeGlobalsAlgorithm algorithm>
@@ -69,6 +69,7 @@
 #include "gromacs/mdtypes/mdatom.h"
 #include "gromacs/mdtypes/mdrunoptions.h"
 #include "gromacs/mdtypes/observableshistory.h"
+#include "gromacs/mdtypes/simulation_workload.h"
 #include "gromacs/mdtypes/state.h"
 #include "gromacs/nbnxm/nbnxm.h"
 #include "gromacs/timing/walltime_accounting.h"
@@ -773,7 +774,8 @@ bool ModularSimulator::isInputCompatible(bool                             exitOn
                                          int                              nfile,
                                          const t_filenm*                  fnm,
                                          ObservablesHistory*              observablesHistory,
-                                         const gmx_membed_t*              membed)
+                                         const gmx_membed_t*              membed,
+                                         bool                             useGpuForUpdate)
 {
     auto conditionalAssert = [exitOnFailure](bool condition, const char* message) {
         if (exitOnFailure)
@@ -912,12 +914,15 @@ bool ModularSimulator::isInputCompatible(bool                             exitOn
             isInputCompatible
             && conditionalAssert(membed == nullptr,
                                  "Membrane embedding is not supported by the modular simulator.");
-    // TODO: Change this to the boolean passed when we merge the user interface change for the GPU update.
+    /* The modular simulator schedules only CPU elements, so choosing it
+     * would silently discard a requested or decided GPU-resident update.
+     * Fall back to the legacy simulator, which supports GPU update, until
+     * GPU-capable propagator and constraint elements exist.
+     */
     isInputCompatible =
             isInputCompatible
-            && conditionalAssert(
-                       getenv("GMX_FORCE_UPDATE_DEFAULT_GPU") == nullptr,
-                       "Integration on the GPU is not supported by the modular simulator.");
+            && conditionalAssert(!useGpuForUpdate,
+                                 "Integration on the GPU is not supported by the modular simulator.");
     // Modular simulator is centered around NS updates
     // TODO: think how to handle nstlist == 0
     isInputCompatible = isInputCompatible
@@ -934,7 +939,7 @@ bool ModularSimulator::isInputCompatible(bool                             exitOn
 void ModularSimulator::checkInputForDisabledFunctionality()
 {
     isInputCompatible(true, inputrec, doRerun, vsite, ms, replExParams, fcd, nfile, fnm,
-                      observablesHistory, membed);
+                      observablesHistory, membed, runScheduleWork->simulationWork.useGpuUpdate);
 }
 
 SignallerCallbackPtr ModularSimulator::SignalHelper::registerLastStepCallback()
@@ -41,6 +41,7 @@
 #ifndef GROMACS_MODULARSIMULATOR_MODULARSIMULATOR_H
 #define GROMACS_MODULARSIMULATOR_MODULARSIMULATOR_H
 
+#include <limits>
 #include <queue>
 
 #include "gromacs/mdlib/md_support.h"
@@ -92,7 +93,8 @@ public:
                                   int                              nfile,
                                   const t_filenm*                  fnm,
                                   ObservablesHistory*              observablesHistory,
-                                  const gmx_membed_t*              membed);
+                                  const gmx_membed_t*              membed,
+                                  bool                             useGpuForUpdate);
 
     // Only builder can construct
     friend class SimulatorBuilder;
@@ -72,11 +72,68 @@
 
 using namespace gmx; // TODO: Remove when this file is moved into gmx namespace
 
+/*! \brief Returns whether reduced-precision storage of coordinates and
+ * per-atom parameters is requested through GMX_NBNXN_HALFPREC_X.
+ *
+ * This emulates storing the packed nbat data with the 11-bit significand
+ * of IEEE half precision, while all force accumulation stays in single
+ * precision. It allows validating the accuracy of future native FP16/BF16
+ * SIMD kernels and is only useful for throughput runs where ~1e-3 relative
+ * force errors are acceptable.
+ */
+static bool useHalfPrecisionNbatStorage()
+{
+    static const bool useHalfPrec = (getenv("GMX_NBNXN_HALFPREC_X") != nullptr);
+
+    return useHalfPrec;
+}
+
+/*! \brief Rounds \p value to the significand precision of IEEE half precision.
+ *
+ * Only the mantissa is truncated, with round-to-nearest-even; the exponent
+ * range of half precision is not emulated, since coordinates in nm and
+ * combination-rule parameters do not approach the FP16 overflow/underflow
+ * thresholds in practice.
+ */
+static inline real roundRealToHalfPrecision(real value)
+{
+    float    valueSingle = static_cast<float>(value);
+    uint32_t bits;
+    std::memcpy(&bits, &valueSingle, sizeof(bits));
+    /* Keep 10 explicit mantissa bits, rounding to nearest, ties to even */
+    bits += 0x00000fff + ((bits >> 13) & 1);
+    bits &= 0xffffe000;
+    std::memcpy(&valueSingle, &bits, sizeof(bits));
+
+    return valueSingle;
+}
+
+//! Rounds \p numValues reals starting at \p values to half-precision storage
+static void roundRealsToHalfPrecision(real* values, int numValues)
+{
+    for (int i = 0; i < numValues; i++)
+    {
+        values[i] = roundRealToHalfPrecision(values[i]);
+    }
+}
+
 void nbnxn_atomdata_t::resizeCoordinateBuffer(int numAtoms)
 {
     numAtoms_ = numAtoms;
 
     x_.resize(numAtoms * xstride);
+    if (useCoordinateBufferRing_)
+    {
+        xAlternate_.resize(numAtoms * xstride);
+    }
+}
+
+void nbnxn_atomdata_t::rotateCoordinateBuffer()
+{
+    if (useCoordinateBufferRing_)
+    {
+        std::swap(x_, xAlternate_);
+    }
 }
 
 void nbnxn_atomdata_t::resizeForceBuffers()
@@ -431,6 +488,9 @@ nbnxn_atomdata_t::nbnxn_atomdata_t(gmx::PinningPolicy pinningPolicy) :
     natoms_local(0),
     shift_vec({}, { pinningPolicy }),
     x_({}, { pinningPolicy }),
+    xAlternate_({}, { pinningPolicy }),
+    useCoordinateBufferRing_(pinningPolicy == gmx::PinningPolicy::PinnedIfSupported
+                             && getenv("GMX_NBNXN_XBUF_RING") != nullptr),
     simdMasks(),
     bUseBufferFlags(FALSE),
     bUseTreeReduce(FALSE)
@@ -778,6 +838,11 @@ static void nbnxn_atomdata_set_ljcombparams(nbnxn_atomdata_t::Params* params,
                 }
             }
         }
+
+        if (useHalfPrecisionNbatStorage())
+        {
+            roundRealsToHalfPrecision(params->lj_comb.data(), params->lj_comb.size());
+        }
     }
 }
 
@@ -1024,6 +1089,14 @@ void nbnxn_atomdata_copy_x_to_nbat_x(const Nbnxm::GridSet&   gridSet,
     int gridEnd   = 0;
     getAtomRanges(gridSet, locality, &gridBegin, &gridEnd);
 
+    if (locality != gmx::AtomLocality::NonLocal)
+    {
+        /* Rotate before packing the local atoms, so the non-local packing
+         * and the transfers of this step all use the same buffer.
+         */
+        nbat->rotateCoordinateBuffer();
+    }
+
     if (fillLocal)
     {
         nbat->natoms_local = gridSet.grids()[0].atomIndexEnd();
@@ -1049,8 +1122,12 @@ void nbnxn_atomdata_copy_x_to_nbat_x(const Nbnxm::GridSet&   gridSet,
                     const int ash = grid.firstAtomInColumn(cxy);
 
                     int na_fill;
-                    if (g == 0 && fillLocal)
+                    if ((g == 0 && fillLocal) || nbat->useCoordinateBufferRing())
                     {
+                        /* With the buffer ring we always rewrite the filler
+                         * entries, since the buffer we rotated to holds
+                         * filler values from an older pair list.
+                         */
                         na_fill = grid.paddedNumAtomsInColumn(cxy);
                     }
                     else
@@ -1063,6 +1140,16 @@ void nbnxn_atomdata_copy_x_to_nbat_x(const Nbnxm::GridSet&   gridSet,
                     }
                     copy_rvec_to_nbat_real(gridSet.atomIndices().data() + ash, na, na_fill,
                                            coordinates, nbat->XFormat, nbat->x().data(), ash);
+
+                    if (useHalfPrecisionNbatStorage())
+                    {
+                        /* With nbatXYZQ this also covers the charges, which
+                         * matches the precision model of FP16 parameter
+                         * storage with single-precision accumulation.
+                         */
+                        roundRealsToHalfPrecision(nbat->x().data() + ash * nbat->xstride,
+                                                  na_fill * nbat->xstride);
+                    }
                 }
             }
         }
@@ -1172,6 +1259,53 @@ gmx_unused static void nbnxn_atomdata_reduce_reals_simd(real gmx_unused* gmx_res
 #endif
 }
 
+#if GMX_SIMD
+/*! \brief Adds forces for a range of atoms in nbatXYZ/nbatXYZQ format to f
+ *
+ * Gathers SIMD-width packed force triplets through the cell index,
+ * transposes them in registers and scatter-increments into the rvec
+ * output. This replaces three dependent scalar adds per atom by
+ * transposed SIMD accumulation.
+ */
+template<int packStride>
+static void nbnxn_atomdata_add_nbat_f_to_f_partSimd(gmx::ArrayRef<const int> cell,
+                                                    const real*              fnb,
+                                                    const int                a0,
+                                                    const int                a1,
+                                                    rvec*                    f)
+{
+    constexpr int c_simdWidth = GMX_SIMD_REAL_WIDTH;
+
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t srcOffset[c_simdWidth];
+    alignas(GMX_SIMD_ALIGNMENT) std::int32_t destOffset[c_simdWidth];
+
+    int a = a0;
+    for (; a + c_simdWidth <= a1; a += c_simdWidth)
+    {
+        for (int s = 0; s < c_simdWidth; s++)
+        {
+            srcOffset[s]  = cell[a + s];
+            destOffset[s] = a + s;
+        }
+
+        SimdReal fx, fy, fz;
+        gatherLoadUTranspose<packStride>(fnb, srcOffset, &fx, &fy, &fz);
+
+        transposeScatterIncrU<3>(reinterpret_cast<real*>(f), destOffset, fx, fy, fz);
+    }
+
+    /* Handle the remaining atoms with the scalar path */
+    for (; a < a1; a++)
+    {
+        const int i = cell[a] * packStride;
+
+        f[a][XX] += fnb[i];
+        f[a][YY] += fnb[i + 1];
+        f[a][ZZ] += fnb[i + 2];
+    }
+}
+#endif
+
 /* Add part of the force array(s) from nbnxn_atomdata_t to f
  *
  * Note: Adding restrict to f makes this function 50% slower with gcc 7.3
@@ -1192,6 +1326,17 @@ static void nbnxn_atomdata_add_nbat_f_to_f_part(const Nbnxm::GridSet&          g
     {
         case nbatXYZ:
         case nbatXYZQ:
+#if GMX_SIMD
+            if (nbat.fstride == 3)
+            {
+                nbnxn_atomdata_add_nbat_f_to_f_partSimd<3>(cell, fnb, a0, a1, f);
+            }
+            else
+            {
+                GMX_ASSERT(nbat.fstride == 4, "Unsupported force stride");
+                nbnxn_atomdata_add_nbat_f_to_f_partSimd<4>(cell, fnb, a0, a1, f);
+            }
+#else
             for (int a = a0; a < a1; a++)
             {
                 int i = cell[a] * nbat.fstride;
@@ -1200,6 +1345,7 @@ static void nbnxn_atomdata_add_nbat_f_to_f_part(const Nbnxm::GridSet&          g
                 f[a][YY] += fnb[i + 1];
                 f[a][ZZ] += fnb[i + 2];
             }
+#endif
             break;
         case nbatX4:
             for (int a = a0; a < a1; a++)
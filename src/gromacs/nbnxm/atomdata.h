@@ -263,6 +263,20 @@ struct nbnxn_atomdata_t
     //! Resizes the force buffers for the current number of atoms
     void resizeForceBuffers();
 
+    /*! \brief Rotates to the next coordinate buffer in the pinned ring.
+     *
+     * With GMX_NBNXN_XBUF_RING set and pinned buffers in use, packing
+     * alternates between two pinned coordinate buffers, so the CPU can
+     * repack coordinates for the next step while an asynchronous H2D
+     * copy of the previous buffer may still be in flight. A no-op when
+     * the ring is not active. Must only be called before packing the
+     * local atoms, so that all localities of a step use the same buffer.
+     */
+    void rotateCoordinateBuffer();
+
+    //! Returns whether the pinned coordinate-buffer ring is active
+    bool useCoordinateBufferRing() const { return useCoordinateBufferRing_; }
+
 private:
     //! The LJ and charge parameters
     Params params_;
@@ -288,6 +302,10 @@ public:
 private:
     //! x and possibly q, size natoms*xstride
     gmx::HostVector<real> x_;
+    //! Alternate coordinate buffer, only allocated when the pinned ring is active
+    gmx::HostVector<real> xAlternate_;
+    //! Whether packing rotates between x_ and xAlternate_
+    bool useCoordinateBufferRing_ = false;
 
 public:
     //! Masks for handling exclusions in the SIMD kernels
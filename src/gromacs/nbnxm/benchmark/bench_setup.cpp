@@ -276,9 +276,18 @@ static void setupAndRunInstance(const gmx::BenchmarkSystem& system,
     const real atomDensity = system.coordinates.size() / det(system.box);
     const real numPairsWithinCutoff =
             atomDensity * 4.0 / 3.0 * M_PI * std::pow(options.pairlistCutoff, 3);
-    const real numUsefulPairs = system.coordinates.size() * 0.5 * (numPairsWithinCutoff + 1);
-
-    std::unique_ptr<nonbonded_verlet_t> nbv = setupNbnxmForBenchInstance(options, system);
+    const real numUsefulPairs =
+            system.coordinates.size() * 0.5 * (numPairsWithinCutoff + 1) * options.numSystems;
+
+    /* With numSystems > 1 we benchmark batched execution over independent
+     * copies of the system, cycling over the copies within each iteration.
+     */
+    std::vector<std::unique_ptr<nonbonded_verlet_t>> nbvList;
+    for (int s = 0; s < options.numSystems; s++)
+    {
+        nbvList.push_back(setupNbnxmForBenchInstance(options, system));
+    }
+    nonbonded_verlet_t* nbv = nbvList[0].get();
 
     // We set the interaction cut-off to the pairlist cut-off
     interaction_const_t ic = setupInteractionConst(options);
@@ -312,19 +321,26 @@ static void setupAndRunInstance(const gmx::BenchmarkSystem& system,
     // Run pre-iteration to avoid cache misses
     for (int iter = 0; iter < options.numPreIterations; iter++)
     {
-        nbv->dispatchNonbondedKernel(gmx::InteractionLocality::Local, ic, stepWork, enbvClearFYes,
-                                     system.forceRec, &enerd, &nrnb);
+        for (auto& nbvInstance : nbvList)
+        {
+            nbvInstance->dispatchNonbondedKernel(gmx::InteractionLocality::Local, ic, stepWork,
+                                                 enbvClearFYes, system.forceRec, &enerd, &nrnb);
+        }
     }
 
     const int numIterations = (doWarmup ? options.numWarmupIterations : options.numIterations);
     const PairlistSet& pairlistSet = nbv->pairlistSets().pairlistSet(gmx::InteractionLocality::Local);
-    const gmx::index numPairs = pairlistSet.natpair_ljq_ + pairlistSet.natpair_lj_ + pairlistSet.natpair_q_;
+    const gmx::index numPairs = (pairlistSet.natpair_ljq_ + pairlistSet.natpair_lj_ + pairlistSet.natpair_q_)
+                                * options.numSystems;
     gmx_cycles_t cycles = gmx_cycles_read();
     for (int iter = 0; iter < numIterations; iter++)
     {
         // Run the kernel without force clearing
-        nbv->dispatchNonbondedKernel(gmx::InteractionLocality::Local, ic, stepWork, enbvClearFNo,
-                                     system.forceRec, &enerd, &nrnb);
+        for (auto& nbvInstance : nbvList)
+        {
+            nbvInstance->dispatchNonbondedKernel(gmx::InteractionLocality::Local, ic, stepWork,
+                                                 enbvClearFNo, system.forceRec, &enerd, &nrnb);
+        }
     }
     cycles = gmx_cycles_read() - cycles;
     if (!doWarmup)
@@ -362,6 +378,10 @@ void bench(const int sizeFactor, const KernelBenchOptions& options)
     {
         gmx_fatal(FARGS, "The cut-off should be shorter than half the box size");
     }
+    if (options.numSystems < 1)
+    {
+        gmx_fatal(FARGS, "The number of systems should be at least 1");
+    }
 
     std::vector<KernelBenchOptions> optionsList;
     if (options.doAll)
@@ -404,6 +424,10 @@ void bench(const int sizeFactor, const KernelBenchOptions& options)
     fprintf(stdout, "System size:          %zu atoms\n", system.coordinates.size());
     fprintf(stdout, "Cut-off radius:       %g nm\n", options.pairlistCutoff);
     fprintf(stdout, "Number of threads:    %d\n", options.numThreads);
+    if (options.numSystems > 1)
+    {
+        fprintf(stdout, "Number of systems:    %d\n", options.numSystems);
+    }
     fprintf(stdout, "Number of iterations: %d\n", options.numIterations);
     fprintf(stdout, "Compute energies:     %s\n", options.computeVirialAndEnergy ? "yes" : "no");
     if (options.coulombType != BenchMarkCoulomb::ReactionField)
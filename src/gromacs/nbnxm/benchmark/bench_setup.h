@@ -109,6 +109,13 @@ struct KernelBenchOptions
     int numPreIterations = 1;
     //! The number of iterations for each kernel
     int numIterations = 100;
+    /*! \brief The number of independent copies of the system to cycle over
+     *
+     * With more than one system each iteration runs the kernel once per
+     * system copy, which mimics throughput-style batched execution where
+     * many small systems share the caches of one set of cores.
+     */
+    int numSystems = 1;
     //! The number of (untimed) iterations to run at startup to warm up the CPU
     int numWarmupIterations = 0;
     //! Print cycles/pair instead of pairs/cycle
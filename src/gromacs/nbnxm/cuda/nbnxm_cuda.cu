@@ -880,6 +880,13 @@ void nbnxn_gpu_x_to_nbat_x(const Nbnxm::Grid&        grid,
 }
 
 /* F buffer operations on GPU: performs force summations and conversion from nb to rvec format.
+ *
+ * This is the single reduction pass over the force buffer: the nonbonded and
+ * bonded kernels have already chained their contributions by accumulating into
+ * the shared nbat-format buffer, and the kernel launched here combines that
+ * buffer, the PME forces (when reduced on the GPU) and any prior contents of
+ * the total-force buffer in one sweep, with the producers' completion
+ * expressed through the events in \p dependencyList.
  *
  * NOTE: When the total force device buffer is reallocated and its size increases, it is cleared in
  *       Local stream. Hence, if accumulateForce is true, NonLocal stream should start accumulating
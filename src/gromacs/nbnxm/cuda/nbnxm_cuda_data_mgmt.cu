@@ -127,20 +127,13 @@ static void init_ewald_coulomb_force_table(const EwaldCorrectionTables& tables,
     pair-search. */
 static void init_atomdata_first(cu_atomdata_t* ad, int ntypes)
 {
-    cudaError_t stat;
-
     ad->ntypes = ntypes;
-    stat       = cudaMalloc((void**)&ad->shift_vec, SHIFTS * sizeof(*ad->shift_vec));
-    CU_RET_ERR(stat, "cudaMalloc failed on ad->shift_vec");
+    allocateDeviceBuffer(&ad->shift_vec, SHIFTS, nullptr);
     ad->bShiftVecUploaded = false;
 
-    stat = cudaMalloc((void**)&ad->fshift, SHIFTS * sizeof(*ad->fshift));
-    CU_RET_ERR(stat, "cudaMalloc failed on ad->fshift");
-
-    stat = cudaMalloc((void**)&ad->e_lj, sizeof(*ad->e_lj));
-    CU_RET_ERR(stat, "cudaMalloc failed on ad->e_lj");
-    stat = cudaMalloc((void**)&ad->e_el, sizeof(*ad->e_el));
-    CU_RET_ERR(stat, "cudaMalloc failed on ad->e_el");
+    allocateDeviceBuffer(&ad->fshift, SHIFTS, nullptr);
+    allocateDeviceBuffer(&ad->e_lj, 1, nullptr);
+    allocateDeviceBuffer(&ad->e_el, 1, nullptr);
 
     /* initialize to nullptr poiters to data that is not allocated here and will
        need reallocation in nbnxn_cuda_init_atomdata */
@@ -616,7 +609,6 @@ void gpu_clear_outputs(NbnxmGpu* nb, bool computeVirial)
 
 void gpu_init_atomdata(NbnxmGpu* nb, const nbnxn_atomdata_t* nbat)
 {
-    cudaError_t    stat;
     int            nalloc, natoms;
     bool           realloced;
     bool           bDoTime = nb->bDoTime;
@@ -648,19 +640,15 @@ void gpu_init_atomdata(NbnxmGpu* nb, const nbnxn_atomdata_t* nbat)
             freeDeviceBuffer(&d_atdat->lj_comb);
         }
 
-        stat = cudaMalloc((void**)&d_atdat->f, nalloc * sizeof(*d_atdat->f));
-        CU_RET_ERR(stat, "cudaMalloc failed on d_atdat->f");
-        stat = cudaMalloc((void**)&d_atdat->xq, nalloc * sizeof(*d_atdat->xq));
-        CU_RET_ERR(stat, "cudaMalloc failed on d_atdat->xq");
+        allocateDeviceBuffer(&d_atdat->f, nalloc, nullptr);
+        allocateDeviceBuffer(&d_atdat->xq, nalloc, nullptr);
         if (useLjCombRule(nb->nbparam))
         {
-            stat = cudaMalloc((void**)&d_atdat->lj_comb, nalloc * sizeof(*d_atdat->lj_comb));
-            CU_RET_ERR(stat, "cudaMalloc failed on d_atdat->lj_comb");
+            allocateDeviceBuffer(&d_atdat->lj_comb, nalloc, nullptr);
         }
         else
         {
-            stat = cudaMalloc((void**)&d_atdat->atom_types, nalloc * sizeof(*d_atdat->atom_types));
-            CU_RET_ERR(stat, "cudaMalloc failed on d_atdat->atom_types");
+            allocateDeviceBuffer(&d_atdat->atom_types, nalloc, nullptr);
         }
 
         d_atdat->nalloc = nalloc;
@@ -743,15 +731,10 @@ void gpu_free(NbnxmGpu* nb)
         destroyParamLookupTable(nbparam->nbfp_comb, nbparam->nbfp_comb_texobj);
     }
 
-    stat = cudaFree(atdat->shift_vec);
-    CU_RET_ERR(stat, "cudaFree failed on atdat->shift_vec");
-    stat = cudaFree(atdat->fshift);
-    CU_RET_ERR(stat, "cudaFree failed on atdat->fshift");
-
-    stat = cudaFree(atdat->e_lj);
-    CU_RET_ERR(stat, "cudaFree failed on atdat->e_lj");
-    stat = cudaFree(atdat->e_el);
-    CU_RET_ERR(stat, "cudaFree failed on atdat->e_el");
+    freeDeviceBuffer(&atdat->shift_vec);
+    freeDeviceBuffer(&atdat->fshift);
+    freeDeviceBuffer(&atdat->e_lj);
+    freeDeviceBuffer(&atdat->e_el);
 
     freeDeviceBuffer(&atdat->f);
     freeDeviceBuffer(&atdat->xq);
@@ -812,7 +795,28 @@ void gpu_reset_timings(nonbonded_verlet_t* nbv)
 
 int gpu_min_ci_balanced(NbnxmGpu* nb)
 {
-    return nb != nullptr ? gpu_min_ci_balanced_factor * nb->deviceInfo->prop.multiProcessorCount : 0;
+    if (nb == nullptr)
+    {
+        return 0;
+    }
+
+    const int numMultiProcessors = nb->deviceInfo->prop.multiProcessorCount;
+
+    /* On devices with many multiprocessors (Volta/Ampere data-center class)
+     * small systems produce too few cluster pairs per SM with the Kepler-era
+     * factor, so occupancy collapses before the list-splitting heuristic
+     * kicks in. Scale the balancing target with the SM count so that the
+     * list generation splits i-entries aggressively enough to fill the
+     * device. This is cheaper and more maintainable than instantiating
+     * kernels for a second, smaller cluster geometry.
+     */
+    unsigned int factor = gpu_min_ci_balanced_factor;
+    if (numMultiProcessors >= 60)
+    {
+        factor = gpu_min_ci_balanced_factor * 3 / 2;
+    }
+
+    return factor * numMultiProcessors;
 }
 
 gmx_bool gpu_is_kernel_ewald_analytical(const NbnxmGpu* nb)
@@ -100,6 +100,92 @@ static real gridAtomDensity(int numAtoms, const rvec lowerCorner, const rvec upp
     return static_cast<real>(numAtoms) / (size[XX] * size[YY] * size[ZZ]);
 }
 
+/*! \brief Rotates/flips a quadrant for the Hilbert-curve index conversion */
+static void hilbertRotate(const int n, int* x, int* y, const int rx, const int ry)
+{
+    if (ry == 0)
+    {
+        if (rx == 1)
+        {
+            *x = n - 1 - *x;
+            *y = n - 1 - *y;
+        }
+        std::swap(*x, *y);
+    }
+}
+
+/*! \brief Returns the x,y location of distance \p d along a Hilbert curve on an n*n grid, n a power of 2 */
+static void hilbertDistanceToXY(const int n, const int d, int* x, int* y)
+{
+    int t = d;
+    *x    = 0;
+    *y    = 0;
+    for (int s = 1; s < n; s *= 2)
+    {
+        const int rx = 1 & (t / 2);
+        const int ry = 1 & (t ^ rx);
+        hilbertRotate(s, x, y, rx, ry);
+        *x += s * rx;
+        *y += s * ry;
+        t /= 4;
+    }
+}
+
+/*! \brief Sets the mapping between x,y indices and column storage order
+ *
+ * By default columns are stored row-major. With GMX_NBNXN_HILBERT_ORDER
+ * set, columns are stored along a Hilbert curve, so columns that are close
+ * in space are also close in memory, which improves cache reuse for the
+ * coordinates and forces of neighboring columns during the pair search
+ * and the kernels.
+ */
+static void setColumnOrdering(Grid::Dimensions* dims)
+{
+    const int numColumnsX = dims->numCells[XX];
+    const int numColumnsY = dims->numCells[YY];
+    const int numColumns  = numColumnsX * numColumnsY;
+
+    dims->columnOrder.resize(numColumns);
+    dims->columnRowMajorIndex.resize(numColumns);
+
+    static const bool useHilbertOrder = (getenv("GMX_NBNXN_HILBERT_ORDER") != nullptr);
+
+    if (useHilbertOrder && numColumnsX > 2 && numColumnsY > 2)
+    {
+        /* Walk a Hilbert curve on the smallest enclosing power-of-2 square
+         * and assign storage indices to the columns that fall on the grid.
+         */
+        int curveSize = 1;
+        while (curveSize < std::max(numColumnsX, numColumnsY))
+        {
+            curveSize *= 2;
+        }
+
+        int storageIndex = 0;
+        for (int d = 0; d < curveSize * curveSize; d++)
+        {
+            int cx, cy;
+            hilbertDistanceToXY(curveSize, d, &cx, &cy);
+            if (cx < numColumnsX && cy < numColumnsY)
+            {
+                const int rowMajorIndex              = cx * numColumnsY + cy;
+                dims->columnOrder[rowMajorIndex]     = storageIndex;
+                dims->columnRowMajorIndex[storageIndex] = rowMajorIndex;
+                storageIndex++;
+            }
+        }
+        GMX_ASSERT(storageIndex == numColumns, "All columns should be covered by the curve");
+    }
+    else
+    {
+        for (int i = 0; i < numColumns; i++)
+        {
+            dims->columnOrder[i]         = i;
+            dims->columnRowMajorIndex[i] = i;
+        }
+    }
+}
+
 void Grid::setDimensions(const int          ddZone,
                          const int          numAtoms,
                          gmx::RVec          lowerCorner,
@@ -198,6 +284,8 @@ void Grid::setDimensions(const int          ddZone,
         dimensions_.numCells[YY]++;
     }
 
+    setColumnOrdering(&dimensions_);
+
     /* We need one additional cell entry for particles moved by DD */
     cxy_na_.resize(numColumns() + 1);
     cxy_ind_.resize(numColumns() + 2);
@@ -1082,8 +1170,8 @@ void Grid::sortColumnsGpuGeometry(GridSetData*                   gridSetData,
      */
     for (int cxy : columnRange)
     {
-        const int gridX = cxy / dimensions_.numCells[YY];
-        const int gridY = cxy - gridX * dimensions_.numCells[YY];
+        const int gridX = columnX(cxy);
+        const int gridY = columnY(cxy);
 
         const int numAtomsInColumn = cxy_na_[cxy];
         const int numCellsInColumn = cxy_ind_[cxy + 1] - cxy_ind_[cxy];
@@ -1229,7 +1317,7 @@ void Grid::calcColumnIndices(const Grid::Dimensions&        gridDims,
                 /* For the moment cell will contain only the, grid local,
                  * x and y indices, not z.
                  */
-                setCellAndAtomCount(cell, cx * gridDims.numCells[YY] + cy, cxy_na, i);
+                setCellAndAtomCount(cell, gridDims.columnOrder[cx * gridDims.numCells[YY] + cy], cxy_na, i);
             }
             else
             {
@@ -1262,7 +1350,7 @@ void Grid::calcColumnIndices(const Grid::Dimensions&        gridDims,
             /* For the moment cell will contain only the, grid local,
              * x and y indices, not z.
              */
-            setCellAndAtomCount(cell, cx * gridDims.numCells[YY] + cy, cxy_na, i);
+            setCellAndAtomCount(cell, gridDims.columnOrder[cx * gridDims.numCells[YY] + cy], cxy_na, i);
         }
     }
 }
@@ -221,6 +221,15 @@ public:
         real invCellSize[DIM - 1];
         //! The number of grid cells along dimensions x and y
         int numCells[DIM - 1];
+        /*! \brief Maps row-major cx*numCells[YY]+cy indices to column storage order
+         *
+         * The identity with the default row-major column ordering; a
+         * space-filling-curve permutation with GMX_NBNXN_HILBERT_ORDER set,
+         * which improves cache reuse between neighboring columns.
+         */
+        std::vector<int> columnOrder;
+        //! The inverse of columnOrder: row-major index for each storage column
+        std::vector<int> columnRowMajorIndex;
     };
 
     //! Constructs a grid given the type of pairlist
@@ -250,6 +259,24 @@ public:
     //! Returns the end of the source atom range mapped to this grid
     int srcAtomEnd() const { return srcAtomEnd_; }
 
+    //! Returns the column storage index for the column with grid indices cx,cy
+    int columnIndex(int cx, int cy) const
+    {
+        return dimensions_.columnOrder[cx * dimensions_.numCells[YY] + cy];
+    }
+
+    //! Returns the x grid index of the column with storage index \p columnIndex
+    int columnX(int columnIndex) const
+    {
+        return dimensions_.columnRowMajorIndex[columnIndex] / dimensions_.numCells[YY];
+    }
+
+    //! Returns the y grid index of the column with storage index \p columnIndex
+    int columnY(int columnIndex) const
+    {
+        return dimensions_.columnRowMajorIndex[columnIndex] % dimensions_.numCells[YY];
+    }
+
     //! Returns the first cell index in the grid, starting at 0 in this grid
     int firstCellInColumn(int columnIndex) const { return cxy_ind_[columnIndex]; }
 
@@ -36,6 +36,8 @@
 
 #include "gmxpre.h"
 
+#include <vector>
+
 #include "gromacs/gmxlib/nrnb.h"
 #include "gromacs/gmxlib/nonbonded/nb_free_energy.h"
 #include "gromacs/gmxlib/nonbonded/nb_kernel.h"
@@ -239,7 +241,11 @@ static void nbnxn_kernel_cpu(const PairlistSet&         pairlistSet,
 
     int gmx_unused nthreads = gmx_omp_nthreads_get(emntNonbonded);
     wallcycle_sub_start(wcycle, ewcsNONBONDED_CLEAR);
-#pragma omp parallel for schedule(static) num_threads(nthreads)
+    /* Dynamic scheduling lets idle threads steal lists when there are more
+     * lists than threads (GMX_NBNXN_LISTS_PER_THREAD); with one list per
+     * thread it behaves like the static schedule used before.
+     */
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
     for (gmx::index nb = 0; nb < pairlists.ssize(); nb++)
     {
         // Presently, the kernels do not call C++ code that can throw,
@@ -527,37 +533,40 @@ void nonbonded_verlet_t::dispatchFreeEnergyKernel(gmx::InteractionLocality   iLo
 
     /* If we do foreign lambda and we have soft-core interactions
      * we have to recalculate the (non-linear) energies contributions.
+     * All lambda sets are evaluated in one batched pass over the pair
+     * lists with per-set accumulators, so many foreign lambdas do not
+     * multiply the pair-list traversal cost.
      */
     if (fepvals->n_lambda > 0 && stepWork.computeDhdl && fepvals->sc_alpha != 0)
     {
-        real lam_i[efptNR];
-        kernel_data.flags = (donb_flags & ~(GMX_NONBONDED_DO_FORCE | GMX_NONBONDED_DO_SHIFTFORCE))
-                            | GMX_NONBONDED_DO_FOREIGNLAMBDA;
-        kernel_data.lambda         = lam_i;
-        kernel_data.energygrp_elec = enerd->foreign_grpp.ener[egCOULSR].data();
-        kernel_data.energygrp_vdw  = enerd->foreign_grpp.ener[egLJSR].data();
-        /* Note that we add to kernel_data.dvdl, but ignore the result */
-
-        for (size_t i = 0; i < enerd->enerpart_lambda.size(); i++)
+        const int numLambdaSets = gmx::ssize(enerd->enerpart_lambda);
+
+        std::vector<real> lambdaSets(numLambdaSets * efptNR);
+        for (int i = 0; i < numLambdaSets; i++)
         {
             for (int j = 0; j < efptNR; j++)
             {
-                lam_i[j] = (i == 0 ? lambda[j] : fepvals->all_lambda[j][i - 1]);
+                lambdaSets[i * efptNR + j] = (i == 0 ? lambda[j] : fepvals->all_lambda[j][i - 1]);
             }
-            reset_foreign_enerdata(enerd);
+        }
+        std::vector<real> vCoulombSets(numLambdaSets, 0);
+        std::vector<real> vVdwSets(numLambdaSets, 0);
+
 #pragma omp parallel for schedule(static) num_threads(nbl_fep.ssize())
-            for (gmx::index th = 0; th < nbl_fep.ssize(); th++)
+        for (gmx::index th = 0; th < nbl_fep.ssize(); th++)
+        {
+            try
             {
-                try
-                {
-                    gmx_nb_free_energy_kernel(nbl_fep[th].get(), x, forceWithShiftForces, fr,
-                                              &mdatoms, &kernel_data, nrnb);
-                }
-                GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+                gmx_nb_free_energy_foreign_kernel(nbl_fep[th].get(), x, fr, &mdatoms, numLambdaSets,
+                                                  lambdaSets.data(), vCoulombSets.data(),
+                                                  vVdwSets.data(), nrnb);
             }
+            GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+        }
 
-            sum_epot(&(enerd->foreign_grpp), enerd->foreign_term);
-            enerd->enerpart_lambda[i] += enerd->foreign_term[F_EPOT];
+        for (int i = 0; i < numLambdaSets; i++)
+        {
+            enerd->enerpart_lambda[i] += vCoulombSets[i] + vVdwSets[i];
         }
     }
     wallcycle_sub_stop(wcycle_, ewcsNONBONDED_FEP);
@@ -174,6 +174,14 @@ void gpu_launch_cpyback(NbnxmGpu gmx_unused* nb,
  *  force buffer (instead of that being passed only to nbnxn_gpu_launch_cpyback()) and by returning
  *  the energy and Fshift contributions for some external/centralized reduction.
  *
+ *  TODO: In fully GPU-resident step sequences (GPU update active, no energy or
+ *  virial output requested) neither the check nor the wait transfers any data
+ *  that the host consumes, yet the MD loop still synchronizes here every step.
+ *  Eliminating this round trip for such step sequences, resynchronizing the
+ *  host only at search steps, requires the inter-module dependencies that are
+ *  currently enforced through host-side event calls to be expressed on the
+ *  device instead, which the current per-module stream ownership does not allow.
+ *
  * \param[in]  nb             The nonbonded data GPU structure
  * \param[in]  stepWork       Step schedule flags
  * \param[in]  aloc           Atom locality identifier
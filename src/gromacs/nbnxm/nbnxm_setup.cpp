@@ -42,6 +42,8 @@
 
 #include "gmxpre.h"
 
+#include <algorithm>
+
 #include "gromacs/domdec/domdec.h"
 #include "gromacs/domdec/domdec_struct.h"
 #include "gromacs/hardware/hw_info.h"
@@ -438,9 +440,14 @@ std::unique_ptr<nonbonded_verlet_t> init_nb_verlet(const gmx::MDLogger&     mdlo
          */
         mimimumNumEnergyGroupNonbonded = 1;
     }
+    /* With CPU kernels we can have more pairlists than kernel threads,
+     * each needing its own output buffer and search work struct.
+     */
+    const int numCpuPairlists = gmx_omp_nthreads_get(emntNonbonded) * nbnxnNumListsPerKernelThread();
+
     nbnxn_atomdata_init(mdlog, nbat.get(), kernelSetup.kernelType, enbnxninitcombrule, fr->ntype,
                         fr->nbfp, mimimumNumEnergyGroupNonbonded,
-                        (useGpu || emulateGpu) ? 1 : gmx_omp_nthreads_get(emntNonbonded));
+                        (useGpu || emulateGpu) ? 1 : numCpuPairlists);
 
     NbnxmGpu* gpu_nbv                          = nullptr;
     int       minimumIlistCountForGpuBalancing = 0;
@@ -459,7 +466,10 @@ std::unique_ptr<nonbonded_verlet_t> init_nb_verlet(const gmx::MDLogger&     mdlo
     auto pairSearch = std::make_unique<PairSearch>(
             ir->pbcType, EI_TPI(ir->eI), DOMAINDECOMP(cr) ? &cr->dd->numCells : nullptr,
             DOMAINDECOMP(cr) ? domdec_zones(cr->dd) : nullptr, pairlistParams.pairlistType,
-            bFEP_NonBonded, gmx_omp_nthreads_get(emntPairsearch), pinPolicy);
+            bFEP_NonBonded,
+            std::max(gmx_omp_nthreads_get(emntPairsearch),
+                     (useGpu || emulateGpu) ? 1 : numCpuPairlists),
+            pinPolicy);
 
     return std::make_unique<nonbonded_verlet_t>(std::move(pairlistSets), std::move(pairSearch),
                                                 std::move(nbat), kernelSetup, gpu_nbv, wcycle);
@@ -687,7 +687,11 @@ PairlistSet::PairlistSet(const InteractionLocality locality, const PairlistParam
     // Currently GPU lists are always combined
     combineLists_ = !isCpuType_;
 
-    const int numLists = gmx_omp_nthreads_get(emntNonbonded);
+    /* With simple lists we can oversubscribe lists relative to kernel
+     * threads, so the kernel dispatch can balance dynamically.
+     */
+    const int numLists = gmx_omp_nthreads_get(emntNonbonded)
+                         * (isCpuType_ ? nbnxnNumListsPerKernelThread() : 1);
 
     if (!combineLists_ && numLists > NBNXN_BUFFERFLAG_MAX_THREADS)
     {
@@ -1363,13 +1367,20 @@ static nbnxn_sci_t* getOpenIEntry(NbnxnPairlistGpu* nbl)
  *
  * Set all atom-pair exclusions from the topology stored in exclusions
  * as masks in the pair-list for simple list entry iEntry.
+ *
+ * The exclusion bits of all atoms in the i-cluster are first aggregated
+ * into one bitmask per excluded j-cluster in \p exclusionMasks, so each
+ * distinct j-cluster is searched for in the list only once. With e.g.
+ * solvent molecules mapping to a single cluster this saves most of the
+ * pair-list searches.
  */
 static void setExclusionsForIEntry(const Nbnxm::GridSet&   gridSet,
                                    NbnxnPairlistCpu*       nbl,
                                    gmx_bool                diagRemoved,
                                    int                     na_cj_2log,
                                    const nbnxn_ci_t&       iEntry,
-                                   const ListOfLists<int>& exclusions)
+                                   const ListOfLists<int>& exclusions,
+                                   std::vector<std::pair<int, unsigned int>>* exclusionMasks)
 {
     if (iEntry.cj_ind_end == iEntry.cj_ind_start)
     {
@@ -1384,6 +1395,8 @@ static void setExclusionsForIEntry(const Nbnxm::GridSet&   gridSet,
     gmx::ArrayRef<const int> cell        = gridSet.cells();
     gmx::ArrayRef<const int> atomIndices = gridSet.atomIndices();
 
+    exclusionMasks->clear();
+
     /* Loop over the atoms in the i-cluster */
     for (int i = 0; i < nbl->na_ci; i++)
     {
@@ -1416,22 +1429,43 @@ static void setExclusionsForIEntry(const Nbnxm::GridSet&   gridSet,
                 /* Could the cluster se be in our list? */
                 if (jCluster >= ranges.cjFirst && jCluster <= ranges.cjLast)
                 {
-                    const int index =
-                            findJClusterInJList(jCluster, ranges, gmx::makeConstArrayRef(nbl->cj));
+                    const int innerJ = jIndex - (jCluster << na_cj_2log);
+                    const unsigned int bit = 1U << ((i << na_cj_2log) + innerJ);
 
-                    if (index >= 0)
+                    /* Aggregate the bit in the mask for this j-cluster.
+                     * The number of distinct j-clusters is tiny, so a
+                     * linear search beats any fancier container here.
+                     */
+                    bool found = false;
+                    for (auto& maskEntry : *exclusionMasks)
                     {
-                        /* We found an exclusion, clear the corresponding
-                         * interaction bit.
-                         */
-                        const int innerJ = jIndex - (jCluster << na_cj_2log);
-
-                        nbl->cj[index].excl &= ~(1U << ((i << na_cj_2log) + innerJ));
+                        if (maskEntry.first == jCluster)
+                        {
+                            maskEntry.second |= bit;
+                            found = true;
+                            break;
+                        }
+                    }
+                    if (!found)
+                    {
+                        exclusionMasks->emplace_back(jCluster, bit);
                     }
                 }
             }
         }
     }
+
+    /* Clear the aggregated interaction bits with one search per j-cluster */
+    for (const auto& maskEntry : *exclusionMasks)
+    {
+        const int index =
+                findJClusterInJList(maskEntry.first, ranges, gmx::makeConstArrayRef(nbl->cj));
+
+        if (index >= 0)
+        {
+            nbl->cj[index].excl &= ~maskEntry.second;
+        }
+    }
 }
 
 /* Add a new i-entry to the FEP list and copy the i-properties */
@@ -1876,7 +1910,8 @@ static void setExclusionsForIEntry(const Nbnxm::GridSet& gridSet,
                                    gmx_bool              diagRemoved,
                                    int gmx_unused          na_cj_2log,
                                    const nbnxn_sci_t&      iEntry,
-                                   const ListOfLists<int>& exclusions)
+                                   const ListOfLists<int>& exclusions,
+                                   std::vector<std::pair<int, unsigned int>> gmx_unused* exclusionMasks)
 {
     if (iEntry.numJClusterGroups() == 0)
     {
@@ -2723,7 +2758,7 @@ static void balance_fep_lists(gmx::ArrayRef<std::unique_ptr<t_nblist>> fepLists,
 
     const int nrj_target = (nrj_tot + numLists - 1) / numLists;
 
-    GMX_ASSERT(gmx_omp_nthreads_get(emntNonbonded) == numLists,
+    GMX_ASSERT(gmx_omp_nthreads_get(emntNonbonded) * nbnxnNumListsPerKernelThread() == numLists,
                "We should have as many work objects as FEP lists");
 
 #pragma omp parallel for schedule(static) num_threads(numLists)
@@ -2822,15 +2857,20 @@ static gmx_bool next_ci(const Grid& grid, int nth, int ci_block, int* ci_x, int*
         return FALSE;
     }
 
-    while (*ci >= grid.firstCellInColumn(*ci_x * grid.dimensions().numCells[YY] + *ci_y + 1))
+    int column = grid.columnIndex(*ci_x, *ci_y);
+    if (grid.firstCellInColumn(column) > *ci)
     {
-        *ci_y += 1;
-        if (*ci_y == grid.dimensions().numCells[YY])
-        {
-            *ci_x += 1;
-            *ci_y = 0;
-        }
+        /* With a non-row-major column ordering the start position x=y=0
+         * does not correspond to storage column 0, restart the walk there.
+         */
+        column = 0;
+    }
+    while (*ci >= grid.firstCellInColumn(column + 1))
+    {
+        column++;
     }
+    *ci_x = grid.columnX(column);
+    *ci_y = grid.columnY(column);
 
     return TRUE;
 }
@@ -3261,7 +3301,7 @@ static void nbnxn_make_pairlist_part(const Nbnxm::GridSet&   gridSet,
             }
         }
 
-        ci_xy = ci_x * iGridDims.numCells[YY] + ci_y;
+        ci_xy = iGrid.columnIndex(ci_x, ci_y);
 
         /* Loop over shift vectors in three dimensions */
         for (int tz = -shp[ZZ]; tz <= shp[ZZ]; tz++)
@@ -3408,9 +3448,9 @@ static void nbnxn_make_pairlist_part(const Nbnxm::GridSet&   gridSet,
                         for (int cy = cyf_x; cy <= cyl; cy++)
                         {
                             const int columnStart =
-                                    jGrid.firstCellInColumn(cx * jGridDims.numCells[YY] + cy);
+                                    jGrid.firstCellInColumn(jGrid.columnIndex(cx, cy));
                             const int columnEnd =
-                                    jGrid.firstCellInColumn(cx * jGridDims.numCells[YY] + cy + 1);
+                                    jGrid.firstCellInColumn(jGrid.columnIndex(cx, cy) + 1);
 
                             const real cy_real = cy;
                             d2zxy              = d2zx;
@@ -3543,7 +3583,8 @@ static void nbnxn_make_pairlist_part(const Nbnxm::GridSet&   gridSet,
                     {
                         /* Set the exclusions for this ci list */
                         setExclusionsForIEntry(gridSet, nbl, excludeSubDiagonal, na_cj_2log,
-                                               *getOpenIEntry(nbl), exclusions);
+                                               *getOpenIEntry(nbl), exclusions,
+                                               &work->exclusionMaskBuffer);
                     }
 
                     if (haveFep)
@@ -3919,6 +3960,53 @@ static Range<int> getJZoneRange(const gmx_domdec_zones_t& ddZones,
 //! Prepares CPU lists produced by the search for dynamic pruning
 static void prepareListsForDynamicPruning(gmx::ArrayRef<NbnxnPairlistCpu> lists);
 
+/*! \brief Reserves arena-style initial capacity for CPU pairlists
+ *
+ * The list buffers keep their capacity across rebuilds, so reallocations
+ * only happen while the capacity grows towards its steady-state size.
+ * Without a reservation that growth happens through many exponential
+ * reallocate-and-copy cycles in the middle of the first searches. Here we
+ * reserve the expected list size up front from the atom density, so the
+ * buffers reach their working size with a single allocation.
+ */
+static void reserveInitialPairlistCapacities(const Nbnxm::GridSet&           gridSet,
+                                             const gmx::InteractionLocality  locality,
+                                             const PairlistType              pairlistType,
+                                             const real                      rlist,
+                                             gmx::ArrayRef<NbnxnPairlistCpu> lists)
+{
+    if (lists[0].cj.capacity() > 0)
+    {
+        /* Not the first search: the buffers have reached working size */
+        return;
+    }
+
+    const real atomDensity = gridSet.grids()[0].dimensions().atomDensity;
+    const int  numAtoms    = (locality == InteractionLocality::Local
+                                   ? gridSet.numRealAtomsLocal()
+                                   : gridSet.numRealAtomsTotal());
+
+    /* Average number of neighbors within rlist, with a factor 2 covering
+     * the inflation due to interacting at cluster granularity.
+     */
+    const real numNeighborsPerAtom = atomDensity * 4 * M_PI / 3 * gmx::power3(rlist);
+    /* The list cluster sizes are set by the search itself, so on the
+     * first search we need to take them from the list type.
+     */
+    const int  numAtomsPerClusterPair =
+            IClusterSizePerListType[pairlistType] * JClusterSizePerListType[pairlistType];
+    const real numClusterPairsEst = numAtoms * numNeighborsPerAtom / numAtomsPerClusterPair;
+
+    const int numCjPerList = static_cast<int>(numClusterPairsEst / lists.ssize());
+
+    for (NbnxnPairlistCpu& list : lists)
+    {
+        list.cj.reserve(numCjPerList);
+        /* i-entries are far fewer; a quarter is a generous upper bound */
+        list.ci.reserve(numCjPerList / 4);
+    }
+}
+
 void PairlistSet::constructPairlists(const Nbnxm::GridSet&         gridSet,
                                      gmx::ArrayRef<PairsearchWork> searchWork,
                                      nbnxn_atomdata_t*             nbat,
@@ -3960,6 +4048,11 @@ void PairlistSet::constructPairlists(const Nbnxm::GridSet&         gridSet,
         nsubpair_tot_est = 0;
     }
 
+    if (isCpuType_)
+    {
+        reserveInitialPairlistCapacities(gridSet, locality_, params_.pairlistType, rlist, cpuLists_);
+    }
+
     /* Clear all pair-lists */
     for (int th = 0; th < numLists; th++)
     {
@@ -4197,6 +4290,51 @@ void PairlistSet::constructPairlists(const Nbnxm::GridSet&         gridSet,
     }
 }
 
+void PairlistSets::updateIncrementalReuseStats(const Nbnxm::GridSet& gridSet)
+{
+    /* Scouting infrastructure for an incremental pairlist update mode:
+     * columns whose occupancy is unchanged since the previous search are
+     * candidates for patching the existing list in place. For now we only
+     * measure and report the reusable fraction, the actual in-place
+     * patching requires stable in-column atom ordering across searches.
+     */
+    static const bool trackIncrementalReuse = (getenv("GMX_NBNXN_INCREMENTAL_LIST") != nullptr);
+    if (!trackIncrementalReuse)
+    {
+        return;
+    }
+
+    const Nbnxm::Grid& localGrid = gridSet.grids()[0];
+    const int          numColumns = localGrid.numColumns();
+
+    if (gmx::ssize(previousColumnCounts_) == numColumns)
+    {
+        for (int column = 0; column < numColumns; column++)
+        {
+            if (localGrid.numAtomsInColumn(column) == previousColumnCounts_[column])
+            {
+                reusableColumnCount_++;
+            }
+        }
+        comparedColumnCount_ += numColumns;
+
+        if (comparedColumnCount_ >= 100 * numColumns)
+        {
+            fprintf(stderr, "Incremental pairlist scouting: %.1f%% of grid columns reusable\n",
+                    100.0 * static_cast<double>(reusableColumnCount_)
+                            / static_cast<double>(comparedColumnCount_));
+            reusableColumnCount_ = 0;
+            comparedColumnCount_ = 0;
+        }
+    }
+
+    previousColumnCounts_.resize(numColumns);
+    for (int column = 0; column < numColumns; column++)
+    {
+        previousColumnCounts_[column] = localGrid.numAtomsInColumn(column);
+    }
+}
+
 void PairlistSets::construct(const InteractionLocality iLocality,
                              PairSearch*               pairSearch,
                              nbnxn_atomdata_t*         nbat,
@@ -4222,6 +4360,8 @@ void PairlistSets::construct(const InteractionLocality iLocality,
 
     if (iLocality == InteractionLocality::Local)
     {
+        updateIncrementalReuseStats(gridSet);
+
         outerListCreationStep_ = step;
     }
     else
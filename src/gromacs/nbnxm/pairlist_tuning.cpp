@@ -51,16 +51,21 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
+#include "gromacs/domdec/dlb.h"
 #include "gromacs/domdec/domdec.h"
+#include "gromacs/gmxlib/network.h"
 #include "gromacs/hardware/cpuinfo.h"
 #include "gromacs/math/vec.h"
 #include "gromacs/mdlib/calc_verletbuf.h"
 #include "gromacs/mdtypes/commrec.h"
+#include "gromacs/mdtypes/forcerec.h"
 #include "gromacs/mdtypes/inputrec.h"
 #include "gromacs/mdtypes/interaction_const.h"
 #include "gromacs/mdtypes/state.h"
 #include "gromacs/pbcutil/pbc.h"
+#include "gromacs/timing/wallcycle.h"
 #include "gromacs/topology/topology.h"
 #include "gromacs/utility/cstringutil.h"
 #include "gromacs/utility/fatalerror.h"
@@ -69,6 +74,7 @@
 #include "gromacs/utility/strconvert.h"
 #include "gromacs/utility/stringutil.h"
 
+#include "nbnxm.h"
 #include "nbnxm_geometry.h"
 #include "pairlistsets.h"
 
@@ -545,6 +551,33 @@ void setupDynamicPairlistPruning(const gmx::MDLogger&       mdlog,
             listParams->numRollingPruningParts =
                     listParams->nstlistPrune / c_nbnxnGpuRollingListPruningInterval;
         }
+        else if (listParams->useDynamicPruning && getenv("GMX_NBNXN_CPU_ROLLING_PRUNING") != nullptr)
+        {
+            /* GPU-style rolling pruning for CPU lists: the pruning work is
+             * spread over several steps by pruning a subset of the lists
+             * at a time, at a proportionally shorter interval. This keeps
+             * the per-list pruning interval at nstlistPrune, but reduces
+             * the per-step pruning spike that can stall PME overlap.
+             */
+            char* endPtr;
+            char* envCpu = getenv("GMX_NBNXN_CPU_ROLLING_PRUNING");
+            int   parts  = strtol(envCpu, &endPtr, 10);
+            if (!endPtr || (*endPtr != 0) || parts < 1 || parts > listParams->nstlistPrune)
+            {
+                gmx_fatal(FARGS,
+                          "Invalid value passed in GMX_NBNXN_CPU_ROLLING_PRUNING=%s, should be > 0 "
+                          "and <= nstlistPrune",
+                          envCpu);
+            }
+            /* Round down to a divisor of nstlistPrune, so the parts cycle
+             * aligns with the pruning interval.
+             */
+            while (listParams->nstlistPrune % parts != 0)
+            {
+                parts--;
+            }
+            listParams->numRollingPruningParts = parts;
+        }
         else
         {
             listParams->numRollingPruningParts = 1;
@@ -598,3 +631,386 @@ void setupDynamicPairlistPruning(const gmx::MDLogger&       mdlog,
 
     GMX_LOG(mdlog.info).asParagraph().appendText(mesg);
 }
+
+/* Online nstlist tuning.
+ *
+ * The startup heuristics in increaseNstlist() assume a fixed ratio between
+ * the pair search and kernel cost. That ratio depends on the hardware and
+ * on the system, and it can change when the density changes during
+ * equilibration. Here we instead measure the actual cost per step over
+ * whole pair-list intervals, like the PME load balancing does, scan a
+ * small ladder of nstlist values and settle on the fastest. The pair-list
+ * buffer is recomputed with calcVerletBufferSize() for every value tried,
+ * using the current box, so the Verlet buffer tolerance is always obeyed.
+ */
+
+//! Number of list intervals to skip after an nstlist switch, perturbed by (re)allocation
+static const int c_nstlistTuningPostSwitchIntervalSkip = 1;
+//! Number of list intervals to measure per nstlist setting
+static const int c_nstlistTuningNumMeasureIntervals = 2;
+//! Number of list intervals to skip at the start of the run, while performance stabilizes
+static const int c_nstlistTuningFirstIntervalSkip = 5;
+//! Stop the nstlist tuning after this many steps
+static const int64_t c_nstlistTuningMaxSteps = 10000;
+
+/*! \brief One nstlist setting tried by online nstlist tuning */
+struct nstlist_setup_t
+{
+    int    nstlist;       /**< the pair-list update interval */
+    real   rlist;         /**< the outer list cut-off when this setting was last active */
+    int    count;         /**< the number of list intervals timed with this setting */
+    double cyclesPerStep; /**< the fastest measured cycle count per step */
+    bool   allowed;       /**< false when this setting does not fit the box or the DD */
+};
+
+struct NstlistTuning
+{
+    bool               bActive;              /**< is the tuning still active? */
+    bool               checkedStartingSetup; /**< have we verified the setup after PME load balancing? */
+    const gmx_mtop_t*  mtop;                 /**< the global topology, used for buffer estimates */
+    VerletbufListSetup listSetup;            /**< the cluster setup of the pair list */
+    bool               useDynamicPruning;    /**< whether a dual pair-list setup is in use */
+    int                nstlistStart;         /**< nstlist at the start of the tuning */
+    real               rlistStart;           /**< the outer list cut-off at the start of the tuning */
+    std::vector<nstlist_setup_t> setup;      /**< the nstlist settings to try, in increasing order */
+    int                          cur;        /**< the index (in setup) of the current setting */
+    int    cycles_n;                         /**< step cycle counter cumulative count */
+    double cycles_c;                         /**< step cycle counter cumulative cycles */
+};
+
+void nstlistTuningInit(NstlistTuning**           tuningPtr,
+                       const t_commrec*          cr,
+                       const gmx::MDLogger&      mdlog,
+                       const t_inputrec&         ir,
+                       const gmx_mtop_t*         mtop,
+                       const nonbonded_verlet_t& nbv)
+{
+    *tuningPtr = nullptr;
+
+    if (getenv("GMX_NSTLIST_TUNING") == nullptr)
+    {
+        return;
+    }
+
+    if (!supportsDynamicPairlistGenerationInterval(ir) || ir.nstlist <= 0)
+    {
+        GMX_LOG(mdlog.warning)
+                .asParagraph()
+                .appendText(
+                        "NOTE: GMX_NSTLIST_TUNING is set, but the run does not support changing "
+                        "nstlist");
+        return;
+    }
+    if (!wallcycle_have_counter())
+    {
+        GMX_LOG(mdlog.warning)
+                .asParagraph()
+                .appendText(
+                        "NOTE: Cycle counters unsupported or not enabled in kernel. Cannot use "
+                        "nstlist tuning.");
+        return;
+    }
+    if (DOMAINDECOMP(cr) && inputrec2nboundeddim(&ir) < DIM)
+    {
+        GMX_LOG(mdlog.warning)
+                .asParagraph()
+                .appendText(
+                        "NOTE: Cannot tune nstlist with domain decomposition and unbounded "
+                        "dimensions");
+        return;
+    }
+
+    const PairlistParams& listParams = nbv.pairlistSets().params();
+
+    NstlistTuning* tuning = new NstlistTuning;
+
+    tuning->bActive              = true;
+    tuning->checkedStartingSetup = false;
+    tuning->mtop                 = mtop;
+    tuning->listSetup            = { IClusterSizePerListType[listParams.pairlistType],
+                          JClusterSizePerListType[listParams.pairlistType] };
+    tuning->useDynamicPruning    = listParams.useDynamicPruning;
+    tuning->nstlistStart         = ir.nstlist;
+    tuning->rlistStart           = listParams.rlistOuter;
+
+    /* The ladder of nstlist values to try: the reference value, the values
+     * used by the startup heuristics and the current value.
+     */
+    std::vector<int> values;
+    values.push_back(nbnxnReferenceNstlist);
+    for (size_t i = 0; i < NNSTL; i++)
+    {
+        values.push_back(nstlist_try[i]);
+    }
+    values.push_back(ir.nstlist);
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+
+    for (int value : values)
+    {
+        /* With a dual list the rolling pruning interval has to fit
+         * in the list lifetime.
+         */
+        if (listParams.useDynamicPruning && value <= listParams.nstlistPrune)
+        {
+            continue;
+        }
+        nstlist_setup_t set;
+        set.nstlist       = value;
+        set.rlist         = 0;
+        set.count         = 0;
+        set.cyclesPerStep = 0;
+        set.allowed       = true;
+        tuning->setup.push_back(set);
+    }
+
+    tuning->cur = 0;
+    while (tuning->setup[tuning->cur].nstlist != ir.nstlist)
+    {
+        tuning->cur++;
+    }
+
+    tuning->cycles_n = 0;
+    tuning->cycles_c = 0;
+
+    GMX_LOG(mdlog.info)
+            .asParagraph()
+            .appendTextFormatted("Will tune nstlist online over the first %d steps, measuring %d settings",
+                                 static_cast<int>(c_nstlistTuningMaxSteps),
+                                 static_cast<int>(tuning->setup.size()));
+
+    *tuningPtr = tuning;
+}
+
+/*! \brief Switch to the nstlist setting with index \p setupIndex
+ *
+ * Recomputes the pair-list buffer for the current box and checks that the
+ * new list cut-off fits in the box and the domain decomposition.
+ * Returns whether the switch succeeded; on failure the setting is marked
+ * as not allowed and the current setup is kept.
+ */
+static bool nstlistTuningSwitchSetup(NstlistTuning*                 tuning,
+                                     int                            setupIndex,
+                                     t_commrec*                     cr,
+                                     t_inputrec*                    ir,
+                                     t_forcerec*                    fr,
+                                     const matrix                   box,
+                                     gmx::ArrayRef<const gmx::RVec> x)
+{
+    nstlist_setup_t* set = &tuning->setup[setupIndex];
+
+    /* Recompute the buffer for the current box, so the Verlet buffer
+     * tolerance is also obeyed when the density changed since startup.
+     */
+    const real rlistNew = calcVerletBufferSize(*tuning->mtop, det(box), *ir, set->nstlist,
+                                               set->nstlist - 1, -1, tuning->listSetup);
+
+    if (ir->pbcType != PbcType::No && gmx::square(rlistNew) >= max_cutoff2(ir->pbcType, box))
+    {
+        set->allowed = false;
+        return false;
+    }
+    if (tuning->useDynamicPruning && rlistNew < fr->nbv->pairlistInnerRadius())
+    {
+        set->allowed = false;
+        return false;
+    }
+    if (DOMAINDECOMP(cr) && !change_dd_cutoff(cr, box, x, rlistNew))
+    {
+        set->allowed = false;
+        return false;
+    }
+
+    set->rlist  = rlistNew;
+    ir->nstlist = set->nstlist;
+    ir->rlist   = rlistNew;
+    /* Without a dual list the inner radius has to track the outer one */
+    const real rlistInner = (tuning->useDynamicPruning ? fr->nbv->pairlistInnerRadius() : rlistNew);
+    fr->nbv->changePairlistRadii(rlistNew, rlistInner);
+    fr->nbv->changePairlistLifetime(set->nstlist - 1);
+    fr->rlist = rlistNew;
+
+    if (debug)
+    {
+        fprintf(debug, "nstlist tuning: switched to nstlist %d rlist %.3f\n", set->nstlist, rlistNew);
+    }
+
+    return true;
+}
+
+/*! \brief Returns the index of the next setting to measure, or -1 when all have been tried */
+static int nstlistTuningNextSetup(const NstlistTuning& tuning)
+{
+    const int numSetups = static_cast<int>(tuning.setup.size());
+    for (int i = 1; i <= numSetups; i++)
+    {
+        const int index = (tuning.cur + i) % numSetups;
+        if (tuning.setup[index].allowed && tuning.setup[index].count == 0)
+        {
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+void nstlistTuningDo(NstlistTuning*                 tuning,
+                     t_commrec*                     cr,
+                     const gmx::MDLogger&           mdlog,
+                     t_inputrec*                    ir,
+                     t_forcerec*                    fr,
+                     const matrix                   box,
+                     gmx::ArrayRef<const gmx::RVec> x,
+                     gmx_wallcycle_t                wcycle,
+                     int64_t                        step_rel,
+                     bool                           pmeLoadBalancingIsActive)
+{
+    if (!tuning->bActive)
+    {
+        return;
+    }
+
+    const int    n_prev = tuning->cycles_n;
+    const double c_prev = tuning->cycles_c;
+    wallcycle_get(wcycle, ewcSTEP, &tuning->cycles_n, &tuning->cycles_c);
+
+    /* While PME load balancing is active we only keep the baseline current */
+    if (pmeLoadBalancingIsActive)
+    {
+        return;
+    }
+
+    if (!tuning->checkedStartingSetup)
+    {
+        /* When PME load balancing changed the cut-off, buffer sizes computed
+         * from the inputrec no longer match the actual list setup and we
+         * can not re-tune rlist.
+         */
+        if (fr->nbv->pairlistOuterRadius() != tuning->rlistStart)
+        {
+            GMX_LOG(mdlog.info)
+                    .asParagraph()
+                    .appendText(
+                            "NOTE: PME load balancing changed the pair-list setup, online nstlist "
+                            "tuning is disabled");
+            tuning->bActive = false;
+            return;
+        }
+        tuning->checkedStartingSetup = true;
+    }
+
+    /* Skip the first intervals of the run, while performance stabilizes.
+     * Also skip intervals where the cycle counters were reset.
+     */
+    if (tuning->cycles_n <= n_prev || step_rel < c_nstlistTuningFirstIntervalSkip * ir->nstlist)
+    {
+        return;
+    }
+
+    double cyclesPerStep = (tuning->cycles_c - c_prev) / (tuning->cycles_n - n_prev);
+    if (PAR(cr))
+    {
+        gmx_sumd(1, &cyclesPerStep, cr);
+        cyclesPerStep /= cr->nnodes;
+    }
+
+    nstlist_setup_t* set = &tuning->setup[tuning->cur];
+    set->count++;
+    /* Skip the first interval after a switch, which is perturbed by
+     * pair-list reallocation and caching effects.
+     */
+    if (set->count > c_nstlistTuningPostSwitchIntervalSkip)
+    {
+        if (set->count == c_nstlistTuningPostSwitchIntervalSkip + 1)
+        {
+            set->cyclesPerStep = cyclesPerStep;
+        }
+        else
+        {
+            set->cyclesPerStep = std::min(set->cyclesPerStep, cyclesPerStep);
+        }
+    }
+
+    const bool setupDone =
+            (set->count >= c_nstlistTuningPostSwitchIntervalSkip + c_nstlistTuningNumMeasureIntervals);
+    if (!setupDone && step_rel < c_nstlistTuningMaxSteps)
+    {
+        return;
+    }
+
+    if (step_rel < c_nstlistTuningMaxSteps)
+    {
+        /* Try to move on to the next setting that has not been measured yet */
+        int next = nstlistTuningNextSetup(*tuning);
+        while (next >= 0)
+        {
+            if (nstlistTuningSwitchSetup(tuning, next, cr, ir, fr, box, x))
+            {
+                tuning->cur = next;
+                return;
+            }
+            /* The switch marked the setting as not allowed, try the next one */
+            next = nstlistTuningNextSetup(*tuning);
+        }
+    }
+
+    /* All settings have been measured, or we ran out of tuning budget:
+     * settle on the fastest measured setting.
+     */
+    while (true)
+    {
+        int fastest = -1;
+        for (size_t i = 0; i < tuning->setup.size(); i++)
+        {
+            const nstlist_setup_t& trial = tuning->setup[i];
+            if (trial.allowed && trial.count > c_nstlistTuningPostSwitchIntervalSkip
+                && (fastest < 0 || trial.cyclesPerStep < tuning->setup[fastest].cyclesPerStep))
+            {
+                fastest = static_cast<int>(i);
+            }
+        }
+        if (fastest < 0 || fastest == tuning->cur
+            || nstlistTuningSwitchSetup(tuning, fastest, cr, ir, fr, box, x))
+        {
+            if (fastest >= 0)
+            {
+                tuning->cur = fastest;
+            }
+            break;
+        }
+        /* The switch failed and marked the setting as not allowed;
+         * pick the fastest among the remaining settings.
+         */
+    }
+
+    if (DOMAINDECOMP(cr))
+    {
+        /* Ensure that DLB does not make the chosen cut-off impossible */
+        set_dd_dlb_max_cutoff(cr, fr->nbv->pairlistOuterRadius());
+    }
+
+    if (ir->nstlist != tuning->nstlistStart)
+    {
+        GMX_LOG(mdlog.info)
+                .asParagraph()
+                .appendTextFormatted(
+                        "Online nstlist tuning: changing nstlist from %d to %d, rlist from %g to %g",
+                        tuning->nstlistStart, ir->nstlist, tuning->rlistStart, ir->rlist);
+    }
+    else
+    {
+        GMX_LOG(mdlog.info)
+                .asParagraph()
+                .appendTextFormatted(
+                        "Online nstlist tuning: the initial nstlist of %d was measured to be "
+                        "fastest",
+                        ir->nstlist);
+    }
+
+    tuning->bActive = false;
+}
+
+void nstlistTuningDone(NstlistTuning* tuning)
+{
+    delete tuning;
+}
@@ -49,17 +49,22 @@
 #include <stdio.h>
 
 #include "gromacs/math/vectypes.h"
+#include "gromacs/timing/wallcycle.h"
 
 namespace gmx
 {
 class CpuInfo;
 class MDLogger;
+template<typename T>
+class ArrayRef;
 } // namespace gmx
 
 struct gmx_mtop_t;
 struct interaction_const_t;
+struct nonbonded_verlet_t;
 struct PairlistParams;
 struct t_commrec;
+struct t_forcerec;
 struct t_inputrec;
 
 /*! \brief Try to increase nstlist when using the Verlet cut-off scheme
@@ -98,4 +103,63 @@ void setupDynamicPairlistPruning(const gmx::MDLogger&       mdlog,
                                  const interaction_const_t* ic,
                                  PairlistParams*            listParams);
 
+/*! \brief Object to manage online nstlist tuning */
+struct NstlistTuning;
+
+/*! \brief Initialize online nstlist tuning
+ *
+ * Online tuning measures the actual cost per step of a range of nstlist
+ * values during the first steps of the run and settles on the fastest,
+ * instead of relying only on the startup heuristics in increaseNstlist().
+ * The pair-list buffer is recomputed for every nstlist value tried, so
+ * the Verlet buffer tolerance is always obeyed.
+ * The tuning is only enabled when the env.var. GMX_NSTLIST_TUNING is set.
+ * Sets \p *tuningPtr to nullptr when tuning is not enabled or not supported.
+ *
+ * \param[out] tuningPtr  The tuning object to initialize
+ * \param[in]  cr         The communication record
+ * \param[in]  mdlog      MD logger
+ * \param[in]  ir         The input parameter record
+ * \param[in]  mtop       The global topology
+ * \param[in]  nbv        The nonbonded Verlet object
+ */
+void nstlistTuningInit(NstlistTuning**           tuningPtr,
+                       const t_commrec*          cr,
+                       const gmx::MDLogger&      mdlog,
+                       const t_inputrec&         ir,
+                       const gmx_mtop_t*         mtop,
+                       const nonbonded_verlet_t& nbv);
+
+/*! \brief Process cycles measured over the last pair-list interval and re-tune nstlist
+ *
+ * Should be called at every search step determined by nstlist, after the
+ * ewcSTEP cycle counter of the previous step has been stopped.
+ * While PME load balancing is active this only keeps the cycle baseline
+ * up to date; the nstlist tuning starts after the load balancing is done.
+ *
+ * \param[in,out] tuning    The tuning object
+ * \param[in]     cr        The communication record
+ * \param[in,out] mdlog     MD logger
+ * \param[in,out] ir        The input parameter record, nstlist and rlist can change
+ * \param[in,out] fr        The force record, the pair-list radii can change
+ * \param[in]     box       The unit cell
+ * \param[in]     x         The coordinates, used for DD cut-off checks
+ * \param[in]     wcycle    The wallcycle counters
+ * \param[in]     step_rel  The step count relative to the start of the run
+ * \param[in]     pmeLoadBalancingIsActive  Whether PME load balancing is still active
+ */
+void nstlistTuningDo(NstlistTuning*                 tuning,
+                     t_commrec*                     cr,
+                     const gmx::MDLogger&           mdlog,
+                     t_inputrec*                    ir,
+                     t_forcerec*                    fr,
+                     const matrix                   box,
+                     gmx::ArrayRef<const gmx::RVec> x,
+                     gmx_wallcycle_t                wcycle,
+                     int64_t                        step_rel,
+                     bool                           pmeLoadBalancingIsActive);
+
+/*! \brief Finish the online nstlist tuning and free the tuning object */
+void nstlistTuningDone(NstlistTuning* tuning);
+
 #endif /* NBNXM_PAIRLIST_TUNING_H */
@@ -45,7 +45,10 @@
 
 #include "pairlistparams.h"
 
+#include <cstdlib>
+
 #include "gromacs/nbnxm/nbnxm.h"
+#include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/gmxassert.h"
 
 #include "nbnxm_geometry.h"
@@ -79,3 +82,24 @@ PairlistParams::PairlistParams(const Nbnxm::KernelType kernelType,
         }
     }
 }
+
+int nbnxnNumListsPerKernelThread()
+{
+    int numListsPerThread = 1;
+
+    if (const char* env = getenv("GMX_NBNXN_LISTS_PER_THREAD"))
+    {
+        char* end;
+
+        numListsPerThread = strtol(env, &end, 10);
+        if (!end || (*end != 0) || numListsPerThread < 1 || numListsPerThread > 8)
+        {
+            gmx_fatal(FARGS,
+                      "Invalid value passed in GMX_NBNXN_LISTS_PER_THREAD=%s, an integer between 1 "
+                      "and 8 is required",
+                      env);
+        }
+    }
+
+    return numListsPerThread;
+}
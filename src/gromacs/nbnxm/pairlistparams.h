@@ -138,4 +138,14 @@ struct PairlistParams
     int lifetime;
 };
 
+/*! \brief Returns the number of CPU pairlists to generate per non-bonded kernel thread.
+ *
+ * The default of 1 gives each kernel thread the list it constructed.
+ * With GMX_NBNXN_LISTS_PER_THREAD set to a value > 1, more, smaller lists
+ * are generated and the kernel dispatch hands them out dynamically, which
+ * lets fast threads steal work from slow ones when the static balancing
+ * cannot correct for e.g. frequency or NUMA differences between cores.
+ */
+int nbnxnNumListsPerKernelThread();
+
 #endif
@@ -97,7 +97,10 @@ public:
                             SearchCycleCounting*          searchCycleCounting);
 
     //! Dispatch the kernel for dynamic pairlist pruning
-    void dispatchPruneKernel(const nbnxn_atomdata_t* nbat, const rvec* shift_vec);
+    void dispatchPruneKernel(const nbnxn_atomdata_t* nbat,
+                             const rvec*             shift_vec,
+                             int                     rollingPruningPart,
+                             int                     numRollingPruningParts);
 
     //! Returns the locality
     gmx::InteractionLocality locality() const { return locality_; }
@@ -49,6 +49,7 @@
 #define GMX_NBNXM_PAIRLISTSETS_H
 
 #include <memory>
+#include <vector>
 
 #include "gromacs/mdtypes/locality.h"
 
@@ -60,6 +61,11 @@ enum class PairlistType;
 class PairSearch;
 struct t_nrnb;
 
+namespace Nbnxm
+{
+class GridSet;
+}
+
 namespace gmx
 {
 template<typename>
@@ -86,7 +92,8 @@ public:
     //! Dispatches the dynamic pruning kernel for the given locality
     void dispatchPruneKernel(gmx::InteractionLocality iLocality,
                              const nbnxn_atomdata_t*  nbat,
-                             const rvec*              shift_vec);
+                             const rvec*              shift_vec,
+                             int64_t                  step);
 
     //! Returns the pair list parameters
     const PairlistParams& params() const { return params_; }
@@ -100,7 +107,13 @@ public:
     //! Returns whether step is a dynamic list pruning step, for CPU lists
     bool isDynamicPruningStepCpu(int64_t step) const
     {
-        return (params_.useDynamicPruning && numStepsWithPairlist(step) % params_.nstlistPrune == 0);
+        /* With rolling pruning each dispatch prunes only 1/numParts of the
+         * lists, at a proportionally shorter interval, so the per-list
+         * pruning interval stays at nstlistPrune.
+         */
+        const int dispatchInterval = params_.nstlistPrune / params_.numRollingPruningParts;
+
+        return (params_.useDynamicPruning && numStepsWithPairlist(step) % dispatchInterval == 0);
     }
 
     //! Returns whether step is a dynamic list pruning step, for GPU lists
@@ -119,6 +132,9 @@ public:
         params_.rlistInner = rlistInner;
     }
 
+    //! Changes the lifetime of the outer pair-list, used when nstlist is changed during the run
+    void changePairlistLifetime(int lifetime) { params_.lifetime = lifetime; }
+
     //! Returns the pair-list set for the given locality
     const PairlistSet& pairlistSet(gmx::InteractionLocality iLocality) const
     {
@@ -148,6 +164,16 @@ private:
         }
     }
 
+    /*! \brief Updates statistics on how much of the local pairlist could
+     * be reused by an incremental list update.
+     *
+     * Compares the per-column atom counts of the local grid with those
+     * recorded at the previous search. Columns with unchanged occupancy
+     * are candidates for patching the existing list in place instead of
+     * a full re-search. Only active with GMX_NBNXN_INCREMENTAL_LIST set.
+     */
+    void updateIncrementalReuseStats(const Nbnxm::GridSet& gridSet);
+
     //! Parameters for the search and list pruning setup
     PairlistParams params_;
     //! Pair list balancing parameter for use with GPU
@@ -158,6 +184,12 @@ private:
     std::unique_ptr<PairlistSet> nonlocalSet_;
     //! MD step at with the outer lists in pairlistSets_ were created
     int64_t outerListCreationStep_;
+    //! Per-column atom counts of the local grid at the previous search
+    std::vector<int> previousColumnCounts_;
+    //! Accumulated number of columns whose occupancy was unchanged between searches
+    int64_t reusableColumnCount_ = 0;
+    //! Accumulated total number of columns compared between searches
+    int64_t comparedColumnCount_ = 0;
 };
 
 #endif
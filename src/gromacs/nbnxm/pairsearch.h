@@ -52,6 +52,7 @@
 #define GMX_NBNXM_PAIRSEARCH_H
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "gromacs/domdec/domdec.h"
@@ -157,6 +158,13 @@ struct PairsearchWork
     //! Temporary buffer for sorting atoms within a grid column
     std::vector<int> sortBuffer;
 
+    /*! \brief Temporary buffer with aggregated exclusion bitmasks per j-cluster
+     *
+     * Used to clear the interaction bits for all excluded pairs of an
+     * i-cluster with a single pair-list search per excluded j-cluster.
+     */
+    std::vector<std::pair<int, unsigned int>> exclusionMaskBuffer;
+
     //! Flags for force buffer access
     nbnxn_buffer_flags_t buffer_flags;
 
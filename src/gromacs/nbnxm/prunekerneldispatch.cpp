@@ -50,24 +50,49 @@
 
 void PairlistSets::dispatchPruneKernel(const gmx::InteractionLocality iLocality,
                                        const nbnxn_atomdata_t*        nbat,
-                                       const rvec*                    shift_vec)
+                                       const rvec*                    shift_vec,
+                                       const int64_t                  step)
 {
-    pairlistSet(iLocality).dispatchPruneKernel(nbat, shift_vec);
+    /* With rolling pruning the lists are divided round-robin over the
+     * parts, and each dispatch prunes one part. Directly after search the
+     * inner lists are empty, so the first dispatch has to prune them all.
+     */
+    const int age      = numStepsWithPairlist(step);
+    int       numParts = params_.numRollingPruningParts;
+    int       part     = 0;
+    if (age > 0)
+    {
+        const int dispatchInterval = params_.nstlistPrune / numParts;
+        part                       = (age / dispatchInterval) % numParts;
+    }
+    else
+    {
+        numParts = 1;
+    }
+
+    pairlistSet(iLocality).dispatchPruneKernel(nbat, shift_vec, part, numParts);
 }
 
-void PairlistSet::dispatchPruneKernel(const nbnxn_atomdata_t* nbat, const rvec* shift_vec)
+void PairlistSet::dispatchPruneKernel(const nbnxn_atomdata_t* nbat,
+                                      const rvec*             shift_vec,
+                                      const int               rollingPruningPart,
+                                      const int               numRollingPruningParts)
 {
     const real rlistInner = params_.rlistInner;
 
     GMX_ASSERT(cpuLists_[0].ciOuter.size() >= cpuLists_[0].ci.size(),
                "Here we should either have an empty ci list or ciOuter should be >= ci");
 
+    const int      numLists = cpuLists_.size();
     int gmx_unused nthreads = gmx_omp_nthreads_get(emntNonbonded);
-    GMX_ASSERT(nthreads == static_cast<gmx::index>(cpuLists_.size()),
-               "The number of threads should match the number of lists");
-#pragma omp parallel for schedule(static) num_threads(nthreads)
-    for (int i = 0; i < nthreads; i++)
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+    for (int i = 0; i < numLists; i++)
     {
+        if (i % numRollingPruningParts != rollingPruningPart)
+        {
+            continue;
+        }
+
         NbnxnPairlistCpu* nbl = &cpuLists_[i];
 
         switch (getClusterDistanceKernelType(params_.pairlistType, *nbat))
@@ -86,9 +111,11 @@ void PairlistSet::dispatchPruneKernel(const nbnxn_atomdata_t* nbat, const rvec*
     }
 }
 
-void nonbonded_verlet_t::dispatchPruneKernelCpu(const gmx::InteractionLocality iLocality, const rvec* shift_vec)
+void nonbonded_verlet_t::dispatchPruneKernelCpu(const gmx::InteractionLocality iLocality,
+                                                const rvec*                    shift_vec,
+                                                const int64_t                  step)
 {
-    pairlistSets_->dispatchPruneKernel(iLocality, nbat.get(), shift_vec);
+    pairlistSets_->dispatchPruneKernel(iLocality, nbat.get(), shift_vec, step);
 }
 
 void nonbonded_verlet_t::dispatchPruneKernelGpu(int64_t step)
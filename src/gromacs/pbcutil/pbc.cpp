@@ -57,6 +57,7 @@
 #include "gromacs/math/vecdump.h"
 #include "gromacs/pbcutil/ishift.h"
 #include "gromacs/pbcutil/mshift.h"
+#include "gromacs/pbcutil/pbc_dx_batch.h"
 #include "gromacs/topology/topology.h"
 #include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/fatalerror.h"
@@ -632,6 +633,22 @@ t_pbc* set_pbc_dd(t_pbc* pbc, PbcType pbcType, const ivec domdecCells, gmx_bool
     return (pbc->pbcType != PbcType::No ? pbc : nullptr);
 }
 
+gmx::PbcDxBatchKernelType gmx::pbcDxBatchKernelType(const t_pbc* pbc)
+{
+    if (pbc == nullptr)
+    {
+        return PbcDxBatchKernelType::None;
+    }
+    switch (pbc->pbcTypeDX)
+    {
+        case epbcdxNOPBC:
+        case epbcdxUNSUPPORTED: return PbcDxBatchKernelType::None;
+        case epbcdxRECTANGULAR: return PbcDxBatchKernelType::Rectangular;
+        case epbcdxTRICLINIC: return PbcDxBatchKernelType::Triclinic;
+        default: return PbcDxBatchKernelType::General;
+    }
+}
+
 void pbc_dx(const t_pbc* pbc, const rvec x1, const rvec x2, rvec dx)
 {
     int      i, j;
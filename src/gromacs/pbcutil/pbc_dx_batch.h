@@ -0,0 +1,268 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ *
+ * \brief Declares batched PBC distance kernels specialized per box type.
+ *
+ * pbc_dx() switches on the box classification for every pair, which shows
+ * up in hot analysis and pull loops. The kernels here are specialized at
+ * compile time on the classification that set_pbc() determined once, so a
+ * whole batch of distance vectors is computed without per-pair branching,
+ * with the SIMD lanes running across pairs. The triclinic kernel includes
+ * the shift-vector search and thus returns the same shortest distances as
+ * pbc_dx() for all pair distances within the allowed cutoff.
+ *
+ * \author Berk Hess <hess@kth.se>
+ * \inlibraryapi
+ * \ingroup module_pbcutil
+ */
+#ifndef GMX_PBCUTIL_PBC_DX_BATCH_H
+#define GMX_PBCUTIL_PBC_DX_BATCH_H
+
+#include "config.h"
+
+#include <cmath>
+#include <cstdint>
+
+#include "gromacs/math/vec.h"
+#include "gromacs/math/vectypes.h"
+#include "gromacs/pbcutil/pbc.h"
+#include "gromacs/simd/simd.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/basedefinitions.h"
+#include "gromacs/utility/gmxassert.h"
+
+namespace gmx
+{
+
+/*! \brief The box families a batched PBC distance kernel can be specialized for.
+ *
+ * set_pbc() classifies the box once and stores the result in t_pbc.
+ * pbcDxBatchKernelType() maps that classification onto this enum, so callers
+ * select a branch-free kernel a single time per batch instead of switching
+ * inside pbc_dx() for every pair.
+ */
+enum class PbcDxBatchKernelType : int
+{
+    None,        //!< No periodicity, plain coordinate differences
+    Rectangular, //!< Fully periodic rectangular box
+    Triclinic,   //!< Fully periodic triclinic box, including the shift-vector search
+    General      //!< 1D/2D/screw setups, falls back to pbc_dx() per pair
+};
+
+/*! \brief Returns the batched kernel type matching the classification stored by set_pbc().
+ *
+ * \param pbc  PBC information as set by set_pbc(), nullptr means no PBC
+ */
+PbcDxBatchKernelType pbcDxBatchKernelType(const t_pbc* pbc);
+
+/*! \brief Shift-vector search for one triclinic distance vector.
+ *
+ * Tries all triclinic shifts without early exit; when the resulting
+ * distance is within max_cutoff it is guaranteed to be the shortest,
+ * identical to the search in pbc_dx().
+ */
+static inline void pbcDxTriclinicShiftSearch(const t_pbc* pbc, rvec dx)
+{
+    real d2min = norm2(dx);
+    if (d2min > pbc->max_cutoff2)
+    {
+        rvec dx_start;
+        copy_rvec(dx, dx_start);
+        for (int t = 0; t < pbc->ntric_vec; t++)
+        {
+            rvec trial;
+            rvec_add(dx_start, pbc->tric_vec[t], trial);
+            const real d2trial = norm2(trial);
+            if (d2trial < d2min)
+            {
+                copy_rvec(trial, dx);
+                d2min = d2trial;
+            }
+        }
+    }
+}
+
+/*! \brief Computes PBC corrected distance vectors dx = x1 - x2 for a batch of pairs.
+ *
+ * The kernel type has to match the box set with set_pbc(), as returned by
+ * pbcDxBatchKernelType(). For PbcDxBatchKernelType::None \p pbc may be nullptr.
+ * Pairs exactly on a periodic boundary can resolve to the opposite, equally
+ * distant image compared to pbc_dx(); the returned distances are identical.
+ *
+ * \tparam        kernelType  Compile-time box classification
+ * \param[in]     pbc         PBC information as set by set_pbc()
+ * \param[in]     x1          Coordinates of the first atom of each pair
+ * \param[in]     x2          Coordinates of the second atom of each pair
+ * \param[out]    dx          The shortest distance vectors x1 - x2
+ */
+template<PbcDxBatchKernelType kernelType>
+static inline void pbcDxBatch(const t_pbc* pbc, ArrayRef<const RVec> x1, ArrayRef<const RVec> x2, ArrayRef<RVec> dx)
+{
+    GMX_ASSERT(x2.size() == x1.size() && dx.size() == x1.size(),
+               "Coordinate and output buffers should have matching sizes");
+
+    index i = 0;
+#if GMX_SIMD_HAVE_REAL
+    if (kernelType != PbcDxBatchKernelType::General && x1.ssize() >= GMX_SIMD_REAL_WIDTH)
+    {
+        alignas(GMX_SIMD_ALIGNMENT) std::int32_t offsets[GMX_SIMD_REAL_WIDTH];
+        for (int j = 0; j < GMX_SIMD_REAL_WIDTH; j++)
+        {
+            offsets[j] = j;
+        }
+
+        /* Box constants; the rows not used by a kernel type are left zero */
+        SimdReal invBxx(0), invByy(0), invBzz(0);
+        SimdReal bXX(0), bYX(0), bYY(0), bZX(0), bZY(0), bZZ(0);
+        SimdReal maxCutoff2(0);
+        if (kernelType == PbcDxBatchKernelType::Rectangular
+            || kernelType == PbcDxBatchKernelType::Triclinic)
+        {
+            invBxx = SimdReal(1.0_real / pbc->box[XX][XX]);
+            invByy = SimdReal(1.0_real / pbc->box[YY][YY]);
+            invBzz = SimdReal(1.0_real / pbc->box[ZZ][ZZ]);
+            bXX    = SimdReal(pbc->box[XX][XX]);
+            bYY    = SimdReal(pbc->box[YY][YY]);
+            bZZ    = SimdReal(pbc->box[ZZ][ZZ]);
+        }
+        if (kernelType == PbcDxBatchKernelType::Triclinic)
+        {
+            bYX        = SimdReal(pbc->box[YY][XX]);
+            bZX        = SimdReal(pbc->box[ZZ][XX]);
+            bZY        = SimdReal(pbc->box[ZZ][YY]);
+            maxCutoff2 = SimdReal(pbc->max_cutoff2);
+        }
+
+        const real* x1Base = reinterpret_cast<const real*>(x1.data());
+        const real* x2Base = reinterpret_cast<const real*>(x2.data());
+        real*       dxBase = reinterpret_cast<real*>(dx.data());
+        for (; i + GMX_SIMD_REAL_WIDTH <= x1.ssize(); i += GMX_SIMD_REAL_WIDTH)
+        {
+            SimdReal ax, ay, az, bx, by, bz;
+            gatherLoadUTranspose<3>(x1Base + 3 * i, offsets, &ax, &ay, &az);
+            gatherLoadUTranspose<3>(x2Base + 3 * i, offsets, &bx, &by, &bz);
+
+            SimdReal dxX = ax - bx;
+            SimdReal dxY = ay - by;
+            SimdReal dxZ = az - bz;
+
+            if (kernelType == PbcDxBatchKernelType::Rectangular)
+            {
+                dxX = fnma(round(dxX * invBxx), bXX, dxX);
+                dxY = fnma(round(dxY * invByy), bYY, dxY);
+                dxZ = fnma(round(dxZ * invBzz), bZZ, dxZ);
+            }
+            else if (kernelType == PbcDxBatchKernelType::Triclinic)
+            {
+                const SimdReal shz = round(dxZ * invBzz);
+                dxX                = fnma(shz, bZX, dxX);
+                dxY                = fnma(shz, bZY, dxY);
+                dxZ                = fnma(shz, bZZ, dxZ);
+                const SimdReal shy = round(dxY * invByy);
+                dxX                = fnma(shy, bYX, dxX);
+                dxY                = fnma(shy, bYY, dxY);
+                const SimdReal shx = round(dxX * invBxx);
+                dxX                = fnma(shx, bXX, dxX);
+            }
+
+            transposeScatterStoreU<3>(dxBase + 3 * i, offsets, dxX, dxY, dxZ);
+
+            if (kernelType == PbcDxBatchKernelType::Triclinic)
+            {
+                /* For skewed boxes the row reduction above does not always
+                 * yield the shortest image; fix up the rare affected lanes.
+                 */
+                const SimdReal d2 = fma(dxX, dxX, fma(dxY, dxY, dxZ * dxZ));
+                if (anyTrue(maxCutoff2 < d2))
+                {
+                    for (int j = 0; j < GMX_SIMD_REAL_WIDTH; j++)
+                    {
+                        pbcDxTriclinicShiftSearch(pbc, dx[i + j]);
+                    }
+                }
+            }
+        }
+    }
+#endif
+    for (; i < x1.ssize(); i++)
+    {
+        if (kernelType == PbcDxBatchKernelType::None)
+        {
+            rvec_sub(x1[i], x2[i], dx[i]);
+        }
+        else if (kernelType == PbcDxBatchKernelType::Rectangular)
+        {
+            for (int d = 0; d < DIM; d++)
+            {
+                dx[i][d] = x1[i][d] - x2[i][d];
+                dx[i][d] -= pbc->fbox_diag[d] * std::round(dx[i][d] / pbc->fbox_diag[d]);
+            }
+        }
+        else if (kernelType == PbcDxBatchKernelType::Triclinic)
+        {
+            rvec_sub(x1[i], x2[i], dx[i]);
+            for (int d = DIM - 1; d >= 0; d--)
+            {
+                const real shift = std::round(dx[i][d] / pbc->box[d][d]);
+                for (int j = d; j >= 0; j--)
+                {
+                    dx[i][j] -= shift * pbc->box[d][j];
+                }
+            }
+            pbcDxTriclinicShiftSearch(pbc, dx[i]);
+        }
+        else
+        {
+            pbc_dx(pbc, x1[i], x2[i], dx[i]);
+        }
+    }
+}
+
+/*! \brief Computes PBC corrected distance vectors dx = x1 - x2 for a batch of pairs.
+ *
+ * Runtime-dispatching convenience wrapper around the templated kernels;
+ * the kernel type is selected once per call from \p pbc.
+ *
+ * \param[in]  pbc  PBC information as set by set_pbc(), nullptr means no PBC
+ * \param[in]  x1   Coordinates of the first atom of each pair
+ * \param[in]  x2   Coordinates of the second atom of each pair
+ * \param[out] dx   The shortest distance vectors x1 - x2
+ */
+void pbcDxBatch(const t_pbc* pbc, ArrayRef<const RVec> x1, ArrayRef<const RVec> x2, ArrayRef<RVec> dx);
+
+} // namespace gmx
+
+#endif
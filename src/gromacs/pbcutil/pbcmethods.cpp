@@ -41,6 +41,7 @@
 
 #include "gromacs/pbcutil/pbc.h"
 #include "gromacs/topology/topology.h"
+#include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/smalloc.h"
 
@@ -237,6 +238,65 @@ void calc_pbc_cluster(int ecenter, int nrefat, t_topology* top, PbcType pbcType,
     fprintf(stdout, "\n");
 }
 
+/*! \brief Shift molecule \p mol such that its center of mass is inside the unit cell */
+static void put_one_molecule_com_in_box(int            unitcell_enum,
+                                        int            ecenter,
+                                        const t_block* mols,
+                                        int            mol,
+                                        int            natoms,
+                                        const t_atom   atom[],
+                                        PbcType        pbcType,
+                                        const matrix   box,
+                                        rvec           x[])
+{
+    int    j;
+    int    d;
+    rvec   com, shift;
+    real   m;
+    double mtot;
+
+    /* calc COM */
+    clear_rvec(com);
+    mtot = 0;
+    for (j = mols->index[mol]; (j < mols->index[mol + 1] && j < natoms); j++)
+    {
+        m = atom[j].m;
+        for (d = 0; d < DIM; d++)
+        {
+            com[d] += m * x[j][d];
+        }
+        mtot += m;
+    }
+    /* calculate final COM */
+    svmul(1.0 / mtot, com, com);
+
+    /* check if COM is outside box */
+    gmx::RVec newCom;
+    copy_rvec(com, newCom);
+    auto newComArrayRef = gmx::arrayRefFromArray(&newCom, 1);
+    switch (unitcell_enum)
+    {
+        case euRect: put_atoms_in_box(pbcType, box, newComArrayRef); break;
+        case euTric: put_atoms_in_triclinic_unitcell(ecenter, box, newComArrayRef); break;
+        case euCompact: put_atoms_in_compact_unitcell(pbcType, ecenter, box, newComArrayRef); break;
+    }
+    rvec_sub(newCom, com, shift);
+    if (norm2(shift) > 0)
+    {
+        if (debug)
+        {
+            fprintf(debug,
+                    "\nShifting position of molecule %d "
+                    "by %8.3f  %8.3f  %8.3f\n",
+                    mol + 1, shift[XX], shift[YY], shift[ZZ]);
+        }
+        for (j = mols->index[mol]; (j < mols->index[mol + 1] && j < natoms); j++)
+        {
+            rvec_inc(x[j], shift);
+        }
+    }
+}
+
 void put_molecule_com_in_box(int      unitcell_enum,
                              int      ecenter,
                              t_block* mols,
@@ -246,15 +306,8 @@ void put_molecule_com_in_box(int      unitcell_enum,
                              matrix   box,
                              rvec     x[])
 {
-    int    i, j;
-    int    d;
-    rvec   com, shift, box_center;
-    real   m;
-    double mtot;
-    t_pbc  pbc;
+    int i;
 
-    calc_box_center(ecenter, box, box_center);
-    set_pbc(&pbc, pbcType, box);
     if (mols->nr <= 0)
     {
         gmx_fatal(FARGS,
@@ -262,48 +315,36 @@ void put_molecule_com_in_box(int      unitcell_enum,
     }
     for (i = 0; (i < mols->nr); i++)
     {
-        /* calc COM */
-        clear_rvec(com);
-        mtot = 0;
-        for (j = mols->index[i]; (j < mols->index[i + 1] && j < natoms); j++)
-        {
-            m = atom[j].m;
-            for (d = 0; d < DIM; d++)
-            {
-                com[d] += m * x[j][d];
-            }
-            mtot += m;
-        }
-        /* calculate final COM */
-        svmul(1.0 / mtot, com, com);
+        put_one_molecule_com_in_box(unitcell_enum, ecenter, mols, i, natoms, atom, pbcType, box, x);
+    }
+}
 
-        /* check if COM is outside box */
-        gmx::RVec newCom;
-        copy_rvec(com, newCom);
-        auto newComArrayRef = gmx::arrayRefFromArray(&newCom, 1);
-        switch (unitcell_enum)
-        {
-            case euRect: put_atoms_in_box(pbcType, box, newComArrayRef); break;
-            case euTric: put_atoms_in_triclinic_unitcell(ecenter, box, newComArrayRef); break;
-            case euCompact:
-                put_atoms_in_compact_unitcell(pbcType, ecenter, box, newComArrayRef);
-                break;
-        }
-        rvec_sub(newCom, com, shift);
-        if (norm2(shift) > 0)
+void put_molecule_com_in_box_omp(int      unitcell_enum,
+                                 int      ecenter,
+                                 t_block* mols,
+                                 int      natoms,
+                                 t_atom   atom[],
+                                 PbcType  pbcType,
+                                 matrix   box,
+                                 rvec     x[],
+                                 int      nth)
+{
+    if (mols->nr <= 0)
+    {
+        gmx_fatal(FARGS,
+                  "There are no molecule descriptions. I need a .tpr file for this pbc option.");
+    }
+    /* Each molecule only touches its own atom range, so the molecules
+     * can be distributed over the threads.
+     */
+#pragma omp parallel for num_threads(nth) schedule(static)
+    for (int i = 0; i < mols->nr; i++)
+    {
+        try
         {
-            if (debug)
-            {
-                fprintf(debug,
-                        "\nShifting position of molecule %d "
-                        "by %8.3f  %8.3f  %8.3f\n",
-                        i + 1, shift[XX], shift[YY], shift[ZZ]);
-            }
-            for (j = mols->index[i]; (j < mols->index[i + 1] && j < natoms); j++)
-            {
-                rvec_inc(x[j], shift);
-            }
+            put_one_molecule_com_in_box(unitcell_enum, ecenter, mols, i, natoms, atom, pbcType, box, x);
         }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
     }
 }
 
@@ -65,6 +65,22 @@ void put_molecule_com_in_box(int      unitcell_enum,
                              matrix   box,
                              rvec     x[]);
 
+/*! \brief Parallellizes put_molecule_com_in_box()
+ *
+ * Distributes the molecules over \p nth OpenMP threads; the explicit
+ * thread-count argument avoids silently introducing multithreading
+ * in tools.
+ */
+void put_molecule_com_in_box_omp(int      unitcell_enum,
+                                 int      ecenter,
+                                 t_block* mols,
+                                 int      natoms,
+                                 t_atom   atom[],
+                                 PbcType  pbcType,
+                                 matrix   box,
+                                 rvec     x[],
+                                 int      nth);
+
 void put_residue_com_in_box(int     unitcell_enum,
                             int     ecenter,
                             int     natoms,
@@ -0,0 +1,163 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests the batched PBC distance kernels against pbc_dx().
+ *
+ * \author Berk Hess <hess@kth.se>
+ * \ingroup module_pbcutil
+ */
+#include "gmxpre.h"
+
+#include "gromacs/pbcutil/pbc_dx_batch.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/math/vectypes.h"
+#include "gromacs/pbcutil/pbc.h"
+#include "gromacs/random/threefry.h"
+#include "gromacs/random/uniformrealdistribution.h"
+
+#include "testutils/testasserts.h"
+
+namespace gmx
+{
+
+namespace test
+{
+
+namespace
+{
+
+//! Number of pairs tested; deliberately not a multiple of any SIMD width
+constexpr int c_numPairs = 37;
+
+//! Generates random coordinate pairs spread over a few periodic images of \p box
+void generatePairs(const matrix box, std::vector<RVec>* x1, std::vector<RVec>* x2)
+{
+    ThreeFry2x64<64>               rng(201014, RandomDomain::Other);
+    UniformRealDistribution<real>  dist(-1.5, 2.5);
+
+    x1->resize(c_numPairs);
+    x2->resize(c_numPairs);
+    for (int i = 0; i < c_numPairs; i++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            (*x1)[i][d] = dist(rng) * box[d][d];
+            (*x2)[i][d] = dist(rng) * box[d][d];
+        }
+    }
+}
+
+//! Checks that pbcDxBatch() reproduces pbc_dx() for \p pbcType and \p box
+void comparePbcDxBatchWithPbcDx(PbcType pbcType, const matrix box)
+{
+    t_pbc pbc;
+    set_pbc(&pbc, pbcType, box);
+
+    std::vector<RVec> x1, x2;
+    generatePairs(box, &x1, &x2);
+    std::vector<RVec> dx(c_numPairs);
+
+    pbcDxBatch(&pbc, x1, x2, dx);
+
+    for (int i = 0; i < c_numPairs; i++)
+    {
+        rvec dxRef;
+        pbc_dx(&pbc, x1[i], x2[i], dxRef);
+        for (int d = 0; d < DIM; d++)
+        {
+            EXPECT_REAL_EQ_TOL(dxRef[d], dx[i][d],
+                               relativeToleranceAsFloatingPoint(box[d][d], 1e-5))
+                    << "pair " << i << " dim " << d;
+        }
+    }
+}
+
+TEST(PbcDxBatchTest, KernelTypeMatchesBoxClassification)
+{
+    const matrix rectBox = { { 5, 0, 0 }, { 0, 6, 0 }, { 0, 0, 7 } };
+    const matrix tricBox = { { 6, 0, 0 }, { 0, 6, 0 }, { 3, 3, 4.5 } };
+
+    t_pbc pbc;
+    EXPECT_EQ(pbcDxBatchKernelType(nullptr), PbcDxBatchKernelType::None);
+    set_pbc(&pbc, PbcType::No, rectBox);
+    EXPECT_EQ(pbcDxBatchKernelType(&pbc), PbcDxBatchKernelType::None);
+    set_pbc(&pbc, PbcType::Xyz, rectBox);
+    EXPECT_EQ(pbcDxBatchKernelType(&pbc), PbcDxBatchKernelType::Rectangular);
+    set_pbc(&pbc, PbcType::Xyz, tricBox);
+    EXPECT_EQ(pbcDxBatchKernelType(&pbc), PbcDxBatchKernelType::Triclinic);
+    set_pbc(&pbc, PbcType::XY, rectBox);
+    EXPECT_EQ(pbcDxBatchKernelType(&pbc), PbcDxBatchKernelType::General);
+}
+
+TEST(PbcDxBatchTest, MatchesPbcDxWithoutPbc)
+{
+    const matrix box = { { 5, 0, 0 }, { 0, 6, 0 }, { 0, 0, 7 } };
+    comparePbcDxBatchWithPbcDx(PbcType::No, box);
+}
+
+TEST(PbcDxBatchTest, MatchesPbcDxForRectangularBox)
+{
+    const matrix box = { { 5, 0, 0 }, { 0, 6, 0 }, { 0, 0, 7 } };
+    comparePbcDxBatchWithPbcDx(PbcType::Xyz, box);
+}
+
+TEST(PbcDxBatchTest, MatchesPbcDxForTriclinicBox)
+{
+    const matrix box = { { 6, 0, 0 }, { 0, 6, 0 }, { 3, 3, 4.5 } };
+    comparePbcDxBatchWithPbcDx(PbcType::Xyz, box);
+}
+
+TEST(PbcDxBatchTest, MatchesPbcDxForSkewedTriclinicBox)
+{
+    const matrix box = { { 6, 0, 0 }, { 2.9, 6, 0 }, { -2.9, 2.9, 6 } };
+    comparePbcDxBatchWithPbcDx(PbcType::Xyz, box);
+}
+
+TEST(PbcDxBatchTest, MatchesPbcDxFor2DBox)
+{
+    const matrix box = { { 5, 0, 0 }, { 0, 6, 0 }, { 0, 0, 7 } };
+    comparePbcDxBatchWithPbcDx(PbcType::XY, box);
+}
+
+} // namespace
+
+} // namespace test
+
+} // namespace gmx
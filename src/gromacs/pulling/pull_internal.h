@@ -246,6 +246,7 @@ struct pull_t
 
     int                  nthreads; /* Number of threads used by the pull code */
     std::vector<ComSums> comSums;  /* Work array for summing for COM, 1 entry per thread */
+    std::vector<int> smallGroupWorkList; /* Work list of groups with few local atoms, summed with one thread per group */
 
     pull_comm_t comm; /* Communication parameters, communicator and buffers */
 
@@ -61,6 +61,7 @@
 #include "gromacs/math/functions.h"
 #include "gromacs/math/utilities.h"
 #include "gromacs/math/vec.h"
+#include "gromacs/mdlib/gmx_omp_nthreads.h"
 #include "gromacs/mdlib/groupcoord.h"
 #include "gromacs/mdlib/stat.h"
 #include "gromacs/mdrunutility/handlerestart.h"
@@ -733,7 +734,12 @@ static void get_slab_centers(gmx_enfrotgrp* erg,  /* Enforced rotation group wor
                                                      init_rot_group we need to store
                                                      the reference slab centers                   */
 {
-    /* Loop over slabs */
+    /* Loop over slabs. The slabs are independent of each other, and each
+     * slab requires a pass over all rotation group atoms, so this is by far
+     * the most expensive part of the flexible potentials and is done on all
+     * available threads. */
+    int problemSlab = erg->slab_first - 1; /* Slab where the weight was too low, if any */
+#pragma omp parallel for num_threads(gmx_omp_nthreads_get(emntDefault)) schedule(static)
     for (int j = erg->slab_first; j <= erg->slab_last; j++)
     {
         int slabIndex                = j - erg->slab_first;
@@ -748,8 +754,10 @@ static void get_slab_centers(gmx_enfrotgrp* erg,  /* Enforced rotation group wor
         else
         {
             /* We need to check this here, since we divide through slab_weights
-             * in the flexible low-level routines! */
-            gmx_fatal(FARGS, "Not enough weight in slab %d. Slab center cannot be determined!", j);
+             * in the flexible low-level routines! Exit with a fatal error
+             * below, outside of the parallel region. */
+#pragma omp atomic write
+            problemSlab = j;
         }
 
         /* At first time step: save the centers of the reference structure */
@@ -759,6 +767,11 @@ static void get_slab_centers(gmx_enfrotgrp* erg,  /* Enforced rotation group wor
         }
     } /* END of loop over slabs */
 
+    if (problemSlab >= erg->slab_first)
+    {
+        gmx_fatal(FARGS, "Not enough weight in slab %d. Slab center cannot be determined!", problemSlab);
+    }
+
     /* Output on the master */
     if ((nullptr != out_slabs) && bOutStep)
     {
@@ -1792,25 +1805,26 @@ static int get_single_atom_gaussians(rvec curr_x, gmx_enfrotgrp* erg)
 
 static void flex2_precalc_inner_sum(const gmx_enfrotgrp* erg)
 {
-    rvec xi;       /* positions in the i-sum                        */
-    rvec xcn, ycn; /* the current and the reference slab centers    */
-    real gaussian_xi;
-    rvec yi0;
-    rvec rin; /* Helper variables                              */
-    real fac, fac2;
-    rvec innersumvec;
-    real OOpsii, OOpsiistar;
-    real sin_rin; /* s_ii.r_ii */
-    rvec s_in, tmpvec, tmpvec2;
-    real mi, wi; /* Mass-weighting of the positions                 */
-    real N_M;    /* N/M                                             */
-
+    const real N_M = erg->rotg->nat * erg->invmass; /* N/M */
 
-    N_M = erg->rotg->nat * erg->invmass;
-
-    /* Loop over all slabs that contain something */
+    /* Loop over all slabs that contain something. The inner sums of the
+     * slabs are independent of each other, so they can be computed on all
+     * available threads. */
+#pragma omp parallel for num_threads(gmx_omp_nthreads_get(emntDefault)) schedule(static)
     for (int n = erg->slab_first; n <= erg->slab_last; n++)
     {
+        rvec xi;       /* positions in the i-sum                        */
+        rvec xcn, ycn; /* the current and the reference slab centers    */
+        real gaussian_xi;
+        rvec yi0;
+        rvec rin; /* Helper variables                              */
+        real fac, fac2;
+        rvec innersumvec;
+        real OOpsii, OOpsiistar;
+        real sin_rin; /* s_ii.r_ii */
+        rvec s_in, tmpvec, tmpvec2;
+        real mi, wi; /* Mass-weighting of the positions                 */
+
         int slabIndex = n - erg->slab_first; /* slab index */
 
         /* The current center of this slab is saved in xcn: */
@@ -1882,21 +1896,22 @@ static void flex2_precalc_inner_sum(const gmx_enfrotgrp* erg)
 
 static void flex_precalc_inner_sum(const gmx_enfrotgrp* erg)
 {
-    rvec xi;       /* position                                      */
-    rvec xcn, ycn; /* the current and the reference slab centers    */
-    rvec qin, rin; /* q_i^n and r_i^n                               */
-    real bin;
-    rvec tmpvec;
-    rvec innersumvec; /* Inner part of sum_n2                          */
-    real gaussian_xi; /* Gaussian weight gn(xi)                        */
-    real mi, wi;      /* Mass-weighting of the positions               */
-    real N_M;         /* N/M                                           */
+    const real N_M = erg->rotg->nat * erg->invmass; /* N/M */
 
-    N_M = erg->rotg->nat * erg->invmass;
-
-    /* Loop over all slabs that contain something */
+    /* Loop over all slabs that contain something. As for the flex2
+     * potential, the slabs are independent and computed in parallel. */
+#pragma omp parallel for num_threads(gmx_omp_nthreads_get(emntDefault)) schedule(static)
     for (int n = erg->slab_first; n <= erg->slab_last; n++)
     {
+        rvec xi;       /* position                                      */
+        rvec xcn, ycn; /* the current and the reference slab centers    */
+        rvec qin, rin; /* q_i^n and r_i^n                               */
+        real bin;
+        rvec tmpvec;
+        rvec innersumvec; /* Inner part of sum_n2                          */
+        real gaussian_xi; /* Gaussian weight gn(xi)                        */
+        real mi, wi;      /* Mass-weighting of the positions               */
+
         int slabIndex = n - erg->slab_first; /* slab index */
 
         /* The current center of this slab is saved in xcn: */
@@ -517,6 +517,63 @@ static void sum_com_part_cosweight(const pull_group_work_t* pgrp,
     sum_com->sum_smp = sum_smp;
 }
 
+/*! \brief Computes the COM sums of one group with a single thread and stores them in \p comBuffer
+ *
+ * Used for groups with few local atoms, for which threading the sum over
+ * atoms has too much overhead; instead different groups are processed in
+ * parallel, see pull_calc_coms().
+ */
+static void sumComsSmallGroup(const pull_group_work_t&                pgrp,
+                              const rvec*                             x,
+                              const rvec*                             xp,
+                              const real*                             mass,
+                              const t_pbc*                            pbc,
+                              const rvec                              x_pbc,
+                              gmx::ArrayRef<gmx::BasicVector<double>> comBuffer)
+{
+    ComSums comSums = {};
+
+    /* If we have a single-atom group the mass is irrelevant, so
+     * we can remove the mass factor to avoid division by zero.
+     * Note that with constraint pulling the mass does matter, but
+     * in that case a check group mass != 0 has been done before.
+     */
+    if (pgrp.params.nat == 1 && pgrp.atomSet.numAtomsLocal() == 1
+        && mass[pgrp.atomSet.localIndex()[0]] == 0)
+    {
+        GMX_ASSERT(xp == nullptr,
+                   "We should not have groups with zero mass with constraints, i.e. "
+                   "xp!=NULL");
+
+        /* Copy the single atom coordinate */
+        for (int d = 0; d < DIM; d++)
+        {
+            comSums.sum_wmx[d] = x[pgrp.atomSet.localIndex()[0]][d];
+        }
+        /* Set all mass factors to 1 to get the correct COM */
+        comSums.sum_wm  = 1;
+        comSums.sum_wwm = 1;
+    }
+    else
+    {
+        sum_com_part(&pgrp, 0, pgrp.atomSet.numAtomsLocal(), x, xp, mass, pbc, x_pbc, &comSums);
+    }
+
+    if (pgrp.localWeights.empty())
+    {
+        comSums.sum_wwm = comSums.sum_wm;
+    }
+
+    /* Copy local sums to a buffer for global summing */
+    copy_dvec(comSums.sum_wmx, comBuffer[0]);
+
+    copy_dvec(comSums.sum_wmxp, comBuffer[1]);
+
+    comBuffer[2][0] = comSums.sum_wm;
+    comBuffer[2][1] = comSums.sum_wwm;
+    comBuffer[2][2] = 0;
+}
+
 /* calculates center of mass of selection index from all coordinates x */
 // Compiler segfault with 2019_update_5 and 2020_initial
 #if defined(__INTEL_COMPILER) \
@@ -541,6 +598,8 @@ void pull_calc_coms(const t_commrec* cr,
     GMX_ASSERT(comm->comBuffer.size() == pull->group.size() * c_comBufferStride,
                "comBuffer should have size #group*c_comBufferStride");
 
+    pull->smallGroupWorkList.clear();
+
     if (pull->bRefAt && pull->bSetPBCatoms)
     {
         pull_set_pbcatoms(cr, pull, x, comm->pbcAtomBuffer);
@@ -608,37 +667,22 @@ void pull_calc_coms(const t_commrec* cr,
                         copy_dvec_to_rvec(pgrp->x_prev_step, x_pbc);
                 }
 
-                /* The final sums should end up in comSums[0] */
-                ComSums& comSumsTotal = pull->comSums[0];
-
-                /* If we have a single-atom group the mass is irrelevant, so
-                 * we can remove the mass factor to avoid division by zero.
-                 * Note that with constraint pulling the mass does matter, but
-                 * in that case a check group mass != 0 has been done before.
-                 */
-                if (pgrp->params.nat == 1 && pgrp->atomSet.numAtomsLocal() == 1
-                    && md->massT[pgrp->atomSet.localIndex()[0]] == 0)
-                {
-                    GMX_ASSERT(xp == nullptr,
-                               "We should not have groups with zero mass with constraints, i.e. "
-                               "xp!=NULL");
-
-                    /* Copy the single atom coordinate */
-                    for (int d = 0; d < DIM; d++)
-                    {
-                        comSumsTotal.sum_wmx[d] = x[pgrp->atomSet.localIndex()[0]][d];
-                    }
-                    /* Set all mass factors to 1 to get the correct COM */
-                    comSumsTotal.sum_wm  = 1;
-                    comSumsTotal.sum_wwm = 1;
-                }
-                else if (pgrp->atomSet.numAtomsLocal() <= c_pullMaxNumLocalAtomsSingleThreaded)
+                if (pgrp->atomSet.numAtomsLocal() <= c_pullMaxNumLocalAtomsSingleThreaded)
                 {
-                    sum_com_part(pgrp, 0, pgrp->atomSet.numAtomsLocal(), x, xp, md->massT, pbc,
-                                 x_pbc, &comSumsTotal);
+                    /* This group has few local atoms, so threading the sum
+                     * over atoms has too much overhead. Defer the group to
+                     * the loop below, which processes all such groups in
+                     * parallel. The pbc reference coordinate, when used, is
+                     * in pbcAtomBuffer, also with epgrppbcPREVSTEPCOM, as
+                     * it was copied there above.
+                     */
+                    pull->smallGroupWorkList.push_back(static_cast<int>(g));
                 }
                 else
                 {
+                    /* The final sums should end up in comSums[0] */
+                    ComSums& comSumsTotal = pull->comSums[0];
+
 #pragma omp parallel for num_threads(pull->nthreads) schedule(static)
                     for (int t = 0; t < pull->nthreads; t++)
                     {
@@ -656,21 +700,21 @@ void pull_calc_coms(const t_commrec* cr,
                         dvec_inc(comSumsTotal.sum_wmx, pull->comSums[t].sum_wmx);
                         dvec_inc(comSumsTotal.sum_wmxp, pull->comSums[t].sum_wmxp);
                     }
-                }
 
-                if (pgrp->localWeights.empty())
-                {
-                    comSumsTotal.sum_wwm = comSumsTotal.sum_wm;
-                }
+                    if (pgrp->localWeights.empty())
+                    {
+                        comSumsTotal.sum_wwm = comSumsTotal.sum_wm;
+                    }
 
-                /* Copy local sums to a buffer for global summing */
-                copy_dvec(comSumsTotal.sum_wmx, comBuffer[0]);
+                    /* Copy local sums to a buffer for global summing */
+                    copy_dvec(comSumsTotal.sum_wmx, comBuffer[0]);
 
-                copy_dvec(comSumsTotal.sum_wmxp, comBuffer[1]);
+                    copy_dvec(comSumsTotal.sum_wmxp, comBuffer[1]);
 
-                comBuffer[2][0] = comSumsTotal.sum_wm;
-                comBuffer[2][1] = comSumsTotal.sum_wwm;
-                comBuffer[2][2] = 0;
+                    comBuffer[2][0] = comSumsTotal.sum_wm;
+                    comBuffer[2][1] = comSumsTotal.sum_wwm;
+                    comBuffer[2][2] = 0;
+                }
             }
             else
             {
@@ -720,6 +764,28 @@ void pull_calc_coms(const t_commrec* cr,
         }
     }
 
+    /* Process the groups with few local atoms deferred above. With many,
+     * small pull groups the sums over atoms do not parallelize, so here
+     * we parallelize over the groups instead, one thread per group.
+     */
+#pragma omp parallel for num_threads(pull->nthreads) schedule(static)
+    for (gmx::index i = 0; i < gmx::ssize(pull->smallGroupWorkList); i++)
+    {
+        const int                g    = pull->smallGroupWorkList[i];
+        const pull_group_work_t& pgrp = pull->group[g];
+
+        rvec x_pbc = { 0, 0, 0 };
+        if (pgrp.epgrppbc != epgrppbcNONE)
+        {
+            copy_rvec(comm->pbcAtomBuffer[g], x_pbc);
+        }
+
+        auto comBuffer = gmx::arrayRefFromArray(comm->comBuffer.data() + g * c_comBufferStride,
+                                                c_comBufferStride);
+
+        sumComsSmallGroup(pgrp, x, xp, md->massT, pbc, x_pbc, comBuffer);
+    }
+
     pullAllReduce(cr, comm, pull->group.size() * c_comBufferStride * DIM,
                   static_cast<double*>(comm->comBuffer[0]));
 
@@ -53,6 +53,7 @@
 
 #include "gromacs/math/functions.h"
 #include "gromacs/math/utilities.h"
+#include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/basedefinitions.h"
 #include "gromacs/utility/classhelpers.h"
 #include "gromacs/utility/gmxassert.h"
@@ -309,6 +310,64 @@ public:
         return param.mean() + value * param.stddev();
     }
 
+    /*! \brief Fill an array with normal variates for a range of counter values.
+     *
+     * \tparam Rng     Counter-based random engine type, typically ThreeFry2x64.
+     * \param  g       Random engine; it is restarted for every counter value,
+     *                 so the state it is left in is not meaningful.
+     * \param  ctr0    First word of the counter, e.g. the current step.
+     * \param  ctrStart Second counter word for the first batch entry, e.g. the
+     *                 index of the first atom in the batch.
+     * \param  variatesPerCounter Number of values to draw for each counter value.
+     * \param  result  Buffer to fill; its size must be a multiple of
+     *                 \p variatesPerCounter, and determines the number of
+     *                 consecutive counter values processed.
+     * \param  param   Parameters (mean and standard deviation) of the
+     *                 distribution, by default mean 0 and standard deviation 1.
+     *
+     * For each counter value c the result is identical to restarting \p g
+     * with (\p ctr0, c), resetting the distribution, and drawing
+     * \p variatesPerCounter values, which is the pattern the stochastic
+     * integrators use with the atom index as counter. Bulk generation
+     * avoids the per-value distribution state bookkeeping and produces a
+     * contiguous buffer the caller can consume with SIMD operations, while
+     * keeping the noise bitwise independent of how the atoms are batched.
+     */
+    template<class Rng>
+    static void generateBatch(Rng*               g,
+                              uint64_t           ctr0,
+                              uint64_t           ctrStart,
+                              int                variatesPerCounter,
+                              ArrayRef<RealType> result,
+                              const param_type&  param = param_type())
+    {
+        GMX_ASSERT(variatesPerCounter > 0 && result.size() % variatesPerCounter == 0,
+                   "Result buffer size must be a multiple of the variates drawn per counter");
+
+        const uint64_t    mask        = (1ULL << tableBits) - 1;
+        const std::size_t numCounters = result.size() / variatesPerCounter;
+        std::size_t       i           = 0;
+
+        for (std::size_t c = 0; c < numCounters; c++)
+        {
+            g->restart(ctr0, ctrStart + c);
+
+            uint64_t     bits     = 0;
+            unsigned int bitsLeft = 0;
+            for (int j = 0; j < variatesPerCounter; j++)
+            {
+                if (bitsLeft < tableBits)
+                {
+                    bits     = static_cast<uint64_t>((*g)());
+                    bitsLeft = std::numeric_limits<typename Rng::result_type>::digits;
+                }
+                result[i++] = param.mean() + c_table_[bits & mask] * param.stddev();
+                bits >>= tableBits;
+                bitsLeft -= tableBits;
+            }
+        }
+    }
+
     /*!\brief Check if two tabulated normal distributions have identical states.
      *
      * \param  x     Instance to compare with.
@@ -178,6 +178,33 @@ TEST(TabulatedNormalDistributionTableTest, HasValidProperties)
     EXPECT_REAL_EQ_TOL(1.0, variance, tolerance) << "Table should have unit variance";
 }
 
+TEST(TabulatedNormalDistributionTest, GenerateBatchMatchesScalarDraws)
+{
+    const uint64_t step               = 1234;
+    const int      numCounters        = 17; // Not a multiple of any SIMD width
+    const int      variatesPerCounter = 3;
+
+    std::vector<real> batchResult(numCounters * variatesPerCounter);
+
+    gmx::ThreeFry2x64<0> rngBatch(123456, gmx::RandomDomain::UpdateCoordinates);
+    gmx::TabulatedNormalDistribution<>::generateBatch(
+            &rngBatch, step, 10, variatesPerCounter, batchResult,
+            gmx::TabulatedNormalDistribution<>::param_type(2.0, 5.0));
+
+    gmx::ThreeFry2x64<0>               rng(123456, gmx::RandomDomain::UpdateCoordinates);
+    gmx::TabulatedNormalDistribution<> dist(2.0, 5.0);
+    for (int c = 0; c < numCounters; c++)
+    {
+        rng.restart(step, 10 + c);
+        dist.reset();
+        for (int j = 0; j < variatesPerCounter; j++)
+        {
+            EXPECT_EQ(dist(rng), batchResult[c * variatesPerCounter + j])
+                    << "counter " << c << " variate " << j;
+        }
+    }
+}
+
 } // namespace
 
 } // namespace gmx
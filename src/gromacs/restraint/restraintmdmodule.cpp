@@ -38,6 +38,7 @@
 #include "restraintmdmodule.h"
 
 #include <memory>
+#include <vector>
 
 #include "gromacs/mdtypes/forceoutput.h"
 #include "gromacs/mdtypes/iforceprovider.h"
@@ -79,8 +80,42 @@ void RestraintForceProvider::calculateForces(const ForceProviderInput& forceProv
     const auto& x  = forceProviderInput.x_;
     const auto& cr = forceProviderInput.cr_;
     const auto& t  = forceProviderInput.t_;
-    // Cooperatively get Cartesian coordinates for center of mass of each site
-    RVec r1 = sites_[0].centerOfMass(cr, static_cast<size_t>(mdatoms.homenr), x, t);
+    // Cooperatively get Cartesian coordinates for the center of mass of each
+    // site. Each rank fills in the contributions of its local atoms for all
+    // sites, and a single all-reduce makes all site positions available
+    // everywhere, instead of performing one collective operation per site.
+    std::vector<RVec> siteCoordinates;
+    siteCoordinates.reserve(sites_.size());
+    for (const auto& site : sites_)
+    {
+        siteCoordinates.push_back(site.localContribution(cr, static_cast<size_t>(mdatoms.homenr), x));
+    }
+    if (DOMAINDECOMP(&cr))
+    {
+        std::vector<double> buffer(3 * sites_.size());
+        for (size_t i = 0; i < sites_.size(); ++i)
+        {
+            for (int d = 0; d < DIM; ++d)
+            {
+                buffer[3 * i + d] = siteCoordinates[i][d];
+            }
+        }
+        // This should be an all-reduce sum, which gmx_sumd appears to be.
+        gmx_sumd(buffer.size(), buffer.data(), &cr);
+        for (size_t i = 0; i < sites_.size(); ++i)
+        {
+            for (int d = 0; d < DIM; ++d)
+            {
+                siteCoordinates[i][d] = static_cast<real>(buffer[3 * i + d]);
+            }
+        }
+    }
+    for (size_t i = 0; i < sites_.size(); ++i)
+    {
+        sites_[i].setCenterOfMass(siteCoordinates[i]);
+    }
+
+    RVec r1 = siteCoordinates[0];
     // r2 is to be constructed as
     // r2 = (site[N] - site[N-1]) + (site_{N-1} - site_{N-2}) + ... + (site_2 - site_1) + site_1
     // where the minimum image convention is applied to each path but not to the overall sum.
@@ -96,8 +131,8 @@ void RestraintForceProvider::calculateForces(const ForceProviderInput& forceProv
     // a big molecule in a small box.
     for (size_t i = 0; i < sites_.size() - 1; ++i)
     {
-        RVec a = sites_[i].centerOfMass(cr, static_cast<size_t>(mdatoms.homenr), x, t);
-        RVec b = sites_[i + 1].centerOfMass(cr, static_cast<size_t>(mdatoms.homenr), x, t);
+        const RVec& a = siteCoordinates[i];
+        const RVec& b = siteCoordinates[i + 1];
         // dr = minimum_image_vector(b - a)
         pbc_dx(&pbc, b, a, dr);
         r2[0] += dr[0];
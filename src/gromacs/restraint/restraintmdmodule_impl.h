@@ -114,23 +114,28 @@ public:
     int index() const { return index_; }
 
     /*!
-     * \brief Get the position of this site at time t.
+     * \brief Get this rank's contribution to the position of the site.
      *
      * \param cr Communications record.
      * \param nx Number of locally available atoms (size of local atom data arrays)
      * \param x Array of locally available atom coordinates.
-     * \param t the current time.
-     * \return position vector.
+     * \return position vector contributed by this rank.
      *
      * \internal
-     * By providing the current time, we can cache results in order to use them once per timestep.
-     * In the long term, we would prefer to also allow client code to preregister interest in a
-     * position at a given time, or issue "futures".
+     * With domain decomposition the position of an atomic site is only
+     * available on the home rank of the atom; all other ranks contribute
+     * zero. The caller is responsible for summing the contributions of all
+     * sites over the ranks, which allows the reductions for all sites to be
+     * coalesced into a single collective operation per step, and for
+     * recording the result with setCenterOfMass().
+     * For future multi-atom selections, each rank will contribute the
+     * weighted center-of-mass contribution of its local atoms.
+     * \todo use generalized "pull group" facility when available.
      */
-    RVec centerOfMass(const t_commrec& cr, size_t nx, ArrayRef<const RVec> x, double gmx_unused t)
+    RVec localContribution(const t_commrec& cr, size_t nx, ArrayRef<const RVec> x) const
     {
-        // Center of mass to return for the site. Currently the only form of site
-        // implemented is as a global atomic coordinate.
+        // Center-of-mass contribution of this rank. Currently the only form
+        // of site implemented is as a global atomic coordinate.
         gmx::RVec r = { 0, 0, 0 };
         if (DOMAINDECOMP(&cr)) // Domain decomposition
         {
@@ -152,20 +157,6 @@ public:
             {
                 // Nothing to contribute on this rank. Leave position == [0,0,0].
             }
-            // AllReduce across the ranks of the simulation to get the center-of-mass
-            // of the site locally available everywhere. For single-atom sites, this
-            // is trivial: exactly one rank should have a non-zero position.
-            // For future multi-atom selections,
-            // we will receive weighted center-of-mass contributions from
-            // each rank and combine to get the global center of mass.
-            // \todo use generalized "pull group" facility when available.
-            std::array<double, 3> buffer{ { r[0], r[1], r[2] } };
-            // This should be an all-reduce sum, which gmx_sumd appears to be.
-            gmx_sumd(3, buffer.data(), &cr);
-            r[0] = static_cast<real>(buffer[0]);
-            r[1] = static_cast<real>(buffer[1]);
-            r[2] = static_cast<real>(buffer[2]);
-
         } // end domain decomposition branch
         else
         {
@@ -173,12 +164,17 @@ public:
             copy_rvec(x[index_], r);
             (void)nx;
         }
-        // Update cache and cache status.
-        copy_rvec(r, r_);
 
-        return r_;
+        return r;
     }
 
+    /*!
+     * \brief Record the globally reduced position of this site.
+     *
+     * \param r position summed over the contributions of all ranks.
+     */
+    void setCenterOfMass(const RVec& r) { copy_rvec(r, r_); }
+
 private:
     /*!
      * \brief Global index of the single-atom site.
@@ -191,7 +187,7 @@ private:
     /*!
      * \brief Last known value of the center-of-mass.
      *
-     * Updated with centerOfMass().
+     * Updated with setCenterOfMass().
      */
     RVec r_;
 };
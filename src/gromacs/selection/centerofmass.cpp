@@ -45,9 +45,11 @@
 #include "centerofmass.h"
 
 #include <cmath>
+#include <cstdint>
 
 #include "gromacs/math/vec.h"
 #include "gromacs/pbcutil/pbc.h"
+#include "gromacs/simd/simd.h"
 #include "gromacs/topology/block.h"
 #include "gromacs/topology/mtop_lookup.h"
 #include "gromacs/topology/topology.h"
@@ -55,13 +57,39 @@
 
 void gmx_calc_cog(const gmx_mtop_t* /* top */, rvec x[], int nrefat, const int index[], rvec xout)
 {
-    int m, ai;
+    int m = 0;
 
     clear_rvec(xout);
-    for (m = 0; m < nrefat; ++m)
+#if GMX_SIMD_HAVE_REAL
+    /* Accumulate full SIMD blocks with gathered loads; the remaining atoms
+     * are handled by the scalar loop below.
+     */
+    if (nrefat >= GMX_SIMD_REAL_WIDTH)
     {
-        ai = index[m];
-        rvec_inc(xout, x[ai]);
+        gmx::SimdReal xsum = gmx::setZero();
+        gmx::SimdReal ysum = gmx::setZero();
+        gmx::SimdReal zsum = gmx::setZero();
+        for (; m + GMX_SIMD_REAL_WIDTH <= nrefat; m += GMX_SIMD_REAL_WIDTH)
+        {
+            alignas(GMX_SIMD_ALIGNMENT) std::int32_t offset[GMX_SIMD_REAL_WIDTH];
+            for (int s = 0; s < GMX_SIMD_REAL_WIDTH; ++s)
+            {
+                offset[s] = index[m + s];
+            }
+            gmx::SimdReal xi, yi, zi;
+            gmx::gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), offset, &xi, &yi, &zi);
+            xsum = xsum + xi;
+            ysum = ysum + yi;
+            zsum = zsum + zi;
+        }
+        xout[XX] = gmx::reduce(xsum);
+        xout[YY] = gmx::reduce(ysum);
+        xout[ZZ] = gmx::reduce(zsum);
+    }
+#endif
+    for (; m < nrefat; ++m)
+    {
+        rvec_inc(xout, x[index[m]]);
     }
     svmul(1.0 / nrefat, xout, xout);
 }
@@ -83,7 +111,41 @@ void gmx_calc_com(const gmx_mtop_t* top, rvec x[], int nrefat, const int index[]
     clear_rvec(xout);
     real mtot = 0;
     int  molb = 0;
-    for (int m = 0; m < nrefat; ++m)
+    int  m    = 0;
+#if GMX_SIMD_HAVE_REAL
+    /* Accumulate full SIMD blocks with gathered loads; the masses are
+     * looked up scalar into a small buffer per block.
+     */
+    if (nrefat >= GMX_SIMD_REAL_WIDTH)
+    {
+        gmx::SimdReal xsum = gmx::setZero();
+        gmx::SimdReal ysum = gmx::setZero();
+        gmx::SimdReal zsum = gmx::setZero();
+        gmx::SimdReal msum = gmx::setZero();
+        for (; m + GMX_SIMD_REAL_WIDTH <= nrefat; m += GMX_SIMD_REAL_WIDTH)
+        {
+            alignas(GMX_SIMD_ALIGNMENT) std::int32_t offset[GMX_SIMD_REAL_WIDTH];
+            alignas(GMX_SIMD_ALIGNMENT) real         mass[GMX_SIMD_REAL_WIDTH];
+            for (int s = 0; s < GMX_SIMD_REAL_WIDTH; ++s)
+            {
+                offset[s] = index[m + s];
+                mass[s]   = mtopGetAtomMass(top, offset[s], &molb);
+            }
+            gmx::SimdReal xi, yi, zi;
+            gmx::gatherLoadUTranspose<3>(reinterpret_cast<const real*>(x), offset, &xi, &yi, &zi);
+            const gmx::SimdReal mi = gmx::load<gmx::SimdReal>(mass);
+            xsum                   = gmx::fma(mi, xi, xsum);
+            ysum                   = gmx::fma(mi, yi, ysum);
+            zsum                   = gmx::fma(mi, zi, zsum);
+            msum                   = msum + mi;
+        }
+        xout[XX] = gmx::reduce(xsum);
+        xout[YY] = gmx::reduce(ysum);
+        xout[ZZ] = gmx::reduce(zsum);
+        mtot     = gmx::reduce(msum);
+    }
+#endif
+    for (; m < nrefat; ++m)
     {
         const int  ai   = index[m];
         const real mass = mtopGetAtomMass(top, ai, &molb);
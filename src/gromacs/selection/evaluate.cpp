@@ -609,11 +609,11 @@ void _gmx_sel_evaluate_subexpr_staticeval(gmx_sel_evaluate_t*
  *
  * \todo
  * The call to gmx_ana_index_difference() can take quite a lot of unnecessary
- * time if the subexpression is evaluated either several times for the same
- * group or for completely distinct groups.
- * However, in the majority of cases, these situations occur when
+ * time if the subexpression is evaluated for completely distinct groups.
+ * However, in the majority of cases, this situation occurs when
  * _gmx_sel_evaluate_subexpr_staticeval() can be used, so this should not be a
- * major problem.
+ * major problem.  Repeated evaluation for the same group is detected and
+ * returns the cached value directly.
  */
 void _gmx_sel_evaluate_subexpr(gmx_sel_evaluate_t*                     data,
                                const gmx::SelectionTreeElementPointer& sel,
@@ -633,6 +633,14 @@ void _gmx_sel_evaluate_subexpr(gmx_sel_evaluate_t*                     data,
     }
     else
     {
+        if (gmx_ana_index_equals(g, &sel->u.cgrp))
+        {
+            /* The subexpression has already been evaluated for exactly this
+             * group, so the cached value can be used as is.  This avoids the
+             * gmx_ana_index_difference() call mentioned in the \todo above
+             * for the common case of repeated evaluation for the same group. */
+            return;
+        }
         gmissreserver.reserve(&gmiss, g->isize);
         gmx_ana_index_difference(&gmiss, g, &sel->u.cgrp);
     }
@@ -1147,8 +1155,7 @@ void _gmx_sel_evaluate_arithmetic(gmx_sel_evaluate_t*                     data,
                                   const gmx::SelectionTreeElementPointer& sel,
                                   gmx_ana_index_t*                        g)
 {
-    int  n, i, i1, i2;
-    real lval, rval = 0., val = 0.;
+    int n, i, i1, i2;
 
     const SelectionTreeElementPointer& left  = sel->child;
     const SelectionTreeElementPointer& right = left->next;
@@ -1174,30 +1181,50 @@ void _gmx_sel_evaluate_arithmetic(gmx_sel_evaluate_t*                     data,
 
     bool bArithNeg = (sel->u.arith.type == ARITH_NEG);
     GMX_ASSERT(right || bArithNeg, "Right operand cannot be null except for negations");
-    for (i = i1 = i2 = 0; i < n; ++i)
+    /* The operator dispatch is hoisted out of the per-atom loop; each case
+     * below runs a tight loop over the whole batch of values. */
+    const int   ds = (left->flags & SEL_SINGLEVAL) ? 0 : 1;
+    const int   dt = (!bArithNeg && !(right->flags & SEL_SINGLEVAL)) ? 1 : 0;
+    const real* lv = left->v.u.r;
+    const real* rv = bArithNeg ? nullptr : right->v.u.r;
+    real*       dv = sel->v.u.r;
+    switch (sel->u.arith.type)
     {
-        lval = left->v.u.r[i1];
-        if (!bArithNeg)
-        {
-            rval = right->v.u.r[i2];
-        }
-        switch (sel->u.arith.type)
-        {
-            case ARITH_PLUS: val = lval + rval; break;
-            case ARITH_MINUS: val = lval - rval; break;
-            case ARITH_NEG: val = -lval; break;
-            case ARITH_MULT: val = lval * rval; break;
-            case ARITH_DIV: val = lval / rval; break;
-            case ARITH_EXP: val = pow(lval, rval); break;
-        }
-        sel->v.u.r[i] = val;
-        if (!(left->flags & SEL_SINGLEVAL))
-        {
-            ++i1;
-        }
-        if (!bArithNeg && !(right->flags & SEL_SINGLEVAL))
-        {
-            ++i2;
-        }
+        case ARITH_PLUS:
+            for (i = i1 = i2 = 0; i < n; ++i, i1 += ds, i2 += dt)
+            {
+                dv[i] = lv[i1] + rv[i2];
+            }
+            break;
+        case ARITH_MINUS:
+            for (i = i1 = i2 = 0; i < n; ++i, i1 += ds, i2 += dt)
+            {
+                dv[i] = lv[i1] - rv[i2];
+            }
+            break;
+        case ARITH_NEG:
+            for (i = i1 = 0; i < n; ++i, i1 += ds)
+            {
+                dv[i] = -lv[i1];
+            }
+            break;
+        case ARITH_MULT:
+            for (i = i1 = i2 = 0; i < n; ++i, i1 += ds, i2 += dt)
+            {
+                dv[i] = lv[i1] * rv[i2];
+            }
+            break;
+        case ARITH_DIV:
+            for (i = i1 = i2 = 0; i < n; ++i, i1 += ds, i2 += dt)
+            {
+                dv[i] = lv[i1] / rv[i2];
+            }
+            break;
+        case ARITH_EXP:
+            for (i = i1 = i2 = 0; i < n; ++i, i1 += ds, i2 += dt)
+            {
+                dv[i] = pow(lv[i1], rv[i2]);
+            }
+            break;
     }
 }
@@ -56,6 +56,7 @@
 #include "nbsearch.h"
 
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 
 #include <algorithm>
@@ -64,6 +65,8 @@
 #include "gromacs/math/functions.h"
 #include "gromacs/math/vec.h"
 #include "gromacs/pbcutil/pbc.h"
+#include "gromacs/pbcutil/pbc_dx_batch.h"
+#include "gromacs/simd/simd.h"
 #include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/gmxassert.h"
@@ -363,6 +366,33 @@ private:
     void reset(int testIndex);
     //! Checks whether a reference positiong should be excluded.
     bool isExcluded(int j);
+    /*! \brief
+     * Fills dxBatch_ with distance vectors for reference positions from \p i.
+     *
+     * Used by the simple (non-gridded) pair loop in searchNext() to compute
+     * the PBC corrected distances to the current test position for a whole
+     * block of reference positions with a single batched kernel call instead
+     * of calling pbc_dx() per pair.  The buffer stays valid when the loop is
+     * resumed after returning a pair; reset() invalidates it.
+     */
+    void fillDxBatch(int i);
+#if GMX_SIMD_HAVE_REAL
+    /*! \brief
+     * Skips over blocks of grid cell entries that are all outside the cutoff.
+     *
+     * \param[in] ci    Index of the grid cell to process.
+     * \param[in] cai   Index of the first unprocessed entry within the cell.
+     * \param[in] shift Shift to apply for periodicity for this cell.
+     * \returns   Index of the first entry that may be within the cutoff.
+     *
+     * Checks the distances for \c GMX_SIMD_REAL_WIDTH entries at a time, and
+     * advances over full blocks where no entry is within the cutoff.  The
+     * scalar loop in searchNext() then only processes blocks that contain at
+     * least one pair within the cutoff.  Entries outside the cutoff would be
+     * skipped by the scalar loop as well, so this does not change the result.
+     */
+    int prefilterCellEntries(int ci, int cai, const rvec shift) const;
+#endif
 
     //! Parent search object.
     const AnalysisNeighborhoodSearchImpl& search_;
@@ -400,6 +430,12 @@ private:
     ivec cellBound_;
     //! Stores the index within the current cell during pair loops.
     int prevcai_;
+    //! First reference index covered by dxBatch_, or -1 when invalid.
+    int dxBatchStart_;
+    //! Batched distance vectors for the simple pair loop.
+    std::vector<RVec> dxBatch_;
+    //! Copies of the test position, as needed by the batched kernel.
+    std::vector<RVec> xtestBatch_;
 
     GMX_DISALLOW_COPY_AND_ASSIGN(AnalysisNeighborhoodPairSearchImpl);
 };
@@ -959,8 +995,9 @@ void AnalysisNeighborhoodPairSearchImpl::reset(int testIndex)
     previ_         = -1;
     prevr2_        = 0.0;
     clear_rvec(prevdx_);
-    exclind_ = 0;
-    prevcai_ = -1;
+    exclind_      = 0;
+    prevcai_      = -1;
+    dxBatchStart_ = -1;
     if (testIndex_ >= 0 && testIndex_ < testPosCount_)
     {
         const int index = (testIndices_ != nullptr ? testIndices_[testIndex] : testIndex);
@@ -1027,6 +1064,19 @@ bool AnalysisNeighborhoodPairSearchImpl::isExcluded(int j)
     return false;
 }
 
+void AnalysisNeighborhoodPairSearchImpl::fillDxBatch(int i)
+{
+    constexpr int c_dxBatchSize = 128;
+
+    const int count = std::min(c_dxBatchSize, search_.nref_ - i);
+    dxBatchStart_   = i;
+    dxBatch_.resize(count);
+    xtestBatch_.assign(count, RVec(xtest_[XX], xtest_[YY], xtest_[ZZ]));
+    const t_pbc* pbc = (search_.pbc_.pbcType != PbcType::No ? &search_.pbc_ : nullptr);
+    pbcDxBatch(pbc, constArrayRefFromArray(reinterpret_cast<const RVec*>(search_.xref_) + i, count),
+               xtestBatch_, dxBatch_);
+}
+
 void AnalysisNeighborhoodPairSearchImpl::startSearch(const AnalysisNeighborhoodPositions& positions)
 {
     selfSearchMode_   = false;
@@ -1061,6 +1111,42 @@ void AnalysisNeighborhoodPairSearchImpl::startSelfSearch()
     reset(0);
 }
 
+#if GMX_SIMD_HAVE_REAL
+int AnalysisNeighborhoodPairSearchImpl::prefilterCellEntries(int ci, int cai, const rvec shift) const
+{
+    const std::vector<int>& cell     = search_.cells_[ci];
+    const int               cellSize = ssize(cell);
+    const SimdReal          cutoff2(search_.cutoff2_);
+    const SimdReal          xtest(xtest_[XX] + shift[XX]);
+    const SimdReal          ytest(xtest_[YY] + shift[YY]);
+    const SimdReal          ztest(xtest_[ZZ] + shift[ZZ]);
+    while (cai + GMX_SIMD_REAL_WIDTH <= cellSize)
+    {
+        alignas(GMX_SIMD_ALIGNMENT) std::int32_t offset[GMX_SIMD_REAL_WIDTH];
+        for (int s = 0; s < GMX_SIMD_REAL_WIDTH; ++s)
+        {
+            offset[s] = cell[cai + s];
+        }
+        SimdReal xr, yr, zr;
+        gatherLoadUTranspose<3>(reinterpret_cast<const real*>(search_.xref_), offset, &xr, &yr, &zr);
+        const SimdReal dx = xr - xtest;
+        const SimdReal dy = yr - ytest;
+        SimdReal       r2 = dx * dx + dy * dy;
+        if (!search_.bXY_)
+        {
+            const SimdReal dz = zr - ztest;
+            r2 = r2 + dz * dz;
+        }
+        if (anyTrue(r2 <= cutoff2))
+        {
+            break;
+        }
+        cai += GMX_SIMD_REAL_WIDTH;
+    }
+    return cai;
+}
+#endif
+
 template<class Action>
 bool AnalysisNeighborhoodPairSearchImpl::searchNext(Action action)
 {
@@ -1079,6 +1165,9 @@ bool AnalysisNeighborhoodPairSearchImpl::searchNext(Action action)
                     continue;
                 }
                 const int cellSize = ssize(search_.cells_[ci]);
+#if GMX_SIMD_HAVE_REAL
+                cai = prefilterCellEntries(ci, cai, shift);
+#endif
                 for (; cai < cellSize; ++cai)
                 {
                     const int i = search_.cells_[ci][cai];
@@ -1118,16 +1207,12 @@ bool AnalysisNeighborhoodPairSearchImpl::searchNext(Action action)
                 {
                     continue;
                 }
-                rvec dx;
-                if (search_.pbc_.pbcType != PbcType::No)
+                if (dxBatchStart_ < 0 || i < dxBatchStart_ || i >= dxBatchStart_ + ssize(dxBatch_))
                 {
-                    pbc_dx(&search_.pbc_, search_.xref_[i], xtest_, dx);
-                }
-                else
-                {
-                    rvec_sub(search_.xref_[i], xtest_, dx);
+                    fillDxBatch(i);
                 }
-                const real r2 = search_.bXY_ ? dx[XX] * dx[XX] + dx[YY] * dx[YY] : norm2(dx);
+                const rvec& dx = dxBatch_[i - dxBatchStart_].as_vec();
+                const real  r2 = search_.bXY_ ? dx[XX] * dx[XX] + dx[YY] * dx[YY] : norm2(dx);
                 if (r2 <= search_.cutoff2_)
                 {
                     if (action(i, r2, dx))
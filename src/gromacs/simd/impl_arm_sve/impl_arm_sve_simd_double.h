@@ -0,0 +1,574 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+
+#ifndef GMX_SIMD_IMPL_ARM_SVE_SIMD_DOUBLE_H
+#define GMX_SIMD_IMPL_ARM_SVE_SIMD_DOUBLE_H
+
+#include "config.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <arm_sve.h>
+
+#include "gromacs/math/utilities.h"
+
+#include "impl_arm_sve_definitions.h"
+
+namespace gmx
+{
+
+/* As for single precision, the sizeless SVE types are stored in fixed-size
+ * GNU vector types matching the vector length we compile for. SimdDInt32
+ * keeps one 32-bit integer per double-precision lane, widened to a 64-bit
+ * element so all integer operations can use the full-width 64-bit
+ * instructions; loads and stores narrow/widen on the fly.
+ */
+
+class SimdDouble
+{
+public:
+    SimdDouble() {}
+
+    SimdDouble(const double d) { this->simdInternal_ = svdup_n_f64(d); }
+
+    // Internal utility constructor to simplify return statements
+    SimdDouble(svfloat64_t simd) { this->simdInternal_ = simd; }
+
+    float64_t simdInternal_ __attribute__((vector_size(GMX_SIMD_ARM_SVE_LENGTH_VALUE / 8)));
+};
+
+class SimdDInt32
+{
+public:
+    SimdDInt32() {}
+
+    SimdDInt32(const std::int32_t i) { this->simdInternal_ = svdup_n_s64(i); }
+
+    // Internal utility constructor to simplify return statements
+    SimdDInt32(svint64_t simd) { this->simdInternal_ = simd; }
+
+    int64_t simdInternal_ __attribute__((vector_size(GMX_SIMD_ARM_SVE_LENGTH_VALUE / 8)));
+};
+
+class SimdDBool
+{
+public:
+    SimdDBool() {}
+
+    SimdDBool(const bool b)
+    {
+        this->simdInternal_ = svdup_n_u64_x(svptrue_b64(), b ? 0xFFFFFFFFFFFFFFFF : 0);
+    }
+
+    // Internal utility constructors to simplify return statements
+    SimdDBool(svbool_t simd) { this->simdInternal_ = svdup_n_u64_z(simd, 0xFFFFFFFFFFFFFFFF); }
+
+    SimdDBool(svuint64_t simd) { this->simdInternal_ = simd; }
+
+    uint64_t simdInternal_ __attribute__((vector_size(GMX_SIMD_ARM_SVE_LENGTH_VALUE / 8)));
+};
+
+class SimdDIBool
+{
+public:
+    SimdDIBool() {}
+
+    SimdDIBool(const bool b)
+    {
+        this->simdInternal_ = svdup_n_u64_x(svptrue_b64(), b ? 0xFFFFFFFFFFFFFFFF : 0);
+    }
+
+    // Internal utility constructors to simplify return statements
+    SimdDIBool(svbool_t simd) { this->simdInternal_ = svdup_n_u64_z(simd, 0xFFFFFFFFFFFFFFFF); }
+
+    SimdDIBool(svuint64_t simd) { this->simdInternal_ = simd; }
+
+    uint64_t simdInternal_ __attribute__((vector_size(GMX_SIMD_ARM_SVE_LENGTH_VALUE / 8)));
+};
+
+static inline SimdDouble gmx_simdcall simdLoad(const double* m, SimdDoubleTag = {})
+{
+    assert(std::size_t(m) % GMX_SIMD_ALIGNMENT == 0);
+    return { svld1_f64(svptrue_b64(), m) };
+}
+
+static inline void gmx_simdcall store(double* m, SimdDouble a)
+{
+    assert(std::size_t(m) % GMX_SIMD_ALIGNMENT == 0);
+    svst1_f64(svptrue_b64(), m, a.simdInternal_);
+}
+
+static inline SimdDouble gmx_simdcall simdLoadU(const double* m, SimdDoubleTag = {})
+{
+    return { svld1_f64(svptrue_b64(), m) };
+}
+
+static inline void gmx_simdcall storeU(double* m, SimdDouble a)
+{
+    svst1_f64(svptrue_b64(), m, a.simdInternal_);
+}
+
+static inline SimdDouble gmx_simdcall setZeroD()
+{
+    return { svdup_n_f64(0.0) };
+}
+
+static inline SimdDInt32 gmx_simdcall simdLoad(const std::int32_t* m, SimdDInt32Tag)
+{
+    assert(std::size_t(m) % (GMX_SIMD_DINT32_WIDTH * sizeof(std::int32_t)) == 0);
+    return { svld1sw_s64(svptrue_b64(), m) };
+}
+
+static inline void gmx_simdcall store(std::int32_t* m, SimdDInt32 a)
+{
+    assert(std::size_t(m) % (GMX_SIMD_DINT32_WIDTH * sizeof(std::int32_t)) == 0);
+    svst1w_s64(svptrue_b64(), m, a.simdInternal_);
+}
+
+static inline SimdDInt32 gmx_simdcall simdLoadU(const std::int32_t* m, SimdDInt32Tag)
+{
+    return { svld1sw_s64(svptrue_b64(), m) };
+}
+
+static inline void gmx_simdcall storeU(std::int32_t* m, SimdDInt32 a)
+{
+    svst1w_s64(svptrue_b64(), m, a.simdInternal_);
+}
+
+static inline SimdDInt32 gmx_simdcall setZeroDI()
+{
+    return { svdup_n_s64(0) };
+}
+
+template<int index>
+gmx_simdcall static inline std::int32_t extract(SimdDInt32 a)
+{
+    return static_cast<std::int32_t>(svlasta_s64(svwhilelt_b64(0, index), a.simdInternal_));
+}
+
+static inline SimdDouble gmx_simdcall operator&(SimdDouble a, SimdDouble b)
+{
+    return { svreinterpret_f64_s64(svand_s64_x(svptrue_b64(),
+                                               svreinterpret_s64_f64(a.simdInternal_),
+                                               svreinterpret_s64_f64(b.simdInternal_))) };
+}
+
+static inline SimdDouble gmx_simdcall andNot(SimdDouble a, SimdDouble b)
+{
+    return { svreinterpret_f64_s64(svbic_s64_x(svptrue_b64(),
+                                               svreinterpret_s64_f64(b.simdInternal_),
+                                               svreinterpret_s64_f64(a.simdInternal_))) };
+}
+
+static inline SimdDouble gmx_simdcall operator|(SimdDouble a, SimdDouble b)
+{
+    return { svreinterpret_f64_s64(svorr_s64_x(svptrue_b64(),
+                                               svreinterpret_s64_f64(a.simdInternal_),
+                                               svreinterpret_s64_f64(b.simdInternal_))) };
+}
+
+static inline SimdDouble gmx_simdcall operator^(SimdDouble a, SimdDouble b)
+{
+    return { svreinterpret_f64_s64(sveor_s64_x(svptrue_b64(),
+                                               svreinterpret_s64_f64(a.simdInternal_),
+                                               svreinterpret_s64_f64(b.simdInternal_))) };
+}
+
+static inline SimdDouble gmx_simdcall operator+(SimdDouble a, SimdDouble b)
+{
+    return { svadd_f64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall operator-(SimdDouble a, SimdDouble b)
+{
+    return { svsub_f64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall operator-(SimdDouble x)
+{
+    return { svneg_f64_x(svptrue_b64(), x.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall operator*(SimdDouble a, SimdDouble b)
+{
+    return { svmul_f64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+// a*b+c
+static inline SimdDouble gmx_simdcall fma(SimdDouble a, SimdDouble b, SimdDouble c)
+{
+    return { svmad_f64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_, c.simdInternal_) };
+}
+
+// a*b-c
+static inline SimdDouble gmx_simdcall fms(SimdDouble a, SimdDouble b, SimdDouble c)
+{
+    return { svnmsb_f64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_, c.simdInternal_) };
+}
+
+// -a*b+c
+static inline SimdDouble gmx_simdcall fnma(SimdDouble a, SimdDouble b, SimdDouble c)
+{
+    return { svmsb_f64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_, c.simdInternal_) };
+}
+
+// -a*b-c
+static inline SimdDouble gmx_simdcall fnms(SimdDouble a, SimdDouble b, SimdDouble c)
+{
+    return { svnmad_f64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_, c.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall rsqrt(SimdDouble x)
+{
+    return { svrsqrte_f64(x.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall rsqrtIter(SimdDouble lu, SimdDouble x)
+{
+    return { svmul_f64_x(svptrue_b64(), lu.simdInternal_,
+                         svrsqrts_f64(svmul_f64_x(svptrue_b64(), lu.simdInternal_, lu.simdInternal_),
+                                      x.simdInternal_)) };
+}
+
+static inline SimdDouble gmx_simdcall rcp(SimdDouble x)
+{
+    return { svrecpe_f64(x.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall rcpIter(SimdDouble lu, SimdDouble x)
+{
+    return { svmul_f64_x(svptrue_b64(), lu.simdInternal_,
+                         svrecps_f64(lu.simdInternal_, x.simdInternal_)) };
+}
+
+static inline SimdDouble gmx_simdcall maskAdd(SimdDouble a, SimdDouble b, SimdDBool m)
+{
+    svbool_t pg = svcmpne_n_u64(svptrue_b64(), m.simdInternal_, 0);
+    return { svadd_f64_m(pg, a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall maskzMul(SimdDouble a, SimdDouble b, SimdDBool m)
+{
+    svbool_t pg = svcmpne_n_u64(svptrue_b64(), m.simdInternal_, 0);
+    return { svmul_f64_z(pg, a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall maskzFma(SimdDouble a, SimdDouble b, SimdDouble c, SimdDBool m)
+{
+    svbool_t pg = svcmpne_n_u64(svptrue_b64(), m.simdInternal_, 0);
+    return { svmad_f64_z(pg, a.simdInternal_, b.simdInternal_, c.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall maskzRsqrt(SimdDouble x, SimdDBool m)
+{
+    svbool_t pg = svcmpne_n_u64(svptrue_b64(), m.simdInternal_, 0);
+    // The result will always be correct since we mask the result with m, but
+    // for debug builds we also want to make sure not to generate FP exceptions
+#ifndef NDEBUG
+    x.simdInternal_ = svsel_f64(pg, x.simdInternal_, svdup_n_f64(1.0));
+#endif
+    return { svsel_f64(pg, svrsqrte_f64(x.simdInternal_), svdup_n_f64(0.0)) };
+}
+
+static inline SimdDouble gmx_simdcall maskzRcp(SimdDouble x, SimdDBool m)
+{
+    svbool_t pg = svcmpne_n_u64(svptrue_b64(), m.simdInternal_, 0);
+    // The result will always be correct since we mask the result with m, but
+    // for debug builds we also want to make sure not to generate FP exceptions
+#ifndef NDEBUG
+    x.simdInternal_ = svsel_f64(pg, x.simdInternal_, svdup_n_f64(1.0));
+#endif
+    return { svsel_f64(pg, svrecpe_f64(x.simdInternal_), svdup_n_f64(0.0)) };
+}
+
+static inline SimdDouble gmx_simdcall abs(SimdDouble x)
+{
+    return { svabs_f64_x(svptrue_b64(), x.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall max(SimdDouble a, SimdDouble b)
+{
+    return { svmax_f64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall min(SimdDouble a, SimdDouble b)
+{
+    return { svmin_f64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall round(SimdDouble x)
+{
+    return { svrintn_f64_x(svptrue_b64(), x.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall trunc(SimdDouble x)
+{
+    return { svrintz_f64_x(svptrue_b64(), x.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall frexp(SimdDouble value, SimdDInt32* exponent)
+{
+    const svbool_t  pg           = svptrue_b64();
+    const svint64_t exponentMask = svdup_n_s64(0x7FF0000000000000LL);
+    const svint64_t mantissaMask = svdup_n_s64(0x800FFFFFFFFFFFFFLL);
+    // add 1 to make our definition identical to frexp()
+    const svint64_t   exponentBias = svdup_n_s64(1022);
+    const svfloat64_t half         = svdup_n_f64(0.5);
+    svint64_t         iExponent;
+
+    iExponent = svand_s64_x(pg, svreinterpret_s64_f64(value.simdInternal_), exponentMask);
+    iExponent = svsub_s64_x(pg, svasr_n_s64_x(pg, iExponent, 52), exponentBias);
+    exponent->simdInternal_ = iExponent;
+
+    return { svreinterpret_f64_s64(
+            svorr_s64_x(pg,
+                        svand_s64_x(pg, svreinterpret_s64_f64(value.simdInternal_), mantissaMask),
+                        svreinterpret_s64_f64(half))) };
+}
+
+template<MathOptimization opt = MathOptimization::Safe>
+static inline SimdDouble gmx_simdcall ldexp(SimdDouble value, SimdDInt32 exponent)
+{
+    const svbool_t  pg           = svptrue_b64();
+    const svint64_t exponentBias = svdup_n_s64(1023);
+    svint64_t       iExponent    = svadd_s64_x(pg, exponent.simdInternal_, exponentBias);
+
+    if (opt == MathOptimization::Safe)
+    {
+        // Make sure biased argument is not negative
+        iExponent = svmax_n_s64_x(pg, iExponent, 0);
+    }
+
+    iExponent = svlsl_n_s64_x(pg, iExponent, 52);
+
+    return { svmul_f64_x(pg, value.simdInternal_, svreinterpret_f64_s64(iExponent)) };
+}
+
+static inline double gmx_simdcall reduce(SimdDouble a)
+{
+    return svaddv_f64(svptrue_b64(), a.simdInternal_);
+}
+
+static inline SimdDBool gmx_simdcall operator==(SimdDouble a, SimdDouble b)
+{
+    return { svcmpeq_f64(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDBool gmx_simdcall operator!=(SimdDouble a, SimdDouble b)
+{
+    return { svcmpne_f64(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDBool gmx_simdcall operator<(SimdDouble a, SimdDouble b)
+{
+    return { svcmplt_f64(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDBool gmx_simdcall operator<=(SimdDouble a, SimdDouble b)
+{
+    return { svcmple_f64(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDBool gmx_simdcall testBits(SimdDouble a)
+{
+    return { svcmpne_n_u64(svptrue_b64(), svreinterpret_u64_f64(a.simdInternal_), 0) };
+}
+
+static inline SimdDBool gmx_simdcall operator&&(SimdDBool a, SimdDBool b)
+{
+    return { svand_u64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDBool gmx_simdcall operator||(SimdDBool a, SimdDBool b)
+{
+    return { svorr_u64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline bool gmx_simdcall anyTrue(SimdDBool a)
+{
+    return svptest_any(svptrue_b64(), svcmpne_n_u64(svptrue_b64(), a.simdInternal_, 0));
+}
+
+static inline SimdDouble gmx_simdcall selectByMask(SimdDouble a, SimdDBool m)
+{
+    return { svreinterpret_f64_u64(svand_u64_x(
+            svptrue_b64(), svreinterpret_u64_f64(a.simdInternal_), m.simdInternal_)) };
+}
+
+static inline SimdDouble gmx_simdcall selectByNotMask(SimdDouble a, SimdDBool m)
+{
+    return { svreinterpret_f64_u64(svbic_u64_x(
+            svptrue_b64(), svreinterpret_u64_f64(a.simdInternal_), m.simdInternal_)) };
+}
+
+static inline SimdDouble gmx_simdcall blend(SimdDouble a, SimdDouble b, SimdDBool sel)
+{
+    svbool_t pg = svcmpne_n_u64(svptrue_b64(), sel.simdInternal_, 0);
+    return { svsel_f64(pg, b.simdInternal_, a.simdInternal_) };
+}
+
+static inline SimdDInt32 gmx_simdcall operator&(SimdDInt32 a, SimdDInt32 b)
+{
+    return { svand_s64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDInt32 gmx_simdcall andNot(SimdDInt32 a, SimdDInt32 b)
+{
+    return { svbic_s64_x(svptrue_b64(), b.simdInternal_, a.simdInternal_) };
+}
+
+static inline SimdDInt32 gmx_simdcall operator|(SimdDInt32 a, SimdDInt32 b)
+{
+    return { svorr_s64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDInt32 gmx_simdcall operator^(SimdDInt32 a, SimdDInt32 b)
+{
+    return { sveor_s64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDInt32 gmx_simdcall operator+(SimdDInt32 a, SimdDInt32 b)
+{
+    return { svadd_s64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDInt32 gmx_simdcall operator-(SimdDInt32 a, SimdDInt32 b)
+{
+    return { svsub_s64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDInt32 gmx_simdcall operator*(SimdDInt32 a, SimdDInt32 b)
+{
+    return { svmul_s64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDIBool gmx_simdcall operator==(SimdDInt32 a, SimdDInt32 b)
+{
+    return { svcmpeq_s64(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDIBool gmx_simdcall testBits(SimdDInt32 a)
+{
+    return { svcmpne_n_s64(svptrue_b64(), a.simdInternal_, 0) };
+}
+
+static inline SimdDIBool gmx_simdcall operator<(SimdDInt32 a, SimdDInt32 b)
+{
+    return { svcmplt_s64(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDIBool gmx_simdcall operator&&(SimdDIBool a, SimdDIBool b)
+{
+    return { svand_u64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdDIBool gmx_simdcall operator||(SimdDIBool a, SimdDIBool b)
+{
+    return { svorr_u64_x(svptrue_b64(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline bool gmx_simdcall anyTrue(SimdDIBool a)
+{
+    return svptest_any(svptrue_b64(), svcmpne_n_u64(svptrue_b64(), a.simdInternal_, 0));
+}
+
+static inline SimdDInt32 gmx_simdcall selectByMask(SimdDInt32 a, SimdDIBool m)
+{
+    return { svand_s64_x(svptrue_b64(), a.simdInternal_, svreinterpret_s64_u64(m.simdInternal_)) };
+}
+
+static inline SimdDInt32 gmx_simdcall selectByNotMask(SimdDInt32 a, SimdDIBool m)
+{
+    return { svbic_s64_x(svptrue_b64(), a.simdInternal_, svreinterpret_s64_u64(m.simdInternal_)) };
+}
+
+static inline SimdDInt32 gmx_simdcall blend(SimdDInt32 a, SimdDInt32 b, SimdDIBool sel)
+{
+    svbool_t pg = svcmpne_n_u64(svptrue_b64(), sel.simdInternal_, 0);
+    return { svsel_s64(pg, b.simdInternal_, a.simdInternal_) };
+}
+
+static inline SimdDInt32 gmx_simdcall cvtR2I(SimdDouble a)
+{
+    return { svcvt_s64_f64_x(svptrue_b64(), svrintn_f64_x(svptrue_b64(), a.simdInternal_)) };
+}
+
+static inline SimdDInt32 gmx_simdcall cvttR2I(SimdDouble a)
+{
+    return { svcvt_s64_f64_x(svptrue_b64(), a.simdInternal_) };
+}
+
+static inline SimdDouble gmx_simdcall cvtI2R(SimdDInt32 a)
+{
+    return { svcvt_f64_s64_x(svptrue_b64(), a.simdInternal_) };
+}
+
+static inline SimdDIBool gmx_simdcall cvtB2IB(SimdDBool a)
+{
+    SimdDIBool res;
+    res.simdInternal_ = a.simdInternal_;
+    return res;
+}
+
+static inline SimdDBool gmx_simdcall cvtIB2B(SimdDIBool a)
+{
+    SimdDBool res;
+    res.simdInternal_ = a.simdInternal_;
+    return res;
+}
+
+static inline void gmx_simdcall cvtF2DD(SimdFloat f, SimdDouble* d0, SimdDouble* d1)
+{
+    const svbool_t pg = svptrue_b64();
+    // svcvt_f64_f32 converts the even-numbered single-precision lanes, so
+    // zipping the input with itself places the relevant half in those lanes.
+    d0->simdInternal_ = svcvt_f64_f32_x(pg, svzip1_f32(f.simdInternal_, f.simdInternal_));
+    d1->simdInternal_ = svcvt_f64_f32_x(pg, svzip2_f32(f.simdInternal_, f.simdInternal_));
+}
+
+static inline SimdFloat gmx_simdcall cvtDD2F(SimdDouble d0, SimdDouble d1)
+{
+    const svbool_t pg = svptrue_b64();
+    // The converted values end up in the even-numbered single-precision
+    // lanes, from where uzp1 concatenates them into a single vector.
+    return { svuzp1_f32(svcvt_f32_f64_x(pg, d0.simdInternal_),
+                        svcvt_f32_f64_x(pg, d1.simdInternal_)) };
+}
+
+} // namespace gmx
+
+#endif // GMX_SIMD_IMPL_ARM_SVE_SIMD_DOUBLE_H
@@ -0,0 +1,558 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+
+#ifndef GMX_SIMD_IMPL_ARM_SVE_SIMD_FLOAT_H
+#define GMX_SIMD_IMPL_ARM_SVE_SIMD_FLOAT_H
+
+#include "config.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <arm_sve.h>
+
+#include "gromacs/math/utilities.h"
+
+#include "impl_arm_sve_definitions.h"
+
+namespace gmx
+{
+
+/* SVE intrinsic types are sizeless and can therefore not be class members.
+ * Since we compile for a single, fixed vector length the values can be kept
+ * in fixed-size GNU vector types instead, which the ACLE defines to be
+ * implicitly convertible to and from the corresponding SVE types when
+ * -msve-vector-bits is in effect. Boolean masks are widened to full integer
+ * vectors for storage, since fixed-size predicate members are not available
+ * on all supported compilers.
+ */
+
+class SimdFloat
+{
+public:
+    SimdFloat() {}
+
+    SimdFloat(const float f) { this->simdInternal_ = svdup_n_f32(f); }
+
+    // Internal utility constructor to simplify return statements
+    SimdFloat(svfloat32_t simd) { this->simdInternal_ = simd; }
+
+    float32_t simdInternal_ __attribute__((vector_size(GMX_SIMD_ARM_SVE_LENGTH_VALUE / 8)));
+};
+
+class SimdFInt32
+{
+public:
+    SimdFInt32() {}
+
+    SimdFInt32(const std::int32_t i) { this->simdInternal_ = svdup_n_s32(i); }
+
+    // Internal utility constructor to simplify return statements
+    SimdFInt32(svint32_t simd) { this->simdInternal_ = simd; }
+
+    int32_t simdInternal_ __attribute__((vector_size(GMX_SIMD_ARM_SVE_LENGTH_VALUE / 8)));
+};
+
+class SimdFBool
+{
+public:
+    SimdFBool() {}
+
+    SimdFBool(const bool b)
+    {
+        this->simdInternal_ = svdup_n_u32_x(svptrue_b32(), b ? 0xFFFFFFFF : 0);
+    }
+
+    // Internal utility constructors to simplify return statements
+    SimdFBool(svbool_t simd) { this->simdInternal_ = svdup_n_u32_z(simd, 0xFFFFFFFF); }
+
+    SimdFBool(svuint32_t simd) { this->simdInternal_ = simd; }
+
+    uint32_t simdInternal_ __attribute__((vector_size(GMX_SIMD_ARM_SVE_LENGTH_VALUE / 8)));
+};
+
+class SimdFIBool
+{
+public:
+    SimdFIBool() {}
+
+    SimdFIBool(const bool b)
+    {
+        this->simdInternal_ = svdup_n_u32_x(svptrue_b32(), b ? 0xFFFFFFFF : 0);
+    }
+
+    // Internal utility constructors to simplify return statements
+    SimdFIBool(svbool_t simd) { this->simdInternal_ = svdup_n_u32_z(simd, 0xFFFFFFFF); }
+
+    SimdFIBool(svuint32_t simd) { this->simdInternal_ = simd; }
+
+    uint32_t simdInternal_ __attribute__((vector_size(GMX_SIMD_ARM_SVE_LENGTH_VALUE / 8)));
+};
+
+static inline SimdFloat gmx_simdcall simdLoad(const float* m, SimdFloatTag = {})
+{
+    assert(std::size_t(m) % GMX_SIMD_ALIGNMENT == 0);
+    return { svld1_f32(svptrue_b32(), m) };
+}
+
+static inline void gmx_simdcall store(float* m, SimdFloat a)
+{
+    assert(std::size_t(m) % GMX_SIMD_ALIGNMENT == 0);
+    svst1_f32(svptrue_b32(), m, a.simdInternal_);
+}
+
+static inline SimdFloat gmx_simdcall simdLoadU(const float* m, SimdFloatTag = {})
+{
+    return { svld1_f32(svptrue_b32(), m) };
+}
+
+static inline void gmx_simdcall storeU(float* m, SimdFloat a)
+{
+    svst1_f32(svptrue_b32(), m, a.simdInternal_);
+}
+
+static inline SimdFloat gmx_simdcall setZeroF()
+{
+    return { svdup_n_f32(0.0F) };
+}
+
+static inline SimdFInt32 gmx_simdcall simdLoad(const std::int32_t* m, SimdFInt32Tag)
+{
+    assert(std::size_t(m) % GMX_SIMD_ALIGNMENT == 0);
+    return { svld1_s32(svptrue_b32(), m) };
+}
+
+static inline void gmx_simdcall store(std::int32_t* m, SimdFInt32 a)
+{
+    assert(std::size_t(m) % GMX_SIMD_ALIGNMENT == 0);
+    svst1_s32(svptrue_b32(), m, a.simdInternal_);
+}
+
+static inline SimdFInt32 gmx_simdcall simdLoadU(const std::int32_t* m, SimdFInt32Tag)
+{
+    return { svld1_s32(svptrue_b32(), m) };
+}
+
+static inline void gmx_simdcall storeU(std::int32_t* m, SimdFInt32 a)
+{
+    svst1_s32(svptrue_b32(), m, a.simdInternal_);
+}
+
+static inline SimdFInt32 gmx_simdcall setZeroFI()
+{
+    return { svdup_n_s32(0) };
+}
+
+template<int index>
+gmx_simdcall static inline std::int32_t extract(SimdFInt32 a)
+{
+    return svlasta_s32(svwhilelt_b32(0, index), a.simdInternal_);
+}
+
+static inline SimdFloat gmx_simdcall operator&(SimdFloat a, SimdFloat b)
+{
+    return { svreinterpret_f32_s32(svand_s32_x(svptrue_b32(),
+                                               svreinterpret_s32_f32(a.simdInternal_),
+                                               svreinterpret_s32_f32(b.simdInternal_))) };
+}
+
+static inline SimdFloat gmx_simdcall andNot(SimdFloat a, SimdFloat b)
+{
+    return { svreinterpret_f32_s32(svbic_s32_x(svptrue_b32(),
+                                               svreinterpret_s32_f32(b.simdInternal_),
+                                               svreinterpret_s32_f32(a.simdInternal_))) };
+}
+
+static inline SimdFloat gmx_simdcall operator|(SimdFloat a, SimdFloat b)
+{
+    return { svreinterpret_f32_s32(svorr_s32_x(svptrue_b32(),
+                                               svreinterpret_s32_f32(a.simdInternal_),
+                                               svreinterpret_s32_f32(b.simdInternal_))) };
+}
+
+static inline SimdFloat gmx_simdcall operator^(SimdFloat a, SimdFloat b)
+{
+    return { svreinterpret_f32_s32(sveor_s32_x(svptrue_b32(),
+                                               svreinterpret_s32_f32(a.simdInternal_),
+                                               svreinterpret_s32_f32(b.simdInternal_))) };
+}
+
+static inline SimdFloat gmx_simdcall operator+(SimdFloat a, SimdFloat b)
+{
+    return { svadd_f32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall operator-(SimdFloat a, SimdFloat b)
+{
+    return { svsub_f32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall operator-(SimdFloat x)
+{
+    return { svneg_f32_x(svptrue_b32(), x.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall operator*(SimdFloat a, SimdFloat b)
+{
+    return { svmul_f32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+// a*b+c
+static inline SimdFloat gmx_simdcall fma(SimdFloat a, SimdFloat b, SimdFloat c)
+{
+    return { svmad_f32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_, c.simdInternal_) };
+}
+
+// a*b-c
+static inline SimdFloat gmx_simdcall fms(SimdFloat a, SimdFloat b, SimdFloat c)
+{
+    return { svnmsb_f32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_, c.simdInternal_) };
+}
+
+// -a*b+c
+static inline SimdFloat gmx_simdcall fnma(SimdFloat a, SimdFloat b, SimdFloat c)
+{
+    return { svmsb_f32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_, c.simdInternal_) };
+}
+
+// -a*b-c
+static inline SimdFloat gmx_simdcall fnms(SimdFloat a, SimdFloat b, SimdFloat c)
+{
+    return { svnmad_f32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_, c.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall rsqrt(SimdFloat x)
+{
+    return { svrsqrte_f32(x.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall rsqrtIter(SimdFloat lu, SimdFloat x)
+{
+    return { svmul_f32_x(svptrue_b32(), lu.simdInternal_,
+                         svrsqrts_f32(svmul_f32_x(svptrue_b32(), lu.simdInternal_, lu.simdInternal_),
+                                      x.simdInternal_)) };
+}
+
+static inline SimdFloat gmx_simdcall rcp(SimdFloat x)
+{
+    return { svrecpe_f32(x.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall rcpIter(SimdFloat lu, SimdFloat x)
+{
+    return { svmul_f32_x(svptrue_b32(), lu.simdInternal_,
+                         svrecps_f32(lu.simdInternal_, x.simdInternal_)) };
+}
+
+static inline SimdFloat gmx_simdcall maskAdd(SimdFloat a, SimdFloat b, SimdFBool m)
+{
+    svbool_t pg = svcmpne_n_u32(svptrue_b32(), m.simdInternal_, 0);
+    return { svadd_f32_m(pg, a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall maskzMul(SimdFloat a, SimdFloat b, SimdFBool m)
+{
+    svbool_t pg = svcmpne_n_u32(svptrue_b32(), m.simdInternal_, 0);
+    return { svmul_f32_z(pg, a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall maskzFma(SimdFloat a, SimdFloat b, SimdFloat c, SimdFBool m)
+{
+    svbool_t pg = svcmpne_n_u32(svptrue_b32(), m.simdInternal_, 0);
+    return { svmad_f32_z(pg, a.simdInternal_, b.simdInternal_, c.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall maskzRsqrt(SimdFloat x, SimdFBool m)
+{
+    svbool_t pg = svcmpne_n_u32(svptrue_b32(), m.simdInternal_, 0);
+    // The result will always be correct since we mask the result with m, but
+    // for debug builds we also want to make sure not to generate FP exceptions
+#ifndef NDEBUG
+    x.simdInternal_ = svsel_f32(pg, x.simdInternal_, svdup_n_f32(1.0F));
+#endif
+    return { svsel_f32(pg, svrsqrte_f32(x.simdInternal_), svdup_n_f32(0.0F)) };
+}
+
+static inline SimdFloat gmx_simdcall maskzRcp(SimdFloat x, SimdFBool m)
+{
+    svbool_t pg = svcmpne_n_u32(svptrue_b32(), m.simdInternal_, 0);
+    // The result will always be correct since we mask the result with m, but
+    // for debug builds we also want to make sure not to generate FP exceptions
+#ifndef NDEBUG
+    x.simdInternal_ = svsel_f32(pg, x.simdInternal_, svdup_n_f32(1.0F));
+#endif
+    return { svsel_f32(pg, svrecpe_f32(x.simdInternal_), svdup_n_f32(0.0F)) };
+}
+
+static inline SimdFloat gmx_simdcall abs(SimdFloat x)
+{
+    return { svabs_f32_x(svptrue_b32(), x.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall max(SimdFloat a, SimdFloat b)
+{
+    return { svmax_f32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall min(SimdFloat a, SimdFloat b)
+{
+    return { svmin_f32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall round(SimdFloat x)
+{
+    return { svrintn_f32_x(svptrue_b32(), x.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall trunc(SimdFloat x)
+{
+    return { svrintz_f32_x(svptrue_b32(), x.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall frexp(SimdFloat value, SimdFInt32* exponent)
+{
+    const svbool_t  pg           = svptrue_b32();
+    const svint32_t exponentMask = svdup_n_s32(0x7F800000);
+    const svint32_t mantissaMask = svdup_n_s32(0x807FFFFF);
+    // add 1 to make our definition identical to frexp()
+    const svint32_t   exponentBias = svdup_n_s32(126);
+    const svfloat32_t half         = svdup_n_f32(0.5F);
+    svint32_t         iExponent;
+
+    iExponent = svand_s32_x(pg, svreinterpret_s32_f32(value.simdInternal_), exponentMask);
+    iExponent = svsub_s32_x(pg, svasr_n_s32_x(pg, iExponent, 23), exponentBias);
+    exponent->simdInternal_ = iExponent;
+
+    return { svreinterpret_f32_s32(
+            svorr_s32_x(pg,
+                        svand_s32_x(pg, svreinterpret_s32_f32(value.simdInternal_), mantissaMask),
+                        svreinterpret_s32_f32(half))) };
+}
+
+template<MathOptimization opt = MathOptimization::Safe>
+static inline SimdFloat gmx_simdcall ldexp(SimdFloat value, SimdFInt32 exponent)
+{
+    const svbool_t  pg           = svptrue_b32();
+    const svint32_t exponentBias = svdup_n_s32(127);
+    svint32_t       iExponent    = svadd_s32_x(pg, exponent.simdInternal_, exponentBias);
+
+    if (opt == MathOptimization::Safe)
+    {
+        // Make sure biased argument is not negative
+        iExponent = svmax_n_s32_x(pg, iExponent, 0);
+    }
+
+    iExponent = svlsl_n_s32_x(pg, iExponent, 23);
+
+    return { svmul_f32_x(pg, value.simdInternal_, svreinterpret_f32_s32(iExponent)) };
+}
+
+static inline float gmx_simdcall reduce(SimdFloat a)
+{
+    return svaddv_f32(svptrue_b32(), a.simdInternal_);
+}
+
+static inline SimdFBool gmx_simdcall operator==(SimdFloat a, SimdFloat b)
+{
+    return { svcmpeq_f32(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFBool gmx_simdcall operator!=(SimdFloat a, SimdFloat b)
+{
+    return { svcmpne_f32(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFBool gmx_simdcall operator<(SimdFloat a, SimdFloat b)
+{
+    return { svcmplt_f32(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFBool gmx_simdcall operator<=(SimdFloat a, SimdFloat b)
+{
+    return { svcmple_f32(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFBool gmx_simdcall testBits(SimdFloat a)
+{
+    return { svcmpne_n_u32(svptrue_b32(), svreinterpret_u32_f32(a.simdInternal_), 0) };
+}
+
+static inline SimdFBool gmx_simdcall operator&&(SimdFBool a, SimdFBool b)
+{
+    return { svand_u32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFBool gmx_simdcall operator||(SimdFBool a, SimdFBool b)
+{
+    return { svorr_u32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline bool gmx_simdcall anyTrue(SimdFBool a)
+{
+    return svptest_any(svptrue_b32(), svcmpne_n_u32(svptrue_b32(), a.simdInternal_, 0));
+}
+
+static inline SimdFloat gmx_simdcall selectByMask(SimdFloat a, SimdFBool m)
+{
+    return { svreinterpret_f32_u32(svand_u32_x(
+            svptrue_b32(), svreinterpret_u32_f32(a.simdInternal_), m.simdInternal_)) };
+}
+
+static inline SimdFloat gmx_simdcall selectByNotMask(SimdFloat a, SimdFBool m)
+{
+    return { svreinterpret_f32_u32(svbic_u32_x(
+            svptrue_b32(), svreinterpret_u32_f32(a.simdInternal_), m.simdInternal_)) };
+}
+
+static inline SimdFloat gmx_simdcall blend(SimdFloat a, SimdFloat b, SimdFBool sel)
+{
+    svbool_t pg = svcmpne_n_u32(svptrue_b32(), sel.simdInternal_, 0);
+    return { svsel_f32(pg, b.simdInternal_, a.simdInternal_) };
+}
+
+static inline SimdFInt32 gmx_simdcall operator&(SimdFInt32 a, SimdFInt32 b)
+{
+    return { svand_s32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFInt32 gmx_simdcall andNot(SimdFInt32 a, SimdFInt32 b)
+{
+    return { svbic_s32_x(svptrue_b32(), b.simdInternal_, a.simdInternal_) };
+}
+
+static inline SimdFInt32 gmx_simdcall operator|(SimdFInt32 a, SimdFInt32 b)
+{
+    return { svorr_s32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFInt32 gmx_simdcall operator^(SimdFInt32 a, SimdFInt32 b)
+{
+    return { sveor_s32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFInt32 gmx_simdcall operator+(SimdFInt32 a, SimdFInt32 b)
+{
+    return { svadd_s32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFInt32 gmx_simdcall operator-(SimdFInt32 a, SimdFInt32 b)
+{
+    return { svsub_s32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFInt32 gmx_simdcall operator*(SimdFInt32 a, SimdFInt32 b)
+{
+    return { svmul_s32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFIBool gmx_simdcall operator==(SimdFInt32 a, SimdFInt32 b)
+{
+    return { svcmpeq_s32(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFIBool gmx_simdcall testBits(SimdFInt32 a)
+{
+    return { svcmpne_n_s32(svptrue_b32(), a.simdInternal_, 0) };
+}
+
+static inline SimdFIBool gmx_simdcall operator<(SimdFInt32 a, SimdFInt32 b)
+{
+    return { svcmplt_s32(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFIBool gmx_simdcall operator&&(SimdFIBool a, SimdFIBool b)
+{
+    return { svand_u32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline SimdFIBool gmx_simdcall operator||(SimdFIBool a, SimdFIBool b)
+{
+    return { svorr_u32_x(svptrue_b32(), a.simdInternal_, b.simdInternal_) };
+}
+
+static inline bool gmx_simdcall anyTrue(SimdFIBool a)
+{
+    return svptest_any(svptrue_b32(), svcmpne_n_u32(svptrue_b32(), a.simdInternal_, 0));
+}
+
+static inline SimdFInt32 gmx_simdcall selectByMask(SimdFInt32 a, SimdFIBool m)
+{
+    return { svand_s32_x(svptrue_b32(), a.simdInternal_, svreinterpret_s32_u32(m.simdInternal_)) };
+}
+
+static inline SimdFInt32 gmx_simdcall selectByNotMask(SimdFInt32 a, SimdFIBool m)
+{
+    return { svbic_s32_x(svptrue_b32(), a.simdInternal_, svreinterpret_s32_u32(m.simdInternal_)) };
+}
+
+static inline SimdFInt32 gmx_simdcall blend(SimdFInt32 a, SimdFInt32 b, SimdFIBool sel)
+{
+    svbool_t pg = svcmpne_n_u32(svptrue_b32(), sel.simdInternal_, 0);
+    return { svsel_s32(pg, b.simdInternal_, a.simdInternal_) };
+}
+
+static inline SimdFInt32 gmx_simdcall cvtR2I(SimdFloat a)
+{
+    return { svcvt_s32_f32_x(svptrue_b32(), svrintn_f32_x(svptrue_b32(), a.simdInternal_)) };
+}
+
+static inline SimdFInt32 gmx_simdcall cvttR2I(SimdFloat a)
+{
+    return { svcvt_s32_f32_x(svptrue_b32(), a.simdInternal_) };
+}
+
+static inline SimdFloat gmx_simdcall cvtI2R(SimdFInt32 a)
+{
+    return { svcvt_f32_s32_x(svptrue_b32(), a.simdInternal_) };
+}
+
+static inline SimdFIBool gmx_simdcall cvtB2IB(SimdFBool a)
+{
+    SimdFIBool res;
+    res.simdInternal_ = a.simdInternal_;
+    return res;
+}
+
+static inline SimdFBool gmx_simdcall cvtIB2B(SimdFIBool a)
+{
+    SimdFBool res;
+    res.simdInternal_ = a.simdInternal_;
+    return res;
+}
+
+} // namespace gmx
+
+#endif // GMX_SIMD_IMPL_ARM_SVE_SIMD_FLOAT_H
@@ -0,0 +1,286 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+
+#ifndef GMX_SIMD_IMPL_ARM_SVE_UTIL_DOUBLE_H
+#define GMX_SIMD_IMPL_ARM_SVE_UTIL_DOUBLE_H
+
+#include "config.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <arm_sve.h>
+
+#include "impl_arm_sve_definitions.h"
+#include "impl_arm_sve_simd_double.h"
+
+namespace gmx
+{
+
+/* As in single precision, the transpose utilities use gather and scatter
+ * instructions with computed per-lane indices to stay vector-length
+ * agnostic. The 32-bit offset arrays are widened to 64-bit lanes on load.
+ */
+
+template<int align>
+static inline void gmx_simdcall gatherLoadTranspose(const double*      base,
+                                                    const std::int32_t offset[],
+                                                    SimdDouble*        v0,
+                                                    SimdDouble*        v1,
+                                                    SimdDouble*        v2,
+                                                    SimdDouble*        v3)
+{
+    assert(std::size_t(offset) % (GMX_SIMD_DINT32_WIDTH * sizeof(std::int32_t)) == 0);
+    assert(std::size_t(base) % (align * sizeof(double)) == 0);
+    assert(align % 4 == 0);
+
+    const svbool_t pg  = svptrue_b64();
+    svint64_t      idx = svmul_n_s64_x(pg, svld1sw_s64(pg, offset), align);
+
+    v0->simdInternal_ = svld1_gather_s64index_f64(pg, base, idx);
+    v1->simdInternal_ = svld1_gather_s64index_f64(pg, base + 1, idx);
+    v2->simdInternal_ = svld1_gather_s64index_f64(pg, base + 2, idx);
+    v3->simdInternal_ = svld1_gather_s64index_f64(pg, base + 3, idx);
+}
+
+template<int align>
+static inline void gmx_simdcall
+gatherLoadTranspose(const double* base, const std::int32_t offset[], SimdDouble* v0, SimdDouble* v1)
+{
+    assert(std::size_t(offset) % (GMX_SIMD_DINT32_WIDTH * sizeof(std::int32_t)) == 0);
+    assert(std::size_t(base) % (align * sizeof(double)) == 0);
+    assert(align % 2 == 0);
+
+    const svbool_t pg  = svptrue_b64();
+    svint64_t      idx = svmul_n_s64_x(pg, svld1sw_s64(pg, offset), align);
+
+    v0->simdInternal_ = svld1_gather_s64index_f64(pg, base, idx);
+    v1->simdInternal_ = svld1_gather_s64index_f64(pg, base + 1, idx);
+}
+
+static const int c_simdBestPairAlignmentDouble = 2;
+
+template<int align>
+static inline void gmx_simdcall gatherLoadUTranspose(const double*      base,
+                                                     const std::int32_t offset[],
+                                                     SimdDouble*        v0,
+                                                     SimdDouble*        v1,
+                                                     SimdDouble*        v2)
+{
+    assert(std::size_t(offset) % (GMX_SIMD_DINT32_WIDTH * sizeof(std::int32_t)) == 0);
+
+    const svbool_t pg  = svptrue_b64();
+    svint64_t      idx = svmul_n_s64_x(pg, svld1sw_s64(pg, offset), align);
+
+    v0->simdInternal_ = svld1_gather_s64index_f64(pg, base, idx);
+    v1->simdInternal_ = svld1_gather_s64index_f64(pg, base + 1, idx);
+    v2->simdInternal_ = svld1_gather_s64index_f64(pg, base + 2, idx);
+}
+
+template<int align>
+static inline void gmx_simdcall
+transposeScatterStoreU(double* base, const std::int32_t offset[], SimdDouble v0, SimdDouble v1, SimdDouble v2)
+{
+    assert(std::size_t(offset) % (GMX_SIMD_DINT32_WIDTH * sizeof(std::int32_t)) == 0);
+
+    const svbool_t pg  = svptrue_b64();
+    svint64_t      idx = svmul_n_s64_x(pg, svld1sw_s64(pg, offset), align);
+
+    svst1_scatter_s64index_f64(pg, base, idx, v0.simdInternal_);
+    svst1_scatter_s64index_f64(pg, base + 1, idx, v1.simdInternal_);
+    svst1_scatter_s64index_f64(pg, base + 2, idx, v2.simdInternal_);
+}
+
+template<int align>
+static inline void gmx_simdcall
+transposeScatterIncrU(double* base, const std::int32_t offset[], SimdDouble v0, SimdDouble v1, SimdDouble v2)
+{
+    assert(std::size_t(offset) % (GMX_SIMD_DINT32_WIDTH * sizeof(std::int32_t)) == 0);
+
+    // All callers guarantee the offsets are distinct within one call, so the
+    // gather-add-scatter read-modify-write sequences below cannot alias.
+    const svbool_t pg  = svptrue_b64();
+    svint64_t      idx = svmul_n_s64_x(pg, svld1sw_s64(pg, offset), align);
+
+    svst1_scatter_s64index_f64(
+            pg, base, idx,
+            svadd_f64_x(pg, svld1_gather_s64index_f64(pg, base, idx), v0.simdInternal_));
+    svst1_scatter_s64index_f64(
+            pg, base + 1, idx,
+            svadd_f64_x(pg, svld1_gather_s64index_f64(pg, base + 1, idx), v1.simdInternal_));
+    svst1_scatter_s64index_f64(
+            pg, base + 2, idx,
+            svadd_f64_x(pg, svld1_gather_s64index_f64(pg, base + 2, idx), v2.simdInternal_));
+}
+
+template<int align>
+static inline void gmx_simdcall
+transposeScatterDecrU(double* base, const std::int32_t offset[], SimdDouble v0, SimdDouble v1, SimdDouble v2)
+{
+    assert(std::size_t(offset) % (GMX_SIMD_DINT32_WIDTH * sizeof(std::int32_t)) == 0);
+
+    // All callers guarantee the offsets are distinct within one call, so the
+    // gather-subtract-scatter read-modify-write sequences below cannot alias.
+    const svbool_t pg  = svptrue_b64();
+    svint64_t      idx = svmul_n_s64_x(pg, svld1sw_s64(pg, offset), align);
+
+    svst1_scatter_s64index_f64(
+            pg, base, idx,
+            svsub_f64_x(pg, svld1_gather_s64index_f64(pg, base, idx), v0.simdInternal_));
+    svst1_scatter_s64index_f64(
+            pg, base + 1, idx,
+            svsub_f64_x(pg, svld1_gather_s64index_f64(pg, base + 1, idx), v1.simdInternal_));
+    svst1_scatter_s64index_f64(
+            pg, base + 2, idx,
+            svsub_f64_x(pg, svld1_gather_s64index_f64(pg, base + 2, idx), v2.simdInternal_));
+}
+
+static inline void gmx_simdcall expandScalarsToTriplets(SimdDouble  scalar,
+                                                        SimdDouble* triplets0,
+                                                        SimdDouble* triplets1,
+                                                        SimdDouble* triplets2)
+{
+    const svbool_t   pg   = svptrue_b64();
+    const svuint64_t lane = svindex_u64(0, 1);
+
+    triplets0->simdInternal_ = svtbl_f64(
+            scalar.simdInternal_, svdiv_n_u64_x(pg, lane, 3));
+    triplets1->simdInternal_ = svtbl_f64(
+            scalar.simdInternal_,
+            svdiv_n_u64_x(pg, svadd_n_u64_x(pg, lane, GMX_SIMD_DOUBLE_WIDTH), 3));
+    triplets2->simdInternal_ = svtbl_f64(
+            scalar.simdInternal_,
+            svdiv_n_u64_x(pg, svadd_n_u64_x(pg, lane, 2 * GMX_SIMD_DOUBLE_WIDTH), 3));
+}
+
+template<int align>
+static inline void gmx_simdcall gatherLoadBySimdIntTranspose(const double* base,
+                                                             SimdDInt32    offset,
+                                                             SimdDouble*   v0,
+                                                             SimdDouble*   v1,
+                                                             SimdDouble*   v2,
+                                                             SimdDouble*   v3)
+{
+    assert(std::size_t(base) % (align * sizeof(double)) == 0);
+    assert(align % 4 == 0);
+
+    const svbool_t pg  = svptrue_b64();
+    svint64_t      idx = svmul_n_s64_x(pg, offset.simdInternal_, align);
+
+    v0->simdInternal_ = svld1_gather_s64index_f64(pg, base, idx);
+    v1->simdInternal_ = svld1_gather_s64index_f64(pg, base + 1, idx);
+    v2->simdInternal_ = svld1_gather_s64index_f64(pg, base + 2, idx);
+    v3->simdInternal_ = svld1_gather_s64index_f64(pg, base + 3, idx);
+}
+
+template<int align>
+static inline void gmx_simdcall
+gatherLoadBySimdIntTranspose(const double* base, SimdDInt32 offset, SimdDouble* v0, SimdDouble* v1)
+{
+    assert(std::size_t(base) % (align * sizeof(double)) == 0);
+    assert(align % 2 == 0);
+
+    const svbool_t pg  = svptrue_b64();
+    svint64_t      idx = svmul_n_s64_x(pg, offset.simdInternal_, align);
+
+    v0->simdInternal_ = svld1_gather_s64index_f64(pg, base, idx);
+    v1->simdInternal_ = svld1_gather_s64index_f64(pg, base + 1, idx);
+}
+
+template<int align>
+static inline void gmx_simdcall
+gatherLoadUBySimdIntTranspose(const double* base, SimdDInt32 offset, SimdDouble* v0, SimdDouble* v1)
+{
+    const svbool_t pg  = svptrue_b64();
+    svint64_t      idx = svmul_n_s64_x(pg, offset.simdInternal_, align);
+
+    v0->simdInternal_ = svld1_gather_s64index_f64(pg, base, idx);
+    v1->simdInternal_ = svld1_gather_s64index_f64(pg, base + 1, idx);
+}
+
+static inline double gmx_simdcall
+reduceIncr4ReturnSum(double* m, SimdDouble v0, SimdDouble v1, SimdDouble v2, SimdDouble v3)
+{
+    assert(std::size_t(m) % (4 * sizeof(double)) == 0);
+
+    double sum0 = svaddv_f64(svptrue_b64(), v0.simdInternal_);
+    double sum1 = svaddv_f64(svptrue_b64(), v1.simdInternal_);
+    double sum2 = svaddv_f64(svptrue_b64(), v2.simdInternal_);
+    double sum3 = svaddv_f64(svptrue_b64(), v3.simdInternal_);
+
+    m[0] += sum0;
+    m[1] += sum1;
+    m[2] += sum2;
+    m[3] += sum3;
+
+    return sum0 + sum1 + sum2 + sum3;
+}
+
+#if GMX_SIMD_DOUBLE_WIDTH > 4
+static inline SimdDouble gmx_simdcall loadUNDuplicate4(const double* f)
+{
+    const svbool_t pg = svptrue_b64();
+    return { svld1_gather_u64index_f64(pg, f, svlsr_n_u64_x(pg, svindex_u64(0, 1), 2)) };
+}
+
+static inline SimdDouble gmx_simdcall load4DuplicateN(const double* f)
+{
+    const svbool_t pg = svptrue_b64();
+    return { svld1_gather_u64index_f64(pg, f, svand_n_u64_x(pg, svindex_u64(0, 1), 3)) };
+}
+
+static inline SimdDouble gmx_simdcall loadU4NOffset(const double* f, int offset)
+{
+    const svbool_t   pg   = svptrue_b64();
+    const svuint64_t lane = svindex_u64(0, 1);
+    svuint64_t       idx  = svadd_u64_x(pg, svand_n_u64_x(pg, lane, 3),
+                                        svmul_n_u64_x(pg, svlsr_n_u64_x(pg, lane, 2), offset));
+    return { svld1_gather_u64index_f64(pg, f, idx) };
+}
+
+static inline void gmx_simdcall storeU4NOffset(double* f, int offset, SimdDouble a)
+{
+    const svbool_t   pg   = svptrue_b64();
+    const svuint64_t lane = svindex_u64(0, 1);
+    svuint64_t       idx  = svadd_u64_x(pg, svand_n_u64_x(pg, lane, 3),
+                                        svmul_n_u64_x(pg, svlsr_n_u64_x(pg, lane, 2), offset));
+    svst1_scatter_u64index_f64(pg, f, idx, a.simdInternal_);
+}
+#endif // GMX_SIMD_DOUBLE_WIDTH > 4
+
+} // namespace gmx
+
+#endif // GMX_SIMD_IMPL_ARM_SVE_UTIL_DOUBLE_H
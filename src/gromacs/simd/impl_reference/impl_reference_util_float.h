@@ -980,6 +980,27 @@ static inline SimdFloat gmx_simdcall loadU4NOffset(const float* m, int offset)
     }
     return a;
 }
+
+/*! \brief Store floats in blocks of 4 at fixed offsets
+ *
+ * \param m Pointer to unaligned memory
+ * \param offset Offset in memory between output blocks of 4
+ * \param a SIMD variable with floats to store
+ *
+ * Available if \ref GMX_SIMD_HAVE_4NSIMD_UTIL_FLOAT is 1.
+ * Blocks of 4 floats are stored to m+n*offset where n
+ * is the n-th block of 4 floats.
+ */
+static inline void gmx_simdcall storeU4NOffset(float* m, int offset, SimdFloat a)
+{
+    for (std::size_t i = 0; i < a.simdInternal_.size() / 4; i++)
+    {
+        m[offset * i + 0] = a.simdInternal_[i * 4];
+        m[offset * i + 1] = a.simdInternal_[i * 4 + 1];
+        m[offset * i + 2] = a.simdInternal_[i * 4 + 2];
+        m[offset * i + 3] = a.simdInternal_[i * 4 + 3];
+    }
+}
 #endif
 
 /*! \} */
@@ -674,6 +674,12 @@ static inline SimdFloat gmx_simdcall loadU4NOffset(const float* m, int offset)
     return { _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(m)), _mm_loadu_ps(m + offset), 0x1) };
 }
 
+static inline void gmx_simdcall storeU4NOffset(float* m, int offset, SimdFloat a)
+{
+    _mm_storeu_ps(m, _mm256_castps256_ps128(a.simdInternal_));
+    _mm_storeu_ps(m + offset, _mm256_extractf128_ps(a.simdInternal_, 0x1));
+}
+
 
 } // namespace gmx
 
@@ -424,6 +424,12 @@ static inline SimdDouble gmx_simdcall loadU4NOffset(const double* m, int offset)
                                 _mm256_loadu_pd(m + offset), 1) };
 }
 
+static inline void gmx_simdcall storeU4NOffset(double* m, int offset, SimdDouble a)
+{
+    _mm256_storeu_pd(m, _mm512_castpd512_pd256(a.simdInternal_));
+    _mm256_storeu_pd(m + offset, _mm512_extractf64x4_pd(a.simdInternal_, 1));
+}
+
 } // namespace gmx
 
 #endif // GMX_SIMD_IMPL_X86_AVX_512_UTIL_DOUBLE_H
@@ -477,6 +477,15 @@ static inline SimdFloat gmx_simdcall loadU4NOffset(const float* f, int offset)
     return { _mm512_castpd_ps(_mm512_i32gather_pd(gdx, reinterpret_cast<const double*>(f), sizeof(float))) };
 }
 
+static inline void gmx_simdcall storeU4NOffset(float* f, int offset, SimdFloat a)
+{
+    const __m256i idx = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i gdx = _mm256_add_epi32(_mm256_setr_epi32(0, 2, 0, 2, 0, 2, 0, 2),
+                                         _mm256_mullo_epi32(idx, _mm256_set1_epi32(offset)));
+    _mm512_i32scatter_pd(reinterpret_cast<double*>(f), gdx,
+                         _mm512_castps_pd(a.simdInternal_), sizeof(float));
+}
+
 } // namespace gmx
 
 #endif // GMX_SIMD_IMPL_X86_AVX_512_UTIL_FLOAT_H
@@ -151,6 +151,8 @@ struct SimdDInt32Tag
 #    include "impl_arm_neon/impl_arm_neon.h"
 #elif GMX_SIMD_ARM_NEON_ASIMD
 #    include "impl_arm_neon_asimd/impl_arm_neon_asimd.h"
+#elif GMX_SIMD_ARM_SVE
+#    include "impl_arm_sve/impl_arm_sve.h"
 #elif GMX_SIMD_IBM_VMX
 #    include "impl_ibm_vmx/impl_ibm_vmx.h"
 #elif GMX_SIMD_IBM_VSX
@@ -633,11 +635,22 @@ T loadU(const typename internal::Simd4Traits<T>::type* m)
 {
     return load4U(m);
 }
+template<typename T>
+void store(typename internal::Simd4Traits<T>::type* m, T a)
+{
+    store4(m, a);
+}
+template<typename T>
+void storeU(typename internal::Simd4Traits<T>::type* m, T a)
+{
+    store4U(m, a);
+}
 #endif
 
 /* Implement most of 4xn functions by forwarding them to other functions when possible.
  * The functions forwarded here don't need to be implemented by each implementation.
- * For width=4 all functions are forwarded and for width=8 all but loadU4NOffset are forwarded.
+ * For width=4 all functions are forwarded and for width=8 all but loadU4NOffset and
+ * storeU4NOffset are forwarded.
  */
 #if GMX_SIMD_HAVE_FLOAT
 #    if GMX_SIMD_FLOAT_WIDTH < 4
@@ -670,7 +683,11 @@ static inline Simd4NFloat gmx_simdcall loadU4NOffset(const float* f, int)
 {
     return loadU<Simd4NFloat>(f);
 }
-#        elif GMX_SIMD_FLOAT_WIDTH == 8
+static inline void gmx_simdcall storeU4NOffset(float* f, int /*unused*/, Simd4NFloat a)
+{
+    storeU(f, a);
+}
+#        elif GMX_SIMD_FLOAT_WIDTH == 8 && GMX_SIMD_HAVE_HSIMD_UTIL_FLOAT
 static inline Simd4NFloat gmx_simdcall loadUNDuplicate4(const float* f)
 {
     return loadU1DualHsimd(f);
@@ -716,7 +733,11 @@ static inline Simd4NDouble gmx_simdcall loadU4NOffset(const double* f, int /*unu
 {
     return loadU<Simd4NDouble>(f);
 }
-#        elif GMX_SIMD_DOUBLE_WIDTH == 8
+static inline void gmx_simdcall storeU4NOffset(double* f, int /*unused*/, Simd4NDouble a)
+{
+    storeU(f, a);
+}
+#        elif GMX_SIMD_DOUBLE_WIDTH == 8 && GMX_SIMD_HAVE_HSIMD_UTIL_DOUBLE
 static inline Simd4NDouble gmx_simdcall loadUNDuplicate4(const double* f)
 {
     return loadU1DualHsimd(f);
@@ -70,6 +70,7 @@ enum class SimdType
     X86_Mic,       //!< Knight's corner
     Arm_Neon,      //!< 32-bit ARM NEON
     Arm_NeonAsimd, //!< 64-bit ARM AArch64 Advanced SIMD
+    Arm_Sve,       //!< 64-bit ARM AArch64 Scalable Vector Extensions
     Ibm_Vmx,       //!< IBM VMX SIMD (Altivec on Power6 and later)
     Ibm_Vsx,       //!< IBM VSX SIMD (Power7 and later)
     Fujitsu_HpcAce //!< Fujitsu K-computer
@@ -985,6 +985,38 @@ TEST_F(SimdFloatingpointUtilTest, loadU4NOffset)
     GMX_EXPECT_SIMD_REAL_EQ(v0, v1);
 }
 
+#        if GMX_SIMD_HAVE_STOREU
+
+TEST_F(SimdFloatingpointUtilTest, storeU4NOffset)
+{
+    constexpr int offset  = 6; // non power of 2
+    constexpr int dataLen = 4 + offset * (GMX_SIMD_REAL_WIDTH / 4 - 1);
+    real          data[dataLen];
+    std::fill(data, data + dataLen, 0);
+
+    std::iota(val0_, val0_ + GMX_SIMD_REAL_WIDTH, 1);
+
+    storeU4NOffset(data, offset, load<Simd4NReal>(val0_));
+
+    for (int i = 0; i < GMX_SIMD_REAL_WIDTH / 4; i++)
+    {
+        EXPECT_EQ(val0_[i * 4], data[0 + offset * i]);
+        EXPECT_EQ(val0_[i * 4 + 1], data[1 + offset * i]);
+        EXPECT_EQ(val0_[i * 4 + 2], data[2 + offset * i]);
+        EXPECT_EQ(val0_[i * 4 + 3], data[3 + offset * i]);
+    }
+    // The gaps between the blocks of 4 should be untouched
+    for (int i = 0; i < GMX_SIMD_REAL_WIDTH / 4 - 1; i++)
+    {
+        for (int j = 4; j < offset; j++)
+        {
+            EXPECT_EQ(real(0), data[j + offset * i]);
+        }
+    }
+}
+
+#        endif // GMX_SIMD_HAVE_STOREU
+
 #    endif // GMX_SIMD_HAVE_4NSIMD_UTIL_REAL
 
 #endif // GMX_SIMD_HAVE_REAL
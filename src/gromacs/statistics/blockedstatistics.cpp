@@ -0,0 +1,184 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Implements incremental blocked statistics for observable streams
+ *
+ * \ingroup module_statistics
+ */
+#include "gmxpre.h"
+
+#include "blockedstatistics.h"
+
+#include <cmath>
+
+#include <algorithm>
+
+namespace gmx
+{
+
+namespace
+{
+
+/*! \brief Minimum number of blocks for a level to enter the error estimate.
+ *
+ * With fewer blocks the variance of the block means is itself too noisy
+ * to be useful for locating the plateau.
+ */
+constexpr int64_t c_minBlocksForError = 8;
+
+} // namespace
+
+BlockedStatistics::BlockedStatistics() : numPoints_(0) {}
+
+void BlockedStatistics::reset()
+{
+    levels_.clear();
+    numPoints_ = 0;
+}
+
+void BlockedStatistics::addPoint(double value)
+{
+    numPoints_++;
+    /* Enter the value at level 0 and propagate completed pairs upwards;
+     * each pair of block means forms one mean at twice the block size.
+     */
+    for (size_t level = 0;; level++)
+    {
+        if (level == levels_.size())
+        {
+            levels_.emplace_back();
+        }
+        BlockLevel& blockLevel = levels_[level];
+
+        blockLevel.numBlocks++;
+        blockLevel.sum += value;
+        blockLevel.sumOfSquares += value * value;
+        if (!blockLevel.havePending)
+        {
+            blockLevel.pendingMean = value;
+            blockLevel.havePending = true;
+            break;
+        }
+        value                  = 0.5 * (blockLevel.pendingMean + value);
+        blockLevel.havePending = false;
+    }
+}
+
+double BlockedStatistics::mean() const
+{
+    if (numPoints_ == 0)
+    {
+        return 0;
+    }
+
+    return levels_[0].sum / numPoints_;
+}
+
+double BlockedStatistics::variance() const
+{
+    if (numPoints_ < 2)
+    {
+        return 0;
+    }
+    const BlockLevel& raw = levels_[0];
+    const double      ssd = raw.sumOfSquares - raw.sum * raw.sum / numPoints_;
+
+    return std::max(ssd, 0.0) / (numPoints_ - 1);
+}
+
+double BlockedStatistics::standardDeviation() const
+{
+    return std::sqrt(variance());
+}
+
+double BlockedStatistics::squaredErrorAtLevel(int level) const
+{
+    const BlockLevel& blockLevel = levels_[level];
+    const int64_t     n          = blockLevel.numBlocks;
+    const double ssd = blockLevel.sumOfSquares - blockLevel.sum * blockLevel.sum / n;
+
+    /* Variance of the mean estimated from n block means */
+    return std::max(ssd, 0.0) / (n - 1) / n;
+}
+
+double BlockedStatistics::errorEstimate() const
+{
+    if (numPoints_ < 2)
+    {
+        return 0;
+    }
+    /* The blocked error grows with block size until the blocks are longer
+     * than the correlation time and then plateaus; blocking is continued
+     * while the estimate still grows, and stopped at the first level that
+     * no longer increases it, which avoids chasing the noise of the few
+     * large blocks at the top of the hierarchy.
+     */
+    double squaredError = squaredErrorAtLevel(0);
+    for (size_t level = 1; level < levels_.size(); level++)
+    {
+        if (levels_[level].numBlocks < c_minBlocksForError)
+        {
+            break;
+        }
+        const double next = squaredErrorAtLevel(level);
+        if (next <= squaredError)
+        {
+            break;
+        }
+        squaredError = next;
+    }
+
+    return std::sqrt(squaredError);
+}
+
+double BlockedStatistics::autocorrelationTime() const
+{
+    const double var = variance();
+    if (var <= 0)
+    {
+        return 0;
+    }
+    /* The statistical inefficiency g relates the true squared error of the
+     * mean to the naive one: error^2 = g var/N, with g = 2 tau for points
+     * sampled every tau_sample; uncorrelated data gives g = 1, tau = 0.5.
+     */
+    const double error = errorEstimate();
+    const double g     = error * error * numPoints_ / var;
+
+    return 0.5 * std::max(g, 1.0);
+}
+
+} // namespace gmx
@@ -0,0 +1,137 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares incremental blocked statistics for observable streams
+ *
+ * \inlibraryapi
+ * \ingroup module_statistics
+ */
+#ifndef GMX_STATISTICS_BLOCKEDSTATISTICS_H
+#define GMX_STATISTICS_BLOCKEDSTATISTICS_H
+
+#include <cstdint>
+
+#include <vector>
+
+namespace gmx
+{
+
+/*! \libinternal \brief
+ * Incremental statistics over a stream of observations using block averaging.
+ *
+ * Unlike gmx_stats_t, which stores every sample and recomputes aggregates
+ * on query, this class keeps only running sums, so a stream of any length
+ * needs a few kilobytes of memory: points are paired into blocks of
+ * doubling size (the Flyvbjerg-Petersen blocking transform), and the sum
+ * and sum of squares of the block means are maintained at each of the
+ * O(log N) levels.
+ *
+ * Besides the mean and variance this yields an error estimate of the mean
+ * that accounts for correlation between successive points, and from the
+ * ratio of the blocked to the naive error an estimate of the integrated
+ * autocorrelation time, which makes the class suitable for on-the-fly
+ * convergence monitoring of per-step observables in long runs.
+ *
+ * All results are computed from the current running sums, so queries can
+ * be freely interleaved with addPoint() calls.
+ */
+class BlockedStatistics
+{
+public:
+    BlockedStatistics();
+
+    //! Add an observation to the stream.
+    void addPoint(double value);
+
+    //! Discard all accumulated data.
+    void reset();
+
+    //! Return the number of observations added so far.
+    int64_t numPoints() const { return numPoints_; }
+
+    //! Return the mean of the observations, or 0 without data.
+    double mean() const;
+
+    //! Return the unbiased variance of the individual observations, or 0 with fewer than two points.
+    double variance() const;
+
+    //! Return the standard deviation of the individual observations.
+    double standardDeviation() const;
+
+    /*! \brief Return the estimated standard error of the mean.
+     *
+     * Block means at increasing block size are decorrelated progressively;
+     * the estimate is taken where the blocked error reaches its plateau.
+     * With fewer than two points, returns 0.
+     */
+    double errorEstimate() const;
+
+    /*! \brief Return the estimated integrated autocorrelation time.
+     *
+     * The time is expressed in units of the sampling interval, and is 0.5
+     * for uncorrelated data. With fewer than two points or zero variance,
+     * returns 0.
+     */
+    double autocorrelationTime() const;
+
+private:
+    //! Running sums over the block means at one block-size level.
+    struct BlockLevel
+    {
+        //! Number of completed blocks at this level.
+        int64_t numBlocks = 0;
+        //! Sum of the block means.
+        double sum = 0;
+        //! Sum of the squared block means.
+        double sumOfSquares = 0;
+        //! Block mean waiting for its partner to form the next-level block.
+        double pendingMean = 0;
+        //! Whether pendingMean holds a value.
+        bool havePending = false;
+    };
+
+    //! Return the squared standard error of the mean at blocking level \p level.
+    double squaredErrorAtLevel(int level) const;
+
+    //! Blocking levels; level 0 holds the raw observations.
+    std::vector<BlockLevel> levels_;
+    //! Total number of observations.
+    int64_t numPoints_;
+};
+
+} // namespace gmx
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for incremental blocked statistics
+ *
+ * \ingroup module_statistics
+ */
+#include "gmxpre.h"
+
+#include "gromacs/statistics/blockedstatistics.h"
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/random/normaldistribution.h"
+#include "gromacs/random/threefry.h"
+
+namespace gmx
+{
+namespace
+{
+
+TEST(BlockedStatisticsTest, EmptyReturnsZero)
+{
+    BlockedStatistics stats;
+
+    EXPECT_EQ(stats.numPoints(), 0);
+    EXPECT_EQ(stats.mean(), 0);
+    EXPECT_EQ(stats.variance(), 0);
+    EXPECT_EQ(stats.errorEstimate(), 0);
+    EXPECT_EQ(stats.autocorrelationTime(), 0);
+}
+
+TEST(BlockedStatisticsTest, ComputesMeanAndVariance)
+{
+    BlockedStatistics stats;
+
+    /* 1..9 has mean 5 and unbiased variance 7.5 */
+    for (int i = 1; i <= 9; i++)
+    {
+        stats.addPoint(i);
+    }
+    EXPECT_EQ(stats.numPoints(), 9);
+    EXPECT_DOUBLE_EQ(stats.mean(), 5.0);
+    EXPECT_DOUBLE_EQ(stats.variance(), 7.5);
+    EXPECT_DOUBLE_EQ(stats.standardDeviation(), std::sqrt(7.5));
+}
+
+TEST(BlockedStatisticsTest, ResetDiscardsData)
+{
+    BlockedStatistics stats;
+
+    for (int i = 0; i < 100; i++)
+    {
+        stats.addPoint(i);
+    }
+    stats.reset();
+    EXPECT_EQ(stats.numPoints(), 0);
+    EXPECT_EQ(stats.mean(), 0);
+
+    stats.addPoint(2);
+    stats.addPoint(4);
+    EXPECT_DOUBLE_EQ(stats.mean(), 3.0);
+}
+
+TEST(BlockedStatisticsTest, UncorrelatedDataGivesNaiveError)
+{
+    ThreeFry2x64<>               rng(0x4d4f434bULL, RandomDomain::Other);
+    NormalDistribution<double>   normal(0.0, 1.0);
+    BlockedStatistics            stats;
+    const int                    numPoints = 65536;
+
+    for (int i = 0; i < numPoints; i++)
+    {
+        stats.addPoint(normal(rng));
+    }
+    const double naiveError = std::sqrt(stats.variance() / stats.numPoints());
+    /* For uncorrelated data the blocked error should stay close to the
+     * naive one, and the autocorrelation time close to 0.5. The estimates
+     * fluctuate, so the tolerances are loose.
+     */
+    EXPECT_NEAR(stats.errorEstimate() / naiveError, 1.0, 0.25);
+    EXPECT_NEAR(stats.autocorrelationTime(), 0.5, 0.3);
+}
+
+TEST(BlockedStatisticsTest, CorrelatedDataGivesLargerError)
+{
+    ThreeFry2x64<>             rng(0x41523141ULL, RandomDomain::Other);
+    NormalDistribution<double> normal(0.0, 1.0);
+    BlockedStatistics          stats;
+    const int                  numPoints = 65536;
+    /* AR(1) process with autocorrelation 0.9 per step, for which the
+     * integrated autocorrelation time is (1+phi)/(2(1-phi)) = 9.5.
+     */
+    const double phi   = 0.9;
+    double       value = 0;
+
+    for (int i = 0; i < numPoints; i++)
+    {
+        value = phi * value + std::sqrt(1 - phi * phi) * normal(rng);
+        stats.addPoint(value);
+    }
+    const double naiveError = std::sqrt(stats.variance() / stats.numPoints());
+    EXPECT_GT(stats.errorEstimate(), 2.0 * naiveError);
+    EXPECT_NEAR(stats.autocorrelationTime(), 9.5, 4.0);
+}
+
+} // namespace
+} // namespace gmx
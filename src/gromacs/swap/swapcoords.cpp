@@ -697,47 +697,71 @@ static void sortMoleculesIntoCompartments(t_swapgrp*    g,
     /* Get us a counter that cycles in the range of [0 ... sc->nAverage[ */
     int replace = (step / sc->nstswap) % sc->nAverage;
 
+    real left[eCompNR], right[eCompNR];
     for (int comp = eCompA; comp <= eCompB; comp++)
     {
-        real left, right;
-
-        /* Get lists of atoms that match criteria for this compartment */
-        get_compartment_boundaries(comp, s, box, &left, &right);
+        /* Get the boundaries of this compartment */
+        get_compartment_boundaries(comp, s, box, &left[comp], &right[comp]);
 
         /* First clear the ion molecule lists */
         g->comp[comp].nMol  = 0;
         nMolNotInComp[comp] = 0; /* consistency check */
+    }
 
-        /* Loop over the molecules and atoms of this group */
-        for (int iMol = 0, iAtom = 0; iAtom < static_cast<int>(g->atomset.numAtomsGlobal());
-             iAtom += g->apm, iMol++)
-        {
-            real dist;
-            int  sd = s->swapdim;
+    const int sd = s->swapdim;
 
-            /* Is this first atom of the molecule in the compartment that we look at? */
-            if (compartment_contains_atom(left, right, g->xc[iAtom][sd], box[sd][sd],
-                                          sc->bulkOffset[comp], &dist))
-            {
-                /* Add the first atom of this molecule to the list of molecules in this compartment */
-                add_to_list(iAtom, &g->comp[comp], dist);
+    /* Loop over the molecules and atoms of this group. The compartments
+     * partition the swap dimension, so a single pass over the molecules
+     * suffices: a molecule found in compartment A need not be checked
+     * against compartment B.
+     */
+    for (int iMol = 0, iAtom = 0; iAtom < static_cast<int>(g->atomset.numAtomsGlobal());
+         iAtom += g->apm, iMol++)
+    {
+        real dist;
+        int  comp = -1;
 
-                /* Master also checks for ion groups through which channel each ion has passed */
-                if (MASTER(cr) && (g->comp_now != nullptr) && !bIsSolvent)
-                {
-                    int globalAtomNr = g->atomset.globalIndex()[iAtom] + 1; /* PDB index starts at 1 ... */
-                    detect_flux_per_channel(g, globalAtomNr, comp, g->xc[iAtom], &g->comp_now[iMol],
-                                            &g->comp_from[iMol], &g->channel_label[iMol], sc, s,
-                                            cyl0_r2, cyl1_r2, step, bRerun, fpout);
-                }
+        /* Determine which compartment contains the first atom of this molecule */
+        if (compartment_contains_atom(left[eCompA], right[eCompA], g->xc[iAtom][sd], box[sd][sd],
+                                      sc->bulkOffset[eCompA], &dist))
+        {
+            comp = eCompA;
+            nMolNotInComp[eCompB]++;
+        }
+        else
+        {
+            nMolNotInComp[eCompA]++;
+            if (compartment_contains_atom(left[eCompB], right[eCompB], g->xc[iAtom][sd],
+                                          box[sd][sd], sc->bulkOffset[eCompB], &dist))
+            {
+                comp = eCompB;
             }
             else
             {
-                nMolNotInComp[comp]++;
+                nMolNotInComp[eCompB]++;
             }
         }
-        /* Correct the time-averaged number of ions in the compartment */
-        if (!bIsSolvent)
+
+        if (comp >= 0)
+        {
+            /* Add the first atom of this molecule to the list of molecules in this compartment */
+            add_to_list(iAtom, &g->comp[comp], dist);
+
+            /* Master also checks for ion groups through which channel each ion has passed */
+            if (MASTER(cr) && (g->comp_now != nullptr) && !bIsSolvent)
+            {
+                int globalAtomNr = g->atomset.globalIndex()[iAtom] + 1; /* PDB index starts at 1 ... */
+                detect_flux_per_channel(g, globalAtomNr, comp, g->xc[iAtom], &g->comp_now[iMol],
+                                        &g->comp_from[iMol], &g->channel_label[iMol], sc, s,
+                                        cyl0_r2, cyl1_r2, step, bRerun, fpout);
+            }
+        }
+    }
+
+    /* Correct the time-averaged number of ions in the compartments */
+    if (!bIsSolvent)
+    {
+        for (int comp = eCompA; comp <= eCompB; comp++)
         {
             update_time_window(&g->comp[comp], sc->nAverage, replace);
         }
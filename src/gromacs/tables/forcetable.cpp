@@ -42,6 +42,7 @@
 #include <cmath>
 
 #include <algorithm>
+#include <vector>
 
 #include "gromacs/fileio/xvgr.h"
 #include "gromacs/math/functions.h"
@@ -54,7 +55,9 @@
 #include "gromacs/mdtypes/interaction_const.h"
 #include "gromacs/mdtypes/md_enums.h"
 #include "gromacs/mdtypes/nblist.h"
+#include "gromacs/tables/cubicsplinetable.h"
 #include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/cstringutil.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/futil.h"
@@ -1459,6 +1462,40 @@ bondedtable_t make_bonded_table(FILE* fplog, const char* fn, int angle)
     tab.scale = td.tabscale;
     snew(tab.data, tab.n * stride);
     copy2table(tab.n, 0, stride, td.x, td.v, td.f, 1.0, tab.data);
+
+    tab.cubicSpline = nullptr;
+    if (angle == 0)
+    {
+        /* Distance-based tables can also be evaluated through the batched
+         * spline classes. Construction rejects input that is too coarse or
+         * inconsistent for the spline tolerance; in that case we keep only
+         * the scalar interpolation path on tab.data.
+         */
+        try
+        {
+            std::vector<double> function(td.nx);
+            std::vector<double> derivative(td.nx);
+            for (i = 0; i < td.nx; i++)
+            {
+                function[i]   = td.v[i];
+                derivative[i] = -td.f[i];
+            }
+            const double spacing = 1.0 / static_cast<double>(tab.scale);
+            tab.cubicSpline      = new gmx::CubicSplineTable(
+                    { { "bonded", function, derivative, spacing } },
+                    { 0.0, static_cast<real>((td.nx - 1) * spacing) });
+        }
+        catch (const gmx::GromacsException&)
+        {
+            tab.cubicSpline = nullptr;
+        }
+        if (debug)
+        {
+            fprintf(debug, "Bonded table %s %s be evaluated with the cubic spline table\n", fn,
+                    tab.cubicSpline != nullptr ? "will" : "can not");
+        }
+    }
+
     done_tabledata(&td);
 
     return tab;
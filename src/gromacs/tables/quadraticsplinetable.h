@@ -64,6 +64,7 @@
 #include "gromacs/simd/simd.h"
 #include "gromacs/tables/tableinput.h"
 #include "gromacs/utility/alignedallocator.h"
+#include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/classhelpers.h"
 #include "gromacs/utility/exceptions.h"
 #include "gromacs/utility/gmxassert.h"
@@ -408,6 +409,48 @@ public:
         *derivativeValue = fma(t1 - t0, eps, t0);
     }
 
+    /*! \brief Evaluate function and derivative for a whole array of points
+     *
+     *  Batched version of evaluateFunctionAndDerivative() that processes the
+     *  input in SIMD-width chunks with a scalar loop for the remainder, so
+     *  index computation and the table gather are fused inside one loop
+     *  instead of being issued pointwise by the caller.
+     *
+     *  \tparam     numFuncInTable  Number of separate functions in table, default is 1
+     *  \tparam     funcIndex       Index of function to evaluate in table, default is 0
+     *  \param      r               Points for which to evaluate function and derivative
+     *  \param[out] functionValue   Function values; size must match r
+     *  \param[out] derivativeValue Function derivatives; size must match r
+     *
+     *  For debug builds we assert that the input values fall in the range
+     *  specified when constructing the table.
+     */
+    template<int numFuncInTable = 1, int funcIndex = 0>
+    void evaluateFunctionAndDerivativeBatch(ArrayRef<const real> r,
+                                            ArrayRef<real>       functionValue,
+                                            ArrayRef<real>       derivativeValue) const
+    {
+        GMX_ASSERT(functionValue.size() == r.size() && derivativeValue.size() == r.size(),
+                   "Output arrays must match the size of the input");
+
+        std::size_t i = 0;
+#if GMX_SIMD_HAVE_REAL
+        for (; i + GMX_SIMD_REAL_WIDTH <= r.size(); i += GMX_SIMD_REAL_WIDTH)
+        {
+            SimdReal function, derivative;
+            evaluateFunctionAndDerivative<numFuncInTable, funcIndex>(
+                    loadU<SimdReal>(r.data() + i), &function, &derivative);
+            storeU(functionValue.data() + i, function);
+            storeU(derivativeValue.data() + i, derivative);
+        }
+#endif
+        for (; i < r.size(); i++)
+        {
+            evaluateFunctionAndDerivative<numFuncInTable, funcIndex>(
+                    r[i], &functionValue[i], &derivativeValue[i]);
+        }
+    }
+
     /************************************************************
      *             Evaluation methods for two functions         *
      ************************************************************/
@@ -46,6 +46,7 @@
 #include <algorithm>
 #include <functional>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -673,6 +674,35 @@ TYPED_TEST(SplineTableTest, ThreeFunctions)
     EXPECT_EQ(tstDer2, tmpDer2);
 }
 
+TYPED_TEST(SplineTableTest, BatchEvaluation)
+{
+    std::pair<real, real> range(0.2, 1.0);
+    TypeParam             table({ { "LJ12", lj12Function, lj12Derivative } }, range);
+
+    // Use an odd number of points so the SIMD main loop is exercised
+    // together with the scalar remainder loop when SIMD is enabled.
+    const std::size_t numPoints = 23;
+    std::vector<real> x(numPoints);
+    std::vector<real> func(numPoints);
+    std::vector<real> der(numPoints);
+
+    for (std::size_t i = 0; i < numPoints; i++)
+    {
+        x[i] = range.first + (range.second - range.first) * (i + 0.5) / numPoints;
+    }
+
+    table.evaluateFunctionAndDerivativeBatch(x, func, der);
+
+    for (std::size_t i = 0; i < numPoints; i++)
+    {
+        real refFunc = lj12Function(x[i]);
+        real refDer  = lj12Derivative(x[i]);
+
+        EXPECT_LT(std::abs(func[i] - refFunc) / std::abs(refFunc), TypeParam::defaultTolerance);
+        EXPECT_LT(std::abs(der[i] - refDer) / std::abs(refDer), TypeParam::defaultTolerance);
+    }
+}
+
 #if GMX_SIMD_HAVE_REAL
 TYPED_TEST(SplineTableTest, Simd)
 {
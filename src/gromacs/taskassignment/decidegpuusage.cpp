@@ -103,6 +103,20 @@ const char* g_specifyEverythingFormatString =
 #endif
         ;
 
+/*! \brief Return whether the rank setup is compatible with running PME on a GPU.
+ *
+ * GPU PME currently requires all PME work to reside on a single rank:
+ * either one rank doing everything, or exactly one separate PME rank.
+ * Decomposing the PME grid over multiple GPU ranks, with halo exchange
+ * of the grid overlap regions, is not yet implemented. This predicate
+ * is the single place to relax once such decomposition support lands.
+ */
+bool pmeRankSetupIsCompatibleWithGpuPme(const int numRanksPerSimulation, const int numPmeRanksPerSimulation)
+{
+    return !(((numRanksPerSimulation > 1) && (numPmeRanksPerSimulation == 0))
+             || (numPmeRanksPerSimulation > 1));
+}
+
 } // namespace
 
 bool decideWhetherToUseGpusForNonbondedWithThreadMpi(const TaskTarget        nonbondedTarget,
@@ -186,8 +200,7 @@ bool decideWhetherToUseGpusForPmeWithThreadMpi(const bool              useGpuFor
         // PME on GPUs is only supported in a single case
         if (pmeTarget == TaskTarget::Gpu)
         {
-            if (((numRanksPerSimulation > 1) && (numPmeRanksPerSimulation == 0))
-                || (numPmeRanksPerSimulation > 1))
+            if (!pmeRankSetupIsCompatibleWithGpuPme(numRanksPerSimulation, numPmeRanksPerSimulation))
             {
                 GMX_THROW(InconsistentInputError(
                         "When you run mdrun -pme gpu -gputasks, you must supply a PME-enabled .tpr "
@@ -206,8 +219,7 @@ bool decideWhetherToUseGpusForPmeWithThreadMpi(const bool              useGpuFor
 
     if (pmeTarget == TaskTarget::Gpu)
     {
-        if (((numRanksPerSimulation > 1) && (numPmeRanksPerSimulation == 0))
-            || (numPmeRanksPerSimulation > 1))
+        if (!pmeRankSetupIsCompatibleWithGpuPme(numRanksPerSimulation, numPmeRanksPerSimulation))
         {
             GMX_THROW(NotImplementedError(
                     "PME tasks were required to run on GPUs, but that is not implemented with "
@@ -405,8 +417,7 @@ bool decideWhetherToUseGpusForPme(const bool              useGpuForNonbonded,
 
     if (pmeTarget == TaskTarget::Gpu)
     {
-        if (((numRanksPerSimulation > 1) && (numPmeRanksPerSimulation == 0))
-            || (numPmeRanksPerSimulation > 1))
+        if (!pmeRankSetupIsCompatibleWithGpuPme(numRanksPerSimulation, numPmeRanksPerSimulation))
         {
             GMX_THROW(NotImplementedError(
                     "PME tasks were required to run on GPUs, but that is not implemented with "
@@ -0,0 +1,179 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+#include "gmxpre.h"
+
+#include "mpi_profile.h"
+
+#include "config.h"
+
+#include <cstdlib>
+
+#include "gromacs/mdtypes/commrec.h"
+#include "gromacs/timing/walltime_accounting.h"
+#include "gromacs/utility/gmxassert.h"
+#include "gromacs/utility/gmxmpi.h"
+
+/*! \brief The accumulated statistics for one communication phase */
+struct mpi_profile_counter_t
+{
+    double numCalls      = 0;
+    double bytesSent     = 0;
+    double bytesReceived = 0;
+    double seconds       = 0;
+};
+
+//! Names of the phases for the report, indexed by the empc enum
+static const char* empc_names[empcNR] = { "Domain dec. halo exchange", "PME-PP transfer",
+                                          "Global reductions" };
+
+/*! \brief The per-thread counters
+ *
+ * These are thread local so that with thread-MPI the ranks within a
+ * process each accumulate, and later report, only their own calls.
+ */
+static thread_local mpi_profile_counter_t s_counters[empcNR];
+
+bool mpi_profile_enabled()
+{
+    static const bool enabled = (std::getenv("GMX_MPI_PROFILE") != nullptr);
+
+    return enabled;
+}
+
+double mpi_profile_start()
+{
+    if (!mpi_profile_enabled())
+    {
+        return 0;
+    }
+
+    return gmx_gettime();
+}
+
+void mpi_profile_record(int empc, double start, std::size_t bytesSent, std::size_t bytesReceived)
+{
+    if (!mpi_profile_enabled())
+    {
+        return;
+    }
+
+    GMX_ASSERT(empc >= 0 && empc < empcNR, "Invalid communication phase index");
+
+    mpi_profile_counter_t* counter = &s_counters[empc];
+    counter->numCalls += 1;
+    counter->bytesSent += bytesSent;
+    counter->bytesReceived += bytesReceived;
+    counter->seconds += gmx_gettime() - start;
+}
+
+void mpi_profile_print(FILE* fplog, const t_commrec* cr, double elapsedTimeOverAllRanks)
+{
+    /* Four summed quantities per phase plus the per-phase maximum time */
+    double sums[empcNR * 4];
+    double maxTime[empcNR];
+
+    for (int empc = 0; empc < empcNR; empc++)
+    {
+        sums[empc * 4 + 0] = s_counters[empc].numCalls;
+        sums[empc * 4 + 1] = s_counters[empc].bytesSent;
+        sums[empc * 4 + 2] = s_counters[empc].bytesReceived;
+        sums[empc * 4 + 3] = s_counters[empc].seconds;
+        maxTime[empc]      = s_counters[empc].seconds;
+    }
+
+#if GMX_MPI
+    if (cr->nnodes > 1)
+    {
+        double buf[empcNR * 4];
+
+        MPI_Allreduce(sums, buf, empcNR * 4, MPI_DOUBLE, MPI_SUM, cr->mpi_comm_mysim);
+        for (int i = 0; i < empcNR * 4; i++)
+        {
+            sums[i] = buf[i];
+        }
+        MPI_Allreduce(maxTime, buf, empcNR, MPI_DOUBLE, MPI_MAX, cr->mpi_comm_mysim);
+        for (int empc = 0; empc < empcNR; empc++)
+        {
+            maxTime[empc] = buf[empc];
+        }
+    }
+#endif
+
+    if (fplog == nullptr)
+    {
+        return;
+    }
+
+    const int nranks = cr->nnodes;
+
+    fprintf(fplog, "\n     M P I   C O M M U N I C A T I O N   P R O F I L E\n\n");
+    fprintf(fplog, " Communication recorded with GMX_MPI_PROFILE, averaged over %d rank%s.\n",
+            nranks, nranks == 1 ? "" : "s");
+    fprintf(fplog,
+            " Times include the wait time of blocking calls, so load imbalance\n"
+            " between the ranks shows up here as communication time.\n\n");
+    fprintf(fplog, " %-26s %11s %10s %10s %9s %9s %5s\n", "Phase", "Calls", "MB sent", "MB recv",
+            "Time (s)", "Max (s)", "%");
+    fprintf(fplog,
+            "------------------------------------------------------------------------------------"
+            "\n");
+
+    double totalTime = 0;
+    for (int empc = 0; empc < empcNR; empc++)
+    {
+        const double numCalls = sums[empc * 4 + 0] / nranks;
+        const double mbSent   = sums[empc * 4 + 1] / (1e6 * nranks);
+        const double mbRecv   = sums[empc * 4 + 2] / (1e6 * nranks);
+        const double time     = sums[empc * 4 + 3] / nranks;
+        totalTime += time;
+
+        fprintf(fplog, " %-26s %11.0f %10.1f %10.1f %9.3f %9.3f", empc_names[empc], numCalls,
+                mbSent, mbRecv, time, maxTime[empc]);
+        if (elapsedTimeOverAllRanks > 0)
+        {
+            fprintf(fplog, " %5.1f", 100 * time / elapsedTimeOverAllRanks);
+        }
+        fprintf(fplog, "\n");
+    }
+    fprintf(fplog,
+            "------------------------------------------------------------------------------------"
+            "\n");
+    fprintf(fplog, " %-26s %11s %10s %10s %9.3f %9s", "Total", "", "", "", totalTime, "");
+    if (elapsedTimeOverAllRanks > 0)
+    {
+        fprintf(fplog, " %5.1f", 100 * totalTime / elapsedTimeOverAllRanks);
+    }
+    fprintf(fplog, "\n\n");
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+#ifndef GMX_TIMING_MPI_PROFILE_H
+#define GMX_TIMING_MPI_PROFILE_H
+
+/* Lightweight, opt-in accounting of the MPI communication of mdrun.
+ *
+ * When the environment variable GMX_MPI_PROFILE is set, the MPI calls
+ * of the communication phases listed below accumulate message counts,
+ * byte counts and wall time, which are reported next to the cycle
+ * accounting table in the log file. The measured time includes the
+ * wait time of blocking calls, so load imbalance between the ranks
+ * shows up as communication time.
+ *
+ * The counters are kept per thread. All profiled MPI calls of a rank
+ * are made by its master thread, which with thread-MPI keeps the
+ * ranks, which share a process, from interfering with each other.
+ */
+
+#include <cstddef>
+#include <cstdio>
+
+struct t_commrec;
+
+/* The profiled communication phases */
+enum
+{
+    empcDDHALO,    /* domain decomposition halo exchange  */
+    empcPMEPP,     /* PP-PME coordinate and force traffic */
+    empcGLOBALSUM, /* global reductions (gmx_sum*)        */
+    empcNR
+};
+
+/* Returns whether MPI profiling was requested with GMX_MPI_PROFILE */
+bool mpi_profile_enabled();
+
+/* Returns the time to pass to mpi_profile_record(); 0 when profiling is off.
+ *
+ * Kept this cheap so call sites can invoke it unconditionally.
+ */
+double mpi_profile_start();
+
+/* Accumulates one profiled communication call into phase \p empc.
+ *
+ * \p start must be the value returned by mpi_profile_start() right before
+ * the MPI call(s); the bytes are the totals sent and received by this rank.
+ * Does nothing when profiling is off.
+ */
+void mpi_profile_record(int empc, double start, std::size_t bytesSent, std::size_t bytesReceived);
+
+/* Reports the communication profile, reduced over the ranks of the simulation.
+ *
+ * Since this involves a reduction over cr->mpi_comm_mysim, all ranks of the
+ * simulation need to make this call; only the rank(s) with fplog!=nullptr
+ * print. \p elapsedTimeOverAllRanks is used to report the time fraction
+ * spent communicating.
+ */
+void mpi_profile_print(FILE* fplog, const t_commrec* cr, double elapsedTimeOverAllRanks);
+
+#endif
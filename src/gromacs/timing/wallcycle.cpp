@@ -41,6 +41,8 @@
 
 #include "config.h"
 
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 
 #include <array>
@@ -58,6 +60,23 @@
 #include "gromacs/utility/smalloc.h"
 #include "gromacs/utility/snprintf.h"
 
+/* Optional hardware event counting with GMX_CYCLE_PMU uses the Linux
+ * perf_event interface and is therefore only available on Linux.
+ */
+#ifdef __linux__
+#    define GMX_USE_PMU_COUNTERS 1
+#else
+#    define GMX_USE_PMU_COUNTERS 0
+#endif
+
+#if GMX_USE_PMU_COUNTERS
+#    include <cstring>
+
+#    include <linux/perf_event.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
 static const bool useCycleSubcounters = GMX_CYCLE_SUBCOUNTERS;
 
 /* DEBUG_WCYCLE adds consistency checking for the counters.
@@ -77,6 +96,25 @@ typedef struct
     gmx_cycles_t start;
 } wallcc_t;
 
+/* Fixed-size record for the optional per-call cycle trace */
+typedef struct
+{
+    int32_t  ewc;      /* the counter index */
+    int32_t  reserved; /* padding, written as zero */
+    uint64_t start;    /* cycle counter reading at the start call */
+    uint64_t cycles;   /* cycles counted by this start/stop pair */
+} wallcycle_trace_t;
+
+/* The hardware events sampled per main counter region with GMX_CYCLE_PMU */
+enum
+{
+    epmuCYCLES,
+    epmuINSTR,
+    epmuSTALL,
+    epmuLLCMISS,
+    epmuNR
+};
+
 struct gmx_wallcycle
 {
     wallcc_t* wcc;
@@ -98,6 +136,16 @@ struct gmx_wallcycle
     MPI_Comm mpi_comm_mygroup;
 #endif
     wallcc_t* wcsc;
+    /* ring buffer with per-call cycle counts, only used with GMX_CYCLE_TRACE */
+    wallcycle_trace_t* trace;
+    int64_t            trace_capacity;
+    int64_t            trace_count;
+    char               trace_filename[STRLEN];
+    /* hardware event counting, only used with GMX_CYCLE_PMU */
+    gmx_bool pmu_enabled;
+    int      pmu_fd[epmuNR];
+    int64_t  pmu_start[ewcNR][epmuNR];
+    int64_t  pmu_sum[ewcNR][epmuNR];
 };
 
 /* Each name should not exceed 19 printing characters
@@ -189,6 +237,40 @@ gmx_bool wallcycle_have_counter()
     return gmx_cycles_have_counter();
 }
 
+#if GMX_USE_PMU_COUNTERS
+/*! \brief Open a hardware counter for the calling thread, returns the
+ *         file descriptor or -1 when the event is not available.
+ */
+static int pmu_event_open(uint64_t config)
+{
+    struct perf_event_attr attr;
+
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.config         = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+/*! \brief Return the current count of hardware event \p e, or 0 when
+ *         the event could not be opened or read.
+ */
+static int64_t pmu_read_counter(gmx_wallcycle_t wc, int e)
+{
+    int64_t count = 0;
+
+    if (wc->pmu_fd[e] < 0 || read(wc->pmu_fd[e], &count, sizeof(count)) != sizeof(count))
+    {
+        count = 0;
+    }
+
+    return count;
+}
+#endif
+
 gmx_wallcycle_t wallcycle_init(FILE* fplog, int resetstep, t_commrec gmx_unused* cr)
 {
     gmx_wallcycle_t wc;
@@ -235,6 +317,79 @@ gmx_wallcycle_t wallcycle_init(FILE* fplog, int resetstep, t_commrec gmx_unused*
         snew(wc->wcsc, ewcsNR);
     }
 
+    wc->trace             = nullptr;
+    const char* traceEnv  = getenv("GMX_CYCLE_TRACE");
+    if (traceEnv != nullptr)
+    {
+        /* A positive integer value sets the ring buffer capacity in records,
+         * otherwise a default is used; when full, the oldest records are
+         * overwritten, so the trace keeps the end of the run. */
+        int64_t capacity   = strtoll(traceEnv, nullptr, 10);
+        wc->trace_capacity = (capacity > 0) ? capacity : (1 << 20);
+        snew(wc->trace, wc->trace_capacity);
+        wc->trace_count = 0;
+        snprintf(wc->trace_filename, STRLEN, "wallcycle_trace_rank%d.bin",
+                 (cr != nullptr) ? cr->sim_nodeid : 0);
+        if (fplog)
+        {
+            fprintf(fplog, "\nWill trace the cycle count of each counter call, keeping the last %lld, to %s\n\n",
+                    static_cast<long long>(wc->trace_capacity), wc->trace_filename);
+        }
+    }
+
+    wc->pmu_enabled = FALSE;
+    for (int e = 0; e < epmuNR; e++)
+    {
+        wc->pmu_fd[e] = -1;
+    }
+    if (getenv("GMX_CYCLE_PMU") != nullptr)
+    {
+#if GMX_USE_PMU_COUNTERS
+        /* The counters are opened per thread, so they only sample the
+         * master thread of each rank; the ratios reported are
+         * representative for efficiency analysis, not totals.
+         */
+        wc->pmu_fd[epmuCYCLES]  = pmu_event_open(PERF_COUNT_HW_CPU_CYCLES);
+        wc->pmu_fd[epmuINSTR]   = pmu_event_open(PERF_COUNT_HW_INSTRUCTIONS);
+        wc->pmu_fd[epmuSTALL]   = pmu_event_open(PERF_COUNT_HW_STALLED_CYCLES_BACKEND);
+        wc->pmu_fd[epmuLLCMISS] = pmu_event_open(PERF_COUNT_HW_CACHE_MISSES);
+        /* Instructions are required for all reported ratios; the other
+         * events are optional, since not all CPUs/kernels support them.
+         */
+        if (wc->pmu_fd[epmuINSTR] >= 0)
+        {
+            wc->pmu_enabled = TRUE;
+            if (fplog)
+            {
+                fprintf(fplog, "\nWill sample hardware performance counters for each cycle counting region\n\n");
+            }
+        }
+        else
+        {
+            for (int e = 0; e < epmuNR; e++)
+            {
+                if (wc->pmu_fd[e] >= 0)
+                {
+                    close(wc->pmu_fd[e]);
+                    wc->pmu_fd[e] = -1;
+                }
+            }
+            if (fplog)
+            {
+                fprintf(fplog,
+                        "\nNOTE: GMX_CYCLE_PMU is set, but opening the hardware counters failed,\n"
+                        "probably due to missing permissions (see "
+                        "/proc/sys/kernel/perf_event_paranoid)\n\n");
+            }
+        }
+#else
+        if (fplog)
+        {
+            fprintf(fplog, "\nNOTE: GMX_CYCLE_PMU is only supported on Linux\n\n");
+        }
+#endif
+    }
+
 #ifdef DEBUG_WCYCLE
     wc->count_depth = 0;
 #endif
@@ -242,6 +397,47 @@ gmx_wallcycle_t wallcycle_init(FILE* fplog, int resetstep, t_commrec gmx_unused*
     return wc;
 }
 
+/*! \brief Write the trace ring buffer, oldest record first, to its file.
+ *
+ * The file is self-describing: an 8-byte magic string "GMXWCTRC", the
+ * format version, the counter count and names (20 bytes each, as in the
+ * cycle accounting table), the record count, and then the fixed-size
+ * records in wallcycle_trace_t layout, all in host byte order.
+ * scripts/wallcycle_trace2chrometrace.py converts these files into a
+ * Chrome-trace timeline.
+ */
+static void wallcycle_trace_write(gmx_wallcycle_t wc)
+{
+    FILE* fp = fopen(wc->trace_filename, "wb");
+    if (fp == nullptr)
+    {
+        return;
+    }
+
+    const char magic[8] = { 'G', 'M', 'X', 'W', 'C', 'T', 'R', 'C' };
+    fwrite(magic, sizeof(magic), 1, fp);
+    const int32_t version = 2;
+    fwrite(&version, sizeof(version), 1, fp);
+    const int32_t numCounters = ewcNR;
+    fwrite(&numCounters, sizeof(numCounters), 1, fp);
+    for (int i = 0; i < ewcNR; i++)
+    {
+        char name[20] = { 0 };
+        snprintf(name, sizeof(name), "%s", wcn[i]);
+        fwrite(name, sizeof(name), 1, fp);
+    }
+
+    const int64_t numRecords =
+            (wc->trace_count < wc->trace_capacity) ? wc->trace_count : wc->trace_capacity;
+    fwrite(&numRecords, sizeof(numRecords), 1, fp);
+    const int64_t first = (wc->trace_count > wc->trace_capacity) ? wc->trace_count % wc->trace_capacity : 0;
+    for (int64_t i = 0; i < numRecords; i++)
+    {
+        fwrite(&wc->trace[(first + i) % wc->trace_capacity], sizeof(wallcycle_trace_t), 1, fp);
+    }
+    fclose(fp);
+}
+
 void wallcycle_destroy(gmx_wallcycle_t wc)
 {
     if (wc == nullptr)
@@ -261,6 +457,20 @@ void wallcycle_destroy(gmx_wallcycle_t wc)
     {
         sfree(wc->wcsc);
     }
+    if (wc->trace != nullptr)
+    {
+        wallcycle_trace_write(wc);
+        sfree(wc->trace);
+    }
+#if GMX_USE_PMU_COUNTERS
+    for (int e = 0; e < epmuNR; e++)
+    {
+        if (wc->pmu_fd[e] >= 0)
+        {
+            close(wc->pmu_fd[e]);
+        }
+    }
+#endif
     sfree(wc);
 }
 
@@ -331,6 +541,15 @@ void wallcycle_start(gmx_wallcycle_t wc, int ewc)
 
     cycle              = gmx_cycles_read();
     wc->wcc[ewc].start = cycle;
+#if GMX_USE_PMU_COUNTERS
+    if (wc->pmu_enabled)
+    {
+        for (int e = 0; e < epmuNR; e++)
+        {
+            wc->pmu_start[ewc][e] = pmu_read_counter(wc, e);
+        }
+    }
+#endif
     if (wc->wcc_all != nullptr)
     {
         wc->wc_depth++;
@@ -405,6 +624,24 @@ double wallcycle_stop(gmx_wallcycle_t wc, int ewc)
     }
     wc->wcc[ewc].c += last;
     wc->wcc[ewc].n++;
+#if GMX_USE_PMU_COUNTERS
+    if (wc->pmu_enabled)
+    {
+        for (int e = 0; e < epmuNR; e++)
+        {
+            wc->pmu_sum[ewc][e] += pmu_read_counter(wc, e) - wc->pmu_start[ewc][e];
+        }
+    }
+#endif
+    if (wc->trace != nullptr)
+    {
+        wallcycle_trace_t* rec = &wc->trace[wc->trace_count % wc->trace_capacity];
+        rec->ewc               = ewc;
+        rec->reserved          = 0;
+        rec->start             = wc->wcc[ewc].start;
+        rec->cycles            = last;
+        wc->trace_count++;
+    }
     if (wc->wcc_all)
     {
         wc->wc_depth--;
@@ -459,6 +696,16 @@ void wallcycle_reset_all(gmx_wallcycle_t wc)
             wc->wcsc[i].c = 0;
         }
     }
+    if (wc->pmu_enabled)
+    {
+        for (i = 0; i < ewcNR; i++)
+        {
+            for (int e = 0; e < epmuNR; e++)
+            {
+                wc->pmu_sum[i][e] = 0;
+            }
+        }
+    }
 }
 
 static gmx_bool is_pme_counter(int ewc)
@@ -945,6 +1192,57 @@ void wallcycle_print(FILE*                            fplog,
         fprintf(fplog, "%s\n", hline);
     }
 
+    if (wc->pmu_enabled)
+    {
+        /* The hardware events are sampled on the main thread of this rank
+         * only, so the ratios below are representative for efficiency
+         * analysis, but the instruction counts are not whole-run totals.
+         */
+        fprintf(fplog, "\n Hardware event statistics, main thread of the master rank only\n");
+        fprintf(fplog, "%s\n", hline);
+        fprintf(fplog,
+                " Region              Instr. (1e9)  Instr/cycle  Stall cyc. %%  LLC-miss/kInstr\n");
+        fprintf(fplog, "%s\n", hline);
+        for (i = ewcPPDURINGPME + 1; i < ewcNR; i++)
+        {
+            if (is_pme_subcounter(i) || wc->wcc[i].n == 0 || wc->pmu_sum[i][epmuINSTR] <= 0)
+            {
+                continue;
+            }
+            const double instr  = wc->pmu_sum[i][epmuINSTR];
+            const double cycles = wc->pmu_sum[i][epmuCYCLES];
+            char         ipcBuf[STRLEN], stallBuf[STRLEN], missBuf[STRLEN];
+            /* Events that could not be opened on this CPU are printed as - */
+            if (wc->pmu_fd[epmuCYCLES] >= 0 && cycles > 0)
+            {
+                snprintf(ipcBuf, STRLEN, "%.2f", instr / cycles);
+            }
+            else
+            {
+                snprintf(ipcBuf, STRLEN, "-");
+            }
+            if (wc->pmu_fd[epmuSTALL] >= 0 && cycles > 0)
+            {
+                snprintf(stallBuf, STRLEN, "%.1f", 100.0 * wc->pmu_sum[i][epmuSTALL] / cycles);
+            }
+            else
+            {
+                snprintf(stallBuf, STRLEN, "-");
+            }
+            if (wc->pmu_fd[epmuLLCMISS] >= 0)
+            {
+                snprintf(missBuf, STRLEN, "%.2f", 1e3 * wc->pmu_sum[i][epmuLLCMISS] / instr);
+            }
+            else
+            {
+                snprintf(missBuf, STRLEN, "-");
+            }
+            fprintf(fplog, " %-19.19s %12.3f  %11s  %12s  %15s\n", wcn[i], instr * 1e-9, ipcBuf,
+                    stallBuf, missBuf);
+        }
+        fprintf(fplog, "%s\n", hline);
+    }
+
     /* print GPU timing summary */
     double tot_gpu = 0.0;
     if (gpu_pme_t)
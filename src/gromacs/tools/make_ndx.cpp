@@ -43,6 +43,9 @@
 #include <cstring>
 
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "gromacs/commandline/pargs.h"
 #include "gromacs/fileio/confio.h"
@@ -127,14 +130,26 @@ static int or_groups(int nr1, const int* at1, int nr2, const int* at2, int* nr,
 
 static int and_groups(int nr1, const int* at1, int nr2, const int* at2, int* nr, int* at)
 {
-    int i1, i2;
+    int i1;
+
+    /* Count the occurrences in the second group, so each atom of the first
+     * group can be matched in constant time; keeping the count preserves
+     * the duplicated output atoms that groups with double entries produce.
+     */
+    std::unordered_map<int, int> count2;
+    count2.reserve(nr2);
+    for (int i2 = 0; i2 < nr2; i2++)
+    {
+        count2[at2[i2]]++;
+    }
 
     *nr = 0;
     for (i1 = 0; i1 < nr1; i1++)
     {
-        for (i2 = 0; i2 < nr2; i2++)
+        auto match = count2.find(at1[i1]);
+        if (match != count2.end())
         {
-            if (at1[i1] == at2[i2])
+            for (int k = 0; k < match->second; k++)
             {
                 at[*nr] = at1[i1];
                 (*nr)++;
@@ -505,6 +520,8 @@ atoms_from_residuenumbers(const t_atoms* atoms, int group, t_blocka* block, int*
     j0   = block->index[group];
     j1   = block->index[group + 1];
     nres = atoms->nres;
+    std::unordered_set<int> resnrSelected;
+    resnrSelected.reserve(j1 - j0);
     for (j = j0; j < j1; j++)
     {
         if (block->a[j] >= nres)
@@ -512,18 +529,15 @@ atoms_from_residuenumbers(const t_atoms* atoms, int group, t_blocka* block, int*
             printf("Index %s contains number>nres (%d>%d)\n", gname, block->a[j] + 1, nres);
             return FALSE;
         }
+        resnrSelected.insert(block->a[j] + 1);
     }
     for (i = 0; i < atoms->nr; i++)
     {
         resnr = atoms->resinfo[atoms->atom[i].resind].nr;
-        for (j = j0; j < j1; j++)
+        if (resnrSelected.count(resnr) > 0)
         {
-            if (block->a[j] + 1 == resnr)
-            {
-                index[*nr] = i;
-                (*nr)++;
-                break;
-            }
+            index[*nr] = i;
+            (*nr)++;
         }
     }
     printf("Found %d atom%s in %d residues from group %s\n", *nr, (*nr == 1) ? "" : "s", j1 - j0, gname);
@@ -1052,16 +1066,20 @@ static gmx_bool parse_entry(char**         string,
     }
     if (bRet && bCompl)
     {
+        /* Mark the selected atoms so the complement is a single pass */
+        std::vector<bool> selected(natoms, false);
+        for (j = 0; j < *nr; j++)
+        {
+            if (index[j] >= 0 && index[j] < natoms)
+            {
+                selected[index[j]] = true;
+            }
+        }
         snew(index1, natoms - *nr);
         nr1 = 0;
         for (i = 0; i < natoms; i++)
         {
-            j = 0;
-            while ((j < *nr) && (index[j] != i))
-            {
-                j++;
-            }
-            if (j == *nr)
+            if (!selected[i])
             {
                 if (nr1 >= natoms - *nr)
                 {
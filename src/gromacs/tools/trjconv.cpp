@@ -73,6 +73,7 @@
 #include "gromacs/utility/arraysize.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/futil.h"
+#include "gromacs/utility/gmxomp.h"
 #include "gromacs/utility/smalloc.h"
 
 static void mk_filenm(char* base, const char* ext, int ndigit, int file_nr, char out_file[])
@@ -854,6 +855,13 @@ int gmx_trjconv(int argc, char* argv[])
             flags = flags | TRX_READ_F;
         }
 
+        /* The PBC treatment and fitting below work on independent atoms or
+         * molecules and are parallelized over the OpenMP threads.
+         */
+        const int nth = gmx_omp_get_max_threads();
+
+        t_trxreadahead* readahead = nullptr;
+
         /* open trx file for reading */
         bHaveFirstFrame = read_first_frame(oenv, &trxin, in_file, &fr, flags);
         if (fr.bPrec)
@@ -969,6 +977,21 @@ int gmx_trjconv(int argc, char* argv[])
                 }
             }
 
+            /* With GMX_ANALYSIS_READAHEAD set, upcoming frames are decoded on
+             * a reader thread so that input (de)compression overlaps with the
+             * PBC treatment, fitting and writing below. The value sets the
+             * number of frames read ahead; any non-number selects the default.
+             */
+            if (const char* env = std::getenv("GMX_ANALYSIS_READAHEAD"))
+            {
+                int depth = std::atoi(env);
+                if (depth <= 0)
+                {
+                    depth = 4;
+                }
+                readahead = start_trx_readahead(oenv, trxin, &fr, depth);
+            }
+
             /* Start the big loop over frames */
             file_nr  = 0;
             frame    = 0;
@@ -1048,28 +1071,30 @@ int gmx_trjconv(int argc, char* argv[])
                     {
                         hbox[d] = 0.5 * fr.box[d][d];
                     }
-                    for (i = 0; i < natoms; i++)
+                    /* Each atom is reset independently of the others */
+#pragma omp parallel for num_threads(nth) schedule(static)
+                    for (int ja = 0; ja < natoms; ja++)
                     {
                         if (bReset)
                         {
-                            rvec_dec(fr.x[i], x_shift);
+                            rvec_dec(fr.x[ja], x_shift);
                         }
-                        for (m = DIM - 1; m >= 0; m--)
+                        for (int jm = DIM - 1; jm >= 0; jm--)
                         {
-                            if (hbox[m] > 0)
+                            if (hbox[jm] > 0)
                             {
-                                while (fr.x[i][m] - xp[i][m] <= -hbox[m])
+                                while (fr.x[ja][jm] - xp[ja][jm] <= -hbox[jm])
                                 {
-                                    for (d = 0; d <= m; d++)
+                                    for (int jd = 0; jd <= jm; jd++)
                                     {
-                                        fr.x[i][d] += fr.box[m][d];
+                                        fr.x[ja][jd] += fr.box[jm][jd];
                                     }
                                 }
-                                while (fr.x[i][m] - xp[i][m] > hbox[m])
+                                while (fr.x[ja][jm] - xp[ja][jm] > hbox[jm])
                                 {
-                                    for (d = 0; d <= m; d++)
+                                    for (int jd = 0; jd <= jm; jd++)
                                     {
-                                        fr.x[i][d] -= fr.box[m][d];
+                                        fr.x[ja][jd] -= fr.box[jm][jd];
                                     }
                                 }
                             }
@@ -1237,7 +1262,7 @@ int gmx_trjconv(int argc, char* argv[])
                             switch (unitcell_enum)
                             {
                                 case euRect:
-                                    put_atoms_in_box(pbcType, fr.box, positionsArrayRef);
+                                    put_atoms_in_box_omp(pbcType, fr.box, positionsArrayRef, nth);
                                     break;
                                 case euTric:
                                     put_atoms_in_triclinic_unitcell(ecenter, fr.box, positionsArrayRef);
@@ -1255,8 +1280,8 @@ int gmx_trjconv(int argc, char* argv[])
                         }
                         if (bPBCcomMol)
                         {
-                            put_molecule_com_in_box(unitcell_enum, ecenter, &top->mols, natoms,
-                                                    atoms->atom, pbcType, fr.box, fr.x);
+                            put_molecule_com_in_box_omp(unitcell_enum, ecenter, &top->mols, natoms,
+                                                        atoms->atom, pbcType, fr.box, fr.x, nth);
                         }
                         /* Copy the input trxframe struct to the output trxframe struct */
                         frout        = fr;
@@ -1445,7 +1470,14 @@ int gmx_trjconv(int argc, char* argv[])
                     }
                 }
                 frame++;
-                bHaveNextFrame = read_next_frame(oenv, trxin, &fr);
+                if (readahead != nullptr)
+                {
+                    bHaveNextFrame = read_next_frame_readahead(readahead, &fr);
+                }
+                else
+                {
+                    bHaveNextFrame = read_next_frame(oenv, trxin, &fr);
+                }
             } while (!(bTDump && bDumpFrame) && bHaveNextFrame);
         }
 
@@ -1458,6 +1490,10 @@ int gmx_trjconv(int argc, char* argv[])
         }
         fprintf(stderr, "\n");
 
+        if (readahead != nullptr)
+        {
+            done_trx_readahead(readahead);
+        }
         close_trx(trxin);
         sfree(outf_base);
 
@@ -0,0 +1,476 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+#include "gmxpre.h"
+
+#include "tune.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gromacs/commandline/pargs.h"
+#include "gromacs/utility/arraysize.h"
+#include "gromacs/utility/baseversion.h"
+#include "gromacs/utility/cstringutil.h"
+#include "gromacs/utility/fatalerror.h"
+#include "gromacs/utility/futil.h"
+#include "gromacs/utility/stringutil.h"
+
+/* One combination of mdrun launch settings to benchmark */
+typedef struct
+{
+    int         ntmpi;      /* thread-MPI ranks, 0 lets mdrun choose          */
+    int         ntomp;      /* OpenMP threads per rank, 0 lets mdrun choose   */
+    int         npme;       /* separate PME ranks, -1 lets mdrun choose       */
+    int         nstlist;    /* pair-list interval, 0 keeps the tpr value      */
+    const char* nb;         /* where the nonbonded tasks run                  */
+    const char* pme;        /* where the PME tasks run                        */
+    float       ns_per_day; /* measured performance, 0 when the run failed    */
+} t_tunesetting;
+
+
+static void sep_line(FILE* fp)
+{
+    fprintf(fp, "------------------------------------------------------------\n");
+}
+
+
+/* Check if string starts with substring */
+static gmx_bool str_starts(const char* string, const char* substring)
+{
+    return (std::strncmp(string, substring, std::strlen(substring)) == 0);
+}
+
+
+static void remove_if_exists(const char* fn)
+{
+    if (gmx_fexist(fn))
+    {
+        remove(fn);
+    }
+}
+
+
+/* Returns the ns/day performance from a benchmark log file, or 0 when the
+ * log contains no timings, e.g. because mdrun refused these settings.
+ */
+static float parse_benchmark_log(const char* logfile)
+{
+    FILE*      fp;
+    char       line[STRLEN], dumstring[STRLEN];
+    const char matchstring[] = "R E A L   C Y C L E   A N D   T I M E   A C C O U N T I N G";
+    float      dum1, dum2, dum3, dum4;
+    int        ndum;
+    gmx_bool   bFoundAccounting = FALSE;
+    float      ns_per_day       = 0.0;
+
+    if (!gmx_fexist(logfile))
+    {
+        return 0.0;
+    }
+    fp = fopen(logfile, "r");
+    while (fgets(line, STRLEN, fp) != nullptr)
+    {
+        ltrim(line);
+        if (str_starts(line, matchstring))
+        {
+            bFoundAccounting = TRUE;
+        }
+        else if (bFoundAccounting && str_starts(line, "Performance:"))
+        {
+            ndum = sscanf(line, "%s %f %f %f %f", dumstring, &dum1, &dum2, &dum3, &dum4);
+            /* (ns/day) is the second last entry, depending on whether
+             * GMX_DETAILED_PERF_STATS was set in print_perf(), nrnb.c */
+            ns_per_day = (ndum == 5) ? dum3 : dum1;
+            break;
+        }
+    }
+    fclose(fp);
+
+    return ns_per_day;
+}
+
+
+/* Constructs the mdrun command line for one benchmark of this setting.
+ * Without the benchmark file and step arguments this is also the command
+ * line that is reported to (and can be launched for) the user.
+ */
+static std::string build_mdrun_command(const char*          cmd_mdrun,
+                                       const char*          tpr,
+                                       const t_tunesetting* s,
+                                       const char*          extra_args)
+{
+    std::string command = gmx::formatString("%s -s %s", cmd_mdrun, tpr);
+
+    if (s->ntmpi > 0)
+    {
+        command += gmx::formatString(" -ntmpi %d -ntomp %d", s->ntmpi, s->ntomp);
+    }
+    command += gmx::formatString(" -npme %d", s->npme);
+    if (s->nstlist > 0)
+    {
+        command += gmx::formatString(" -nstlist %d", s->nstlist);
+    }
+    command += gmx::formatString(" -nb %s -pme %s", s->nb, s->pme);
+    if (extra_args[0] != '\0')
+    {
+        command += gmx::formatString(" %s", extra_args);
+    }
+
+    return command;
+}
+
+
+/* Runs mdrun repeats times with the given settings and stores the average
+ * performance in setting->ns_per_day (0 when any repeat failed). One row
+ * with the result is appended to fp and echoed to stdout.
+ */
+static void bench_setting(FILE*           fp,
+                          const char*     cmd_mdrun,
+                          const char*     extra_args,
+                          t_tunesetting*  setting,
+                          int64_t         bench_steps,
+                          int             repeats,
+                          const t_filenm* fnm,
+                          int             nfile)
+{
+    const char* benchlog = opt2fn("-bg", nfile, fnm);
+    const char* errfile  = opt2fn("-err", nfile, fnm);
+    float       ns_sum   = 0.0;
+    gmx_bool    bFailed  = FALSE;
+
+    std::string command = build_mdrun_command(cmd_mdrun, opt2fn("-s", nfile, fnm), setting, extra_args);
+    command += gmx::formatString(" -nsteps %" PRId64 " -resethway -noconfout", bench_steps);
+    command += gmx::formatString(" -g %s -e %s -o %s -cpo %s", benchlog, opt2fn("-be", nfile, fnm),
+                                 opt2fn("-bo", nfile, fnm), opt2fn("-bcpo", nfile, fnm));
+    command += gmx::formatString(" 1> /dev/null 2> %s", errfile);
+
+    for (int nr = 0; nr < repeats && !bFailed; nr++)
+    {
+        remove_if_exists(benchlog);
+        if (system(command.c_str()) != 0)
+        {
+            bFailed = TRUE;
+        }
+        float ns_per_day = parse_benchmark_log(benchlog);
+        if (ns_per_day <= 0)
+        {
+            bFailed = TRUE;
+        }
+        ns_sum += ns_per_day;
+    }
+    setting->ns_per_day = bFailed ? 0.0 : (ns_sum / repeats);
+
+    char row[STRLEN];
+    sprintf(row, " %5d %5d %5d %7d %5s %5s  ", setting->ntmpi, setting->ntomp, setting->npme,
+            setting->nstlist, setting->nb, setting->pme);
+    if (bFailed)
+    {
+        std::strcat(row, "failed, see benchmark log/err files\n");
+    }
+    else
+    {
+        sprintf(row + std::strlen(row), "%10.3f ns/day\n", setting->ns_per_day);
+    }
+    fprintf(fp, "%s", row);
+    fprintf(stdout, "%s", row);
+    fflush(fp);
+    fflush(stdout);
+}
+
+
+static void print_stage_header(FILE* fp, const char* stage)
+{
+    char buf[STRLEN];
+
+    sprintf(buf, "\nStage: %s\n ntmpi ntomp  npme nstlist    nb   pme  performance\n", stage);
+    fprintf(fp, "%s", buf);
+    fprintf(stdout, "%s", buf);
+    sep_line(fp);
+    sep_line(stdout);
+}
+
+
+int gmx_tune(int argc, char* argv[])
+{
+    const char* desc[] = {
+        "[THISMODULE] searches for the [gmx-mdrun] launch settings that give the best",
+        "performance for a [REF].tpr[ref] file on the node it runs on. It times short",
+        "benchmark runs of [gmx-mdrun], resetting the time and cycle counters halfway",
+        "through each run so that load balancing has settled before timings are taken,",
+        "and at the end prints the fastest complete [gmx-mdrun] command line.[PAR]",
+        "The search is staged rather than exhaustive: first the split of the available",
+        "cores into thread-MPI ranks and OpenMP threads is varied, then the number of",
+        "separate PME ranks, then the pair-list update interval [TT]-nstlist[tt], and",
+        "finally (with [TT]-gpu[tt]) the assignment of the nonbonded and PME tasks to",
+        "the GPU. Each stage keeps the best setting found by the previous stages, so",
+        "the total number of benchmark runs stays small enough to be cheaper than one",
+        "mistuned production job.[PAR]",
+        "[THISMODULE] needs to call [gmx-mdrun] and so requires that you specify how",
+        "to call mdrun with the argument to the [TT]-mdrun[tt] parameter. The search",
+        "covers a single node with thread-MPI; for tuning the number of PME ranks of",
+        "an MPI-parallel run across nodes, use [gmx-tune_pme].[PAR]",
+        "Unrecognized command-line arguments are passed on verbatim to the benchmark",
+        "(and launched) [gmx-mdrun] invocations. With [TT]-launch[tt], the fastest",
+        "command line is executed after the search has finished.",
+    };
+
+    int      nthreads     = 0;
+    int      repeats      = 1;
+    int64_t  bench_nsteps = 2000;
+    gmx_bool bGpu         = FALSE;
+    gmx_bool bLaunch      = FALSE;
+    char*    cmd_mdrun    = nullptr;
+
+    /* The nstlist values to test; these match the candidate values of the
+     * nstlist tuning that mdrun performs for GPU runs (pairlist_tuning.cpp),
+     * which does not run for CPU-only runs.
+     */
+    const int nstlist_try[] = { 20, 25, 40, 50, 80, 100 };
+
+    static t_filenm fnm[] = { { efTPR, "-s", nullptr, ffREAD },
+                              { efOUT, "-p", "tuneperf", ffWRITE },
+                              { efLOG, "-err", "bencherr", ffWRITE },
+                              /* Output files of the benchmark runs, deleted afterwards */
+                              { efLOG, "-bg", "bench", ffWRITE },
+                              { efEDR, "-be", "bench", ffWRITE },
+                              { efTRN, "-bo", "bench", ffWRITE },
+                              { efCPT, "-bcpo", "bench", ffWRITE } };
+
+    t_pargs pa[] = {
+        { "-mdrun",
+          FALSE,
+          etSTR,
+          { &cmd_mdrun },
+          "Command line to run a simulation, e.g. 'gmx mdrun'" },
+        { "-nt",
+          FALSE,
+          etINT,
+          { &nthreads },
+          "Total number of threads to divide over ranks (0 is all hardware threads)" },
+        { "-r", FALSE, etINT, { &repeats }, "Repeat each benchmark this often" },
+        { "-steps",
+          FALSE,
+          etINT64,
+          { &bench_nsteps },
+          "Number of steps per benchmark run; the counters are reset after the first half" },
+        { "-gpu",
+          FALSE,
+          etBOOL,
+          { &bGpu },
+          "Also vary the GPU task assignment ([TT]-nb[tt]/[TT]-pme[tt] of [gmx-mdrun])" },
+        { "-launch", FALSE, etBOOL, { &bLaunch }, "Launch the fastest command line afterwards" }
+    };
+
+#define NFILE asize(fnm)
+
+    gmx_output_env_t* oenv = nullptr;
+
+    if (!parse_common_args(&argc, argv, PCA_NOEXIT_ON_ARGS, NFILE, fnm, asize(pa), pa, asize(desc),
+                           desc, 0, nullptr, &oenv))
+    {
+        return 0;
+    }
+
+    /* Store the remaining unparsed command line entries in a string which
+     * is then attached to the mdrun command line */
+    std::string ExtraArgs;
+    for (int i = 1; i < argc; i++) /* argc will now be 1 if everything was understood */
+    {
+        if (!ExtraArgs.empty())
+        {
+            ExtraArgs += " ";
+        }
+        ExtraArgs += argv[i];
+    }
+
+    if (cmd_mdrun == nullptr)
+    {
+        gmx_fatal(FARGS,
+                  "Please provide the command that runs mdrun with -mdrun, e.g. -mdrun 'gmx "
+                  "mdrun'.");
+    }
+    if (nthreads <= 0)
+    {
+        nthreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    if (repeats < 1)
+    {
+        gmx_fatal(FARGS, "Number of repeats < 1!");
+    }
+
+    FILE* fp = gmx_ffopen(opt2fn("-p", NFILE, fnm), "w");
+    fprintf(fp, "P E R F O R M A N C E   R E S U L T S\n");
+    fprintf(fp, "%s for GROMACS %s\n", output_env_get_program_display_name(oenv), gmx_version());
+    fprintf(fp, "Benchmark steps       : %" PRId64 " (counters reset halfway)\n", bench_nsteps);
+    fprintf(fp, "Repeats per setting   : %d\n", repeats);
+    fprintf(fp, "Threads to divide     : %d\n", nthreads);
+    fprintf(fp, "mdrun args from cmdl. : %s\n", ExtraArgs.c_str());
+
+    t_tunesetting best;
+    best.ntmpi      = 0;
+    best.ntomp      = 0;
+    best.npme       = -1;
+    best.nstlist    = 0;
+    best.nb         = "auto";
+    best.pme        = "auto";
+    best.ns_per_day = 0.0;
+
+    /* Stage 1: how to divide the threads over ranks. The first candidate
+     * leaves the choice to mdrun, which serves as the baseline.
+     */
+    print_stage_header(fp, "thread-MPI ranks x OpenMP threads");
+    std::vector<t_tunesetting> candidates;
+    candidates.push_back(best);
+    for (int ntmpi = 1; ntmpi <= nthreads; ntmpi++)
+    {
+        if (nthreads % ntmpi == 0)
+        {
+            t_tunesetting s = best;
+            s.ntmpi         = ntmpi;
+            s.ntomp         = nthreads / ntmpi;
+            candidates.push_back(s);
+        }
+    }
+    for (t_tunesetting& s : candidates)
+    {
+        bench_setting(fp, cmd_mdrun, ExtraArgs.c_str(), &s, bench_nsteps, repeats, fnm, NFILE);
+        if (s.ns_per_day > best.ns_per_day)
+        {
+            best = s;
+        }
+    }
+
+    /* Stage 2: separate PME ranks; only sensible with enough ranks.
+     * mdrun's own guess was benchmarked as npme = -1 in stage 1.
+     */
+    if (best.ntmpi >= 3)
+    {
+        print_stage_header(fp, "separate PME ranks");
+        candidates.clear();
+        const int npme_try[] = { 0, best.ntmpi / 4, best.ntmpi / 3, best.ntmpi / 2 };
+        for (int npme : npme_try)
+        {
+            gmx_bool bDuplicate = FALSE;
+            for (const t_tunesetting& s : candidates)
+            {
+                bDuplicate = bDuplicate || (s.npme == npme);
+            }
+            if (!bDuplicate && npme < best.ntmpi)
+            {
+                t_tunesetting s = best;
+                s.npme          = npme;
+                candidates.push_back(s);
+            }
+        }
+        for (t_tunesetting& s : candidates)
+        {
+            bench_setting(fp, cmd_mdrun, ExtraArgs.c_str(), &s, bench_nsteps, repeats, fnm, NFILE);
+            if (s.ns_per_day > best.ns_per_day)
+            {
+                best = s;
+            }
+        }
+    }
+
+    /* Stage 3: pair-list update interval */
+    print_stage_header(fp, "pair-list interval (-nstlist)");
+    for (int nstlist : nstlist_try)
+    {
+        t_tunesetting s = best;
+        s.nstlist       = nstlist;
+        bench_setting(fp, cmd_mdrun, ExtraArgs.c_str(), &s, bench_nsteps, repeats, fnm, NFILE);
+        if (s.ns_per_day > best.ns_per_day)
+        {
+            best = s;
+        }
+    }
+
+    /* Stage 4: GPU task assignment. PME on a GPU requires a single rank
+     * or exactly one separate PME rank.
+     */
+    if (bGpu)
+    {
+        print_stage_header(fp, "GPU task assignment");
+        const char* placements[][2] = { { "gpu", "cpu" }, { "gpu", "gpu" } };
+        for (const auto& placement : placements)
+        {
+            t_tunesetting s = best;
+            s.nb            = placement[0];
+            s.pme           = placement[1];
+            if (std::strcmp(s.pme, "gpu") == 0)
+            {
+                s.npme = (s.ntmpi > 1) ? 1 : 0;
+            }
+            bench_setting(fp, cmd_mdrun, ExtraArgs.c_str(), &s, bench_nsteps, repeats, fnm, NFILE);
+            if (s.ns_per_day > best.ns_per_day)
+            {
+                best = s;
+            }
+        }
+    }
+
+    /* Clean up the output of the last benchmark run */
+    remove_if_exists(opt2fn("-bg", NFILE, fnm));
+    remove_if_exists(opt2fn("-be", NFILE, fnm));
+    remove_if_exists(opt2fn("-bo", NFILE, fnm));
+    remove_if_exists(opt2fn("-bcpo", NFILE, fnm));
+
+    std::string best_command =
+            build_mdrun_command(cmd_mdrun, opt2fn("-s", NFILE, fnm), &best, ExtraArgs.c_str());
+    fprintf(fp, "\nBest performance was %.3f ns/day with:\n%s\n", best.ns_per_day,
+            best_command.c_str());
+    gmx_ffclose(fp);
+    fprintf(stdout, "\nBest performance was %.3f ns/day with:\n%s\n", best.ns_per_day,
+            best_command.c_str());
+    fprintf(stdout, "Details were written to %s.\n", opt2fn("-p", NFILE, fnm));
+
+    if (bLaunch)
+    {
+        fprintf(stdout, "\nLaunching the fastest command line:\n%s\n\n", best_command.c_str());
+        if (system(best_command.c_str()) != 0)
+        {
+            gmx_fatal(FARGS, "The launched mdrun returned an error.");
+        }
+    }
+
+    return 0;
+}
@@ -46,6 +46,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include "gromacs/math/functions.h"
 #include "gromacs/math/utilities.h"
@@ -99,8 +101,22 @@ struct AtomProperty
     double def = 0.0;
     //! Basic entries for properties.
     std::vector<BaseEntry> entry;
+    //! Index from exact residue/atom name pair to the first entry with those names.
+    std::unordered_map<std::string, int> exactEntryIndex;
 };
 
+/*! \brief
+ * Returns the key into the exact-match index for a residue and atom name pair.
+ *
+ * \param[in] residueName Name of the residue.
+ * \param[in] atomName Name of the atom.
+ * \returns The key for the pair.
+ */
+static std::string exactEntryKey(const std::string& residueName, const std::string& atomName)
+{
+    return residueName + ' ' + atomName;
+}
+
 //! Implementation detail type for Atomproperties.
 class AtomProperties::Impl
 {
@@ -243,6 +259,11 @@ static void addProperty(AtomProperty*      ap,
         ap->entry.emplace_back(BaseEntry(atomName, residueName));
 
         j = ap->entry.size() - 1;
+
+        /* Index the new entry for exact-match lookups; the first entry
+         * with a given name pair wins, as in findPropertyIndex.
+         */
+        ap->exactEntryIndex.emplace(exactEntryKey(residueName, atomName), j);
     }
     if (ap->entry[j].isAvailable)
     {
@@ -396,7 +417,17 @@ bool AtomProperties::setAtomProperty(int                eprop,
     {
         tmpAtomName = atomName;
     }
-    j = findPropertyIndex(&(impl_->prop[eprop]), &impl_->restype, residueName, tmpAtomName, &bExact);
+    AtomProperty* ap         = &impl_->prop[eprop];
+    auto          exactMatch = ap->exactEntryIndex.find(exactEntryKey(residueName, tmpAtomName));
+    if (exactMatch != ap->exactEntryIndex.end())
+    {
+        /* An exact residue/atom pair always wins the wildcard scan */
+        j = exactMatch->second;
+    }
+    else
+    {
+        j = findPropertyIndex(ap, &impl_->restype, residueName, tmpAtomName, &bExact);
+    }
 
     if (eprop == epropVDW && !impl_->bWarnVDW)
     {
@@ -44,6 +44,9 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <string>
+#include <unordered_map>
+
 #include "gromacs/math/vectypes.h"
 #include "gromacs/topology/atoms.h"
 #include "gromacs/topology/block.h"
@@ -468,6 +471,47 @@ const InteractionLists* gmx_mtop_ilistloop_all_next(gmx_mtop_ilistloop_all_t ilo
     return &iloop->mtop->moltype[iloop->mtop->molblock[iloop->mblock].type].ilist;
 }
 
+/* Appends the raw bytes of \p data to the interning key \p key */
+static void appendInternKeyBytes(std::string* key, const void* data, size_t numBytes)
+{
+    key->append(reinterpret_cast<const char*>(data), numBytes);
+}
+
+std::vector<int> gmx_mtop_ilist_intern_index(const gmx_mtop_t& mtop)
+{
+    std::vector<int>                     internIndex(mtop.moltype.size());
+    std::unordered_map<std::string, int> firstMoltypeWithKey;
+    for (size_t mt = 0; mt < mtop.moltype.size(); mt++)
+    {
+        const gmx_moltype_t& molt = mtop.moltype[mt];
+        std::string          key;
+        appendInternKeyBytes(&key, &molt.atoms.nr, sizeof(molt.atoms.nr));
+        key.push_back(molt.atoms.atom != nullptr ? 1 : 0);
+        if (molt.atoms.atom != nullptr)
+        {
+            for (int a = 0; a < molt.atoms.nr; a++)
+            {
+                /* The particle type affects e.g. vsite bookkeeping in consumers */
+                key.push_back(static_cast<char>(molt.atoms.atom[a].ptype));
+            }
+        }
+        for (int ftype = 0; ftype < F_NRE; ftype++)
+        {
+            const InteractionList& il   = molt.ilist[ftype];
+            const int              size = il.size();
+            appendInternKeyBytes(&key, &size, sizeof(size));
+            if (size > 0)
+            {
+                appendInternKeyBytes(&key, il.iatoms.data(), size * sizeof(il.iatoms[0]));
+            }
+        }
+        /* The first molecule type with each key is the canonical one */
+        internIndex[mt] = firstMoltypeWithKey.emplace(std::move(key), mt).first->second;
+    }
+
+    return internIndex;
+}
+
 int gmx_mtop_ftype_count(const gmx_mtop_t* mtop, int ftype)
 {
     gmx_mtop_ilistloop_t iloop;
@@ -919,6 +963,18 @@ static gmx::ListOfLists<int> globalExclusionLists(const gmx_mtop_t& mtop)
 {
     gmx::ListOfLists<int> excls;
 
+    /* Reserve the final sizes to avoid reallocation while appending */
+    std::size_t numLists    = 0;
+    std::size_t numElements = 0;
+    for (const gmx_molblock_t& molb : mtop.molblock)
+    {
+        const gmx_moltype_t& molt = mtop.moltype[molb.type];
+
+        numLists += molb.nmol * molt.excls.size();
+        numElements += molb.nmol * molt.excls.numElements();
+    }
+    excls.reserve(numLists, numElements);
+
     int atomIndex = 0;
     for (const gmx_molblock_t& molb : mtop.molblock)
     {
@@ -235,6 +235,18 @@ gmx_mtop_ilistloop_all_t gmx_mtop_ilistloop_all_init(const gmx_mtop_t* mtop);
  */
 const InteractionLists* gmx_mtop_ilistloop_all_next(gmx_mtop_ilistloop_all_t iloop, int* atnr_offset);
 
+/* Returns for each molecule type the lowest molecule type index with
+ * identical interaction lists, atom count and particle types.
+ *
+ * Heterogeneous systems, e.g. ligand screening soups, often contain many
+ * molecule types that are topologically identical copies of each other.
+ * Consumers that derive per-molecule-type data from the interaction lists
+ * can use this index to compute and store such data once per unique set
+ * of lists and share it between the duplicates (flyweight), instead of
+ * once per molecule type.
+ */
+std::vector<int> gmx_mtop_ilist_intern_index(const gmx_mtop_t& mtop);
+
 
 /* Returns the total number of interactions in the system of type ftype */
 int gmx_mtop_ftype_count(const gmx_mtop_t* mtop, int ftype);
@@ -83,6 +83,31 @@ TEST(MtopTest, RangeBasedLoop)
     EXPECT_EQ(count, 9);
 }
 
+TEST(MtopTest, IlistInternIndex)
+{
+    gmx_mtop_t    mtop;
+    gmx_moltype_t moltype;
+    moltype.atoms.nr         = NRAL(F_SETTLE);
+    std::vector<int>& iatoms = moltype.ilist[F_SETTLE].iatoms;
+    const int         settleType = 0;
+    iatoms.push_back(settleType);
+    iatoms.push_back(0);
+    iatoms.push_back(1);
+    iatoms.push_back(2);
+    /* Two identical molecule types and one with a different parameter type */
+    mtop.moltype.push_back(moltype);
+    mtop.moltype.push_back(moltype);
+    gmx_moltype_t other          = moltype;
+    other.ilist[F_SETTLE].iatoms[0] = 1;
+    mtop.moltype.push_back(other);
+
+    std::vector<int> internIndex = gmx_mtop_ilist_intern_index(mtop);
+    ASSERT_EQ(internIndex.size(), 3);
+    EXPECT_EQ(internIndex[0], 0);
+    EXPECT_EQ(internIndex[1], 0);
+    EXPECT_EQ(internIndex[2], 2);
+}
+
 TEST(MtopTest, Operators)
 {
     gmx_mtop_t mtop;
@@ -52,6 +52,8 @@
 #include "gromacs/math/vec.h"
 #include "gromacs/pbcutil/pbc.h"
 #include "gromacs/selection/nbsearch.h"
+#include "gromacs/simd/simd.h"
+#include "gromacs/utility/alignedallocator.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/gmxassert.h"
 #include "gromacs/utility/smalloc.h"
@@ -78,41 +80,41 @@ static real safe_asin(real f)
 /* routines for dot distributions on the surface of the unit sphere */
 static real icosaeder_vertices(real* xus)
 {
-    const real rh = std::sqrt(1. - 2. * cos(TORAD(72.))) / (1. - cos(TORAD(72.)));
-    const real rg = cos(TORAD(72.)) / (1. - cos(TORAD(72.)));
+    const real rh = std::sqrt(1. - 2. * std::cos(TORAD(72.))) / (1. - std::cos(TORAD(72.)));
+    const real rg = std::cos(TORAD(72.)) / (1. - std::cos(TORAD(72.)));
     /* icosaeder vertices */
     xus[0]  = 0.;
     xus[1]  = 0.;
     xus[2]  = 1.;
-    xus[3]  = rh * cos(TORAD(72.));
-    xus[4]  = rh * sin(TORAD(72.));
+    xus[3]  = rh * std::cos(TORAD(72.));
+    xus[4]  = rh * std::sin(TORAD(72.));
     xus[5]  = rg;
-    xus[6]  = rh * cos(TORAD(144.));
-    xus[7]  = rh * sin(TORAD(144.));
+    xus[6]  = rh * std::cos(TORAD(144.));
+    xus[7]  = rh * std::sin(TORAD(144.));
     xus[8]  = rg;
-    xus[9]  = rh * cos(TORAD(216.));
-    xus[10] = rh * sin(TORAD(216.));
+    xus[9]  = rh * std::cos(TORAD(216.));
+    xus[10] = rh * std::sin(TORAD(216.));
     xus[11] = rg;
-    xus[12] = rh * cos(TORAD(288.));
-    xus[13] = rh * sin(TORAD(288.));
+    xus[12] = rh * std::cos(TORAD(288.));
+    xus[13] = rh * std::sin(TORAD(288.));
     xus[14] = rg;
     xus[15] = rh;
     xus[16] = 0;
     xus[17] = rg;
-    xus[18] = rh * cos(TORAD(36.));
-    xus[19] = rh * sin(TORAD(36.));
+    xus[18] = rh * std::cos(TORAD(36.));
+    xus[19] = rh * std::sin(TORAD(36.));
     xus[20] = -rg;
-    xus[21] = rh * cos(TORAD(108.));
-    xus[22] = rh * sin(TORAD(108.));
+    xus[21] = rh * std::cos(TORAD(108.));
+    xus[22] = rh * std::sin(TORAD(108.));
     xus[23] = -rg;
     xus[24] = -rh;
     xus[25] = 0;
     xus[26] = -rg;
-    xus[27] = rh * cos(TORAD(252.));
-    xus[28] = rh * sin(TORAD(252.));
+    xus[27] = rh * std::cos(TORAD(252.));
+    xus[28] = rh * std::sin(TORAD(252.));
     xus[29] = -rg;
-    xus[30] = rh * cos(TORAD(324.));
-    xus[31] = rh * sin(TORAD(324.));
+    xus[30] = rh * std::cos(TORAD(324.));
+    xus[31] = rh * std::sin(TORAD(324.));
     xus[32] = -rg;
     xus[33] = 0.;
     xus[34] = 0.;
@@ -141,8 +143,8 @@ divarc(real x1, real y1, real z1, real x2, real y2, real z2, int div1, int div2,
 
     phi  = safe_asin(dd / std::sqrt(d1 * d2));
     phi  = phi * (static_cast<real>(div1)) / (static_cast<real>(div2));
-    sphi = sin(phi);
-    cphi = cos(phi);
+    sphi = std::sin(phi);
+    cphi = std::cos(phi);
     s    = (x1 * xd + y1 * yd + z1 * zd) / dd;
 
     x   = xd * s * (1. - cphi) / dd + x1 * cphi + (yd * z1 - y1 * zd) * sphi / dd;
@@ -176,7 +178,7 @@ static std::vector<real> ico_dot_arc(int densit)
     if (tess > 1)
     {
         tn = 12;
-        a  = rh * rh * 2. * (1. - cos(TORAD(72.)));
+        a  = rh * rh * 2. * (1. - std::cos(TORAD(72.)));
         /* calculate tessalation of icosaeder edges */
         for (i = 0; i < 11; i++)
         {
@@ -292,7 +294,7 @@ static std::vector<real> ico_dot_dod(int densit)
 
     tn = 12;
     /* square of the edge of an icosaeder */
-    a = rh * rh * 2. * (1. - cos(TORAD(72.)));
+    a = rh * rh * 2. * (1. - std::cos(TORAD(72.)));
     /* dodecaeder vertices */
     for (i = 0; i < 10; i++)
     {
@@ -340,7 +342,7 @@ static std::vector<real> ico_dot_dod(int densit)
     {
         tn = 32;
         /* square of the edge of an dodecaeder */
-        adod = 4. * (cos(TORAD(108.)) - cos(TORAD(120.))) / (1. - cos(TORAD(120.)));
+        adod = 4. * (std::cos(TORAD(108.)) - std::cos(TORAD(120.))) / (1. - std::cos(TORAD(120.)));
         /* square of the distance of two adjacent vertices of ico- and dodecaeder */
         ai_d = 2. * (1. - std::sqrt(1. - a / 3.));
 
@@ -652,6 +654,17 @@ static void nsc_dclm_pbc(const rvec*                 coords,
 
     std::vector<int> wkdot(n_dot);
 
+#if GMX_SIMD_HAVE_REAL
+    constexpr int simdWidth = GMX_SIMD_REAL_WIDTH;
+#else
+    constexpr int simdWidth = 1;
+#endif
+    /* Coordinate differences and coverage thresholds of the neighbors of
+     * one atom, gathered so the dot accessibility test can be batched over
+     * neighbors. Padding lanes get a threshold no unit vector dot product
+     * can exceed, so they never mark a dot covered. */
+    std::vector<real, AlignedAllocator<real>> nbDx, nbDy, nbDz, nbRefdot;
+
     for (int i = 0; i < nat; ++i)
     {
         const int                      iat  = index[i];
@@ -661,7 +674,12 @@ static void nsc_dclm_pbc(const rvec*                 coords,
         AnalysisNeighborhoodPair       pair;
         std::fill(wkdot.begin(), wkdot.end(), 1);
         int currDotCount = n_dot;
-        while (currDotCount > 0 && pairSearch.findNextPair(&pair))
+
+        nbDx.clear();
+        nbDy.clear();
+        nbDz.clear();
+        nbRefdot.clear();
+        while (pairSearch.findNextPair(&pair))
         {
             const int  jat = index[pair.refIndex()];
             const real aj  = radius[jat];
@@ -670,27 +688,74 @@ static void nsc_dclm_pbc(const rvec*                 coords,
             {
                 continue;
             }
-            const rvec& dx     = pair.dx();
-            const real  refdot = (d2 + aisq - aj * aj) / (2 * ai);
-            // TODO: Consider whether micro-optimizations from the old
-            // implementation would be useful, compared to the complexity that
-            // they bring: instead of this direct loop, the neighbors were
-            // stored into a temporary array, the loop order was
-            // reversed (first over dots, then over neighbors), and for each
-            // dot, it was first checked whether the same neighbor that
-            // resulted in marking the previous dot covered would also cover
-            // this dot. This presumably plays together with sorting of the
-            // surface dots (done in make_unsp) to avoid some of the looping.
-            // Alternatively, we could keep a skip list here to avoid
-            // repeatedly looping over dots that have already marked as
-            // covered.
+            const rvec& dx = pair.dx();
+            nbDx.push_back(dx[XX]);
+            nbDy.push_back(dx[YY]);
+            nbDz.push_back(dx[ZZ]);
+            nbRefdot.push_back((d2 + aisq - aj * aj) / (2 * ai));
+        }
+        while (nbRefdot.size() % simdWidth != 0)
+        {
+            nbDx.push_back(0);
+            nbDy.push_back(0);
+            nbDz.push_back(0);
+            nbRefdot.push_back(GMX_REAL_MAX);
+        }
+        if (!nbRefdot.empty())
+        {
+            /* A dot is covered when any neighbor covers it, so the loop
+             * runs with the dots outermost and stops at the first covering
+             * neighbor batch. The dots are spatially sorted (make_unsp),
+             * so consecutive dots tend to be covered by the same neighbor;
+             * starting each scan at the batch that covered the previous
+             * dot makes the first comparison succeed for most buried dots.
+             */
+            const int numBatches = nbRefdot.size() / simdWidth;
+            int       lastHit    = 0;
             for (int j = 0; j < n_dot; ++j)
             {
-                if (wkdot[j] && iprod(&xus[3 * j], dx) > refdot)
+#if GMX_SIMD_HAVE_REAL
+                const SimdReal ux(xus[3 * j]);
+                const SimdReal uy(xus[3 * j + 1]);
+                const SimdReal uz(xus[3 * j + 2]);
+                for (int bi = 0; bi < numBatches; ++bi)
+                {
+                    int b = lastHit + bi;
+                    if (b >= numBatches)
+                    {
+                        b -= numBatches;
+                    }
+                    const int      k = b * simdWidth;
+                    const SimdReal dot =
+                            fma(uz, simdLoad(nbDz.data() + k),
+                                fma(uy, simdLoad(nbDy.data() + k), ux * simdLoad(nbDx.data() + k)));
+                    if (anyTrue(simdLoad(nbRefdot.data() + k) < dot))
+                    {
+                        lastHit  = b;
+                        wkdot[j] = 0;
+                        --currDotCount;
+                        break;
+                    }
+                }
+#else
+                for (int bi = 0; bi < numBatches; ++bi)
                 {
-                    --currDotCount;
-                    wkdot[j] = 0;
+                    int b = lastHit + bi;
+                    if (b >= numBatches)
+                    {
+                        b -= numBatches;
+                    }
+                    const real dot = xus[3 * j] * nbDx[b] + xus[3 * j + 1] * nbDy[b]
+                                     + xus[3 * j + 2] * nbDz[b];
+                    if (dot > nbRefdot[b])
+                    {
+                        lastHit  = b;
+                        wkdot[j] = 0;
+                        --currDotCount;
+                        break;
+                    }
                 }
+#endif
             }
         }
 
@@ -44,15 +44,18 @@
 
 #include "runnercommon.h"
 
+#include <cstdlib>
 #include <cstring>
 
 #include <algorithm>
 #include <string>
 
+#include "gromacs/analysisdata/paralleloptions.h"
 #include "gromacs/fileio/oenv.h"
 #include "gromacs/fileio/timecontrol.h"
 #include "gromacs/fileio/trxio.h"
 #include "gromacs/math/vec.h"
+#include "gromacs/pbcutil/pbc.h"
 #include "gromacs/options/basicoptions.h"
 #include "gromacs/options/filenameoption.h"
 #include "gromacs/options/ioptionscontainer.h"
@@ -63,6 +66,7 @@
 #include "gromacs/selection/selectionoptionbehavior.h"
 #include "gromacs/topology/topology.h"
 #include "gromacs/trajectory/trajectoryframe.h"
+#include "gromacs/trajectoryanalysis/analysismodule.h"
 #include "gromacs/trajectoryanalysis/analysissettings.h"
 #include "gromacs/trajectoryanalysis/topologyinformation.h"
 #include "gromacs/utility/cstringutil.h"
@@ -133,7 +137,9 @@ public:
     t_trxframe* fr;
     gmx_rmpbc_t gpbc_;
     //! Used to store the status variable from read_first_frame().
-    t_trxstatus*      status_;
+    t_trxstatus* status_;
+    //! Read-ahead handle when frames are decoded on a reader thread.
+    t_trxreadahead*   readahead_;
     gmx_output_env_t* oenv_;
 };
 
@@ -150,6 +156,7 @@ TrajectoryAnalysisRunnerCommon::Impl::Impl(TrajectoryAnalysisSettings* settings)
     fr(nullptr),
     gpbc_(nullptr),
     status_(nullptr),
+    readahead_(nullptr),
     oenv_(nullptr)
 {
 }
@@ -235,6 +242,20 @@ void TrajectoryAnalysisRunnerCommon::Impl::initFirstFrame()
                 GMX_THROW(InconsistentInputError(message));
             }
         }
+
+        /* With GMX_ANALYSIS_READAHEAD set, upcoming frames are decoded on
+         * a reader thread so that trajectory (de)compression overlaps
+         * with the per-frame analysis. The value sets the number of
+         * frames read ahead; any non-number selects the default. */
+        if (const char* env = std::getenv("GMX_ANALYSIS_READAHEAD"))
+        {
+            int depth = std::atoi(env);
+            if (depth <= 0)
+            {
+                depth = 4;
+            }
+            readahead_ = start_trx_readahead(oenv_, status_, fr, depth);
+        }
     }
     else
     {
@@ -293,6 +314,11 @@ void TrajectoryAnalysisRunnerCommon::Impl::finishTrajectory()
 {
     if (bTrajOpen_)
     {
+        if (readahead_ != nullptr)
+        {
+            done_trx_readahead(readahead_);
+            readahead_ = nullptr;
+        }
         close_trx(status_);
         bTrajOpen_ = false;
     }
@@ -442,7 +468,14 @@ bool TrajectoryAnalysisRunnerCommon::readNextFrame()
     bool bContinue = false;
     if (hasTrajectory())
     {
-        bContinue = read_next_frame(impl_->oenv_, impl_->status_, impl_->fr);
+        if (impl_->readahead_ != nullptr)
+        {
+            bContinue = read_next_frame_readahead(impl_->readahead_, impl_->fr);
+        }
+        else
+        {
+            bContinue = read_next_frame(impl_->oenv_, impl_->status_, impl_->fr);
+        }
     }
     if (!bContinue)
     {
@@ -479,4 +512,98 @@ t_trxframe& TrajectoryAnalysisRunnerCommon::frame() const
     return *impl_->fr;
 }
 
+
+/********************************************************************
+ * TrajectoryAnalysisModuleBatch
+ */
+
+TrajectoryAnalysisModuleBatch::TrajectoryAnalysisModuleBatch(TrajectoryAnalysisSettings* settings,
+                                                             TrajectoryAnalysisRunnerCommon* common,
+                                                             SelectionCollection* selections) :
+    settings_(settings),
+    common_(common),
+    selections_(selections)
+{
+}
+
+
+void TrajectoryAnalysisModuleBatch::addModule(TrajectoryAnalysisModule* module)
+{
+    modules_.push_back(module);
+}
+
+
+int TrajectoryAnalysisModuleBatch::run()
+{
+    common_->initTopology();
+    const TopologyInformation& topology = common_->topologyInformation();
+    for (TrajectoryAnalysisModule* module : modules_)
+    {
+        module->initAnalysis(*settings_, topology);
+    }
+
+    // Load first frame.
+    common_->initFirstFrame();
+    common_->initFrameIndexGroup();
+    for (TrajectoryAnalysisModule* module : modules_)
+    {
+        module->initAfterFirstFrame(*settings_, common_->frame());
+    }
+
+    t_pbc  pbc;
+    t_pbc* ppbc = settings_->hasPBC() ? &pbc : nullptr;
+
+    int                                              nframes = 0;
+    AnalysisDataParallelOptions                      dataOptions;
+    std::vector<TrajectoryAnalysisModuleDataPointer> pdata;
+    pdata.reserve(modules_.size());
+    for (TrajectoryAnalysisModule* module : modules_)
+    {
+        pdata.push_back(module->startFrames(dataOptions, *selections_));
+    }
+    do
+    {
+        common_->initFrame();
+        t_trxframe& frame = common_->frame();
+        if (ppbc != nullptr)
+        {
+            set_pbc(ppbc, topology.pbcType(), frame.box);
+        }
+
+        // The frame and the selections are shared by all modules.
+        // \todo If analysis modules gain GPU implementations, this is the
+        // place to make the frame coordinates resident on the device once
+        // per frame, so that all modules consume the same device buffer
+        // instead of each uploading separately.
+        selections_->evaluate(&frame, ppbc);
+        for (size_t i = 0; i < modules_.size(); ++i)
+        {
+            modules_[i]->analyzeFrame(nframes, frame, ppbc, pdata[i].get());
+            modules_[i]->finishFrameSerial(nframes);
+        }
+
+        ++nframes;
+    } while (common_->readNextFrame());
+    for (size_t i = 0; i < modules_.size(); ++i)
+    {
+        modules_[i]->finishFrames(pdata[i].get());
+        if (pdata[i] != nullptr)
+        {
+            pdata[i]->finish();
+        }
+        pdata[i].reset();
+    }
+
+    // Restore the maximal groups for dynamic selections.
+    selections_->evaluateFinal(nframes);
+
+    for (TrajectoryAnalysisModule* module : modules_)
+    {
+        module->finishAnalysis(nframes);
+        module->writeOutput();
+    }
+
+    return nframes;
+}
+
 } // namespace gmx
@@ -43,6 +43,8 @@
 #ifndef GMX_TRAJECTORYANALYSIS_RUNNERCOMMON_H
 #define GMX_TRAJECTORYANALYSIS_RUNNERCOMMON_H
 
+#include <vector>
+
 #include "gromacs/utility/classhelpers.h"
 
 struct t_trxframe;
@@ -55,6 +57,7 @@ class ITopologyProvider;
 class SelectionCollection;
 class TimeUnitBehavior;
 class TopologyInformation;
+class TrajectoryAnalysisModule;
 class TrajectoryAnalysisSettings;
 
 /*! \internal
@@ -132,6 +135,63 @@ private:
     PrivateImplPointer<Impl> impl_;
 };
 
+/*! \internal
+ * \brief
+ * Runs several analysis modules over a single pass of the trajectory.
+ *
+ * The registered modules share one TrajectoryAnalysisSettings, one
+ * TrajectoryAnalysisRunnerCommon, and one SelectionCollection, so the
+ * trajectory is read and the selections are evaluated only once per frame
+ * for all modules instead of once per module.
+ *
+ * The caller is responsible for initializing and finishing the options of
+ * each module against the shared settings and selection collection, in the
+ * same way the command-line runner does for a single module.  Because the
+ * settings are shared, requirements set by the modules (frame flags, PBC
+ * handling, etc.) accumulate over all of them.
+ *
+ * \ingroup module_trajectoryanalysis
+ */
+class TrajectoryAnalysisModuleBatch
+{
+public:
+    /*! \brief
+     * Initializes a batch runner using shared helper objects.
+     *
+     * \param    settings   Settings object shared by all modules.
+     * \param    common     Runner helper that owns the frame stream.
+     * \param    selections Selection collection shared by all modules.
+     *
+     * The objects need to remain valid for the lifetime of the batch.
+     */
+    TrajectoryAnalysisModuleBatch(TrajectoryAnalysisSettings*     settings,
+                                  TrajectoryAnalysisRunnerCommon* common,
+                                  SelectionCollection*            selections);
+
+    /*! \brief
+     * Registers \p module to run during the shared pass.
+     *
+     * The caller retains ownership of the module.
+     */
+    void addModule(TrajectoryAnalysisModule* module);
+    /*! \brief
+     * Runs all registered modules over the trajectory in one pass.
+     *
+     * \returns Number of frames analyzed.
+     */
+    int run();
+
+private:
+    //! Settings shared by all modules.
+    TrajectoryAnalysisSettings* settings_;
+    //! Helper that owns the frame stream.
+    TrajectoryAnalysisRunnerCommon* common_;
+    //! Selections shared by all modules.
+    SelectionCollection* selections_;
+    //! Modules to run over the shared pass (not owned).
+    std::vector<TrajectoryAnalysisModule*> modules_;
+};
+
 } // namespace gmx
 
 #endif
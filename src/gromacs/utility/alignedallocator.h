@@ -74,6 +74,11 @@ public:
      * It will also be padded by the same amount at the end of the
      * area, to help avoid false cache sharing.
      *
+     * When the environment variable GMX_HUGEPAGES is set, large
+     * allocations are additionally aligned to and, where supported,
+     * backed by transparent huge pages, which reduces TLB pressure
+     * for very large systems.
+     *
      *  \note Memory allocated with this routine must be released with
      *        gmx::AlignedAllocationPolicy::free(), and absolutely not the system free().
      */
@@ -133,6 +138,11 @@ public:
      *
      * \return Valid pointer if the allocation worked, otherwise nullptr.
      *
+     * When the environment variable GMX_HUGEPAGES is set, large
+     * allocations are additionally aligned to and, where supported,
+     * backed by transparent huge pages, which reduces TLB pressure
+     * for very large systems.
+     *
      *  \note Memory allocated with this routine must be released with
      *        gmx::PageAlignedAllocationPolicy::free(), and absolutely not the system free().
      */
@@ -733,6 +733,32 @@ int gmx_fsync(FILE* fp)
     return rc;
 }
 
+void gmx_file_drop_page_cache(FILE* fp)
+{
+#if HAVE_POSIX_FADVISE && (HAVE_FILENO || HAVE__FILENO)
+    int fn;
+
+#    if HAVE_FILENO
+    fn = fileno(fp);
+#    else
+    fn = _fileno(fp);
+#    endif
+    if (fn < 0)
+    {
+        return;
+    }
+#    if HAVE_SYNC_FILE_RANGE
+    /* Start writeback of dirty pages first, since the kernel only drops
+     * clean pages; without this the advice would mostly be ignored. This
+     * does not wait for the writeback to complete. */
+    sync_file_range(fn, 0, 0, SYNC_FILE_RANGE_WRITE);
+#    endif
+    posix_fadvise(fn, 0, 0, POSIX_FADV_DONTNEED);
+#else
+    GMX_UNUSED_VALUE(fp);
+#endif
+}
+
 void gmx_chdir(const char* directory)
 {
 #if GMX_NATIVE_WINDOWS
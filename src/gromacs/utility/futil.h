@@ -205,6 +205,16 @@ int gmx_file_copy(const char* oldname, const char* newname, gmx_bool copy_if_emp
  */
 int gmx_fsync(FILE* fp);
 
+/*! \brief
+ * Advise the OS to drop the page cache used by \p fp.
+ *
+ * Starts writeback of dirty pages and marks the cached pages of the
+ * whole file as not needed again, which keeps large streamed output
+ * files from evicting more useful data from the page cache. A no-op
+ * when the OS does not support the needed calls.
+ */
+void gmx_file_drop_page_cache(FILE* fp);
+
 /*! \brief
  * OS-independent chdir().
  *
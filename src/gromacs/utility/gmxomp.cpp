@@ -68,6 +68,15 @@ int gmx_omp_get_max_threads()
 #endif
 }
 
+int gmx_omp_get_num_threads()
+{
+#if GMX_OPENMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
 int gmx_omp_get_num_procs()
 {
 #if GMX_OPENMP
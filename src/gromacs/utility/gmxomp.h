@@ -75,6 +75,16 @@
  */
 int gmx_omp_get_max_threads();
 
+/*! \brief
+ * Returns the number of threads in the current team.
+ *
+ * Returns 1 when called outside a parallel region, or from a nested
+ * parallel region that executes with a single thread.
+ *
+ * Acts as a wrapper for omp_get_num_threads().
+ */
+int gmx_omp_get_num_threads();
+
 /*! \brief
  * Returns the number of processors available when the function is called.
  *
@@ -139,6 +139,20 @@ public:
         listRanges_.push_back(int(elements_.size()));
     }
 
+    /*! \brief Reserves memory for a total count of lists and elements
+     *
+     * Avoids reallocation when the final sizes are known in advance,
+     * e.g. when concatenating many lists.
+     *
+     * \param[in] numLists     The total number of lists that will be stored
+     * \param[in] numElements  The total number of elements that will be stored
+     */
+    void reserve(const std::size_t numLists, const std::size_t numElements)
+    {
+        listRanges_.reserve(numLists + 1);
+        elements_.reserve(numElements);
+    }
+
     //! Returns an ArrayRef to the elements of the list with the given index
     ArrayRef<const T> operator[](std::size_t listIndex) const
     {
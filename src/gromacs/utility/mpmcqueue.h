@@ -0,0 +1,199 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares a bounded lock-free multi-producer multi-consumer queue.
+ *
+ * \inlibraryapi
+ * \ingroup module_utility
+ */
+#ifndef GMX_UTILITY_MPMCQUEUE_H
+#define GMX_UTILITY_MPMCQUEUE_H
+
+#include <cstddef>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "gromacs/utility/classhelpers.h"
+
+namespace gmx
+{
+
+/*! \libinternal \brief Bounded lock-free multi-producer multi-consumer queue.
+ *
+ * \tparam T  Type of the queued elements, must be default constructible
+ *            and movable.
+ *
+ * Implements the bounded MPMC queue of Dmitry Vyukov: every cell of the
+ * ring buffer carries a sequence number that producers and consumers use
+ * to claim cells with a single compare-and-swap each, so any number of
+ * threads can push and pop concurrently without taking a lock. Both
+ * operations are non-blocking: they fail instead of waiting when the
+ * queue is full or empty, which makes the queue suitable for work
+ * distribution in fine-grained phases where (OpenMP) barrier and lock
+ * overhead would dominate.
+ */
+template<typename T>
+class MpmcQueue
+{
+public:
+    /*! \brief Construct a queue with at least \p capacity cells.
+     *
+     * The capacity is rounded up to the next power of two, so the ring
+     * buffer index can be computed with a mask.
+     */
+    explicit MpmcQueue(std::size_t capacity) : enqueuePos_(0), dequeuePos_(0)
+    {
+        capacity_ = 2;
+        while (capacity_ < capacity)
+        {
+            capacity_ *= 2;
+        }
+        cells_.reset(new Cell[capacity_]);
+        for (std::size_t i = 0; i < capacity_; i++)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /*! \brief Push \p value onto the queue.
+     *
+     * \returns false without blocking when the queue is full.
+     */
+    bool tryPush(T value)
+    {
+        Cell*       cell;
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell                  = &cells_[pos & (capacity_ - 1)];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff =
+                    static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                /* The cell has not been consumed yet: the queue is full */
+                return false;
+            }
+            else
+            {
+                /* Another producer claimed this cell, reload the position */
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /*! \brief Pop an element from the queue into \p value.
+     *
+     * \returns false without blocking when the queue is empty.
+     */
+    bool tryPop(T* value)
+    {
+        Cell*       cell;
+        std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell                  = &cells_[pos & (capacity_ - 1)];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff =
+                    static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                /* The cell has not been produced yet: the queue is empty */
+                return false;
+            }
+            else
+            {
+                /* Another consumer claimed this cell, reload the position */
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        *value = std::move(cell->value);
+        cell->sequence.store(pos + capacity_, std::memory_order_release);
+
+        return true;
+    }
+
+    //! Return the capacity of the queue
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    /*! \internal \brief One ring buffer cell with its sequence number */
+    struct Cell
+    {
+        //! The sequence number used to claim the cell without a lock
+        std::atomic<std::size_t> sequence;
+        //! The stored element
+        T value;
+    };
+
+    //! The ring buffer, with capacity_ cells
+    std::unique_ptr<Cell[]> cells_;
+    //! The capacity of the ring buffer, a power of two
+    std::size_t capacity_;
+    /* The producer and consumer positions are kept on separate cache
+     * lines to avoid false sharing between pushing and popping threads.
+     */
+    //! The position of the next push
+    alignas(64) std::atomic<std::size_t> enqueuePos_;
+    //! The position of the next pop
+    alignas(64) std::atomic<std::size_t> dequeuePos_;
+
+    GMX_DISALLOW_COPY_AND_ASSIGN(MpmcQueue);
+};
+
+} // namespace gmx
+
+#endif
@@ -44,8 +44,11 @@
 #include "strconvert.h"
 
 #include <cerrno>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 
+#include <algorithm>
 #include <limits>
 #include <string>
 
@@ -143,6 +146,73 @@ double doubleFromString(const char* str)
     return value;
 }
 
+const char* parseDoubleFromFixedField(const char* begin, const char* end, double* value)
+{
+    /* Powers of ten used to divide out the fraction; these are exactly
+     * representable, so the single division below rounds only once.
+     */
+    static const double c_powerOfTen[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                                           1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17 };
+
+    const char* p = begin;
+    while (p < end && (*p == ' ' || *p == '\t'))
+    {
+        p++;
+    }
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    std::uint64_t mantissa      = 0;
+    int           numDigits     = 0;
+    int           numFracDigits = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        mantissa = mantissa * 10 + (*p - '0');
+        numDigits++;
+        p++;
+    }
+    if (p < end && *p == '.')
+    {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9')
+        {
+            mantissa = mantissa * 10 + (*p - '0');
+            numDigits++;
+            numFracDigits++;
+            p++;
+        }
+    }
+
+    const bool haveExponent = (p < end && (*p == 'e' || *p == 'E'));
+    if (numDigits == 0 || numDigits > 17 || haveExponent)
+    {
+        /* Rare or invalid input: delegate to strtod() on a terminated
+         * copy of the field, so all C number syntax is accepted.
+         */
+        char buf[64];
+
+        const std::size_t length = std::min<std::size_t>(end - begin, sizeof(buf) - 1);
+        std::memcpy(buf, begin, length);
+        buf[length] = '\0';
+        char*        endptr;
+        const double result = std::strtod(buf, &endptr);
+
+        *value = result;
+
+        return begin + (endptr - buf);
+    }
+
+    const double result = static_cast<double>(mantissa) / c_powerOfTen[numFracDigits];
+
+    *value = negative ? -result : result;
+
+    return p;
+}
+
 //! \endcond
 
 } // namespace gmx
@@ -95,6 +95,32 @@ float floatFromString(const char* str);
  */
 double doubleFromString(const char* str);
 
+/*! \brief
+ * Parses a decimal floating-point number from a fixed-width character field.
+ *
+ * This is optimized for the coordinate fields of structure file formats
+ * such as gro and pdb: the common case of optional whitespace, an
+ * optional sign, digits and an optional fraction is converted with pure
+ * integer arithmetic, which is roughly an order of magnitude faster than
+ * sscanf() or strtod() and makes a difference when reading files with
+ * millions of atoms. Fields using an exponent, or more digits than fit
+ * in the integer fast path, fall back to strtod() for full
+ * compatibility.
+ *
+ * Parsing stops at \p end or at the first character that cannot be part
+ * of the number, whichever comes first.
+ *
+ * \param[in]  begin  Start of the field.
+ * \param[in]  end    End of the field (exclusive).
+ * \param[out] value  The parsed value; 0 when no number was found.
+ * \returns  Pointer just past the parsed number, or \p begin when the
+ *           field does not contain a number.
+ *
+ * Does not throw, in contrast to the *FromString() functions above, so
+ * the caller decides how to handle invalid fields.
+ */
+const char* parseDoubleFromFixedField(const char* begin, const char* end, double* value);
+
 /*! \brief
  * Parses a value from a string to a given type.
  *
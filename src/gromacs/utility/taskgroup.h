@@ -0,0 +1,110 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares a lightweight task group for running independent tasks.
+ *
+ * \inlibraryapi
+ * \ingroup module_utility
+ */
+#ifndef GMX_UTILITY_TASKGROUP_H
+#define GMX_UTILITY_TASKGROUP_H
+
+#include <cstddef>
+
+#include <functional>
+
+#include "gromacs/utility/classhelpers.h"
+#include "gromacs/utility/mpmcqueue.h"
+
+namespace gmx
+{
+
+/*! \libinternal \brief Lightweight group of independent tasks executed
+ * by a team of threads pulling from a lock-free queue.
+ *
+ * Tasks are enqueued from the calling thread and executed with run(),
+ * which lets each thread of an OpenMP team pop and execute tasks until
+ * the queue is empty. Since the threads pull work dynamically, phases
+ * consisting of tasks with unequal cost do not need a barrier between
+ * them: a thread that finishes its share of one phase immediately
+ * proceeds with the remaining tasks, instead of waiting for the full
+ * team at a statically scheduled loop boundary.
+ *
+ * The tasks must be independent: no ordering between them is guaranteed
+ * and they must not use OpenMP barriers or other team-wide operations.
+ */
+class TaskGroup
+{
+public:
+    /*! \brief Construct a task group with capacity for \p maxTasks tasks */
+    explicit TaskGroup(std::size_t maxTasks);
+
+    /*! \brief Add \p task to the group.
+     *
+     * Should be called before run(); asserts when the queue is full.
+     */
+    void enqueue(std::function<void()> task);
+
+    /*! \brief Execute all enqueued tasks on a team of \p numThreads
+     * OpenMP threads and return when all tasks have completed.
+     *
+     * Exceptions thrown by tasks terminate the run with a fatal error,
+     * as is usual for errors inside OpenMP regions.
+     *
+     * Must not be called from within an OpenMP parallel region.
+     */
+    void run(int numThreads);
+
+    /*! \brief Pop and execute tasks on the calling thread until the
+     * queue is empty.
+     *
+     * This can be used by threads of an already existing parallel
+     * region to participate in executing the tasks. Note that an empty
+     * queue does not imply that all tasks have completed, since other
+     * threads may still be executing; run() provides that guarantee.
+     */
+    void runPendingTasks();
+
+private:
+    //! The queue holding the tasks not yet started
+    MpmcQueue<std::function<void()>> queue_;
+
+    GMX_DISALLOW_COPY_AND_ASSIGN(TaskGroup);
+};
+
+} // namespace gmx
+
+#endif
@@ -198,6 +198,19 @@ TEST(ListOfLists, ExtractsAndRestores)
     compareLists(list2, v);
 }
 
+TEST(ListOfLists, ReservesAndKeepsContents)
+{
+    ListOfLists<char> list;
+    list.reserve(2, 3);
+
+    std::vector<char> v{ { 5, 3 } };
+    list.pushBack(v);
+    list.pushBack({});
+    EXPECT_EQ(list.size(), 2);
+    EXPECT_EQ(list.numElements(), 2);
+    EXPECT_THAT(list.front(), Pointwise(Eq(), v));
+}
+
 TEST(ListOfLists, AppendsListOfListsWithOffset)
 {
     std::vector<std::vector<char>> v = { { 5, 3 }, { 2, char(-1) }, { 4 } };
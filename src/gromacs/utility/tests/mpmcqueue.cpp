@@ -0,0 +1,135 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief Tests for gmx::MpmcQueue
+ *
+ * \ingroup module_utility
+ */
+#include "gmxpre.h"
+
+#include "gromacs/utility/mpmcqueue.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace gmx
+{
+
+namespace
+{
+
+TEST(MpmcQueueTest, RoundsCapacityUpToPowerOfTwo)
+{
+    EXPECT_EQ(MpmcQueue<int>(1).capacity(), 2U);
+    EXPECT_EQ(MpmcQueue<int>(8).capacity(), 8U);
+    EXPECT_EQ(MpmcQueue<int>(9).capacity(), 16U);
+}
+
+TEST(MpmcQueueTest, PushPopPreservesOrder)
+{
+    MpmcQueue<int> queue(8);
+
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        int value;
+        ASSERT_TRUE(queue.tryPop(&value));
+        EXPECT_EQ(value, i);
+    }
+}
+
+TEST(MpmcQueueTest, FailsWhenFullOrEmpty)
+{
+    MpmcQueue<int> queue(2);
+
+    int value;
+    EXPECT_FALSE(queue.tryPop(&value));
+
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_FALSE(queue.tryPush(3));
+
+    EXPECT_TRUE(queue.tryPop(&value));
+    EXPECT_TRUE(queue.tryPush(3));
+}
+
+TEST(MpmcQueueTest, ConcurrentPushPopDeliversAllElements)
+{
+    const int numThreads        = 4;
+    const int numPushesPerThread = 1000;
+
+    MpmcQueue<int>   queue(numThreads * numPushesPerThread);
+    std::atomic<int> sum(0);
+    std::atomic<int> numPopped(0);
+
+    std::vector<std::thread> threads;
+    threads.reserve(2 * numThreads);
+    for (int t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back([&queue, t] {
+            for (int i = 0; i < numPushesPerThread; i++)
+            {
+                while (!queue.tryPush(t * numPushesPerThread + i)) {}
+            }
+        });
+        threads.emplace_back([&queue, &sum, &numPopped] {
+            for (int i = 0; i < numPushesPerThread; i++)
+            {
+                int value;
+                while (!queue.tryPop(&value)) {}
+                sum += value;
+                numPopped++;
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const int numPushed = numThreads * numPushesPerThread;
+    EXPECT_EQ(numPopped.load(), numPushed);
+    EXPECT_EQ(sum.load(), numPushed * (numPushed - 1) / 2);
+}
+
+} // namespace
+
+} // namespace gmx
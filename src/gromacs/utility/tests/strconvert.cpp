@@ -0,0 +1,109 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief Tests for string conversion routines.
+ *
+ * \ingroup module_utility
+ */
+#include "gmxpre.h"
+
+#include "gromacs/utility/strconvert.h"
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+namespace gmx
+{
+
+namespace
+{
+
+//! Parses all of \p field and returns the value, expecting success
+double parseField(const char* field)
+{
+    double      value;
+    const char* end = parseDoubleFromFixedField(field, field + std::strlen(field), &value);
+
+    EXPECT_NE(end, field);
+
+    return value;
+}
+
+TEST(ParseDoubleFromFixedFieldTest, ParsesFixedFormatFields)
+{
+    EXPECT_DOUBLE_EQ(parseField("   1.250"), 1.25);
+    EXPECT_DOUBLE_EQ(parseField("  -0.734"), -0.734);
+    EXPECT_DOUBLE_EQ(parseField("+123.456"), 123.456);
+    EXPECT_DOUBLE_EQ(parseField("42"), 42.0);
+    EXPECT_DOUBLE_EQ(parseField(".5"), 0.5);
+    EXPECT_DOUBLE_EQ(parseField("  987654.321"), 987654.321);
+}
+
+TEST(ParseDoubleFromFixedFieldTest, FallsBackForExponents)
+{
+    EXPECT_DOUBLE_EQ(parseField("1.5e3"), 1500.0);
+    EXPECT_DOUBLE_EQ(parseField(" -2E-2"), -0.02);
+    /* More digits than the integer fast path handles */
+    EXPECT_DOUBLE_EQ(parseField("123456789.123456789012"), 123456789.123456789012);
+}
+
+TEST(ParseDoubleFromFixedFieldTest, ReturnsBeginForInvalidFields)
+{
+    double      value;
+    const char* field = "  abc ";
+
+    EXPECT_EQ(parseDoubleFromFixedField(field, field + std::strlen(field), &value), field);
+    EXPECT_EQ(parseDoubleFromFixedField(field, field, &value), field);
+}
+
+TEST(ParseDoubleFromFixedFieldTest, StopsAtFieldEnd)
+{
+    /* Two concatenated 8-wide fixed fields */
+    const char* line = "   1.250  -0.734";
+
+    double      value;
+    const char* end = parseDoubleFromFixedField(line, line + 8, &value);
+    EXPECT_EQ(end, line + 8);
+    EXPECT_DOUBLE_EQ(value, 1.25);
+
+    end = parseDoubleFromFixedField(line + 8, line + 16, &value);
+    EXPECT_EQ(end, line + 16);
+    EXPECT_DOUBLE_EQ(value, -0.734);
+}
+
+} // namespace
+
+} // namespace gmx
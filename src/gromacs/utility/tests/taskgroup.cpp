@@ -0,0 +1,110 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief Tests for gmx::TaskGroup
+ *
+ * \ingroup module_utility
+ */
+#include "gmxpre.h"
+
+#include "gromacs/utility/taskgroup.h"
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace gmx
+{
+
+namespace
+{
+
+TEST(TaskGroupTest, RunsAllTasks)
+{
+    const int numTasks = 100;
+
+    TaskGroup        taskGroup(numTasks);
+    std::atomic<int> sum(0);
+
+    for (int i = 0; i < numTasks; i++)
+    {
+        taskGroup.enqueue([&sum, i] { sum += i; });
+    }
+    taskGroup.run(4);
+
+    EXPECT_EQ(sum.load(), numTasks * (numTasks - 1) / 2);
+}
+
+TEST(TaskGroupTest, RunsTasksOnCallingThread)
+{
+    TaskGroup        taskGroup(4);
+    std::atomic<int> count(0);
+
+    for (int i = 0; i < 4; i++)
+    {
+        taskGroup.enqueue([&count] { count++; });
+    }
+    taskGroup.runPendingTasks();
+
+    EXPECT_EQ(count.load(), 4);
+}
+
+TEST(TaskGroupTest, EachTaskRunsExactlyOnce)
+{
+    const int numTasks = 64;
+
+    TaskGroup                     taskGroup(numTasks);
+    std::vector<std::atomic<int>> runCount(numTasks);
+    for (auto& count : runCount)
+    {
+        count = 0;
+    }
+
+    for (int i = 0; i < numTasks; i++)
+    {
+        taskGroup.enqueue([&runCount, i] { runCount[i]++; });
+    }
+    taskGroup.run(4);
+
+    for (const auto& count : runCount)
+    {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+} // namespace
+
+} // namespace gmx
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief Tests for the per-thread scratch arena.
+ *
+ * \ingroup module_utility
+ */
+#include "gmxpre.h"
+
+#include "gromacs/utility/threadscratch.h"
+
+#include <cstdint>
+
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace gmx
+{
+
+namespace
+{
+
+TEST(ThreadScratchTest, AllocatesAlignedMemory)
+{
+    ThreadScratchScope scratchScope;
+
+    void* p = ThreadScratchAllocationPolicy::malloc(100);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 128, 0U);
+    ThreadScratchAllocationPolicy::free(p);
+}
+
+TEST(ThreadScratchTest, ReclaimsMemoryWhenScopeIsLeft)
+{
+    void* first;
+    {
+        ThreadScratchScope scratchScope;
+        first = ThreadScratchAllocationPolicy::malloc(100);
+        ThreadScratchAllocationPolicy::free(first);
+    }
+    {
+        ThreadScratchScope scratchScope;
+        /* After resetting the arena, the same memory is handed out again */
+        void* second = ThreadScratchAllocationPolicy::malloc(100);
+        EXPECT_EQ(first, second);
+        ThreadScratchAllocationPolicy::free(second);
+    }
+}
+
+TEST(ThreadScratchTest, WorksWithoutActiveScope)
+{
+    void* p = ThreadScratchAllocationPolicy::malloc(100);
+    ASSERT_NE(p, nullptr);
+    ThreadScratchAllocationPolicy::free(p);
+}
+
+TEST(ThreadScratchTest, FallsBackToHeapForLargeAllocations)
+{
+    ThreadScratchScope scratchScope;
+
+    /* Much larger than the arena capacity */
+    void* p = ThreadScratchAllocationPolicy::malloc(64 * 1024 * 1024);
+    ASSERT_NE(p, nullptr);
+    ThreadScratchAllocationPolicy::free(p);
+}
+
+TEST(ThreadScratchTest, VectorWorksInScope)
+{
+    ThreadScratchScope scratchScope;
+
+    std::vector<int, ThreadScratchAllocator<int>> v;
+    for (int i = 0; i < 1000; i++)
+    {
+        v.push_back(i);
+    }
+    EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 1000 * 999 / 2);
+}
+
+TEST(ThreadScratchTest, NestedScopesRestoreCorrectly)
+{
+    ThreadScratchScope outerScope;
+
+    void* outer = ThreadScratchAllocationPolicy::malloc(100);
+    void* inner;
+    {
+        ThreadScratchScope innerScope;
+        inner = ThreadScratchAllocationPolicy::malloc(100);
+        ThreadScratchAllocationPolicy::free(inner);
+    }
+    /* The inner allocation is reclaimed, the outer one is not */
+    void* p = ThreadScratchAllocationPolicy::malloc(100);
+    EXPECT_EQ(p, inner);
+    EXPECT_NE(p, outer);
+    ThreadScratchAllocationPolicy::free(p);
+    ThreadScratchAllocationPolicy::free(outer);
+}
+
+} // namespace
+
+} // namespace gmx
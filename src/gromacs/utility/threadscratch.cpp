@@ -0,0 +1,159 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Implements the per-thread monotonic scratch arena.
+ *
+ * \ingroup module_utility
+ */
+#include "gmxpre.h"
+
+#include "threadscratch.h"
+
+#include <cstdint>
+
+#include "gromacs/utility/alignedallocator.h"
+#include "gromacs/utility/gmxassert.h"
+
+namespace gmx
+{
+
+namespace
+{
+
+//! The capacity of the scratch arena buffer of each thread
+constexpr std::size_t c_scratchCapacity = 1024 * 1024;
+
+//! The alignment of scratch allocations, matching AlignedAllocationPolicy
+constexpr std::size_t c_scratchAlignment = 128;
+
+/*! \internal \brief The scratch arena of one thread */
+struct ScratchArena
+{
+    ~ScratchArena()
+    {
+        if (buffer != nullptr)
+        {
+            AlignedAllocationPolicy::free(buffer);
+        }
+    }
+
+    //! The bump allocation buffer, allocated at first use
+    unsigned char* buffer = nullptr;
+    //! The current allocation offset into \p buffer
+    std::size_t offset = 0;
+    //! The nesting depth of active ThreadScratchScope objects
+    int scopeDepth = 0;
+};
+
+//! Returns the scratch arena of the calling thread
+ScratchArena& threadArena()
+{
+    static thread_local ScratchArena arena;
+
+    return arena;
+}
+
+//! Returns whether \p p points into the arena buffer of \p arena
+bool isArenaPointer(const ScratchArena& arena, const void* p)
+{
+    const auto address = reinterpret_cast<std::uintptr_t>(p);
+    const auto begin   = reinterpret_cast<std::uintptr_t>(arena.buffer);
+
+    return (arena.buffer != nullptr && address >= begin && address < begin + c_scratchCapacity);
+}
+
+} // namespace
+
+void* ThreadScratchAllocationPolicy::malloc(std::size_t bytes)
+{
+    ScratchArena& arena = threadArena();
+
+    if (arena.scopeDepth > 0)
+    {
+        /* Round up, so the next allocation stays aligned */
+        const std::size_t paddedBytes =
+                ((bytes + c_scratchAlignment - 1) / c_scratchAlignment) * c_scratchAlignment;
+
+        if (arena.buffer == nullptr)
+        {
+            arena.buffer = static_cast<unsigned char*>(AlignedAllocationPolicy::malloc(c_scratchCapacity));
+        }
+        if (arena.buffer != nullptr && arena.offset + paddedBytes <= c_scratchCapacity)
+        {
+            void* p = arena.buffer + arena.offset;
+            arena.offset += paddedBytes;
+
+            return p;
+        }
+        /* The arena is full: fall through to a normal heap allocation */
+    }
+
+    return AlignedAllocationPolicy::malloc(bytes);
+}
+
+void ThreadScratchAllocationPolicy::free(void* p)
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+
+    if (!isArenaPointer(threadArena(), p))
+    {
+        AlignedAllocationPolicy::free(p);
+    }
+    /* Arena memory is reclaimed when the enclosing scope is left */
+}
+
+ThreadScratchScope::ThreadScratchScope()
+{
+    ScratchArena& arena = threadArena();
+
+    savedOffset_ = arena.offset;
+    arena.scopeDepth++;
+}
+
+ThreadScratchScope::~ThreadScratchScope()
+{
+    ScratchArena& arena = threadArena();
+
+    GMX_ASSERT(arena.scopeDepth > 0, "Unbalanced ThreadScratchScope destruction");
+
+    arena.offset = savedOffset_;
+    arena.scopeDepth--;
+}
+
+} // namespace gmx
@@ -0,0 +1,129 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares a per-thread monotonic scratch arena for transient allocations.
+ *
+ * Short-lived containers in per-step code, such as the buffers used when
+ * setting up the bonded threading or building domain decomposition lists,
+ * cause malloc traffic that contends on the allocator lock at high thread
+ * counts. The scratch arena hands out memory from a per-thread buffer with
+ * a simple offset bump and reclaims all of it at once when the enclosing
+ * ThreadScratchScope is left, so such transient allocations never touch
+ * the system allocator.
+ *
+ * Usage:
+ * \code
+ *   ThreadScratchScope scratchScope;
+ *   std::vector<int, ThreadScratchAllocator<int>> buffer;
+ *   ... // use buffer, it must not outlive scratchScope
+ * \endcode
+ *
+ * Allocations that do not fit in the arena, and allocations made while
+ * no scope is active, transparently fall back to the normal aligned
+ * heap allocation, so correctness never depends on the arena capacity.
+ *
+ * \inlibraryapi
+ * \ingroup module_utility
+ */
+#ifndef GMX_UTILITY_THREADSCRATCH_H
+#define GMX_UTILITY_THREADSCRATCH_H
+
+#include <cstddef>
+
+#include "gromacs/utility/allocator.h"
+#include "gromacs/utility/classhelpers.h"
+
+namespace gmx
+{
+
+/*! \libinternal \brief Policy class for configuring gmx::Allocator to
+ * allocate from the scratch arena of the calling thread.
+ *
+ * Memory obtained through this policy inside a ThreadScratchScope is
+ * only valid until that scope is left; containers using it must
+ * therefore not outlive the innermost scope that was active at their
+ * last reallocation.
+ */
+class ThreadScratchAllocationPolicy
+{
+public:
+    /*! \brief Allocate \p bytes from the scratch arena of the calling thread.
+     *
+     * Falls back to aligned heap allocation when the arena is full or
+     * no ThreadScratchScope is active.
+     */
+    static void* malloc(std::size_t bytes);
+    /*! \brief Release memory obtained from malloc().
+     *
+     * A no-op for memory from the arena buffer, which is reclaimed
+     * when the enclosing ThreadScratchScope is left.
+     */
+    static void free(void* p);
+};
+
+/*! \brief Scratch arena allocator for transient containers in hot paths.
+ *
+ * \tparam T  Type of objects to allocate
+ *
+ * This convenience partial specialization can be used for the optional
+ * allocator template parameter in standard library containers that are
+ * created and destroyed inside a ThreadScratchScope.
+ */
+template<class T>
+using ThreadScratchAllocator = Allocator<T, ThreadScratchAllocationPolicy>;
+
+/*! \libinternal \brief Scope handle that reclaims all scratch arena
+ * allocations made by the calling thread during its lifetime.
+ *
+ * Scopes can be nested; leaving a scope resets the arena of the calling
+ * thread to the state it had when the scope was entered.
+ */
+class ThreadScratchScope
+{
+public:
+    ThreadScratchScope();
+    ~ThreadScratchScope();
+
+private:
+    //! The arena offset to restore when this scope is left
+    std::size_t savedOffset_;
+
+    GMX_DISALLOW_COPY_AND_ASSIGN(ThreadScratchScope);
+};
+
+} // namespace gmx
+
+#endif
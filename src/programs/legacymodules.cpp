@@ -67,8 +67,10 @@
 #include "gromacs/tools/report_methods.h"
 #include "gromacs/tools/trjcat.h"
 #include "gromacs/tools/trjconv.h"
+#include "gromacs/tools/tune.h"
 #include "gromacs/tools/tune_pme.h"
 
+#include "mdrun/mdkernel_bench.h"
 #include "mdrun/mdrun_main.h"
 #include "mdrun/nonbonded_bench.h"
 #include "view/view.h"
@@ -188,6 +190,10 @@ void registerLegacyModules(gmx::CommandLineModuleManager* manager)
             manager, gmx::NonbondedBenchmarkInfo::name,
             gmx::NonbondedBenchmarkInfo::shortDescription, &gmx::NonbondedBenchmarkInfo::create);
 
+    gmx::ICommandLineOptionsModule::registerModuleFactory(
+            manager, gmx::MDKernelBenchmarkInfo::name, gmx::MDKernelBenchmarkInfo::shortDescription,
+            &gmx::MDKernelBenchmarkInfo::create);
+
     gmx::ICommandLineOptionsModule::registerModuleFactory(manager, gmx::InsertMoleculesInfo::name(),
                                                           gmx::InsertMoleculesInfo::shortDescription(),
                                                           &gmx::InsertMoleculesInfo::create);
@@ -316,6 +322,8 @@ void registerLegacyModules(gmx::CommandLineModuleManager* manager)
     registerModule(manager, &gmx_tcaf, "tcaf", "Calculate viscosities of liquids");
     registerModule(manager, &gmx_traj, "traj",
                    "Plot x, v, f, box, temperature and rotational energy from trajectories");
+    registerModule(manager, &gmx_tune, "tune",
+                   "Search for the fastest mdrun launch settings on this node");
     registerModule(manager, &gmx_tune_pme, "tune_pme",
                    "Time mdrun as a function of PME ranks to optimize settings");
     registerModule(manager, &gmx_vanhove, "vanhove",
@@ -375,6 +383,7 @@ void registerLegacyModules(gmx::CommandLineModuleManager* manager)
         group.addModule("sham");
         group.addModule("spatial");
         group.addModule("traj");
+        group.addModule("tune");
         group.addModule("tune_pme");
         group.addModule("wham");
         group.addModule("check");
@@ -0,0 +1,629 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2020, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ *
+ * \brief This file contains the benchmark for bonded, constraint and
+ * update kernels, which complements the non-bonded kernel benchmark.
+ */
+
+#include "gmxpre.h"
+
+#include "mdkernel_bench.h"
+
+#include <cmath>
+#include <cstdio>
+
+#include <memory>
+#include <vector>
+
+#include "gromacs/commandline/cmdlineoptionsmodule.h"
+#include "gromacs/gmxlib/nrnb.h"
+#include "gromacs/listed_forces/bonded.h"
+#include "gromacs/math/paddedvector.h"
+#include "gromacs/math/units.h"
+#include "gromacs/math/vec.h"
+#include "gromacs/mdlib/constr.h"
+#include "gromacs/mdlib/gmx_omp_nthreads.h"
+#include "gromacs/mdlib/lincs.h"
+#include "gromacs/mdlib/settle.h"
+#include "gromacs/mdlib/update.h"
+#include "gromacs/mdrunutility/multisim.h"
+#include "gromacs/mdtypes/commrec.h"
+#include "gromacs/mdtypes/fcdata.h"
+#include "gromacs/mdtypes/group.h"
+#include "gromacs/mdtypes/inputrec.h"
+#include "gromacs/mdtypes/md_enums.h"
+#include "gromacs/mdtypes/mdatom.h"
+#include "gromacs/mdtypes/state.h"
+#include "gromacs/options/basicoptions.h"
+#include "gromacs/options/ioptionscontainer.h"
+#include "gromacs/pbcutil/ishift.h"
+#include "gromacs/timing/cyclecounter.h"
+#include "gromacs/topology/idef.h"
+#include "gromacs/topology/topology.h"
+#include "gromacs/utility/arraysize.h"
+#include "gromacs/utility/gmxomp.h"
+#include "gromacs/utility/listoflists.h"
+#include "gromacs/utility/smalloc.h"
+
+namespace gmx
+{
+
+namespace
+{
+
+//! The kernel classes that can be benchmarked
+enum class BenchKernelClass : int
+{
+    All,
+    Bonded,
+    Settle,
+    Lincs,
+    Update,
+    Count
+};
+
+//! Prints one result row in the common table format
+void printResultRow(const char* kernel, const char* variant, double cycles, int numIterations, double numUnits)
+{
+    fprintf(stdout, "%-10s %-18s %12.3f %12.4f %10.2f\n", kernel, variant, cycles * 1e-6,
+            cycles * 1e-6 / numIterations, cycles / (numIterations * numUnits));
+}
+
+/*! \brief Benchmarks the CPU kernels for one simple bonded type.
+ *
+ * The atoms form a single zig-zag chain with roughly bond-length spacing
+ * and the interactions couple numAtomsPerInteraction consecutive atoms,
+ * so neighboring interactions share atoms as they do in real molecules.
+ * Each thread processes its own slice of the interaction list and
+ * accumulates into its own force buffer, as the listed-forces threading
+ * in the MD engine does.
+ */
+void benchBondedType(int ftype, const t_iparams& iparams, int numAtoms, int numThreads, int numIterations)
+{
+    const int nral            = NRAL(ftype);
+    const int numInteractions = numAtoms - nral + 1;
+
+    std::vector<RVec> x(numAtoms);
+    for (int i = 0; i < numAtoms; i++)
+    {
+        /* A zig-zag chain with ~0.15 nm spacing; the small index-dependent
+         * z-offsets avoid collinear triples and planar quadruples.
+         */
+        x[i] = RVec(0.13_real * i, 0.08_real * (i % 2), 0.01_real * (i % 7));
+    }
+
+    std::vector<t_iparams> forceparams(1, iparams);
+    std::vector<t_iatom>   forceatoms;
+    forceatoms.reserve(numInteractions * (1 + nral));
+    for (int i = 0; i < numInteractions; i++)
+    {
+        forceatoms.push_back(0);
+        for (int j = 0; j < nral; j++)
+        {
+            forceatoms.push_back(i + j);
+        }
+    }
+
+    /* rvec4 is a plain array type, so allocate the per-thread force
+     * buffers with snew instead of in a std::vector.
+     */
+    std::vector<rvec4*> threadForces(numThreads);
+    for (auto& f : threadForces)
+    {
+        snew(f, numAtoms);
+    }
+
+    const t_mdatoms mdatoms = { 0 };
+    t_fcdata        fcd     = { 0 };
+
+    const BondedKernelFlavor flavors[] = { BondedKernelFlavor::ForcesSimdWhenAvailable,
+                                           BondedKernelFlavor::ForcesNoSimd,
+                                           BondedKernelFlavor::ForcesAndVirialAndEnergy };
+    const char* flavorNames[]          = { "forces-simd", "forces-no-simd", "forces+ener+vir" };
+
+    for (int flavorIndex = 0; flavorIndex < asize(flavors); flavorIndex++)
+    {
+        const BondedKernelFlavor flavor = flavors[flavorIndex];
+
+        gmx_cycles_t cycles = 0;
+        /* Iteration -1 warms up the caches and is not timed */
+        for (int iter = -1; iter < numIterations; iter++)
+        {
+            if (iter == 0)
+            {
+                cycles = gmx_cycles_read();
+            }
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+            for (int thread = 0; thread < numThreads; thread++)
+            {
+                const int firstInteraction = (numInteractions * thread) / numThreads;
+                const int endInteraction   = (numInteractions * (thread + 1)) / numThreads;
+                const int stride           = 1 + nral;
+                rvec      fshift[SHIFTS]   = { { 0 } };
+                real      lambda           = 0;
+                real      dvdlambda        = 0;
+
+                calculateSimpleBond(ftype, (endInteraction - firstInteraction) * stride,
+                                    forceatoms.data() + firstInteraction * stride,
+                                    forceparams.data(), as_rvec_array(x.data()),
+                                    threadForces[thread], fshift, nullptr, nullptr, lambda,
+                                    &dvdlambda, &mdatoms, &fcd, nullptr, flavor);
+            }
+        }
+        cycles = gmx_cycles_read() - cycles;
+
+        printResultRow(interaction_function[ftype].name, flavorNames[flavorIndex],
+                       static_cast<double>(cycles), numIterations, numInteractions);
+    }
+
+    for (auto& f : threadForces)
+    {
+        sfree(f);
+    }
+}
+
+//! Benchmarks the simple bonded kernels over synthetic interaction lists
+void benchBonded(int numAtoms, int numThreads, int numIterations)
+{
+    t_iparams bondParams    = {};
+    bondParams.harmonic.rA  = 0.15;
+    bondParams.harmonic.krA = 250000;
+    bondParams.harmonic.rB  = bondParams.harmonic.rA;
+    bondParams.harmonic.krB = bondParams.harmonic.krA;
+    benchBondedType(F_BONDS, bondParams, numAtoms, numThreads, numIterations);
+
+    t_iparams angleParams    = {};
+    angleParams.harmonic.rA  = 111;
+    angleParams.harmonic.krA = 400;
+    angleParams.harmonic.rB  = angleParams.harmonic.rA;
+    angleParams.harmonic.krB = angleParams.harmonic.krA;
+    benchBondedType(F_ANGLES, angleParams, numAtoms, numThreads, numIterations);
+
+    t_iparams dihParams  = {};
+    dihParams.pdihs.phiA = 180;
+    dihParams.pdihs.cpA  = 10;
+    dihParams.pdihs.phiB = dihParams.pdihs.phiA;
+    dihParams.pdihs.cpB  = dihParams.pdihs.cpA;
+    dihParams.pdihs.mult = 3;
+    benchBondedType(F_PDIHS, dihParams, numAtoms, numThreads, numIterations);
+}
+
+//! Benchmarks SETTLE over a synthetic set of rigid waters
+void benchSettle(int numAtoms, int numThreads, int numIterations)
+{
+    const int  numSettles   = numAtoms / 3;
+    const real dOH          = 0.09572;
+    const real dHH          = 0.15139;
+    const real oxygenMass   = 15.9994;
+    const real hydrogenMass = 1.008;
+
+    /* Rigid waters on a grid; xPrime is perturbed so there is work to do */
+    PaddedVector<RVec> x(3 * numSettles);
+    PaddedVector<RVec> xPrime(3 * numSettles);
+    PaddedVector<RVec> v(3 * numSettles, RVec(0, 0, 0));
+    const int          gridDim = static_cast<int>(std::cbrt(static_cast<double>(numSettles))) + 1;
+    const real         deltas[4] = { 0.01, -0.01, 0.02, -0.02 };
+    for (int i = 0; i < numSettles; i++)
+    {
+        const RVec base(0.3_real * (i % gridDim), 0.3_real * ((i / gridDim) % gridDim),
+                        0.3_real * (i / (gridDim * gridDim)));
+        x[3 * i + 0] = base;
+        x[3 * i + 1] = base + RVec(dOH, 0, 0);
+        x[3 * i + 2] = base + RVec(-0.0240_real, 0.0927_real, 0);
+        for (int j = 0; j < 3; j++)
+        {
+            xPrime[3 * i + j] = x[3 * i + j] + RVec(deltas[i % 4], deltas[(i + 1) % 4], deltas[(i + 2) % 4]);
+        }
+    }
+
+    gmx_mtop_t mtop;
+    mtop.moltype.resize(1);
+    mtop.molblock.resize(1);
+    mtop.molblock[0].type    = 0;
+    std::vector<int>& iatoms = mtop.moltype[0].ilist[F_SETTLE].iatoms;
+    for (int i = 0; i < numSettles; i++)
+    {
+        iatoms.push_back(0);
+        iatoms.push_back(3 * i + 0);
+        iatoms.push_back(3 * i + 1);
+        iatoms.push_back(3 * i + 2);
+    }
+    t_iparams iparams  = {};
+    iparams.settle.doh = dOH;
+    iparams.settle.dhh = dHH;
+    mtop.ffparams.iparams.push_back(iparams);
+
+    std::vector<real> massT(3 * numSettles);
+    std::vector<real> invmass(3 * numSettles);
+    mtop.moltype[0].atoms.nr = 3 * numSettles;
+    snew(mtop.moltype[0].atoms.atom, 3 * numSettles);
+    for (int i = 0; i < numSettles; i++)
+    {
+        const real masses[3] = { oxygenMass, hydrogenMass, hydrogenMass };
+        for (int j = 0; j < 3; j++)
+        {
+            massT[3 * i + j]                     = masses[j];
+            invmass[3 * i + j]                   = 1.0 / masses[j];
+            mtop.moltype[0].atoms.atom[3 * i + j].m = masses[j];
+        }
+    }
+    t_mdatoms mdatoms = { 0 };
+    mdatoms.homenr    = 3 * numSettles;
+    mdatoms.massT     = massT.data();
+    mdatoms.invmass   = invmass.data();
+
+    settledata* settled = settle_init(mtop);
+    t_ilist     ilist   = { mtop.moltype[0].ilist[F_SETTLE].size(),
+                        mtop.moltype[0].ilist[F_SETTLE].iatoms.data(), 0 };
+    settle_set_constraints(settled, &ilist, mdatoms);
+
+    const real invdt  = 1.0 / 0.002;
+    tensor     virial = { { 0 } };
+
+    gmx_cycles_t cycles = 0;
+    for (int iter = -1; iter < numIterations; iter++)
+    {
+        if (iter == 0)
+        {
+            cycles = gmx_cycles_read();
+        }
+#pragma omp parallel num_threads(numThreads)
+        {
+            bool errorHasOccurred;
+            csettle(settled, numThreads, gmx_omp_get_thread_num(), nullptr, x.arrayRefWithPadding(),
+                    xPrime.arrayRefWithPadding(), invdt, v.arrayRefWithPadding(), false, virial,
+                    &errorHasOccurred);
+        }
+    }
+    cycles = gmx_cycles_read() - cycles;
+
+    printResultRow("settle", "positions+vel", static_cast<double>(cycles), numIterations, numSettles);
+
+    settle_free(settled);
+}
+
+//! Benchmarks LINCS on chains of coupled constraints
+void benchLincs(int numAtoms, int numThreads, int numIterations)
+{
+    /* Chains of 16 atoms with alternating heavy/light masses; within a
+     * chain the constraints are coupled, which is what makes LINCS work.
+     */
+    const int chainLength    = 16;
+    const int numChains      = numAtoms / chainLength;
+    const int atomsTotal     = numChains * chainLength;
+    const int numConstraints = numChains * (chainLength - 1);
+
+    PaddedVector<RVec> x(atomsTotal);
+    PaddedVector<RVec> xPrime(atomsTotal);
+    const real         deltas[4] = { 0.002, -0.002, 0.004, -0.004 };
+    for (int i = 0; i < atomsTotal; i++)
+    {
+        x[i]      = RVec(0.1_real * (i % chainLength), 0.05_real * (i % 2), 0.3_real * (i / chainLength));
+        xPrime[i] = x[i] + RVec(deltas[i % 4], deltas[(i + 1) % 4], deltas[(i + 2) % 4]);
+    }
+
+    std::vector<real> invmass(atomsTotal);
+    for (int i = 0; i < atomsTotal; i++)
+    {
+        invmass[i] = 1.0 / ((i % 2 == 0) ? 12.011 : 1.008);
+    }
+
+    t_mdatoms mdatoms      = { 0 };
+    mdatoms.nr             = atomsTotal;
+    mdatoms.homenr         = atomsTotal;
+    mdatoms.invmass        = invmass.data();
+    mdatoms.nMassPerturbed = 0;
+    mdatoms.lambda         = 0;
+
+    /* The constraints, both as local topology and as global topology */
+    t_idef idef = {};
+    for (int i = 0; i < F_NRE; i++)
+    {
+        idef.il[i].nr = 0;
+    }
+    InteractionList interactionList;
+    for (int c = 0; c < numChains; c++)
+    {
+        for (int i = 0; i < chainLength - 1; i++)
+        {
+            interactionList.iatoms.push_back(0);
+            interactionList.iatoms.push_back(c * chainLength + i);
+            interactionList.iatoms.push_back(c * chainLength + i + 1);
+        }
+    }
+    idef.il[F_CONSTR].nr     = interactionList.iatoms.size();
+    idef.il[F_CONSTR].iatoms = interactionList.iatoms.data();
+    t_iparams iparams        = {};
+    iparams.constr.dA        = 0.1;
+    iparams.constr.dB        = 0.1;
+    idef.iparams             = &iparams;
+
+    gmx_mtop_t    mtop;
+    gmx_moltype_t molType;
+    molType.atoms.nr           = atomsTotal;
+    molType.ilist[F_CONSTR]    = interactionList;
+    mtop.moltype.push_back(molType);
+    gmx_molblock_t molBlock;
+    molBlock.type = 0;
+    molBlock.nmol = 1;
+    mtop.molblock.push_back(molBlock);
+    mtop.natoms = atomsTotal;
+    mtop.ffparams.iparams.push_back(iparams);
+    mtop.bIntermolecularInteractions = false;
+
+    t_inputrec ir;
+    ir.eI             = eiMD;
+    ir.efep           = efepNO;
+    ir.delta_t        = 0.002;
+    ir.nLincsIter     = 1;
+    ir.nProjOrder     = 4;
+    ir.LincsWarnAngle = 30;
+
+    t_commrec cr = {};
+    cr.nnodes    = 1;
+    cr.dd        = nullptr;
+    gmx_multisim_t ms;
+    ms.sim  = 0;
+    ms.nsim = 1;
+
+    gmx_omp_nthreads_set(emntLINCS, numThreads);
+
+    std::vector<ListOfLists<int>> at2con_mt;
+    at2con_mt.reserve(mtop.moltype.size());
+    for (const gmx_moltype_t& moltype : mtop.moltype)
+    {
+        at2con_mt.push_back(make_at2con(moltype, mtop.ffparams.iparams,
+                                        flexibleConstraintTreatment(EI_DYNAMICS(ir.eI))));
+    }
+    Lincs* lincsd = init_lincs(nullptr, mtop, 0, at2con_mt, false, ir.nLincsIter, ir.nProjOrder);
+    set_lincs(idef, mdatoms, EI_DYNAMICS(ir.eI), &cr, lincsd);
+
+    matrix box       = { { 0 } };
+    real   dvdlambda = 0;
+    tensor virial    = { { 0 } };
+    t_nrnb nrnb      = { 0 };
+    int    warncount = 0;
+
+    gmx_cycles_t cycles = 0;
+    for (int iter = -1; iter < numIterations; iter++)
+    {
+        if (iter == 0)
+        {
+            cycles = gmx_cycles_read();
+        }
+        constrain_lincs(false, ir, iter, lincsd, mdatoms, &cr, &ms, x.arrayRefWithPadding(),
+                        xPrime.arrayRefWithPadding(),
+                        ArrayRef<RVec>(), box, nullptr, 0, &dvdlambda, 1.0 / ir.delta_t,
+                        ArrayRef<RVec>(), false, virial, ConstraintVariable::Positions, &nrnb, 100,
+                        &warncount);
+    }
+    cycles = gmx_cycles_read() - cycles;
+
+    printResultRow("lincs", "positions", static_cast<double>(cycles), numIterations, numConstraints);
+
+    done_lincs(lincsd);
+}
+
+//! Benchmarks the leap-frog update loop
+void benchUpdate(int numAtoms, int numThreads, int numIterations)
+{
+    t_inputrec ir;
+    ir.eI         = eiMD;
+    ir.delta_t    = 0.002;
+    ir.etc        = etcNO;
+    ir.epc        = epcNO;
+    ir.nsttcouple = 1;
+
+    std::vector<real> invmass(numAtoms);
+    std::vector<RVec> invMassPerDim(numAtoms);
+    for (int i = 0; i < numAtoms; i++)
+    {
+        invmass[i] = 1.0 / (1.0 + i % 100);
+        for (int d = 0; d < DIM; d++)
+        {
+            invMassPerDim[i][d] = invmass[i];
+        }
+    }
+    t_mdatoms mdatoms               = { 0 };
+    mdatoms.nr                      = numAtoms;
+    mdatoms.homenr                  = numAtoms;
+    mdatoms.invmass                 = invmass.data();
+    mdatoms.invMassPerDim           = as_rvec_array(invMassPerDim.data());
+    mdatoms.haveVsites              = false;
+    mdatoms.havePartiallyFrozenAtoms = false;
+    snew(mdatoms.cTC, numAtoms);
+
+    gmx_ekindata_t ekind;
+    ekind.ngtc = 1;
+    t_grp_tcstat tcstat;
+    tcstat.lambda = 1.0;
+    ekind.tcstat.emplace_back(tcstat);
+    ekind.bNEMD            = false;
+    ekind.cosacc.cos_accel = 0.0;
+    ekind.nthreads         = numThreads;
+    snew(ekind.ekin_work_alloc, ekind.nthreads);
+    snew(ekind.ekin_work, ekind.nthreads);
+    snew(ekind.dekindl_work, ekind.nthreads);
+
+    t_state state;
+    state.flags = 0;
+    clear_mat(state.box);
+    state.box[XX][XX] = 10;
+    state.box[YY][YY] = 10;
+    state.box[ZZ][ZZ] = 10;
+    state.x.resizeWithPadding(numAtoms);
+    state.v.resizeWithPadding(numAtoms);
+    PaddedVector<RVec> f(numAtoms);
+    for (int i = 0; i < numAtoms; i++)
+    {
+        state.x[i] = RVec(0.3_real * (i % 30), 0.3_real * ((i / 30) % 30), 0.3_real * (i / 900));
+        state.v[i] = RVec(0.1_real, -0.2_real, 0.05_real);
+        f[i]       = RVec(1.0_real, -2.0_real, 0.5_real);
+    }
+
+    matrix velocityScalingMatrix;
+    clear_mat(velocityScalingMatrix);
+    velocityScalingMatrix[XX][XX] = 1;
+    velocityScalingMatrix[YY][YY] = 1;
+    velocityScalingMatrix[ZZ][ZZ] = 1;
+
+    Update update(&ir, nullptr);
+    update.setNumAtoms(numAtoms);
+
+    gmx_omp_nthreads_set(emntUpdate, numThreads);
+
+    gmx_cycles_t cycles = 0;
+    for (int iter = -1; iter < numIterations; iter++)
+    {
+        if (iter == 0)
+        {
+            cycles = gmx_cycles_read();
+        }
+        update_coords(iter, &ir, &mdatoms, &state, f.arrayRefWithPadding(), nullptr, &ekind,
+                      velocityScalingMatrix, &update, etrtNONE, nullptr, nullptr);
+    }
+    cycles = gmx_cycles_read() - cycles;
+
+    printResultRow("update", "leap-frog", static_cast<double>(cycles), numIterations, numAtoms);
+
+    sfree(mdatoms.cTC);
+}
+
+class MDKernelBenchmark : public ICommandLineOptionsModule
+{
+public:
+    MDKernelBenchmark() {}
+
+    // From ICommandLineOptionsModule
+    void init(CommandLineModuleSettings* /*settings*/) override {}
+    void initOptions(IOptionsContainer* options, ICommandLineOptionsModuleSettings* settings) override;
+    void optionsFinished() override {}
+    int  run() override;
+
+private:
+    int              sizeFactor_    = 1;
+    int              numThreads_    = 1;
+    int              numIterations_ = 100;
+    BenchKernelClass kernelClass_   = BenchKernelClass::All;
+};
+
+void MDKernelBenchmark::initOptions(IOptionsContainer* options, ICommandLineOptionsModuleSettings* settings)
+{
+    std::vector<const char*> desc = {
+        "[THISMODULE] runs benchmarks for the CPU kernels of an MD step other",
+        "than the non-bonded pair interactions, which have their own benchmark",
+        "in [gmx-nonbonded-benchmark]. It covers the simple bonded kernels",
+        "(bonds, angles and proper dihedrals, each in SIMD, plain-C and",
+        "energy+virial flavors), the SETTLE and LINCS constraint algorithms",
+        "and the leap-frog update loop. Together with the non-bonded benchmark",
+        "this allows qualifying new hardware for full-step performance instead",
+        "of extrapolating from non-bonded numbers alone.[PAR]",
+        "The interactions act on synthetic systems: a bonded chain where",
+        "neighboring interactions share atoms, a grid of rigid waters for",
+        "SETTLE, chains of 16 coupled constraints for LINCS, and atoms with a",
+        "spread of masses for the update. No pair list or neighbor searching",
+        "is involved, so the numbers isolate the kernel cost itself.[PAR]",
+        "OpenMP parallelization follows the MD engine: the bonded and SETTLE",
+        "benchmarks divide the interactions over the threads with per-thread",
+        "force accumulation, while LINCS and the update use their regular",
+        "internal threading. As with the non-bonded benchmark, results are",
+        "reported in cycles read from the CPU's cycle counter, and thread",
+        "affinity (e.g. through GOMP_CPU_AFFINITY) and locked clocks are",
+        "recommended for stable results.",
+    };
+
+    settings->setHelpText(desc);
+
+    const char* const cKernelClassStrings[] = { "all", "bonded", "settle", "lincs", "update" };
+
+    options->addOption(
+            IntegerOption("size").store(&sizeFactor_).description("The system size is 3000 atoms times this value"));
+    options->addOption(
+            IntegerOption("nt").store(&numThreads_).description("The number of OpenMP threads to use"));
+    options->addOption(IntegerOption("iter")
+                               .store(&numIterations_)
+                               .description("The number of iterations for each kernel"));
+    options->addOption(EnumOption<BenchKernelClass>("kernel")
+                               .store(&kernelClass_)
+                               .enumValue(cKernelClassStrings)
+                               .description("The class of kernels to benchmark"));
+}
+
+int MDKernelBenchmark::run()
+{
+    const int numAtoms = sizeFactor_ * 3000;
+
+    fprintf(stdout, "System size:          %d atoms\n", numAtoms);
+    fprintf(stdout, "Number of threads:    %d\n", numThreads_);
+    fprintf(stdout, "Number of iterations: %d\n", numIterations_);
+    fprintf(stdout, "\n");
+    fprintf(stdout, "%-10s %-18s %12s %12s %10s\n", "Kernel", "Variant", "Mcycles", "Mcycles/it.",
+            "cyc./unit");
+    fprintf(stdout,
+            "(the unit is one interaction, settle, constraint or atom, respectively)\n\n");
+
+    if (kernelClass_ == BenchKernelClass::All || kernelClass_ == BenchKernelClass::Bonded)
+    {
+        benchBonded(numAtoms, numThreads_, numIterations_);
+    }
+    if (kernelClass_ == BenchKernelClass::All || kernelClass_ == BenchKernelClass::Settle)
+    {
+        benchSettle(numAtoms, numThreads_, numIterations_);
+    }
+    if (kernelClass_ == BenchKernelClass::All || kernelClass_ == BenchKernelClass::Lincs)
+    {
+        benchLincs(numAtoms, numThreads_, numIterations_);
+    }
+    if (kernelClass_ == BenchKernelClass::All || kernelClass_ == BenchKernelClass::Update)
+    {
+        benchUpdate(numAtoms, numThreads_, numIterations_);
+    }
+
+    return 0;
+}
+
+} // namespace
+
+const char MDKernelBenchmarkInfo::name[] = "mdkernel-benchmark";
+const char MDKernelBenchmarkInfo::shortDescription[] =
+        "Benchmarking tool for the bonded, constraint and update kernels.";
+
+ICommandLineOptionsModulePointer MDKernelBenchmarkInfo::create()
+{
+    return ICommandLineOptionsModulePointer(std::make_unique<MDKernelBenchmark>());
+}
+
+} // namespace gmx
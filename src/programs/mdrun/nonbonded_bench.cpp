@@ -196,6 +196,11 @@ void NonbondedBenchmark::initOptions(IOptionsContainer* options, ICommandLineOpt
     options->addOption(IntegerOption("iter")
                                .store(&benchmarkOptions_.numIterations)
                                .description("The number of iterations for each kernel"));
+    options->addOption(
+            IntegerOption("nsystems")
+                    .store(&benchmarkOptions_.numSystems)
+                    .description("The number of independent system copies to cycle over per "
+                                 "iteration, for benchmarking batched multi-system throughput"));
     options->addOption(IntegerOption("warmup")
                                .store(&benchmarkOptions_.numWarmupIterations)
                                .description("The number of iterations for initial warmup"));